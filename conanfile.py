@@ -63,7 +63,8 @@ class oxc3(ConanFile):
 		"dynamicLinkingShaderCompiler": [ True, False ],
 		"debugShaderCompiler": [ True, False ],
 		"enableASAN": [ True, False ],
-		"enableUBSAN": [ True, False ]
+		"enableUBSAN": [ True, False ],
+		"enableTracing": [ True, False ]
 	}
 
 	default_options = {
@@ -94,7 +95,11 @@ class oxc3(ConanFile):
 		# CMakeLists turns a request under MSVC into a hard error rather than ignoring it.
 
 		"enableASAN": False,
-		"enableUBSAN": False
+		"enableUBSAN": False,
+
+		# Compiles the trace zones in (see types/container/trace.h), off means they don't exist at all.
+
+		"enableTracing": False
 	}
 
 	exports_sources = [ "include/*", "cmake/*" ]
@@ -144,6 +149,7 @@ class oxc3(ConanFile):
 		tc.cache_variables["DynamicLinkingGraphics"] = self.options.dynamicLinkingGraphics
 		tc.cache_variables["EnableASAN"] = self.options.enableASAN
 		tc.cache_variables["EnableUBSAN"] = self.options.enableUBSAN
+		tc.cache_variables["EnableTracing"] = self.options.enableTracing
 
 		if not self.settings.os == "Windows":
 			tc.cache_variables["CMAKE_CONFIGURATION_TYPES"] = str(self.settings.build_type)
@@ -39,7 +39,7 @@ typedef enum EDLFlags {
 
 	EDLFlags_None                    = 0,
 
-	EDLFlags_Reserved                = 1 << 0,        //Reserved: [CRC32C,SHA256][v] if compressed and not encrypted
+	EDLFlags_Reserved                = 1 << 0,        //Reserved: [CRC32C,SHA256][v] (LZ blocks carry their own CRC32C)
 
 	EDLFlags_IsString                = 1 << 1,        //If true; must be a valid UTF8 string
 
@@ -62,7 +62,7 @@ typedef struct DLHeader {
 	DLVersion version;         //major.minor (%10 = minor, /10 = major (+1 to get real major))
 	DLFlags flags;
 	U8 type;                   //(EXXCompressionType << 4) | EXXEncryptionType. Each enum should be <Count (see oiXX.md).
-	U8 sizeTypes;              //EXXDataSizeTypes: entryType | (uncompressedSizType << 2) | (dataType << 4) (< (1 << 6)).
+	U8 sizeTypes;              //EXXDataSizeTypes: entryType | (compressedSizeType << 2) | (dataType << 4) (< (1 << 6)).
 } DLHeader;
 
 static const U32 DLHeader_chunkSizes[] = { 131072, 1048576, 8388608, 67108864 };
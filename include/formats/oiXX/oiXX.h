@@ -34,8 +34,8 @@ typedef struct Allocator Allocator;
 
 typedef enum EXXCompressionType {
 	EXXCompressionType_None,                            //--uncompressed (default)
-	//EXXCompressionType_Brotli11,                      //(default): Unsupported
-	//EXXCompressionType_Brotli1,                       //--fast-compress
+	EXXCompressionType_LZ,                              //--fast-compress (see types/container/buffer_compress.h)
+	//EXXCompressionType_Brotli11,                      //Unsupported
 	EXXCompressionType_Count
 } EXXCompressionType;
 
@@ -174,6 +174,10 @@ typedef struct GraphicsDevice {
 
 	DescriptorHeapRef *defaultDescriptorHeaps;
 
+	//Where its deferred resources retire to (see GraphicsInstance_makeObjectTypes), collected every frame
+
+	RefPtrRetireDomain retireDomain;
+
 } GraphicsDevice;
 
 typedef RefPtr GraphicsDeviceRef;
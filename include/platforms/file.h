@@ -251,6 +251,36 @@ Bool FileHandle_openStream(
 	Error *e_rr
 );
 
+//Memory mapped file streams (mmap on unix, a file mapping on Windows) are readonly and EStreamType_Mapped.
+//StreamCursor_read then copies straight from the mapping and StreamCursor_view returns a Buffer into it without a copy.
+//The mapping belongs to the stream, so views stay valid as long as a reference to the StreamRef is kept.
+//The hint tells the OS how the mapping is going to be read (madvise), Windows ignores it.
+
+typedef enum EFileMapHint {
+	EFileMapHint_Normal,
+	EFileMapHint_Sequential,        //Read ahead aggressively and drop pages that were already read
+	EFileMapHint_Random            //Don't read ahead
+} EFileMapHint;
+
+Bool File_openMappedStream(
+	const CharString *loc,
+	Ns timeout,
+	EFileMapHint hint,
+	const RefPtrType *fileHandleType,
+	const RefPtrType *streamType,        //FileStream_makeType(alloc)
+	StreamRef **output,
+	Error *e_rr
+);
+
+//Takes over FileHandle, which has to be opened as EFileOpenType_Read
+Bool FileHandle_openMappedStream(
+	FileHandleRef **handle,
+	EFileMapHint hint,
+	const RefPtrType *streamType,
+	StreamRef **streamRef,
+	Error *e_rr
+);
+
 //TODO: make it more like a DirectStorage-like api
 
 #ifdef __cplusplus
@@ -67,6 +67,7 @@ Bool CLI_profileCast(const ParsedArgs *args);
 Bool CLI_profileRNG(const ParsedArgs *args);
 Bool CLI_profileCRC32C(const ParsedArgs *args);
 Bool CLI_profileFNV1A64(const ParsedArgs *args);
+Bool CLI_profileXXH3(const ParsedArgs *args);
 Bool CLI_profileSHA256(const ParsedArgs *args);
 Bool CLI_profileMD5(const ParsedArgs *args);
 Bool CLI_profileAES256(const ParsedArgs *args);
@@ -186,7 +186,9 @@ typedef enum EOperationFlags {
 
 	EOperationFlags_KeepRegisters       = 1 << 27,        //--keep-registers: unused resources stay bound and reflected
 
-	EOperationFlags_Count               = 28
+	EOperationFlags_FastCompress        = 1 << 28,        //--fast-compress: EXXCompressionType_LZ for oiCA/oiDL
+
+	EOperationFlags_Count               = 29
 
 } EOperationFlags;
 
@@ -263,6 +265,7 @@ typedef enum EOperation {
 	EOperation_ProfileRNG,
 	EOperation_ProfileCRC32C,
 	EOperation_ProfileFNV1A64,
+	EOperation_ProfileXXH3,
 	EOperation_ProfileSHA256,
 	EOperation_ProfileMD5,
 	EOperation_ProfileAES256,
@@ -330,6 +333,8 @@ typedef enum EFormat {
 	EFormat_CRC32C,
 	EFormat_MD5,
 	EFormat_FNV1A64,
+	EFormat_XXH3,
+	EFormat_XXH128,
 
 	EFormat_HLSL,
 
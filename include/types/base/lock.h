@@ -68,6 +68,136 @@ static inline Bool SpinLock_isLockedForThread(SpinLock *l) {
 	return l && AtomicI64_load(&l->lockedThreadId) == (I64)Thread_getId();
 }
 
+//Mutex behaves like SpinLock (owner checked unlock, AlreadyLocked for the owner, same timeouts),
+// but after a short spin the waiting thread is parked by the OS (futex on Linux/Android, WaitOnAddress on Windows)
+// instead of yielding in a loop, so a lock that's held for long doesn't keep the waiters' cores busy.
+//Other platforms don't have a parking primitive exposed, there it parks on a pthread condition variable instead.
+//
+//state is Thread_getId() << 1 of the owner, the low bit is set once someone parked (or might park) on it,
+// which is what tells unlock it has to wake a thread.
+
+typedef struct Mutex {
+	alignas(64) AtomicI64 state;
+} Mutex;
+
+//Parks the thread while word is still expected, for at most maxTime (U64_MAX is forever).
+//It may return early or spuriously, so callers always look at the word again.
+//futex only compares 32 bits, the low half of the word on the (little endian) archs we support;
+// Mutex and RWLock make sure the low half changes whenever it matters.
+//Without a parking primitive (OS X, iOS, web) it waits on a condition variable of a bucket picked by address,
+// which words sharing that bucket also wake.
+
+impl void Lock_park(AtomicI64 *word, I64 expected, Ns maxTime);
+impl void Lock_wake(AtomicI64 *word, Bool all);
+
+ELockAcquire Mutex_lock(Mutex *l, Ns maxTime);
+
+static inline Bool Mutex_unlock(Mutex *l) {
+
+	if (l) {
+
+		const I64 owner = (I64)(Thread_getId() << 1);
+		const I64 prev = AtomicI64_cmpStore(&l->state, owner, 0);
+
+		//Contended; nobody but the owner changes the state once the parked bit is set
+
+		if (prev == (owner | 1)) {
+			AtomicI64_store(&l->state, 0);
+			Lock_wake(&l->state, false);
+		}
+
+		const Bool unlocked = (prev &~ (I64)1) == owner;
+		assert(unlocked && "Thread tried unlocking for a Mutex it didn't own");
+		return unlocked;
+	}
+
+	return false;
+}
+
+static inline Bool Mutex_isLockedForThread(Mutex *l) {
+	return l && (AtomicI64_load(&l->state) &~ (I64)1) == (I64)(Thread_getId() << 1);
+}
+
+//RWLock allows any number of readers or one writer, for read-mostly data.
+//The writer is owner checked like Mutex and a thread holding the write lock gets AlreadyLocked for a read lock.
+//Readers aren't tracked per thread: a thread must not take the read lock twice or upgrade it to a write lock,
+// since a waiting writer blocks new readers (so writers can't starve), which would deadlock.
+//
+//state is the reader count (RWLock_readerMask), RWLock_writer once a writer owns or is waiting for the lock and
+// RWLock_parked if a thread might be parked on it.
+
+#define RWLock_readerMask ((I64)0x0FFFFFFF)
+#define RWLock_writer ((I64)1 << 28)
+#define RWLock_parked ((I64)1 << 29)
+
+typedef struct RWLock {
+	alignas(64) AtomicI64 state;
+	AtomicI64 writerThreadId;
+} RWLock;
+
+ELockAcquire RWLock_lockRead(RWLock *l, Ns maxTime);
+ELockAcquire RWLock_lockWrite(RWLock *l, Ns maxTime);
+
+void RWLock_releaseWriter(RWLock *l);      //Use RWLock_unlockWrite instead
+
+static inline Bool RWLock_isWriteLockedForThread(RWLock *l) {
+	return l && AtomicI64_load(&l->writerThreadId) == (I64)Thread_getId();
+}
+
+static inline Bool RWLock_unlockWrite(RWLock *l) {
+
+	if (l) {
+
+		const I64 tid = (I64) Thread_getId();
+		const Bool unlocked = AtomicI64_cmpStore(&l->writerThreadId, tid, 0) == tid;
+		assert(unlocked && "Thread tried unlocking the write lock of an RWLock it didn't own");
+
+		if(unlocked)
+			RWLock_releaseWriter(l);
+
+		return unlocked;
+	}
+
+	return false;
+}
+
+static inline Bool RWLock_unlockRead(RWLock *l) {
+
+	if (l) {
+
+		while (true) {
+
+			const I64 state = AtomicI64_load(&l->state);
+			const Bool hasReaders = state & RWLock_readerMask;
+			assert(hasReaders && "Thread tried unlocking a read lock on an RWLock without readers");
+
+			if(!hasReaders)
+				return false;
+
+			//The last reader wakes the waiting writer (and the readers parked behind it, they'll park again)
+
+			I64 next = state - 1;
+
+			if(!(next & RWLock_readerMask))
+				next &= ~RWLock_parked;
+
+			if (AtomicI64_cmpStore(&l->state, state, next) == state) {
+
+				if((state & RWLock_parked) && !(next & RWLock_parked))
+					Lock_wake(&l->state, true);
+
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static inline Bool RWLock_isLocked(RWLock *l) {
+	return l && (AtomicI64_load(&l->state) & (RWLock_readerMask | RWLock_writer));
+}
+
 #ifdef __cplusplus
 	}
 #endif
@@ -0,0 +1,51 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/simd/neon/neon_string_search.inc.h
+
+#include <arm_neon.h>
+
+#ifndef STRING_SEARCH_NEON_GUARD
+	#error String search NEON guard was undefined, neon_string_search.inc.h is only included by string_search.c
+#endif
+
+//NEON has no movemask, but with 64 bytes at once one can be built exactly: every matching lane keeps the bit of its
+// position within 8 lanes, and three pairwise adds sum each run of 8 lanes into the byte of the mask that covers them.
+
+static inline U64 StringSearch_block(const C8 *ptr, C8 a, C8 b) {
+
+	static const U8 laneBits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+
+	const uint8x16_t bits = vld1q_u8(laneBits);
+	const uint8x16_t va = vdupq_n_u8((U8) a);
+	const uint8x16_t vb = vdupq_n_u8((U8) b);
+
+	uint8x16_t m[4];
+
+	for (U64 i = 0; i < 4; ++i) {
+		const uint8x16_t v = vld1q_u8((const U8*) ptr + i * 16);
+		m[i] = vandq_u8(vorrq_u8(vceqq_u8(v, va), vceqq_u8(v, vb)), bits);
+	}
+
+	uint8x16_t sum = vpaddq_u8(vpaddq_u8(m[0], m[1]), vpaddq_u8(m[2], m[3]));
+	sum = vpaddq_u8(sum, sum);
+
+	return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
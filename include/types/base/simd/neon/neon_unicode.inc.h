@@ -0,0 +1,240 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/simd/neon/neon_unicode.inc.h
+
+#include <arm_neon.h>
+
+#ifndef UNICODE_NEON_GUARD
+	#error Unicode NEON guard was undefined, this likely indicates include of neon_unicode.inc.h outside of unicode.c
+#endif
+
+//The same range table validation as sse_unicode.inc.h (see there for how the tables work), with tbl as the lookup
+
+#define Unicode_tooShort        (1 << 0)
+#define Unicode_tooLong         (1 << 1)
+#define Unicode_overlong3       (1 << 2)
+#define Unicode_tooLarge        (1 << 3)
+#define Unicode_surrogate       (1 << 4)
+#define Unicode_overlong2       (1 << 5)
+#define Unicode_tooLarge1000    (1 << 6)
+#define Unicode_overlong4       (1 << 6)
+#define Unicode_twoConts        (1 << 7)
+#define Unicode_carry           (Unicode_tooShort | Unicode_tooLong | Unicode_twoConts)
+
+static const U8 Unicode_byte1HighTable[16] = {
+	Unicode_tooLong, Unicode_tooLong, Unicode_tooLong, Unicode_tooLong,
+	Unicode_tooLong, Unicode_tooLong, Unicode_tooLong, Unicode_tooLong,
+	Unicode_twoConts, Unicode_twoConts, Unicode_twoConts, Unicode_twoConts,
+	Unicode_tooShort | Unicode_overlong2,
+	Unicode_tooShort,
+	Unicode_tooShort | Unicode_overlong3 | Unicode_surrogate,
+	Unicode_tooShort | Unicode_tooLarge | Unicode_tooLarge1000 | Unicode_overlong4
+};
+
+static const U8 Unicode_byte1LowTable[16] = {
+	Unicode_carry | Unicode_overlong3 | Unicode_overlong2 | Unicode_overlong4,
+	Unicode_carry | Unicode_overlong2,
+	Unicode_carry,
+	Unicode_carry,
+	Unicode_carry | Unicode_tooLarge,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000 | Unicode_surrogate,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000,
+	Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000
+};
+
+static const U8 Unicode_byte2HighTable[16] = {
+	Unicode_tooShort, Unicode_tooShort, Unicode_tooShort, Unicode_tooShort,
+	Unicode_tooShort, Unicode_tooShort, Unicode_tooShort, Unicode_tooShort,
+	Unicode_tooLong | Unicode_overlong2 | Unicode_twoConts | Unicode_overlong3 | Unicode_tooLarge1000 | Unicode_overlong4,
+	Unicode_tooLong | Unicode_overlong2 | Unicode_twoConts | Unicode_overlong3 | Unicode_tooLarge,
+	Unicode_tooLong | Unicode_overlong2 | Unicode_twoConts | Unicode_surrogate | Unicode_tooLarge,
+	Unicode_tooLong | Unicode_overlong2 | Unicode_twoConts | Unicode_surrogate | Unicode_tooLarge,
+	Unicode_tooShort, Unicode_tooShort, Unicode_tooShort, Unicode_tooShort
+};
+
+static inline uint8x16_t Unicode_checkUTF8(uint8x16_t cur, uint8x16_t prev) {
+
+	const uint8x16_t prev1 = vextq_u8(prev, cur, 15);
+	const uint8x16_t prev2 = vextq_u8(prev, cur, 14);
+	const uint8x16_t prev3 = vextq_u8(prev, cur, 13);
+
+	const uint8x16_t byte1High = vqtbl1q_u8(vld1q_u8(Unicode_byte1HighTable), vshrq_n_u8(prev1, 4));
+	const uint8x16_t byte1Low  = vqtbl1q_u8(vld1q_u8(Unicode_byte1LowTable), vandq_u8(prev1, vdupq_n_u8(0x0F)));
+	const uint8x16_t byte2High = vqtbl1q_u8(vld1q_u8(Unicode_byte2HighTable), vshrq_n_u8(cur, 4));
+
+	const uint8x16_t special = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+
+	const uint8x16_t third  = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+	const uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+	const uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+	return veorq_u8(must23, special);
+}
+
+static inline uint8x16_t Unicode_checkAscii(uint8x16_t v) {
+
+	const uint8x16_t allowed = vorrq_u8(
+		vorrq_u8(vceqq_u8(v, vdupq_n_u8('\t')), vceqq_u8(v, vdupq_n_u8('\n'))),
+		vceqq_u8(v, vdupq_n_u8('\r'))
+	);
+
+	return vorrq_u8(vbicq_u8(vcltq_u8(v, vdupq_n_u8(0x20)), allowed), vceqq_u8(v, vdupq_n_u8(0x7F)));
+}
+
+static inline U64 Unicode_validateBlocksUTF8(const U8 *ptr, U64 len, U64 *continuations, U64 *fourByte) {
+
+	static const U8 incompleteMaxBytes[16] = {
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+	};
+
+	const uint8x16_t incompleteMax = vld1q_u8(incompleteMaxBytes);
+
+	uint8x16_t prev = vdupq_n_u8(0);
+	uint8x16_t incomplete = vdupq_n_u8(0);
+
+	U64 i = 0, conts = 0, fours = 0;
+
+	for (; i + 64 <= len; i += 64) {
+
+		const uint8x16_t v0 = vld1q_u8(ptr + i);
+		const uint8x16_t v1 = vld1q_u8(ptr + i + 16);
+		const uint8x16_t v2 = vld1q_u8(ptr + i + 32);
+		const uint8x16_t v3 = vld1q_u8(ptr + i + 48);
+
+		uint8x16_t error = vorrq_u8(
+			vorrq_u8(Unicode_checkAscii(v0), Unicode_checkAscii(v1)),
+			vorrq_u8(Unicode_checkAscii(v2), Unicode_checkAscii(v3))
+		);
+
+		const uint8x16_t any = vorrq_u8(vorrq_u8(v0, v1), vorrq_u8(v2, v3));
+
+		if (vmaxvq_u8(any) < 0x80)
+			error = vorrq_u8(error, incomplete);
+
+		else {
+
+			error = vorrq_u8(error, vorrq_u8(Unicode_checkUTF8(v0, prev), Unicode_checkUTF8(v1, v0)));
+			error = vorrq_u8(error, vorrq_u8(Unicode_checkUTF8(v2, v1), Unicode_checkUTF8(v3, v2)));
+
+			//Compares are 0xFF per lane, so shifting to 1 and adding across lanes counts them (at most 64 per block)
+
+			const uint8x16_t contLo = vdupq_n_u8(0x80), contHi = vdupq_n_u8(0xBF), fourMin = vdupq_n_u8(0xF0);
+
+			uint8x16_t contCount = vdupq_n_u8(0), fourCount = vdupq_n_u8(0);
+			const uint8x16_t v[4] = { v0, v1, v2, v3 };
+
+			for (U64 j = 0; j < 4; ++j) {
+				const uint8x16_t isCont = vandq_u8(vcgeq_u8(v[j], contLo), vcleq_u8(v[j], contHi));
+				contCount = vaddq_u8(contCount, vshrq_n_u8(isCont, 7));
+				fourCount = vaddq_u8(fourCount, vshrq_n_u8(vcgeq_u8(v[j], fourMin), 7));
+			}
+
+			conts += vaddvq_u8(contCount);
+			fours += vaddvq_u8(fourCount);
+		}
+
+		if(vmaxvq_u8(error))
+			return U64_MAX;
+
+		incomplete = vqsubq_u8(v3, incompleteMax);
+		prev = v3;
+	}
+
+	*continuations = conts;
+	*fourByte = fours;
+	return i;
+}
+
+static inline Bool Unicode_isAscii16(const U8 *ptr) {
+	return vmaxvq_u8(vld1q_u8(ptr)) < 0x80;
+}
+
+static inline void Unicode_widen16(const U8 *ptr, U16 *out) {
+	const uint8x16_t v = vld1q_u8(ptr);
+	vst1q_u16(out,     vmovl_u8(vget_low_u8(v)));
+	vst1q_u16(out + 8, vmovl_high_u8(v));
+}
+
+static inline void Unicode_widen32(const U8 *ptr, U32 *out) {
+
+	const uint8x16_t v = vld1q_u8(ptr);
+	const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+	const uint16x8_t hi = vmovl_high_u8(v);
+
+	vst1q_u32(out,      vmovl_u16(vget_low_u16(lo)));
+	vst1q_u32(out + 4,  vmovl_high_u16(lo));
+	vst1q_u32(out + 8,  vmovl_u16(vget_low_u16(hi)));
+	vst1q_u32(out + 12, vmovl_high_u16(hi));
+}
+
+static inline Bool Unicode_narrow16(const U16 *ptr, U8 *out) {
+
+	const uint16x8_t a = vld1q_u16(ptr);
+	const uint16x8_t b = vld1q_u16(ptr + 8);
+
+	if(vmaxvq_u16(vorrq_u16(a, b)) >= 0x80)
+		return false;
+
+	vst1q_u8(out, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+	return true;
+}
+
+static inline U64 Unicode_utf16Block(const U16 *ptr) {
+
+	U64 bytes = 16;
+
+	for (U64 i = 0; i < 2; ++i) {
+
+		const uint16x8_t v = vld1q_u16(ptr + i * 8);
+
+		const uint16x8_t surrogate = vceqq_u16(vandq_u16(v, vdupq_n_u16(0xF800)), vdupq_n_u16(0xD800));
+
+		const uint16x8_t allowed = vorrq_u16(
+			vorrq_u16(vceqq_u16(v, vdupq_n_u16('\t')), vceqq_u16(v, vdupq_n_u16('\n'))),
+			vceqq_u16(v, vdupq_n_u16('\r'))
+		);
+
+		const uint16x8_t bad = vorrq_u16(
+			vorrq_u16(surrogate, vbicq_u16(vcltq_u16(v, vdupq_n_u16(0x20)), allowed)),
+			vceqq_u16(v, vdupq_n_u16(0x7F))
+		);
+
+		if(vmaxvq_u16(bad))
+			return 0;
+
+		const uint16x8_t extra = vaddq_u16(
+			vshrq_n_u16(vcgeq_u16(v, vdupq_n_u16(0x80)), 15),
+			vshrq_n_u16(vcgeq_u16(v, vdupq_n_u16(0x800)), 15)
+		);
+
+		bytes += vaddvq_u16(extra);
+	}
+
+	return bytes;
+}
@@ -0,0 +1,37 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/simd/none/none_string_search.inc.h
+
+#ifndef STRING_SEARCH_NONE_GUARD
+	#error String search none guard was undefined, none_string_search.inc.h is only included by string_search.c
+#endif
+
+//Same layout as the SSE mask (one bit per byte), just built one byte at a time
+
+static inline U64 StringSearch_block(const C8 *ptr, C8 a, C8 b) {
+
+	U64 mask = 0;
+
+	for(U64 i = 0; i < 64; ++i)
+		mask |= (U64)(ptr[i] == a || ptr[i] == b) << i;
+
+	return mask;
+}
@@ -0,0 +1,75 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/simd/none/none_unicode.inc.h
+
+#ifndef UNICODE_NONE_GUARD
+	#error Unicode none guard was undefined, this likely indicates include of none_unicode.inc.h outside of unicode.c
+#endif
+
+//Nothing is validated in blocks, unicode.c checks everything one code point at a time
+
+static inline U64 Unicode_validateBlocksUTF8(const U8 *ptr, U64 len, U64 *continuations, U64 *fourByte) {
+	(void) ptr;
+	(void) len;
+	*continuations = *fourByte = 0;
+	return 0;
+}
+
+static inline Bool Unicode_isAscii16(const U8 *ptr) {
+
+	U8 any = 0;
+
+	for(U64 i = 0; i < 16; ++i)
+		any |= ptr[i];
+
+	return !(any >> 7);
+}
+
+static inline void Unicode_widen16(const U8 *ptr, U16 *out) {
+	for(U64 i = 0; i < 16; ++i)
+		out[i] = ptr[i];
+}
+
+static inline void Unicode_widen32(const U8 *ptr, U32 *out) {
+	for(U64 i = 0; i < 16; ++i)
+		out[i] = ptr[i];
+}
+
+static inline Bool Unicode_narrow16(const U16 *ptr, U8 *out) {
+
+	U16 any = 0;
+
+	for(U64 i = 0; i < 16; ++i)
+		any |= ptr[i];
+
+	if(any >= 0x80)
+		return false;
+
+	for(U64 i = 0; i < 16; ++i)
+		out[i] = (U8) ptr[i];
+
+	return true;
+}
+
+static inline U64 Unicode_utf16Block(const U16 *ptr) {
+	(void) ptr;
+	return 0;
+}
@@ -0,0 +1,45 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/simd/sse/sse_string_search.inc.h
+
+#include <emmintrin.h>
+
+#ifndef STRING_SEARCH_SSE_GUARD
+	#error String search SSE guard was undefined, sse_string_search.inc.h is only included by string_search.c
+#endif
+
+//Bit i is set if ptr[i] is a or b, for 64 bytes (four 16 byte compares, one movemask each)
+
+static inline U64 StringSearch_block(const C8 *ptr, C8 a, C8 b) {
+
+	const __m128i va = _mm_set1_epi8(a);
+	const __m128i vb = _mm_set1_epi8(b);
+
+	U64 mask = 0;
+
+	for (U64 i = 0; i < 4; ++i) {
+		const __m128i v = _mm_loadu_si128((const __m128i*) (ptr + i * 16));
+		const __m128i eq = _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb));
+		mask |= (U64)(U32) _mm_movemask_epi8(eq) << (i * 16);
+	}
+
+	return mask;
+}
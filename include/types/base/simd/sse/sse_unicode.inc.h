@@ -0,0 +1,278 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/simd/sse/sse_unicode.inc.h
+
+#include <tmmintrin.h>
+
+#ifndef UNICODE_SSE_GUARD
+	#error Unicode SSE guard was undefined, this likely indicates include of sse_unicode.inc.h outside of unicode.c
+#endif
+
+//Range table UTF-8 validation (Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte").
+//Three 16 entry tables are indexed by the high and low nibble of the previous byte and the high nibble of the
+// current one; every error a pair of bytes can have gets a bit, and the bits of the three lookups only all survive
+// the and if that pair really is that error.
+//Lead bytes that need a third or fourth byte are caught separately: those positions have to be continuations,
+// which is exactly when the table says "two continuations in a row", so the two are xor-ed.
+
+#define Unicode_tooShort        (1 << 0)    //Lead (or ASCII) followed by a lead or ASCII where a continuation goes
+#define Unicode_tooLong         (1 << 1)    //ASCII followed by a continuation
+#define Unicode_overlong3       (1 << 2)    //E0 80..9F
+#define Unicode_tooLarge        (1 << 3)    //F4 90..BF or F5..FF
+#define Unicode_surrogate       (1 << 4)    //ED A0..BF
+#define Unicode_overlong2       (1 << 5)    //C0..C1
+#define Unicode_tooLarge1000    (1 << 6)    //F5..FF 80..8F
+#define Unicode_overlong4       (1 << 6)    //F0 80..8F
+#define Unicode_twoConts        (1 << 7)    //Continuation followed by a continuation
+#define Unicode_carry           (Unicode_tooShort | Unicode_tooLong | Unicode_twoConts)
+
+static inline __m128i Unicode_checkUTF8(__m128i cur, __m128i prev) {
+
+	const __m128i byte1HighTable = _mm_setr_epi8(
+		Unicode_tooLong, Unicode_tooLong, Unicode_tooLong, Unicode_tooLong,
+		Unicode_tooLong, Unicode_tooLong, Unicode_tooLong, Unicode_tooLong,
+		(C8) Unicode_twoConts, (C8) Unicode_twoConts, (C8) Unicode_twoConts, (C8) Unicode_twoConts,
+		Unicode_tooShort | Unicode_overlong2,
+		Unicode_tooShort,
+		Unicode_tooShort | Unicode_overlong3 | Unicode_surrogate,
+		Unicode_tooShort | Unicode_tooLarge | Unicode_tooLarge1000 | Unicode_overlong4
+	);
+
+	const __m128i byte1LowTable = _mm_setr_epi8(
+		(C8) (Unicode_carry | Unicode_overlong3 | Unicode_overlong2 | Unicode_overlong4),
+		(C8) (Unicode_carry | Unicode_overlong2),
+		(C8) Unicode_carry,
+		(C8) Unicode_carry,
+		(C8) (Unicode_carry | Unicode_tooLarge),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000 | Unicode_surrogate),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000),
+		(C8) (Unicode_carry | Unicode_tooLarge | Unicode_tooLarge1000)
+	);
+
+	const __m128i byte2HighTable = _mm_setr_epi8(
+		Unicode_tooShort, Unicode_tooShort, Unicode_tooShort, Unicode_tooShort,
+		Unicode_tooShort, Unicode_tooShort, Unicode_tooShort, Unicode_tooShort,
+		(C8) (
+			Unicode_tooLong | Unicode_overlong2 | Unicode_twoConts |
+			Unicode_overlong3 | Unicode_tooLarge1000 | Unicode_overlong4
+		),
+		(C8) (Unicode_tooLong | Unicode_overlong2 | Unicode_twoConts | Unicode_overlong3 | Unicode_tooLarge),
+		(C8) (Unicode_tooLong | Unicode_overlong2 | Unicode_twoConts | Unicode_surrogate | Unicode_tooLarge),
+		(C8) (Unicode_tooLong | Unicode_overlong2 | Unicode_twoConts | Unicode_surrogate | Unicode_tooLarge),
+		Unicode_tooShort, Unicode_tooShort, Unicode_tooShort, Unicode_tooShort
+	);
+
+	const __m128i nibble = _mm_set1_epi8(0x0F);
+
+	const __m128i prev1 = _mm_alignr_epi8(cur, prev, 15);
+	const __m128i prev2 = _mm_alignr_epi8(cur, prev, 14);
+	const __m128i prev3 = _mm_alignr_epi8(cur, prev, 13);
+
+	const __m128i byte1High = _mm_shuffle_epi8(byte1HighTable, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+	const __m128i byte1Low  = _mm_shuffle_epi8(byte1LowTable,  _mm_and_si128(prev1, nibble));
+	const __m128i byte2High = _mm_shuffle_epi8(byte2HighTable, _mm_and_si128(_mm_srli_epi16(cur, 4), nibble));
+
+	const __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+	//prev2 >= E0 or prev3 >= F0 means this byte has to be a continuation
+
+	const __m128i third  = _mm_subs_epu8(prev2, _mm_set1_epi8((C8)(0xE0 - 0x80)));
+	const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8((C8)(0xF0 - 0x80)));
+	const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((C8) 0x80));
+
+	return _mm_xor_si128(must23, special);
+}
+
+//ASCII that isn't C8_isValidAscii: below 0x20 (except tab, new line and carriage return) or 0x7F
+
+static inline __m128i Unicode_checkAscii(__m128i v) {
+
+	const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v);
+
+	const __m128i allowed = _mm_or_si128(
+		_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+		_mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))
+	);
+
+	return _mm_or_si128(_mm_andnot_si128(allowed, control), _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F)));
+}
+
+//Validates the whole 64 byte blocks of ptr[0, len) and returns how many bytes that was (U64_MAX if invalid).
+//A sequence that isn't finished at the end of the last block isn't an error here, the caller continues from its lead.
+//Counts the continuation bytes and the four byte leads in what was validated.
+
+static inline U64 Unicode_validateBlocksUTF8(const U8 *ptr, U64 len, U64 *continuations, U64 *fourByte) {
+
+	//Non zero if the last bytes of the previous vector start a sequence it doesn't finish
+
+	const __m128i incompleteMax = _mm_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (C8)(0xF0 - 1), (C8)(0xE0 - 1), (C8)(0xC0 - 1)
+	);
+
+	__m128i prev = _mm_setzero_si128();
+	__m128i incomplete = _mm_setzero_si128();
+
+	U64 i = 0, conts = 0, fours = 0;
+
+	for (; i + 64 <= len; i += 64) {
+
+		const __m128i v0 = _mm_loadu_si128((const __m128i*) (ptr + i));
+		const __m128i v1 = _mm_loadu_si128((const __m128i*) (ptr + i + 16));
+		const __m128i v2 = _mm_loadu_si128((const __m128i*) (ptr + i + 32));
+		const __m128i v3 = _mm_loadu_si128((const __m128i*) (ptr + i + 48));
+
+		__m128i error = _mm_or_si128(
+			_mm_or_si128(Unicode_checkAscii(v0), Unicode_checkAscii(v1)),
+			_mm_or_si128(Unicode_checkAscii(v2), Unicode_checkAscii(v3))
+		);
+
+		const __m128i any = _mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3));
+
+		//All ASCII, only valid if the previous block didn't leave a sequence open
+
+		if (!_mm_movemask_epi8(any))
+			error = _mm_or_si128(error, incomplete);
+
+		else {
+
+			error = _mm_or_si128(error, _mm_or_si128(Unicode_checkUTF8(v0, prev), Unicode_checkUTF8(v1, v0)));
+			error = _mm_or_si128(error, _mm_or_si128(Unicode_checkUTF8(v2, v1), Unicode_checkUTF8(v3, v2)));
+
+			//Signed compare, so 80..BF are the only values below C0; F0..FF is where max doesn't change it
+
+			const __m128i contEnd = _mm_set1_epi8((C8) 0xC0);
+			const __m128i fourMin = _mm_set1_epi8((C8) 0xF0);
+
+			const U64 contMask =
+				(U64)(U32) _mm_movemask_epi8(_mm_cmpgt_epi8(contEnd, v0)) |
+				((U64)(U32) _mm_movemask_epi8(_mm_cmpgt_epi8(contEnd, v1)) << 16) |
+				((U64)(U32) _mm_movemask_epi8(_mm_cmpgt_epi8(contEnd, v2)) << 32) |
+				((U64)(U32) _mm_movemask_epi8(_mm_cmpgt_epi8(contEnd, v3)) << 48);
+
+			const U64 fourMask =
+				(U64)(U32) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v0, fourMin), v0)) |
+				((U64)(U32) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v1, fourMin), v1)) << 16) |
+				((U64)(U32) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v2, fourMin), v2)) << 32) |
+				((U64)(U32) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v3, fourMin), v3)) << 48);
+
+			conts += Unicode_bitCount(contMask);
+			fours += Unicode_bitCount(fourMask);
+		}
+
+		if(_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF)
+			return U64_MAX;
+
+		incomplete = _mm_subs_epu8(v3, incompleteMax);
+		prev = v3;
+	}
+
+	*continuations = conts;
+	*fourByte = fours;
+	return i;
+}
+
+static inline Bool Unicode_isAscii16(const U8 *ptr) {
+	return !_mm_movemask_epi8(_mm_loadu_si128((const __m128i*) ptr));
+}
+
+static inline void Unicode_widen16(const U8 *ptr, U16 *out) {
+	const __m128i v = _mm_loadu_si128((const __m128i*) ptr);
+	_mm_storeu_si128((__m128i*) out,       _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+	_mm_storeu_si128((__m128i*) (out + 8), _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+}
+
+static inline void Unicode_widen32(const U8 *ptr, U32 *out) {
+
+	const __m128i v = _mm_loadu_si128((const __m128i*) ptr);
+	const __m128i lo = _mm_unpacklo_epi8(v, _mm_setzero_si128());
+	const __m128i hi = _mm_unpackhi_epi8(v, _mm_setzero_si128());
+
+	_mm_storeu_si128((__m128i*) out,        _mm_unpacklo_epi16(lo, _mm_setzero_si128()));
+	_mm_storeu_si128((__m128i*) (out + 4),  _mm_unpackhi_epi16(lo, _mm_setzero_si128()));
+	_mm_storeu_si128((__m128i*) (out + 8),  _mm_unpacklo_epi16(hi, _mm_setzero_si128()));
+	_mm_storeu_si128((__m128i*) (out + 12), _mm_unpackhi_epi16(hi, _mm_setzero_si128()));
+}
+
+//Writes 16 bytes if all 16 units are ASCII
+
+static inline Bool Unicode_narrow16(const U16 *ptr, U8 *out) {
+
+	const __m128i a = _mm_loadu_si128((const __m128i*) ptr);
+	const __m128i b = _mm_loadu_si128((const __m128i*) (ptr + 8));
+	const __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16((I16) 0xFF80));
+
+	if(_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF)
+		return false;
+
+	_mm_storeu_si128((__m128i*) out, _mm_packus_epi16(a, b));
+	return true;
+}
+
+//UTF-8 bytes of 16 UTF-16 units, or 0 if there's a surrogate or invalid ASCII (the caller goes one unit at a time)
+
+static inline U64 Unicode_utf16Block(const U16 *ptr) {
+
+	U64 bytes = 16;
+
+	for (U64 i = 0; i < 2; ++i) {
+
+		const __m128i v = _mm_loadu_si128((const __m128i*) (ptr + i * 8));
+
+		const __m128i surrogate = _mm_cmpeq_epi16(
+			_mm_and_si128(v, _mm_set1_epi16((I16) 0xF800)), _mm_set1_epi16((I16) 0xD800)
+		);
+
+		const __m128i control = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16((I16) 0xFFE0)), _mm_setzero_si128());
+
+		const __m128i allowed = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi16(v, _mm_set1_epi16('\t')), _mm_cmpeq_epi16(v, _mm_set1_epi16('\n'))),
+			_mm_cmpeq_epi16(v, _mm_set1_epi16('\r'))
+		);
+
+		const __m128i bad = _mm_or_si128(
+			_mm_or_si128(surrogate, _mm_andnot_si128(allowed, control)),
+			_mm_cmpeq_epi16(v, _mm_set1_epi16(0x7F))
+		);
+
+		if(_mm_movemask_epi8(bad))
+			return 0;
+
+		//Every unit >= 0x80 takes one byte more and every unit >= 0x800 another (two movemask bits per unit)
+
+		const __m128i small1 = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16((I16) 0xFF80)), _mm_setzero_si128());
+		const __m128i small2 = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16((I16) 0xF800)), _mm_setzero_si128());
+
+		const U64 smallBits =
+			Unicode_bitCount((U32) _mm_movemask_epi8(small1)) + Unicode_bitCount((U32) _mm_movemask_epi8(small2));
+
+		bytes += 16 - smallBits / 2;
+	}
+
+	return bytes;
+}
@@ -0,0 +1,52 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/string_search.h
+
+#pragma once
+#include "types/base/c8.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+//Byte and substring search over ptr[0, len), used by the CharString find, count, split and replace functions.
+//insensitive compares ASCII letters case insensitively, the same as EStringCase_Insensitive does elsewhere.
+//Everything returns U64_MAX when nothing was found.
+//
+//The byte scan looks at 64 bytes per step (SSE2 or NEON compares folded into a 64-bit mask, scalar with SIMD off).
+//The substring search is a SIMD prefilter: a position is only verified if the first and the last byte of the needle
+// both match there, which rules out nearly every position in real text with two compares per 64 bytes.
+
+U64 StringSearch_findByte(const C8 *ptr, U64 len, C8 c, Bool insensitive);
+U64 StringSearch_findLastByte(const C8 *ptr, U64 len, C8 c, Bool insensitive);
+U64 StringSearch_countByte(const C8 *ptr, U64 len, C8 c, Bool insensitive);
+
+//First position that holds a or b (such as '\r' and '\n')
+U64 StringSearch_findEither(const C8 *ptr, U64 len, C8 a, C8 b);
+
+U64 StringSearch_findString(const C8 *ptr, U64 len, const C8 *needle, U64 needleLen, Bool insensitive);
+
+//Non overlapping occurrences, the same way find all and replace all step over a match
+U64 StringSearch_countString(const C8 *ptr, U64 len, const C8 *needle, U64 needleLen, Bool insensitive);
+
+#ifdef __cplusplus
+	}
+#endif
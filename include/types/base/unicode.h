@@ -0,0 +1,58 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/unicode.h
+
+#pragma once
+#include "types/base/c8.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+//Bulk UTF-8, UTF-16 and UTF-32 validation and transcoding for the CharString and Buffer unicode functions.
+//
+//Validity is the same as Buffer_readAsUTF8 / Buffer_readAsUTF16 per code point:
+// UTF-8 has to be well formed (no overlong encodings, surrogates or code points above 0x10FFFF),
+// UTF-16 can't contain unpaired surrogates and ASCII is limited to C8_isValidAscii in both.
+//
+//UTF-8 is validated with a range table lookup per 16 bytes (SSE or NEON) and runs of ASCII skip even that;
+// with SIMD off (or for the last bytes) it's checked one code point at a time.
+//Validation also returns the exact length in the other encodings, so transcoding can allocate once up front.
+
+typedef struct UnicodeLengths {
+	U64 codepoints;             //UTF-32 units
+	U64 utf8;                   //Bytes
+	U64 utf16;                  //U16s
+} UnicodeLengths;
+
+//lengths is optional, it's only written if the input was valid
+Bool Unicode_validateUTF8(const U8 *ptr, U64 len, UnicodeLengths *lengths);
+Bool Unicode_validateUTF16(const U16 *ptr, U64 len, UnicodeLengths *lengths);
+
+//The input has to be valid (see validate) and the output has to fit the lengths it returned.
+
+void Unicode_utf8ToUTF16(const U8 *ptr, U64 len, U16 *out);
+void Unicode_utf8ToUTF32(const U8 *ptr, U64 len, U32 *out);
+void Unicode_utf16ToUTF8(const U16 *ptr, U64 len, U8 *out);
+
+#ifdef __cplusplus
+	}
+#endif
@@ -0,0 +1,121 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/arena.h
+
+#pragma once
+#include "types/base/allocator.h"
+#include "types/base/error.h"
+#include "types/container/hash_map.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+//A bump pointer (linear) allocator made of chunks that come from a parent allocator.
+//Pass &arena->allocator to anything that takes a const Allocator* and all of its allocations become pointer bumps.
+//Freeing is a no-op unless it was the most recent allocation (which is undone), so memory is released in bulk:
+// either with Arena_rewind to a mark taken earlier, or with Arena_free.
+//
+//Meant for short-lived allocation-heavy work (parsing a file, a CLI operation, a single job) from one thread.
+//The arena isn't thread safe and can't be moved after creation, since its allocator points back at it.
+//
+//maxSize limits the bytes held in chunks (0 = unlimited).
+//Once reached, allocations fail with outOfMemory, unless EArenaFlags_FallbackToParent is set,
+// in which case they're forwarded to the parent (and still released by rewind/free like any other allocation).
+//Allocations bigger than chunkSize get a chunk of their own.
+//
+//EArenaFlags_ReportLeaks treats the arena as a regular allocator that expects every allocation to be freed.
+//Anything still alive at a rewind or Arena_free is logged with the stacktrace of where it was allocated,
+// the same way the platform's allocator reports leaks.
+//This is useful to verify that code switched to an arena still frees correctly with any other allocator.
+//The chunks themselves always come from the parent, so a leaked arena shows up in the parent's own leak report.
+
+typedef enum EArenaFlags {
+	EArenaFlags_None                = 0,
+	EArenaFlags_FallbackToParent    = 1 << 0,
+	EArenaFlags_ReportLeaks         = 1 << 1,
+	EArenaFlags_Count               = 2
+} EArenaFlags;
+
+typedef struct ArenaChunk ArenaChunk;
+
+typedef struct ArenaFallback {
+	U64 length, id;
+} ArenaFallback;
+
+typedef struct ArenaAllocation {
+	U64 length, id;
+	StackTrace stack;
+} ArenaAllocation;
+
+THashMapNamed(U64, ArenaFallback, ArenaFallbackMap);
+THashMapNamed(U64, ArenaAllocation, ArenaAllocationMap);
+
+typedef struct Arena {
+
+	Allocator allocator;                //.ptr points to this arena
+
+	const Allocator *parent;
+
+	ArenaChunk *current;                //Newest chunk, links to the ones before it
+	ArenaChunk *spare;                  //Most recently released chunk, kept for reuse
+
+	U64 chunkSize, maxSize;
+	U64 reserved;                       //Bytes held in chunks (spare excluded)
+	U64 lastId;                         //Id of the most recent allocation, marks compare against this
+
+	EArenaFlags flags;
+	U32 padding;
+
+	ArenaFallbackMap fallbacks;         //Allocations forwarded to the parent (location -> length, id)
+	ArenaAllocationMap live;            //Only with EArenaFlags_ReportLeaks (location -> length, id, stack)
+
+} Arena;
+
+//Position to rewind to. Marks have to be rewound in reverse order (like scopes),
+// rewinding to a mark taken before another rewind's mark is fine, the other way around isn't.
+
+typedef struct ArenaMark {
+	ArenaChunk *chunk;
+	U64 used, lastId;
+} ArenaMark;
+
+//chunkSize 0 picks a default (64KiB)
+Bool Arena_create(
+	U64 chunkSize, U64 maxSize, EArenaFlags flags, const Allocator *parent, Arena *result, Error *e_rr
+);
+
+void Arena_free(Arena *arena);
+
+ArenaMark Arena_mark(const Arena *arena);
+
+//Releases everything allocated after mark in one go.
+//Returns the number of allocations that were still alive (only tracked with EArenaFlags_ReportLeaks).
+U64 Arena_rewind(Arena *arena, ArenaMark mark);
+
+static inline U64 Arena_reset(Arena *arena) { return Arena_rewind(arena, (ArenaMark) { 0 }); }
+
+//Only tracked with EArenaFlags_ReportLeaks
+static inline U64 Arena_liveAllocations(const Arena *arena) { return arena ? ArenaAllocationMap_length(arena->live) : 0; }
+
+#ifdef __cplusplus
+	}
+#endif
@@ -54,8 +54,21 @@ Bool BigInt_mul(BigInt *a, BigInt b, const Allocator *allocator, Error *e_rr);
 Bool BigInt_add(BigInt *a, BigInt b);                                            //Add on self and keep bit count
 Bool BigInt_sub(BigInt *a, BigInt b);                                            //Subtract on self and keep bit count
 
-//Bool BigInt_mod(BigInt *a, BigInt b);
-//Bool BigInt_div(BigInt *a, BigInt b);
+//Divide self by b and keep bit count, remainder is optional and receives a % b.
+//remainder has to be big enough to hold the result (it keeps its bit count) and can't be a.
+//Errors with divideByZero if b is 0.
+Bool BigInt_divMod(BigInt *a, BigInt b, BigInt *remainder, const Allocator *allocator, Error *e_rr);
+
+static inline Bool BigInt_div(BigInt *a, BigInt b, const Allocator *allocator, Error *e_rr) {
+	return BigInt_divMod(a, b, NULL, allocator, e_rr);
+}
+
+Bool BigInt_mod(BigInt *a, BigInt b, const Allocator *allocator, Error *e_rr);        //a % b on self, keeps bit count
+
+//a = a^exponent % modulus, keeps bit count (so a needs to be able to hold modulus - 1).
+//Odd moduli (the common case; primes, RSA) use Montgomery multiplication, even ones fall back to divMod.
+//This is variable time, so it shouldn't be used with a secret exponent where timing can be observed.
+Bool BigInt_powMod(BigInt *a, BigInt exponent, BigInt modulus, const Allocator *allocator, Error *e_rr);
 
 //Bitwise
 
@@ -198,6 +211,10 @@ static inline Bool BigInt_nyto(const BigIntStringify *stringify, BigInt b, Error
 	return BigInt_base2(stringify, EIntEncoding_Nyto, b, e_rr);
 }
 
+static inline Bool BigInt_dec(const BigIntStringify *stringify, BigInt b, Error *e_rr) {
+	return BigInt_toString(stringify, EIntEncoding_Dec, b, e_rr);
+}
+
 #ifdef __cplusplus
 	}
 #endif
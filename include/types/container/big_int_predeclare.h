@@ -36,9 +36,10 @@ typedef struct Error Error;
 typedef struct Allocator Allocator;
 typedef struct CharString CharString;
 
-//BigInt allow up to 16320 bit ints but isn't well optimized.
-//For optimized versions please use U128 (and U256 in the future) since they don't dynamically allocate,
-// and because big int can be varying length so no SIMD optimizations are present.
+//BigInt allow up to 16320 bit ints.
+//For small fixed sizes please use U128 (and U256 in the future) since they don't dynamically allocate.
+//Multiplication switches to Karatsuba once both sides are long enough, division is Knuth's algorithm D,
+// powMod uses Montgomery reduction for odd moduli and decimal conversion splits the number by powers of 10.
 typedef struct BigInt {
 
 	union {
@@ -79,8 +80,9 @@ typedef enum EIntEncoding {
 	EIntEncoding_Bin,
 	EIntEncoding_Oct,
 	EIntEncoding_Nyto,
+	EIntEncoding_Dec,
 	EIntEncoding_Count,
-	EIntEncoding_Base2End = EIntEncoding_Count        //TODO: If dec is added, keep this in mind!
+	EIntEncoding_Base2End = EIntEncoding_Dec
 } EIntEncoding;
 
 Bool BigInt_createFromBase2Type(const BigIntCreate *bigIntCreate, EIntEncoding type, Error *e_rr);
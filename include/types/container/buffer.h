@@ -30,6 +30,7 @@
 
 typedef struct Error Error;
 typedef struct Allocator Allocator;
+typedef struct JobQueue JobQueue;
 
 //All these functions allocate, so Buffer_free them later
 
@@ -127,6 +128,8 @@ static inline Bool Buffer_isUTF16(const Buffer buf, F32 threshold) { return Buff
 //hash/crc32c: Hashmaps / performance critical hashing /
 //    fast data integrity (encryption checksum / compression) when *NOT* dealing with adversaries
 //
+//hash/hash64 (XXH3): Hashmaps / deduplication / cache keys, same as crc32c *NOT* when dealing with adversaries
+//
 //hash/sha256: data integrity (encryption checksum / compression) when dealing with adversaries
 //
 //encryption/aes256: If you want to recover data that is essential (NOT PASSWORDS) but needs a key
@@ -147,6 +150,15 @@ static inline U32 Buffer_crc32c(const Buffer buf) {
 	return Buffer_crc32cChained(buf, 0);
 }
 
+//CRC of a || b from the CRCs of a and b, only b's length is needed (a can be any length).
+//Buffer_crc32cChained(b, crcA) == Buffer_crc32cCombine(crcA, Buffer_crc32c(b), Buffer_length(b)).
+U32 Buffer_crc32cCombine(U32 crcA, U32 crcB, U64 lenB);
+
+//Splits big buffers in chunks that are hashed by queue and combined after, to use multiple cores on a multi GB file.
+//Small buffers (or a NULL or single threaded queue) are hashed inline.
+//This waits for queue, so it has to be called by the thread that owns it (not from inside a job).
+Bool Buffer_crc32cParallel(const Buffer buf, JobQueue *queue, U32 *result, Error *e_rr);
+
 //Fowler-Noll-Vo-1A 64-bit (fast non HW accelerated hashes)
 
 static const U64 Buffer_fnv1a64Offset = 0xCBF29CE484222325;
@@ -155,6 +167,45 @@ static const U64 Buffer_fnv1a64Prime = 0x00000100000001B3;
 U64 Buffer_fnv1a64Single(U64 a, U64 hash);
 U64 Buffer_fnv1a64(const Buffer buf, U64 hash);        //Put hash as Buffer_fnv1a64Offset if none
 
+//XXH3 64 and 128-bit, seedable non cryptographic hashes for hash maps, deduplication and cache keys.
+//Output is the same as xxHash's XXH3_64bits_withSeed / XXH3_128bits_withSeed, so it can be checked against xxhsum.
+//Long inputs are hashed 64 bytes at a time by SIMD (SSE, AVX2, AVX512 or NEON), many times faster than FNV1A64.
+//Seed 0 is the default seed of xxHash.
+
+typedef struct Hash128 { U64 lo, hi; } Hash128;
+
+U64 Buffer_hash64(const Buffer buf, U64 seed);
+Hash128 Buffer_hash128(const Buffer buf, U64 seed);
+
+//Streaming version, for input that comes in parts (e.g. StreamCursor_hash).
+//The digest of all parts is the same as Buffer_hash64/128 of the parts concatenated.
+//Digesting doesn't modify the state, so it can be updated again after.
+
+#define Buffer_hashSecretSize 192
+#define Buffer_hashBufferSize 256
+
+typedef struct BufferHashState {
+	U64 acc[8];
+	U64 seed, length;
+	U64 stripesInBlock;
+	U16 buffered;
+	U8 padding[6];
+	U8 secret[Buffer_hashSecretSize];
+	U8 buffer[Buffer_hashBufferSize];
+} BufferHashState;
+
+void BufferHashState_create(U64 seed, BufferHashState *state);
+void BufferHashState_update(BufferHashState *state, const Buffer buf);
+U64 BufferHashState_digest64(const BufferHashState *state);
+Hash128 BufferHashState_digest128(const BufferHashState *state);
+
+//The XXH3 stripe loop, provided by the SIMD backend; the fallbacks are plain C (but don't manually call either).
+//acc[i ^ 1] += data[i], acc[i] += lo32(data[i] ^ secret[i]) * hi32(...) per stripe, secret advances 8 bytes a stripe.
+void Buffer_hashAccumulate(U64 acc[8], const U8 *ptr, U64 stripes, const U8 *secret);
+void Buffer_hashScramble(U64 acc[8], const U8 *secret);
+void Buffer_hashAccumulateFallback(U64 acc[8], const U8 *ptr, U64 stripes, const U8 *secret);
+void Buffer_hashScrambleFallback(U64 acc[8], const U8 *secret);
+
 //MD5
 
 typedef struct MD5Hash { U32 v[4]; } MD5Hash;
@@ -166,6 +217,18 @@ MD5Hash Buffer_md5(const Buffer buf);
 void Buffer_sha256(const Buffer buf, U32 output[8]);
 void Buffer_sha256Fallback(const Buffer buf, U32 *output);        //In case of no native SHA256, but don't manually call
 
+//Multi-buffer SHA256, outputs[i] is what Buffer_sha256 returns for bufs[i].
+//Many small inputs (files in a folder, shader sources) are hashed 4, 8 or 16 at a time in the lanes of one register
+// (SSE/NEON, AVX2, AVX512), instead of one after the other each with its own setup and serial chain of rounds.
+//lanes is the number of messages at once: 0 picks the fastest for this CPU.
+//4, 8 or 16 force that width (or the widest one below it the CPU supports) and 1 calls Buffer_sha256 per buffer.
+//Returns the lanes that were used (always 1 without SIMD).
+U8 Buffer_sha256BatchLanes(const Buffer *bufs, U64 count, U32 (*outputs)[8], U8 lanes);
+
+static inline void Buffer_sha256Batch(const Buffer *bufs, U64 count, U32 (*outputs)[8]) {
+	Buffer_sha256BatchLanes(bufs, count, outputs, 0);
+}
+
 //Cryptographically secure random on a sized buffer
 
 Bool Buffer_csprng(const Buffer target);
@@ -171,6 +171,14 @@ namespace oxc {
 			return c::Buffer_crc32c(self);
 		}
 
+		[[nodiscard]] static c::U32 crc32cCombine(c::U32 crcA, c::U32 crcB, c::U64 lenB) noexcept {
+			return c::Buffer_crc32cCombine(crcA, crcB, lenB);
+		}
+
+		[[nodiscard]] c::Bool crc32cParallel(c::JobQueue *queue, c::U32 *result, c::Error *e_rr = nullptr) const noexcept {
+			return c::Buffer_crc32cParallel(self, queue, result, e_rr);
+		}
+
 		[[nodiscard]] static c::U64 fnv1a64Single(c::U64 a, c::U64 hash) noexcept {
 			return c::Buffer_fnv1a64Single(a, hash);
 		}
@@ -179,6 +187,14 @@ namespace oxc {
 			return c::Buffer_fnv1a64(self, hash);
 		}
 
+		[[nodiscard]] c::U64 hash64(c::U64 seed = 0) const noexcept {
+			return c::Buffer_hash64(self, seed);
+		}
+
+		[[nodiscard]] c::Hash128 hash128(c::U64 seed = 0) const noexcept {
+			return c::Buffer_hash128(self, seed);
+		}
+
 		[[nodiscard]] c::MD5Hash md5() const noexcept {
 			return c::Buffer_md5(self);
 		}
@@ -191,6 +207,14 @@ namespace oxc {
 			c::Buffer_sha256Fallback(self, output);
 		}
 
+		static c::U8 sha256BatchLanes(const c::Buffer *bufs, c::U64 count, c::U32 (*outputs)[8], c::U8 lanes) noexcept {
+			return c::Buffer_sha256BatchLanes(bufs, count, outputs, lanes);
+		}
+
+		static void sha256Batch(const c::Buffer *bufs, c::U64 count, c::U32 (*outputs)[8]) noexcept {
+			c::Buffer_sha256Batch(bufs, count, outputs);
+		}
+
 		[[nodiscard]] c::Bool csprng() const noexcept {
 			return c::Buffer_csprng(self);
 		}
@@ -0,0 +1,90 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/buffer_compress.h
+
+#pragma once
+#include "types/container/list_basic_types.h"
+#include "types/base/buffer_base.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+//LZ77 codec (literal runs and matches of up to 64KiB back), tuned for fast decompression over ratio.
+//A block is a list of sequences, every sequence is:
+//  U8 token (literal count in the upper nibble, match length - 4 in the lower; 15 = more bytes follow)
+//  U8 extraLiterals[] (each 255 adds 255 and continues, anything else adds itself and ends)
+//  U8 literals[literal count]
+//  if not the end of the block:
+//      U16 offset (1 to 65535, how far back the match starts)
+//      U8 extraMatch[] (same as extraLiterals)
+//The last sequence only has literals (possibly none).
+
+static const U32 BufferCompress_blockSize = 65536;
+
+//Worst case size of a compressed block of length bytes (incompressible data)
+static inline U64 Buffer_compressBlockBound(U64 length) { return length + length / 255 + 16; }
+
+//Compresses input (at most BufferCompress_blockSize) into output, which has to fit Buffer_compressBlockBound.
+//*written is the size of the compressed block.
+Bool Buffer_compressBlock(Buffer input, Buffer output, U64 *written, Error *e_rr);
+
+//Decompresses a block into output, which has to be exactly as big as the uncompressed block.
+//Malformed input fails rather than reading or writing out of bounds.
+Bool Buffer_decompressBlock(Buffer input, Buffer output, Error *e_rr);
+
+//Data bigger than a block is compressed as independent blocks, so they can be decompressed in parallel or seeked into:
+//  BufferCompressBlock blocks[BufferCompress_blockCount(uncompressedSize)];
+//  U8 data[];        //Every block back to back
+//A block that didn't get smaller is stored as is, which is when its size is the length of the uncompressed block.
+
+typedef struct BufferCompressBlock {
+	U32 size;                //Compressed size
+	U32 crc32c;              //Of the uncompressed block
+} BufferCompressBlock;
+
+static inline U64 BufferCompress_blockCount(U64 uncompressedSize) {
+	return (uncompressedSize + BufferCompress_blockSize - 1) / BufferCompress_blockSize;
+}
+
+//Appends the compressed block (at most BufferCompress_blockSize) to data and returns its size and checksum in *block.
+//To build the blocked layout one block at a time, reserve the table at the start of data first.
+Bool BufferCompress_appendBlock(
+	Buffer input,
+	ListU8 *data,
+	BufferCompressBlock *block,
+	const Allocator *alloc,
+	Error *e_rr
+);
+
+//Validates and decompresses a single block of the blocked layout.
+//input is its compressed (or stored) data and output the uncompressed block.
+Bool BufferCompress_decodeBlock(Buffer input, BufferCompressBlock block, Buffer output, Error *e_rr);
+
+//Compresses input into the blocked layout (output is allocated)
+Bool Buffer_compress(Buffer input, const Allocator *alloc, Buffer *output, Error *e_rr);
+
+//Decompresses the blocked layout into output, which has to be as big as the uncompressed data.
+Bool Buffer_decompress(Buffer input, Buffer output, Error *e_rr);
+
+#ifdef __cplusplus
+	}
+#endif
@@ -30,6 +30,8 @@
 	extern "C" {
 #endif
 
+typedef struct JobQueue JobQueue;
+
 //AES256GCM encryption with auto generated iv.
 //Encrypt function encrypts target into target (in place).
 //Be careful about the following:
@@ -98,6 +100,11 @@ typedef struct BufferEncrypt {
 	//Whether to use supplied keys or generate new ones (currently encryption only).
 	EBufferEncryptionFlags flags;
 
+	//Optional; splits a big target (at least 8 MiB) in chunks that are en/decrypted by the queue.
+	//The partial GHASHes are combined after, so ciphertext and tag are the same as without a queue.
+	//This waits for queue, so it has to be called by the thread that owns it (not from inside a job).
+	JobQueue *queue;
+
 	union {
 
 		struct {
@@ -216,6 +223,12 @@ void Buffer_aesExpertDecUpdate(
 //It's OK to ignore the result for encryption, since there's no valid tag yet.
 Bool Buffer_aesExpertFinalize(AESEncryptionContext *restrict ctx, U64 aadLen, U64 dataLen, I32x4 expectTag);
 
+//CPUs without AES and carry-less multiply use a constant-time bitsliced AES-CTR + GHASH (no tables),
+// which gives the exact same ciphertext and tags, just slower.
+//Forcing it is for tests and benchmarks only; it's global, not thread safe and it has to be set before a context is
+// created (Buffer_aesExpertCreate picks the H table and block size based on it).
+void Buffer_aesForceSoftware(Bool force);
+
 #ifdef __cplusplus
 	}
 #endif
@@ -0,0 +1,81 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/compression_stream.h
+
+#pragma once
+#include "types/container/stream.h"
+#include "types/container/buffer_compress.h"
+#include "types/base/atomic.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+typedef struct JobQueue JobQueue;
+
+//Readonly stream of the uncompressed data of the blocked layout (see buffer_compress.h) in another stream.
+//Only the blocks a read touches are decompressed, so it can be seeked into.
+
+typedef struct CompressionStream {
+
+	OxStream parent;
+
+	StreamRef *dataStream;        //The physical stream represented by this virtual one.
+
+	U64 blockCount;
+	Buffer blockData;                   //blockOffsets then blocks
+	U64 *blockOffsets;                  //Where every block starts in dataStream (and where the last one ends)
+	BufferCompressBlock *blocks;
+
+	Buffer internalCache;        //Compressed and decompressed block (2x BufferCompress_blockSize)
+	U64 cachedBlock;             //Block decompressed in the second half of internalCache (U64_MAX = none)
+	AtomicI64 cacheInUse;        //A concurrent read (e.g. read-ahead) uses a temporary cache instead
+
+	JobQueue *queue;            //Optional, see CompressionStream_setJobQueue
+	U64 queueThread;            //Thread_getId() of the thread that set the queue
+
+	//The stream owns its type, so it lives exactly as long as the stream does.
+	//Readers (e.g. oiDL) create one without needing a type from the caller that outlives the file.
+
+	RefPtrType type;
+
+} CompressionStream;
+
+typedef RefPtr CompressionStreamRef;
+
+Bool CompressionStream_create(
+	StreamRef *dataStream,
+	U64 streamOffset,            //Where the blocked layout starts
+	U64 compressedSize,          //Of the blocked layout (including its block table)
+	U64 size,                    //Uncompressed size
+	const Allocator *alloc,
+	CompressionStreamRef **compStream,
+	Error *e_rr
+);
+
+//Lets reads that span at least two whole blocks decompress them concurrently on queue (NULL = serial).
+//The compressed blocks are read first (on the calling thread), so only decompression happens on the queue.
+//Same constraints as EncryptionStream_setJobQueue: only reads from the thread that set the queue use it.
+Bool CompressionStream_setJobQueue(CompressionStreamRef *compStream, JobQueue *queue, Error *e_rr);
+
+#ifdef __cplusplus
+	}
+#endif
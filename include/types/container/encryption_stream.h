@@ -22,10 +22,13 @@
 
 #pragma once
 #include "types/container/stream.h"
+#include "types/base/atomic.h"
 
 #ifdef __cplusplus
 	extern "C" {
 #endif
+
+typedef struct JobQueue JobQueue;
 		
 typedef struct EncryptionStream {
 
@@ -44,6 +47,10 @@ typedef struct EncryptionStream {
 	U8 pad[7];
 
 	Buffer internalCache;        //sizeof(CryptoChunk) + chunkSize
+	AtomicI64 cacheInUse;        //A concurrent read (e.g. read-ahead) uses a temporary cache instead
+
+	JobQueue *queue;            //Optional, see EncryptionStream_setJobQueue
+	U64 queueThread;            //Thread_getId() of the thread that set the queue
 
 } EncryptionStream;
 
@@ -74,6 +81,13 @@ Bool EncryptionStream_create(
 	Error *e_rr
 );
 
+//Lets reads that span at least two whole chunks read, decrypt and verify them concurrently on queue (NULL = serial).
+//The result (and any error) is the same as decrypting them one by one.
+//Only reads from the calling thread use the queue, since JobQueue_wait has to be called by the queue's owner.
+//Reads from another thread (e.g. StreamCursor_enableReadAhead's worker) stay serial.
+//queue has to outlive its use by the stream (or be unset before it's freed).
+Bool EncryptionStream_setJobQueue(EncryptionStreamRef *encStream, JobQueue *queue, Error *e_rr);
+
 #ifdef __cplusplus
 	}
 #endif
@@ -32,6 +32,7 @@
 
 typedef struct Allocator Allocator;
 typedef struct Error Error;
+typedef struct JobQueue JobQueue;
 
 void ListU64_free(ListU64 *indices, const Allocator *allocator);
 
@@ -362,6 +363,12 @@ Bool GenericList_resize(GenericList *list, U64 size, const Allocator *allocator,
 
 Bool GenericList_shrinkToFit(GenericList *list, const Allocator *allocator, Error *e_rr);
 
+//Radix sorts; the stride has to match the type.
+//sortX is an in place MSD radix sort, it keeps the signature without an allocator since callers such as
+// GenericList_eraseAll and the descriptor layouts sort without one.
+//sortRadixX is an LSD radix sort, usually faster on big lists but it needs a temp buffer (from alloc).
+//Floats order -0 before +0 and NaNs by sign bit (after +inf or before -inf).
+
 Bool GenericList_sortU64(GenericList list);
 Bool GenericList_sortU32(GenericList list);
 Bool GenericList_sortU16(GenericList list);
@@ -375,11 +382,42 @@ Bool GenericList_sortI8(GenericList list);
 Bool GenericList_sortF32(GenericList list);
 Bool GenericList_sortF64(GenericList list);
 
+Bool GenericList_sortRadixU64(GenericList list, const Allocator *alloc, Error *e_rr);
+Bool GenericList_sortRadixU32(GenericList list, const Allocator *alloc, Error *e_rr);
+Bool GenericList_sortRadixU16(GenericList list, const Allocator *alloc, Error *e_rr);
+Bool GenericList_sortRadixU8(GenericList list, const Allocator *alloc, Error *e_rr);
+
+Bool GenericList_sortRadixI64(GenericList list, const Allocator *alloc, Error *e_rr);
+Bool GenericList_sortRadixI32(GenericList list, const Allocator *alloc, Error *e_rr);
+Bool GenericList_sortRadixI16(GenericList list, const Allocator *alloc, Error *e_rr);
+Bool GenericList_sortRadixI8(GenericList list, const Allocator *alloc, Error *e_rr);
+
+Bool GenericList_sortRadixF32(GenericList list, const Allocator *alloc, Error *e_rr);
+Bool GenericList_sortRadixF64(GenericList list, const Allocator *alloc, Error *e_rr);
+
 //Only allowed when the stride is <= 1024 (it needs to copy to a temp buffer)
 //context is handed to func untouched on every comparison; pass NULL when the comparator doesn't need it.
+//Pattern-defeating quicksort: O(n log n) worst case, linear on sorted or reversed input, not stable.
 
 Bool GenericList_sortCustom(GenericList list, CompareFunction func, void *context);
 
+//Like sortCustom but stable (equal elements keep their order); a merge sort that needs a temp copy of the list.
+Bool GenericList_sortStable(GenericList list, CompareFunction func, void *context, const Allocator *alloc, Error *e_rr);
+
+//Like sortCustom, but chunks are sorted and merged as jobs on queue (needs a temp copy of the list).
+//Waits for the queue, so it has to be called by the thread that owns it, not from a job (and shouldn't be called
+// while unrelated jobs are in flight either, as it waits for those too).
+//func has to be safe to call from multiple threads at once.
+//Small lists or a single threaded queue just use sortCustom.
+Bool GenericList_sortParallel(
+	GenericList list,
+	CompareFunction func,
+	void *context,
+	JobQueue *queue,
+	const Allocator *alloc,
+	Error *e_rr
+);
+
 Bool GenericList_sortString(GenericList list, EStringCase stringCase);
 
 static inline Bool GenericList_sortStringSensitive(GenericList list) {
@@ -0,0 +1,237 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/hash_map.h
+
+#pragma once
+#include "types/base/buffer_base.h"
+#include "types/base/algorithm.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+typedef struct Allocator Allocator;
+typedef struct Error Error;
+
+//An open addressing hash map for POD keys and values, the hashed counterpart of GenericList.
+//
+//Every slot has a control byte: HashMap_ctrlEmpty or the top 7 bits of the key's hash.
+//Lookups compare a whole group of control bytes against those 7 bits at once (SSE/NEON, or a plain loop when SIMD
+// is off), so most misses never touch a key and a hit usually compares exactly one.
+//Probing is linear per slot, which is what lets erase shift the rest of the run back instead of leaving a
+// tombstone behind: a map that sees lots of erases doesn't slowly fill up with dead slots and never has to be
+// rehashed just to clean them.
+//
+//The control bytes are followed by HashMap_groupSize - 1 mirrored ones, so a group starting near the end can be
+// loaded unaligned without wrapping.
+//Keys and values live in two separate arrays (so a set, with valueStride 0, costs nothing extra).
+//
+//hash may be NULL to hash the raw key bytes and eq may be NULL to compare them (like GenericList_find).
+//Whatever hash returns is mixed again before use, so an identity hash on pointers or indices is fine.
+//
+//Slots move when the map grows and when something is erased, so pointers to keys or values are only valid until
+// the next insert or erase.
+//Iterate with GenericHashMap_next, but don't erase while doing so (a shifted entry could be skipped or seen twice).
+
+#define HashMap_groupSize 16
+#define HashMap_ctrlEmpty ((U8)0x80)
+
+typedef struct GenericHashMap {
+
+	Buffer data;                //ctrl (capacity + groupSize - 1, padded) then keys then values; NULL if never allocated
+
+	U8 *ctrl;
+	U8 *keys;
+	U8 *values;
+
+	U64 keyStride, valueStride;
+	U64 length, capacity;       //capacity is 0 or a power of two >= HashMap_groupSize
+
+	HashFunction hash;
+	EqualsFunction eq;
+
+} GenericHashMap;
+
+//capacity is the number of elements to reserve for, 0 allocates on first insert.
+//keyStride is required, valueStride can be 0 to create a set.
+//result has to be zero initialized.
+Bool GenericHashMap_create(
+	U64 keyStride,
+	U64 valueStride,
+	HashFunction hash,
+	EqualsFunction eq,
+	U64 capacity,
+	const Allocator *alloc,
+	GenericHashMap *result,
+	Error *e_rr
+);
+
+void GenericHashMap_free(GenericHashMap *map, const Allocator *alloc);
+
+//Makes sure capacity elements fit without growing again.
+Bool GenericHashMap_reserve(GenericHashMap *map, U64 capacity, const Allocator *alloc, Error *e_rr);
+
+//Removes all entries but keeps the memory.
+void GenericHashMap_clear(GenericHashMap *map);
+
+//Returns the slot of key or U64_MAX if it isn't present.
+U64 GenericHashMap_findSlot(const GenericHashMap *map, const void *key);
+
+//Finds key or inserts it, *slot is where it lives now and *inserted says which one happened.
+//A new entry's value is zeroed, so the caller can fill it in through GenericHashMap_valueAt.
+Bool GenericHashMap_emplace(
+	GenericHashMap *map, const void *key, const Allocator *alloc, U64 *slot, Bool *inserted, Error *e_rr
+);
+
+//Inserts key; error (alreadyDefined) if it was already present.
+//value can be NULL for a set (or to zero the value).
+Bool GenericHashMap_insert(GenericHashMap *map, const void *key, const void *value, const Allocator *alloc, Error *e_rr);
+
+//Inserts key or overwrites the value if it was already present.
+Bool GenericHashMap_set(GenericHashMap *map, const void *key, const void *value, const Allocator *alloc, Error *e_rr);
+
+//Removes key, copying its value to valueOut first if it's not NULL.
+//Returns false if key wasn't present.
+Bool GenericHashMap_erase(GenericHashMap *map, const void *key, void *valueOut);
+
+//First occupied slot >= slot, U64_MAX if none remain.
+//for(U64 i = GenericHashMap_next(&m, 0); i != U64_MAX; i = GenericHashMap_next(&m, i + 1))
+U64 GenericHashMap_next(const GenericHashMap *map, U64 slot);
+
+static inline Bool GenericHashMap_contains(const GenericHashMap *map, const void *key) {
+	return GenericHashMap_findSlot(map, key) != U64_MAX;
+}
+
+static inline const void *GenericHashMap_keyAt(const GenericHashMap *map, U64 slot) {
+	return map && slot < map->capacity ? map->keys + slot * map->keyStride : NULL;
+}
+
+static inline void *GenericHashMap_valueAt(const GenericHashMap *map, U64 slot) {
+	return map && slot < map->capacity && map->valueStride ? map->values + slot * map->valueStride : NULL;
+}
+
+static inline void *GenericHashMap_find(const GenericHashMap *map, const void *key) {
+	return GenericHashMap_valueAt(map, GenericHashMap_findSlot(map, key));
+}
+
+//Hash and equals for CharString keys (the CharString struct is the key, so it has to outlive the entry)
+U64 GenericHashMap_hashString(const void *a);
+Bool GenericHashMap_equalsString(const void *a, const void *b);
+
+//THashMap is to GenericHashMap what TList is to GenericList: the same map, but typed.
+//The typed functions are one line forwards, so they're all static inline and no Impl macro is needed.
+
+#define THashMapNamedBase(Name)                                                                                     \
+																													\
+static inline Bool Name##_createCustom(                                                                             \
+	U64 capacity, HashFunction hash, EqualsFunction eq, const Allocator *alloc, Name *result, Error *e_rr           \
+) {                                                                                                                 \
+	return GenericHashMap_create(                                                                                   \
+		sizeof(Name##_Key), Name##_valueStride, hash, eq, capacity, alloc, result ? &result->map : NULL, e_rr       \
+	);                                                                                                              \
+}                                                                                                                   \
+																													\
+static inline Bool Name##_create(U64 capacity, const Allocator *alloc, Name *result, Error *e_rr) {                 \
+	return Name##_createCustom(capacity, NULL, NULL, alloc, result, e_rr);                                          \
+}                                                                                                                   \
+																													\
+static inline void Name##_free(Name *m, const Allocator *alloc) { if(m) GenericHashMap_free(&m->map, alloc); }      \
+static inline void Name##_clear(Name *m) { if(m) GenericHashMap_clear(&m->map); }                                   \
+static inline U64 Name##_length(const Name m) { return m.map.length; }                                              \
+static inline Bool Name##_empty(const Name m) { return !m.map.length; }                                             \
+																													\
+static inline Bool Name##_reserve(Name *m, U64 capacity, const Allocator *alloc, Error *e_rr) {                     \
+	return GenericHashMap_reserve(m ? &m->map : NULL, capacity, alloc, e_rr);                                       \
+}                                                                                                                   \
+																													\
+static inline Bool Name##_contains(const Name *m, Name##_Key key) {                                                 \
+	return m && GenericHashMap_contains(&m->map, &key);                                                             \
+}                                                                                                                   \
+																													\
+static inline Bool Name##_erase(Name *m, Name##_Key key) {                                                          \
+	return m && GenericHashMap_erase(&m->map, &key, NULL);                                                          \
+}                                                                                                                   \
+																													\
+static inline U64 Name##_next(const Name *m, U64 slot) { return !m ? U64_MAX : GenericHashMap_next(&m->map, slot); } \
+																													\
+static inline Name##_Key Name##_keyAt(const Name *m, U64 slot) {                                                    \
+	return *(const Name##_Key*) GenericHashMap_keyAt(&m->map, slot);                                                \
+}
+
+#define THashMapNamed(K, V, Name)                                                                                   \
+																													\
+typedef K Name##_Key;                                                                                               \
+typedef V Name##_Value;                                                                                             \
+typedef struct Name { GenericHashMap map; } Name;                                                                   \
+static const U64 Name##_valueStride = sizeof(V);                                                                    \
+																													\
+THashMapNamedBase(Name)                                                                                             \
+																													\
+static inline Bool Name##_insert(Name *m, Name##_Key key, Name##_Value v, const Allocator *alloc, Error *e_rr) {    \
+	return GenericHashMap_insert(m ? &m->map : NULL, &key, &v, alloc, e_rr);                                        \
+}                                                                                                                   \
+																													\
+static inline Bool Name##_set(Name *m, Name##_Key key, Name##_Value v, const Allocator *alloc, Error *e_rr) {       \
+	return GenericHashMap_set(m ? &m->map : NULL, &key, &v, alloc, e_rr);                                           \
+}                                                                                                                   \
+																													\
+static inline Name##_Value *Name##_find(const Name *m, Name##_Key key) {                                            \
+	return !m ? NULL : (Name##_Value*) GenericHashMap_find(&m->map, &key);                                          \
+}                                                                                                                   \
+																													\
+static inline Bool Name##_get(const Name *m, Name##_Key key, Name##_Value *v) {                                     \
+	const Name##_Value *found = Name##_find(m, key);                                                                \
+	if(found && v) *v = *found;                                                                                     \
+	return found != NULL;                                                                                           \
+}                                                                                                                   \
+																													\
+static inline Bool Name##_pop(Name *m, Name##_Key key, Name##_Value *v) {                                           \
+	return m && GenericHashMap_erase(&m->map, &key, v);                                                             \
+}                                                                                                                   \
+																													\
+static inline Name##_Value *Name##_valueAt(const Name *m, U64 slot) {                                               \
+	return (Name##_Value*) GenericHashMap_valueAt(&m->map, slot);                                                   \
+}
+
+#define THashSetNamed(T, Name)                                                                                      \
+																													\
+typedef T Name##_Key;                                                                                               \
+typedef struct Name { GenericHashMap map; } Name;                                                                   \
+static const U64 Name##_valueStride = 0;                                                                            \
+																													\
+THashMapNamedBase(Name)                                                                                             \
+																													\
+/* Returns false on error, *inserted (optional) is false if it was already present */                             \
+static inline Bool Name##_add(Name *m, Name##_Key key, const Allocator *alloc, Bool *inserted, Error *e_rr) {       \
+	U64 slot = U64_MAX;                                                                                             \
+	Bool tmp = false;                                                                                               \
+	return GenericHashMap_emplace(m ? &m->map : NULL, &key, alloc, &slot, inserted ? inserted : &tmp, e_rr);        \
+}
+
+#define THashMap(K, V) THashMapNamed(K, V, HashMap##K##V)
+#define THashSet(T) THashSetNamed(T, HashSet##T)
+
+THashSet(U64);
+THashMap(U64, U64);
+
+#ifdef __cplusplus
+	}
+#endif
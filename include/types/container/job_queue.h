@@ -81,7 +81,7 @@ typedef struct Job {
 TList(Job);
 TListNamed(Thread*, ListThreadHandle);
 
-//JobQueue is a simple FIFO work queue built on SpinLock + Thread + AtomicI64.
+//JobQueue is a simple FIFO work queue built on Mutex + Thread + AtomicI64.
 //It has two modes, selected at create time:
 //- threadCount <= 1: single threaded mode.
 //  No worker threads are created.
@@ -91,14 +91,43 @@ TListNamed(Thread*, ListThreadHandle);
 //  and the thread calling JobQueue_wait participates as the final execution context,
 //  so there are exactly threadCount contexts.
 //The struct is address stable after create (workers hold a pointer to it); don't move or copy it.
+//
+//EJobQueueFlags_WorkStealing changes how the multi threaded mode schedules (single threaded mode ignores it):
+//Every execution context gets its own Chase-Lev deque and a job pushed from inside a running job goes to the
+// deque of the context running it, without taking the lock.
+//A context runs the newest job of its own deque first (the children it just pushed are still in cache),
+// then the shared FIFO (jobs pushed from outside a job), then steals the oldest job of a random other context.
+//This is what fan-out heavy work (precompile -> compile -> link) wants; with a flat list of independent jobs
+// pushed from the owner it behaves like the FIFO mode.
+//Jobs are no longer started in push order then, but they never were with more than one context either.
+
+typedef enum EJobQueueFlags {
+	EJobQueueFlags_None             = 0,
+	EJobQueueFlags_WorkStealing     = 1 << 0,
+	EJobQueueFlags_Count            = 1
+} EJobQueueFlags;
+
+//Jobs with a higher priority are taken before any job with a lower one (but never interrupt a running job).
+//Meant for the few latency-critical jobs everything else waits on (e.g. a finalize that writes an oiSH),
+// so they don't queue up behind bulk work.
+//High priority jobs always go through the shared FIFO, also when pushed from inside a job with work stealing.
+
+typedef enum EJobPriority {
+	EJobPriority_Normal,
+	EJobPriority_High,
+	EJobPriority_Count
+} EJobPriority;
+
+typedef struct JobQueueDeque JobQueueDeque;
 
 typedef struct JobQueue {
 
-	ListJob jobs;                   //FIFO, guarded by lock
-	ListThreadHandle threads;       //threadCount - 1 workers, empty in single threaded mode
+	ListJob jobs[EJobPriority_Count];       //FIFO per priority, guarded by lock
+	ListThreadHandle threads;               //threadCount - 1 workers, empty in single threaded mode
 
-	SpinLock lock;
+	Mutex lock;
 
+	AtomicI64 queued[EJobPriority_Count];   //Jobs in each FIFO, lets contexts skip the lock when it's empty
 	AtomicI64 pending;              //Queued + currently running jobs
 	AtomicI64 shutdown;             //Set on free; workers exit once the queue is drained
 	AtomicI64 failedJobs;           //Number of jobs whose callback returned false
@@ -107,6 +136,12 @@ typedef struct JobQueue {
 	const Allocator *alloc;         //Must outlive the queue (same contract as RefPtr etc.)
 
 	U64 threadCount;                //Execution contexts (>= 1)
+	U64 jobsHead[EJobPriority_Count];   //First job in jobs that wasn't taken yet, guarded by lock
+
+	EJobQueueFlags flags;
+	U32 padding;
+
+	Buffer deques;                  //JobQueueDeque[threadCount], only with work stealing and threadCount > 1
 
 } JobQueue;
 
@@ -115,6 +150,11 @@ typedef struct JobQueue {
 //queue must be zero initialized or a previously freed queue.
 Bool JobQueue_create(U64 threadCount, const Allocator *alloc, JobQueue *queue, Error *e_rr);
 
+//JobQueue_create with EJobQueueFlags (e.g. EJobQueueFlags_WorkStealing).
+Bool JobQueue_createFlags(
+	U64 threadCount, EJobQueueFlags flags, const Allocator *alloc, JobQueue *queue, Error *e_rr
+);
+
 //Enqueue a job.
 //Safe to call from the owner thread and from within running jobs.
 //data is owned by the caller and must outlive the job's execution.
@@ -127,6 +167,11 @@ Bool JobQueue_pushDestructor(
 	JobQueue *queue, JobCallback callback, void *data, JobDestructor destructor, Error *e_rr
 );
 
+//Like JobQueue_pushDestructor, with a priority other than EJobPriority_Normal.
+Bool JobQueue_pushPriority(
+	JobQueue *queue, EJobPriority priority, JobCallback callback, void *data, JobDestructor destructor, Error *e_rr
+);
+
 //Run/help run jobs until the queue is fully drained (including jobs pushed by other jobs).
 //Must be called by the thread that created the queue (it becomes execution context 0).
 //Returns false (with e_rr untouched) only on invalid usage;
@@ -139,6 +184,31 @@ Bool JobQueue_isSuccess(const JobQueue *queue);
 //Number of execution contexts; the valid range of threadId in callbacks is [0, threadCount>.
 U64 JobQueue_threadCount(const JobQueue *queue);
 
+//Runs callback over [0, count> in chunks of at most grainSize (0 picks one based on the thread count).
+//The range is split in halves as it runs: a job pushes the upper half and keeps going with the lower one until
+// it's down to a grain, so idle contexts steal big halves and the splitting stops where nobody is idle anymore.
+//Works best with EJobQueueFlags_WorkStealing (the halves then stay on the context that split them).
+//
+//This only pushes the work, it doesn't wait for it: call JobQueue_wait from the owner, or pass a continuation to
+// run something once every chunk finished (it may be NULL).
+//The continuation is treated like a task it precedes (JobTask_precede), so it mustn't be submitted yet and it's
+// skipped if a chunk returned false.
+//data has to outlive all chunks.
+
+typedef Bool (*JobRangeCallback)(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue);
+
+typedef struct JobTask JobTask;
+
+Bool JobQueue_parallelFor(
+	JobQueue *queue,
+	U64 count,
+	U64 grainSize,
+	JobRangeCallback callback,
+	void *data,
+	JobTask *continuation,
+	Error *e_rr
+);
+
 //Signals shutdown, discards jobs that haven't started yet, joins all workers and frees memory.
 //Call JobQueue_wait first if all pushed jobs should complete.
 void JobQueue_free(JobQueue *queue);
@@ -152,6 +222,7 @@ void JobQueue_free(JobQueue *queue);
 // and release a token with JobGroup_leave as each unit finishes.
 //When the last token drops the group is done - "last one out" fires the finalize
 // (pushed as its own job, so its work, e.g. combining + writing an oiSH, overlaps other compiles).
+//Finalize is pushed with EJobPriority_High, since whatever comes after the group is waiting on it.
 //If any unit called JobGroup_fail, finalize is skipped instead.
 //Groups nest: a group's finalize (or a plain job) can JobGroup_leave a parent group,
 // giving the SHFile-latch -> output-group-latch hierarchy.
@@ -203,6 +274,69 @@ Bool JobGroup_fail(JobGroup *group, Error *e_rr);
 //False if JobGroup_fail was called since create.
 Bool JobGroup_isSuccess(const JobGroup *group);
 
+//JobTask: a job that is part of a dependency graph.
+//
+//Where JobGroup is a latch over work that is discovered as it runs, a JobTask is for work whose order is known:
+// JobTask_precede(a, b) makes b a continuation of a, so b is only pushed once a and its other predecessors finished.
+//A task is pushed as soon as it's submitted and all its predecessors are done, with its own priority.
+//Edges can be added from inside running jobs too; precede on a task that already finished is a no-op
+// (or fails 'after' if 'before' failed).
+//
+//A task whose callback returns false (or that is discarded by JobQueue_free) fails.
+//Failing skips every continuation: their callback doesn't run, their destructor does and their own continuations
+// are skipped in turn, like a JobGroup skips its finalize.
+//
+//callback may be NULL for a task that only joins its predecessors (it completes without being pushed).
+//Tasks that are never submitted never run, and JobQueue_wait doesn't know about them until they're pushed,
+// so submit everything before waiting.
+//The task must stay alive and address stable until JobTask_isDone (or until the queue was freed).
+
+TListNamed(JobTask*, ListJobTaskPtr);
+
+typedef struct JobTask {
+
+	JobQueue *queue;                //Where the task is pushed (and whose allocator holds the continuations)
+	JobCallback callback;           //May be NULL
+	void *data;
+	JobDestructor destructor;       //May be NULL; frees data when the callback won't run
+
+	EJobPriority priority;
+	Bool closed;                    //Finished and continuations were released, guarded by lock
+	U8 padding[3];
+
+	ListJobTaskPtr continuations;   //Guarded by lock
+
+	SpinLock lock;
+
+	AtomicI64 dependencies;         //Unfinished predecessors, +1 until JobTask_submit
+	AtomicI64 failed;               //Sticky; own callback or a predecessor failed
+	AtomicI64 done;                 //Set as the very last access of the queue, after this the task can be freed
+
+} JobTask;
+
+//task must be zero initialized.
+Bool JobTask_create(
+	JobTask *task,
+	JobQueue *queue,
+	EJobPriority priority,
+	JobCallback callback,
+	void *data,
+	JobDestructor destructor,
+	Error *e_rr
+);
+
+//after won't be pushed before before finished.
+//Has to be called before after is submitted.
+Bool JobTask_precede(JobTask *before, JobTask *after, Error *e_rr);
+
+//Allows the task to run once its predecessors are done; call exactly once.
+Bool JobTask_submit(JobTask *task, Error *e_rr);
+
+Bool JobTask_isDone(const JobTask *task);
+
+//False if the task's callback or one of its predecessors failed, or it was discarded.
+Bool JobTask_isSuccess(const JobTask *task);
+
 #ifdef __cplusplus
 	}
 #endif
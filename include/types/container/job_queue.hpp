@@ -138,6 +138,16 @@ namespace oxc {
 			return initialized;
 		}
 
+		//Same, with c::EJobQueueFlags (e.g. c::EJobQueueFlags_WorkStealing)
+
+		[[nodiscard]] c::Bool init(
+			c::U64 threadCount, c::EJobQueueFlags flags, const c::Allocator &alloc, c::Error *e_rr = nullptr
+		) noexcept {
+			release();
+			initialized = c::JobQueue_createFlags(threadCount, flags, &alloc, &queue, e_rr);
+			return initialized;
+		}
+
 		//Raw C style push; data is owned by the caller
 
 		[[nodiscard]] c::Bool push(c::JobCallback callback, void *data, c::Error *e_rr = nullptr) noexcept {
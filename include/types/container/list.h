@@ -120,6 +120,7 @@ static inline Bool Name##_neq(const Name a, const Name b) { return !Name##_eq(a,
 Bool Name##_swap(Name l, U64 i, U64 j, Error *e_rr);                                                                        \
 Bool Name##_reverse(Name l);                                                                                                \
 Bool Name##_sortCustom(Name l, CompareFunction func, void *context);                                                        \
+Bool Name##_sortStable(Name l, CompareFunction func, void *context, const Allocator *alloc, Error *e_rr);                   \
 																															\
 Bool Name##_createSubset(const Name l, U64 index, U64 length, Name *result, Error *e_rr);                                   \
 Bool Name##_create(U64 length, const Allocator *alloc, Name *result, Error *e_rr);                                          \
@@ -175,7 +176,8 @@ TListX(Name)
 
 #define TListNamed(T, Name) TListDefinition(T, Name); TListNamedBase(Name)
 #define TList(T) TListNamed(T, List##T)
-#define TListSort(T) TList(T);                        Bool List##T##_sort(List##T l)
+#define TListSort(T) TList(T);                        Bool List##T##_sort(List##T l);                             \
+	Bool List##T##_sortRadix(List##T l, const Allocator *alloc, Error *e_rr)
 
 #ifdef __cplusplus
 	}
@@ -30,6 +30,7 @@
 
 TListNamedBase(ListU64);
 Bool ListU64_sort(ListU64 l);
+Bool ListU64_sortRadix(ListU64 l, const Allocator *alloc, Error *e_rr);
 
 TListNamedBase(ListU8); TListNamedBase(ListU16); TListNamedBase(ListU32);
 TListNamedBase(ListI8); TListNamedBase(ListI16); TListNamedBase(ListI32); TListNamedBase(ListI64);
@@ -41,6 +42,16 @@ Bool ListU8_sort(ListU8 l);   Bool ListU16_sort(ListU16 l); Bool ListU32_sort(Li
 Bool ListI8_sort(ListI8 l);   Bool ListI16_sort(ListI16 l); Bool ListI32_sort(ListI32 l); Bool ListI64_sort(ListI64 l);
 Bool ListF32_sort(ListF32 l); Bool ListF64_sort(ListF64 l);
 
+Bool ListU8_sortRadix(ListU8 l, const Allocator *alloc, Error *e_rr);
+Bool ListU16_sortRadix(ListU16 l, const Allocator *alloc, Error *e_rr);
+Bool ListU32_sortRadix(ListU32 l, const Allocator *alloc, Error *e_rr);
+Bool ListI8_sortRadix(ListI8 l, const Allocator *alloc, Error *e_rr);
+Bool ListI16_sortRadix(ListI16 l, const Allocator *alloc, Error *e_rr);
+Bool ListI32_sortRadix(ListI32 l, const Allocator *alloc, Error *e_rr);
+Bool ListI64_sortRadix(ListI64 l, const Allocator *alloc, Error *e_rr);
+Bool ListF32_sortRadix(ListF32 l, const Allocator *alloc, Error *e_rr);
+Bool ListF64_sortRadix(ListF64 l, const Allocator *alloc, Error *e_rr);
+
 TListNamedBase(ListListU8);
 TListNamedBase(ListListU16);
 TListNamedBase(ListListU32);
@@ -60,6 +60,9 @@ Bool Name##_swap(Name l, U64 i, U64 j, Error *e_rr) { return GenericList_swap(Na
 Bool Name##_reverse(Name l) { return GenericList_reverse(Name##_toList(l)); }                                                \
 Bool Name##_sortCustom(Name l, CompareFunction func, void *context) {                                                         \
 	return GenericList_sortCustom(Name##_toList(l), func, context);                                                           \
+}                                                                                                                             \
+Bool Name##_sortStable(Name l, CompareFunction func, void *context, const Allocator *alloc, Error *e_rr) {                    \
+	return GenericList_sortStable(Name##_toList(l), func, context, alloc, e_rr);                                              \
 }                                                                                                                             \
 																															\
 Bool Name##_createSubset(const Name l, U64 index, U64 length, Name *result, Error *e_rr) {                                    \
@@ -257,6 +260,9 @@ TListXBaseImpl(Name)
 #define TListSortImpl(T) TListNamedBaseImpl(List##T); Bool List##T##_sort(List##T l) {                                    \
 	GenericList gll = List##T##_toList(l);                                                                                \
 	return GenericList_sort##T(gll);                                                                                    \
+}                                                                                                                       \
+Bool List##T##_sortRadix(List##T l, const Allocator *alloc, Error *e_rr) {                                              \
+	return GenericList_sortRadix##T(List##T##_toList(l), alloc, e_rr);                                                  \
 }
 
 #ifdef __cplusplus
@@ -43,6 +43,7 @@ typedef struct MemoryStream {
 	Buffer data;
 } MemoryStream;
 
+//Streams that are neither writable nor resizable are EStreamType_Mapped, so StreamCursor_view doesn't copy.
 typedef RefPtr MemoryStreamRef;
 
 RefPtrType MemoryStream_makeType(const Allocator *alloc);
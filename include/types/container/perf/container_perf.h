@@ -21,10 +21,98 @@
 //types/container/perf/container_perf.h
 
 #pragma once
-#include "types/base/types.h"
+#include "types/container/list.h"
 
 typedef struct Allocator Allocator;
 typedef struct Error Error;
 typedef struct CharString CharString;
+typedef struct Buffer Buffer;
+
+//Writes csv (or any other text) to path, the perf files go through this instead of the C file API
+Bool Perf_writeCsv(CharString path, CharString csv, Error *e_rr);
+
+//Reads the file at path (e.g. a baseline CSV) into result (allocated)
+Bool Perf_readFile(CharString path, const Allocator *alloc, Buffer *result, Error *e_rr);
+
+//Throughput tables, every one writes a CSV of its own layout
 
 Bool Perf_aesThroughput(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_bigInt(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_compress(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_encryptionStream(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_hashMap(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_jobQueue(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_lock(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_poolAllocator(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_ringQueue(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_sha256(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_sort(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_stream(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_stringSearch(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+Bool Perf_unicode(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+
+//Micro benchmark suite.
+//
+//A benchmark is a function that does ops operations per call (a repetition).
+//PerfSuite_run calls it warmup times without measuring, then repetitions times, and keeps the median, p95 and
+// fastest repetition together with the allocations per repetition (if the suite knows the allocator's counters).
+//The results can be written as CSV or JSON, and compared against a CSV written earlier (the baseline):
+// a benchmark regresses if its median or allocation count grew by more than threshold (0.1 = 10%).
+
+typedef struct PerfResult {
+
+	const C8 *group;                //Static strings, e.g. "List"
+	const C8 *name;                 //e.g. "pushBack"
+
+	U64 ops, repetitions;
+
+	F64 medianNs, p95Ns, minNs;     //Per repetition
+	F64 allocations, allocBytes;    //Per repetition, 0 if the suite has no allocStats
+
+} PerfResult;
+
+TList(PerfResult);
+
+//Returns the total allocations and allocated bytes so far (of the allocator the benchmarks use)
+typedef void (*PerfAllocStats)(U64 *allocations, U64 *bytes);
+
+//Does ops operations, data belongs to the benchmark
+typedef Bool (*PerfBenchFunc)(void *data, const Allocator *alloc, Error *e_rr);
+
+typedef struct PerfSuite {
+
+	const Allocator *alloc;
+	PerfAllocStats allocStats;      //Optional
+
+	U64 warmup, repetitions;        //repetitions has to be at least 1
+
+	Bool logToConsole;
+	U8 padding[7];
+
+	ListPerfResult results;
+
+} PerfSuite;
+
+Bool PerfSuite_run(
+	PerfSuite *suite,
+	const C8 *group,
+	const C8 *name,
+	U64 ops,
+	PerfBenchFunc func,
+	void *data,
+	Error *e_rr
+);
+
+Bool PerfSuite_writeCsv(const PerfSuite *suite, const CharString *path, Error *e_rr);
+Bool PerfSuite_writeJson(const PerfSuite *suite, const CharString *path, Error *e_rr);
+
+//Benchmarks that aren't in the baseline (or are only in the baseline) are ignored.
+//*regressions is the number of benchmarks that regressed; every regression is logged.
+Bool PerfSuite_compareBaseline(
+	const PerfSuite *suite, const CharString *baselineCsv, F64 threshold, U64 *regressions, Error *e_rr
+);
+
+void PerfSuite_free(PerfSuite *suite);
+
+//Runs every micro benchmark: GenericList, CharString, hashes, JobQueue, StreamCursor and RefPtr
+Bool Perf_micro(PerfSuite *suite, Error *e_rr);
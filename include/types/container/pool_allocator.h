@@ -0,0 +1,120 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/pool_allocator.h
+
+#pragma once
+#include "types/base/allocator.h"
+#include "types/base/lock.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+//A size-class (slab) allocator for small allocations that keep repeating the same sizes
+// (RefPtr objects, CharString copies, small list growth, job data).
+//
+//Allocations up to PoolAllocator_maxSize are rounded up to one of PoolAllocator_classCount size classes
+// and served from slabs (PoolAllocator_slabSize) taken from the parent; larger ones go straight to the parent.
+//
+//Threads follow the JobQueue model: each execution context has a stable threadId in [0, threadCount>,
+// and PoolAllocator_thread(pool, threadId) is that context's own allocator.
+//It has a magazine (a small stack of free blocks) per size class, so most allocs and frees touch nothing shared.
+//Only when a magazine runs empty or full is half a magazine moved from/to the class' depot, under that class' lock.
+//
+//Blocks don't belong to a thread, only to a size class (which is derived from the length passed to free),
+// so freeing from another thread than the one that allocated is just a free into that thread's magazine.
+//
+//&pool->allocator is for code outside of the threadId model (e.g. the thread that owns the JobQueue
+// between waits); it has its own magazines, serialized by a lock.
+//
+//Slabs are only returned to the parent on PoolAllocator_free, which doesn't have to wait for every block to
+// be freed (just like an arena). The pool is address stable after create; don't move or copy it.
+
+#define PoolAllocator_classCount 16
+#define PoolAllocator_maxSize 4096
+#define PoolAllocator_magazineSize 64
+#define PoolAllocator_slabSize (64 * 1024)
+
+//Per size class; the entry at PoolAllocator_classCount is for allocations that went to the parent.
+//Counters are kept per thread without atomics and summed by PoolAllocator_getStats,
+// so they're only exact once the threads using the pool are idle.
+
+typedef struct PoolAllocatorStats {
+	U64 blockSize;              //0 for the parent entry
+	U64 allocations, frees;     //active = allocations - frees
+	U64 refills, flushes;       //Magazine exchanges with the depot
+	U64 slabs;                  //Slabs carved for this class
+} PoolAllocatorStats;
+
+typedef struct PoolAllocator PoolAllocator;
+
+typedef struct PoolMagazine {
+	U64 count;
+	void *blocks[PoolAllocator_magazineSize];
+} PoolMagazine;
+
+typedef struct PoolAllocatorThread {
+	Allocator allocator;                                    //.ptr points back to this
+	PoolAllocator *pool;
+	PoolMagazine magazines[PoolAllocator_classCount];
+	PoolAllocatorStats stats[PoolAllocator_classCount + 1];
+} PoolAllocatorThread;
+
+typedef struct PoolAllocatorDepot {
+	SpinLock lock;
+	void *freeList;             //Intrusive: the first bytes of a free block point to the next one
+	void *slabs;                //Intrusive as well, the first bytes of a slab point to the previous slab
+	U64 freeCount, slabCount;
+} PoolAllocatorDepot;
+
+typedef struct PoolAllocator {
+
+	Allocator allocator;                                    //Shared entry point, .ptr points back to the pool
+
+	const Allocator *parent;
+
+	PoolAllocatorThread *threads;                           //threadCount + 1, the last one backs the shared allocator
+	U64 threadCount;
+
+	SpinLock sharedLock;                                    //Serializes the shared allocator's magazines
+	PoolAllocatorDepot depots[PoolAllocator_classCount];
+
+} PoolAllocator;
+
+//threadCount is the number of execution contexts (e.g. JobQueue_threadCount), 0 is allowed (shared only).
+//result has to be zero initialized.
+Bool PoolAllocator_create(U64 threadCount, const Allocator *parent, PoolAllocator *result, Error *e_rr);
+
+//Returns every slab to the parent; any block still in use is invalidated.
+void PoolAllocator_free(PoolAllocator *pool);
+
+//The allocator for execution context threadId, NULL if it's out of bounds.
+//Must only be used from that context (like the other per threadId resources of a JobQueue).
+const Allocator *PoolAllocator_thread(const PoolAllocator *pool, U64 threadId);
+
+U64 PoolAllocator_classSize(U64 classId);
+
+//stats has PoolAllocator_classCount + 1 entries.
+void PoolAllocator_getStats(const PoolAllocator *pool, PoolAllocatorStats *stats);
+
+#ifdef __cplusplus
+	}
+#endif
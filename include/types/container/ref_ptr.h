@@ -45,6 +45,45 @@ typedef void (*ObjectFreeInvoke)(void *ptr, const void *allocator);
 
 typedef U32 TypeId;
 
+typedef enum ERefPtrFlags {
+
+	ERefPtrFlags_None = 0,
+
+	//The last RefPtr_dec doesn't free, but retires the object onto the retire list of the calling thread.
+	//It's only freed once its retire domain is collected, which is meant to be a point where freeing is cheap and safe
+	// (a graphics device collects its own in GraphicsDeviceRef_handleNextFrame), so the drop itself never runs the free.
+	//The free can therefore run on a different thread, alloc has to be thread safe.
+
+	ERefPtrFlags_DeferRelease = 1 << 0
+
+} ERefPtrFlags;
+
+//Where deferred RefPtrs retire to: one list per thread (spread round robin over RefPtr_retireListCount).
+//Types without a retireDomain share a process-wide one, an owner can keep its own (a graphics device has one),
+// so it can free what was retired for it without also freeing what was retired for somebody else.
+
+#define RefPtr_retireListCount 64
+
+typedef struct RefPtrRetireList {
+	alignas(64) AtomicI64 head;                 //RefPtr*, 0 if empty
+} RefPtrRetireList;
+
+typedef struct RefPtrRetireDomain {
+	RefPtrRetireList lists[RefPtr_retireListCount];
+	struct RefPtrRetireDomain *prev, *next;     //Registered ones, so RefPtr_collect can reach it
+} RefPtrRetireDomain;
+
+//Starts empty and registered. Has to stay at the same address until RefPtrRetireDomain_free.
+void RefPtrRetireDomain_create(RefPtrRetireDomain *domain);
+
+//Collects and unregisters it. Anything retired into it afterwards would leak, so the owner has to be done with it.
+//Safe on a zeroed domain that was never created.
+void RefPtrRetireDomain_free(RefPtrRetireDomain *domain);
+
+//Returns the domain the (deferred) object retires into, NULL for the process-wide one.
+//Called with RefPtr_data on its last RefPtr_dec, so before the free and while the object is still whole.
+typedef RefPtrRetireDomain *(*RefPtrRetireDomainFunc)(void *ptr);
+
 typedef struct RefPtrType {
 
 	TypeId typeId;
@@ -56,6 +95,11 @@ typedef struct RefPtrType {
 
 	ObjectFreeInvoke freeInvoke;
 
+	RefPtrRetireDomainFunc retireDomain;        //ERefPtrFlags_DeferRelease only, optional
+
+	ERefPtrFlags flags;
+	U32 padding;
+
 } RefPtrType;
 
 //Alignment goes in the upper U8 as its log2, so it costs nothing next to the length rather than another field.
@@ -94,9 +138,29 @@ TListNamed(RefPtr*, ListRefPtr);
 //So there can be multiple RefPtrType* that reference to the same typeId.
 Bool RefPtr_create(const RefPtrType *type, RefPtr **result, Error *e_rr);
 
-Bool RefPtr_inc(RefPtr *ptr);
+Bool RefPtr_inc(RefPtr *ptr);    //False for NULL and for a retired RefPtr, which can't be revived
 void RefPtr_dec(RefPtr **ptr);    //Clears pointer if it's gone
 
+//The same for a whole list (for example the resources a command list keeps alive), NULL entries are skipped.
+//incMany returns false if any of them couldn't be incremented.
+//decMany clears every pointer, deferred RefPtrs that are released are retired with a single atomic per call.
+
+Bool RefPtr_incMany(RefPtr *const *ptrs, U64 count);
+void RefPtr_decMany(RefPtr **ptrs, U64 count);
+
+//Frees everything retired by ERefPtrFlags_DeferRelease on any thread, including what those frees retire in turn.
+//Returns how many were freed. It can be called from any thread that doesn't hold a lock the frees need.
+//RefPtr_collect goes through every domain (the process-wide one and every registered one),
+// RefPtr_collectDomain only through one, what its frees retire into other domains waits for those to be collected.
+
+U64 RefPtr_collect();
+U64 RefPtr_collectDomain(RefPtrRetireDomain *domain);
+
+//A retired RefPtr is still allocated, but has no references anymore and waits for RefPtr_collect.
+//Weak references (like a list of pending resources) have to skip it.
+//The refCount then holds the next retired RefPtr with the sign bit set, so it's negative.
+static inline Bool RefPtr_isRetired(RefPtr *ptr) { return ptr && AtomicI64_load(&ptr->refCount) <= 0; }
+
 #define RefPtr_data(dat, T) (!(dat) ? NULL : (T*)((dat) + 1))
 
 //Signifies that the RefPtr will not need inc/dec, because the owner will manually ensure
@@ -0,0 +1,102 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/ring_queue.h
+
+#pragma once
+#include "types/base/buffer_base.h"
+#include "types/base/atomic.h"
+#include <stdalign.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+typedef struct Allocator Allocator;
+typedef struct Error Error;
+
+//Bounded lock-free queues to hand fixed size elements (stride bytes, copied in and out) from one thread to another.
+//Both are a ring of capacity elements, capacity is rounded up to a power of two (at least 2).
+//Neither allocates or blocks after creation: push on a full queue and pop on an empty one return false, the caller
+// decides whether to retry, back off or do something else.
+//
+//MPMCQueue is Dmitry Vyukov's bounded MPMC queue, any number of threads can push and pop at the same time.
+//Every cell has a sequence number that says whether it's free for the push of round r or holds the element for the
+// pop of round r. A push or pop only claims its position (cmpStore on its own index) once the cell says it's ready,
+// and hands the cell over by bumping the sequence after copying, so an element is never read half written.
+//Producers only contend on enqueuePos and consumers on dequeuePos, which live on separate cache lines.
+//
+//SPSCQueue is for exactly one producer thread and one consumer thread.
+//Each side only writes its own index and keeps a copy of the other one, which it only refreshes when the queue
+// looks full (producer) or empty (consumer), so most pushes and pops never touch the other side's cache line.
+
+typedef struct MPMCQueue {
+
+	alignas(64) AtomicI64 enqueuePos;
+	alignas(64) AtomicI64 dequeuePos;
+
+	alignas(64) Buffer cells;       //[ AtomicI64 sequence, element (stride rounded up to 8 bytes) ] * capacity
+
+	U64 mask;                       //capacity - 1
+	U64 stride, cellStride;
+
+} MPMCQueue;
+
+//queue has to be zero initialized (or freed)
+Bool MPMCQueue_create(U64 capacity, U64 stride, const Allocator *alloc, MPMCQueue *queue, Error *e_rr);
+void MPMCQueue_free(MPMCQueue *queue, const Allocator *alloc);
+
+Bool MPMCQueue_push(MPMCQueue *queue, const void *element);        //False if full
+Bool MPMCQueue_pop(MPMCQueue *queue, void *element);               //False if empty, element can be NULL to discard
+
+//A snapshot, it may already be outdated if other threads are pushing or popping
+U64 MPMCQueue_length(MPMCQueue *queue);
+
+static inline U64 MPMCQueue_capacity(const MPMCQueue *queue) { return queue && queue->stride ? queue->mask + 1 : 0; }
+
+typedef struct SPSCQueue {
+
+	alignas(64) AtomicI64 head;     //Next element to pop, only written by the consumer
+	I64 cachedTail;                 //Consumer's copy of tail
+
+	alignas(64) AtomicI64 tail;     //Next element to push, only written by the producer
+	I64 cachedHead;                 //Producer's copy of head
+
+	alignas(64) Buffer data;        //element * capacity
+
+	U64 mask;                       //capacity - 1
+	U64 stride;
+
+} SPSCQueue;
+
+//queue has to be zero initialized (or freed)
+Bool SPSCQueue_create(U64 capacity, U64 stride, const Allocator *alloc, SPSCQueue *queue, Error *e_rr);
+void SPSCQueue_free(SPSCQueue *queue, const Allocator *alloc);
+
+Bool SPSCQueue_push(SPSCQueue *queue, const void *element);        //Producer thread only, false if full
+Bool SPSCQueue_pop(SPSCQueue *queue, void *element);               //Consumer thread only, false if empty
+
+U64 SPSCQueue_length(SPSCQueue *queue);
+
+static inline U64 SPSCQueue_capacity(const SPSCQueue *queue) { return queue && queue->stride ? queue->mask + 1 : 0; }
+
+#ifdef __cplusplus
+	}
+#endif
@@ -25,6 +25,16 @@
 
 //Shared helpers between aes implementations
 
+//Constant-time software fallback (buffer_encrypt_software.c), no tables and no AES or carry-less multiply instructions.
+//rk is (rounds + 1) * 8 bitsliced round keys from AES_bitsliceKeys, in and out are AES_bitslicedBlocks blocks.
+//AES_clmulSoftware outputs the same clmul00, clmul01 ^ clmul10 and clmul11 that AESEncryptionContext_ghashReduceClMul takes.
+
+#define AES_bitslicedBlocks 8
+
+void AES_bitsliceKeys(const I32x4 *restrict k, U8 rounds, I32x4 *restrict rk);
+void AES_encryptBitsliced(const I32x4 *restrict in, I32x4 *restrict out, const I32x4 *restrict rk, U8 rounds);
+void AES_clmulSoftware(I32x4 a, I32x4 b, I32x4 *clmuls/*[3]*/);
+
 //Refactored from https://www.intel.com/content/dam/develop/external/us/en/documents/clmul-wp-rev-2-02-2014-04-20.pdf
 __forceinline__ static I32x4 AESEncryptionContext_ghashReduceClMul(I32x4 clmul00, I32x4 clmulFused, I32x4 clmul11) {
 
@@ -96,59 +96,56 @@ static inline U32 Buffer_crc32cSimd(const Buffer buf, U32 prevCrc) {
 		}
 	}
 
-	//Can only be supported if CRC32C is 64-bit, otherwise needs a different version.
-	#ifndef DISABLE_CRC32C_TRIPLET
+	//Compute 3 CRCs at once, this is beneficial because the hardware is able to schedule these at once
+	//Giving us better perf (up to 15x faster!)
+	//The CRCs are kept as U32; x64's crc32 returns a zero extended U64 while ARM's __crc32cd takes and returns a U32,
+	// so casting every result keeps this identical (and free of implicit narrowing) on both.
 
-		//Compute 3 CRCs at once, this is beneficial because the hardware is able to schedule these at once
-		//Giving us better perf (up to 15x faster!)
-		//We always run 64-bit, so we can assume U64 to be properly present
+	U32 crc0 = crc;
 
-		U64 crc0 = crc;
+	static const U64 LONG_SHIFT = 8192, LONG_SHIFT_U64 = 8192 / sizeof(U64);
 
-		static const U64 LONG_SHIFT = 8192, LONG_SHIFT_U64 = 8192 / sizeof(U64);
+	while(len >= LONG_SHIFT * 3) {
 
-		while(len >= LONG_SHIFT * 3) {
+		U32 crc1 = 0, crc2 = 0;
+		const U64 *offu64 = (const U64*)(const void*)off;
 
-			U64 crc1 = 0, crc2 = 0;
-			U64 *offu64 = (U64*)(void*)off;
-
-			for (U64 i = 0; i < LONG_SHIFT_U64; ++i) {
-				crc0 = SIMD_CRC32C_U64(crc0, offu64[i]);
-				crc1 = SIMD_CRC32C_U64(crc1, offu64[LONG_SHIFT_U64 + i]);
-				crc2 = SIMD_CRC32C_U64(crc2, offu64[LONG_SHIFT_U64 * 2 + i]);
-			}
-
-			crc0 = CRC32C_shiftLong((U32) crc0) ^ crc1;
-			crc0 = CRC32C_shiftLong((U32) crc0) ^ crc2;
-
-			off += LONG_SHIFT * 3;
-			len -= LONG_SHIFT * 3;
+		for (U64 i = 0; i < LONG_SHIFT_U64; ++i) {
+			crc0 = (U32) SIMD_CRC32C_U64(crc0, offu64[i]);
+			crc1 = (U32) SIMD_CRC32C_U64(crc1, offu64[LONG_SHIFT_U64 + i]);
+			crc2 = (U32) SIMD_CRC32C_U64(crc2, offu64[LONG_SHIFT_U64 * 2 + i]);
 		}
 
-		//Do the same thing but for smaller blocks
+		crc0 = CRC32C_shiftLong(crc0) ^ crc1;
+		crc0 = CRC32C_shiftLong(crc0) ^ crc2;
 
-		static const U64 SHORT_SHIFT = 256, SHORT_SHIFT_U64 = 256 / sizeof(U64);
+		off += LONG_SHIFT * 3;
+		len -= LONG_SHIFT * 3;
+	}
 
-		while(len >= SHORT_SHIFT * 3) {
+	//Do the same thing but for smaller blocks
 
-			U64 crc1 = 0, crc2 = 0;
-			U64 *offu64 = (U64*)(void*)off;
+	static const U64 SHORT_SHIFT = 256, SHORT_SHIFT_U64 = 256 / sizeof(U64);
 
-			for (U64 i = 0; i < SHORT_SHIFT_U64; ++i) {
-				crc0 = SIMD_CRC32C_U64(crc0, offu64[i]);
-				crc1 = SIMD_CRC32C_U64(crc1, offu64[SHORT_SHIFT_U64 + i]);
-				crc2 = SIMD_CRC32C_U64(crc2, offu64[SHORT_SHIFT_U64 * 2 + i]);
-			}
+	while(len >= SHORT_SHIFT * 3) {
 
-			crc0 = CRC32C_shiftShort((U32) crc0) ^ crc1;
-			crc0 = CRC32C_shiftShort((U32) crc0) ^ crc2;
+		U32 crc1 = 0, crc2 = 0;
+		const U64 *offu64 = (const U64*)(const void*)off;
 
-			off += SHORT_SHIFT * 3;
-			len -= SHORT_SHIFT * 3;
+		for (U64 i = 0; i < SHORT_SHIFT_U64; ++i) {
+			crc0 = (U32) SIMD_CRC32C_U64(crc0, offu64[i]);
+			crc1 = (U32) SIMD_CRC32C_U64(crc1, offu64[SHORT_SHIFT_U64 + i]);
+			crc2 = (U32) SIMD_CRC32C_U64(crc2, offu64[SHORT_SHIFT_U64 * 2 + i]);
 		}
 
-		crc = (U32) crc0;
-	#endif
+		crc0 = CRC32C_shiftShort(crc0) ^ crc1;
+		crc0 = CRC32C_shiftShort(crc0) ^ crc2;
+
+		off += SHORT_SHIFT * 3;
+		len -= SHORT_SHIFT * 3;
+	}
+
+	crc = crc0;
 
 	//Process remaining U64s
 
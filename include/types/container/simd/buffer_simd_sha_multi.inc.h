@@ -0,0 +1,269 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/simd/buffer_simd_sha_multi.inc.h
+
+//Multi-buffer SHA256: SIMD_SHA256X_LANES independent messages at once, one per 32-bit lane of a register.
+//The rounds are the plain FIPS 180-4 ones rather than the SHA extension, but they're done for all lanes at once.
+//So the serial dependency between rounds is paid once per 4, 8 or 16 messages rather than once per message.
+//
+//Define the lane ops before including (like buffer_simd_sha.inc.h):
+//    SIMD_SHA256X_T, SIMD_SHA256X_LANES and SIMD_SHA256X_SUFFIX(x) (e.g. x##X4)
+//    SIMD_SHA256X_ADD, XOR, AND, OR(a, b) and SIMD_SHA256X_ANDNOT(a, b) (~a & b)
+//    SIMD_SHA256X_ROR(a, n) and SIMD_SHA256X_SHR(a, n) with n a constant, SIMD_SHA256X_SET1(u32)
+//    SIMD_SHA256X_LOAD(ptr) and SIMD_SHA256X_STORE(ptr, v) (unaligned U32 *)
+//Optionally SIMD_SHA256X_CH(e, f, g) and SIMD_SHA256X_MAJ(a, b, c) when there's something better (e.g. ternlog).
+
+#ifndef SIMD_SHA256X_T
+	#error Define SIMD_SHA256X_T for this architecture; e.g. __m128i
+#endif
+
+#ifndef SIMD_SHA256X_LANES
+	#error Define SIMD_SHA256X_LANES for this architecture; 4, 8 or 16
+#endif
+
+#ifndef SIMD_SHA256X_SUFFIX
+	#error Define SIMD_SHA256X_SUFFIX for this architecture; e.g. #define SIMD_SHA256X_SUFFIX(x) x##X4
+#endif
+
+#ifndef SIMD_SHA256X_LINKING
+	#define SIMD_SHA256X_LINKING static inline
+#endif
+
+#ifndef SIMD_SHA256X_CH
+	#define SIMD_SHA256X_CH(e, f, g) SIMD_SHA256X_XOR(SIMD_SHA256X_AND(e, f), SIMD_SHA256X_ANDNOT(e, g))
+#endif
+
+#ifndef SIMD_SHA256X_MAJ
+	#define SIMD_SHA256X_MAJ(a, b, c) \
+		SIMD_SHA256X_OR(SIMD_SHA256X_AND(a, b), SIMD_SHA256X_AND(c, SIMD_SHA256X_OR(a, b)))
+#endif
+
+extern const U32 SHA256_STATE[8];
+extern const U32 SHA256_ROUNDS[64];
+
+#define SIMD_SHA256X_S0(a) \
+	SIMD_SHA256X_XOR(SIMD_SHA256X_XOR(SIMD_SHA256X_ROR(a, 2), SIMD_SHA256X_ROR(a, 13)), SIMD_SHA256X_ROR(a, 22))
+
+#define SIMD_SHA256X_S1(e) \
+	SIMD_SHA256X_XOR(SIMD_SHA256X_XOR(SIMD_SHA256X_ROR(e, 6), SIMD_SHA256X_ROR(e, 11)), SIMD_SHA256X_ROR(e, 25))
+
+#define SIMD_SHA256X_SIGMA0(w) \
+	SIMD_SHA256X_XOR(SIMD_SHA256X_XOR(SIMD_SHA256X_ROR(w, 7), SIMD_SHA256X_ROR(w, 18)), SIMD_SHA256X_SHR(w, 3))
+
+#define SIMD_SHA256X_SIGMA1(w) \
+	SIMD_SHA256X_XOR(SIMD_SHA256X_XOR(SIMD_SHA256X_ROR(w, 17), SIMD_SHA256X_ROR(w, 19)), SIMD_SHA256X_SHR(w, 10))
+
+//One round; the caller rotates which variable is called a..h instead of moving them (so 8 rounds per iteration).
+//w[t & 15] is expanded in place once t >= 16.
+
+#define SIMD_SHA256X_ROUND(a, b, c, d, e, f, g, h, t) {                                                             \
+																													\
+	if((t) >= 16)                                                                                                   \
+		w[(t) & 15] = SIMD_SHA256X_ADD(                                                                             \
+			SIMD_SHA256X_ADD(w[(t) & 15], SIMD_SHA256X_SIGMA1(w[((t) - 2) & 15])),                                  \
+			SIMD_SHA256X_ADD(w[((t) - 7) & 15], SIMD_SHA256X_SIGMA0(w[((t) - 15) & 15]))                            \
+		);                                                                                                          \
+																													\
+	const SIMD_SHA256X_T t1 = SIMD_SHA256X_ADD(                                                                     \
+		SIMD_SHA256X_ADD(SIMD_SHA256X_ADD(h, SIMD_SHA256X_S1(e)), SIMD_SHA256X_CH(e, f, g)),                        \
+		SIMD_SHA256X_ADD(SIMD_SHA256X_SET1(SHA256_ROUNDS[t]), w[(t) & 15])                                          \
+	);                                                                                                              \
+																													\
+	d = SIMD_SHA256X_ADD(d, t1);                                                                                    \
+	h = SIMD_SHA256X_ADD(t1, SIMD_SHA256X_ADD(SIMD_SHA256X_S0(a), SIMD_SHA256X_MAJ(a, b, c)));                      \
+}
+
+//state is [8][SIMD_SHA256X_LANES] (word major), lane j reads blockCount 64-byte blocks starting at blocks[j].
+
+static void SIMD_SHA256X_SUFFIX(Buffer_sha256Blocks)(U32 *state, const U8 *const *blocks, U64 blockCount) {
+
+	SIMD_SHA256X_T s[8];
+
+	for(U64 i = 0; i < 8; ++i)
+		s[i] = SIMD_SHA256X_LOAD(state + i * SIMD_SHA256X_LANES);
+
+	U32 words[16 * SIMD_SHA256X_LANES];
+
+	for (U64 block = 0; block < blockCount; ++block) {
+
+		//Transpose, so word t of every lane is next to each other (and big endian like SHA256 wants it)
+
+		for (U64 j = 0; j < SIMD_SHA256X_LANES; ++j) {
+
+			const U8 *ptr = blocks[j] + block * 64;
+
+			for (U64 t = 0; t < 16; ++t, ptr += 4)
+				words[t * SIMD_SHA256X_LANES + j] =
+					((U32)ptr[0] << 24) | ((U32)ptr[1] << 16) | ((U32)ptr[2] << 8) | ptr[3];
+		}
+
+		SIMD_SHA256X_T w[16];
+
+		for(U64 t = 0; t < 16; ++t)
+			w[t] = SIMD_SHA256X_LOAD(words + t * SIMD_SHA256X_LANES);
+
+		SIMD_SHA256X_T a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+		for (U64 t = 0; t < 64; t += 8) {
+			SIMD_SHA256X_ROUND(a, b, c, d, e, f, g, h, t);
+			SIMD_SHA256X_ROUND(h, a, b, c, d, e, f, g, t + 1);
+			SIMD_SHA256X_ROUND(g, h, a, b, c, d, e, f, t + 2);
+			SIMD_SHA256X_ROUND(f, g, h, a, b, c, d, e, t + 3);
+			SIMD_SHA256X_ROUND(e, f, g, h, a, b, c, d, t + 4);
+			SIMD_SHA256X_ROUND(d, e, f, g, h, a, b, c, t + 5);
+			SIMD_SHA256X_ROUND(c, d, e, f, g, h, a, b, t + 6);
+			SIMD_SHA256X_ROUND(b, c, d, e, f, g, h, a, t + 7);
+		}
+
+		s[0] = SIMD_SHA256X_ADD(s[0], a);
+		s[1] = SIMD_SHA256X_ADD(s[1], b);
+		s[2] = SIMD_SHA256X_ADD(s[2], c);
+		s[3] = SIMD_SHA256X_ADD(s[3], d);
+		s[4] = SIMD_SHA256X_ADD(s[4], e);
+		s[5] = SIMD_SHA256X_ADD(s[5], f);
+		s[6] = SIMD_SHA256X_ADD(s[6], g);
+		s[7] = SIMD_SHA256X_ADD(s[7], h);
+	}
+
+	for(U64 i = 0; i < 8; ++i)
+		SIMD_SHA256X_STORE(state + i * SIMD_SHA256X_LANES, s[i]);
+}
+
+//Batch state; a lane first reads the whole blocks straight from its message, then the blocks in tail.
+//tail holds the last partial block followed by 0x80, zeros and the length in bits (1 or 2 blocks).
+
+typedef struct SIMD_SHA256X_SUFFIX(SHA256Batch) {
+
+	U32 state[8 * SIMD_SHA256X_LANES];
+
+	const U8 *ptrs[SIMD_SHA256X_LANES];
+	U64 message[SIMD_SHA256X_LANES];        //U64_MAX if the lane is idle
+	U64 left[SIMD_SHA256X_LANES];           //Blocks left at ptrs
+
+	U8 tails[SIMD_SHA256X_LANES][128];
+	U64 tailBlocks[SIMD_SHA256X_LANES];
+	Bool inTail[SIMD_SHA256X_LANES];
+
+	const Buffer *bufs;
+	U32 (*outputs)[8];
+	U64 count, next, singleFrom, active;
+
+} SIMD_SHA256X_SUFFIX(SHA256Batch);
+
+//Gives lane j the next message (hashing the ones of singleFrom bytes or more with Buffer_sha256) or idles it.
+
+static void SIMD_SHA256X_SUFFIX(SHA256Batch_start)(SIMD_SHA256X_SUFFIX(SHA256Batch) *b, U64 j) {
+
+	for(; b->next < b->count && Buffer_length(b->bufs[b->next]) >= b->singleFrom; ++b->next)
+		Buffer_sha256(b->bufs[b->next], b->outputs[b->next]);
+
+	if (b->next == b->count) {
+		b->message[j] = U64_MAX;
+		return;
+	}
+
+	const Buffer buf = b->bufs[b->next];
+	b->message[j] = b->next++;
+	++b->active;
+
+	for(U64 i = 0; i < 8; ++i)
+		b->state[i * SIMD_SHA256X_LANES + j] = SHA256_STATE[i];
+
+	const U64 len = Buffer_length(buf), rem = len & 63, blocks = rem + 9 > 64 ? 2 : 1, end = blocks * 64;
+	U8 *tail = b->tails[j];
+
+	for(U64 i = 0; i < rem; ++i)
+		tail[i] = buf.ptr[len - rem + i];
+
+	tail[rem] = 0x80;
+
+	for(U64 i = rem + 1; i < end - 8; ++i)
+		tail[i] = 0;
+
+	for(U64 i = 0; i < 8; ++i)
+		tail[end - 1 - i] = (U8)((len << 3) >> (i * 8));
+
+	b->tailBlocks[j] = blocks;
+	b->inTail[j] = len < 64;
+	b->ptrs[j] = len < 64 ? tail : buf.ptr;
+	b->left[j] = len < 64 ? blocks : len >> 6;
+}
+
+//Hashes count buffers, outputs[i] is what Buffer_sha256 would return for bufs[i].
+//Every lane takes the next message as soon as its previous one is done, so messages of different lengths mix fine.
+//Buffers of singleFrom bytes or more are hashed by Buffer_sha256 instead (U64_MAX never does).
+
+SIMD_SHA256X_LINKING void SIMD_SHA256X_SUFFIX(Buffer_sha256Batch)(
+	const Buffer *bufs, U64 count, U32 (*outputs)[8], U64 singleFrom
+) {
+
+	SIMD_SHA256X_SUFFIX(SHA256Batch) b = (SIMD_SHA256X_SUFFIX(SHA256Batch)) {
+		.bufs = bufs, .outputs = outputs, .count = count, .singleFrom = singleFrom
+	};
+
+	for (U64 j = 0; j < SIMD_SHA256X_LANES; ++j)
+		SIMD_SHA256X_SUFFIX(SHA256Batch_start)(&b, j);
+
+	while (b.active) {
+
+		//Run as many blocks as every busy lane has left at its pointer.
+		//Idle lanes follow a busy lane's data; they cost as much as a busy one, but their result is ignored.
+
+		U64 run = U64_MAX, busy = 0;
+
+		for (U64 j = 0; j < SIMD_SHA256X_LANES; ++j)
+			if (b.message[j] != U64_MAX) {
+				run = U64_min(run, b.left[j]);
+				busy = j;
+			}
+
+		for (U64 j = 0; j < SIMD_SHA256X_LANES; ++j)
+			if(b.message[j] == U64_MAX)
+				b.ptrs[j] = b.ptrs[busy];
+
+		SIMD_SHA256X_SUFFIX(Buffer_sha256Blocks)(b.state, b.ptrs, run);
+
+		for (U64 j = 0; j < SIMD_SHA256X_LANES; ++j) {
+
+			if(b.message[j] == U64_MAX)
+				continue;
+
+			b.ptrs[j] += run * 64;
+			b.left[j] -= run;
+
+			if(b.left[j])
+				continue;
+
+			if (!b.inTail[j]) {
+				b.inTail[j] = true;
+				b.ptrs[j] = b.tails[j];
+				b.left[j] = b.tailBlocks[j];
+				continue;
+			}
+
+			for(U64 i = 0; i < 8; ++i)
+				outputs[b.message[j]][i] = b.state[i * SIMD_SHA256X_LANES + j];
+
+			--b.active;
+			SIMD_SHA256X_SUFFIX(SHA256Batch_start)(&b, j);
+		}
+	}
+}
@@ -0,0 +1,56 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/simd/neon/neon_buffer_compress.inc.h
+
+#include <arm_neon.h>
+
+#ifndef BUFFER_COMPRESS_NEON_GUARD
+	#error Compress NEON guard undefined, likely an include of neon_buffer_compress.inc.h outside of buffer_compress.c
+#endif
+
+static inline void BufferCompress_copy16(U8 *dst, const U8 *src) { vst1q_u8(dst, vld1q_u8(src)); }
+
+//How many of the 16 bytes at a and b are equal before the first difference.
+//There's no movemask, so the compare is narrowed to a nibble per byte (see neon_hash_map.inc.h).
+
+static inline U64 BufferCompress_equal16(const U8 *a, const U8 *b) {
+
+	const uint8x16_t eq = vceqq_u8(vld1q_u8(a), vld1q_u8(b));
+	const U64 diff = ~vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+
+	if(!diff)
+		return 16;
+
+	#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index = 0;
+		_BitScanForward64(&index, diff);
+		return index >> 2;
+	#else
+		return (U64) __builtin_ctzll(diff) >> 2;
+	#endif
+}
+
+//Repeats the first offset (< 16) bytes of src over 16 bytes of dst.
+//src[offset, 16> is read but not used, so it has to be addressable.
+
+static inline void BufferCompress_pattern16(U8 *dst, const U8 *src, U64 offset) {
+	vst1q_u8(dst, vqtbl1q_u8(vld1q_u8(src), vld1q_u8(BufferCompress_patternShuffle[offset])));
+}
@@ -0,0 +1,63 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/simd/neon/neon_hash_map.inc.h
+
+#include <arm_neon.h>
+
+#ifndef HASH_MAP_NEON_GUARD
+	#error Hash map NEON guard was undefined, this likely indicates include of neon_hash_map.inc.h outside of hash_map.c
+#endif
+
+//NEON has no movemask, so the compare result is narrowed to a nibble per control byte instead.
+//Lane i is bits [i * 4, i * 4 + 4>, which is why first divides by 4 and clearFirst drops a whole nibble.
+
+typedef U64 HashMapGroupMask;
+
+static inline HashMapGroupMask HashMapGroup_toMask(uint8x16_t eq) {
+	const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+	return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+static inline HashMapGroupMask HashMapGroup_match(const U8 *ctrl, U8 tag) {
+	return HashMapGroup_toMask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(tag)));
+}
+
+static inline HashMapGroupMask HashMapGroup_matchEmpty(const U8 *ctrl) {
+	return HashMapGroup_toMask(vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl))));
+}
+
+static inline U64 HashMapGroupMask_first(HashMapGroupMask mask) {
+	#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index = 0;
+		_BitScanForward64(&index, mask);
+		return index >> 2;
+	#else
+		return (U64) __builtin_ctzll(mask) >> 2;
+	#endif
+}
+
+static inline HashMapGroupMask HashMapGroupMask_clearFirst(HashMapGroupMask mask) {
+	return mask & ~((U64)0xF << (HashMapGroupMask_first(mask) << 2));
+}
+
+static inline HashMapGroupMask HashMapGroupMask_before(HashMapGroupMask mask, HashMapGroupMask before) {
+	return before ? mask & ((before & (~before + 1)) - 1) : mask;
+}
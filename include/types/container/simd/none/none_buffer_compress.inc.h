@@ -0,0 +1,45 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/simd/none/none_buffer_compress.inc.h
+
+#ifndef BUFFER_COMPRESS_NONE_GUARD
+	#error Compress none guard undefined, likely an include of none_buffer_compress.inc.h outside of buffer_compress.c
+#endif
+
+static inline void BufferCompress_copy16(U8 *dst, const U8 *src) {
+	for(U64 i = 0; i < 16; ++i)
+		dst[i] = src[i];
+}
+
+static inline U64 BufferCompress_equal16(const U8 *a, const U8 *b) {
+
+	U64 i = 0;
+
+	while(i < 16 && a[i] == b[i])
+		++i;
+
+	return i;
+}
+
+static inline void BufferCompress_pattern16(U8 *dst, const U8 *src, U64 offset) {
+	for(U64 i = 0; i < 16; ++i)
+		dst[i] = src[BufferCompress_patternShuffle[offset][i]];
+}
@@ -27,32 +27,8 @@
 //https://www.intel.com/content/dam/doc/white-paper/advanced-encryption-standard-new-instructions-set-paper.pdf
 //https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.197.pdf
 
-static inline U32 AES_rotWord(U32 a) {
-	return (a >> 8) | (a << 24);
-}
-
-I32x4 AES_keyGenAssist(I32x4 a, U8 i) {
-
-	if(i >= 11)
-		return I32x4_zero();
-
-	//https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html#text=_mm_aeskeygenassist_si128&ig_expand=6746,293
-
-	U32 x1 = I32x4_y(a);
-	U32 x3 = I32x4_w(a);
-
-	const U32 rcons[] = { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36 };
-	const U32 rcon = rcons[i];
-
-	x1 = AES_subWord(x1);
-	x3 = AES_subWord(x3);
-
-	return I32x4_create4(
-		x1,
-		AES_rotWord(x1) ^ rcon,
-		x3,
-		AES_rotWord(x3) ^ rcon
-	);
+static inline I32x4 AES_keyGenAssist(I32x4 a, U8 i) {
+	return AES_keyGenAssistSoftware(a, i);
 }
 
 typedef struct U8x4x4 {
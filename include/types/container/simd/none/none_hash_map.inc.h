@@ -0,0 +1,67 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/simd/none/none_hash_map.inc.h
+
+#ifndef HASH_MAP_NONE_GUARD
+	#error Hash map none guard was undefined, this likely indicates include of none_hash_map.inc.h outside of hash_map.c
+#endif
+
+//Same layout as the SSE mask (one bit per control byte), just built one byte at a time
+
+typedef U32 HashMapGroupMask;
+
+static inline HashMapGroupMask HashMapGroup_match(const U8 *ctrl, U8 tag) {
+
+	HashMapGroupMask mask = 0;
+
+	for(U8 i = 0; i < HashMap_groupSize; ++i)
+		mask |= (HashMapGroupMask)(ctrl[i] == tag) << i;
+
+	return mask;
+}
+
+static inline HashMapGroupMask HashMapGroup_matchEmpty(const U8 *ctrl) {
+
+	HashMapGroupMask mask = 0;
+
+	for(U8 i = 0; i < HashMap_groupSize; ++i)
+		mask |= (HashMapGroupMask)(ctrl[i] >> 7) << i;
+
+	return mask;
+}
+
+static inline U64 HashMapGroupMask_first(HashMapGroupMask mask) {
+
+	U64 i = 0;
+
+	while(!(mask & 1)) {
+		mask >>= 1;
+		++i;
+	}
+
+	return i;
+}
+
+static inline HashMapGroupMask HashMapGroupMask_clearFirst(HashMapGroupMask mask) { return mask & (mask - 1); }
+
+static inline HashMapGroupMask HashMapGroupMask_before(HashMapGroupMask mask, HashMapGroupMask before) {
+	return before ? mask & ((before & (~before + 1)) - 1) : mask;
+}
@@ -0,0 +1,58 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/simd/sse/sse_buffer_compress.inc.h
+
+#include <tmmintrin.h>
+
+#ifndef BUFFER_COMPRESS_SSE_GUARD
+	#error Compress SSE guard undefined, likely an include of sse_buffer_compress.inc.h outside of buffer_compress.c
+#endif
+
+static inline void BufferCompress_copy16(U8 *dst, const U8 *src) {
+	_mm_storeu_si128((__m128i*) dst, _mm_loadu_si128((const __m128i*) src));
+}
+
+//How many of the 16 bytes at a and b are equal before the first difference
+
+static inline U64 BufferCompress_equal16(const U8 *a, const U8 *b) {
+
+	const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) a), _mm_loadu_si128((const __m128i*) b));
+	const U32 diff = ~(U32)_mm_movemask_epi8(eq) & 0xFFFF;
+
+	if(!diff)
+		return 16;
+
+	#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index = 0;
+		_BitScanForward(&index, diff);
+		return index;
+	#else
+		return (U64) __builtin_ctz(diff);
+	#endif
+}
+
+//Repeats the first offset (< 16) bytes of src over 16 bytes of dst.
+//src[offset, 16> is read but not used, so it has to be addressable.
+
+static inline void BufferCompress_pattern16(U8 *dst, const U8 *src, U64 offset) {
+	const __m128i shuffle = _mm_loadu_si128((const __m128i*) BufferCompress_patternShuffle[offset]);
+	_mm_storeu_si128((__m128i*) dst, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) src), shuffle));
+}
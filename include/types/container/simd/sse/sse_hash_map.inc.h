@@ -0,0 +1,60 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/simd/sse/sse_hash_map.inc.h
+
+#include <emmintrin.h>
+
+#ifndef HASH_MAP_SSE_GUARD
+	#error Hash map SSE guard was undefined, this likely indicates include of sse_hash_map.inc.h outside of hash_map.c
+#endif
+
+//One bit per control byte, bit i is slot i of the group
+
+typedef U32 HashMapGroupMask;
+
+static inline HashMapGroupMask HashMapGroup_match(const U8 *ctrl, U8 tag) {
+	const __m128i group = _mm_loadu_si128((const __m128i*) ctrl);
+	return (U32) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((I8) tag)));
+}
+
+//Empty is the only control byte with the high bit set, which is exactly what movemask reads
+
+static inline HashMapGroupMask HashMapGroup_matchEmpty(const U8 *ctrl) {
+	return (U32) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) ctrl));
+}
+
+static inline U64 HashMapGroupMask_first(HashMapGroupMask mask) {
+	#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index = 0;
+		_BitScanForward(&index, mask);
+		return index;
+	#else
+		return (U64) __builtin_ctz(mask);
+	#endif
+}
+
+static inline HashMapGroupMask HashMapGroupMask_clearFirst(HashMapGroupMask mask) { return mask & (mask - 1); }
+
+//Keeps the lanes before the first lane of 'before' (all lanes if it's empty)
+
+static inline HashMapGroupMask HashMapGroupMask_before(HashMapGroupMask mask, HashMapGroupMask before) {
+	return before ? mask & ((before & (~before + 1)) - 1) : mask;
+}
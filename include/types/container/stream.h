@@ -41,10 +41,11 @@ typedef enum EStreamType {
 	EStreamType_Memory            = 1 << 0,
 	EStreamType_File            = 1 << 1,
 	EStreamType_ArchiveEntry    = 1 << 2,
-	EStreamType_Compressed        = 1 << 3,        //Unsupported
+	EStreamType_Compressed        = 1 << 3,        //Readonly, see CompressionStream
 	EStreamType_Encrypted        = 1 << 4,
 	EStreamType_Resizable        = 1 << 5,
-	EStreamType_DisableSeek        = 1 << 6        //It's impossible to restart this stream (e.g. network stream)
+	EStreamType_DisableSeek        = 1 << 6,        //It's impossible to restart this stream (e.g. network stream)
+	EStreamType_Mapped            = 1 << 7        //Readonly, addressable through OxStream::mapped
 } EStreamType;
 
 typedef struct OxStream {
@@ -54,16 +55,21 @@ typedef struct OxStream {
 	StreamCloseFunc close;
 	U64 size;
 	U64 streamType;            //EStreamType, except extendible
+	const U8 *mapped;        //EStreamType_Mapped only: size bytes that stay valid as long as the stream does
 } OxStream;
 
 typedef RefPtr StreamRef;
 
+typedef struct StreamReadAhead StreamReadAhead;
+
 typedef struct StreamCursor {
 
 	StreamRef *stream;
 
 	Buffer cacheData;            //Temporary cache
 
+	StreamReadAhead *readAhead;    //Optional, see StreamCursor_enableReadAhead
+
 	U64 lastLocation;            //Last location the cache was fetched from
 	U64 lastWriteLocation;        //If writable only, TODO: Maybe lastReadLocation to allow switching mode? (reduce overhead)
 
@@ -120,6 +126,16 @@ Bool StreamCursor_createWithCache(
 
 Bool StreamCursor_flush(StreamCursor *cursor, const Allocator *alloc, Error *e_rr);
 
+//Lets a worker thread prefetch the next depth caches (0 = 2, at most 16) of a sequential reader.
+//Reads turn sequential when a cache refill starts where the previous cache ended, the next caches are then requested.
+//A refill that finds its cache prefetched swaps buffers instead of reading, any other refill waits for the worker
+// and reads as before, so random access only costs the extra depth * cacheSize of memory.
+//The worker reads the stream while the owner keeps going, so the stream has to allow concurrent reads.
+//Memory, file and encrypted streams do (a concurrent decrypt that finds the shared cache busy uses its own).
+//The stream can't be written while prefetching (StreamCursor_flush/setWritable drop what was prefetched).
+//alloc is used from the worker too and has to outlive the cursor; StreamCursor_close joins the worker.
+Bool StreamCursor_enableReadAhead(StreamCursor *cursor, U64 depth, const Allocator *alloc, Error *e_rr);
+
 //Turns a readwrite (or readonly) stream into a readonly stream until setWritable is enabled again.
 //Returns false if not readable.
 Bool StreamCursor_setReadOnly(StreamCursor *cursor, const Allocator *alloc, Error *e_rr);
@@ -168,6 +184,19 @@ Bool StreamCursor_read(
 	Error *e_rr
 );
 
+//Returns a readonly view of length bytes at offset without copying them if the stream is EStreamType_Mapped.
+//That view points into the mapping (e.g. a memory mapped file), so it's valid while the stream is referenced.
+//Other streams load the range into the cache (so length can't exceed it) and return a view into the cache instead.
+//That one is only valid until the cursor is used (or closed) again.
+Bool StreamCursor_view(
+	StreamCursor *cursor,
+	U64 offset,
+	U64 length,
+	Buffer *output,
+	const Allocator *alloc,
+	Error *e_rr
+);
+
 //Expensively compare the two streams, this is only valid if both streams are seekable.
 //As otherwise reading them might cause the stream to change.
 //Avoid using this in heavy paths, as this is a full stream compare.
@@ -183,6 +212,19 @@ Bool Stream_compare(
 	Error *e_rr
 );
 
+typedef struct BufferHashState BufferHashState;
+
+//Feeds length bytes (0 = the rest of the stream) at offset into state (BufferHashState_create, see buffer.h).
+//The stream is read a cache at a time, so a big file can be hashed without loading it into memory.
+Bool StreamCursor_hash(
+	StreamCursor *cursor,
+	U64 offset,
+	U64 length,
+	BufferHashState *state,
+	const Allocator *alloc,
+	Error *e_rr
+);
+
 //Consumes stream at *it into cursor (and copies into v) and increments *it.
 static inline Bool StreamCursor_consume(
 	StreamCursor *cursor,
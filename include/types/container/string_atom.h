@@ -0,0 +1,111 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/string_atom.h
+
+#pragma once
+#include "types/base/lock.h"
+#include "types/base/string_base.h"
+#include "types/container/arena.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+//Interned strings: every distinct string added to a StringAtomTable gets one StringAtom, a small id that stays the
+// same for the lifetime of the table.
+//Two atoms from the same table are equal exactly when their strings are (case sensitive), so names that are
+// compared over and over (path components, input handles, entrypoints, defines, variable names) can be interned
+// once and compared with == afterwards, and the hash is computed once when the string is interned.
+//
+//The characters are copied into the table's Arena, so interning many short names costs a bump each rather than an
+// allocation each, and StringAtomTable_string hands out a null terminated const ref that stays valid until free.
+//
+//Interning and finding take the RWLock (read for a lookup, write only to add a new string).
+//StringAtomTable_string and _hash don't take a lock at all, the entries never move once they're published.
+//The table can't be moved after creation, since its arena can't.
+
+typedef U32 StringAtom;
+
+#define StringAtom_none ((StringAtom)0)            //Never returned for an interned string
+
+#define StringAtomTable_pageSize 1024
+#define StringAtomTable_maxPages 1024              //So up to 1M - 1 atoms
+
+typedef struct StringAtomEntry {
+	CharString str;                 //Const ref into the arena
+	U64 hash;                       //CharString_hash(str)
+} StringAtomEntry;
+
+THashMapNamed(CharString, StringAtom, StringAtomMap);
+
+typedef struct StringAtomTable {
+
+	RWLock lock;
+
+	AtomicI64 count;                //Atoms handed out + 1, published after the entry is written
+
+	StringAtomEntry **pages;        //[StringAtomTable_maxPages], allocated from alloc so it never moves
+	StringAtomMap map;              //String -> atom, the key is the entry's str
+
+	const Allocator *alloc;
+	Arena arena;                    //Characters and pages
+
+} StringAtomTable;
+
+//table has to be zero initialized (or freed)
+Bool StringAtomTable_create(const Allocator *alloc, StringAtomTable *table, Error *e_rr);
+void StringAtomTable_free(StringAtomTable *table);
+
+//Returns the atom of str, interning it first if it wasn't present yet
+Bool StringAtomTable_intern(StringAtomTable *table, CharString str, StringAtom *atom, Error *e_rr);
+
+//StringAtom_none if str was never interned
+StringAtom StringAtomTable_find(StringAtomTable *table, CharString str);
+
+static inline U64 StringAtomTable_count(StringAtomTable *table) {
+	return table && table->pages ? (U64) AtomicI64_load(&table->count) - 1 : 0;
+}
+
+//NULL for StringAtom_none or an atom that this table didn't hand out
+
+static inline const StringAtomEntry *StringAtomTable_entry(StringAtomTable *table, StringAtom atom) {
+
+	if(!atom || atom > StringAtomTable_count(table))
+		return NULL;
+
+	return &table->pages[atom / StringAtomTable_pageSize][atom % StringAtomTable_pageSize];
+}
+
+//Empty string for StringAtom_none or an unknown atom
+
+static inline CharString StringAtomTable_string(StringAtomTable *table, StringAtom atom) {
+	const StringAtomEntry *entry = StringAtomTable_entry(table, atom);
+	return entry ? entry->str : CharString_createNull();
+}
+
+static inline U64 StringAtomTable_hash(StringAtomTable *table, StringAtom atom) {
+	const StringAtomEntry *entry = StringAtomTable_entry(table, atom);
+	return entry ? entry->hash : 0;
+}
+
+#ifdef __cplusplus
+	}
+#endif
@@ -0,0 +1,105 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/trace.h
+
+#pragma once
+#include "types/base/types.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+typedef struct Allocator Allocator;
+typedef struct Error Error;
+typedef struct CharString CharString;
+
+//Tracing: zones, counters and instant events recorded per thread, exported in the Chrome trace event format
+// (load the JSON in chrome://tracing or ui.perfetto.dev).
+//
+//Only compiled in with -DEnableTracing=ON (_ENABLE_TRACING=1); otherwise Trace_zoneBegin/End, Trace_counter and
+// Trace_instant expand to nothing and their arguments aren't even evaluated.
+//Trace_start, Trace_stop, Trace_clear and Trace_exportChrome always exist, so the code driving a capture doesn't
+// need the define; with tracing compiled out the capture is simply empty.
+//
+//Every thread appends to a chunk of its own, so recording an event is a timestamp, a few stores and no lock.
+//A full chunk stays where it is and the thread allocates a new one, which it publishes to a global lock-free list.
+//The event count of a chunk is published after the event itself, so Trace_exportChrome can read everything that
+// was recorded so far while other threads keep recording.
+//
+//category and name have to be static strings (they're stored as pointers) without quotes or backslashes.
+//A zone has to end on the thread that began it (Chrome matches them per thread, like a stack).
+
+#ifndef _ENABLE_TRACING
+	#define _ENABLE_TRACING 0
+#endif
+
+typedef enum ETraceEvent {
+	ETraceEvent_Begin,
+	ETraceEvent_End,
+	ETraceEvent_Counter,
+	ETraceEvent_Instant
+} ETraceEvent;
+
+typedef struct TraceEvent {
+	const C8 *category;
+	const C8 *name;
+	Ns time;
+	I64 value;                  //Counter only
+	U64 type;                   //ETraceEvent
+} TraceEvent;
+
+//alloc is used for the chunks of every thread that records, so it has to be thread safe and outlive the capture.
+//Starting again after a stop continues the same capture.
+Bool Trace_start(const Allocator *alloc, Error *e_rr);
+void Trace_stop();
+Bool Trace_isRecording();
+
+//Frees everything that was recorded, call it when no thread can still be recording (after Trace_stop and after
+// the traced threads finished what they were doing, e.g. a JobQueue_wait).
+void Trace_clear();
+
+//Number of events that were dropped because a chunk couldn't be allocated
+U64 Trace_dropped();
+
+//{ "traceEvents": [ ... ] } with timestamps in microseconds since Trace_start, pid 1 and the OS thread id as tid.
+Bool Trace_exportChrome(const Allocator *alloc, CharString *result, Error *e_rr);
+
+#if _ENABLE_TRACING
+
+	void Trace_record(ETraceEvent type, const C8 *category, const C8 *name, I64 value);
+
+	#define Trace_zoneBegin(category, name) Trace_record(ETraceEvent_Begin, category, name, 0)
+	#define Trace_zoneEnd(category, name) Trace_record(ETraceEvent_End, category, name, 0)
+	#define Trace_counter(category, name, value) Trace_record(ETraceEvent_Counter, category, name, (I64)(value))
+	#define Trace_instant(category, name) Trace_record(ETraceEvent_Instant, category, name, 0)
+
+#else
+
+	#define Trace_zoneBegin(category, name) ((void)0)
+	#define Trace_zoneEnd(category, name) ((void)0)
+	#define Trace_counter(category, name, value) ((void)0)
+	#define Trace_instant(category, name) ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+	}
+#endif
@@ -168,7 +168,14 @@ static inline Bool U128_base2(const BigIntStringify *stringify, EIntEncoding enc
 	return BigInt_base2(stringify, encoding, b, e_rr);
 }
 
-//Bool U128_dec(const BigIntStringify *stringify, U128 a, Error *e_rr);
+static inline Bool U128_dec(const BigIntStringify *stringify, U128 a, Error *e_rr) {
+
+	BigInt b = { 0 };
+	if (!BigInt_createRefConst((const U64*) &a, 2, &b, e_rr))
+		return false;
+
+	return BigInt_toString(stringify, EIntEncoding_Dec, b, e_rr);
+}
 
 static inline Bool U128_hex(const BigIntStringify *stringify, U128 a, Error *e_rr) {
 	return U128_base2(stringify, EIntEncoding_Hex, a, e_rr);
@@ -95,7 +95,7 @@ Bool CAFile_dataEqual(
 			retError(clean, Error_invalidState(0, "CAFile_dataEqual()::failed to get buffer for a"));
 
 		gotoIfError3(clean, MemoryStream_createFromBufferRegion(
-			aData, 0, 0, EMemoryStreamFlags_None, &memType, &aStream, e_rr
+			aData, 0, Buffer_length(aData), EMemoryStreamFlags_None, &memType, &aStream, e_rr
 		));
 
 		aOff = 0;
@@ -114,7 +114,7 @@ Bool CAFile_dataEqual(
 			retError(clean, Error_invalidState(0, "CAFile_dataEqual()::failed to get buffer for b"));
 
 		gotoIfError3(clean, MemoryStream_createFromBufferRegion(
-			bData, 0, 0, EMemoryStreamFlags_None, &memType, &bStream, e_rr
+			bData, 0, Buffer_length(bData), EMemoryStreamFlags_None, &memType, &bStream, e_rr
 		));
 
 		bOff = 0;
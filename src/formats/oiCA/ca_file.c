@@ -48,9 +48,6 @@ Bool CAFile_create(
 	if (settings->compressionType >= EXXCompressionType_Count)
 		retError(clean, Error_invalidParameter(0, 0, "CAFile_create()::settings.compressionType is invalid"));
 
-	if (settings->compressionType > EXXCompressionType_None)
-		retError(clean, Error_unsupportedOperation(0, "CAFile_create() compression not supported yet"));        //TODO:
-
 	if (settings->flags & ECASettingsFlags_Invalid)
 		retError(clean, Error_invalidParameter(0, 0, "CAFile_create()::settings->flags contains invalid flags"));
 
@@ -29,6 +29,7 @@
 #include "types/container/stream.h"
 #include "types/container/container_types.h"
 #include "types/container/list_basic_types.h"
+#include "types/container/trace.h"
 #include "types/math/vec4i.h"
 #include "types/base/time.h"
 
@@ -95,6 +96,8 @@ Bool CAFile_read(
 	DLFile names = (DLFile) { 0 };
 	DLFile content = (DLFile) { 0 };
 
+	Trace_zoneBegin("oiCA", "CAFile_read");
+
 	if (!file || file->refPtrType->typeId != (TypeId)EContainerTypeId_Stream)
 		retError(clean, Error_nullPointer(0, "CAFile_read()::file must be a valid StreamRef"));
 
@@ -354,6 +357,8 @@ Bool CAFile_read(
 	if (content.settings.dataType != EDLDataType_Data)
 		retError(clean, Error_invalidState(0, "CAFile_read()::content DLFile must have data type"));
 
+	settings.compressionType = content.settings.compressionType;        //The oiCA header doesn't store it, the DLFiles do
+
 	//Validate all name entries: must already be in memory (not stream-backed) and within the name size limit.
 	//Small entries are loaded into the DLFile cache by DLFile_read automatically, so if an entry is still
 	// stream-backed it means it exceeded DLFile_smallLen, which means it also exceeds CAFile_maxFileNameSize
@@ -479,5 +484,6 @@ clean:
 	if(!s_uccess && allocated)
 		CAFile_free(caFile, alloc);
 
+	Trace_zoneEnd("oiCA", "CAFile_read");
 	return s_uccess;
 }
@@ -26,6 +26,7 @@
 #include "types/container/stream.h"
 #include "types/container/container_types.h"
 #include "types/container/buffer_encrypt.h"
+#include "types/container/trace.h"
 #include "types/math/vec4i.h"
 #include "types/base/time.h"
 #include "types/base/mathi.h"
@@ -59,6 +60,8 @@ Bool CAFile_write(
 	Buffer tmp = Buffer_createNull();
 	I32x4 iv = I32x4_zero();
 
+	Trace_zoneBegin("oiCA", "CAFile_write");
+
 	if (!caFile || !caFile->folders.ptr || !startOffset)
 		retError(clean, Error_nullPointer(
 			!result ? 2 : (!startOffset ? 3 : 0), "CAFile_write()::caFile and startOffset are required"
@@ -72,9 +75,6 @@ Bool CAFile_write(
 	if (settings->compressionType >= EXXCompressionType_Count)
 		retError(clean, Error_invalidParameter(0, 0, "CAFile_write()::compressionType is invalid"));
 
-	if (settings->compressionType != EXXCompressionType_None)
-		retError(clean, Error_unsupportedOperation(0, "CAFile_write()::compressionType not supported yet"));    //TODO:
-
 	if (settings->encryptionType >= EXXEncryptionType_Count)
 		retError(clean, Error_invalidParameter(0, 1, "CAFile_write()::encryptionType is invalid"));
 
@@ -130,10 +130,17 @@ Bool CAFile_write(
 	//Align to 16 bytes before DLFiles
 
 	headerSize = (headerSize + 15) & ~(U64)15;
-	gotoIfError3(clean, DLFile_write(&caFile->names, alloc, NULL, encStreamType, I32x4_zero(), &headerSize, e_rr));
 
-	headerSize = (headerSize + 15) & ~(U64)15;
-	gotoIfError3(clean, DLFile_write(&caFile->content, alloc, NULL, encStreamType, I32x4_zero(), &headerSize, e_rr));
+	//Compressed DLFiles would have to be compressed twice just to know their size, so that only happens if it's requested.
+	//Otherwise only the fixed header is reserved and DLFile_write reserves its own part of the stream.
+
+	if (!result || !settings->compressionType) {
+
+		gotoIfError3(clean, DLFile_write(&caFile->names, alloc, NULL, encStreamType, I32x4_zero(), &headerSize, e_rr));
+
+		headerSize = (headerSize + 15) & ~(U64)15;
+		gotoIfError3(clean, DLFile_write(&caFile->content, alloc, NULL, encStreamType, I32x4_zero(), &headerSize, e_rr));
+	}
 
 	if (!result) {
 		*startOffset += headerSize;
@@ -318,5 +325,6 @@ clean:
 	iv = I32x4_zero();
 	StreamCursor_close(&cursor, alloc);
 	Buffer_free(&tmp, alloc);
+	Trace_zoneEnd("oiCA", "CAFile_write");
 	return s_uccess;
 }
@@ -26,6 +26,7 @@
 #include "formats/oiCA/ca_file.h"
 #include "formats/oiCA/ca_lookup.h"
 #include "formats/oiCA/ca_props.h"
+#include "formats/oiCA/ca_compare.h"
 #include "types/base/time.h"
 
 CAHandle addFile(Test *t, CAFile *ca, CAHandle parent, const C8 *name, Ns time, Bool failIsSuccess);
@@ -611,3 +612,101 @@ void Test_CASerializeStreamBacked(Test *t) {
 		CAFile_free(&ca2, t->alloc);
 	}
 }
+
+//Write with --fast-compress (optionally encrypted), every file has to come back the same.
+//One file spans multiple 64KiB blocks and is kept in a stream, so reading it decompresses on demand.
+void Test_CASerializeCompressed(Test *t) {
+
+	Test_setModule(t, "CAFile serialize: compressed");
+
+	const RefPtrType type = MemoryStream_makeType(t->alloc);
+	const RefPtrType encStreamType = EncryptionStream_makeType(t->alloc);
+
+	for (U8 encrypted = 0; encrypted < 2; ++encrypted) {
+
+		CASettings settings = kCASettings;
+		settings.compressionType = EXXCompressionType_LZ;
+
+		if (encrypted) {
+			settings.encryptionType = EXXEncryptionType_AES256GCM;
+			Buffer_memcpy(
+				Buffer_createRef(settings.encryptionKey, sizeof(settings.encryptionKey)),
+				Buffer_createRefConst(kTestKey, sizeof(kTestKey))
+			);
+		}
+
+		CAFile ca = { 0 };
+		CAFile ca2 = { 0 };
+		StreamRef *sr = NULL;
+		Buffer big = Buffer_createNull();
+		Buffer small = Buffer_createNull();
+
+		if (!CAFile_create(&settings, 0, 0, t->alloc, &ca, &t->err)) {
+			Test_assert(t, "create ca compressed", false);
+			goto doneCompressed;
+		}
+
+		const U64 bigLen = 300 * KIBI + 123;
+
+		if (
+			!Buffer_createUninitializedBytes(bigLen, t->alloc, &big, &t->err) ||
+			!Buffer_createUninitializedBytes(100, t->alloc, &small, &t->err)
+		) {
+			Test_assert(t, "alloc compressed data", false);
+			goto doneCompressed;
+		}
+
+		for (U64 i = 0; i < bigLen; ++i)        //Compressible, but not trivially so
+			big.ptrNonConst[i] = (U8)((i / 7) ^ (i % 13 == 0 ? 0x5A : 0) ^ (i >> 12));
+
+		for (U64 i = 0; i < 100; ++i)
+			small.ptrNonConst[i] = (U8)(i * 31);
+
+		const CAHandle hBig = addFile(t, &ca, CAHandle_Root, "big.bin", 0, false);
+		const CAHandle hSmall = addFile(t, &ca, CAHandle_Root, "small.bin", 0, false);
+		addFile(t, &ca, CAHandle_Root, "empty.bin", 0, false);
+
+		Test_assert(t, "setData big", CAFile_setData(&ca, hBig, t->alloc, &big, &t->err));
+		Test_assert(t, "setData small", CAFile_setData(&ca, hSmall, t->alloc, &small, &t->err));
+
+		if (!MemoryStream_create(0, EMemoryStreamFlags_WriteResize, &type, &sr, &t->err)) {
+			Test_assert(t, "MemoryStream compressed create", false);
+			goto doneCompressed;
+		}
+
+		U64 streamOff = 0;
+		Test_assert(
+			t, "write compressed",
+			CAFile_write(&ca, encrypted ? &encStreamType : NULL, sr, &streamOff, t->alloc, &t->err)
+		);
+
+		Test_assert(t, "compressed is smaller", streamOff < bigLen * 3 / 4);
+
+		Test_assert(
+			t, "read compressed",
+			CAFile_read(sr, encrypted ? &encStreamType : NULL, 0, encrypted ? kTestKey : NULL, t->alloc, &ca2, &t->err)
+		);
+
+		Test_assert(t, "compression type kept", ca2.settings.compressionType == EXXCompressionType_LZ);
+
+		const C8 *names[] = { "big.bin", "small.bin", "empty.bin" };
+
+		for (U64 i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+
+			const CAHandle a = CAFile_resolveCStr(&ca, names[i]);
+			const CAHandle b = CAFile_resolveCStr(&ca2, names[i]);
+			Test_assert(t, "resolve compressed file", a != CAHandle_Invalid && b != CAHandle_Invalid);
+
+			ECompareResult cmp = ECompareResult_Lt;
+			Test_assert(t, "compare compressed file", CAFile_dataEqual(&ca, a, &ca2, b, t->alloc, &cmp, &t->err));
+			Test_assert(t, "compressed content matches", cmp == ECompareResult_Eq);
+		}
+
+	doneCompressed:
+		Buffer_free(&big, t->alloc);
+		Buffer_free(&small, t->alloc);
+		RefPtr_dec(&sr);
+		CAFile_free(&ca, t->alloc);
+		CAFile_free(&ca2, t->alloc);
+	}
+}
@@ -71,3 +71,4 @@ void Test_CASerializeFullDate(Test *t);
 void Test_CASerializeEncrypted(Test *t);
 void Test_CASerializeMultipleFiles(Test *t);
 void Test_CASerializeStreamBacked(Test *t);
+void Test_CASerializeCompressed(Test *t);
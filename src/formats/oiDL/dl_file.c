@@ -51,9 +51,6 @@ Bool DLFile_createInternal(
 	if(settings->compressionType >= EXXCompressionType_Count)
 		retError(clean, Error_invalidParameter(0, 0, "DLFile_create()::settings.compressionType is invalid"));
 
-	if(settings->compressionType != EXXCompressionType_None)
-		retError(clean, Error_invalidOperation(0, "DLFile_create() compression not supported yet"));        //TODO:
-
 	if(settings->encryptionType >= EXXEncryptionType_Count)
 		retError(clean, Error_invalidParameter(0, 1, "DLFile_create()::settings.encryptionType is invalid"));
 
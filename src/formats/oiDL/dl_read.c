@@ -27,6 +27,7 @@
 #include "types/base/error.h"
 #include "types/container/buffer.h"
 #include "types/container/encryption_stream.h"
+#include "types/container/compression_stream.h"
 #include "types/container/buffer_encrypt.h"
 #include "types/base/constants.h"
 #include "types/base/mathi.h"
@@ -90,7 +91,7 @@ Bool DLFile_read(
 	gotoIfError3(clean, StreamCursor_consume(&cursor, &streamOff, &header, sizeof(header), alloc, e_rr));
 
 	EXXDataSizeType entrySizeType = (EXXDataSizeType)(header.sizeTypes & 3);
-	//EXXDataSizeType uncompressedSizeType = (EXXDataSizeType)((header.sizeTypes >> 2) & 3);
+	EXXDataSizeType compressedSizeType = (EXXDataSizeType)((header.sizeTypes >> 2) & 3);
 	EXXDataSizeType dataSizeType = (EXXDataSizeType)(header.sizeTypes >> 4);
 
 	//Validate header
@@ -98,8 +99,8 @@ Bool DLFile_read(
 	if(header.version != EDLVersion_V1_0)
 		retError(clean, Error_invalidParameter(0, 1, "DLFile_read() header.version is invalid"));
 
-	if(header.type >> 4)                                //TODO: Compression
-		retError(clean, Error_unsupportedOperation(1, "DLFile_read() compression not supported yet"));
+	if((header.type >> 4) >= EXXCompressionType_Count)
+		retError(clean, Error_invalidParameter(0, 3, "DLFile_read() invalid compression type"));
 
 	if((header.type & 0xF) >= EXXEncryptionType_Count)
 		retError(clean, Error_invalidParameter(0, 4, "DLFile_read() invalid encryption type"));
@@ -159,6 +160,16 @@ Bool DLFile_read(
 		dataSize += entryLen;
 	}
 
+	//Compressed size (of the blocked layout, see buffer_compress.h)
+
+	Bool isCompressed = header.type >> 4;
+	U64 storedSize = dataSize;
+
+	if (isCompressed)
+		gotoIfError3(clean, StreamCursor_consumeSizeType(
+			&cursor, &streamOff, compressedSizeType, &storedSize, alloc, e_rr
+		));
+
 	//Decrypt
 
 	U64 chunkSize = 0;            //No chunkSize by default (32KiB for stream cursors)
@@ -192,7 +203,7 @@ Bool DLFile_read(
 
 		chunkSize = DLHeader_chunkSizes[chunkSize2];
 
-		U64 realDataSize = EncryptionStream_underlyingSize(chunkSize, dataSize);
+		U64 realDataSize = EncryptionStream_underlyingSize(chunkSize, storedSize);
 
 		if (streamOff + realDataSize > stream->size)
 			retError(clean, Error_outOfBounds(
@@ -230,7 +241,7 @@ Bool DLFile_read(
 			encryptionKey,
 			iv,
 			chunkSize,
-			dataSize,
+			storedSize,
 			encryptionStreamType,
 			&dataStream,
 			e_rr
@@ -248,6 +259,21 @@ Bool DLFile_read(
 		RefPtr_inc(dataStream);
 	}
 
+	//Decompress blocks on demand, so entries that are kept in the stream can still be seeked into
+
+	if (isCompressed) {
+
+		StreamRef *compStream = NULL;
+
+		gotoIfError3(clean, CompressionStream_create(
+			dataStream, fileStart, storedSize, dataSize, alloc, &compStream, e_rr
+		));
+
+		RefPtr_dec(&dataStream);
+		dataStream = compStream;
+		fileStart = 0;        //We're now relative to the compression stream
+	}
+
 	//Allocate DLFile
 
 	DLSettings settings = (DLSettings) {
@@ -317,7 +343,7 @@ Bool DLFile_read(
 		//We'll create a new cursor if our previous cursor is too small,
 		// because the previous cursor is constantly looking at entryStart + i * entryStride
 
-		Bool isInPrimaryCursor = !isEncrypted && StreamCursor_contains(&cursor, dataOff, entryLen);
+		Bool isInPrimaryCursor = !isEncrypted && !isCompressed && StreamCursor_contains(&cursor, dataOff, entryLen);
 
 		if (!isInPrimaryCursor && !cursorEntry.cacheData.ptr)
 			gotoIfError3(clean, StreamCursor_create(
@@ -367,7 +393,7 @@ Bool DLFile_read(
 		}
 	}
 
-	streamOff += isEncrypted ? EncryptionStream_underlyingSize(chunkSize, dataSize) : dataSize;
+	streamOff += isEncrypted ? EncryptionStream_underlyingSize(chunkSize, storedSize) : storedSize;
 
 	if(!isSubFile && streamOff != stream->size)
 		retError(clean, Error_invalidState(1, "DLFile_read() contained extra data, not allowed if it's not a subfile"));
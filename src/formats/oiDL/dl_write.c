@@ -26,13 +26,109 @@
 #include "types/container/buffer_encrypt.h"
 #include "types/container/ref_ptr.h"
 #include "types/container/encryption_stream.h"
+#include "types/container/buffer_compress.h"
 #include "types/container/container_types.h"
 #include "types/base/allocator.h"
 #include "types/base/error.h"
 #include "types/base/mathi.h"
 
-//We currently don't support compression yet.
-//But once Buffer_compress/decompress is available, it should be easy.
+//Compresses the contents of every entry into the blocked layout of buffer_compress.h.
+//Entries are streamed into blocks one after another, so only a block at a time of a partially loaded entry is loaded.
+
+static Bool DLFile_compressEntries(
+	const DLFile *dlFile,
+	U64 totalSize,
+	const Allocator *alloc,
+	ListU8 *data,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+	Buffer block = Buffer_createNull();
+	StreamCursor inputCursor = (StreamCursor) { 0 };
+	StreamRef *prevStream = NULL;
+
+	const U64 blockCount = BufferCompress_blockCount(totalSize);
+	const U64 tableSize = blockCount * sizeof(BufferCompressBlock);
+	const Bool isString = dlFile->settings.dataType == EDLDataType_String;
+
+	gotoIfError3(clean, ListU8_reserve(data, tableSize + totalSize / 2, alloc, e_rr));
+	gotoIfError3(clean, ListU8_resize(data, tableSize, alloc, e_rr));
+	gotoIfError3(clean, Buffer_createUninitializedBytes(BufferCompress_blockSize, alloc, &block, e_rr));
+
+	U64 blockId = 0, blockUsed = 0;
+
+	for (U64 i = 0; i < DLFile_entryCount(dlFile); ++i) {
+
+		const U64 siz = DLFile_entrySize(dlFile, i);
+		const Bool isFullyLoaded = DLFile_isFullyLoaded(dlFile, i);
+		const DLEntryStream inputStream = dlFile->entryStreams.ptr[i];
+
+		const U8 *ptr = NULL;
+
+		if (isFullyLoaded)
+			ptr = isString ? (const U8*)dlFile->entryStrings.ptr[i].ptr : dlFile->entryBuffers.ptr[i].ptr;
+
+		else if (inputStream.stream != prevStream) {
+			StreamCursor_close(&inputCursor, alloc);
+			gotoIfError3(clean, StreamCursor_create(inputStream.stream, 0, false, alloc, &inputCursor, e_rr));
+			prevStream = inputStream.stream;
+		}
+
+		for (U64 off = 0; off < siz; ) {
+
+			const U64 len = U64_min(siz - off, BufferCompress_blockSize - blockUsed);
+			Buffer input = Buffer_createNull();
+
+			//Whole blocks of loaded entries don't need to be copied first
+
+			if (ptr && len == BufferCompress_blockSize)
+				input = Buffer_createRefConst(ptr + off, len);
+
+			else {
+
+				if (ptr)
+					Buffer_memcpy(Buffer_createRef(block.ptrNonConst + blockUsed, len), Buffer_createRefConst(ptr + off, len));
+
+				else gotoIfError3(clean, StreamCursor_read(
+					&inputCursor, block, inputStream.dataOff + off, blockUsed, len, false, alloc, e_rr
+				));
+
+				blockUsed += len;
+
+				if (blockUsed == BufferCompress_blockSize)
+					input = block;
+			}
+
+			off += len;
+
+			if (Buffer_length(input)) {
+
+				BufferCompressBlock compressed;
+				gotoIfError3(clean, BufferCompress_appendBlock(input, data, &compressed, alloc, e_rr));
+
+				((BufferCompressBlock*)data->ptrNonConst)[blockId++] = compressed;
+				blockUsed = 0;
+			}
+		}
+	}
+
+	if (blockUsed) {
+		BufferCompressBlock compressed;
+		gotoIfError3(clean, BufferCompress_appendBlock(
+			Buffer_createRefConst(block.ptr, blockUsed), data, &compressed, alloc, e_rr
+		));
+		((BufferCompressBlock*)data->ptrNonConst)[blockId++] = compressed;
+	}
+
+	if (blockId != blockCount)
+		retError(clean, Error_invalidState(0, "DLFile_compressEntries() block count mismatch"));
+
+clean:
+	StreamCursor_close(&inputCursor, alloc);
+	Buffer_free(&block, alloc);
+	return s_uccess;
+}
 
 Bool DLFile_write(
 	const DLFile *dlFile,
@@ -50,6 +146,7 @@ Bool DLFile_write(
 	Buffer tmp = Buffer_createNull();
 	Buffer loadCache = Buffer_createNull();
 	StreamRef *encryptionStream = NULL;
+	ListU8 compressed = (ListU8) { 0 };
 
 	if(!DLFile_isAllocated(dlFile))
 		retError(clean, Error_nullPointer(0, "DLFile_write()::dlFile is required"));
@@ -62,8 +159,8 @@ Bool DLFile_write(
 
 	OxStream *stream = RefPtr_data(streamRef, OxStream);
 
-	if (dlFile->settings.compressionType)        //TODO: Compression
-		retError(clean, Error_unsupportedOperation(0, "DLFile_write() doesn't support compression yet"));
+	if (dlFile->settings.compressionType >= EXXCompressionType_Count)
+		retError(clean, Error_invalidParameter(0, 0, "DLFile_write() has an invalid compressionType"));
 
 	if(dlFile->settings.chunkSize && !dlFile->settings.encryptionType)
 		retError(clean, Error_unsupportedOperation(0, "DLFile_write() had chunkSize but no encryption"));
@@ -96,6 +193,16 @@ Bool DLFile_write(
 	if (totalSize >> 48)
 		retError(clean, Error_outOfBounds(0, totalSize, (U64)1 << 48, "DLFile_write() totalSize out of bounds"));
 
+	//Compression happens up front, since the header needs the compressed size (even if only the size is requested)
+
+	const Bool isCompressed = dlFile->settings.compressionType;
+	U64 storedSize = totalSize;
+
+	if (isCompressed) {
+		gotoIfError3(clean, DLFile_compressEntries(dlFile, totalSize, alloc, &compressed, e_rr));
+		storedSize = compressed.length;
+	}
+
 	U64 chunkSize = 0;
 	U8 chunkSize2 = 0;
 	EDLFlags dlFlags = EDLFlags_None;
@@ -118,7 +225,7 @@ Bool DLFile_write(
 
 			for (U8 i = 1; i < 3; ++i) {
 
-				if (totalSize <= 8 * DLHeader_chunkSizes[i])
+				if (storedSize <= 8 * DLHeader_chunkSizes[i])
 					break;
 
 				chunkSize = DLHeader_chunkSizes[i];
@@ -149,7 +256,7 @@ Bool DLFile_write(
 	//Add the chunks
 
 	if (isEncrypted)
-		totalSize = EncryptionStream_underlyingSize(chunkSize, totalSize);
+		storedSize = EncryptionStream_underlyingSize(chunkSize, storedSize);
 
 	//Get header size
 
@@ -167,6 +274,11 @@ Bool DLFile_write(
 	headerSize += SIZE_BYTE_TYPE[entrySizeType];
 	headerSize += dataSizeTypeSize * entryCount;
 
+	const EXXDataSizeType compressedSizeType = EXXDataSizeType_getRequiredType(compressed.length);
+
+	if (isCompressed)
+		headerSize += SIZE_BYTE_TYPE[compressedSizeType];
+
 	if (isEncrypted) {
 
 		headerSize += sizeof(I32x4);            //Tag for AAD and IV
@@ -180,14 +292,14 @@ Bool DLFile_write(
 	//Add to stream
 
 	if (!stream) {        //Handle size detection
-		*startOffset += headerSize + totalSize;
+		*startOffset += headerSize + storedSize;
 		goto clean;
 	}
 
 	if(stream->reserve)
-		gotoIfError3(clean, stream->reserve(stream, *startOffset + headerSize + totalSize, alloc, e_rr));
+		gotoIfError3(clean, stream->reserve(stream, *startOffset + headerSize + storedSize, alloc, e_rr));
 
-	U64 cursorSize = U64_max(U64_min(headerSize + totalSize, chunkSize + sizeof(CryptoChunk)), 32 * KIBI);
+	U64 cursorSize = U64_max(U64_min(headerSize + storedSize, chunkSize + sizeof(CryptoChunk)), 32 * KIBI);
 
 	gotoIfError3(clean, StreamCursor_create(streamRef, cursorSize, true, alloc, &cursor, e_rr));
 	
@@ -201,8 +313,8 @@ Bool DLFile_write(
 	DLHeader header = (DLHeader) {
 		.version = EDLVersion_V1_0,
 		.flags = (U8)dlFlags,
-		.type = (U8)dlFile->settings.encryptionType,
-		.sizeTypes = (U8)entrySizeType | ((U8)dataSizeType << 4)
+		.type = (U8)((dlFile->settings.compressionType << 4) | dlFile->settings.encryptionType),
+		.sizeTypes = (U8)entrySizeType | (isCompressed ? (U8)compressedSizeType << 2 : 0) | ((U8)dataSizeType << 4)
 	};
 
 	if (!(dlFile->settings.flags & EDLSettingsFlags_HideMagicNumber))
@@ -217,6 +329,11 @@ Bool DLFile_write(
 		gotoIfError3(clean, StreamCursor_appendSizeType(&cursor, startOffset, l, dataSizeType, alloc, e_rr));
 	}
 
+	if (isCompressed)
+		gotoIfError3(clean, StreamCursor_appendSizeType(
+			&cursor, startOffset, compressed.length, compressedSizeType, alloc, e_rr
+		));
+
 	//Encryption header
 
 	if (isEncrypted) {
@@ -309,12 +426,15 @@ Bool DLFile_write(
 
 	//Contents
 
-	if (isPartiallyLoaded)
+	if (isCompressed)
+		gotoIfError3(clean, StreamCursor_append(&cursor, startOffset, compressed.ptr, compressed.length, alloc, e_rr));
+
+	if (isPartiallyLoaded && !isCompressed)
 		gotoIfError3(clean, Buffer_createUninitializedBytes(chunkSize + sizeof(CryptoChunk), alloc, &loadCache, e_rr));
 
 	StreamRef *prevStream = NULL;
 
-	for (U64 i = 0; i < entryCount; ++i) {
+	for (U64 i = 0; i < entryCount && !isCompressed; ++i) {
 
 		U64 siz = DLFile_entrySize(dlFile, i);
 		Bool isFullyLoaded = DLFile_isFullyLoaded(dlFile, i);
@@ -347,10 +467,11 @@ Bool DLFile_write(
 
 	if (isEncrypted) {
 		EncryptionStream *es = RefPtr_data(encryptionStream, EncryptionStream);
-		*startOffset = es->startOffset + totalSize;
+		*startOffset = es->startOffset + storedSize;
 	}
 
 clean:
+	ListU8_free(&compressed, alloc);
 	RefPtr_dec(&encryptionStream);
 	Buffer_free(&loadCache, alloc);
 	Buffer_free(&tmp, alloc);
@@ -675,3 +675,171 @@ void Test_DLStress(Test *t) {
 		DLFile_free(&f2, t->alloc);
 	}
 }
+
+//Entries of 0 - 300KiB, so some are loaded and others stay in the (compression) stream, spanning multiple blocks
+
+static Bool DLFile_testCompressedEntries(DLFile *f, Test *t) {
+
+	static const U64 sizes[] = { 0, 1, 100, 70000, 200000, 33, 300 * 1024, 5 };
+
+	for (U64 i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+
+		Buffer buf = Buffer_createNull();
+
+		if (sizes[i] && !Buffer_createUninitializedBytes(sizes[i], t->alloc, &buf, &t->err))
+			return false;
+
+		for (U64 j = 0; j < sizes[i]; ++j)
+			buf.ptrNonConst[j] = (U8)((j / 7) * 3 + i);
+
+		const Bool ok = DLFile_addEntry(f, &buf, t->alloc, &t->err);
+		Buffer_free(&buf, t->alloc);
+
+		if (!ok)
+			return false;
+	}
+
+	return true;
+}
+
+static Bool DLFile_testCompressedEqual(const DLFile *a, const DLFile *b, Test *t) {
+
+	if (DLFile_entryCount(a) != DLFile_entryCount(b))
+		return false;
+
+	for (U64 i = 0; i < DLFile_entryCount(a); ++i) {
+
+		if (!DLFile_isFullyLoaded(b, i) && !DLFile_loadEntry(b, i, t->alloc, &t->err))
+			return false;
+
+		Buffer bufA = Buffer_createNull(), bufB = Buffer_createNull();
+
+		if (
+			!DLFile_loadedBufferAtConst(a, i, &bufA, &t->err) ||
+			!DLFile_loadedBufferAtConst(b, i, &bufB, &t->err) ||
+			Buffer_neq(bufA, bufB)
+		)
+			return false;
+	}
+
+	return true;
+}
+
+void Test_DLRoundtripCompressed(Test *t) {
+
+	Test_setModule(t, "DLFile_roundtripCompressed");
+
+	const RefPtrType memStreamType = MemoryStream_makeType(t->alloc);
+	const RefPtrType encStreamType = EncryptionStream_makeType(t->alloc);
+
+	const U32 key[8] = {
+		0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210,
+		0x11223344, 0x55667788, 0x99AABBCC, 0xDDEEFF00
+	};
+
+	DLSettings s = (DLSettings) {
+		.compressionType = EXXCompressionType_LZ,
+		.encryptionType  = EXXEncryptionType_None,
+		.dataType        = EDLDataType_Data
+	};
+
+	for (U8 encrypted = 0; encrypted < 2; ++encrypted) {
+
+		DLFile f = { 0 }, f2 = { 0 }, f3 = { 0 }, f4 = { 0 };
+		MemoryStreamRef *ms = NULL, *ms2 = NULL;
+		const RefPtrType *encType = encrypted ? &encStreamType : NULL;
+		const U32 *readKey = encrypted ? key : NULL;
+
+		if (encrypted) {
+			s.encryptionType = EXXEncryptionType_AES256GCM;
+			Buffer_memcpy(Buffer_createRef(s.encryptionKey, sizeof(key)), Buffer_createRefConst(key, sizeof(key)));
+		}
+
+		if (
+			!DLFile_create(&s, 0, t->alloc, &f, &t->err) ||
+			!DLFile_testCompressedEntries(&f, t) ||
+			!MemoryStream_create(0, EMemoryStreamFlags_WriteResize, &memStreamType, &ms, &t->err)
+		) {
+			Test_assert(t, "Compressed: setup", false);
+			goto clean;
+		}
+
+		U64 sizeOnly = 0, off = 0;
+
+		if (
+			!Test_assert(t, "Compressed: size", DLFile_write(&f, t->alloc, NULL, encType, I32x4_zero(), &sizeOnly, &t->err)) ||
+			!Test_assert(t, "Compressed: write", DLFile_write(&f, t->alloc, ms, encType, I32x4_zero(), &off, &t->err))
+		)
+			goto clean;
+
+		Test_assert(t, "Compressed: size consistency", sizeOnly == off);
+		Test_assert(t, "Compressed: smaller", off < 600 * 1024 / 4);
+
+		U64 readOff = 0;
+
+		if (!Test_assert(
+			t, "Compressed: read",
+			DLFile_read(ms, &readOff, readKey, I32x4_zero(), false, false, t->alloc, encType, &f2, &t->err)
+		))
+			goto clean;
+
+		Test_assert(t, "Compressed: read all", readOff == off);
+		Test_assert(t, "Compressed: compressionType", f2.settings.compressionType == EXXCompressionType_LZ);
+		Test_assert(t, "Compressed: big entries stay in stream", !DLFile_isFullyLoaded(&f2, 4));
+
+		//Writing entries that are still in a compression stream has to decompress them while compressing again
+
+		readOff = 0;
+
+		if (
+			!Test_assert(
+				t, "Compressed: read streams",
+				DLFile_read(ms, &readOff, readKey, I32x4_zero(), false, true, t->alloc, encType, &f3, &t->err)
+			) ||
+			!MemoryStream_create(0, EMemoryStreamFlags_WriteResize, &memStreamType, &ms2, &t->err)
+		)
+			goto clean;
+
+		off = 0;
+		readOff = 0;
+
+		Test_assert(
+			t, "Compressed: rewrite streams",
+			DLFile_write(&f3, t->alloc, ms2, encType, I32x4_zero(), &off, &t->err) &&
+			DLFile_read(ms2, &readOff, readKey, I32x4_zero(), false, false, t->alloc, encType, &f4, &t->err)
+		);
+
+		Test_assert(t, "Compressed: content", DLFile_testCompressedEqual(&f, &f2, t));
+		Test_assert(t, "Compressed: rewritten content", DLFile_testCompressedEqual(&f, &f4, t));
+
+		//Corrupt data in the last block fails its checksum once that entry is loaded (encryption would fail its tag first)
+
+		if (!encrypted) {
+
+			OxStream *stream = RefPtr_data(ms, OxStream);
+			U8 byte = 0;
+			const U64 corrupt = stream->size - 1000;
+
+			DLFile_free(&f2, t->alloc);
+			readOff = 0;
+
+			Test_assert(
+				t, "Compressed: corrupt fails",
+				stream->read(stream, corrupt, 1, Buffer_createRef(&byte, 1), t->alloc, &t->err) &&
+				(byte ^= 0x10, stream->write(stream, corrupt, 1, Buffer_createRefConst(&byte, 1), t->alloc, &t->err)) &&
+				(
+					!DLFile_read(ms, &readOff, readKey, I32x4_zero(), false, false, t->alloc, encType, &f2, NULL) ||
+					!DLFile_testCompressedEqual(&f, &f2, t)
+				)
+			);
+		}
+
+	clean:
+		RefPtr_dec(&ms);
+		RefPtr_dec(&ms2);
+		DLFile_free(&f,  t->alloc);
+		DLFile_free(&f2, t->alloc);
+		DLFile_free(&f3, t->alloc);
+		DLFile_free(&f4, t->alloc);
+	}
+}
@@ -42,6 +42,7 @@ OXC3_TEST_MAIN(formats_oiDL) {
 	Test_DLCreateFromList(&t);
 	Test_DLRoundtripPlain(&t);
 	Test_DLRoundtripEncrypted(&t);
+	Test_DLRoundtripCompressed(&t);
 	Test_DLCombine(&t);
 	Test_DLFindLoadedString(&t);
 	Test_DLStreams(&t);
@@ -34,6 +34,7 @@ void Test_DLLoadedAt(Test *t);
 void Test_DLCreateFromList(Test *t);
 void Test_DLRoundtripPlain(Test *t);
 void Test_DLRoundtripEncrypted(Test *t);
+void Test_DLRoundtripCompressed(Test *t);
 void Test_DLCombine(Test *t);
 void Test_DLFindLoadedString(Test *t);
 void Test_DLStreams(Test *t);
@@ -58,8 +58,7 @@ Bool CommandListRef_clear(CommandListRef *commandListRef, Error *e_rr) {
 
 	CommandListRef_validate(commandListRef);
 
-	for (U64 i = 0; i < commandList->resources.length; ++i)
-		RefPtr_dec(&commandList->resources.ptrNonConst[i]);
+	RefPtr_decMany(commandList->resources.ptrNonConst, commandList->resources.length);
 
 	gotoIfError3(clean, ListCommandOpInfo_clear(&commandList->commandOps, e_rr));
 	gotoIfError3(clean, ListRefPtr_clear(&commandList->resources, e_rr));
@@ -861,8 +860,7 @@ void CommandList_free(void *cmdGeneric, const Allocator *alloc) {
 
 	SpinLock_lock(&cmd->lock, U64_MAX);
 
-	for (U64 i = 0; i < cmd->resources.length; ++i)
-		RefPtr_dec(cmd->resources.ptrNonConst + i);
+	RefPtr_decMany(cmd->resources.ptrNonConst, cmd->resources.length);
 
 	ListCommandOpInfo_free(&cmd->commandOps, alloc);
 	ListRefPtr_free(&cmd->resources, alloc);
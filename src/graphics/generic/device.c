@@ -43,6 +43,7 @@
 #include "platforms/file.h"
 #include "platforms/platform.h"
 #include "types/container/ref_ptr.h"
+#include "types/container/trace.h"
 #include "types/base/string_read.h"
 #include "formats/oiSH/sh_file.h"
 #include "types/base/string_read_helper.h"
@@ -69,13 +70,21 @@ void GraphicsDevice_free(void *deviceGeneric, const Allocator *alloc) {
 	if(!device)
 		return;
 
+	//Pipelines, tables, buffers and textures only retire on their last RefPtr_dec (ERefPtrFlags_DeferRelease).
+	//They're collected from the device's own domain before whatever they depend on goes and before the ext is gone,
+	// since the internal ones don't keep the device alive.
+
 	for(U64 i = 0; i < 2; ++i)
 		RefPtr_dec(&device->copyShaders[i]);
 
+	RefPtr_collectDomain(&device->retireDomain);
+
 	RefPtr_dec(&device->copyPipelineLayout);        //Even though it's 'ref counted' it's internal so destruction order matters
 	RefPtr_dec(&device->copyDescLayout);
 	RefPtr_dec(&device->copyDescPushDesc);
 	RefPtr_dec(&device->defaultDescriptorTable);
+	RefPtr_collectDomain(&device->retireDomain);
+
 	RefPtr_dec(&device->defaultPipelineLayout);
 	RefPtr_dec(&device->defaultDescLayout);
 	RefPtr_dec(&device->defaultCBufferLayout);
@@ -109,6 +118,8 @@ void GraphicsDevice_free(void *deviceGeneric, const Allocator *alloc) {
 		AllocationBuffer_free(&device->stagingReadbackAllocations[j], alloc);
 	}
 
+	RefPtr_collectDomain(&device->retireDomain);
+
 	SpinLock_lock(&device->lock, U64_MAX);
 	SpinLock_lock(&device->allocator.lock, U64_MAX);
 	ListWeakRefPtr_free(&device->pendingResources, alloc);
@@ -159,6 +170,7 @@ void GraphicsDevice_free(void *deviceGeneric, const Allocator *alloc) {
 		ListRefPtr_free(&device->resourcesInFlight[i], alloc);
 	}
 
+	RefPtrRetireDomain_free(&device->retireDomain);
 	RefPtr_dec(&device->instance);
 }
 
@@ -661,6 +673,7 @@ Bool GraphicsDeviceRef_create(
 	allocated = true;
 
 	GraphicsDevice *device = GraphicsDeviceRef_ptr(*deviceRef);
+	RefPtrRetireDomain_create(&device->retireDomain);
 
 	gotoIfError3(clean, ListWeakRefPtr_reserve(&device->pendingResources, 128, alloc, e_rr));
 
@@ -1329,11 +1342,14 @@ Bool GraphicsDeviceRef_handleNextFrame(GraphicsDeviceRef *deviceRef, void *comma
 	//For example temporary staging resources are released this way.
 
 	ListRefPtr *inFlight = &device->resourcesInFlight[device->fifId];
+	RefPtr_decMany(inFlight->ptrNonConst, inFlight->length);
+	gotoIfError3(clean, ListRefPtr_clear(inFlight, e_rr));
 
-	for (U64 i = 0; i < inFlight->length; ++i)
-		RefPtr_dec(inFlight->ptrNonConst + i);
+	//The GPU is done with this frame, so this is the safe point to free everything that was released with
+	// ERefPtrFlags_DeferRelease since (by any thread, in flight or not).
+	//Only this device's resources are collected, the ones of other devices wait for their own next frame.
 
-	gotoIfError3(clean, ListRefPtr_clear(inFlight, e_rr));
+	RefPtr_collectDomain(&device->retireDomain);
 
 	//Release all allocations of buffer that was in flight
 
@@ -1349,6 +1365,9 @@ Bool GraphicsDeviceRef_handleNextFrame(GraphicsDeviceRef *deviceRef, void *comma
 
 		RefPtr *pending = device->pendingResources.ptr[i];
 
+		if(RefPtr_isRetired(pending))        //Dropped on a different thread since the collect, nothing to flush
+			continue;
+
 		EGraphicsTypeId type = (EGraphicsTypeId) pending->refPtrType->typeId;
 
 		switch(type) {
@@ -1871,6 +1890,8 @@ Bool GraphicsDeviceRef_submitCommands(
 	GraphicsDevice *device = NULL;
 	SpinLock *lockPtr = NULL;
 
+	Trace_zoneBegin("Graphics", "submitCommands");
+
 	//Validation
 
 	if(!deviceRef || deviceRef->refPtrType->typeId != (TypeId) EGraphicsTypeId_GraphicsDevice)
@@ -1999,6 +2020,9 @@ Bool GraphicsDeviceRef_submitCommands(
 
 		WeakRefPtr *res = device->pendingResources.ptr[i];
 
+		if(RefPtr_isRetired(res))        //Waiting for RefPtr_collect, it can't be used by the command lists anymore
+			continue;
+
 		EGraphicsTypeId id = (EGraphicsTypeId) res->refPtrType->typeId;
 
 		switch (id) {
@@ -2061,7 +2085,14 @@ Bool GraphicsDeviceRef_submitCommands(
 	//Submit impl should also set the swapchains and process all command lists and swapchains.
 	//This is not present here because the API impl is the one in charge of how it is threaded.
 
-	gotoIfError3(clean, GraphicsDevice_submitCommandsExt(deviceRef, commandLists, swapchains, &data, e_rr));
+	Trace_counter("Graphics", "pendingBytes", device->pendingBytes);
+	Trace_zoneBegin("Graphics", "submitCommandsExt");
+
+	const Bool submitted = GraphicsDevice_submitCommandsExt(deviceRef, commandLists, swapchains, &data, e_rr);
+
+	Trace_zoneEnd("Graphics", "submitCommandsExt");
+
+	gotoIfError3(clean, submitted);
 
 	//Add resources from command lists to resources in flight
 
@@ -2106,6 +2137,7 @@ clean:
 		ListSpinLockPtr_clear(&device->currentLocks, e_rr);
 	}
 
+	Trace_zoneEnd("Graphics", "submitCommands");
 	return s_uccess;
 }
 
@@ -2158,10 +2190,7 @@ Bool GraphicsDeviceRef_wait(GraphicsDeviceRef *deviceRef, Error *e_rr) {
 		//For example temporary staging resources are released this way.
 
 		ListRefPtr *inFlight = &device->resourcesInFlight[i];
-
-		for (U64 j = 0; j < inFlight->length; ++j)
-			RefPtr_dec(inFlight->ptrNonConst + j);
-
+		RefPtr_decMany(inFlight->ptrNonConst, inFlight->length);
 		gotoIfError3(clean, ListRefPtr_clear(inFlight, e_rr));
 
 		//Release all allocations of buffer that was in flight
@@ -2173,6 +2202,8 @@ Bool GraphicsDeviceRef_wait(GraphicsDeviceRef *deviceRef, Error *e_rr) {
 		GraphicsDevice_completePulls(device, i);
 	}
 
+	RefPtr_collectDomain(&device->retireDomain);        //Idle device, so like handleNextFrame it's safe to free it
+
 clean:
 
 	if(acq == ELockAcquire_Acquired)
@@ -43,6 +43,8 @@
 #include "types/container/ref_ptr.h"
 #include "types/base/error.h"
 
+#include <stddef.h>
+
 TListImpl(GraphicsDeviceInfo);
 
 //Lives in device_info.c but isn't API: it fills in the capability bits neither backend can report.
@@ -252,9 +254,41 @@ void DescriptorHeap_free(void *heap, const Allocator *alloc);
 void PipelineLayout_free(void *layout, const Allocator *alloc);
 void CommandList_free(void *cmd, const Allocator *alloc);
 
+//Deferred resources retire into the domain of their own device, so a device collecting at its next frame doesn't
+// free what another device retired. One that failed before it knew its device goes to the process-wide domain.
+//GraphicsResource (buffers, render textures and depth stencils), Pipeline, Sampler and RTAS start with the device.
+
+static RefPtrRetireDomain *GraphicsDevice_retireDomainOf(GraphicsDeviceRef *device) {
+	return device ? &GraphicsDeviceRef_ptr(device)->retireDomain : NULL;
+}
+
+static RefPtrRetireDomain *GraphicsObject_retireDomain(void *ptr) {
+	return GraphicsDevice_retireDomainOf(*(GraphicsDeviceRef**) ptr);
+}
+
+static RefPtrRetireDomain *DeviceTexture_retireDomain(void *ptr) {
+	return GraphicsDevice_retireDomainOf(((DeviceTexture*) ptr)->base.resource.device);
+}
+
+static RefPtrRetireDomain *DescriptorTable_retireDomain(void *ptr) {
+	DescriptorHeapRef *parent = ((DescriptorTable*) ptr)->parent;
+	return !parent ? NULL : GraphicsDevice_retireDomainOf(DescriptorHeapRef_ptr(parent)->device);
+}
+
+static_assert(
+	!offsetof(GraphicsResource, device) && !offsetof(Pipeline, device) && !offsetof(Sampler, device) &&
+	!offsetof(RTAS, device) && !offsetof(BLAS, base) && !offsetof(TLAS, base) && !offsetof(OpacityMicromap, base) &&
+	!offsetof(DeviceBuffer, resource) && !offsetof(UnifiedTexture, resource),
+	"GraphicsObject_retireDomain reads the device from the start of the object"
+);
+
 //Fills the RefPtrTypes of all objects that can be created through this instance (or its devices).
 //They live in the GraphicsInstance so they're guaranteed to outlive the objects created with them,
 // since every graphics object holds a reference to the device and the device to the instance.
+//Resources are released with ERefPtrFlags_DeferRelease, so dropping one (possibly while it's in flight) never
+// frees on the spot; their device collects them at its next frame.
+//The device, swapchains (a resize recreates one right away), command lists and layouts and heaps (freed in a
+// fixed order by the device) are still freed immediately.
 
 static GraphicsObjectTypes GraphicsInstance_makeObjectTypes(EGraphicsApi api, const Allocator *alloc) {
 
@@ -281,7 +315,9 @@ static GraphicsObjectTypes GraphicsInstance_makeObjectTypes(EGraphicsApi api, co
 			.typeId = (TypeId) EGraphicsTypeId_DeviceBuffer,
 			.lengthAndAlignment = OXC3_APPENDED_LEN(DeviceBuffer, sizes->buffer),
 			.alloc = alloc,
-			.free = DeviceBuffer_free
+			.free = DeviceBuffer_free,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.deviceTexture = (RefPtrType) {
@@ -290,7 +326,9 @@ static GraphicsObjectTypes GraphicsInstance_makeObjectTypes(EGraphicsApi api, co
 				sizeof(DeviceTexture) + imageSize, U64_max(alignof(DeviceTexture), imageAlignment)
 			),
 			.alloc = alloc,
-			.free = DeviceTexture_free
+			.free = DeviceTexture_free,
+			.retireDomain = DeviceTexture_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.renderTexture = (RefPtrType) {
@@ -299,7 +337,9 @@ static GraphicsObjectTypes GraphicsInstance_makeObjectTypes(EGraphicsApi api, co
 				sizeof(RenderTexture) + imageSize, U64_max(alignof(RenderTexture), imageAlignment)
 			),
 			.alloc = alloc,
-			.free = GraphicsDevice_freeRenderTexture
+			.free = GraphicsDevice_freeRenderTexture,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.depthStencil = (RefPtrType) {
@@ -308,7 +348,9 @@ static GraphicsObjectTypes GraphicsInstance_makeObjectTypes(EGraphicsApi api, co
 				sizeof(DepthStencil) + imageSize, U64_max(alignof(DepthStencil), imageAlignment)
 			),
 			.alloc = alloc,
-			.free = GraphicsDevice_freeDepthStencil
+			.free = GraphicsDevice_freeDepthStencil,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.swapchain = (RefPtrType) {
@@ -344,7 +386,9 @@ static GraphicsObjectTypes GraphicsInstance_makeObjectTypes(EGraphicsApi api, co
 			.typeId = (TypeId) EGraphicsTypeId_Pipeline,
 			.lengthAndAlignment = OXC3_APPENDED_LEN(Pipeline, sizes->pipeline),
 			.alloc = alloc,
-			.free = Pipeline_free
+			.free = Pipeline_free,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.pipelineGraphics = (RefPtrType) {
@@ -357,7 +401,9 @@ static GraphicsObjectTypes GraphicsInstance_makeObjectTypes(EGraphicsApi api, co
 				)
 			),
 			.alloc = alloc,
-			.free = Pipeline_free
+			.free = Pipeline_free,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.pipelineRaytracing = (RefPtrType) {
@@ -370,35 +416,45 @@ static GraphicsObjectTypes GraphicsInstance_makeObjectTypes(EGraphicsApi api, co
 				)
 			),
 			.alloc = alloc,
-			.free = Pipeline_free
+			.free = Pipeline_free,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.sampler = (RefPtrType) {
 			.typeId = (TypeId) EGraphicsTypeId_Sampler,
 			.lengthAndAlignment = OXC3_APPENDED_LEN(Sampler, sizes->sampler),
 			.alloc = alloc,
-			.free = Sampler_free
+			.free = Sampler_free,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.blas = (RefPtrType) {
 			.typeId = (TypeId) EGraphicsTypeId_BLASExt,
 			.lengthAndAlignment = OXC3_APPENDED_LEN(BLAS, sizes->blas),
 			.alloc = alloc,
-			.free = BLAS_free
+			.free = BLAS_free,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.tlas = (RefPtrType) {
 			.typeId = (TypeId) EGraphicsTypeId_TLASExt,
 			.lengthAndAlignment = OXC3_APPENDED_LEN(TLAS, sizes->tlas),
 			.alloc = alloc,
-			.free = TLAS_free
+			.free = TLAS_free,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.opacityMicromap = (RefPtrType) {
 			.typeId = (TypeId) EGraphicsTypeId_OpacityMicromapExt,
 			.lengthAndAlignment = OXC3_APPENDED_LEN(OpacityMicromap, sizes->opacityMicromap),
 			.alloc = alloc,
-			.free = OpacityMicromap_free
+			.free = OpacityMicromap_free,
+			.retireDomain = GraphicsObject_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.descriptorLayout = (RefPtrType) {
@@ -412,7 +468,9 @@ static GraphicsObjectTypes GraphicsInstance_makeObjectTypes(EGraphicsApi api, co
 			.typeId = (TypeId) EGraphicsTypeId_DescriptorTable,
 			.lengthAndAlignment = OXC3_APPENDED_LEN(DescriptorTable, sizes->descriptorTable),
 			.alloc = alloc,
-			.free = DescriptorTable_free
+			.free = DescriptorTable_free,
+			.retireDomain = DescriptorTable_retireDomain,
+			.flags = ERefPtrFlags_DeferRelease
 		},
 
 		.descriptorHeap = (RefPtrType) {
@@ -26,6 +26,7 @@
 #include "types/base/error.h"
 #include "types/base/allocator.h"
 #include "types/base/constants.h"
+#include "types/base/mathi.h"
 
 static Bool FileStream_read(
 	OxStream *stream,
@@ -142,3 +143,132 @@ Bool FileHandle_openStream(
 clean:
 	return s_uccess;
 }
+
+//Mapped file streams
+
+impl Bool FileHandle_mapPhysical(FileHandle *handle, EFileMapHint hint, const U8 **mapped, Error *e_rr);
+impl void FileHandle_unmapPhysical(const U8 *mapped, U64 length);
+
+static Bool FileStream_readMapped(
+	OxStream *stream,
+	U64 offset,
+	U64 length,
+	Buffer buf,
+	const Allocator *alloc,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+
+	if(!stream)
+		retError(clean, Error_nullPointer(0, "FileStream_readMapped()::stream is required"));
+
+	(void) alloc;
+
+	if(!length)
+		length = stream->size - U64_min(offset, stream->size);
+
+	if(offset + length > stream->size)
+		retError(clean, Error_outOfBounds(1, offset + length, stream->size, "FileStream_readMapped() out of bounds"));
+
+	if(length > Buffer_length(buf))
+		retError(clean, Error_outOfBounds(3, length, Buffer_length(buf), "FileStream_readMapped() buffer too small"));
+
+	if(length)
+		Buffer_memcpy(buf, Buffer_createRefConst(stream->mapped + offset, length));
+
+clean:
+	return s_uccess;
+}
+
+static void FileStream_closeMapped(OxStream *stream, const Allocator *alloc) {
+
+	if(stream->mapped)
+		FileHandle_unmapPhysical(stream->mapped, stream->size);
+
+	stream->mapped = NULL;
+	FileStream_close(stream, alloc);
+}
+
+Bool File_openMappedStream(
+	const CharString *loc,
+	Ns timeout,
+	EFileMapHint hint,
+	const RefPtrType *fileHandleType,
+	const RefPtrType *streamType,
+	StreamRef **stream,
+	Error *e_rr
+) {
+	Bool s_uccess = true;
+	FileHandleRef *handle = NULL;
+
+	gotoIfError3(clean, File_open(loc, timeout, EFileOpenType_Read, false, fileHandleType, &handle, e_rr));
+	gotoIfError3(clean, FileHandle_openMappedStream(&handle, hint, streamType, stream, e_rr));
+
+clean:
+	RefPtr_dec(&handle);
+	return s_uccess;
+}
+
+Bool FileHandle_openMappedStream(
+	FileHandleRef **handle,
+	EFileMapHint hint,
+	const RefPtrType *streamType,
+	StreamRef **stream,
+	Error *e_rr
+) {
+	Bool s_uccess = true;
+	const U8 *mapped = NULL;
+
+	if(!handle || !*handle)
+		retError(clean, Error_nullPointer(0, "FileHandle_openMappedStream()::handle is required"));
+
+	if(!stream)
+		retError(clean, Error_nullPointer(3, "FileHandle_openMappedStream()::stream is required"));
+
+	if(*stream)
+		retError(clean, Error_invalidOperation(
+			0, "FileHandle_openMappedStream()::stream already defined, might be a memleak"
+		));
+
+	if(hint > EFileMapHint_Random)
+		retError(clean, Error_invalidEnum(
+			1, (U64)hint, (U64)EFileMapHint_Random, "FileHandle_openMappedStream()::hint is invalid"
+		));
+
+	FileHandle *fh = RefPtr_data(*handle, FileHandle);
+
+	if(FileHandle_fileType(fh) != EFileOpenType_Read)
+		retError(clean, Error_invalidOperation(1, "FileHandle_openMappedStream()::handle has to be readonly"));
+
+	U64 fileSize = FileHandle_fileSize(fh);
+
+	if(fileSize)        //Empty files can't be mapped, but there's nothing to read from them either
+		gotoIfError3(clean, FileHandle_mapPhysical(fh, hint, &mapped, e_rr));
+
+	gotoIfError3(clean, Stream_create(
+		FileStream_readMapped,
+		NULL,                        //write
+		NULL,                        //reserve
+		FileStream_closeMapped,
+		fileSize,
+		EStreamType_File | EStreamType_Mapped,
+		streamType,
+		stream,
+		e_rr
+	));
+
+	//Transfer handle and mapping ownership into the FileStream, caller's ref becomes NULL
+	FileStream *fs = RefPtr_data(*stream, FileStream);
+	fs->parent.mapped = mapped;
+	fs->handle = *handle;
+	*handle = NULL;
+	mapped = NULL;
+
+clean:
+
+	if(mapped)
+		FileHandle_unmapPhysical(mapped, FileHandle_fileSize(RefPtr_data(*handle, FileHandle)));
+
+	return s_uccess;
+}
@@ -21,6 +21,8 @@
 //platforms/generic/platform.c
 
 #include "types/container/list_impl.h"
+#include "types/container/hash_map.h"
+#include "types/container/ref_ptr.h"
 #include "platforms/platform.h"
 #include "platforms/logx.h"
 #include "formats/oiCA/ca_file.h"
@@ -69,16 +71,119 @@ AtomicI64 Allocator_memoryAllocationSize = { 0 };
 
 typedef struct DebugAllocation {
 	U64 location, length;
+	U64 id;                                            //Allocation order, so printing can still show the oldest first
 	StackTrace stack;
 } DebugAllocation;
 
 TList(DebugAllocation);
 TListImpl(DebugAllocation);
 
+THashMapNamed(U64, DebugAllocation, DebugAllocationMap);
+
+//Allocations are spread over shards by address, each with its own lock and map (location -> DebugAllocation).
+//A free is a hash lookup in one shard rather than a scan of every live allocation under one global lock,
+// and threads working on unrelated memory almost never end up waiting on the same shard.
+
+#define Allocator_shardBits 6
+#define Allocator_shardCount (1 << Allocator_shardBits)
+
+typedef struct DebugAllocationShard {
+	SpinLock lock;                                    //Own cache line (alignas(64)), so shards don't false share
+	DebugAllocationMap allocations;
+} DebugAllocationShard;
+
 Allocator Allocator_allocationsAllocator;
 Allocator Allocator_trackedAllocator;
-ListDebugAllocation Allocator_allocations;            //TODO: Use hashmap here!
-SpinLock Allocator_lock;                            //Multi threading safety
+DebugAllocationShard Allocator_shards[Allocator_shardCount];
+AtomicI64 Allocator_nextAllocationId;
+
+//Allocations are at least 16-byte aligned, so the low bits are dropped and the rest is multiplied to spread it out.
+
+static DebugAllocationShard *Allocator_shardOf(U64 location) {
+	return &Allocator_shards[((location >> 4) * 0x9E3779B97F4A7C15) >> (64 - Allocator_shardBits)];
+}
+
+static ECompareResult DebugAllocation_compareId(const void *a, const void *b, void *context) {
+	(void) context;
+	const U64 idA = ((const DebugAllocation*) a)->id, idB = ((const DebugAllocation*) b)->id;
+	return idA < idB ? ECompareResult_Lt : (idA > idB ? ECompareResult_Gt : ECompareResult_Eq);
+}
+
+//Copies every tracked allocation (in allocation order) into result.
+//Shards are locked one at a time, so this isn't an atomic snapshot if other threads keep allocating.
+
+static Bool Allocator_snapshotAllocations(ListDebugAllocation *result, Error *e_rr) {
+
+	Bool s_uccess = true;
+	DebugAllocationShard *shard = NULL;
+	ELockAcquire acq = ELockAcquire_Invalid;
+
+	for (U64 i = 0; i < Allocator_shardCount; ++i) {
+
+		shard = &Allocator_shards[i];
+		acq = SpinLock_lock(&shard->lock, U64_MAX);
+
+		if(acq < ELockAcquire_Success)
+			retError(clean, Error_invalidState(0, "Allocator_snapshotAllocations() allocator lock failed to acquire"));
+
+		const DebugAllocationMap *map = &shard->allocations;
+
+		gotoIfError3(clean, ListDebugAllocation_reserve(
+			result, result->length + DebugAllocationMap_length(*map), &Allocator_allocationsAllocator, e_rr
+		));
+
+		for(U64 j = DebugAllocationMap_next(map, 0); j != U64_MAX; j = DebugAllocationMap_next(map, j + 1))
+			gotoIfError3(clean, ListDebugAllocation_pushBack(
+				result, *DebugAllocationMap_valueAt(map, j), &Allocator_allocationsAllocator, e_rr
+			));
+
+		if(acq == ELockAcquire_Acquired)
+			SpinLock_unlock(&shard->lock);
+
+		acq = ELockAcquire_Invalid;
+	}
+
+	ListDebugAllocation_sortCustom(*result, DebugAllocation_compareId, NULL);
+
+clean:
+
+	if(acq == ELockAcquire_Acquired)
+		SpinLock_unlock(&shard->lock);
+
+	return s_uccess;
+}
+
+//Only called when a free didn't match any allocation, so it can afford to walk every shard.
+//Freeing an address inside of a live allocation is likely an accident, so name the allocation it hit.
+
+static void Allocator_logOverlappingFree(void *ptr, U64 len) {
+
+	for (U64 i = 0; i < Allocator_shardCount; ++i) {
+
+		DebugAllocationShard *shard = &Allocator_shards[i];
+		const ELockAcquire acq = SpinLock_lock(&shard->lock, U64_MAX);
+
+		if(acq < ELockAcquire_Success)
+			continue;
+
+		const DebugAllocationMap *map = &shard->allocations;
+
+		for (U64 j = DebugAllocationMap_next(map, 0); j != U64_MAX; j = DebugAllocationMap_next(map, j + 1)) {
+
+			const DebugAllocation *captured = DebugAllocationMap_valueAt(map, j);
+
+			if ((U64)ptr >= captured->location && (U64)ptr < captured->location + captured->length)
+				Log_errorLn(
+					&Allocator_allocationsAllocator,
+					"Allocation at %p with length %"PRIu64" collides with free at %p with length %"PRIu64" this is invalid!",
+					(void*) captured->location, captured->length, ptr, len
+				);
+		}
+
+		if(acq == ELockAcquire_Acquired)
+			SpinLock_unlock(&shard->lock);
+	}
+}
 
 //Allocation
 
@@ -144,7 +249,8 @@ Bool Platform_onAllocate(void *ptr, U64 length, Error *e_rr) {
 
 	Bool s_uccess = true;
 	ELockAcquire acq = ELockAcquire_Invalid;
-	(void)ptr; (void) e_rr;
+	DebugAllocationShard *shard = NULL;
+	(void)ptr; (void) e_rr; (void) shard;
 
 	AtomicI64_add(&Allocator_memoryAllocationCount, 1);
 	AtomicI64_add(&Allocator_memoryAllocationSize, length);
@@ -154,16 +260,18 @@ Bool Platform_onAllocate(void *ptr, U64 length, Error *e_rr) {
 		DebugAllocation captured = (DebugAllocation) { 0 };
 		captured.location = (U64) ptr;
 		captured.length = length;
+		captured.id = (U64) AtomicI64_inc(&Allocator_nextAllocationId);
 
 		Error_captureStackTrace(captured.stack, STACKTRACE_SIZE, 1);
 
-		acq = SpinLock_lock(&Allocator_lock, U64_MAX);
+		shard = Allocator_shardOf(captured.location);
+		acq = SpinLock_lock(&shard->lock, U64_MAX);
 
 		if(acq < ELockAcquire_Success)        //Should never happen
 			retError(clean, Error_invalidState(0, "Platform_onAllocate() allocator lock failed to acquire"));
 
-		gotoIfError3(clean, ListDebugAllocation_pushBack(
-			&Allocator_allocations, captured, &Allocator_allocationsAllocator, e_rr
+		gotoIfError3(clean, DebugAllocationMap_insert(
+			&shard->allocations, captured.location, captured, &Allocator_allocationsAllocator, e_rr
 		));
 
 	#endif
@@ -173,7 +281,7 @@ Bool Platform_onAllocate(void *ptr, U64 length, Error *e_rr) {
 clean:
 
 	if(acq == ELockAcquire_Acquired)
-		SpinLock_unlock(&Allocator_lock);
+		SpinLock_unlock(&shard->lock);
 
 	return s_uccess;
 }
@@ -186,54 +294,32 @@ Bool Platform_onFree(void *ptr, U64 len) {
 	//If not, warn here and return false
 
 	ELockAcquire acq = ELockAcquire_Invalid;
+	DebugAllocationShard *shard = NULL;
 	Error *e_rr = NULL;
 	Bool s_uccess = true;
 
-	(void)e_rr;
+	(void)e_rr; (void) shard;
 
 	#ifndef NDEBUG
 
-		acq = SpinLock_lock(&Allocator_lock, U64_MAX);
+		shard = Allocator_shardOf((U64)ptr);
+		acq = SpinLock_lock(&shard->lock, U64_MAX);
 
 		if(acq < ELockAcquire_Success) {
-			Log_errorLn(&Allocator_allocationsAllocator, "Platform_onFree Allocator_lock failed");
+			Log_errorLn(&Allocator_allocationsAllocator, "Platform_onFree allocator shard lock failed");
 			retError(clean, Error_invalidState(0, "Platform_onFree() allocator lock failed to acquire"));
 		}
 
-		U64 i = 0;
-
-		for (; i < Allocator_allocations.length; ++i) {
-
-			const DebugAllocation *captured = &Allocator_allocations.ptrNonConst[i];
-
-			if (captured->location == (U64)ptr) {
-
-				if(len != captured->length) {
+		const DebugAllocation *captured = DebugAllocationMap_find(&shard->allocations, (U64)ptr);
 
-					Log_errorLn(
-						&Allocator_allocationsAllocator,
-						"Allocation at %p was allocated with length %"PRIu64" but freed with length %"PRIu64"!",
-						ptr, captured->length, len
-					);
+		if(!captured) {
 
-					break;        //Still erase it, but reluctantly
-				}
-
-				break;
+			if (acq == ELockAcquire_Acquired) {
+				SpinLock_unlock(&shard->lock);
+				acq = ELockAcquire_Invalid;
 			}
 
-			//Overlapping range, but likely by accident!
-			//Log it, but refuse to track it.
-
-			else if ((U64)ptr >= captured->location && (U64)ptr < captured->location + captured->length)
-				Log_errorLn(
-					&Allocator_allocationsAllocator,
-					"Allocation at %p with length %"PRIu64" collides with free at %p with length %"PRIu64" this is invalid!",
-					captured->location, captured->length, ptr, len
-				);
-		}
-
-		if(i == Allocator_allocations.length) {
+			Allocator_logOverlappingFree(ptr, len);
 
 			Log_errorLn(
 				&Allocator_allocationsAllocator,
@@ -245,10 +331,17 @@ Bool Platform_onFree(void *ptr, U64 len) {
 			goto clean;
 		}
 
-		ListDebugAllocation_erase(&Allocator_allocations, i, NULL);
+		if(len != captured->length)        //Still erase it, but reluctantly
+			Log_errorLn(
+				&Allocator_allocationsAllocator,
+				"Allocation at %p was allocated with length %"PRIu64" but freed with length %"PRIu64"!",
+				ptr, captured->length, len
+			);
+
+		DebugAllocationMap_erase(&shard->allocations, (U64)ptr);
 
 		if (acq == ELockAcquire_Acquired) {
-			SpinLock_unlock(&Allocator_lock);
+			SpinLock_unlock(&shard->lock);
 			acq = ELockAcquire_Invalid;
 		}
 
@@ -264,7 +357,7 @@ Bool Platform_onFree(void *ptr, U64 len) {
 clean:
 
 	if(acq == ELockAcquire_Acquired)
-		SpinLock_unlock(&Allocator_lock);
+		SpinLock_unlock(&shard->lock);
 
 	return s_uccess;
 }
@@ -273,22 +366,20 @@ void Platform_printAllocations(U64 offset, U64 length, U64 minAllocationSize) {
 
 	(void) offset; (void) length; (void) minAllocationSize;
 
-	ELockAcquire acq = ELockAcquire_Invalid;
-	Bool s_uccess = true;
-	Error *e_rr = NULL;
-	(void) s_uccess; (void)e_rr;
-
 	#ifndef NDEBUG
 
-		acq = SpinLock_lock(&Allocator_lock, U64_MAX);
+		Error err = Error_none();
+		ListDebugAllocation allocations = (ListDebugAllocation) { 0 };
 
-		if(acq < ELockAcquire_Success) {
-			Log_errorLn(&Allocator_allocationsAllocator, "Platform_printAllocations Allocator_lock failed");
-			retError(clean, Error_invalidState(0, "Platform_printAllocations() allocator lock failed to acquire"));
+		if (!Allocator_snapshotAllocations(&allocations, &err)) {
+			Log_errorLn(&Allocator_allocationsAllocator, "Platform_printAllocations couldn't snapshot allocations");
+			Error_print(&Allocator_allocationsAllocator, &err, ELogLevel_Error, ELogOptions_Default);
+			ListDebugAllocation_free(&allocations, &Allocator_allocationsAllocator);
+			return;
 		}
 
 		if(!length)
-			length = Allocator_allocations.length;
+			length = allocations.length;
 
 		Log_debugLn(
 			&Allocator_allocationsAllocator, "Showing up to %"PRIu64" allocations starting at offset %"PRIu64"", length, offset
@@ -296,9 +387,9 @@ void Platform_printAllocations(U64 offset, U64 length, U64 minAllocationSize) {
 
 		U64 capturedLength = 0;
 
-		for(U64 i = offset; i < offset + length && i < Allocator_allocations.length; ++i) {
+		for(U64 i = offset; i < offset + length && i < allocations.length; ++i) {
 
-			const DebugAllocation *captured = &Allocator_allocations.ptrNonConst[i];
+			const DebugAllocation *captured = &allocations.ptr[i];
 
 			if(captured->length < minAllocationSize)
 				continue;
@@ -306,7 +397,7 @@ void Platform_printAllocations(U64 offset, U64 length, U64 minAllocationSize) {
 			Log_debugLn(
 				&Allocator_allocationsAllocator,
 				"Allocation %"PRIu64" at %p with length %"PRIu64" allocated at:",
-				i, captured->location, captured->length
+				i, (void*) captured->location, captured->length
 			);
 
 			Log_printCapturedStackTrace(
@@ -318,52 +409,46 @@ void Platform_printAllocations(U64 offset, U64 length, U64 minAllocationSize) {
 
 		Log_debugLn(&Allocator_allocationsAllocator, "Showed %"PRIu64" bytes of allocations", capturedLength);
 
-	#endif
-
-	goto clean;
+		ListDebugAllocation_free(&allocations, &Allocator_allocationsAllocator);
 
-clean:
-	if(acq == ELockAcquire_Acquired)
-		SpinLock_unlock(&Allocator_lock);
+	#endif
 }
 
 U64 Platform_getActiveAllocations(U64 minAllocationSize) {
-	
+
 	(void)minAllocationSize;
 
 	U64 active = 0;
 
-	Bool s_uccess = true;
-	Error *e_rr = NULL;
-	(void) s_uccess; (void)e_rr;
+	#ifndef NDEBUG
 
-	ELockAcquire acq = SpinLock_lock(&Allocator_lock, U64_MAX);
+		for (U64 i = 0; i < Allocator_shardCount; ++i) {
 
-	if (acq < ELockAcquire_Success) {
-		Log_errorLn(&Allocator_allocationsAllocator, "Platform_getActiveAllocations Allocator_lock failed");
-		retError(clean, Error_invalidState(0, "Platform_getActiveAllocations() allocator lock failed to acquire"));
-	}
+			DebugAllocationShard *shard = &Allocator_shards[i];
+			const ELockAcquire acq = SpinLock_lock(&shard->lock, U64_MAX);
 
-	#ifndef NDEBUG
+			if (acq < ELockAcquire_Success) {
+				Log_errorLn(&Allocator_allocationsAllocator, "Platform_getActiveAllocations allocator shard lock failed");
+				continue;
+			}
 
-		for (U64 i = 0; i < Allocator_allocations.length; ++i) {
+			const DebugAllocationMap *map = &shard->allocations;
 
-			const DebugAllocation* captured = &Allocator_allocations.ptrNonConst[i];
+			if(!minAllocationSize)
+				active += DebugAllocationMap_length(*map);
 
-			if (captured->length < minAllocationSize)
-				continue;
+			else for(U64 j = DebugAllocationMap_next(map, 0); j != U64_MAX; j = DebugAllocationMap_next(map, j + 1))
+				if (DebugAllocationMap_valueAt(map, j)->length >= minAllocationSize)
+					++active;
 
-			++active;
+			if(acq == ELockAcquire_Acquired)
+				SpinLock_unlock(&shard->lock);
 		}
 
 	#else
 		active = AtomicI64_add(&Allocator_memoryAllocationCount, 0);
 	#endif
 
-clean:
-	if(acq == ELockAcquire_Acquired)
-		SpinLock_unlock(&Allocator_lock);
-
 	return active;
 }
 
@@ -430,7 +515,14 @@ Bool Platform_create(int cmdArgc, const C8 *cmdArgs[], void *data, void *allocat
 	};
 
 	#ifndef NDEBUG
-		gotoIfError3(clean, ListDebugAllocation_reserve(&Allocator_allocations, 256, &Allocator_allocationsAllocator, e_rr));
+
+		for(U64 i = 0; i < Allocator_shardCount; ++i)
+			gotoIfError3(clean, DebugAllocationMap_create(
+				16, &Allocator_allocationsAllocator, &Allocator_shards[i].allocations, e_rr
+			));
+
+		Allocator_nextAllocationId = (AtomicI64) { 0 };
+
 	#endif
 
 	Allocator_memoryAllocationCount = Allocator_memoryAllocationSize = (AtomicI64) { 0 };
@@ -484,6 +576,11 @@ void Platform_cleanup() {
 	if(!Platform_instance)
 		return;
 
+	//A retired RefPtr still holds its references (a graphics resource keeps its device alive),
+	// so whatever wasn't collected by a next frame yet goes before the allocator reports leaks.
+
+	RefPtr_collect();
+
 	CharString_free(&Platform_instance->workDirectory, Platform_instance->alloc);
 	CharString_free(&Platform_instance->appDirectory, Platform_instance->alloc);
 	ListCharString_free(&Platform_instance->args, Platform_instance->alloc);
@@ -503,7 +600,8 @@ void Platform_cleanup() {
 
 	Allocator_reportLeaks();
 
-	ListDebugAllocation_free(&Allocator_allocations, &Allocator_allocationsAllocator);
+	for(U64 i = 0; i < Allocator_shardCount; ++i)
+		DebugAllocationMap_free(&Allocator_shards[i].allocations, &Allocator_allocationsAllocator);
 
 	Platform_cleanupExt();
 
@@ -30,13 +30,12 @@ Bool Platform_checkCPUSupport() {
 	if(!*(const U8*)&v)        //Little endian only
 		return false;
 
-	//CMakeLists.txt compiles the whole arm64 build with -march=armv8-a+simd+crypto+crc, and the NEON encrypt
-	// path calls vaeseq_u8 unconditionally because SIMD_createCryptoState only exists on SSE.
-	//So unlike CRC32C and SHA-256, which pick a fallback at runtime, AES has no guard behind this one:
-	// an ARMv8-A part without the crypto extension would fault the first time anything encrypts an archive.
+	//CMakeLists.txt compiles the whole arm64 build with -march=armv8-a+simd+crypto+crc.
+	//AES and PMULL are runtime gated by SIMD_createCryptoState, which falls back to the bitsliced software path,
+	// but CRC32C is still required.
 
 	const ECPUFeatures features = Platform_detectCPUFeatures();
-	const ECPUFeatures required = ECPUFeatures_HwAES | ECPUFeatures_PCLMULQDQ | ECPUFeatures_HwCRC32C;
+	const ECPUFeatures required = ECPUFeatures_HwCRC32C;
 
 	if((features & required) == required)
 		return true;
@@ -46,7 +45,7 @@ Bool Platform_checkCPUSupport() {
 
 	if(Platform_instance)
 		Log_errorLnx(
-			"Unsupported CPU, this build requires the ARMv8 crypto and CRC extensions (have %08X, need %08X)",
+			"Unsupported CPU, this build requires the ARMv8 CRC extension (have %08X, need %08X)",
 			(U32) features, (U32) required
 		);
 
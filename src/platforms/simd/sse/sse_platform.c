@@ -32,7 +32,7 @@ Bool Platform_checkCPUSupport() {
 
 	//This has to cover everything X64_SIMD_FLAGS in CMakeLists.txt compiles for, because the compiler emits those
 	// instructions anywhere it likes and a missing one faults at an arbitrary point in an arbitrary file.
-	//Leaf 1 EDX gives SSE and SSE2, leaf 1 ECX the rest of the SSE family plus AES, PCLMULQDQ, FMA, AVX and F16C,
+	//Leaf 1 EDX gives SSE and SSE2, leaf 1 ECX the rest of the SSE family plus FMA, AVX and F16C,
 	// and leaf 7 EBX the BMI pair.
 	//-msha is deliberately absent: its only use is runtime gated in sse_buffer_hash.c, so requiring SHA-NI here
 	// would reject every pre-Ice-Lake desktop for a path they never take.
@@ -41,10 +41,10 @@ Bool Platform_checkCPUSupport() {
 
 	U32 mask3 = (1 << 25) | (1 << 26);                                        //SSE, SSE2
 
-	//SSE3, PCLMULQDQ, SSSE3, FMA, SSE4.1, SSE4.2, AES, OSXSAVE, AVX, F16C
-	U32 mask2 =
-		(1 << 0) | (1 << 1) | (1 << 9) | (1 << 12) | (1 << 19) | (1 << 20) | (1 << 25) | (1 << 27) | (1 << 28) |
-		(1 << 29);
+	//SSE3, SSSE3, FMA, SSE4.1, SSE4.2, OSXSAVE, AVX, F16C
+	//AES and PCLMULQDQ are runtime gated by SIMD_createCryptoState (with a software fallback) just like SHA-NI,
+	// the compiler never emits them on its own.
+	U32 mask2 = (1 << 0) | (1 << 9) | (1 << 12) | (1 << 19) | (1 << 20) | (1 << 27) | (1 << 28) | (1 << 29);
 
 	//Zeroed because cpuid leaves the array untouched when the leaf is above the CPU's maximum.
 	//Leaf 7 can be above it on pre-2012 parts and on VM CPU models that report an older family.
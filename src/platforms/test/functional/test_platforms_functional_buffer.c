@@ -304,6 +304,38 @@ static void Test_storeCPUBuffer(Test *t) {
 		Test_assert(t, "streamLen", sr->streamLen == expectedBytes);
 	}
 
+	//The same file as a mapped stream: same bytes, but views point into the mapping
+
+	StreamRef *mappedStream = NULL;
+	StreamCursor cursor = (StreamCursor) { 0 };
+
+	if (Test_assert(t, "openMappedStream", File_openMappedStream(
+		&outPath, 50 * MS, EFileMapHint_Sequential, &fileHandleType, &streamType, &mappedStream, &t->err
+	))) {
+
+		const OxStream *mapped = RefPtr_data(mappedStream, OxStream);
+		ECompareResult cmp = ECompareResult_Lt;
+
+		Test_assert(t, "mappedType", (mapped->streamType & EStreamType_Mapped) && mapped->mapped);
+		Test_assert(t, "mappedWrite", !mapped->write);
+
+		if (Test_assert(t, "mappedCompare", Stream_compare(
+			readStream, mappedStream, 0, 0, 0, 0, alloc, &cmp, &t->err
+		)))
+			Test_assert(t, "mappedEqual", cmp == ECompareResult_Eq);
+
+		Buffer view = Buffer_createNull();
+
+		if (
+			Test_assert(t, "mappedCursor", StreamCursor_create(mappedStream, 0, false, alloc, &cursor, &t->err)) &&
+			Test_assert(t, "mappedView", StreamCursor_view(&cursor, 0, 4, &view, alloc, &t->err))
+		)
+			Test_assert(t, "mappedViewZeroCopy", view.ptr == mapped->mapped && *(const U32*)view.ptr == 0x20534444);
+
+		StreamCursor_close(&cursor, alloc);
+		RefPtr_dec(&mappedStream);
+	}
+
 	File_remove(&outPath, 1 * SECOND, alloc, NULL);
 
 clean:
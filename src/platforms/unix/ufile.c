@@ -30,6 +30,7 @@
 #include "types/base/mathi.h"
 
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <dirent.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -409,6 +410,40 @@ clean:
 	return s_uccess;
 }
 
+Bool FileHandle_mapPhysical(FileHandle *handle, EFileMapHint hint, const U8 **mapped, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(!handle || !mapped)
+		retError(clean, Error_nullPointer(!handle ? 0 : 2, "FileHandle_mapPhysical() handle and mapped are required"));
+
+	int fd = (int)(intptr_t)handle->ext;
+	U64 fileSize = FileHandle_fileSize(handle);
+
+	void *ptr = mmap(NULL, (size_t)fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	if(ptr == MAP_FAILED)
+		retError(clean, Error_stderr(0, "FileHandle_mapPhysical() mmap failed"));
+
+	//Only a hint, so a kernel that ignores it is fine
+
+	if(hint == EFileMapHint_Sequential)
+		madvise(ptr, (size_t)fileSize, MADV_SEQUENTIAL);
+
+	else if(hint == EFileMapHint_Random)
+		madvise(ptr, (size_t)fileSize, MADV_RANDOM);
+
+	*mapped = (const U8*) ptr;
+
+clean:
+	return s_uccess;
+}
+
+void FileHandle_unmapPhysical(const U8 *mapped, U64 length) {
+	if(mapped)
+		munmap((void*) mapped, (size_t)length);
+}
+
 void FileHandle_closePhysical(const void *ext, const Allocator *alloc) {
  
 	(void)alloc;
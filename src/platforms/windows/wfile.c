@@ -430,6 +430,46 @@ clean:
 	return s_uccess;
 }
 
+Bool FileHandle_mapPhysical(FileHandle *handle, EFileMapHint hint, const U8 **mapped, Error *e_rr) {
+
+	Bool s_uccess = true;
+	HANDLE mapping = NULL;
+
+	(void)hint;        //There's no madvise, the cache manager detects sequential access by itself
+
+	if(!handle || !mapped)
+		retError(clean, Error_nullPointer(!handle ? 0 : 2, "FileHandle_mapPhysical() handle and mapped are required"));
+
+	mapping = CreateFileMappingW((HANDLE)handle->ext, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if(!mapping)
+		retError(clean, Error_platformError(0, GetLastError(), "FileHandle_mapPhysical() CreateFileMapping failed"));
+
+	//The view keeps the mapping object alive, so it can be closed right away
+
+	const void *ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if(!ptr)
+		retError(clean, Error_platformError(1, GetLastError(), "FileHandle_mapPhysical() MapViewOfFile failed"));
+
+	*mapped = (const U8*) ptr;
+
+clean:
+
+	if(mapping)
+		CloseHandle(mapping);
+
+	return s_uccess;
+}
+
+void FileHandle_unmapPhysical(const U8 *mapped, U64 length) {
+
+	(void)length;
+
+	if(mapped)
+		UnmapViewOfFile(mapped);
+}
+
 void FileHandle_closePhysical(const void *ext, const Allocator *alloc) {
 
 	(void)alloc;
@@ -28,6 +28,7 @@
 #include "types/base/lock.h"
 #include "types/base/thread.h"
 #include "types/container/job_queue.h"
+#include "types/container/trace.h"
 #include "types/container/list_basic_types.h"
 #include "types/base/string_read_helper.h"
 #include "types/container/memory_stream.h"
@@ -455,7 +456,9 @@ Bool Compiler_compileCombinationJob(void *data, U64 threadId, JobQueue *queue) {
 
 	//Compile and return error if failed
 
-	if(!Compiler_compileShaderSingle(
+	Trace_zoneBegin("Compiler", "compileShaderSingle");
+
+	const Bool compiled = Compiler_compileShaderSingle(
 		compiler,
 		file->binaryType,
 		job->isDebug,
@@ -471,7 +474,11 @@ Bool Compiler_compileCombinationJob(void *data, U64 threadId, JobQueue *queue) {
 		&job->includeDirs,
 		job->enableLogging,
 		alloc
-	)) {
+	);
+
+	Trace_zoneEnd("Compiler", "compileShaderSingle");
+
+	if (!compiled) {
 
 		if(job->enableLogging)
 			Log_errorLn(
@@ -956,9 +963,13 @@ Bool Compiler_compileShaderFileJob(void *data, U64 threadId, JobQueue *queue) {
 	if(!job)
 		return false;
 
+	Trace_zoneBegin("Compiler", "compileShaderFile");
+
 	Error errTmp = Error_none();
 	Bool spawned = Compiler_compileShaderFile(job, queue, threadId, &errTmp);
 
+	Trace_zoneEnd("Compiler", "compileShaderFile");
+
 	if(!spawned && job->enableLogging)
 		Error_print(job->alloc, &errTmp, ELogLevel_Error, ELogOptions_Default);
 
@@ -1099,6 +1110,123 @@ clean:
 	return s_uccess;
 }
 
+//Combining and writing one oiSH per output.
+//Files that share an output are adjacent, so an output group is a range of files.
+//Groups don't share anything, so they're written with JobQueue_parallelFor once all compiles are done;
+// within a group merging stays ordered.
+
+typedef struct CompilerOutputGroup {
+	U64 begin, end;                     //Files [begin, end> write to allOutputs->ptr[end - 1]
+	Error err;                          //Only written by this group's job
+} CompilerOutputGroup;
+
+TList(CompilerOutputGroup);
+TListImpl(CompilerOutputGroup);
+
+typedef struct CompilerWriteCtx {
+	ListCompilerShaderFileJob jobs;
+	ListCompilerOutputGroup groups;
+	const ListCharString *allOutputs;
+	ListBuffer *allBuffers;             //Optional; otherwise written to disk
+	const Allocator *alloc;
+	ECompilerWarning extraWarnings;
+	Bool enableLogging;
+	U8 padding[3];
+} CompilerWriteCtx;
+
+Bool Compiler_writeOutputGroup(const CompilerWriteCtx *ctx, CompilerOutputGroup *group, Error *e_rr) {
+
+	Bool s_uccess = true;
+	const Allocator *alloc = ctx->alloc;
+
+	SHFile previous = (SHFile) { 0 };       //Accumulates the SHFiles of the group
+	Buffer temp = Buffer_createNull();
+	Bool errorInPrevious = false;
+
+	MemoryStreamRef *ms = NULL;
+	const RefPtrType msType = MemoryStream_makeType(alloc);
+	const RefPtrType fileHandleType = FileHandle_makeType(alloc);
+
+	for (U64 i = group->begin; i < group->end; ++i) {
+
+		CompilerShaderFileJob *job = &ctx->jobs.ptrNonConst[i];
+
+		if(!job->success)
+			errorInPrevious = true;
+
+		//Merge into the group's accumulator (empty results come from ignored empty files)
+
+		else if (job->result.entries.ptr) {
+
+			if (!previous.entries.ptr) {
+				previous = job->result;
+				job->result = (SHFile) { 0 };
+			}
+
+			else {
+				SHFile tmp = (SHFile) { 0 };
+				gotoIfError3(clean, SHFile_combine(&previous, &job->result, alloc, &tmp, e_rr));
+				SHFile_free(&previous, alloc);
+				SHFile_free(&job->result, alloc);
+				previous = tmp;
+			}
+		}
+	}
+
+	//Finish up the group's SHFile and write it
+
+	const U64 outputId = group->end - 1;
+
+	if(errorInPrevious) {
+		if(ctx->enableLogging)
+			Log_warnLn(alloc, "One of the previous oiSH compilations failed, not producing a binary");
+	}
+
+	else if (previous.entries.ptr) {
+
+		if(ctx->extraWarnings)
+			gotoIfError3(clean, Compiler_handleExtraWarnings(&previous, ctx->extraWarnings, alloc, e_rr));
+
+		//Serialize through a resizable memory stream, then hand the buffer to the caller or disk
+
+		U64 writeOff = 0;
+		gotoIfError3(clean, MemoryStream_create(0, EMemoryStreamFlags_WriteResize, &msType, &ms, e_rr));
+		gotoIfError3(clean, SHFile_write((StreamRef*)ms, &writeOff, &previous, alloc, e_rr));
+		gotoIfError3(clean, MemoryStream_move(&ms, &temp, e_rr));
+		RefPtr_dec(&ms);
+
+		if(ctx->allBuffers) {
+			ctx->allBuffers->ptrNonConst[outputId] = temp;
+			temp = Buffer_createNull();     //Moved
+		}
+
+		else gotoIfError3(clean, File_write(
+			&temp, &ctx->allOutputs->ptr[outputId], 0, 0, 100 * MS, true, &fileHandleType, e_rr
+		));
+	}
+
+clean:
+	RefPtr_dec(&ms);
+	SHFile_free(&previous, alloc);
+	Buffer_free(&temp, alloc);
+	return s_uccess;
+}
+
+Bool Compiler_writeOutputGroupsJob(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+
+	CompilerWriteCtx *ctx = (CompilerWriteCtx*) data;
+	Bool s_uccess = true;
+
+	for (U64 i = begin; i < end; ++i) {
+		CompilerOutputGroup *group = &ctx->groups.ptrNonConst[i];
+		s_uccess &= Compiler_writeOutputGroup(ctx, group, &group->err);
+	}
+
+	return s_uccess;
+}
+
 Bool Compiler_compileShaders(
 	const ListCharString *allFiles,
 	const ListCharString *allShaderText,
@@ -1120,17 +1248,13 @@ Bool Compiler_compileShaders(
 
 	Bool s_uccess = true;
 
+	Trace_zoneBegin("Compiler", "compileShaders");
+
 	JobQueue queue = (JobQueue) { 0 };
 	ListCompiler compilers = (ListCompiler) { 0 };
 	ListCompilerShaderFileJob jobs = (ListCompilerShaderFileJob) { 0 };
 
-	SHFile previous = (SHFile) { 0 };       //Accumulates SHFiles that share the same output
-	Buffer temp = Buffer_createNull();
-	Bool errorInPrevious = false;
-
-	MemoryStreamRef *ms = NULL;
-	const RefPtrType msType = MemoryStream_makeType(alloc);
-	const RefPtrType fileHandleType = FileHandle_makeType(alloc);
+	ListCompilerOutputGroup groups = (ListCompilerOutputGroup) { 0 };
 
 	if(allBuffers)
 		gotoIfError3(clean, ListBuffer_resize(allBuffers, allOutputs->length, alloc, e_rr));
@@ -1139,8 +1263,9 @@ Bool Compiler_compileShaders(
 	//threadCount <= 1 puts the queue in single threaded mode: no threads are spawned and all jobs run inline
 	// (in push order) during JobQueue_wait, which keeps a deterministic flow around for debugging.
 	//Higher counts run the same jobs on threadCount execution contexts.
+	//Every file fans out into combinations and link jobs from inside its jobs, which is what work stealing is for.
 
-	gotoIfError3(clean, JobQueue_create(threadCount, alloc, &queue, e_rr));
+	gotoIfError3(clean, JobQueue_createFlags(threadCount, EJobQueueFlags_WorkStealing, alloc, &queue, e_rr));
 
 	const U64 contexts = JobQueue_threadCount(&queue);
 
@@ -1184,76 +1309,49 @@ Bool Compiler_compileShaders(
 		s_uccess = false;       //Report failure, but still write the outputs that did succeed
 
 	//Combine SHFiles that share the same output (e.g. DXIL + SPIRV into a single oiSH) and write them to allBuffers or disk.
-	//Files with the same output are adjacent.
-	//This stays sequential on purpose; it's cheap compared to compiling and merging is ordered.
+	//Files with the same output are adjacent, each output group is written by its own job.
 
-	for (U64 i = 0; i < allFiles->length; ++i) {
-
-		CompilerShaderFileJob *job = &jobs.ptrNonConst[i];
+	for (U64 i = 0, begin = 0; i < allFiles->length; ++i) {
 
 		const Bool lastOfGroup =
 			i + 1 == allOutputs->length ||
 			!CharString_equalsStringSensitive(&allOutputs->ptr[i + 1], &allOutputs->ptr[i]);
 
-		if(!job->success)
-			errorInPrevious = true;
-
-		//Merge into the group's accumulator (empty results come from ignored empty files)
-
-		else if (job->result.entries.ptr) {
-
-			if (!previous.entries.ptr) {
-				previous = job->result;
-				job->result = (SHFile) { 0 };
-			}
-
-			else {
-				SHFile tmp = (SHFile) { 0 };
-				gotoIfError3(clean, SHFile_combine(&previous, &job->result, alloc, &tmp, e_rr));
-				SHFile_free(&previous, alloc);
-				SHFile_free(&job->result, alloc);
-				previous = tmp;
-			}
-		}
-
 		if(!lastOfGroup)
 			continue;
 
-		//Finish up the group's SHFile and write it
+		gotoIfError3(clean, ListCompilerOutputGroup_pushBack(
+			&groups, (CompilerOutputGroup) { .begin = begin, .end = i + 1 }, alloc, e_rr
+		));
 
-		if(errorInPrevious) {
-			if(enableLogging)
-				Log_warnLn(alloc, "One of the previous oiSH compilations failed, not producing a binary");
-		}
+		begin = i + 1;
+	}
 
-		else if (previous.entries.ptr) {
+	CompilerWriteCtx writeCtx = (CompilerWriteCtx) {
+		.jobs = jobs,
+		.groups = groups,
+		.allOutputs = allOutputs,
+		.allBuffers = allBuffers,
+		.alloc = alloc,
+		.extraWarnings = extraWarnings,
+		.enableLogging = enableLogging
+	};
 
-			if(extraWarnings)
-				gotoIfError3(clean, Compiler_handleExtraWarnings(&previous, extraWarnings, alloc, e_rr));
+	gotoIfError3(clean, JobQueue_parallelFor(&queue, groups.length, 1, Compiler_writeOutputGroupsJob, &writeCtx, NULL, e_rr));
+	gotoIfError3(clean, JobQueue_wait(&queue, e_rr));
 
-			//Serialize through a resizable memory stream, then hand the buffer to the caller or disk
+	//Report the first output that failed, like the sequential loop used to
 
-			U64 writeOff = 0;
-			gotoIfError3(clean, MemoryStream_create(0, EMemoryStreamFlags_WriteResize, &msType, &ms, e_rr));
-			gotoIfError3(clean, SHFile_write((StreamRef*)ms, &writeOff, &previous, alloc, e_rr));
-			gotoIfError3(clean, MemoryStream_move(&ms, &temp, e_rr));
-			RefPtr_dec(&ms);
+	for(U64 i = 0; i < groups.length; ++i)
+		if (groups.ptr[i].err.genericError) {
 
-			if(allBuffers) {
-				allBuffers->ptrNonConst[i] = temp;
-				temp = Buffer_createNull();     //Moved
-			}
+			if(e_rr)
+				*e_rr = groups.ptr[i].err;
 
-			else {
-				gotoIfError3(clean, File_write(&temp, &allOutputs->ptr[i], 0, 0, 100 * MS, true, &fileHandleType, e_rr));
-				Buffer_free(&temp, alloc);
-			}
+			s_uccess = false;
+			break;
 		}
 
-		SHFile_free(&previous, alloc);
-		errorInPrevious = false;
-	}
-
 clean:
 
 	JobQueue_free(&queue);      //Must go first; jobs reference compilers and the jobs list
@@ -1262,11 +1360,9 @@ clean:
 		SHFile_free(&jobs.ptrNonConst[i].result, alloc);
 
 	ListCompilerShaderFileJob_free(&jobs, alloc);
+	ListCompilerOutputGroup_free(&groups, alloc);
 	ListCompiler_freeUnderlying(&compilers, alloc);
 
-	RefPtr_dec(&ms);
-	SHFile_free(&previous, alloc);
-	Buffer_free(&temp, alloc);
-
+	Trace_zoneEnd("Compiler", "compileShaders");
 	return s_uccess;
 }
@@ -131,8 +131,6 @@ Bool CLI_convertToCA(const CLIConvert *convert, Error *e_rr) {
 
 	(void)convert->inputInfo;
 
-	//TODO: Compression type
-
 	CASettings settings = (CASettings) { .compressionType = EXXCompressionType_None };
 
 	//Dates
@@ -150,11 +148,13 @@ Bool CLI_convertToCA(const CLIConvert *convert, Error *e_rr) {
 
 	//Compression type
 
-	if(convert->args->flags & EOperationFlags_Uncompressed)
-		settings.compressionType = EXXCompressionType_None;
+	if ((convert->args->flags & EOperationFlags_Uncompressed) && (convert->args->flags & EOperationFlags_FastCompress))
+		retError(clean, Error_invalidParameter(
+			0, 0, "CLI_convertToCA() oiCA can only pick --uncompressed or --fast-compress, not both"
+		));
 
-	//else if(args.flags & EOperationFlags_FastCompress)                TODO:
-	//    settings.compressionType = ECACompressionType_Brotli1;
+	if(convert->args->flags & EOperationFlags_FastCompress)
+		settings.compressionType = EXXCompressionType_LZ;
 
 	//Copying encryption key
 
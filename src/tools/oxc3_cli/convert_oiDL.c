@@ -60,8 +60,6 @@ Bool CLI_convertToDL(const CLIConvert *convert, Error *e_rr) {
 
 	if(!convert) return false;
 
-	//TODO: EXXCompressionType_Brotli11
-
 	const Allocator *alloc = Platform_instance->alloc;
 
 	Bool s_uccess = true;
@@ -101,11 +99,13 @@ Bool CLI_convertToDL(const CLIConvert *convert, Error *e_rr) {
 
 	//Compression type
 
-	if(convert->args->flags & EOperationFlags_Uncompressed)
-		settings.compressionType = EXXCompressionType_None;
+	if ((convert->args->flags & EOperationFlags_Uncompressed) && (convert->args->flags & EOperationFlags_FastCompress))
+		retError(clean, Error_invalidParameter(
+			0, 1, "CLI_convertToDL() oiDL can only pick --uncompressed or --fast-compress, not both"
+		));
 
-	//else if(args->flags & EOperationFlags_FastCompress)                TODO:
-	//    settings.compressionType = EXXCompressionType_Brotli1;
+	if(convert->args->flags & EOperationFlags_FastCompress)
+		settings.compressionType = EXXCompressionType_LZ;
 
 	//Copying encryption key
 
@@ -22,11 +22,50 @@
 
 #include "tools/oxc3_cli/cli.h"
 #include "platforms/platform.h"
+#include "platforms/file.h"
+#include "types/container/trace.h"
+#include "types/container/string.h"
+#include "types/container/log.h"
+
+#include <stdlib.h>
 
 #ifdef CLI_SHADER_COMPILER
 	#include "shader_compiler/compiler.h"
 #endif
 
+//With tracing compiled in, OXC3_TRACE=path records the whole run and writes it as a Chrome trace.
+
+static const C8 *CLI_tracePath() {
+	return _ENABLE_TRACING ? getenv("OXC3_TRACE") : NULL;
+}
+
+static void CLI_writeTrace(const C8 *path) {
+
+	const Allocator *alloc = Platform_instance->alloc;
+	Error err = Error_none(), *e_rr = &err;
+	Bool s_uccess = true;
+	CharString json = CharString_createNull();
+
+	Trace_stop();
+
+	gotoIfError3(clean, Trace_exportChrome(alloc, &json, e_rr));
+
+	const CharString loc = CharString_createRefCStrConst(path);
+	const RefPtrType fileHandleType = FileHandle_makeType(alloc);
+	const Buffer buf = CharString_bufferConst(json);
+
+	gotoIfError3(clean, File_write(&buf, &loc, 0, 0, 1 * SECOND, true, &fileHandleType, e_rr));
+	Log_debugLn(alloc, "Wrote trace to \"%s\" (%"PRIu64" dropped events)", path, Trace_dropped());
+
+clean:
+
+	if(!s_uccess)
+		Error_print(alloc, &err, ELogLevel_Error, ELogOptions_Default);
+
+	CharString_free(&json, alloc);
+	Trace_clear();
+}
+
 Platform_defineEntrypoint() {
 
 	int status = 0;
@@ -41,6 +80,11 @@ Platform_defineEntrypoint() {
 		Compiler_setPlatform(Platform_instance);
 	#endif
 
+	const C8 *tracePath = CLI_tracePath();
+
+	if(tracePath && !Trace_start(Platform_instance->alloc, NULL))
+		tracePath = NULL;
+
 	CLI_init();
 
 	if (!CLI_execute(Platform_instance->args)) {
@@ -49,6 +93,10 @@ Platform_defineEntrypoint() {
 	}
 
 clean:
+
+	if(tracePath)
+		CLI_writeTrace(tracePath);
+
 	CLI_shutdown();
 	Platform_cleanup();
 	Platform_return(status);
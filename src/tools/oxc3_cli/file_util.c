@@ -850,7 +850,6 @@ Bool CLI_fileCmp(const ParsedArgs *args) {
 	FileInfo infoA = (FileInfo) { 0 }, infoB = (FileInfo) { 0 };
 	StreamRef *sa = NULL, *sb = NULL;
 	StreamCursor ca = (StreamCursor) { 0 }, cb = (StreamCursor) { 0 };
-	Buffer chunkA = Buffer_createNull(), chunkB = Buffer_createNull();
 	Bool s_uccess = true;
 	Error err = Error_none(), *e_rr = &err;
 
@@ -860,26 +859,35 @@ Bool CLI_fileCmp(const ParsedArgs *args) {
 	const U64 lenA = infoA.fileSize, lenB = infoB.fileSize;
 	const U64 minLen = U64_min(lenA, lenB);
 
-	gotoIfError3(clean, File_openStream(&a, 1 * SECOND, EFileOpenType_Read, false, &fileHandleType, &streamType, &sa, e_rr));
-	gotoIfError3(clean, File_openStream(&b, 1 * SECOND, EFileOpenType_Read, false, &fileHandleType, &streamType, &sb, e_rr));
+	//Both files are mapped, so the chunks are compared in place rather than read into buffers first
+
+	gotoIfError3(clean, File_openMappedStream(
+		&a, 1 * SECOND, EFileMapHint_Sequential, &fileHandleType, &streamType, &sa, e_rr
+	));
+
+	gotoIfError3(clean, File_openMappedStream(
+		&b, 1 * SECOND, EFileMapHint_Sequential, &fileHandleType, &streamType, &sb, e_rr
+	));
+
 	gotoIfError3(clean, StreamCursor_create(sa, CLI_STREAM_CACHE, false, alloc, &ca, e_rr));
 	gotoIfError3(clean, StreamCursor_create(sb, CLI_STREAM_CACHE, false, alloc, &cb, e_rr));
 
-	gotoIfError3(clean, Buffer_createUninitializedBytes(CLI_FILE_CHUNK, alloc, &chunkA, e_rr));
-	gotoIfError3(clean, Buffer_createUninitializedBytes(CLI_FILE_CHUNK, alloc, &chunkB, e_rr));
-
 	U64 firstDiff = U64_MAX;
+	U8 diffA = 0, diffB = 0;
 
 	for(U64 off = 0; off < minLen && firstDiff == U64_MAX; off += CLI_FILE_CHUNK) {
 
 		const U64 n = U64_min((U64) CLI_FILE_CHUNK, minLen - off);
+		Buffer chunkA = Buffer_createNull(), chunkB = Buffer_createNull();
 
-		gotoIfError3(clean, StreamCursor_read(&ca, chunkA, off, 0, n, true, alloc, e_rr));
-		gotoIfError3(clean, StreamCursor_read(&cb, chunkB, off, 0, n, true, alloc, e_rr));
+		gotoIfError3(clean, StreamCursor_view(&ca, off, n, &chunkA, alloc, e_rr));
+		gotoIfError3(clean, StreamCursor_view(&cb, off, n, &chunkB, alloc, e_rr));
 
 		for(U64 i = 0; i < n; ++i)
 			if(chunkA.ptr[i] != chunkB.ptr[i]) {
 				firstDiff = off + i;
+				diffA = chunkA.ptr[i];
+				diffB = chunkB.ptr[i];
 				break;
 			}
 	}
@@ -894,15 +902,13 @@ Bool CLI_fileCmp(const ParsedArgs *args) {
 
 	else Log_debugLnx(
 		"Files differ at byte 0x%"PRIx64" (%"PRIu64"): 0x%02x vs 0x%02x.",
-		firstDiff, firstDiff, chunkA.ptr[firstDiff % CLI_FILE_CHUNK], chunkB.ptr[firstDiff % CLI_FILE_CHUNK]
+		firstDiff, firstDiff, diffA, diffB
 	);
 
 clean:
 	if(err.genericError)
 		Error_print(alloc, &err, ELogLevel_Error, ELogOptions_Default);
 
-	Buffer_free(&chunkA, alloc);
-	Buffer_free(&chunkB, alloc);
 	StreamCursor_close(&ca, alloc);
 	StreamCursor_close(&cb, alloc);
 	RefPtr_dec(&sa);
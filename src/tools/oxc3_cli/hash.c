@@ -24,6 +24,9 @@
 #include "types/container/buffer.h"
 #include "types/math/vec4i.h"
 #include "types/container/string.h"
+#include "types/container/stream.h"
+#include "types/container/job_queue.h"
+#include "types/container/list_impl.h"
 #include "types/base/string_mut.h"
 #include "platforms/platform.h"
 #include "platforms/file.h"
@@ -31,20 +34,70 @@
 #include "tools/oxc3_cli/operations.h"
 #include "types/base/constants.h"
 
-Bool CLI_hash(CharString str, Bool isFile, EFormat format, Error *e_rr) {
+//Turns a SHA256 into a hex string (without 0x)
 
-	const Allocator *alloc = Platform_instance->alloc;
-	const RefPtrType fileHandleType = FileHandle_makeType(alloc);
+Bool CLI_sha256ToString(const U32 output[8], const Allocator *alloc, CharString *result, Error *e_rr) {
 
-	Buffer buf = Buffer_createNull();
 	CharString tmp = CharString_createNull();
 	CharString tmpi = CharString_createNull();
 	Bool s_uccess = true;
 
-	if(!isFile)
-		buf = CharString_bufferConst(str);
+	for (U8 i = 0; i < 8; ++i) {
+		const CharStringCreateNumber number = (CharStringCreateNumber) {
+			.v = output[i], .leadingZeros = 8, .allocator = alloc, .result = &tmpi
+		};
+		gotoIfError3(clean, CharString_createHex(&number, e_rr));
+		gotoIfError3(clean, CharString_popFrontCount(&tmpi, 2, e_rr));
+		gotoIfError3(clean, CharString_appendString(&tmp, &tmpi, alloc, e_rr));
+		CharString_free(&tmpi, alloc);
+	}
 
-	else gotoIfError3(clean, File_read(&str, 100 * MS, 0, 0, &fileHandleType, &buf, e_rr));
+	*result = tmp;
+	tmp = CharString_createNull();
+
+clean:
+	CharString_free(&tmp, alloc);
+	CharString_free(&tmpi, alloc);
+	return s_uccess;
+}
+
+//Turns an XXH3 into a hex string (without 0x), XXH128 is printed like xxhsum does (high half first)
+
+Bool CLI_xxh3ToString(Hash128 h, Bool is64, const Allocator *alloc, CharString *result, Error *e_rr) {
+
+	CharString tmp = CharString_createNull();
+	CharString tmpi = CharString_createNull();
+	Bool s_uccess = true;
+
+	for (U8 i = is64 ? 1 : 0; i < 2; ++i) {
+		const CharStringCreateNumber number = (CharStringCreateNumber) {
+			.v = i ? h.lo : h.hi, .leadingZeros = 16, .allocator = alloc, .result = &tmpi
+		};
+		gotoIfError3(clean, CharString_createHex(&number, e_rr));
+		gotoIfError3(clean, CharString_popFrontCount(&tmpi, 2, e_rr));
+		gotoIfError3(clean, CharString_appendString(&tmp, &tmpi, alloc, e_rr));
+		CharString_free(&tmpi, alloc);
+	}
+
+	*result = tmp;
+	tmp = CharString_createNull();
+
+clean:
+	CharString_free(&tmp, alloc);
+	CharString_free(&tmpi, alloc);
+	return s_uccess;
+}
+
+//Turns the hash of buf into a hex string (without 0x)
+//queue (optional) lets CRC32C use multiple threads, only the thread that owns the queue may pass it.
+
+Bool CLI_hashToString(
+	Buffer buf, EFormat format, JobQueue *queue, const Allocator *alloc, CharString *result, Error *e_rr
+) {
+
+	CharString tmp = CharString_createNull();
+	CharString tmpi = CharString_createNull();
+	Bool s_uccess = true;
 
 	switch(format) {
 
@@ -52,24 +105,14 @@ Bool CLI_hash(CharString str, Bool isFile, EFormat format, Error *e_rr) {
 
 			U32 output[8] = { 0 };
 			Buffer_sha256(buf, output);
-
-			//Stringify
-
-			for (U8 i = 0; i < 8; ++i) {
-				const CharStringCreateNumber number = (CharStringCreateNumber) {
-					.v = output[i], .leadingZeros = 8, .allocator = alloc, .result = &tmpi
-				};
-				gotoIfError3(clean, CharString_createHex(&number, e_rr));
-				gotoIfError3(clean, CharString_popFrontCount(&tmpi, 2, e_rr));
-				gotoIfError3(clean, CharString_appendString(&tmp, &tmpi, alloc, e_rr));
-				CharString_free(&tmpi, alloc);
-			}
-
+			gotoIfError3(clean, CLI_sha256ToString(output, alloc, &tmp, e_rr));
 			break;
 		}
 
 		case EFormat_CRC32C: {
-			const U32 output = Buffer_crc32c(buf);
+			U32 output = 0;
+			gotoIfError3(clean, Buffer_crc32cParallel(buf, queue, &output, e_rr));
+
 			const CharStringCreateNumber number = (CharStringCreateNumber) {
 				.v = output, .leadingZeros = 8, .allocator = alloc, .result = &tmp
 			};
@@ -88,6 +131,16 @@ Bool CLI_hash(CharString str, Bool isFile, EFormat format, Error *e_rr) {
 			break;
 		}
 
+		case EFormat_XXH3:
+		case EFormat_XXH128: {
+
+			const Hash128 h = format == EFormat_XXH3 ?
+				(Hash128) { .lo = Buffer_hash64(buf, 0) } : Buffer_hash128(buf, 0);
+
+			gotoIfError3(clean, CLI_xxh3ToString(h, format == EFormat_XXH3, alloc, &tmp, e_rr));
+			break;
+		}
+
 		case EFormat_MD5: {
 
 			const MD5Hash output = Buffer_md5(buf);
@@ -106,10 +159,70 @@ Bool CLI_hash(CharString str, Bool isFile, EFormat format, Error *e_rr) {
 		}
 
 		default:
-			Log_errorLnx("Unsupported format");
-			goto clean;
+			retError(clean, Error_invalidEnum(
+				1, (U64) format, (U64) EFormat_Invalid, "CLI_hashToString() unsupported format"
+			));
+	}
+
+	*result = tmp;
+	tmp = CharString_createNull();
+
+clean:
+	CharString_free(&tmp, alloc);
+	CharString_free(&tmpi, alloc);
+	return s_uccess;
+}
+
+Bool CLI_hash(CharString str, Bool isFile, EFormat format, Error *e_rr) {
+
+	const Allocator *alloc = Platform_instance->alloc;
+	const RefPtrType fileHandleType = FileHandle_makeType(alloc);
+	const RefPtrType streamType = FileStream_makeType(alloc);
+
+	Buffer buf = Buffer_createNull();
+	CharString tmp = CharString_createNull();
+	JobQueue queue = (JobQueue) { 0 };
+	StreamRef *stream = NULL;
+	StreamCursor cursor = (StreamCursor) { 0 };
+	Bool s_uccess = true;
+
+	const Bool xxh3 = format == EFormat_XXH3 || format == EFormat_XXH128;
+
+	if(!isFile)
+		buf = CharString_bufferConst(str);
+
+	//XXH3 streams the file through a StreamCursor rather than reading it whole, so any size works
+
+	else if (xxh3) {
+
+		gotoIfError3(clean, File_openStream(
+			&str, 100 * MS, EFileOpenType_Read, false, &fileHandleType, &streamType, &stream, e_rr
+		));
+
+		gotoIfError3(clean, StreamCursor_create(stream, MIBI, false, alloc, &cursor, e_rr));
+
+		BufferHashState state;
+		BufferHashState_create(0, &state);
+		gotoIfError3(clean, StreamCursor_hash(&cursor, 0, 0, &state, alloc, e_rr));
+
+		const Hash128 h = format == EFormat_XXH3 ?
+			(Hash128) { .lo = BufferHashState_digest64(&state) } : BufferHashState_digest128(&state);
+
+		gotoIfError3(clean, CLI_xxh3ToString(h, format == EFormat_XXH3, alloc, &tmp, e_rr));
 	}
 
+	else gotoIfError3(clean, File_read(&str, 100 * MS, 0, 0, &fileHandleType, &buf, e_rr));
+
+	//A multi GB file can be split over all cores for CRC32C (small ones are hashed inline anyway)
+
+	const Bool parallel = isFile && format == EFormat_CRC32C && Buffer_length(buf) >= 64 * MIBI;
+
+	if(parallel)
+		gotoIfError3(clean, JobQueue_create(Platform_getThreads(), alloc, &queue, e_rr));
+
+	if(!isFile || !xxh3)
+		gotoIfError3(clean, CLI_hashToString(buf, format, parallel ? &queue : NULL, alloc, &tmp, e_rr));
+
 	Log_debugLnx("Hash: 0x%.*s: \t\t%.*s", CharString_length(tmp), tmp.ptr, (int) CharString_length(str), str.ptr);
 
 clean:
@@ -122,33 +235,164 @@ clean:
 			Error_print(alloc, e_rr, ELogLevel_Error, ELogOptions_Default);
 	}
 
+	JobQueue_free(&queue);
+	StreamCursor_close(&cursor, alloc);
+	RefPtr_dec(&stream);
 	Buffer_free(&buf, alloc);
 	CharString_free(&tmp, alloc);
-	CharString_free(&tmpi, alloc);
 	return s_uccess;
 }
 
-Bool CLI_hashAllTheFiles(const FileInfo *info, void *formatGeneric, const Allocator *alloc, Error *e_rr) {
+//Hashing a folder.
+//Files are collected first, then hashed by a JobQueue (reading + hashing a file doesn't depend on any other file).
+//Every file keeps its own result and error, so the output is still logged in the order File_foreach found them.
+//Files are already spread over the threads here, so each one is hashed single threaded.
+
+typedef struct CLIHashEntry {
+	CharString path;
+	CharString hash;
+	Error err;                          //Only written by the job that hashes this file
+} CLIHashEntry;
 
-	EFormat *format = (EFormat*) formatGeneric;
+TList(CLIHashEntry);
+TListImpl(CLIHashEntry);
 
-	(void) alloc;
+typedef struct CLIHashFolder {
+	ListCLIHashEntry entries;
+	const Allocator *alloc;
+	EFormat format;
+	U32 padding;
+} CLIHashFolder;
 
+Bool CLI_hashAllTheFiles(const FileInfo *info, void *folderGeneric, const Allocator *alloc, Error *e_rr) {
+
+	CLIHashFolder *folder = (CLIHashFolder*) folderGeneric;
+	CLIHashEntry entry = (CLIHashEntry) { 0 };
 	Bool s_uccess = true;
 
-	if(info->type == EFileType_File)
-		gotoIfError3(clean, CLI_hash(info->path, true, *format, e_rr));
+	if(info->type != EFileType_File)
+		goto clean;
+
+	gotoIfError3(clean, CharString_createCopy(info->path, alloc, &entry.path, e_rr));
+	gotoIfError3(clean, ListCLIHashEntry_pushBack(&folder->entries, entry, alloc, e_rr));
+	entry.path = CharString_createNull();       //Moved
 
 clean:
+	CharString_free(&entry.path, alloc);
 	return s_uccess;
 }
 
-Bool CLI_hashFile(const ParsedArgs *args) {
+//SHA256 reads every file of its range first, so they're hashed as one multi-buffer batch (Buffer_sha256Batch).
+//The other formats hash a file as soon as it's read.
 
-	if(!args) return false;
+#define CLI_hashBatch 16
+
+Bool CLI_hashFileJob(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+
+	const CLIHashFolder *folder = (const CLIHashFolder*) data;
+	const Allocator *alloc = folder->alloc;
+	const RefPtrType fileHandleType = FileHandle_makeType(alloc);
+	const Bool batch = folder->format == EFormat_SHA256;
+	Bool s_uccess = true;
+
+	Buffer bufs[CLI_hashBatch] = { 0 };
+	U32 outputs[CLI_hashBatch][8];
+
+	for (U64 i = begin; i < end; ++i) {
+
+		CLIHashEntry *entry = &folder->entries.ptrNonConst[i];
+		Buffer *buf = &bufs[batch ? i - begin : 0];
+
+		Bool ok = File_read(&entry->path, 100 * MS, 0, 0, &fileHandleType, buf, &entry->err);
+
+		if (!batch) {
+			ok = ok && CLI_hashToString(*buf, folder->format, NULL, alloc, &entry->hash, &entry->err);
+			Buffer_free(buf, alloc);
+		}
+
+		s_uccess &= ok;
+	}
+
+	if(!batch)
+		return s_uccess;
+
+	Buffer_sha256Batch(bufs, end - begin, outputs);
+
+	for (U64 i = begin; i < end; ++i) {
+
+		CLIHashEntry *entry = &folder->entries.ptrNonConst[i];
+
+		if(!entry->err.genericError)
+			s_uccess &= CLI_sha256ToString(outputs[i - begin], alloc, &entry->hash, &entry->err);
+
+		Buffer_free(&bufs[i - begin], alloc);
+	}
+
+	return s_uccess;
+}
+
+Bool CLI_hashFolder(CharString str, EFormat format) {
 
 	const Allocator *alloc = Platform_instance->alloc;
 
+	CLIHashFolder folder = (CLIHashFolder) { .alloc = alloc, .format = format };
+	JobQueue queue = (JobQueue) { 0 };
+	Error err = Error_none(), *e_rr = &err;
+	Bool s_uccess = true;
+
+	gotoIfError3(clean, File_foreach(&str, false, CLI_hashAllTheFiles, &folder, true, alloc, e_rr));
+
+	gotoIfError3(clean, JobQueue_createFlags(
+		Platform_getThreads(), EJobQueueFlags_WorkStealing, alloc, &queue, e_rr
+	));
+
+	const U64 grain = format == EFormat_SHA256 ? CLI_hashBatch : 1;
+	gotoIfError3(clean, JobQueue_parallelFor(&queue, folder.entries.length, grain, CLI_hashFileJob, &folder, NULL, e_rr));
+
+	gotoIfError3(clean, JobQueue_wait(&queue, e_rr));       //File errors are per entry and reported below
+
+	for (U64 i = 0; i < folder.entries.length; ++i) {
+
+		CLIHashEntry *entry = &folder.entries.ptrNonConst[i];
+
+		if (entry->err.genericError) {
+			Log_errorLnx("Failed to hash %.*s", (int) CharString_length(entry->path), entry->path.ptr);
+			Error_print(alloc, &entry->err, ELogLevel_Error, ELogOptions_Default);
+			s_uccess = false;
+			continue;
+		}
+
+		Log_debugLnx(
+			"Hash: 0x%.*s: \t\t%.*s",
+			CharString_length(entry->hash), entry->hash.ptr,
+			(int) CharString_length(entry->path), entry->path.ptr
+		);
+	}
+
+clean:
+
+	if(err.genericError) {
+		Log_errorLnx("Failed to hash folder!");
+		Error_print(alloc, e_rr, ELogLevel_Error, ELogOptions_Default);
+	}
+
+	JobQueue_free(&queue);
+
+	for (U64 i = 0; i < folder.entries.length; ++i) {
+		CharString_free(&folder.entries.ptrNonConst[i].path, alloc);
+		CharString_free(&folder.entries.ptrNonConst[i].hash, alloc);
+	}
+
+	ListCLIHashEntry_free(&folder.entries, alloc);
+	return s_uccess;
+}
+
+Bool CLI_hashFile(const ParsedArgs *args) {
+
+	if(!args) return false;
+
 	CharString str = CharString_createNull();
 
 	if(!ParsedArgs_getArg(args, EOperationHasParameter_InputShift, &str, NULL))
@@ -157,10 +401,8 @@ Bool CLI_hashFile(const ParsedArgs *args) {
 	//If it's a folder, then we have to find all files in it and hash them
 	//Otherwise we just go to the file directly
 
-	if (File_hasFolder(&str, alloc)) {
-		EFormat format = args->format;        //Local non-const copy (File_foreach's userData is a void*)
-		return File_foreach(&str, false, CLI_hashAllTheFiles, &format, true, alloc, NULL);
-	}
+	if (File_hasFolder(&str, Platform_instance->alloc))
+		return CLI_hashFolder(str, args->format);
 
 	return CLI_hash(str, true, args->format, NULL);
 }
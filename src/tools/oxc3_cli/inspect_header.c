@@ -69,10 +69,10 @@ VersionString VersionCharString_get(U8 version) {
 
 void XXFile_printType(U8 type) {
 
-	//Compression is currently unsupported (only EXXCompressionType_None), so a set compression nibble is unexpected.
-
-	if (type >> 4)
-		Log_debugLnx("Compression type: Unrecognized (compression is unsupported).");
+	if (type >> 4) {
+		const C8 *typeStr = (type >> 4) == EXXCompressionType_LZ ? "LZ (64KiB blocks)" : "Unrecognized";
+		Log_debugLnx("Compression type: %s.", typeStr);
+	}
 
 	if (type & 0xF) {
 		const C8 *typeStr = (type & 0xF) == EXXEncryptionType_AES256GCM ? "AES256GCM" : "Unrecognized";
@@ -338,7 +338,7 @@ Bool CLI_inspectHeader(const ParsedArgs *args) {
 
 			XXFile_printVersion(caHeader.version);
 
-			//Type (oiCA stores only an encryption type; the archive itself isn't compressed)
+			//Type (oiCA stores only an encryption type; compression is stored by its DLFiles)
 
 			XXFile_printType(caHeader.type);
 
@@ -140,12 +140,13 @@ const C8 *EOperationFlags_names[EOperationFlags_Count] = {
 	"--verbose",
 	"--fixed",
 	"--aes-stdin",
-	"--keep-registers"
+	"--keep-registers",
+	"--fast-compress"
 };
 
 const C8 *EOperationFlags_descriptions[EOperationFlags_Count] = {
 	"Includes 256-bit hashes instead of 32-bit ones into file if applicable.",
-	"Store data uncompressed (the current default; compression is a work in progress and not supported yet).",
+	"Store data uncompressed (the default).",
 	"Indicates the input files should be treated as ASCII. If 1 file; splits by enter, otherwise 1 entry/file.",
 	"Indicates the input files should be treated as UTF8. If 1 file; splits by enter, otherwise 1 entry/file.",
 	"Includes full file timestamp (Ns)",
@@ -171,7 +172,8 @@ const C8 *EOperationFlags_descriptions[EOperationFlags_Count] = {
 	"Print full information to the console.",
 	"Emit a fixed-point value instead of a float format (float convert).",
 	"Read the 32-byte AES key (hex) from one line of stdin instead of a plaintext argument.",
-	"Keep declared but unused resources bound and reflected (stable register layouts across shader variants)."
+	"Keep declared but unused resources bound and reflected (stable register layouts across shader variants).",
+	"Compress data in independent 64KiB LZ blocks (fast to compress and decompress, can be seeked into)."
 };
 
 //Operations
@@ -236,7 +238,8 @@ void Operations_init() {
 	Format_values[EFormat_oiCA] = (Format) {
 		.name = "oiCA",
 		.desc = "Oxsomi Compressed Archive; a file table with file data.",
-		.operationFlags = EOperationFlags_Default | EOperationFlags_Date | EOperationFlags_FullDate,
+		.operationFlags =
+			EOperationFlags_Default | EOperationFlags_Date | EOperationFlags_FullDate | EOperationFlags_FastCompress,
 		.optionalParameters =
 			EOperationHasParameter_AES | EOperationHasParameter_AESFile |
 			EOperationHasParameter_Input2,
@@ -248,7 +251,8 @@ void Operations_init() {
 	Format_values[EFormat_oiDL] = (Format) {
 		.name = "oiDL",
 		.desc = "Oxsomi Data List; an indexed list of data, can be text (ASCII/UTF8) or binary data.",
-		.operationFlags = EOperationFlags_Default | EOperationFlags_Ascii | EOperationFlags_UTF8,
+		.operationFlags =
+			EOperationFlags_Default | EOperationFlags_Ascii | EOperationFlags_UTF8 | EOperationFlags_FastCompress,
 		.optionalParameters =
 			EOperationHasParameter_AES | EOperationHasParameter_AESFile |
 			EOperationHasParameter_SplitBy | EOperationHasParameter_Input2,
@@ -499,6 +503,26 @@ void Operations_init() {
 		.supportedCategories = { EOperationCategory_Hash }
 	};
 
+	Format_values[EFormat_XXH3] = (Format) {
+		.name = "XXH3",
+		.desc = "XXH3 64-bit hash (xxHash, fast non cryptographic)",
+		.operationFlags = EOperationFlags_None,
+		.optionalParameters = EOperationHasParameter_None,
+		.requiredParameters = EOperationHasParameter_Input,
+		.flags = EFormatFlags_SupportFiles | EFormatFlags_SupportFolders | EFormatFlags_SupportAsString,
+		.supportedCategories = { EOperationCategory_Hash }
+	};
+
+	Format_values[EFormat_XXH128] = (Format) {
+		.name = "XXH128",
+		.desc = "XXH3 128-bit hash (xxHash, fast non cryptographic)",
+		.operationFlags = EOperationFlags_None,
+		.optionalParameters = EOperationHasParameter_None,
+		.requiredParameters = EOperationHasParameter_Input,
+		.flags = EFormatFlags_SupportFiles | EFormatFlags_SupportFolders | EFormatFlags_SupportAsString,
+		.supportedCategories = { EOperationCategory_Hash }
+	};
+
 	Format_values[EFormat_SHA256] = (Format) {
 		.name = "SHA256",
 		.desc = "SHA256 (256-bit hash)",
@@ -898,6 +922,19 @@ void Operations_init() {
 		.isFormatLess = true
 	};
 
+	Operation_values[EOperation_ProfileXXH3] = (Operation) {
+
+		.category = EOperationCategory_Profile,
+
+		.name = "xxh3",
+		.desc = "Profiles hashing random data using xxh3 (64 and 128-bit).",
+
+		.func = &CLI_profileXXH3,
+
+		.optionalParameters = EOperationHasParameter_ThreadCount | EOperationHasParameter_Length,
+		.isFormatLess = true
+	};
+
 	Operation_values[EOperation_ProfileSHA256] = (Operation) {
 
 		.category = EOperationCategory_Profile,
@@ -377,11 +377,11 @@ Bool CLI_profileFNV1A64Impl(const ParsedArgs *args, Buffer buf, Error *e_rr) {
 	(void) e_rr;
 
 	const Ns then = Time_now();
-	const U32 hash = Buffer_crc32c(buf);
+	const U64 hash = Buffer_fnv1a64(buf, Buffer_fnv1a64Offset);
 	const Ns now = Time_now();
 
 	Log_debugLnx(
-		"Profile FNV1a64: %"PRIu64" bytes within %fs (%fns/byte, %fbytes/sec). Random hash %u.",
+		"Profile FNV1a64: %"PRIu64" bytes within %fs (%fns/byte, %fbytes/sec). Random hash %016"PRIX64".",
 		Buffer_length(buf),
 		(F64)(now - then) / SECOND,
 		(F64)(now - then) / Buffer_length(buf),
@@ -397,6 +397,43 @@ Bool CLI_profileFNV1A64(const ParsedArgs *args) {
 	return CLI_profileData(args, CLI_profileFNV1A64Impl);
 }
 
+Bool CLI_profileXXH3Impl(const ParsedArgs *args, Buffer buf, Error *e_rr) {
+
+	(void)args;
+	(void) e_rr;
+
+	const Ns then = Time_now();
+	const U64 hash = Buffer_hash64(buf, 0);
+	const Ns mid = Time_now();
+	const Hash128 hash128 = Buffer_hash128(buf, 0);
+	const Ns now = Time_now();
+
+	Log_debugLnx(
+		"Profile XXH3: %"PRIu64" bytes within %fs (%fns/byte, %fbytes/sec). Random hash %016"PRIX64".",
+		Buffer_length(buf),
+		(F64)(mid - then) / SECOND,
+		(F64)(mid - then) / Buffer_length(buf),
+		(F64)Buffer_length(buf) / (mid - then) * SECOND,
+		hash
+	);
+
+	Log_debugLnx(
+		"Profile XXH128: %"PRIu64" bytes within %fs (%fns/byte, %fbytes/sec). Random hash %016"PRIX64"%016"PRIX64".",
+		Buffer_length(buf),
+		(F64)(now - mid) / SECOND,
+		(F64)(now - mid) / Buffer_length(buf),
+		(F64)Buffer_length(buf) / (now - mid) * SECOND,
+		hash128.hi, hash128.lo
+	);
+
+	return true;
+}
+
+Bool CLI_profileXXH3(const ParsedArgs *args) {
+	if(!args) return false;
+	return CLI_profileData(args, CLI_profileXXH3Impl);
+}
+
 Bool CLI_profileSHA256Impl(const ParsedArgs *args, Buffer buf, Error *e_rr) {
 
 	(void)args;
@@ -658,8 +695,8 @@ Bool CLI_profileAll(const ParsedArgs *args) {
 	if(!args) return false;
 
 	const OperationFunc all[] = {
-		CLI_profileCast, CLI_profileRNG, CLI_profileCRC32C, CLI_profileFNV1A64, CLI_profileSHA256, CLI_profileMD5,
-		CLI_profileAES256, CLI_profileAES128, CLI_profileMemcpy, CLI_profileMemset, CLI_profileVec
+		CLI_profileCast, CLI_profileRNG, CLI_profileCRC32C, CLI_profileFNV1A64, CLI_profileXXH3, CLI_profileSHA256,
+		CLI_profileMD5, CLI_profileAES256, CLI_profileAES128, CLI_profileMemcpy, CLI_profileMemset, CLI_profileVec
 	};
 
 	Bool s_uccess = true;
@@ -105,3 +105,171 @@ ELockAcquire SpinLock_lock(SpinLock *l, Ns maxTime) {
 
 	return ELockAcquire_Invalid;
 }
+
+//Called when the lock was busy (word was state): spins SHORT_SPIN times, then parks until the word changes.
+//parkedBit is set before parking, that's how the thread releasing the lock knows it has to wake someone.
+//Returns false once maxTime passed.
+
+static Bool Lock_wait(AtomicI64 *word, I64 state, I64 parkedBit, U64 *spins, Ns startTime, Ns maxTime) {
+
+	Ns timeout = U64_MAX;
+
+	if (maxTime != U64_MAX) {
+
+		const Ns elapsed = Time_now() - startTime;
+
+		if(elapsed >= maxTime)
+			return false;
+
+		timeout = maxTime - elapsed;
+	}
+
+	if (*spins < SHORT_SPIN) {
+		++*spins;
+		CPU_PAUSE();
+		return true;
+	}
+
+	if (!(state & parkedBit)) {
+
+		if(AtomicI64_cmpStore(word, state, state | parkedBit) != state)
+			return true;
+
+		state |= parkedBit;
+	}
+
+	Lock_park(word, state, timeout);
+	return true;
+}
+
+//Mutex
+
+ELockAcquire Mutex_lock(Mutex *l, Ns maxTime) {
+
+	if(!l)
+		return ELockAcquire_Invalid;
+
+	const Ns startTime = maxTime == U64_MAX ? 0 : Time_now();
+	const I64 owner = (I64)(Thread_getId() << 1);
+
+	I64 state = AtomicI64_cmpStore(&l->state, 0, owner);
+
+	if(!state)
+		return ELockAcquire_Acquired;
+
+	if((state &~ (I64)1) == owner)
+		return ELockAcquire_AlreadyLocked;
+
+	U64 spins = 0;
+
+	while (true) {
+
+		if (!state) {
+
+			//Once we might have parked, there's no telling whether others are still parked.
+			//So it's taken as contended, at worst unlock wakes a thread that doesn't exist.
+
+			const I64 acquired = spins < SHORT_SPIN ? owner : owner | 1;
+
+			if(!AtomicI64_cmpStore(&l->state, 0, acquired))
+				return ELockAcquire_Acquired;
+		}
+
+		else if (!Lock_wait(&l->state, state, 1, &spins, startTime, maxTime)) {
+
+			//The wake of the unlock may have been meant for us, pass it on so the others don't keep sleeping
+
+			if(spins >= SHORT_SPIN)
+				Lock_wake(&l->state, false);
+
+			return ELockAcquire_TimedOut;
+		}
+
+		state = AtomicI64_load(&l->state);
+	}
+}
+
+//RWLock
+
+ELockAcquire RWLock_lockRead(RWLock *l, Ns maxTime) {
+
+	if(!l)
+		return ELockAcquire_Invalid;
+
+	if(RWLock_isWriteLockedForThread(l))
+		return ELockAcquire_AlreadyLocked;
+
+	const Ns startTime = maxTime == U64_MAX ? 0 : Time_now();
+	U64 spins = 0;
+
+	while (true) {
+
+		const I64 state = AtomicI64_load(&l->state);
+
+		if (!(state & RWLock_writer)) {
+
+			if((state & RWLock_readerMask) == RWLock_readerMask)
+				return ELockAcquire_Invalid;
+
+			if(AtomicI64_cmpStore(&l->state, state, state + 1) == state)
+				return ELockAcquire_Acquired;
+		}
+
+		else if(!Lock_wait(&l->state, state, RWLock_parked, &spins, startTime, maxTime))
+			return ELockAcquire_TimedOut;
+	}
+}
+
+void RWLock_releaseWriter(RWLock *l) {
+
+	const I64 prev = AtomicI64_and(&l->state, ~(RWLock_writer | RWLock_parked));
+
+	if(prev & RWLock_parked)
+		Lock_wake(&l->state, true);
+}
+
+ELockAcquire RWLock_lockWrite(RWLock *l, Ns maxTime) {
+
+	if(!l)
+		return ELockAcquire_Invalid;
+
+	if(RWLock_isWriteLockedForThread(l))
+		return ELockAcquire_AlreadyLocked;
+
+	const Ns startTime = maxTime == U64_MAX ? 0 : Time_now();
+	U64 spins = 0;
+
+	//Claim the writer bit, from then on no new reader gets in
+
+	while (true) {
+
+		const I64 state = AtomicI64_load(&l->state);
+
+		if (!(state & RWLock_writer)) {
+
+			if(AtomicI64_cmpStore(&l->state, state, state | RWLock_writer) == state)
+				break;
+		}
+
+		else if(!Lock_wait(&l->state, state, RWLock_parked, &spins, startTime, maxTime))
+			return ELockAcquire_TimedOut;
+	}
+
+	//Wait for the readers that were already in
+
+	while (true) {
+
+		const I64 state = AtomicI64_load(&l->state);
+
+		if(!(state & RWLock_readerMask))
+			break;
+
+		if (!Lock_wait(&l->state, state, RWLock_parked, &spins, startTime, maxTime)) {
+			RWLock_releaseWriter(l);
+			return ELockAcquire_TimedOut;
+		}
+	}
+
+	AtomicI64_store(&l->writerThreadId, (I64) Thread_getId());
+	return ELockAcquire_Acquired;
+}
@@ -0,0 +1,119 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/platforms/unix/ulock.c
+
+#include "types/base/lock.h"
+#include "types/base/platform_types.h"
+
+#if _PLATFORM_TYPE == PLATFORM_LINUX || _PLATFORM_TYPE == PLATFORM_ANDROID
+
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#include <time.h>
+
+	void Lock_park(AtomicI64 *word, I64 expected, Ns maxTime) {
+
+		const struct timespec time = { (time_t)(maxTime / SECOND), (long)(maxTime % SECOND) };
+
+		syscall(
+			SYS_futex, (volatile U32*) &word->atomic, FUTEX_WAIT_PRIVATE, (U32) expected,
+			maxTime == U64_MAX ? NULL : &time, NULL, 0
+		);
+	}
+
+	void Lock_wake(AtomicI64 *word, Bool all) {
+		syscall(SYS_futex, (volatile U32*) &word->atomic, FUTEX_WAKE_PRIVATE, all ? I32_MAX : 1, NULL, NULL, 0);
+	}
+
+#else
+
+	//os_sync_wait_on_address only exists since macOS 14.4 and the web doesn't have a futex either.
+	//So parking goes through a parking lot instead: a mutex + condition variable per bucket, picked by address.
+	//The word is checked again under the bucket's mutex and Lock_wake takes that mutex after the word changed,
+	// so a wake can't slip in between the check and the wait.
+
+	#include <pthread.h>
+	#include <time.h>
+
+	#define Lock_parkingBuckets 64
+
+	typedef struct LockParkingBucket {
+		pthread_mutex_t mutex;
+		pthread_cond_t cond;
+	} LockParkingBucket;
+
+	static LockParkingBucket Lock_parkingLot[Lock_parkingBuckets];
+	static pthread_once_t Lock_parkingLotOnce = PTHREAD_ONCE_INIT;
+
+	static void Lock_initParkingLot() {
+		for (U64 i = 0; i < Lock_parkingBuckets; ++i) {
+			pthread_mutex_init(&Lock_parkingLot[i].mutex, NULL);
+			pthread_cond_init(&Lock_parkingLot[i].cond, NULL);
+		}
+	}
+
+	//Hashed, because most words are 64 byte aligned and would otherwise end up in the same few buckets
+
+	static LockParkingBucket *Lock_getParkingBucket(AtomicI64 *word) {
+		pthread_once(&Lock_parkingLotOnce, Lock_initParkingLot);
+		return &Lock_parkingLot[((U64)(uintptr_t) word * 0x9E3779B97F4A7C15) >> 58];
+	}
+
+	void Lock_park(AtomicI64 *word, I64 expected, Ns maxTime) {
+
+		LockParkingBucket *bucket = Lock_getParkingBucket(word);
+		pthread_mutex_lock(&bucket->mutex);
+
+		if (AtomicI64_load(word) == expected) {
+
+			if(maxTime > (Ns) I64_MAX)
+				pthread_cond_wait(&bucket->cond, &bucket->mutex);
+
+			else {
+
+				struct timespec time;
+				clock_gettime(CLOCK_REALTIME, &time);
+
+				const Ns end = (Ns) time.tv_nsec + maxTime;
+				time.tv_sec += (time_t)(end / SECOND);
+				time.tv_nsec = (long)(end % SECOND);
+
+				pthread_cond_timedwait(&bucket->cond, &bucket->mutex, &time);
+			}
+		}
+
+		pthread_mutex_unlock(&bucket->mutex);
+	}
+
+	//Other words can share the bucket, so all of them are woken and the wrong ones park again
+
+	void Lock_wake(AtomicI64 *word, Bool all) {
+
+		(void) all;
+
+		LockParkingBucket *bucket = Lock_getParkingBucket(word);
+		pthread_mutex_lock(&bucket->mutex);
+		pthread_cond_broadcast(&bucket->cond);
+		pthread_mutex_unlock(&bucket->mutex);
+	}
+
+#endif
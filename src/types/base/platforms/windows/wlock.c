@@ -0,0 +1,46 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/platforms/windows/wlock.c
+
+#include "types/base/lock.h"
+#include "types/base/mathi.h"
+
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+void Lock_park(AtomicI64 *word, I64 expected, Ns maxTime) {
+
+	DWORD ms = INFINITE;
+
+	if(maxTime != U64_MAX)
+		ms = (DWORD) U64_min((maxTime + MS - 1) / MS, INFINITE - 1);
+
+	WaitOnAddress((volatile VOID*) &word->atomic, &expected, sizeof(expected), ms);
+}
+
+void Lock_wake(AtomicI64 *word, Bool all) {
+
+	if(all)
+		WakeByAddressAll((PVOID) &word->atomic);
+
+	else WakeByAddressSingle((PVOID) &word->atomic);
+}
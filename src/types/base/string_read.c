@@ -21,6 +21,7 @@
 //types/base/string_read.c
 
 #include "types/base/string_read_helper.h"
+#include "types/base/string_search.h"
 #include "types/base/algorithm.h"
 #include "types/base/mathi.h"
 #include "types/base/mathf.h"
@@ -322,19 +323,14 @@ U64 CharString_countAll(const CharStringSensOff *strSensOff, C8 c) {
 	if (!strSensOff || !strSensOff->str)
 		return 0;
 
-	const C8 *sPtr = strSensOff->str->ptr;
+	const U64 off = strSensOff->off;
 	const U64 slen = CharString_length(*strSensOff->str);
-	const EStringTransform transform = (EStringTransform)strSensOff->caseSensitive;
-
-	c = C8_transform(c, transform);
 
-	U64 count = 0;
-
-	for (U64 i = strSensOff->off; i < slen; ++i)
-		if (C8_transform(sPtr[i], transform) == c)
-			++count;
+	if(off >= slen)
+		return 0;
 
-	return count;
+	const Bool insensitive = strSensOff->caseSensitive == EStringCase_Insensitive;
+	return StringSearch_countByte(strSensOff->str->ptr + off, slen - off, c, insensitive);
 }
 
 U64 CharString_countAllString(const CharStringSensOff *strSensOff, const CharString *other) {
@@ -343,35 +339,14 @@ U64 CharString_countAllString(const CharStringSensOff *strSensOff, const CharStr
 		return 0;
 
 	const U64 off = strSensOff->off;
-	const EStringTransform transform = (EStringTransform)strSensOff->caseSensitive;
-
-	const C8 *sPtr = strSensOff->str->ptr;
 	const U64 strl = CharString_length(*strSensOff->str);
-
 	const U64 otherl = CharString_length(*other);
 
-	if(!otherl || strl < otherl)
+	if(!otherl || strl < otherl || off >= strl)
 		return 0;
 
-	U64 j = 0;
-
-	for (U64 i = off; i < strl - otherl + 1; ++i) {
-
-		Bool match = true;
-
-		for (U64 l = i, k = 0; l < strl && k < otherl; ++l, ++k)
-			if (C8_transform(sPtr[l], transform) != C8_transform(other->ptr[k], transform)) {
-				match = false;
-				break;
-			}
-
-		if (match) {
-			i += otherl - 1;
-			++j;
-		}
-	}
-
-	return j;
+	const Bool insensitive = strSensOff->caseSensitive == EStringCase_Insensitive;
+	return StringSearch_countString(strSensOff->str->ptr + off, strl - off, other->ptr, otherl, insensitive);
 }
 
 U64 CharString_findFirst(const CharStringSensOffLen *strSensOffLen, C8 c) {
@@ -381,51 +356,39 @@ U64 CharString_findFirst(const CharStringSensOffLen *strSensOffLen, C8 c) {
 
 	const U64 off = strSensOffLen->off;
 	U64 len = strSensOffLen->len;
-	const EStringTransform transform = (EStringTransform) strSensOffLen->caseSensitive;
 
-	const C8 *sPtr = strSensOffLen->str->ptr;
 	const U64 strl = CharString_length(*strSensOffLen->str);
 
-	c = C8_transform(c, transform);
-
 	if(off >= strl || off + len > strl)
 		return U64_MAX;
 
 	if(!len)
 		len = strl - off;
 
-	for (U64 i = off; i < off + len; ++i)
-		if (C8_transform(sPtr[i], transform) == c)
-			return i;
-
-	return U64_MAX;
+	const Bool insensitive = strSensOffLen->caseSensitive == EStringCase_Insensitive;
+	const U64 i = StringSearch_findByte(strSensOffLen->str->ptr + off, len, c, insensitive);
+	return i == U64_MAX ? U64_MAX : off + i;
 }
 
 U64 CharString_findLast(const CharStringSensOffLen *strSensOffLen, C8 c) {
-	
+
 	if (!strSensOffLen || !strSensOffLen->str)
 		return U64_MAX;
 
 	const U64 off = strSensOffLen->off;
 	U64 len = strSensOffLen->len;
-	const EStringTransform transform = (EStringTransform) strSensOffLen->caseSensitive;
 
-	const C8 *sPtr = strSensOffLen->str->ptr;
 	const U64 strl = CharString_length(*strSensOffLen->str);
 
-	c = C8_transform(c, transform);
-
 	if(off >= strl || off + len > strl)
 		return U64_MAX;
 
 	if(!len)
 		len = strl - off;
 
-	for (U64 i = (off + len) - 1; i != U64_MAX && i >= off; --i)
-		if (C8_transform(sPtr[i], transform) == c)
-			return i;
-
-	return U64_MAX;
+	const Bool insensitive = strSensOffLen->caseSensitive == EStringCase_Insensitive;
+	const U64 i = StringSearch_findLastByte(strSensOffLen->str->ptr + off, len, c, insensitive);
+	return i == U64_MAX ? U64_MAX : off + i;
 }
 
 U64 CharString_findFirstString(const CharStringSensOffLen *strSensOffLen, const CharString *other) {
@@ -435,9 +398,6 @@ U64 CharString_findFirstString(const CharStringSensOffLen *strSensOffLen, const
 
 	const U64 off = strSensOffLen->off;
 	const U64 len = strSensOffLen->len;
-	const EStringTransform transform = (EStringTransform) strSensOffLen->caseSensitive;
-
-	const C8 *sPtr = strSensOffLen->str->ptr;
 
 	const U64 otherl = CharString_length(*other);
 	U64 strl = CharString_length(*strSensOffLen->str);
@@ -451,24 +411,9 @@ U64 CharString_findFirstString(const CharStringSensOffLen *strSensOffLen, const
 	if(len)
 		strl = off + len;
 
-	U64 i = off;
-
-	for (; i < strl; ++i) {
-
-		Bool match = true;
-		U64 k = 0;
-
-		for (U64 j = i; j < strl && k < otherl; ++j, ++k)
-			if (C8_transform(sPtr[j], transform) != C8_transform(other->ptr[k], transform)) {
-				match = false;
-				break;
-			}
-
-		if (match && k == otherl)
-			break;
-	}
-
-	return i >= strl ? U64_MAX : i;
+	const Bool insensitive = strSensOffLen->caseSensitive == EStringCase_Insensitive;
+	const U64 i = StringSearch_findString(strSensOffLen->str->ptr + off, strl - off, other->ptr, otherl, insensitive);
+	return i == U64_MAX ? U64_MAX : off + i;
 }
 
 U64 CharString_findLastString(const CharStringSensOffLen *strSensOffLen, const CharString *other) {
@@ -0,0 +1,218 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/string_search.c
+
+#include "types/base/string_search.h"
+#include "types/base/platform_types.h"
+
+#if _SIMD == SIMD_SSE
+	#define STRING_SEARCH_SSE_GUARD
+	#include "types/base/simd/sse/sse_string_search.inc.h"
+#elif _SIMD == SIMD_NEON
+	#define STRING_SEARCH_NEON_GUARD
+	#include "types/base/simd/neon/neon_string_search.inc.h"
+#else
+	#define STRING_SEARCH_NONE_GUARD
+	#include "types/base/simd/none/none_string_search.inc.h"
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#include <intrin.h>
+#endif
+
+static const U64 StringSearch_blockSize = 64;
+
+static inline U64 StringSearch_first(U64 mask) {
+	#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index = 0;
+		_BitScanForward64(&index, mask);
+		return index;
+	#else
+		return (U64) __builtin_ctzll(mask);
+	#endif
+}
+
+static inline U64 StringSearch_last(U64 mask) {
+	#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index = 0;
+		_BitScanReverse64(&index, mask);
+		return index;
+	#else
+		return 63 - (U64) __builtin_clzll(mask);
+	#endif
+}
+
+static inline U64 StringSearch_bitCount(U64 mask) {
+	mask = mask - ((mask >> 1) & 0x5555555555555555);
+	mask = (mask & 0x3333333333333333) + ((mask >> 2) & 0x3333333333333333);
+	mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0F;
+	return (mask * 0x0101010101010101) >> 56;
+}
+
+//Both cases of c if insensitive, so the block compare stays exact
+
+static inline C8 StringSearch_caseA(C8 c, Bool insensitive) { return insensitive ? C8_toLower(c) : c; }
+static inline C8 StringSearch_caseB(C8 c, Bool insensitive) { return insensitive ? C8_toUpper(c) : c; }
+
+static inline Bool StringSearch_equals(const C8 *a, const C8 *b, U64 len, Bool insensitive) {
+
+	if (!insensitive) {
+
+		for(U64 i = 0; i < len; ++i)
+			if(a[i] != b[i])
+				return false;
+
+		return true;
+	}
+
+	for(U64 i = 0; i < len; ++i)
+		if(C8_toLower(a[i]) != C8_toLower(b[i]))
+			return false;
+
+	return true;
+}
+
+U64 StringSearch_findEither(const C8 *ptr, U64 len, C8 a, C8 b) {
+
+	if(!ptr)
+		return U64_MAX;
+
+	U64 i = 0;
+
+	for (; i + StringSearch_blockSize <= len; i += StringSearch_blockSize) {
+
+		const U64 mask = StringSearch_block(ptr + i, a, b);
+
+		if(mask)
+			return i + StringSearch_first(mask);
+	}
+
+	for(; i < len; ++i)
+		if(ptr[i] == a || ptr[i] == b)
+			return i;
+
+	return U64_MAX;
+}
+
+U64 StringSearch_findByte(const C8 *ptr, U64 len, C8 c, Bool insensitive) {
+	return StringSearch_findEither(ptr, len, StringSearch_caseA(c, insensitive), StringSearch_caseB(c, insensitive));
+}
+
+U64 StringSearch_findLastByte(const C8 *ptr, U64 len, C8 c, Bool insensitive) {
+
+	if(!ptr)
+		return U64_MAX;
+
+	const C8 a = StringSearch_caseA(c, insensitive);
+	const C8 b = StringSearch_caseB(c, insensitive);
+
+	U64 i = len;
+
+	for (; i >= StringSearch_blockSize; i -= StringSearch_blockSize) {
+
+		const U64 mask = StringSearch_block(ptr + i - StringSearch_blockSize, a, b);
+
+		if(mask)
+			return i - StringSearch_blockSize + StringSearch_last(mask);
+	}
+
+	while(i--)
+		if(ptr[i] == a || ptr[i] == b)
+			return i;
+
+	return U64_MAX;
+}
+
+U64 StringSearch_countByte(const C8 *ptr, U64 len, C8 c, Bool insensitive) {
+
+	if(!ptr)
+		return 0;
+
+	const C8 a = StringSearch_caseA(c, insensitive);
+	const C8 b = StringSearch_caseB(c, insensitive);
+
+	U64 count = 0, i = 0;
+
+	for (; i + StringSearch_blockSize <= len; i += StringSearch_blockSize)
+		count += StringSearch_bitCount(StringSearch_block(ptr + i, a, b));
+
+	for(; i < len; ++i)
+		count += ptr[i] == a || ptr[i] == b;
+
+	return count;
+}
+
+U64 StringSearch_findString(const C8 *ptr, U64 len, const C8 *needle, U64 needleLen, Bool insensitive) {
+
+	if(!ptr || !needle || !needleLen || needleLen > len)
+		return U64_MAX;
+
+	if(needleLen == 1)
+		return StringSearch_findByte(ptr, len, needle[0], insensitive);
+
+	const C8 firstA = StringSearch_caseA(needle[0], insensitive);
+	const C8 firstB = StringSearch_caseB(needle[0], insensitive);
+	const C8 lastA = StringSearch_caseA(needle[needleLen - 1], insensitive);
+	const C8 lastB = StringSearch_caseB(needle[needleLen - 1], insensitive);
+
+	const U64 starts = len - needleLen + 1;        //Every i < starts is a possible match
+	U64 i = 0;
+
+	//The block of last bytes ends at most at i + needleLen - 1 + 63 < len, so no block reads past the string
+
+	for (; i + StringSearch_blockSize <= starts; i += StringSearch_blockSize) {
+
+		U64 mask =
+			StringSearch_block(ptr + i, firstA, firstB) &
+			StringSearch_block(ptr + i + needleLen - 1, lastA, lastB);
+
+		for (; mask; mask &= mask - 1) {
+
+			const U64 j = i + StringSearch_first(mask);
+
+			if(StringSearch_equals(ptr + j + 1, needle + 1, needleLen - 2, insensitive))
+				return j;
+		}
+	}
+
+	for(; i < starts; ++i)
+		if(StringSearch_equals(ptr + i, needle, needleLen, insensitive))
+			return i;
+
+	return U64_MAX;
+}
+
+U64 StringSearch_countString(const C8 *ptr, U64 len, const C8 *needle, U64 needleLen, Bool insensitive) {
+
+	U64 count = 0;
+
+	for (U64 i = 0; i < len; ++count) {
+
+		const U64 found = StringSearch_findString(ptr + i, len - i, needle, needleLen, insensitive);
+
+		if(found == U64_MAX)
+			break;
+
+		i += found + needleLen;
+	}
+
+	return count;
+}
@@ -0,0 +1,311 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/base/unicode.c
+
+#include "types/base/unicode.h"
+#include "types/base/platform_types.h"
+
+static inline U64 Unicode_bitCount(U64 mask) {
+	mask = mask - ((mask >> 1) & 0x5555555555555555);
+	mask = (mask & 0x3333333333333333) + ((mask >> 2) & 0x3333333333333333);
+	mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0F;
+	return (mask * 0x0101010101010101) >> 56;
+}
+
+#if _SIMD == SIMD_SSE
+	#define UNICODE_SSE_GUARD
+	#include "types/base/simd/sse/sse_unicode.inc.h"
+#elif _SIMD == SIMD_NEON
+	#define UNICODE_NEON_GUARD
+	#include "types/base/simd/neon/neon_unicode.inc.h"
+#else
+	#define UNICODE_NONE_GUARD
+	#include "types/base/simd/none/none_unicode.inc.h"
+#endif
+
+//Bytes of the UTF-8 sequence lead starts, 0 if it can't start one (continuation, overlong C0/C1 or too large F5+)
+
+static inline U8 Unicode_sequenceLength(U8 lead) {
+	return lead < 0x80 ? 1 : (lead < 0xC2 ? 0 : (lead < 0xE0 ? 2 : (lead < 0xF0 ? 3 : (lead < 0xF5 ? 4 : 0))));
+}
+
+//Length of the valid code point at ptr[0, len) or 0 if it isn't one
+
+static inline U8 Unicode_checkCodepointUTF8(const U8 *ptr, U64 len) {
+
+	const U8 v0 = ptr[0];
+
+	if(v0 < 0x80)
+		return C8_isValidAscii((C8) v0) ? 1 : 0;
+
+	const U8 n = Unicode_sequenceLength(v0);
+
+	if(!n || n > len)
+		return 0;
+
+	//E0, ED, F0 and F4 allow fewer second bytes: below that is overlong, above is a surrogate or above 0x10FFFF
+
+	const U8 lo = v0 == 0xE0 ? 0xA0 : (v0 == 0xF0 ? 0x90 : 0x80);
+	const U8 hi = v0 == 0xED ? 0x9F : (v0 == 0xF4 ? 0x8F : 0xBF);
+
+	if(ptr[1] < lo || ptr[1] > hi)
+		return 0;
+
+	for(U8 i = 2; i < n; ++i)
+		if((ptr[i] & 0xC0) != 0x80)
+			return 0;
+
+	return n;
+}
+
+//Only for validated input
+
+static inline U8 Unicode_decodeUTF8(const U8 *ptr, U32 *c) {
+
+	const U8 v0 = ptr[0];
+
+	if (v0 < 0x80) {
+		*c = v0;
+		return 1;
+	}
+
+	if (v0 < 0xE0) {
+		*c = ((U32)(v0 & 0x1F) << 6) | (ptr[1] & 0x3F);
+		return 2;
+	}
+
+	if (v0 < 0xF0) {
+		*c = ((U32)(v0 & 0xF) << 12) | ((U32)(ptr[1] & 0x3F) << 6) | (ptr[2] & 0x3F);
+		return 3;
+	}
+
+	*c = ((U32)(v0 & 0x7) << 18) | ((U32)(ptr[1] & 0x3F) << 12) | ((U32)(ptr[2] & 0x3F) << 6) | (ptr[3] & 0x3F);
+	return 4;
+}
+
+Bool Unicode_validateUTF8(const U8 *ptr, U64 len, UnicodeLengths *lengths) {
+
+	if(!ptr)
+		return !len;
+
+	U64 continuations = 0, fourByte = 0;
+	U64 i = Unicode_validateBlocksUTF8(ptr, len, &continuations, &fourByte);
+
+	if(i == U64_MAX)
+		return false;
+
+	U64 codepoints = i - continuations;
+
+	//The blocks don't look past their end, so a sequence that isn't finished there is checked again from its lead
+
+	for (U64 k = 1; k <= 3 && k <= i; ++k) {
+
+		const U8 c = ptr[i - k];
+
+		if((c & 0xC0) == 0x80)
+			continue;
+
+		if (Unicode_sequenceLength(c) > k) {
+			i -= k;
+			--codepoints;
+			fourByte -= c >= 0xF0;
+		}
+
+		break;
+	}
+
+	while (i < len) {
+
+		const U8 n = Unicode_checkCodepointUTF8(ptr + i, len - i);
+
+		if(!n)
+			return false;
+
+		i += n;
+		++codepoints;
+		fourByte += n == 4;
+	}
+
+	if(lengths)
+		*lengths = (UnicodeLengths) { .codepoints = codepoints, .utf8 = len, .utf16 = codepoints + fourByte };
+
+	return true;
+}
+
+Bool Unicode_validateUTF16(const U16 *ptr, U64 len, UnicodeLengths *lengths) {
+
+	if(!ptr)
+		return !len;
+
+	U64 i = 0, utf8 = 0, codepoints = 0;
+
+	while (i < len) {
+
+		if (i + 16 <= len) {
+
+			const U64 bytes = Unicode_utf16Block(ptr + i);
+
+			if (bytes) {
+				utf8 += bytes;
+				codepoints += 16;
+				i += 16;
+				continue;
+			}
+		}
+
+		//One unit at a time until the end of this block, then try the fast path again
+
+		const U64 end = i + 16 < len ? i + 16 : len;
+
+		while (i < end) {
+
+			const U16 v0 = ptr[i++];
+			++codepoints;
+
+			if (v0 < 0x80) {
+
+				if(!C8_isValidAscii((C8) v0))
+					return false;
+
+				++utf8;
+			}
+
+			else if(v0 < 0x800)
+				utf8 += 2;
+
+			else if((v0 & 0xF800) != 0xD800)
+				utf8 += 3;
+
+			//Surrogate pair, which has to be high then low
+
+			else {
+
+				if(v0 >= 0xDC00 || i >= len || (ptr[i] & 0xFC00) != 0xDC00)
+					return false;
+
+				++i;
+				utf8 += 4;
+			}
+		}
+	}
+
+	if(lengths)
+		*lengths = (UnicodeLengths) { .codepoints = codepoints, .utf8 = utf8, .utf16 = len };
+
+	return true;
+}
+
+void Unicode_utf8ToUTF16(const U8 *ptr, U64 len, U16 *out) {
+
+	U64 i = 0, j = 0;
+
+	while (i < len) {
+
+		if (i + 16 <= len && Unicode_isAscii16(ptr + i)) {
+			Unicode_widen16(ptr + i, out + j);
+			i += 16;
+			j += 16;
+			continue;
+		}
+
+		const U64 end = i + 16 < len ? i + 16 : len;
+
+		while (i < end) {
+
+			U32 c = 0;
+			i += Unicode_decodeUTF8(ptr + i, &c);
+
+			if (c < 0x10000) {
+				out[j++] = (U16) c;
+				continue;
+			}
+
+			c -= 0x10000;
+			out[j++] = (U16)(0xD800 | (c >> 10));
+			out[j++] = (U16)(0xDC00 | (c & 0x3FF));
+		}
+	}
+}
+
+void Unicode_utf8ToUTF32(const U8 *ptr, U64 len, U32 *out) {
+
+	U64 i = 0, j = 0;
+
+	while (i < len) {
+
+		if (i + 16 <= len && Unicode_isAscii16(ptr + i)) {
+			Unicode_widen32(ptr + i, out + j);
+			i += 16;
+			j += 16;
+			continue;
+		}
+
+		const U64 end = i + 16 < len ? i + 16 : len;
+
+		while(i < end)
+			i += Unicode_decodeUTF8(ptr + i, &out[j++]);
+	}
+}
+
+void Unicode_utf16ToUTF8(const U16 *ptr, U64 len, U8 *out) {
+
+	U64 i = 0, j = 0;
+
+	while (i < len) {
+
+		if (i + 16 <= len && Unicode_narrow16(ptr + i, out + j)) {
+			i += 16;
+			j += 16;
+			continue;
+		}
+
+		const U64 end = i + 16 < len ? i + 16 : len;
+
+		while (i < end) {
+
+			U32 c = ptr[i++];
+
+			if((c & 0xFC00) == 0xD800)
+				c = 0x10000 + ((c - 0xD800) << 10) + (ptr[i++] - 0xDC00);
+
+			if (c < 0x80)
+				out[j++] = (U8) c;
+
+			else if (c < 0x800) {
+				out[j++] = (U8)(0xC0 | (c >> 6));
+				out[j++] = (U8)(0x80 | (c & 0x3F));
+			}
+
+			else if (c < 0x10000) {
+				out[j++] = (U8)(0xE0 | (c >> 12));
+				out[j++] = (U8)(0x80 | ((c >> 6) & 0x3F));
+				out[j++] = (U8)(0x80 | (c & 0x3F));
+			}
+
+			else {
+				out[j++] = (U8)(0xF0 | (c >> 18));
+				out[j++] = (U8)(0x80 | ((c >> 12) & 0x3F));
+				out[j++] = (U8)(0x80 | ((c >> 6) & 0x3F));
+				out[j++] = (U8)(0x80 | (c & 0x3F));
+			}
+		}
+	}
+}
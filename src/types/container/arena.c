@@ -0,0 +1,357 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/arena.c
+
+#include "types/container/arena.h"
+#include "types/container/buffer.h"
+#include "types/container/log.h"
+#include "types/container/list_basic_types.h"
+#include "types/base/constants.h"
+
+//Chunk header, the data starts right after it (at BUFFER_DEFAULT_ALIGNMENT like any other allocation)
+
+struct ArenaChunk {
+	ArenaChunk *prev;
+	U64 capacity, used;
+	U64 padding;
+};
+
+static U64 Arena_alignUp(U64 v) { return (v + BUFFER_DEFAULT_ALIGNMENT - 1) &~ (U64)(BUFFER_DEFAULT_ALIGNMENT - 1); }
+static U8 *ArenaChunk_data(ArenaChunk *chunk) { return (U8*)(chunk + 1); }
+static U64 ArenaChunk_bytes(const ArenaChunk *chunk) { return sizeof(ArenaChunk) + chunk->capacity; }
+
+static void Arena_releaseChunk(Arena *arena, ArenaChunk *chunk) {
+	Buffer buf = Buffer_createManagedPtr(chunk, ArenaChunk_bytes(chunk));
+	Buffer_free(&buf, arena->parent);
+}
+
+static Bool Arena_newChunk(Arena *arena, U64 length, ArenaChunk **result, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Buffer buf = Buffer_createNull();
+
+	const U64 capacity = length > arena->chunkSize ? length : arena->chunkSize;
+
+	//Reuse the spare if it fits, otherwise it's in the way
+
+	if (arena->spare && arena->spare->capacity >= capacity) {
+		*result = arena->spare;
+		arena->spare = NULL;
+		(*result)->prev = NULL;
+		(*result)->used = 0;
+		goto clean;
+	}
+
+	if (arena->maxSize && (capacity > arena->maxSize || arena->reserved > arena->maxSize - capacity))
+		retError(clean, Error_outOfMemory(0, "Arena_newChunk() arena reached its maxSize"));
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(sizeof(ArenaChunk) + capacity, arena->parent, &buf, e_rr));
+
+	if (arena->spare) {
+		Arena_releaseChunk(arena, arena->spare);
+		arena->spare = NULL;
+	}
+
+	*result = (ArenaChunk*) buf.ptrNonConst;
+	**result = (ArenaChunk) { .capacity = capacity };
+
+clean:
+	if(s_uccess && *result)
+		arena->reserved += ArenaChunk_bytes(*result);
+
+	return s_uccess;
+}
+
+static Bool Arena_alloc(void *allocator, U64 length, Buffer *output, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Arena *arena = (Arena*) allocator;
+	ArenaChunk *chunk = NULL;
+	U8 *ptr = NULL;
+	Error tmp = Error_none();
+
+	if(!arena || !output)
+		retError(clean, Error_nullPointer(!arena ? 0 : 2, "Arena_alloc()::allocator and output are required"));
+
+	if(!length || length > U64_MAX / 2)
+		retError(clean, Error_invalidParameter(1, 0, "Arena_alloc()::length should be in range [1, U64_MAX / 2]"));
+
+	const U64 aligned = Arena_alignUp(length);
+	chunk = arena->current;
+
+	if (!chunk || chunk->capacity - chunk->used < aligned) {
+
+		chunk = NULL;
+
+		if (!Arena_newChunk(arena, aligned, &chunk, &tmp)) {
+
+			if(!(arena->flags & EArenaFlags_FallbackToParent) || tmp.genericError != EGenericError_OutOfMemory) {
+				if(e_rr) *e_rr = tmp;
+				s_uccess = false;
+				goto clean;
+			}
+
+			//Full; forward to the parent but remember it, so it's still released at rewind/free
+
+			Buffer buf = Buffer_createNull();
+			gotoIfError3(clean, Buffer_createUninitializedBytes(length, arena->parent, &buf, e_rr));
+
+			const ArenaFallback fallback = (ArenaFallback) { .length = length, .id = arena->lastId + 1 };
+
+			if (!ArenaFallbackMap_insert(&arena->fallbacks, (U64) buf.ptr, fallback, arena->parent, e_rr)) {
+				Buffer_free(&buf, arena->parent);
+				s_uccess = false;
+				goto clean;
+			}
+
+			ptr = buf.ptrNonConst;
+		}
+
+		else {
+			chunk->prev = arena->current;
+			arena->current = chunk;
+		}
+	}
+
+	if (!ptr) {
+		ptr = ArenaChunk_data(chunk) + chunk->used;
+		chunk->used += aligned;
+	}
+
+	if (arena->flags & EArenaFlags_ReportLeaks) {
+
+		ArenaAllocation allocation = (ArenaAllocation) { .length = length, .id = arena->lastId + 1 };
+		Error_captureStackTrace(allocation.stack, STACKTRACE_SIZE, 2);
+
+		if (!ArenaAllocationMap_insert(&arena->live, (U64) ptr, allocation, arena->parent, e_rr)) {
+
+			//Undo, it's either the last bump or the fallback that was just added
+
+			if(chunk && ptr == ArenaChunk_data(chunk) + chunk->used - aligned)
+				chunk->used -= aligned;
+
+			else {
+				Buffer buf = Buffer_createManagedPtr(ptr, length);
+				ArenaFallbackMap_erase(&arena->fallbacks, (U64) ptr);
+				Buffer_free(&buf, arena->parent);
+			}
+
+			s_uccess = false;
+			goto clean;
+		}
+	}
+
+	++arena->lastId;
+	*output = Buffer_createManagedPtr(ptr, length);
+
+clean:
+	return s_uccess;
+}
+
+static void Arena_dealloc(void *allocator, Buffer buf) {
+
+	Arena *arena = (Arena*) allocator;
+
+	if(!arena || !buf.ptr)
+		return;
+
+	const U64 location = (U64) buf.ptr;
+
+	if ((arena->flags & EArenaFlags_ReportLeaks) && !ArenaAllocationMap_erase(&arena->live, location)) {
+		Log_errorLn(
+			arena->parent, "Arena free at %p with length %"PRIu64" wasn't allocated by the arena", buf.ptr, Buffer_length(buf)
+		);
+		return;
+	}
+
+	ArenaFallback fallback = (ArenaFallback) { 0 };
+
+	if (ArenaFallbackMap_pop(&arena->fallbacks, location, &fallback)) {
+		Buffer_free(&buf, arena->parent);
+		return;
+	}
+
+	//Only the most recent allocation can be given back, the rest waits for a rewind
+
+	ArenaChunk *chunk = arena->current;
+	const U64 aligned = Arena_alignUp(Buffer_length(buf));
+
+	if(chunk && chunk->used >= aligned && buf.ptr == ArenaChunk_data(chunk) + chunk->used - aligned)
+		chunk->used -= aligned;
+}
+
+Bool Arena_create(
+	U64 chunkSize, U64 maxSize, EArenaFlags flags, const Allocator *parent, Arena *result, Error *e_rr
+) {
+
+	Bool s_uccess = true;
+
+	if(!parent || !result)
+		retError(clean, Error_nullPointer(!parent ? 3 : 4, "Arena_create()::parent and result are required"));
+
+	if(result->allocator.ptr)
+		retError(clean, Error_invalidParameter(4, 0, "Arena_create()::result wasn't empty, could indicate memleak"));
+
+	if(flags >> EArenaFlags_Count)
+		retError(clean, Error_invalidEnum(2, (U64) flags, (1 << EArenaFlags_Count) - 1, "Arena_create()::flags is invalid"));
+
+	if(!chunkSize)
+		chunkSize = 64 * KIBI;
+
+	if(chunkSize > U64_MAX / 4)
+		retError(clean, Error_invalidParameter(0, 0, "Arena_create()::chunkSize is out of bounds"));
+
+	*result = (Arena) {
+		.allocator = (Allocator) { .ptr = result, .alloc = Arena_alloc, .free = Arena_dealloc },
+		.parent = parent,
+		.chunkSize = Arena_alignUp(chunkSize),
+		.maxSize = maxSize,
+		.flags = flags
+	};
+
+	gotoIfError3(clean, ArenaFallbackMap_create(0, parent, &result->fallbacks, e_rr));
+	gotoIfError3(clean, ArenaAllocationMap_create(0, parent, &result->live, e_rr));
+
+clean:
+	return s_uccess;
+}
+
+ArenaMark Arena_mark(const Arena *arena) {
+
+	if(!arena)
+		return (ArenaMark) { 0 };
+
+	return (ArenaMark) {
+		.chunk = arena->current,
+		.used = arena->current ? arena->current->used : 0,
+		.lastId = arena->lastId
+	};
+}
+
+//Erasing while iterating isn't allowed, so what's past the mark is gathered first.
+
+static Bool Arena_collectAfter(const GenericHashMap *map, U64 lastId, const Allocator *alloc, ListU64 *result) {
+
+	for (U64 i = GenericHashMap_next(map, 0); i != U64_MAX; i = GenericHashMap_next(map, i + 1)) {
+
+		const U64 id = ((const U64*) GenericHashMap_valueAt(map, i))[1];        //Both value types start with length, id
+
+		if(id > lastId && !ListU64_pushBack(result, *(const U64*) GenericHashMap_keyAt(map, i), alloc, NULL))
+			return false;
+	}
+
+	return true;
+}
+
+U64 Arena_rewind(Arena *arena, ArenaMark mark) {
+
+	if(!arena)
+		return 0;
+
+	//Chunks newer than the mark go back to the parent, except one which is kept to avoid asking again next time
+
+	while (arena->current && arena->current != mark.chunk) {
+
+		ArenaChunk *chunk = arena->current;
+		arena->current = chunk->prev;
+		arena->reserved -= ArenaChunk_bytes(chunk);
+
+		if (!arena->spare || arena->spare->capacity < chunk->capacity) {
+
+			if(arena->spare)
+				Arena_releaseChunk(arena, arena->spare);
+
+			chunk->prev = NULL;        //Parked empty, it's linked again (and filled from the start) when reused
+			chunk->used = 0;
+			arena->spare = chunk;
+		}
+
+		else Arena_releaseChunk(arena, chunk);
+	}
+
+	if(arena->current)
+		arena->current->used = mark.used;
+
+	ListU64 locations = (ListU64) { 0 };
+	U64 leaked = 0;
+
+	if (!Arena_collectAfter(&arena->fallbacks.map, mark.lastId, arena->parent, &locations))
+		Log_errorLn(arena->parent, "Arena_rewind() couldn't collect fallback allocations, they're freed with the arena instead");
+
+	for (U64 i = 0; i < locations.length; ++i) {
+		ArenaFallback fallback = (ArenaFallback) { 0 };
+		ArenaFallbackMap_pop(&arena->fallbacks, locations.ptr[i], &fallback);
+		Buffer buf = Buffer_createManagedPtr((void*) locations.ptr[i], fallback.length);
+		Buffer_free(&buf, arena->parent);
+	}
+
+	if (arena->flags & EArenaFlags_ReportLeaks) {
+
+		ListU64_clear(&locations, NULL);
+
+		if (!Arena_collectAfter(&arena->live.map, mark.lastId, arena->parent, &locations))
+			Log_errorLn(arena->parent, "Arena_rewind() couldn't collect live allocations to report");
+
+		for (U64 i = 0; i < locations.length; ++i) {
+
+			const ArenaAllocation *allocation = ArenaAllocationMap_find(&arena->live, locations.ptr[i]);
+
+			Log_warnLn(
+				arena->parent, "Arena allocation at %p with length %"PRIu64" was never freed, allocated at:",
+				(const void*) locations.ptr[i], allocation->length
+			);
+
+			Log_printCapturedStackTrace(arena->parent, allocation->stack, ELogLevel_Warn, ELogOptions_Default);
+			ArenaAllocationMap_erase(&arena->live, locations.ptr[i]);
+		}
+
+		leaked = locations.length;
+	}
+
+	ListU64_free(&locations, arena->parent);
+	arena->lastId = mark.lastId;
+	return leaked;
+}
+
+void Arena_free(Arena *arena) {
+
+	if(!arena || !arena->parent)
+		return;
+
+	Arena_reset(arena);
+
+	//Anything reset couldn't collect (out of memory) is still in the maps
+
+	for (U64 i = ArenaFallbackMap_next(&arena->fallbacks, 0); i != U64_MAX; i = ArenaFallbackMap_next(&arena->fallbacks, i + 1)) {
+		Buffer buf = Buffer_createManagedPtr(
+			(void*) ArenaFallbackMap_keyAt(&arena->fallbacks, i), ArenaFallbackMap_valueAt(&arena->fallbacks, i)->length
+		);
+		Buffer_free(&buf, arena->parent);
+	}
+
+	if(arena->spare)
+		Arena_releaseChunk(arena, arena->spare);
+
+	ArenaFallbackMap_free(&arena->fallbacks, arena->parent);
+	ArenaAllocationMap_free(&arena->live, arena->parent);
+
+	*arena = (Arena) { 0 };
+}
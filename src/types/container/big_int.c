@@ -32,6 +32,669 @@
 #include "types/base/constants.h"
 #include "types/container/log.h"
 #include "types/base/mathf.h"
+#include "types/math/u128_base.h"
+
+//Limb helpers.
+//These work on raw U64 limbs (least significant first) so the algorithms can recurse on parts of a number,
+// the public functions take care of BigInt's fixed bit count.
+
+#define BigInt_karatsubaThreshold 24        //In limbs, below this schoolbook is faster
+#define BigInt_decBaseLimbs 8               //Decimal conversion stops splitting below this
+#define BigInt_decChunk 18                  //Decimal digits per step, 10^18 fits in a U64 (and 10^9 in a U32)
+#define BigInt_decPowerCount 10             //10^(18 * 2^9) is more than the 4913 digits a BigInt can hold
+
+static inline U64 BigInt_mul64(U64 a, U64 b, U64 *hi) {
+
+	#if _PLATFORM_TYPE != PLATFORM_WINDOWS
+		const __uint128_t r = (__uint128_t)a * b;
+		*hi = (U64)(r >> 64);
+		return (U64)r;
+	#elif _ARCH == ARCH_ARM64
+		*hi = __umulh(a, b);
+		return a * b;
+	#else
+		return _umul128(a, b, hi);
+	#endif
+}
+
+static inline U8 BigInt_clz32(U32 v) {
+
+	#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanReverse(&index, v);
+		return (U8)(31 - index);
+	#else
+		return (U8)__builtin_clz(v);
+	#endif
+}
+
+//How many limbs are used (without the zero limbs on top)
+static inline U64 BigInt_limbs(const U64 *a, U64 n) {
+
+	while(n && !a[n - 1])
+		--n;
+
+	return n;
+}
+
+static inline U32 BigInt_digit32(const U64 *a, U64 i) {
+	return (U32)(a[i >> 1] >> ((i & 1) << 5));
+}
+
+//dst = a + b, returns carry. dst may be a or b
+static U64 BigInt_addLimbs(U64 *dst, const U64 *a, const U64 *b, U64 n) {
+
+	U64 carry = 0;
+
+	for(U64 i = 0; i < n; ++i) {
+		const U64 ai = a[i] + carry;
+		carry = ai < carry;
+		dst[i] = ai + b[i];
+		carry += dst[i] < ai;
+	}
+
+	return carry;
+}
+
+//dst = a - b, returns borrow. dst may be a or b
+static U64 BigInt_subLimbs(U64 *dst, const U64 *a, const U64 *b, U64 n) {
+
+	U64 borrow = 0;
+
+	for(U64 i = 0; i < n; ++i) {
+		const U64 ai = a[i];
+		const U64 bi = b[i] + borrow;
+		borrow = (bi < borrow) | (ai < bi);
+		dst[i] = ai - bi;
+	}
+
+	return borrow;
+}
+
+static U64 BigInt_addCarry(U64 *dst, U64 n, U64 carry) {
+
+	for(U64 i = 0; i < n && carry; ++i) {
+		dst[i] += carry;
+		carry = dst[i] < carry;
+	}
+
+	return carry;
+}
+
+static U64 BigInt_subBorrow(U64 *dst, U64 n, U64 borrow) {
+
+	for(U64 i = 0; i < n && borrow; ++i) {
+		const U64 prev = dst[i];
+		dst[i] = prev - borrow;
+		borrow = prev < borrow;
+	}
+
+	return borrow;
+}
+
+static I32 BigInt_cmpLimbs(const U64 *a, const U64 *b, U64 n) {
+
+	for(U64 i = n - 1; i != U64_MAX; --i)
+		if(a[i] != b[i])
+			return a[i] > b[i] ? 1 : -1;
+
+	return 0;
+}
+
+//dst[0, n) += a[0, n) * b, returns the limb that carries out of it
+static U64 BigInt_mulAddLimb(U64 *dst, const U64 *a, U64 n, U64 b) {
+
+	U64 carry = 0;
+
+	for(U64 i = 0; i < n; ++i) {
+
+		U64 hi = 0;
+		U64 lo = BigInt_mul64(a[i], b, &hi);
+
+		lo += carry;
+		hi += lo < carry;
+
+		dst[i] += lo;
+		hi += dst[i] < lo;
+
+		carry = hi;
+	}
+
+	return carry;
+}
+
+//dst[0, an + bn) = a * b, dst can't overlap a or b
+static void BigInt_mulSchoolbook(U64 *dst, const U64 *a, U64 an, const U64 *b, U64 bn) {
+
+	for(U64 i = 0; i < an + bn; ++i)
+		dst[i] = 0;
+
+	for(U64 i = 0; i < bn; ++i)
+		dst[i + an] = BigInt_mulAddLimb(dst + i, a, an, b[i]);
+}
+
+//dst[0, xn) = |x - y| where xn >= yn, returns if it was negative
+static Bool BigInt_absDiff(U64 *dst, const U64 *x, U64 xn, const U64 *y, U64 yn) {
+
+	I32 c = 0;
+
+	for(U64 i = xn - 1; i != U64_MAX && !c; --i) {
+		const U64 yi = i < yn ? y[i] : 0;
+		c = x[i] > yi ? 1 : (x[i] < yi ? -1 : 0);
+	}
+
+	if (c >= 0) {
+
+		for(U64 i = yn; i < xn; ++i)
+			dst[i] = x[i];
+
+		BigInt_subBorrow(dst + yn, xn - yn, BigInt_subLimbs(dst, x, y, yn));
+		return false;
+	}
+
+	//x < y, so everything in x above yn is 0
+
+	BigInt_subLimbs(dst, y, x, yn);
+
+	for(U64 i = yn; i < xn; ++i)
+		dst[i] = 0;
+
+	return true;
+}
+
+//dst[0, 2n) = a[0, n) * b[0, n), scratch needs 6n limbs.
+//Splitting a = a1 * B^h + a0 (and b likewise), the middle term a0 * b1 + a1 * b0 is equal to
+// a0 * b0 + a1 * b1 - (a1 - a0) * (b1 - b0), so three half sized multiplies are needed instead of four.
+//Using the differences rather than the sums keeps every part the same size (no carry limb to multiply).
+static void BigInt_mulKaratsuba(U64 *dst, const U64 *a, const U64 *b, U64 n, U64 *scratch) {
+
+	if (n < BigInt_karatsubaThreshold) {
+		BigInt_mulSchoolbook(dst, a, n, b, n);
+		return;
+	}
+
+	const U64 h = n >> 1, m = n - h;
+
+	U64 *da = scratch, *db = scratch + m, *mid = scratch + 2 * m, *next = scratch + 4 * m;
+
+	const Bool negA = BigInt_absDiff(da, a + h, m, a, h);
+	const Bool negB = BigInt_absDiff(db, b + h, m, b, h);
+
+	BigInt_mulKaratsuba(mid, da, db, m, next);
+	BigInt_mulKaratsuba(dst, a, b, h, next);
+	BigInt_mulKaratsuba(dst + 2 * h, a + h, b + h, m, next);
+
+	//sum = a0 * b0 + a1 * b1 -/+ mid, is never negative and fits in 2m + 1 limbs
+
+	U64 *sum = next;
+
+	for(U64 i = 0; i < 2 * m + 1; ++i)
+		sum[i] = i < 2 * h ? dst[i] : 0;
+
+	sum[2 * m] = BigInt_addLimbs(sum, sum, dst + 2 * h, 2 * m);
+
+	if(negA == negB)
+		BigInt_subBorrow(sum + 2 * m, 1, BigInt_subLimbs(sum, sum, mid, 2 * m));
+
+	else BigInt_addCarry(sum + 2 * m, 1, BigInt_addLimbs(sum, sum, mid, 2 * m));
+
+	const U64 carry = BigInt_addLimbs(dst + h, dst + h, sum, 2 * m + 1);
+	BigInt_addCarry(dst + h + 2 * m + 1, 2 * n - h - 2 * m - 1, carry);
+}
+
+//Scratch limbs needed by BigInt_mulLimbs
+static inline U64 BigInt_mulScratch(U64 an, U64 bn) {
+	return 16 * (an + bn) + 64;
+}
+
+//dst[0, an + bn) = a * b, dst can't overlap a or b.
+//Uneven sizes are handled by multiplying the smallest side with equally sized parts of the biggest.
+static void BigInt_mulLimbs(U64 *dst, const U64 *a, U64 an, const U64 *b, U64 bn, U64 *scratch) {
+
+	if (an < bn) {
+		const U64 *tmp = a; a = b; b = tmp;
+		const U64 tmpn = an; an = bn; bn = tmpn;
+	}
+
+	if (bn < BigInt_karatsubaThreshold) {
+		BigInt_mulSchoolbook(dst, a, an, b, bn);
+		return;
+	}
+
+	if (an == bn) {
+		BigInt_mulKaratsuba(dst, a, b, an, scratch);
+		return;
+	}
+
+	for(U64 i = 0; i < an + bn; ++i)
+		dst[i] = 0;
+
+	U64 *part = scratch, *next = scratch + 2 * bn;
+
+	for (U64 i = 0; i < an; i += bn) {
+
+		const U64 len = U64_min(bn, an - i);
+		BigInt_mulLimbs(part, a + i, len, b, bn, next);
+
+		const U64 carry = BigInt_addLimbs(dst + i, dst + i, part, len + bn);
+		BigInt_addCarry(dst + i + len + bn, an - i - len, carry);
+	}
+}
+
+//U32 scratch (in limbs) needed by BigInt_divLimbs
+static inline U64 BigInt_divScratch(U64 an, U64 bn) {
+	return 2 * an + bn + 2;
+}
+
+//q[0, an - bn + 1) = a / b and r[0, bn) = a % b, both are optional.
+//b can't be 0 and an >= bn (a can have zero limbs on top). Neither q or r can overlap a or b.
+//This is Knuth's algorithm D (TAOCP vol. 2, 4.3.1) on 32-bit digits; the divisor is shifted until its top bit is set,
+// which makes the estimated quotient digit at most 2 too big.
+//32-bit digits keep every intermediate in a U64, so no 128 by 64 bit division is needed on any platform.
+static void BigInt_divLimbs(U64 *q, U64 *r, const U64 *a, U64 an, const U64 *b, U64 bn, U32 *scratch) {
+
+	U64 m = an * 2, n = bn * 2;
+
+	while(m && !BigInt_digit32(a, m - 1))
+		--m;
+
+	while(n && !BigInt_digit32(b, n - 1))
+		--n;
+
+	if(q)
+		for(U64 i = 0; i < an - bn + 1; ++i)
+			q[i] = 0;
+
+	if(r)
+		for(U64 i = 0; i < bn; ++i)
+			r[i] = 0;
+
+	if (m < n) {                //a < b
+
+		if(r)
+			for(U64 i = 0; i < an && i < bn; ++i)
+				r[i] = a[i];
+
+		return;
+	}
+
+	U32 *un = scratch, *vn = un + m + 1, *qd = vn + n;
+	U64 rem = 0;
+
+	if (n == 1) {                //Short division
+
+		const U64 v = BigInt_digit32(b, 0);
+
+		for (U64 j = m - 1; j != U64_MAX; --j) {
+			const U64 cur = (rem << 32) | BigInt_digit32(a, j);
+			qd[j] = (U32)(cur / v);
+			rem = cur % v;
+		}
+	}
+
+	else {
+
+		const U8 s = BigInt_clz32(BigInt_digit32(b, n - 1));
+
+		for(U64 i = n - 1; i > 0; --i)
+			vn[i] = (U32)(((U64)BigInt_digit32(b, i) << s) | ((U64)BigInt_digit32(b, i - 1) >> (32 - s)));
+
+		vn[0] = (U32)((U64)BigInt_digit32(b, 0) << s);
+
+		un[m] = (U32)((U64)BigInt_digit32(a, m - 1) >> (32 - s));
+
+		for(U64 i = m - 1; i > 0; --i)
+			un[i] = (U32)(((U64)BigInt_digit32(a, i) << s) | ((U64)BigInt_digit32(a, i - 1) >> (32 - s)));
+
+		un[0] = (U32)((U64)BigInt_digit32(a, 0) << s);
+
+		for (U64 j = m - n; j != U64_MAX; --j) {
+
+			//Estimate the digit from the top two digits and correct it with the third
+
+			const U64 num = ((U64)un[j + n] << 32) | un[j + n - 1];
+			U64 qhat = num / vn[n - 1];
+			U64 rhat = num % vn[n - 1];
+
+			while (qhat >> 32 || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+
+				--qhat;
+				rhat += vn[n - 1];
+
+				if(rhat >> 32)
+					break;
+			}
+
+			//Multiply and subtract
+
+			I64 k = 0, t = 0;
+
+			for (U64 i = 0; i < n; ++i) {
+				const U64 p = qhat * vn[i];
+				t = (I64)un[i + j] - k - (I64)(p & U32_MAX);
+				un[i + j] = (U32) t;
+				k = (I64)(p >> 32) - (t >> 32);
+			}
+
+			t = (I64)un[j + n] - k;
+			un[j + n] = (U32) t;
+			qd[j] = (U32) qhat;
+
+			//Estimate was still one too big (rare), add back
+
+			if (t < 0) {
+
+				--qd[j];
+				U64 c = 0;
+
+				for (U64 i = 0; i < n; ++i) {
+					const U64 sum = (U64)un[i + j] + vn[i] + c;
+					un[i + j] = (U32) sum;
+					c = sum >> 32;
+				}
+
+				un[j + n] = (U32)(un[j + n] + c);
+			}
+		}
+
+		//Unnormalize the remainder
+
+		for(U64 i = 0; i < n; ++i)
+			un[i] = (U32)(((U64)un[i] >> s) | ((U64)un[i + 1] << (32 - s)));
+	}
+
+	if(q)
+		for(U64 i = 0; i < m - n + 1; ++i)
+			q[i >> 1] |= (U64)qd[i] << ((i & 1) << 5);
+
+	if(r) {
+
+		if(n == 1)
+			r[0] = rem;
+
+		else for(U64 i = 0; i < n; ++i)
+			r[i >> 1] |= (U64)un[i] << ((i & 1) << 5);
+	}
+}
+
+//Bump allocator over one scratch allocation, decimal conversion recurses so it pushes and pops in order
+
+typedef struct BigIntScratch {
+	U64 *ptr;
+	U64 used, length;
+} BigIntScratch;
+
+static U64 *BigIntScratch_push(BigIntScratch *s, U64 count) {
+
+	if(s->used + count > s->length)
+		return NULL;
+
+	U64 *res = s->ptr + s->used;
+	s->used += count;
+	return res;
+}
+
+//pow[i] = 10^(18 * 2^i) for as long as 18 * 2^i < maxDigits (at least one)
+static Bool BigInt_decPowers(BigIntScratch *s, U64 maxDigits, U64 **pow, U64 *powLen, U8 *powCount) {
+
+	pow[0] = BigIntScratch_push(s, 1);
+
+	if(!pow[0])
+		return false;
+
+	pow[0][0] = 1000000000000000000;
+	powLen[0] = 1;
+
+	U8 i = 1;
+
+	for (; i < BigInt_decPowerCount && ((U64)BigInt_decChunk << i) < maxDigits; ++i) {
+
+		const U64 prevLen = powLen[i - 1];
+		pow[i] = BigIntScratch_push(s, prevLen * 2);
+
+		const U64 mark = s->used;
+		U64 *mulScratch = BigIntScratch_push(s, BigInt_mulScratch(prevLen, prevLen));
+
+		if(!pow[i] || !mulScratch)
+			return false;
+
+		BigInt_mulLimbs(pow[i], pow[i - 1], prevLen, pow[i - 1], prevLen, mulScratch);
+		powLen[i] = BigInt_limbs(pow[i], prevLen * 2);
+		s->used = mark;
+	}
+
+	*powCount = i;
+	return true;
+}
+
+//Writes v[0, n) as decimal right aligned into out[0, digits), padded with zeros.
+//digits has to be enough to hold it, big numbers are split in two by the biggest power of 10 that fits twice,
+// so the lower half is exactly 18 * 2^j digits and both halves are converted the same way.
+static Bool BigInt_toDecLimbs(
+	BigIntScratch *s, const U64 *v, U64 n, C8 *out, U64 digits, U64 *const *pow, const U64 *powLen, U8 powCount
+) {
+
+	n = BigInt_limbs(v, n);
+
+	U8 j = powCount;
+
+	while(j && powLen[j - 1] * 2 - 1 > n)
+		--j;
+
+	const U64 mark = s->used;
+
+	if (n <= BigInt_decBaseLimbs || !j) {
+
+		//Divide by 10^9 until nothing is left, each remainder is 9 digits
+
+		U32 *d = (U32*) BigIntScratch_push(s, n);
+
+		if(!d && n)
+			return false;
+
+		U64 dn = n * 2;
+
+		for(U64 i = 0; i < dn; ++i)
+			d[i] = BigInt_digit32(v, i);
+
+		while(dn && !d[dn - 1])
+			--dn;
+
+		U64 k = digits;
+
+		while (dn) {
+
+			U64 rem = 0;
+
+			for (U64 i = dn - 1; i != U64_MAX; --i) {
+				const U64 cur = (rem << 32) | d[i];
+				d[i] = (U32)(cur / 1000000000);
+				rem = cur % 1000000000;
+			}
+
+			while(dn && !d[dn - 1])
+				--dn;
+
+			for (U8 c = 0; c < 9 && k; ++c) {
+				out[--k] = (C8)('0' + rem % 10);
+				rem /= 10;
+			}
+		}
+
+		while(k)
+			out[--k] = '0';
+
+		s->used = mark;
+		return true;
+	}
+
+	--j;
+
+	const U64 lowDigits = (U64)BigInt_decChunk << j;
+	const U64 pn = powLen[j];
+
+	if(digits <= lowDigits)
+		return false;
+
+	U64 *q = BigIntScratch_push(s, n - pn + 1);
+	U64 *r = BigIntScratch_push(s, pn);
+	U32 *divScratch = (U32*) BigIntScratch_push(s, BigInt_divScratch(n, pn));
+
+	if(!q || !r || !divScratch)
+		return false;
+
+	BigInt_divLimbs(q, r, v, n, pow[j], pn, divScratch);
+
+	const Bool res =
+		BigInt_toDecLimbs(s, q, n - pn + 1, out, digits - lowDigits, pow, powLen, j) &&
+		BigInt_toDecLimbs(s, r, pn, out + digits - lowDigits, lowDigits, pow, powLen, j);
+
+	s->used = mark;
+	return res;
+}
+
+//Parses text[0, len) (only decimal chars) into dst[0, dstLen) with dstLen >= len / 19 + 1.
+//Mirrors BigInt_toDecLimbs; the lowest 18 * 2^j digits and the rest are parsed separately and combined as
+// hi * 10^(18 * 2^j) + lo, which lets the expensive multiplies run on big balanced numbers (Karatsuba).
+static Bool BigInt_fromDecLimbs(
+	BigIntScratch *s, const C8 *text, U64 len, U64 *dst, U64 dstLen, U64 *const *pow, const U64 *powLen, U8 powCount
+) {
+
+	for(U64 i = 0; i < dstLen; ++i)
+		dst[i] = 0;
+
+	U8 j = powCount;
+
+	while(j && ((U64)BigInt_decChunk << (j - 1)) >= len)
+		--j;
+
+	if (len <= BigInt_decBaseLimbs * BigInt_decChunk || !j) {
+
+		U64 used = 0;
+
+		for (U64 i = 0; i < len; ) {
+
+			const U64 chunk = i ? BigInt_decChunk : (len - 1) % BigInt_decChunk + 1;
+			U64 v = 0, mul = 1;
+
+			for (U64 c = 0; c < chunk; ++c, ++i) {
+				v = v * 10 + (U64)(text[i] - '0');
+				mul *= 10;
+			}
+
+			//dst = dst * 10^chunk + v
+
+			U64 carry = v;
+
+			for (U64 k = 0; k < used; ++k) {
+
+				U64 hi = 0;
+				U64 lo = BigInt_mul64(dst[k], mul, &hi);
+
+				lo += carry;
+				hi += lo < carry;
+
+				dst[k] = lo;
+				carry = hi;
+			}
+
+			if (carry) {
+
+				if(used == dstLen)
+					return false;
+
+				dst[used++] = carry;
+			}
+		}
+
+		return true;
+	}
+
+	--j;
+
+	const U64 lowDigits = (U64)BigInt_decChunk << j;
+	const U64 hiDigits = len - lowDigits;
+	const U64 hiLen = hiDigits / 19 + 1, loLen = lowDigits / 19 + 1;
+	const U64 mark = s->used;
+
+	U64 *hi = BigIntScratch_push(s, hiLen);
+	U64 *lo = BigIntScratch_push(s, loLen);
+
+	if(!hi || !lo)
+		return false;
+
+	if(
+		!BigInt_fromDecLimbs(s, text, hiDigits, hi, hiLen, pow, powLen, j) ||
+		!BigInt_fromDecLimbs(s, text + hiDigits, lowDigits, lo, loLen, pow, powLen, j)
+	)
+		return false;
+
+	const U64 hn = BigInt_limbs(hi, hiLen), ln = BigInt_limbs(lo, loLen), pn = powLen[j];
+
+	if (hn) {
+
+		U64 *prod = BigIntScratch_push(s, hn + pn);
+		U64 *mulScratch = BigIntScratch_push(s, BigInt_mulScratch(hn, pn));
+
+		if(!prod || !mulScratch)
+			return false;
+
+		BigInt_mulLimbs(prod, hi, hn, pow[j], pn, mulScratch);
+
+		const U64 prodLen = BigInt_limbs(prod, hn + pn);
+
+		if(prodLen > dstLen)
+			return false;
+
+		for(U64 i = 0; i < prodLen; ++i)
+			dst[i] = prod[i];
+	}
+
+	if(ln > dstLen || BigInt_addCarry(dst + ln, dstLen - ln, BigInt_addLimbs(dst, dst, lo, ln)))
+		return false;
+
+	s->used = mark;
+	return true;
+}
+
+//Scratch limbs needed for decimal conversion of n limbs
+static inline U64 BigInt_decScratch(U64 n) {
+	return 32 * n + 256;
+}
+
+//Montgomery multiplication (CIOS); out = x * y / 2^(64n) % m.
+//m has to be odd, mInv = -m^-1 % 2^64 and t holds n + 2 limbs. out can be x or y.
+static void BigInt_montMul(U64 *out, const U64 *x, const U64 *y, const U64 *m, U64 n, U64 mInv, U64 *t) {
+
+	for(U64 i = 0; i < n + 2; ++i)
+		t[i] = 0;
+
+	for (U64 i = 0; i < n; ++i) {
+
+		U64 carry = BigInt_mulAddLimb(t, x, n, y[i]);
+		t[n] += carry;
+		t[n + 1] += t[n] < carry;
+
+		//Adding a multiple of m that clears the lowest limb makes the shift right by 64 exact
+
+		carry = BigInt_mulAddLimb(t, m, n, t[0] * mInv);
+		t[n] += carry;
+		t[n + 1] += t[n] < carry;
+
+		for(U64 k = 0; k <= n; ++k)
+			t[k] = t[k + 1];
+
+		t[n + 1] = 0;
+	}
+
+	//t < 2m, so at most one subtraction is needed
+
+	if(t[n] || BigInt_cmpLimbs(t, m, n) >= 0)
+		BigInt_subLimbs(out, t, m, n);
+
+	else for(U64 i = 0; i < n; ++i)
+		out[i] = t[i];
+}
 
 Bool BigInt_create(U16 bitCount, const Allocator *alloc, BigInt *big, Error *e_rr) {
 
@@ -112,7 +775,7 @@ Bool BigInt_createCopy(BigInt *a, const Allocator *alloc, BigInt *b, Error *e_rr
 
 	gotoIfError3(clean, BigInt_create((U16)a->length << 6, alloc, b, e_rr));
 
-	if (!BigInt_set(a, *b, false, NULL, e_rr))
+	if (!BigInt_set(b, *a, false, NULL, e_rr))
 		retError(clean, Error_invalidState(0, "BigInt_createCopy() set failed"));
 
 clean:
@@ -145,8 +808,10 @@ Bool BigInt_createFromBase2Type(const BigIntCreate *bigIntCreate, EIntEncoding t
 	if(!bigIntCreate || !bigIntCreate->text || !bigIntCreate->big)
 		retError(clean, Error_nullPointer(0, "BigInt_createFromBase2Type()::bigIntCreate, ->text and ->big are required"));
 
-	if((U64)type >= EIntEncoding_Count)
-		retError(clean, Error_invalidEnum(3, (U64)type, EIntEncoding_Count, "BigInt_createFromBase2Type()::type is invalid"));
+	if((U64)type >= EIntEncoding_Base2End)
+		retError(clean, Error_invalidEnum(
+			3, (U64)type, EIntEncoding_Base2End, "BigInt_createFromBase2Type()::type is invalid"
+		));
 
 	const CharString prefix = CharString_createRefCStrConst(base2Types[type]);
 	const U8 prefixChars = CharString_startsWithStringInsensitive(bigIntCreate->text, &prefix, 0) ? 2 : 0;
@@ -277,10 +942,10 @@ Bool BigInt_createFromDec(const BigIntCreate *bigIntCreate, Error *e_rr) {
 	const Allocator *alloc = NULL;
 	Bool allocated = false;
 
-	BigInt temp = { 0 }, multiplier = { 0 };
+	Buffer temp = Buffer_createNull();
 
 	if (!bigIntCreate || !bigIntCreate->text || !bigIntCreate->big)
-		retError(clean, Error_nullPointer(0, "BigInt_createFromBase2Type()::bigIntCreate, ->text and ->big are required"));
+		retError(clean, Error_nullPointer(0, "BigInt_createFromDec()::bigIntCreate, ->text and ->big are required"));
 
 	const U64 textl = CharString_length(*bigIntCreate->text);
 
@@ -296,7 +961,11 @@ Bool BigInt_createFromDec(const BigIntCreate *bigIntCreate, Error *e_rr) {
 	U16 bitCount = bigIntCreate->bitCount;
 	const C8 *const textPtr = bigIntCreate->text->ptr;
 
-	U64 estBitCount = (U64) F64_ceil(F64_log2((F64) textl));
+	for(U64 i = 0; i < textl; ++i)
+		if(!C8_isDec(textPtr[i]))
+			retError(clean, Error_invalidParameter(0, 1, "BigInt_createFromDec()::text contains non decimal char"));
+
+	const U64 estBitCount = (U64) F64_ceil((F64) textl * 3.321928094887362);        //log2(10) bits per digit
 
 	if (bitCount == U16_MAX) {
 
@@ -322,11 +991,11 @@ Bool BigInt_createFromDec(const BigIntCreate *bigIntCreate, Error *e_rr) {
 			));
 
 		if(bitCount > 0xFF * 64)
-			retError(clean, Error_invalidParameter(1, 0, "BigInt_createFromBase2Type()::bitCount is out of bounds (>16320)"));
+			retError(clean, Error_invalidParameter(1, 0, "BigInt_createFromDec()::bitCount is out of bounds (>16320)"));
 	}
 
 	if(estBitCount > 0xFF * 64 + 1)            //+1 to align to base10
-		retError(clean, Error_outOfMemory(0, "BigInt_createFromBase2Type() estBitCount is out of bounds (>16321)"));
+		retError(clean, Error_outOfMemory(0, "BigInt_createFromDec() estBitCount is out of bounds (>16321)"));
 
 	alloc = bigIntCreate->alloc;
 
@@ -335,53 +1004,50 @@ Bool BigInt_createFromDec(const BigIntCreate *bigIntCreate, Error *e_rr) {
 		allocated = true;
 	}
 
-	gotoIfError3(clean, BigInt_create(bitCount, alloc, &multiplier, e_rr));
-	gotoIfError3(clean, BigInt_create(bitCount, alloc, &temp, e_rr));
-
-	((U64*)multiplier.data)[0] = 1;        //Multiplier
+	//Parse into scratch first, the text might be too big for big
 
-	for (U64 i = textl - 1; i != U64_MAX; --i) {
+	const U64 valueLen = textl / 19 + 1;
+	const U64 scratchLen = valueLen + BigInt_decScratch(valueLen);
 
-		U8 v = C8_dec(textPtr[i]);
+	gotoIfError3(clean, Buffer_createUninitializedBytes(scratchLen * sizeof(U64), alloc, &temp, e_rr));
 
-		if (v == U8_MAX)
-			retError(clean, Error_invalidParameter(0, 1, "BigInt_createFromBase2Type()::text contains non alpha char"));
+	BigIntScratch scratch = (BigIntScratch) { .ptr = (U64*) temp.ptrNonConst, .length = scratchLen };
+	U64 *value = BigIntScratch_push(&scratch, valueLen);
 
-		((U8*)temp.data)[0] = v;
+	U64 *pow[BigInt_decPowerCount];
+	U64 powLen[BigInt_decPowerCount];
+	U8 powCount = 0;
 
-		gotoIfError3(clean, BigInt_mul(&temp, multiplier, alloc, e_rr));
+	if(
+		!BigInt_decPowers(&scratch, textl, pow, powLen, &powCount) ||
+		!BigInt_fromDecLimbs(&scratch, textPtr, textl, value, valueLen, pow, powLen, powCount)
+	)
+		retError(clean, Error_invalidState(0, "BigInt_createFromDec() ran out of scratch memory"));
 
-		if (!BigInt_add(big, temp))
-			retError(clean, Error_invalidState(2, "BigInt_createFromBase2Type() add failed"));
+	const U64 used = BigInt_limbs(value, valueLen);
 
-		//Multiply multiplier by 10
-
-		if (!BigInt_and(&temp, BigInt_createNull()))
-			retError(clean, Error_invalidState(2, "BigInt_createFromBase2Type() clear failed"));
-
-		((U8*)temp.data)[0] = 10;
+	if(used > big->length)
+		retError(clean, Error_outOfBounds(
+			0, used * 64, bitCount, "BigInt_createFromDec()::text would overflow BigInt bitCount"
+		));
 
-		gotoIfError3(clean, BigInt_mul(&multiplier, temp, alloc, e_rr));
-	}
+	for(U64 i = 0; i < used; ++i)
+		big->dataNonConst[i] = value[i];
 
 	if(bitCount & 63) {        //Fix last U64 to handle out of bounds
 
 		if (big->data[big->length - 1] >> (bitCount & 63))
 			retError(clean, Error_outOfBounds(
-				0, bitCount, bitCount, "BigInt_createFromBase2Type()::text contains too much data"
+				0, bitCount, bitCount, "BigInt_createFromDec()::text contains too much data"
 			));
 	}
 
 clean:
 
-	if (alloc) {
+	Buffer_free(&temp, alloc);
 
-		BigInt_free(&multiplier, alloc);
-		BigInt_free(&temp, alloc);
-
-		if (!s_uccess && allocated)
-			BigInt_free(big, alloc);
-	}
+	if (!s_uccess && allocated)
+		BigInt_free(big, alloc);
 
 	return s_uccess;
 }
@@ -416,88 +1082,29 @@ Bool BigInt_mul(BigInt *a, BigInt b, const Allocator *allocator, Error *e_rr) {
 	if(!a || a->isConst || !a->length)
 		return false;
 
-	if(!b.length)
-		return BigInt_and(a, b);
-
-	Bool s_uccess = true;
-	BigInt temp = { 0 };
-	gotoIfError3(clean, BigInt_create(BigInt_bitCount(*a), allocator, &temp, e_rr));
-
-	const U32 digitsA = (U32)a->length * 2;
-	const U32 digitsB = (U32)b.length * 2;
-
-	U32 *dst = (U32*) temp.data;
-	const U32 *aptr = (const U32*) a->data;
-	const U32 *bptr = (const U32*) b.data;
-
-	for (U32 i = 0; i < digitsA; ++i) {
-
-		U64 mul = dst[i];
-
-		//Shoot ray (diagonally) through a Brune matrix.
-		//The concept is as follows:
-		//
-		//   a0 a1 a2 a3
-		//b0 0  1  2  3
-		//b1 1  2  3  4
-		//b2 2  3  4  5
-		//b3 3  4  5  6
-		//
-		//With any number system, (a0 * b0) % base will result into the smallest digit.
-		//While (a0 * b0) / base will result into the overflow.
-		//This overflow is then added to the next which will calculate the next row.
-		//In this case diagonal 1 would be (a1 * b0 + b1 * a0 + overflow).
-		//The digit would be obtained through % base and then overflow is computed again.
-		//This process is continued until it hits the desired number of digits.
-		//
-		//If we use base as 2^32 we can essentially process per U32 and then use a U64 to catch the overflow.
-		//Truncating it is a simple U32 cast and/or shift.
-		//When 128-bit numbers are available (hardware accelerated) this could be extended the same way to speed it up.
-
-		const U32 startX = (U32) U64_min(i, digitsA - 1);
-		const U32 startRayT = i - startX;
-		const U32 endRayT = (U32) U64_min(i, digitsB - 1) - startRayT;
-
-		for (U32 t = startRayT; t <= endRayT; ++t) {
-
-			const U64 x = i - t;
-			const U64 y = t;
-
-			const U64 prevMul = mul;
-			mul += (U64) aptr[x] * bptr[y];
-
-			if(mul < prevMul && i + 2 < digitsA) {            //Overflow in our overflow.
-
-				U64 j = i + 2, v = 0;
-
-				do {                                        //Keep on adding overflow
-					v = ++dst[j++];
-				} while(!v && j < digitsA);
-			}
-		}
-
-		dst[i] = (U32) mul;
+	const U64 an = BigInt_limbs(a->data, a->length);
+	const U64 bn = BigInt_limbs(b.data, b.length);
 
-		if(i + 1 < digitsA) {
-
-			const U64 prev = dst[i + 1];
-			dst[i + 1] += (U32) (mul >> 32);
+	if(!an || !bn)
+		return BigInt_and(a, BigInt_createNull());
 
-			if (dst[i + 1] < prev && i + 2 < digitsA) {        //Overflow in our overflow.
+	//Only the used limbs are multiplied (numbers are often much smaller than their bit count).
+	//The full product is computed in scratch since b may be a.
 
-				U64 j = i + 2, v = 0;
+	Bool s_uccess = true;
+	Buffer temp = Buffer_createNull();
+	gotoIfError3(clean, Buffer_createUninitializedBytes(
+		(an + bn + BigInt_mulScratch(an, bn)) * sizeof(U64), allocator, &temp, e_rr
+	));
 
-				do {                                        //Keep on adding overflow
-					v = ++dst[j++];
-				} while(!v && j < digitsA);
-			}
-		}
-	}
+	U64 *prod = (U64*) temp.ptrNonConst;
+	BigInt_mulLimbs(prod, a->data, an, b.data, bn, prod + an + bn);
 
-	gotoIfError3(clean, BigInt_set(a, temp, false, NULL, e_rr));
+	for(U64 i = 0; i < a->length; ++i)
+		a->dataNonConst[i] = i < an + bn ? prod[i] : 0;
 
 clean:
-	BigInt_free(&temp, allocator);
+	Buffer_free(&temp, allocator);
 	return s_uccess;
 }
 
@@ -684,15 +1291,234 @@ clean:
 	return s_uccess;
 }
 
-//TODO: div and mod
-//Bool BigInt_mod(BigInt *a, BigInt b);
-//Bool BigInt_div(BigInt *a, BigInt b);
+//quotient = a / b and remainder = a % b, both optional and either can be a
+
+static Bool BigInt_divModInternal(
+	BigInt a, BigInt b, BigInt *quotient, BigInt *remainder, const Allocator *allocator, Error *e_rr
+) {
+
+	Bool s_uccess = true;
+	Buffer temp = Buffer_createNull();
+
+	if((quotient && quotient->isConst) || (remainder && remainder->isConst))
+		retError(clean, Error_constData(0, 0, "BigInt_divMod()::a and remainder can't be const"));
+
+	const U64 an = BigInt_limbs(a.data, a.length);
+	const U64 bn = BigInt_limbs(b.data, b.length);
+
+	if(!bn)
+		retError(clean, Error_divideByZero(0, 0, 0, "BigInt_divMod()::b is 0"));
+
+	const U64 qn = an >= bn ? an - bn + 1 : 1;
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(
+		(qn + bn + BigInt_divScratch(an, bn)) * sizeof(U64), allocator, &temp, e_rr
+	));
+
+	U64 *q = (U64*) temp.ptrNonConst, *r = q + qn;
+
+	if (an < bn) {
+
+		q[0] = 0;
+
+		for(U64 i = 0; i < bn; ++i)
+			r[i] = i < an ? a.data[i] : 0;
+	}
+
+	else BigInt_divLimbs(q, r, a.data, an, b.data, bn, (U32*)(r + bn));
+
+	const U64 rn = BigInt_limbs(r, bn);
+
+	if(remainder && rn > remainder->length)
+		retError(clean, Error_outOfBounds(
+			2, rn * 64, BigInt_bitCount(*remainder), "BigInt_divMod()::remainder is too small to hold a % b"
+		));
+
+	if(quotient)
+		for(U64 i = 0; i < quotient->length; ++i)
+			quotient->dataNonConst[i] = i < qn ? q[i] : 0;
+
+	if(remainder)
+		for(U64 i = 0; i < remainder->length; ++i)
+			remainder->dataNonConst[i] = i < rn ? r[i] : 0;
+
+clean:
+	Buffer_free(&temp, allocator);
+	return s_uccess;
+}
+
+Bool BigInt_divMod(BigInt *a, BigInt b, BigInt *remainder, const Allocator *allocator, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(!a)
+		retError(clean, Error_nullPointer(0, "BigInt_divMod()::a is required"));
+
+	if(remainder == a)
+		retError(clean, Error_invalidParameter(2, 0, "BigInt_divMod()::remainder can't be a"));
+
+	gotoIfError3(clean, BigInt_divModInternal(*a, b, a, remainder, allocator, e_rr));
+
+clean:
+	return s_uccess;
+}
+
+Bool BigInt_mod(BigInt *a, BigInt b, const Allocator *allocator, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(!a)
+		retError(clean, Error_nullPointer(0, "BigInt_mod()::a is required"));
+
+	gotoIfError3(clean, BigInt_divModInternal(*a, b, NULL, a, allocator, e_rr));
+
+clean:
+	return s_uccess;
+}
+
+//x * y % m for powMod; either through Montgomery form (odd m) or a full multiply and division
+
+typedef struct BigIntModMul {
+
+	const U64 *m;
+	U64 n, mInv;
+	Bool montgomery;
+
+	U64 *prod;              //2n + 2
+	U64 *mulScratch;
+	U32 *divScratch;
+
+} BigIntModMul;
+
+static void BigIntModMul_mul(const BigIntModMul *ctx, U64 *out, const U64 *x, const U64 *y) {
+
+	if (ctx->montgomery) {
+		BigInt_montMul(out, x, y, ctx->m, ctx->n, ctx->mInv, ctx->prod);
+		return;
+	}
+
+	BigInt_mulLimbs(ctx->prod, x, ctx->n, y, ctx->n, ctx->mulScratch);
+	BigInt_divLimbs(NULL, out, ctx->prod, ctx->n * 2, ctx->m, ctx->n, ctx->divScratch);
+}
+
+Bool BigInt_powMod(BigInt *a, BigInt exponent, BigInt modulus, const Allocator *allocator, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Buffer temp = Buffer_createNull();
+
+	if(!a || a->isConst)
+		retError(clean, Error_nullPointer(0, "BigInt_powMod()::a is required and can't be const"));
+
+	const U64 n = BigInt_limbs(modulus.data, modulus.length);
+
+	if(!n)
+		retError(clean, Error_divideByZero(0, 0, 0, "BigInt_powMod()::modulus is 0"));
+
+	if(a->length < n)
+		retError(clean, Error_outOfBounds(
+			0, BigInt_bitCount(*a), n * 64, "BigInt_powMod()::a can't hold every value below modulus"
+		));
+
+	const U64 an = BigInt_limbs(a->data, a->length);
+	const U64 en = BigInt_limbs(exponent.data, exponent.length);
+	const U64 *m = modulus.data;
+
+	//Window of 4 exponent bits at a time; table[i] = a^i (in Montgomery form if used)
+
+	const U64 shiftedLen = an + n + 1;
+	const U64 dividendLen = U64_max(shiftedLen, n * 2);
+
+	const U64 scratchLen =
+		16 * n + n + (2 * n + 2) + shiftedLen + BigInt_mulScratch(n, n) + BigInt_divScratch(dividendLen, n);
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(scratchLen * sizeof(U64), allocator, &temp, e_rr));
+
+	U64 *table = (U64*) temp.ptrNonConst;
+	U64 *x = table + 16 * n;
+
+	BigIntModMul ctx = (BigIntModMul) {
+		.m = m,
+		.n = n,
+		.montgomery = m[0] & 1,
+		.prod = x + n
+	};
+
+	U64 *shifted = ctx.prod + 2 * n + 2;
+	ctx.mulScratch = shifted + shiftedLen;
+	ctx.divScratch = (U32*)(ctx.mulScratch + BigInt_mulScratch(n, n));
+
+	//Montgomery form of v is v * 2^(64n) % m, so both 1 and a are shifted up by n limbs before reducing.
+	//Without Montgomery they're just reduced by m.
+
+	const U64 shift = ctx.montgomery ? n : 0;
+
+	for(U64 i = 0; i < shiftedLen; ++i)
+		shifted[i] = i == shift;
+
+	BigInt_divLimbs(NULL, table, shifted, U64_max(shift + 1, n), m, n, ctx.divScratch);
+
+	for(U64 i = 0; i < shiftedLen; ++i)
+		shifted[i] = i >= shift && i - shift < an ? a->data[i - shift] : 0;
+
+	BigInt_divLimbs(NULL, table + n, shifted, U64_max(an + shift, n), m, n, ctx.divScratch);
+
+	if (ctx.montgomery) {
+
+		//-m^-1 % 2^64 with Newton's method, every step doubles the correct bits (m * m = 1 % 8 for odd m)
+
+		U64 inv = m[0];
+
+		for(U8 i = 0; i < 5; ++i)
+			inv *= 2 - m[0] * inv;
+
+		ctx.mInv = (U64)0 - inv;
+	}
+
+	for(U64 i = 2; i < 16; ++i)
+		BigIntModMul_mul(&ctx, table + i * n, table + (i - 1) * n, table + n);
+
+	for(U64 i = 0; i < n; ++i)
+		x[i] = table[i];
+
+	Bool started = false;
+
+	for (U64 i = en * 16 - 1; i != U64_MAX; --i) {
+
+		if(started)
+			for(U8 j = 0; j < 4; ++j)
+				BigIntModMul_mul(&ctx, x, x, x);
+
+		const U8 window = (U8)((exponent.data[i >> 4] >> ((i & 15) << 2)) & 15);
+
+		if (window) {
+			BigIntModMul_mul(&ctx, x, x, table + window * n);
+			started = true;
+		}
+	}
+
+	//Back from Montgomery form by multiplying with 1
+
+	if (ctx.montgomery) {
+
+		for(U64 i = 0; i < shiftedLen; ++i)
+			shifted[i] = !i;
+
+		BigIntModMul_mul(&ctx, x, x, shifted);
+	}
+
+	for(U64 i = 0; i < a->length; ++i)
+		a->dataNonConst[i] = i < n ? x[i] : 0;
+
+clean:
+	Buffer_free(&temp, allocator);
+	return s_uccess;
+}
 
 Bool BigInt_base2(const BigIntStringify *stringify, EIntEncoding type, BigInt b, Error *e_rr) {
 
 	Bool s_uccess = true;
 	Bool allocated = false;
-	const U8 countPerChar = base2Count[type];
+	const U8 countPerChar = type < EIntEncoding_Base2End ? base2Count[type] : 1;
 	const U64 len = U64_max(3, (((U64)b.length * 64 + countPerChar - 1) / countPerChar) + 2);
 
 	if (!stringify)
@@ -708,7 +1534,7 @@ Bool BigInt_base2(const BigIntStringify *stringify, EIntEncoding type, BigInt b,
 
 	resultPtr[1] = base2Types[type][1];
 
-	U64 firstLoc = len - 1;
+	U64 firstLoc = 1;                //Zero still prints one digit
 	const U8 mask = (1 << countPerChar) - 1;
 	const U64 i = len - 1;
 
@@ -750,6 +1576,63 @@ clean:
 	return s_uccess;
 }
 
+static Bool BigInt_decimal(const BigIntStringify *stringify, BigInt b, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Bool allocated = false;
+	Buffer temp = Buffer_createNull();
+
+	if (!stringify)
+		retError(clean, Error_nullPointer(0, "BigInt_decimal()::stringify is required"));
+
+	const U64 n = BigInt_limbs(b.data, b.length);
+
+	//Enough digits for anything below 2^bits; the bit count for leading zeros, otherwise the used bits
+
+	const U16 bits = stringify->leadingZeros ? BigInt_bitCount(b) : (n ? BigInt_bitScan(b) + 1 : 1);
+	const U64 digits = U64_max(1, (U64) F64_ceil((F64) bits * 0.30102999566398120));        //log10(2) digits per bit
+
+	gotoIfError3(clean, CharString_resize(stringify->result, digits, '0', stringify->alloc, e_rr));
+	allocated = true;
+
+	if (n) {
+
+		const U64 scratchLen = BigInt_decScratch(n);
+		gotoIfError3(clean, Buffer_createUninitializedBytes(scratchLen * sizeof(U64), stringify->alloc, &temp, e_rr));
+
+		BigIntScratch scratch = (BigIntScratch) { .ptr = (U64*) temp.ptrNonConst, .length = scratchLen };
+
+		U64 *pow[BigInt_decPowerCount];
+		U64 powLen[BigInt_decPowerCount];
+		U8 powCount = 0;
+
+		if(
+			!BigInt_decPowers(&scratch, digits / 2, pow, powLen, &powCount) ||
+			!BigInt_toDecLimbs(&scratch, b.data, n, stringify->result->ptrNonConst, digits, pow, powLen, powCount)
+		)
+			retError(clean, Error_invalidState(0, "BigInt_decimal() ran out of scratch memory"));
+	}
+
+	if (!stringify->leadingZeros) {
+
+		U64 firstLoc = 0;
+
+		while(firstLoc + 1 < digits && stringify->result->ptr[firstLoc] == '0')
+			++firstLoc;
+
+		gotoIfError3(clean, CharString_eraseAtCount(stringify->result, 0, firstLoc, e_rr));
+	}
+
+clean:
+
+	Buffer_free(&temp, stringify ? stringify->alloc : NULL);
+
+	if(!s_uccess && allocated)
+		CharString_free(stringify->result, stringify->alloc);
+
+	return s_uccess;
+}
+
 Bool BigInt_toString(const BigIntStringify *stringify, EIntEncoding encoding, BigInt b, Error *e_rr) {
 
 	Bool s_uccess = true;
@@ -760,6 +1643,10 @@ Bool BigInt_toString(const BigIntStringify *stringify, EIntEncoding encoding, Bi
 			gotoIfError3(clean, BigInt_base2(stringify, encoding, b, e_rr));
 			break;
 
+		case EIntEncoding_Dec:
+			gotoIfError3(clean, BigInt_decimal(stringify, b, e_rr));
+			break;
+
 		default:
 			retError(clean, Error_invalidParameter(3, 0, "BigInt_toString()::encoding is invalid"));
 	}
@@ -767,5 +1654,3 @@ Bool BigInt_toString(const BigIntStringify *stringify, EIntEncoding encoding, Bi
 clean:
 	return s_uccess;
 }
-
-//Bool BigInt_dec(const BigIntStringify *stringify, BigInt b, Error *e_rr);
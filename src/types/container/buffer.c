@@ -27,6 +27,7 @@
 #include "types/base/mathi.h"
 #include "types/base/constants.h"
 #include "types/base/buffer_base.h"
+#include "types/base/unicode.h"
 
 #include <string.h>
 
@@ -373,7 +374,9 @@ Bool Buffer_readAsUTF8(Buffer buf, U64 i, UnicodeCodePointInfo *codepoint, Error
 		goto clean;
 	}
 
-	if(v0 < 0xC0)
+	//Continuation, overlong (C0 and C1 only encode ASCII) or above 0x10FFFF
+
+	if(v0 < 0xC2 || v0 >= 0xF5)
 		retError(clean, Error_invalidParameter(0, 1, "Buffer_readAsUTF8()::buf[i] didn't contain valid UTF8"));
 
 	//2-4 bytes
@@ -383,7 +386,12 @@ Bool Buffer_readAsUTF8(Buffer buf, U64 i, UnicodeCodePointInfo *codepoint, Error
 
 	const U8 v1 = buf.ptr[i++];
 
-	if(v1 < 0x80 || v1 >= 0xC0)
+	//E0, ED, F0 and F4 allow fewer second bytes: below that is overlong, above is a surrogate or above 0x10FFFF
+
+	const U8 v1Min = v0 == 0xE0 ? 0xA0 : (v0 == 0xF0 ? 0x90 : 0x80);
+	const U8 v1Max = v0 == 0xED ? 0x9F : (v0 == 0xF4 ? 0x8F : 0xBF);
+
+	if(v1 < v1Min || v1 > v1Max)
 		retError(clean, Error_invalidParameter(0, 2, "Buffer_readAsUTF8()::buf[i + 1] had invalid encoding"));
 
 	//2 bytes
@@ -516,7 +524,7 @@ Bool Buffer_readAsUTF16(const Buffer buf, U64 i, UnicodeCodePointInfo *codepoint
 	const U16 v0 = Buffer_readU16(buf, i, NULL, NULL);
 	i += 2;
 
-	if (v0 <= 0xD7FF) {
+	if (v0 <= 0xD7FF || v0 >= 0xE000) {
 
 		if(v0 <= 0x7F && !C8_isValidAscii((C8)v0))
 			retError(clean, Error_invalidParameter(0, 0, "Buffer_readAsUTF16()::buf[i] didn't contain valid ascii"));
@@ -525,7 +533,9 @@ Bool Buffer_readAsUTF16(const Buffer buf, U64 i, UnicodeCodePointInfo *codepoint
 		goto clean;
 	}
 
-	if((v0 - 0xD800) >= (1 << 10))
+	//A low surrogate without a high one before it
+
+	if(v0 >= 0xDC00)
 		retError(clean, Error_invalidParameter(0, 1, "Buffer_readAsUTF16()::buf[i] didn't contain valid UTF16"));
 
 	//2 U16s
@@ -538,8 +548,10 @@ Bool Buffer_readAsUTF16(const Buffer buf, U64 i, UnicodeCodePointInfo *codepoint
 	if(v1 < 0xDC00 || (v1 - 0xDC00) >= (1 << 10))
 		retError(clean, Error_invalidParameter(0, 2, "Buffer_readAsUTF16()::buf[i + 1] had invalid encoding"));
 
-	*codepoint = (UnicodeCodePointInfo) { .chars = 2, .bytes = 4, .index = ((v0 - 0xD800) << 10) | (v1 - 0xDC00) | 0x10000 };
-	
+	*codepoint = (UnicodeCodePointInfo) {
+		.chars = 2, .bytes = 4, .index = (((U32)(v0 - 0xD800) << 10) | (v1 - 0xDC00)) + 0x10000
+	};
+
 clean:
 	return s_uccess;
 }
@@ -551,7 +563,7 @@ Bool Buffer_writeAsUTF16(const Buffer buf, U64 i, UnicodeCodePoint codepoint, U8
 	if(Buffer_isConstRef(buf))
 		retError(clean, Error_constData(0, 0, "Buffer_writeAsUTF16()::buf should be writable"));
 
-	if (codepoint <= 0xD7FF) {
+	if (codepoint <= 0xFFFF) {
 
 		if(i + 2 > Buffer_length(buf))
 			retError(clean, Error_outOfBounds(0, i + 2, Buffer_length(buf), "Buffer_writeAsUTF16()::i out of bounds"));
@@ -571,6 +583,7 @@ Bool Buffer_writeAsUTF16(const Buffer buf, U64 i, UnicodeCodePoint codepoint, U8
 		if(bytes)
 			*bytes = 4;
 
+		codepoint -= 0x10000;
 		Buffer_writeU16(buf, i,     0xD800 | (U16)(codepoint >> 10), NULL);
 		Buffer_writeU16(buf, i + 2, 0xDC00 | (U16)(codepoint & 1023), NULL);
 		goto clean;
@@ -599,6 +612,15 @@ Bool Buffer_isUnicode(const Buffer buf, F32 threshold, Bool isUTF16) {
 	if(Buffer_length(buf) & (minWidth - 1))
 		return false;
 
+	//Nearly everything checked is entirely valid, which the bulk validation answers at GB/s.
+	//Only if it isn't does the threshold matter, then it's counted one code point at a time.
+
+	if(!isUTF16 && Unicode_validateUTF8(buf.ptr, Buffer_length(buf), NULL))
+		return true;
+
+	if(isUTF16 && !((U64)buf.ptr & 1) && Unicode_validateUTF16((const U16*) buf.ptr, Buffer_length(buf) / 2, NULL))
+		return true;
+
 	while (i + minWidth <= Buffer_length(buf)) {
 
 		UnicodeCodePointInfo info = (UnicodeCodePointInfo) { 0 };
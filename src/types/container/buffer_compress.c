@@ -0,0 +1,465 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/buffer_compress.c
+
+#include "types/container/buffer_compress.h"
+#include "types/container/buffer.h"
+#include "types/base/platform_types.h"
+#include "types/base/allocator.h"
+#include "types/base/error.h"
+#include "types/base/mathi.h"
+
+//Shuffles that repeat the first N bytes over 16 bytes (row 0 is unused), for matches that overlap their own output
+
+static const U8 BufferCompress_patternShuffle[16][16] = {
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1 },
+	{ 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0 },
+	{ 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 },
+	{ 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0 },
+	{ 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3 },
+	{ 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6, 0, 1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 3, 4 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 1, 2 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 0, 1 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 0 }
+};
+
+#if _SIMD == SIMD_SSE
+	#define BUFFER_COMPRESS_SSE_GUARD
+	#include "types/container/simd/sse/sse_buffer_compress.inc.h"
+#elif _SIMD == SIMD_NEON
+	#define BUFFER_COMPRESS_NEON_GUARD
+	#include "types/container/simd/neon/neon_buffer_compress.inc.h"
+#else
+	#define BUFFER_COMPRESS_NONE_GUARD
+	#include "types/container/simd/none/none_buffer_compress.inc.h"
+#endif
+
+//Matches are at least 4 bytes, don't start in the last 12 bytes and don't end in the last 5.
+//The decoder doesn't need either (it checks every bound), but it keeps the end of a block on the plain literal path.
+
+#define BufferCompress_minMatch 4
+#define BufferCompress_matchStartLimit 12
+#define BufferCompress_lastLiterals 5
+
+#define BufferCompress_hashBits 13        //8Ki positions (16KiB on the stack)
+
+static inline U32 BufferCompress_read32(const U8 *p) {
+	return (U32)p[0] | ((U32)p[1] << 8) | ((U32)p[2] << 16) | ((U32)p[3] << 24);
+}
+
+static inline U32 BufferCompress_hash(const U8 *p) {
+	return (BufferCompress_read32(p) * 2654435761u) >> (32 - BufferCompress_hashBits);
+}
+
+static inline U8 *BufferCompress_writeLength(U8 *op, U64 length) {
+
+	for(; length >= 255; length -= 255)
+		*op++ = 255;
+
+	*op++ = (U8) length;
+	return op;
+}
+
+//offset 0 is the last sequence, which only has literals
+
+static inline U8 *BufferCompress_writeSequence(
+	U8 *op, const U8 *literals, U64 literalCount, U64 offset, U64 matchLength
+) {
+
+	const U64 matchCode = offset ? matchLength - BufferCompress_minMatch : 0;
+	*op++ = (U8)((U64_min(literalCount, 15) << 4) | U64_min(matchCode, 15));
+
+	if(literalCount >= 15)
+		op = BufferCompress_writeLength(op, literalCount - 15);
+
+	Buffer_memcpy(Buffer_createRef(op, literalCount), Buffer_createRefConst(literals, literalCount));
+	op += literalCount;
+
+	if(!offset)
+		return op;
+
+	*op++ = (U8) offset;
+	*op++ = (U8)(offset >> 8);
+
+	if(matchCode >= 15)
+		op = BufferCompress_writeLength(op, matchCode - 15);
+
+	return op;
+}
+
+static inline Bool BufferCompress_readLength(const U8 **ip, const U8 *iend, U64 *length) {
+
+	for(;;) {
+
+		if(*ip >= iend)
+			return false;
+
+		const U8 v = *(*ip)++;
+		*length += v;
+
+		if(v != 255)
+			return true;
+	}
+}
+
+Bool Buffer_compressBlock(Buffer input, Buffer output, U64 *written, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(!written)
+		retError(clean, Error_nullPointer(2, "Buffer_compressBlock()::written is required"));
+
+	const U64 length = Buffer_length(input);
+
+	if(length > BufferCompress_blockSize)
+		retError(clean, Error_outOfBounds(
+			0, length, BufferCompress_blockSize, "Buffer_compressBlock()::input is bigger than a block"
+		));
+
+	if(Buffer_isConstRef(output))
+		retError(clean, Error_constData(1, 0, "Buffer_compressBlock()::output has to be writable"));
+
+	if(Buffer_length(output) < Buffer_compressBlockBound(length))
+		retError(clean, Error_outOfBounds(
+			1, Buffer_length(output), Buffer_compressBlockBound(length),
+			"Buffer_compressBlock()::output has to fit Buffer_compressBlockBound"
+		));
+
+	const U8 *src = input.ptr, *ip = src, *anchor = src, *end = src + length;
+	U8 *op = output.ptrNonConst;
+
+	if (length > BufferCompress_matchStartLimit) {
+
+		U16 table[1 << BufferCompress_hashBits] = { 0 };        //Positions in the block, so every offset fits a U16
+
+		const U8 *matchStartLimit = end - BufferCompress_matchStartLimit;
+		const U8 *matchEnd = end - BufferCompress_lastLiterals;
+
+		while (ip <= matchStartLimit) {
+
+			//Find a match, skipping ahead faster the longer nothing matches (incompressible data)
+
+			const U8 *match = NULL;
+
+			for (U64 misses = 1 << 6; ip <= matchStartLimit; ip += misses++ >> 6) {
+
+				const U32 hash = BufferCompress_hash(ip);
+				const U8 *candidate = src + table[hash];
+				table[hash] = (U16)(ip - src);
+
+				if (candidate < ip && BufferCompress_read32(candidate) == BufferCompress_read32(ip)) {
+					match = candidate;
+					break;
+				}
+			}
+
+			if(!match)
+				break;
+
+			//Extend backwards into the literals, then forwards
+
+			while (ip > anchor && match > src && ip[-1] == match[-1]) {
+				--ip;
+				--match;
+			}
+
+			const U8 *p = ip + BufferCompress_minMatch, *m = match + BufferCompress_minMatch;
+
+			while (p + 16 <= matchEnd) {
+
+				const U64 equal = BufferCompress_equal16(p, m);
+				p += equal;
+				m += equal;
+
+				if(equal < 16)
+					break;
+			}
+
+			while (p < matchEnd && *p == *m) {
+				++p;
+				++m;
+			}
+
+			op = BufferCompress_writeSequence(op, anchor, ip - anchor, ip - match, p - ip);
+			anchor = ip = p;
+
+			if(ip > matchStartLimit)
+				break;
+
+			const U8 *prev = ip - 2;
+			table[BufferCompress_hash(prev)] = (U16)(prev - src);
+		}
+	}
+
+	op = BufferCompress_writeSequence(op, anchor, end - anchor, 0, 0);
+	*written = op - output.ptr;
+
+clean:
+	return s_uccess;
+}
+
+Bool Buffer_decompressBlock(Buffer input, Buffer output, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(Buffer_isConstRef(output) && Buffer_length(output))
+		retError(clean, Error_constData(1, 0, "Buffer_decompressBlock()::output has to be writable"));
+
+	const U8 *ip = input.ptr, *iend = ip + Buffer_length(input);
+	U8 *op = output.ptrNonConst, *ostart = op, *oend = op + Buffer_length(output);
+
+	for(;;) {
+
+		if(ip >= iend)
+			retError(clean, Error_invalidState(0, "Buffer_decompressBlock() input is truncated"));
+
+		const U8 token = *ip++;
+
+		//Literals, copied 16 bytes at a time if there's space to overshoot
+
+		U64 literals = token >> 4;
+
+		if(literals == 15 && !BufferCompress_readLength(&ip, iend, &literals))
+			retError(clean, Error_invalidState(1, "Buffer_decompressBlock() literal length is truncated"));
+
+		if(literals > (U64)(iend - ip) || literals > (U64)(oend - op))
+			retError(clean, Error_invalidState(2, "Buffer_decompressBlock() literals out of bounds"));
+
+		if ((U64)(iend - ip) >= literals + 16 && (U64)(oend - op) >= literals + 16)
+			for(U64 i = 0; i < literals; i += 16)
+				BufferCompress_copy16(op + i, ip + i);
+
+		else Buffer_memcpy(Buffer_createRef(op, literals), Buffer_createRefConst(ip, literals));
+
+		op += literals;
+		ip += literals;
+
+		if(ip == iend)
+			break;
+
+		//Match
+
+		if((U64)(iend - ip) < 2)
+			retError(clean, Error_invalidState(3, "Buffer_decompressBlock() offset is truncated"));
+
+		const U64 offset = ip[0] | ((U64)ip[1] << 8);
+		ip += 2;
+
+		if(!offset || offset > (U64)(op - ostart))
+			retError(clean, Error_invalidState(4, "Buffer_decompressBlock() offset out of bounds"));
+
+		U64 matchLength = token & 15;
+
+		if(matchLength == 15 && !BufferCompress_readLength(&ip, iend, &matchLength))
+			retError(clean, Error_invalidState(5, "Buffer_decompressBlock() match length is truncated"));
+
+		matchLength += BufferCompress_minMatch;
+
+		if(matchLength > (U64)(oend - op))
+			retError(clean, Error_invalidState(6, "Buffer_decompressBlock() match out of bounds"));
+
+		const U8 *match = op - offset;
+
+		//A match that's at least 16 back can be copied 16 bytes at a time.
+		//Closer ones overlap what they write, so the first offset bytes are repeated into 16 bytes once.
+		//Every multiple of offset after that is the same 16 bytes again.
+
+		if ((U64)(oend - op) >= matchLength + 16) {
+
+			if (offset >= 16)
+				for(U64 i = 0; i < matchLength; i += 16)
+					BufferCompress_copy16(op + i, match + i);
+
+			else {
+
+				BufferCompress_pattern16(op, match, offset);
+
+				const U64 step = 16 - 16 % offset;
+
+				for(U64 i = step; i < matchLength; i += step)
+					BufferCompress_copy16(op + i, op);
+			}
+		}
+
+		else for(U64 i = 0; i < matchLength; ++i)
+			op[i] = match[i];
+
+		op += matchLength;
+	}
+
+	if(op != oend)
+		retError(clean, Error_invalidState(7, "Buffer_decompressBlock() didn't fill output"));
+
+clean:
+	return s_uccess;
+}
+
+Bool BufferCompress_appendBlock(
+	Buffer input,
+	ListU8 *data,
+	BufferCompressBlock *block,
+	const Allocator *alloc,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+
+	if(!data || !block)
+		retError(clean, Error_nullPointer(!data ? 1 : 2, "BufferCompress_appendBlock()::data and block are required"));
+
+	const U64 length = Buffer_length(input);
+	const U64 start = data->length;
+	const U64 bound = Buffer_compressBlockBound(length);
+
+	gotoIfError3(clean, ListU8_resize(data, start + bound, alloc, e_rr));
+
+	U64 written = 0;
+	gotoIfError3(clean, Buffer_compressBlock(input, Buffer_createRef(data->ptrNonConst + start, bound), &written, e_rr));
+
+	//Store it if compressing didn't help
+
+	if (written >= length) {
+		Buffer_memcpy(Buffer_createRef(data->ptrNonConst + start, length), input);
+		written = length;
+	}
+
+	gotoIfError3(clean, ListU8_resize(data, start + written, alloc, e_rr));
+	*block = (BufferCompressBlock) { .size = (U32) written, .crc32c = Buffer_crc32c(input) };
+
+clean:
+	return s_uccess;
+}
+
+Bool BufferCompress_decodeBlock(Buffer input, BufferCompressBlock block, Buffer output, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	const U64 length = Buffer_length(output);
+
+	if(Buffer_length(input) != block.size || block.size > length)
+		retError(clean, Error_invalidState(0, "BufferCompress_decodeBlock() block size is invalid"));
+
+	if(Buffer_isConstRef(output) && length)
+		retError(clean, Error_constData(2, 0, "BufferCompress_decodeBlock()::output has to be writable"));
+
+	if(block.size == length) {
+		if(input.ptr != output.ptr)        //Stored blocks can be read in place
+			Buffer_memcpy(output, input);
+	}
+
+	else gotoIfError3(clean, Buffer_decompressBlock(input, output, e_rr));
+
+	if(Buffer_crc32c(output) != block.crc32c)
+		retError(clean, Error_invalidState(1, "BufferCompress_decodeBlock() checksum mismatch"));
+
+clean:
+	return s_uccess;
+}
+
+Bool Buffer_compress(Buffer input, const Allocator *alloc, Buffer *output, Error *e_rr) {
+
+	Bool s_uccess = true;
+	ListU8 data = (ListU8) { 0 };
+
+	if(!output)
+		retError(clean, Error_nullPointer(2, "Buffer_compress()::output is required"));
+
+	if(output->ptr)
+		retError(clean, Error_invalidOperation(0, "Buffer_compress()::output is already allocated, indicating memleak"));
+
+	const U64 length = Buffer_length(input);
+	const U64 blocks = BufferCompress_blockCount(length);
+	const U64 tableSize = blocks * sizeof(BufferCompressBlock);
+
+	gotoIfError3(clean, ListU8_reserve(&data, tableSize + length / 2, alloc, e_rr));
+	gotoIfError3(clean, ListU8_resize(&data, tableSize, alloc, e_rr));
+
+	for (U64 i = 0; i < blocks; ++i) {
+
+		const U64 off = i * BufferCompress_blockSize;
+		const U64 len = U64_min(length - off, BufferCompress_blockSize);
+
+		BufferCompressBlock block;
+		gotoIfError3(clean, BufferCompress_appendBlock(Buffer_createRefConst(input.ptr + off, len), &data, &block, alloc, e_rr));
+
+		Buffer_memcpy(
+			Buffer_createRef(data.ptrNonConst + i * sizeof(BufferCompressBlock), sizeof(block)),
+			Buffer_createRefConst(&block, sizeof(block))
+		);
+	}
+
+	gotoIfError3(clean, Buffer_createCopy(ListU8_bufferConst(data), alloc, output, e_rr));
+
+clean:
+	ListU8_free(&data, alloc);
+	return s_uccess;
+}
+
+Bool Buffer_decompress(Buffer input, Buffer output, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	const U64 length = Buffer_length(output);
+	const U64 blocks = BufferCompress_blockCount(length);
+	const U64 tableSize = blocks * sizeof(BufferCompressBlock);
+
+	if(Buffer_length(input) < tableSize)
+		retError(clean, Error_invalidState(0, "Buffer_decompress() input is too small for its block table"));
+
+	U64 off = tableSize;
+
+	for (U64 i = 0; i < blocks; ++i) {
+
+		BufferCompressBlock block;
+
+		Buffer_memcpy(
+			Buffer_createRef(&block, sizeof(block)),
+			Buffer_createRefConst(input.ptr + i * sizeof(BufferCompressBlock), sizeof(block))
+		);
+
+		if(block.size > Buffer_length(input) - off)
+			retError(clean, Error_invalidState(1, "Buffer_decompress() block out of bounds"));
+
+		const U64 start = i * BufferCompress_blockSize;
+
+		gotoIfError3(clean, BufferCompress_decodeBlock(
+			Buffer_createRefConst(input.ptr + off, block.size),
+			block,
+			Buffer_createRef(output.ptrNonConst + start, U64_min(length - start, BufferCompress_blockSize)),
+			e_rr
+		));
+
+		off += block.size;
+	}
+
+	if(off != Buffer_length(input))
+		retError(clean, Error_invalidState(2, "Buffer_decompress() input has trailing data"));
+
+clean:
+	return s_uccess;
+}
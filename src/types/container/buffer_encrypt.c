@@ -23,6 +23,7 @@
 #include "types/base/error.h"
 #include "types/container/buffer_encrypt.h"
 #include "types/container/buffer.h"
+#include "types/container/job_queue.h"
 #include "types/container/simd/aes_encryption_helpers.h"
 #include "types/math/u128_base.h"
 #include "types/math/vec4i_swizzle.h"
@@ -36,7 +37,7 @@
 #endif
 
 //-1: Uninitialized
-//0: No support (No fallback yet though)
+//0: No support, the constant-time software fallback is used (buffer_encrypt_software.c)
 //1: Support for AES-NI (or AESE with NEON)
 //2: Support for AES-NI, VAES, AVX2, VPCLMUL, AVX512VL, AVX512BM
 //3: Support for AES-NI, VAES, AVX2, VPCLMUL, AVX512VL, AVX512BM, AVX512F, AVX512DQ
@@ -98,10 +99,29 @@ static I8 cryptoState = -1;
 
 		cryptoState = 2;                    //256-bit VAES path
 	}
+#elif _SIMD == SIMD_NEON
+	void SIMD_createCryptoState() {
+
+		if (cryptoState >= 0)
+			return;
+
+		const ECPUFeatures required = ECPUFeatures_HwAES | ECPUFeatures_PCLMULQDQ;
+		cryptoState = (Platform_detectCPUFeatures() & required) == required ? 1 : 0;
+	}
 #else
-	void SIMD_createCryptoState() { }        //TODO: Use this for presence of crypto in the first place
+	void SIMD_createCryptoState() { cryptoState = 0; }
 #endif
 
+static Bool aesForceSoftware = false;
+
+void Buffer_aesForceSoftware(Bool force) {
+	aesForceSoftware = force;
+}
+
+static inline Bool AES_isSoftware() {
+	return !cryptoState || aesForceSoftware;
+}
+
 //Explanation of algorithm; AES256 GCM + GMAC
 //https://www.alexeyshmalko.com/20200319144641/
 //https://www.youtube.com/watch?v=V2TlG3JbGp0
@@ -132,13 +152,9 @@ static I8 cryptoState = -1;
 //For "encrypt" we use AES CTR as explained by the intel paper:
 //https://www.intel.com/content/dam/doc/white-paper/advanced-encryption-standard-new-instructions-set-paper.pdf
 
-//AES_subWord can be used by as fallback for encryption.
+//Reference S-box, used by the key expansion of the software path (and the block functions without SIMD).
 //No lookup tables, those are unsafe.
-//TODO: Speedup this fallback, it's made to be a reference & to be secure.
-//        Since most devices have AES-NI, no time was spent optimizing this.
-//        If you're encrypting a lot of data... goodluck and see you in 2039
-//          (Don't use for perf critical without AES-NI support)
-//        Investigate Bitslicing, Boyar-Peralta or something like it.
+//It's slow, but it only runs 10 or 14 times per key; en/decrypting uses the bitsliced AES_encryptBitsliced instead.
 
 static inline U8 AES_xtime(U8 x) {
 	return (U8)((x << 1) ^ ((x >> 7) * 0x1B));
@@ -184,7 +200,7 @@ static inline U8 AES_sbox(U8 x) {
 	return AES_affine(AES_gfInv(x));
 }
 
-MIGHT_BE_UNUSED static inline U32 AES_subWord(U32 w) {
+static inline U32 AES_subWord(U32 w) {
 	return
 		((U32)AES_sbox((U8)(w >>  0)) <<  0) |
 		((U32)AES_sbox((U8)(w >>  8)) <<  8) |
@@ -192,6 +208,34 @@ MIGHT_BE_UNUSED static inline U32 AES_subWord(U32 w) {
 		((U32)AES_sbox((U8)(w >> 24)) << 24);
 }
 
+static inline U32 AES_rotWord(U32 a) {
+	return (a >> 8) | (a << 24);
+}
+
+//Implemented from
+//https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html#text=_mm_aeskeygenassist_si128&ig_expand=6746,293
+static inline I32x4 AES_keyGenAssistSoftware(I32x4 a, U8 i) {
+
+	if(i >= 11)
+		return I32x4_zero();
+
+	U32 x1 = I32x4_y(a);
+	U32 x3 = I32x4_w(a);
+
+	const U32 rcons[] = { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36 };
+	const U32 rcon = rcons[i];
+
+	x1 = AES_subWord(x1);
+	x3 = AES_subWord(x3);
+
+	return I32x4_create4(
+		x1,
+		AES_rotWord(x1) ^ rcon,
+		x3,
+		AES_rotWord(x3) ^ rcon
+	);
+}
+
 #if _SIMD == SIMD_NEON
 	#include "types/container/simd/neon/neon_buffer_encrypt.inc.h"
 #elif _SIMD == SIMD_SSE
@@ -224,12 +268,16 @@ static inline I32x4 AESEncryptionContext_expandKey1(const I32x4 im1, const I32x4
 	return AESEncryptionContext_expandKeyN(im1, I32x4_wwww(im2));
 }
 
-static inline I32x4 AESEncryptionContext_expandKey2(const I32x4 im1, const I32x4 im3) {
-	return AESEncryptionContext_expandKeyN(im3, I32x4_zzzz(AES_keyGenAssist(im1, 0)));
+static inline I32x4 AESEncryptionContext_keyGenAssist(I32x4 a, U8 i, Bool software) {
+	return software ? AES_keyGenAssistSoftware(a, i) : AES_keyGenAssist(a, i);
+}
+
+static inline I32x4 AESEncryptionContext_expandKey2(const I32x4 im1, const I32x4 im3, Bool software) {
+	return AESEncryptionContext_expandKeyN(im3, I32x4_zzzz(AESEncryptionContext_keyGenAssist(im1, 0, software)));
 }
 
 static inline void AESEncryptionContext_expandKey(
-	const U32 *restrict key, I32x4 *restrict k/*[15]*/, const EBufferEncryptionType encryptionType
+	const U32 *restrict key, I32x4 *restrict k/*[15]*/, const EBufferEncryptionType encryptionType, Bool software
 ) {
 
 	k[0] = I32x4_load4(key);
@@ -244,7 +292,9 @@ static inline void AESEncryptionContext_expandKey(
 		I32x4 im1 = k[0];
 
 		for (U8 i = 0; i < 10; ++i)
-			k[i + 1] = (im1 = AESEncryptionContext_expandKey1(im1, AES_keyGenAssist(im1, i + 1)));
+			k[i + 1] = (im1 = AESEncryptionContext_expandKey1(
+				im1, AESEncryptionContext_keyGenAssist(im1, i + 1, software)
+			));
 
 		return;
 	}
@@ -256,10 +306,10 @@ static inline void AESEncryptionContext_expandKey(
 
 	for (U8 i = 0, j = 2; i < 7; ++i, j += 2) {
 
-		k[j] = (im1 = AESEncryptionContext_expandKey1(im1, AES_keyGenAssist(im3, i + 1)));
+		k[j] = (im1 = AESEncryptionContext_expandKey1(im1, AESEncryptionContext_keyGenAssist(im3, i + 1, software)));
 
 		if(j + 1 < 15)
-			k[j + 1] = (im3 = AESEncryptionContext_expandKey2(im1, im3));
+			k[j + 1] = (im3 = AESEncryptionContext_expandKey2(im1, im3, software));
 	}
 }
 
@@ -935,10 +985,29 @@ __forceinline__ static I32x4x5 AESEncryptionContext_blockHashAndGhash4(
 	void AESEncryptionContext_ghashTable4(I32x4 *restrict H, I32x4 H2, I32x4 H3, I32x4 H4);
 #endif
 
+//tag * H for the software path, it takes and returns the same form as ghashN (a isn't byte swapped yet)
+static inline I32x4 AESEncryptionContext_ghashSoftware(I32x4 a, I32x4 H) {
+	I32x4 clmuls[3];
+	AES_clmulSoftware(I32x4_swapEndianness(a), H, clmuls);
+	return AESEncryptionContext_ghashReduceClMul(clmuls[0], clmuls[1], clmuls[2]);
+}
+
 static inline I32x4 AESEncryptionContext_ghashN(I32x4 *restrict a, const I32x4 *restrict H, U8 N, U8 use256Or512) {
 
 	(void)use256Or512;
 
+	//Software only has H, so it's done as (((a0 * H) ^ a1) * H ^ ...) * H instead of a0 * H^N ^ a1 * H^(N - 1) ...
+
+	if (AES_isSoftware()) {
+
+		I32x4 res = a[0];
+
+		for (U8 i = 1; i < N; ++i)
+			res = I32x4_xor(AESEncryptionContext_ghashSoftware(res, H[0]), a[i]);
+
+		return AESEncryptionContext_ghashSoftware(res, H[0]);
+	}
+
 	I32x4 clmuls[3];
 
 	#ifdef HAS_CLMUL64x4
@@ -1400,13 +1469,50 @@ Bool Buffer_aesExpertCreate(
 			blockSize = oneTimeHint <= 256 ? blockSize : 8;
 	}
 
+	//The software path always does 8 blocks of AES at once and only needs H for GHASH
+
+	const Bool software = AES_isSoftware();
+
+	if (software) {
+		blockSize = 1;
+		use256Or512Real = 0;
+	}
+
 	if (use256Or512) *use256Or512 = use256Or512Real;
 	if (blockSizeMax) *blockSizeMax = blockSize;
 
 	//Get key that's gonna be used for aes blocks
 
 	ctx->encryptionType = type;
-	AESEncryptionContext_expandKey(key.u32x8, ctx->key, ctx->encryptionType);
+	AESEncryptionContext_expandKey(key.u32x8, ctx->key, ctx->encryptionType, software);
+
+	I32x4 Y0 = iv;
+	ctx->iv = Y0;
+
+	I32x4_setWRef(&Y0, I32_swapEndianness(1));
+
+	if (software) {
+
+		//H and EKY0 (see below) in one go
+
+		const U8 rounds = type == EBufferEncryptionType_AES256GCM ? 14 : 10;
+
+		I32x4 rk[15 * 8];
+		I32x4 blocks[AES_bitslicedBlocks] = { 0 };
+		I32x4 encrypted[AES_bitslicedBlocks];
+		blocks[1] = Y0;
+
+		AES_bitsliceKeys(ctx->key, rounds, rk);
+		AES_encryptBitsliced(blocks, encrypted, rk, rounds);
+
+		ctx->H[0] = I32x4_swapEndianness(encrypted[0]);
+		ctx->EKY0 = encrypted[1];
+		ctx->tag = I32x4_zero();
+
+		Buffer_clearAllSecure(Buffer_createRef(rk, sizeof(rk)));
+		Buffer_clearAllSecure(Buffer_createRef(encrypted, sizeof(encrypted)));
+		goto clean;
+	}
 
 	//Prepare ghash
 
@@ -1422,11 +1528,6 @@ Bool Buffer_aesExpertCreate(
 
 	//Compute final tag xor
 
-	I32x4 Y0 = iv;
-	ctx->iv = Y0;
-
-	I32x4_setWRef(&Y0, I32_swapEndianness(1));
-
 	ctx->EKY0 = AESEncryptionContext_blockHash(Y0, ctx->key, ctx->encryptionType);
 	ctx->tag = I32x4_zero();
 
@@ -1988,9 +2089,73 @@ static inline void Buffer_prefetch(Buffer data) {
 	#endif
 }
 
+//Software path; AES_bitslicedBlocks counters are encrypted at once, then each block is xored and hashed.
+//Like handleBlocks the tail block is zero padded for GHASH.
+static void AESEncryptionContext_handleBlocksSoftware(
+	AESEncryptionContext *restrict ctx, U8 *restrict targetPtr, U64 targetLen, Bool isEncrypt, U32 offsetInBlocks
+) {
+
+	if (!targetLen)
+		return;
+
+	const U8 rounds = ctx->encryptionType == EBufferEncryptionType_AES256GCM ? 14 : 10;
+
+	I32x4 rk[15 * 8];
+	AES_bitsliceKeys(ctx->key, rounds, rk);
+
+	I32x4 counters[AES_bitslicedBlocks];
+	I32x4 keyStream[AES_bitslicedBlocks];
+
+	U32 counterForIv = offsetInBlocks + 2;
+	I32x4 tag = ctx->tag;
+	const I32x4 H = ctx->H[0];
+
+	for (U64 i = 0; i < targetLen; i += sizeof(keyStream)) {
+
+		for (U8 j = 0; j < AES_bitslicedBlocks; ++j)
+			counters[j] = I32x4_setWCopy(ctx->iv, (I32)U32_swapEndianness(counterForIv + j));
+
+		counterForIv += AES_bitslicedBlocks;
+		AES_encryptBitsliced(counters, keyStream, rk, rounds);
+
+		const U64 batch = U64_min(targetLen - i, sizeof(keyStream));
+
+		for (U64 j = 0; j < batch; j += sizeof(I32x4)) {
+
+			U8 *ptr = targetPtr + i + j;
+			const U8 len = (U8) U64_min(batch - j, sizeof(I32x4));
+
+			const I32x4 v = len == sizeof(I32x4) ? *(const I32x4*)ptr : AESEncryptionContext_fetchBlockTail(ptr, len);
+			const I32x4 res = I32x4_xor(v, keyStream[j >> 4]);
+			I32x4 cipherText = isEncrypt ? res : v;
+
+			if (len == sizeof(I32x4))
+				*(I32x4*)ptr = res;
+
+			else {
+				Buffer_memcpy(Buffer_createRef(ptr, len), Buffer_createRefConst(&res, len));
+				Buffer_unsetAllBits(Buffer_createRef((U8*)&cipherText + len, sizeof(I32x4) - len), NULL);
+			}
+
+			tag = AESEncryptionContext_ghashSoftware(I32x4_xor(cipherText, tag), H);
+		}
+	}
+
+	ctx->tag = tag;
+
+	Buffer_clearAllSecure(Buffer_createRef(rk, sizeof(rk)));
+	Buffer_clearAllSecure(Buffer_createRef(keyStream, sizeof(keyStream)));
+}
+
 static inline void Buffer_aesExpertEncUpdateFast(
 	AESEncryptionContext *restrict ctx, Buffer data, U32 offsetInBlocks, U8 blockSizeMax, U8 use256Or512
 ) {
+
+	if (AES_isSoftware()) {
+		AESEncryptionContext_handleBlocksSoftware(ctx, data.ptrNonConst, Buffer_length(data), true, offsetInBlocks);
+		return;
+	}
+
 	Buffer_prefetch(data);
 	AESEncryptionContext_handleBlocks(
 		ctx, data.ptrNonConst, Buffer_length(data), true, offsetInBlocks, blockSizeMax, use256Or512
@@ -2000,6 +2165,12 @@ static inline void Buffer_aesExpertEncUpdateFast(
 static inline void Buffer_aesExpertDecUpdateFast(
 	AESEncryptionContext *restrict ctx, Buffer data, U32 offsetInBlocks, U8 blockSizeMax, U8 use256Or512
 ) {
+
+	if (AES_isSoftware()) {
+		AESEncryptionContext_handleBlocksSoftware(ctx, data.ptrNonConst, Buffer_length(data), false, offsetInBlocks);
+		return;
+	}
+
 	Buffer_prefetch(data);
 	AESEncryptionContext_handleBlocks(
 		ctx, data.ptrNonConst, Buffer_length(data), false, offsetInBlocks, blockSizeMax, use256Or512
@@ -2018,6 +2189,182 @@ void Buffer_aesExpertDecUpdate(
 	Buffer_aesExpertDecUpdateFast(ctx, data, offsetInBlocks, blockSizeMax, use256Or512);
 }
 
+static inline void AESEncryptionContext_update(
+	AESEncryptionContext *restrict ctx, Buffer data, Bool isEncrypt, U32 offsetInBlocks, U8 blockSizeMax, U8 use256Or512
+) {
+	if(isEncrypt)
+		switch (blockSizeMax) {
+			case 1:        Buffer_aesExpertEncUpdateFast(ctx, data, offsetInBlocks,   1, use256Or512);    break;
+			case 2:        Buffer_aesExpertEncUpdateFast(ctx, data, offsetInBlocks,   2, use256Or512);    break;
+			case 4:        Buffer_aesExpertEncUpdateFast(ctx, data, offsetInBlocks,   4, use256Or512);    break;
+			case 8:        Buffer_aesExpertEncUpdateFast(ctx, data, offsetInBlocks,   8, use256Or512);    break;
+			case 16:    Buffer_aesExpertEncUpdateFast(ctx, data, offsetInBlocks,  16, use256Or512);    break;
+		}
+
+	else switch (blockSizeMax) {
+		case 1:        Buffer_aesExpertDecUpdateFast(ctx, data, offsetInBlocks,   1, use256Or512);    break;
+		case 2:        Buffer_aesExpertDecUpdateFast(ctx, data, offsetInBlocks,   2, use256Or512);    break;
+		case 4:        Buffer_aesExpertDecUpdateFast(ctx, data, offsetInBlocks,   4, use256Or512);    break;
+		case 8:        Buffer_aesExpertDecUpdateFast(ctx, data, offsetInBlocks,   8, use256Or512);    break;
+		case 16:    Buffer_aesExpertDecUpdateFast(ctx, data, offsetInBlocks,  16, use256Or512);    break;
+	}
+}
+
+//Parallel GCM.
+//CTR only needs the block counter, so every chunk is en/decrypted on its own starting from its first counter.
+//GHASH is linear: the tag of a || b is tag(a) * H^blocks(b) ^ tag(b) where tag(b) starts from 0.
+//So every chunk is hashed from a zero tag and the partial tags are folded in order after,
+// which gives exactly the ciphertext and tag of the serial path.
+
+#define Buffer_aesParallelMinChunk (4 * MIBI)
+#define Buffer_aesParallelMaxChunks 256
+
+typedef struct AESEncryptionParallel {
+
+	const AESEncryptionContext *ctx;
+	U8 *ptr;
+	U64 length, chunks, chunkLength;        //chunkLength is a multiple of 16, the last chunk gets the rest
+
+	Bool isEncrypt;
+	U8 blockSizeMax, use256Or512, padding[5];
+
+	I32x4 tags[Buffer_aesParallelMaxChunks];
+
+	//Set by the job that did the chunk, the queue's own success also covers jobs other callers pushed to it
+
+	Bool done[Buffer_aesParallelMaxChunks];
+
+} AESEncryptionParallel;
+
+static U64 AESEncryptionParallel_bound(const AESEncryptionParallel *p, U64 chunk) {
+	return chunk == p->chunks ? p->length : p->chunkLength * chunk;
+}
+
+static Bool AESEncryptionParallel_job(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+
+	AESEncryptionParallel *p = (AESEncryptionParallel*) data;
+	AESEncryptionContext ctx = *p->ctx;
+
+	for (U64 c = begin; c < end; ++c) {
+
+		const U64 start = AESEncryptionParallel_bound(p, c);
+		const Buffer chunk = Buffer_createRef(p->ptr + start, AESEncryptionParallel_bound(p, c + 1) - start);
+
+		ctx.tag = I32x4_zero();
+		AESEncryptionContext_update(&ctx, chunk, p->isEncrypt, (U32)(start >> 4), p->blockSizeMax, p->use256Or512);
+		p->tags[c] = ctx.tag;
+		p->done[c] = true;
+	}
+
+	AESEncryptionContext_clear(&ctx);
+	return true;
+}
+
+//a * b, both in the form of ctx->H (the same multiply that builds the H^i table)
+static inline I32x4 AESEncryptionContext_mulH(I32x4 a, I32x4 b) {
+
+	if (AES_isSoftware()) {
+		I32x4 clmuls[3];
+		AES_clmulSoftware(a, b, clmuls);
+		return I32x4_swapEndianness(AESEncryptionContext_ghashReduceClMul(clmuls[0], clmuls[1], clmuls[2]));
+	}
+
+	I32x4 clmul01 = I32x4_clmul64(a, b, 0x01);
+	I32x4 clmul10 = I32x4_clmul64(a, b, 0x10);
+	I32x4 clmul00 = I32x4_clmul64(a, b, 0x00);
+	I32x4 clmul11 = I32x4_clmul64(a, b, 0x11);
+	clmul01 = I32x4_xor(clmul01, clmul10);
+
+	return I32x4_swapEndianness(AESEncryptionContext_ghashReduceClMul(clmul00, clmul01, clmul11));
+}
+
+//H^n for n >= 1 by square and multiply
+static inline I32x4 AESEncryptionContext_powH(const AESEncryptionContext *restrict ctx, U64 n) {
+
+	I32x4 result = ctx->H[0];
+	I8 top = 63;
+
+	while(!(n >> top))
+		--top;
+
+	for (I8 i = top - 1; i >= 0; --i) {
+
+		result = AESEncryptionContext_mulH(result, result);
+
+		if((n >> i) & 1)
+			result = AESEncryptionContext_mulH(result, ctx->H[0]);
+	}
+
+	return result;
+}
+
+//Returns false if the buffer isn't worth splitting (or there's no queue), the caller then does it serially.
+static inline Bool AESEncryptionContext_updateParallel(
+	AESEncryptionContext *restrict ctx,
+	Buffer data,
+	Bool isEncrypt,
+	U8 blockSizeMax,
+	U8 use256Or512,
+	JobQueue *queue,
+	Bool *restrict handled,
+	Error *restrict e_rr
+) {
+
+	Bool s_uccess = true;
+	AESEncryptionParallel p = (AESEncryptionParallel) { 0 };
+	*handled = false;
+
+	//A few chunks per thread to even out the load (one thread might be busy with something else)
+
+	const U64 len = Buffer_length(data);
+	const U64 threads = queue ? JobQueue_threadCount(queue) : 1;
+
+	const U64 chunks = U64_min(U64_min(threads * 4, len / Buffer_aesParallelMinChunk), Buffer_aesParallelMaxChunks);
+
+	if (threads <= 1 || chunks <= 1)
+		goto clean;
+
+	p = (AESEncryptionParallel) {
+		.ctx = ctx,
+		.ptr = data.ptrNonConst,
+		.length = len,
+		.chunks = chunks,
+		.chunkLength = (len / chunks) &~ (U64)15,
+		.isEncrypt = isEncrypt,
+		.blockSizeMax = blockSizeMax,
+		.use256Or512 = use256Or512
+	};
+
+	gotoIfError3(clean, JobQueue_parallelFor(queue, chunks, 1, AESEncryptionParallel_job, &p, NULL, e_rr));
+	gotoIfError3(clean, JobQueue_wait(queue, e_rr));
+
+	for(U64 c = 0; c < chunks; ++c)
+		if(!p.done[c])
+			retError(clean, Error_invalidState(0, "AESEncryptionContext_updateParallel() a chunk didn't run"));
+
+	//Fold the partial tags in order, every chunk but the last has the same number of blocks
+
+	const I32x4 Hchunk = AESEncryptionContext_powH(ctx, p.chunkLength >> 4);
+	const U64 lastLength = len - p.chunkLength * (chunks - 1);
+	const I32x4 Hlast = AESEncryptionContext_powH(ctx, (lastLength + 15) >> 4);
+
+	I32x4 tag = ctx->tag;
+
+	for (U64 c = 0; c < chunks; ++c) {
+		I32x4 Hc = c + 1 == chunks ? Hlast : Hchunk;
+		tag = I32x4_xor(AESEncryptionContext_ghashN(&tag, &Hc, 1, 0), p.tags[c]);
+	}
+
+	ctx->tag = tag;
+	*handled = true;
+
+clean:
+	Buffer_clearAllSecure(Buffer_createRef(p.tags, sizeof(p.tags)));
+	return s_uccess;
+}
+
 static inline Bool AESEncryptionContext_encrypt(const BufferEncrypt *restrict encrypt, Error *restrict e_rr) {
 
 	Bool s_uccess = true;
@@ -2048,14 +2395,21 @@ static inline Bool AESEncryptionContext_encrypt(const BufferEncrypt *restrict en
 	U8 use256Or512;
 	gotoIfError3(clean, AESEncryptionContext_create(encrypt, &ctx, &blockSizeMax, &use256Or512, e_rr));
 
-	if(encrypt->target)
-		switch (blockSizeMax) {
-			case 1:        Buffer_aesExpertEncUpdateFast(&ctx, *encrypt->target, 0,   1, use256Or512);    break;
-			case 2:        Buffer_aesExpertEncUpdateFast(&ctx, *encrypt->target, 0,   2, use256Or512);    break;
-			case 4:        Buffer_aesExpertEncUpdateFast(&ctx, *encrypt->target, 0,   4, use256Or512);    break;
-			case 8:        Buffer_aesExpertEncUpdateFast(&ctx, *encrypt->target, 0,   8, use256Or512);    break;
-			case 16:    Buffer_aesExpertEncUpdateFast(&ctx, *encrypt->target, 0,  16, use256Or512);    break;
-		}
+	Bool handled = false;
+
+	if(
+		encrypt->target && encrypt->queue &&
+		!AESEncryptionContext_updateParallel(
+			&ctx, *encrypt->target, true, blockSizeMax, use256Or512, encrypt->queue, &handled, e_rr
+		)
+	) {
+		AESEncryptionContext_clear(&ctx);
+		s_uccess = false;
+		goto clean;
+	}
+
+	if(encrypt->target && !handled)
+		AESEncryptionContext_update(&ctx, *encrypt->target, true, 0, blockSizeMax, use256Or512);
 
 	//Finish encryption by appending tag for authentication / verification that the data isn't messed with
 
@@ -2149,14 +2503,22 @@ static inline Bool AESEncryptionContext_decrypt(const BufferEncrypt *restrict de
 	U8 use256Or512;
 	gotoIfError3(clean, AESEncryptionContext_create(decrypt, &ctx, &blockSizeMax, &use256Or512, e_rr));
 
-	if(decrypt->target)
-		switch (blockSizeMax) {
-			case 1:        Buffer_aesExpertDecUpdateFast(&ctx, *decrypt->target, 0,   1, use256Or512);    break;
-			case 2:        Buffer_aesExpertDecUpdateFast(&ctx, *decrypt->target, 0,   2, use256Or512);    break;
-			case 4:        Buffer_aesExpertDecUpdateFast(&ctx, *decrypt->target, 0,   4, use256Or512);    break;
-			case 8:        Buffer_aesExpertDecUpdateFast(&ctx, *decrypt->target, 0,   8, use256Or512);    break;
-			case 16:    Buffer_aesExpertDecUpdateFast(&ctx, *decrypt->target, 0,  16, use256Or512);    break;
-		}
+	Bool handled = false;
+
+	if(
+		decrypt->target && decrypt->queue &&
+		!AESEncryptionContext_updateParallel(
+			&ctx, *decrypt->target, false, blockSizeMax, use256Or512, decrypt->queue, &handled, e_rr
+		)
+	) {
+		AESEncryptionContext_clear(&ctx);
+		Buffer_clearAllSecure(*decrypt->target);        //Part of it might be decrypted, but it's not verified
+		s_uccess = false;
+		goto clean;
+	}
+
+	if(decrypt->target && !handled)
+		AESEncryptionContext_update(&ctx, *decrypt->target, false, 0, blockSizeMax, use256Or512);
 
 	U64 aadLen = decrypt->additionalData ? Buffer_length(*decrypt->additionalData) : 0;
 	U64 dataLen = decrypt->target ? Buffer_length(*decrypt->target) : 0;
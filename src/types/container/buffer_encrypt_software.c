@@ -0,0 +1,352 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/buffer_encrypt_software.c
+
+#include "types/container/simd/aes_encryption_helpers.h"
+#include "types/base/buffer_base.h"
+
+//Constant-time fallback for CPUs without AES and carry-less multiply instructions.
+//
+//AES is bitsliced over AES_bitslicedBlocks (8) blocks: plane b holds bit b of every state byte,
+// where bit j of a byte is block j (so byte i of plane b is bit b of byte i of all 8 blocks).
+//SubBytes is then a boolean circuit (Boyar-Peralta) over the 8 planes and ShiftRows/MixColumns are byte shuffles,
+// so there's no lookup table and nothing indexed or branched on secret data.
+//https://eprint.iacr.org/2009/191.pdf
+//https://www.bearssl.org/constanttime.html
+//
+//GHASH uses integer multiplies that keep only every 4th bit, which can't carry into the next bit that's kept.
+
+typedef union AESBitsliced {
+	I32x4 v[AES_bitslicedBlocks];
+	U8 u8[AES_bitslicedBlocks][16];
+} AESBitsliced;
+
+//Transposes the 8x8 bit matrix in x (byte = row)
+static inline U64 AES_transpose8x8(U64 x) {
+	U64 t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AA;
+	x ^= t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCC;
+	x ^= t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0;
+	return x ^ t ^ (t << 28);
+}
+
+//Blocks to planes and back, the transpose is its own inverse so it's the same operation
+
+static inline void AES_bitslice(AESBitsliced *restrict out, const AESBitsliced *restrict in) {
+
+	for (U8 i = 0; i < 16; ++i) {
+
+		U64 x = 0;
+
+		for (U8 j = 0; j < 8; ++j)
+			x |= (U64)in->u8[j][i] << (j << 3);
+
+		x = AES_transpose8x8(x);
+
+		for (U8 j = 0; j < 8; ++j)
+			out->u8[j][i] = (U8)(x >> (j << 3));
+	}
+}
+
+void AES_bitsliceKeys(const I32x4 *restrict k, U8 rounds, I32x4 *restrict rk) {
+
+	//A key is the same for every block, so a bit of it just becomes 0x00 or 0xFF in that plane
+
+	for (U8 r = 0; r <= rounds; ++r) {
+
+		AESBitsliced planes;
+		const U8 *key = (const U8*) &k[r];
+
+		for (U8 b = 0; b < 8; ++b)
+			for (U8 i = 0; i < 16; ++i)
+				planes.u8[b][i] = (U8) -((key[i] >> b) & 1);
+
+		for (U8 b = 0; b < 8; ++b)
+			rk[r * 8 + b] = planes.v[b];
+
+		Buffer_clearAllSecure(Buffer_createRef(&planes, sizeof(planes)));
+	}
+}
+
+//Boyar-Peralta S-box circuit, q[b] is the plane of bit b
+static inline void AES_subBytesBitsliced(I32x4 *q) {
+
+	const I32x4 x0 = q[7], x1 = q[6], x2 = q[5], x3 = q[4];
+	const I32x4 x4 = q[3], x5 = q[2], x6 = q[1], x7 = q[0];
+
+	//Top linear transformation
+
+	const I32x4 y14 = I32x4_xor(x3, x5);
+	const I32x4 y13 = I32x4_xor(x0, x6);
+	const I32x4 y9 = I32x4_xor(x0, x3);
+	const I32x4 y8 = I32x4_xor(x0, x5);
+	const I32x4 t0 = I32x4_xor(x1, x2);
+	const I32x4 y1 = I32x4_xor(t0, x7);
+	const I32x4 y4 = I32x4_xor(y1, x3);
+	const I32x4 y12 = I32x4_xor(y13, y14);
+	const I32x4 y2 = I32x4_xor(y1, x0);
+	const I32x4 y5 = I32x4_xor(y1, x6);
+	const I32x4 y3 = I32x4_xor(y5, y8);
+	const I32x4 t1 = I32x4_xor(x4, y12);
+	const I32x4 y15 = I32x4_xor(t1, x5);
+	const I32x4 y20 = I32x4_xor(t1, x1);
+	const I32x4 y6 = I32x4_xor(y15, x7);
+	const I32x4 y10 = I32x4_xor(y15, t0);
+	const I32x4 y11 = I32x4_xor(y20, y9);
+	const I32x4 y7 = I32x4_xor(x7, y11);
+	const I32x4 y17 = I32x4_xor(y10, y11);
+	const I32x4 y19 = I32x4_xor(y10, y8);
+	const I32x4 y16 = I32x4_xor(t0, y11);
+	const I32x4 y21 = I32x4_xor(y13, y16);
+	const I32x4 y18 = I32x4_xor(x0, y16);
+
+	//Non-linear section (inversion in GF(2^4)^2)
+
+	const I32x4 t2 = I32x4_and(y12, y15);
+	const I32x4 t3 = I32x4_and(y3, y6);
+	const I32x4 t4 = I32x4_xor(t3, t2);
+	const I32x4 t5 = I32x4_and(y4, x7);
+	const I32x4 t6 = I32x4_xor(t5, t2);
+	const I32x4 t7 = I32x4_and(y13, y16);
+	const I32x4 t8 = I32x4_and(y5, y1);
+	const I32x4 t9 = I32x4_xor(t8, t7);
+	const I32x4 t10 = I32x4_and(y2, y7);
+	const I32x4 t11 = I32x4_xor(t10, t7);
+	const I32x4 t12 = I32x4_and(y9, y11);
+	const I32x4 t13 = I32x4_and(y14, y17);
+	const I32x4 t14 = I32x4_xor(t13, t12);
+	const I32x4 t15 = I32x4_and(y8, y10);
+	const I32x4 t16 = I32x4_xor(t15, t12);
+	const I32x4 t17 = I32x4_xor(t4, t14);
+	const I32x4 t18 = I32x4_xor(t6, t16);
+	const I32x4 t19 = I32x4_xor(t9, t14);
+	const I32x4 t20 = I32x4_xor(t11, t16);
+	const I32x4 t21 = I32x4_xor(t17, y20);
+	const I32x4 t22 = I32x4_xor(t18, y19);
+	const I32x4 t23 = I32x4_xor(t19, y21);
+	const I32x4 t24 = I32x4_xor(t20, y18);
+
+	const I32x4 t25 = I32x4_xor(t21, t22);
+	const I32x4 t26 = I32x4_and(t21, t23);
+	const I32x4 t27 = I32x4_xor(t24, t26);
+	const I32x4 t28 = I32x4_and(t25, t27);
+	const I32x4 t29 = I32x4_xor(t28, t22);
+	const I32x4 t30 = I32x4_xor(t23, t24);
+	const I32x4 t31 = I32x4_xor(t22, t26);
+	const I32x4 t32 = I32x4_and(t31, t30);
+	const I32x4 t33 = I32x4_xor(t32, t24);
+	const I32x4 t34 = I32x4_xor(t23, t33);
+	const I32x4 t35 = I32x4_xor(t27, t33);
+	const I32x4 t36 = I32x4_and(t24, t35);
+	const I32x4 t37 = I32x4_xor(t36, t34);
+	const I32x4 t38 = I32x4_xor(t27, t36);
+	const I32x4 t39 = I32x4_and(t29, t38);
+	const I32x4 t40 = I32x4_xor(t25, t39);
+
+	const I32x4 t41 = I32x4_xor(t40, t37);
+	const I32x4 t42 = I32x4_xor(t29, t33);
+	const I32x4 t43 = I32x4_xor(t29, t40);
+	const I32x4 t44 = I32x4_xor(t33, t37);
+	const I32x4 t45 = I32x4_xor(t42, t41);
+	const I32x4 z0 = I32x4_and(t44, y15);
+	const I32x4 z1 = I32x4_and(t37, y6);
+	const I32x4 z2 = I32x4_and(t33, x7);
+	const I32x4 z3 = I32x4_and(t43, y16);
+	const I32x4 z4 = I32x4_and(t40, y1);
+	const I32x4 z5 = I32x4_and(t29, y7);
+	const I32x4 z6 = I32x4_and(t42, y11);
+	const I32x4 z7 = I32x4_and(t45, y17);
+	const I32x4 z8 = I32x4_and(t41, y10);
+	const I32x4 z9 = I32x4_and(t44, y12);
+	const I32x4 z10 = I32x4_and(t37, y3);
+	const I32x4 z11 = I32x4_and(t33, y4);
+	const I32x4 z12 = I32x4_and(t43, y13);
+	const I32x4 z13 = I32x4_and(t40, y5);
+	const I32x4 z14 = I32x4_and(t29, y2);
+	const I32x4 z15 = I32x4_and(t42, y9);
+	const I32x4 z16 = I32x4_and(t45, y14);
+	const I32x4 z17 = I32x4_and(t41, y8);
+
+	//Bottom linear transformation (includes the affine transform)
+
+	const I32x4 t46 = I32x4_xor(z15, z16);
+	const I32x4 t47 = I32x4_xor(z10, z11);
+	const I32x4 t48 = I32x4_xor(z5, z13);
+	const I32x4 t49 = I32x4_xor(z9, z10);
+	const I32x4 t50 = I32x4_xor(z2, z12);
+	const I32x4 t51 = I32x4_xor(z2, z5);
+	const I32x4 t52 = I32x4_xor(z7, z8);
+	const I32x4 t53 = I32x4_xor(z0, z3);
+	const I32x4 t54 = I32x4_xor(z6, z7);
+	const I32x4 t55 = I32x4_xor(z16, z17);
+	const I32x4 t56 = I32x4_xor(z12, t48);
+	const I32x4 t57 = I32x4_xor(t50, t53);
+	const I32x4 t58 = I32x4_xor(z4, t46);
+	const I32x4 t59 = I32x4_xor(z3, t54);
+	const I32x4 t60 = I32x4_xor(t46, t57);
+	const I32x4 t61 = I32x4_xor(z14, t57);
+	const I32x4 t62 = I32x4_xor(t52, t58);
+	const I32x4 t63 = I32x4_xor(t49, t58);
+	const I32x4 t64 = I32x4_xor(z4, t59);
+	const I32x4 t65 = I32x4_xor(t61, t62);
+	const I32x4 t66 = I32x4_xor(z1, t63);
+	const I32x4 t67 = I32x4_xor(t64, t65);
+
+	const I32x4 s3 = I32x4_xor(t53, t66);
+
+	q[7] = I32x4_xor(t59, t63);                          //s0
+	q[6] = I32x4_xor(t64, I32x4_not(s3));                //s1
+	q[5] = I32x4_xor(t55, I32x4_not(t67));               //s2
+	q[4] = s3;
+	q[3] = I32x4_xor(t51, t66);                          //s4
+	q[2] = I32x4_xor(t47, t65);                          //s5
+	q[1] = I32x4_xor(t56, I32x4_not(t62));               //s6
+	q[0] = I32x4_xor(t48, I32x4_not(t60));               //s7
+}
+
+//Byte shuffles within every plane; since a plane byte is the same state byte for all blocks,
+// ShiftRows and the column rotations of MixColumns are the same as for a single block.
+
+static inline I32x4 AES_shiftRowsMask() {
+	return I32x4_create4(0x0F0A0500, 0x030E0904, 0x07020D08, 0x0B06010C);
+}
+
+static inline I32x4 AES_rotateColumn1Mask() {
+	return I32x4_create4(0x00030201, 0x04070605, 0x080B0A09, 0x0C0F0E0D);
+}
+
+static inline I32x4 AES_rotateColumn2Mask() {
+	return I32x4_create4(0x01000302, 0x05040706, 0x09080B0A, 0x0D0C0F0E);
+}
+
+//out = 2 * a + 3 * rot1(a) + rot2(a) + rot3(a) = xtime(a ^ rot1(a)) ^ rot1(a) ^ rot2(a ^ rot1(a))
+static inline void AES_mixColumnsBitsliced(I32x4 *q, I32x4 rot1Mask, I32x4 rot2Mask) {
+
+	I32x4 r1[8], t[8];
+
+	for (U8 b = 0; b < 8; ++b) {
+		r1[b] = I32x4_shuffleBytes(q[b], rot1Mask);
+		t[b] = I32x4_xor(q[b], r1[b]);
+	}
+
+	//xtime is a shift over the planes, with the reduction (0x1B) xored into bits 0, 1, 3 and 4
+
+	const I32x4 hi = t[7];
+
+	for (U8 b = 0; b < 8; ++b) {
+
+		I32x4 x = b ? t[b - 1] : hi;
+
+		if(b == 1 || b == 3 || b == 4)
+			x = I32x4_xor(x, hi);
+
+		q[b] = I32x4_xor(I32x4_xor(x, r1[b]), I32x4_shuffleBytes(t[b], rot2Mask));
+	}
+}
+
+void AES_encryptBitsliced(const I32x4 *restrict in, I32x4 *restrict out, const I32x4 *restrict rk, U8 rounds) {
+
+	const I32x4 shiftRows = AES_shiftRowsMask();
+	const I32x4 rot1 = AES_rotateColumn1Mask();
+	const I32x4 rot2 = AES_rotateColumn2Mask();
+
+	AESBitsliced blocks, q;
+
+	for (U8 i = 0; i < AES_bitslicedBlocks; ++i)
+		blocks.v[i] = in[i];
+
+	AES_bitslice(&q, &blocks);
+
+	for (U8 b = 0; b < 8; ++b)
+		q.v[b] = I32x4_xor(q.v[b], rk[b]);
+
+	for (U8 r = 1; r <= rounds; ++r) {
+
+		AES_subBytesBitsliced(q.v);
+
+		for (U8 b = 0; b < 8; ++b)
+			q.v[b] = I32x4_shuffleBytes(q.v[b], shiftRows);
+
+		if(r != rounds)
+			AES_mixColumnsBitsliced(q.v, rot1, rot2);
+
+		for (U8 b = 0; b < 8; ++b)
+			q.v[b] = I32x4_xor(q.v[b], rk[r * 8 + b]);
+	}
+
+	AES_bitslice(&blocks, &q);
+
+	for (U8 i = 0; i < AES_bitslicedBlocks; ++i)
+		out[i] = blocks.v[i];
+
+	Buffer_clearAllSecure(Buffer_createRef(&blocks, sizeof(blocks)));
+	Buffer_clearAllSecure(Buffer_createRef(&q, sizeof(q)));
+}
+
+//32x32 -> 64 carry-less multiply.
+//Every operand is split into 4 parts that only keep bits i with i % 4 == part, so a product of two parts
+// only has terms on bits with (partA + partB) % 4; and since there's at most 8 terms per bit they add up to < 16,
+// which never carries into the next bit that's kept.
+static inline U64 AES_bmul32(U32 x, U32 y) {
+
+	const U64 x0 = x & 0x11111111, x1 = x & 0x22222222, x2 = x & 0x44444444, x3 = x & 0x88888888;
+	const U64 y0 = y & 0x11111111, y1 = y & 0x22222222, y2 = y & 0x44444444, y3 = y & 0x88888888;
+
+	const U64 z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+	const U64 z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+	const U64 z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+	const U64 z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+
+	return
+		(z0 & 0x1111111111111111) | (z1 & 0x2222222222222222) |
+		(z2 & 0x4444444444444444) | (z3 & 0x8888888888888888);
+}
+
+//64x64 -> 128 carry-less multiply (Karatsuba), the result is { lo, hi }
+static inline I32x4 AES_clmul64Software(U64 a, U64 b) {
+
+	const U32 a0 = (U32) a, a1 = (U32)(a >> 32);
+	const U32 b0 = (U32) b, b1 = (U32)(b >> 32);
+
+	const U64 lo = AES_bmul32(a0, b0);
+	const U64 hi = AES_bmul32(a1, b1);
+	const U64 mid = AES_bmul32(a0 ^ a1, b0 ^ b1) ^ lo ^ hi;
+
+	return I32x4_createFromU64x2(lo ^ (mid << 32), hi ^ (mid >> 32));
+}
+
+static inline U64 AES_lo64(I32x4 a) { return (U32) I32x4_x(a) | ((U64)(U32) I32x4_y(a) << 32); }
+static inline U64 AES_hi64(I32x4 a) { return (U32) I32x4_z(a) | ((U64)(U32) I32x4_w(a) << 32); }
+
+void AES_clmulSoftware(I32x4 a, I32x4 b, I32x4 *clmuls) {
+
+	const U64 a0 = AES_lo64(a), a1 = AES_hi64(a);
+	const U64 b0 = AES_lo64(b), b1 = AES_hi64(b);
+
+	clmuls[0] = AES_clmul64Software(a0, b0);
+	clmuls[2] = AES_clmul64Software(a1, b1);
+
+	clmuls[1] = I32x4_xor(
+		AES_clmul64Software(a0 ^ a1, b0 ^ b1),
+		I32x4_xor(clmuls[0], clmuls[2])
+	);
+}
@@ -21,9 +21,13 @@
 //types/container/buffer_hash.c
 
 #include "types/container/buffer.h"
+#include "types/container/job_queue.h"
+#include "types/base/error.h"
 #include "types/math/vec4i_swizzle.h"
 #include "types/math/type_cast.h"
 #include "types/base/endianness.h"
+#include "types/base/mathi.h"
+#include "types/math/u128_base.h"
 #include "types/base/constants.h"
 
 //SHA state
@@ -33,6 +37,19 @@ const U32 SHA256_STATE[8] = {
 	0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
 };
 
+//Round constants, for the multi-buffer version (the SHA extension version keeps them in registers)
+
+const U32 SHA256_ROUNDS[64] = {
+	0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+	0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+	0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+	0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+	0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+	0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+	0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+	0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
 static inline U32 sigma0(U32 x) {
 	return (U32_ror(x, 7) ^ U32_ror(x, 18)) ^ (x >> 3);
 }
@@ -202,6 +219,122 @@ U32 Buffer_crc32cFallbackChained(const Buffer buf, U32 prevCrc) {
 	return (U32)crc ^ U32_MAX;
 }
 
+//CRC32C combine.
+//Appending b to a multiplies crc(a) by x^(8 * lenB) mod P (the bytes of b shift it along), after which crc(b) is added.
+//The pre and post inversion of both CRCs cancel out, so crc(a || b) = crc(a) * x^(8 * lenB) + crc(b) in GF(2).
+//Same approach as zlib's crc32_combine: CRC32C_X2N[k] is x^(2^k) mod P, so x^n is one multiply per set bit of n.
+//For the Castagnoli polynomial x^(2^31) == x, so the table repeats every 31 entries.
+
+static const U32 CRC32C_X2N[31] = {
+	0x40000000, 0x20000000, 0x08000000, 0x00800000,
+	0x00008000, 0x82F63B78, 0x6EA2D55C, 0x18B8EA18,
+	0x510AC59A, 0xB82BE955, 0xB8FDB1E7, 0x88E56F72,
+	0x74C360A4, 0xE4172B16, 0x0D65762A, 0x35D73A62,
+	0x28461564, 0xBF455269, 0xE2EA32DC, 0xFE7740E6,
+	0xF946610B, 0x3C204F8F, 0x538586E3, 0x59726915,
+	0x734D5309, 0xBC1AC763, 0x7D0722CC, 0xD289CABE,
+	0xE94CA9BC, 0x05B74F3F, 0xA51E1F42
+};
+
+//a * b mod P, bit reflected like the CRC itself (so the top bit is x^0)
+
+static U32 CRC32C_multiply(U32 a, U32 b) {
+
+	U32 p = 0;
+
+	for (U32 m = (U32)1 << 31; m; m >>= 1) {
+
+		if(a & m)
+			p ^= b;
+
+		b = b & 1 ? (b >> 1) ^ 0x82F63B78 : b >> 1;
+	}
+
+	return p;
+}
+
+U32 Buffer_crc32cCombine(U32 crcA, U32 crcB, U64 lenB) {
+
+	U32 shift = (U32)1 << 31;        //x^0
+
+	for(U64 k = 3; lenB; lenB >>= 1, ++k)        //k starts at 3, since a byte is x^8
+		if(lenB & 1)
+			shift = CRC32C_multiply(CRC32C_X2N[k % 31], shift);
+
+	return CRC32C_multiply(shift, crcA) ^ crcB;
+}
+
+//Parallel CRC32C.
+//Every chunk is hashed on its own and they're combined in order after.
+//A combine is about a thousand operations, so chunks are kept big enough that it doesn't matter.
+
+#define Buffer_crc32cParallelMinChunk (4 * MIBI)
+#define Buffer_crc32cParallelMaxChunks 256
+
+typedef struct BufferCRC32CParallel {
+	const U8 *ptr;
+	U64 length, chunks;
+	U32 crcs[Buffer_crc32cParallelMaxChunks];
+} BufferCRC32CParallel;
+
+static U64 BufferCRC32CParallel_bound(const BufferCRC32CParallel *p, U64 chunk) {
+	return chunk == p->chunks ? p->length : p->length / p->chunks * chunk;
+}
+
+static Bool BufferCRC32CParallel_job(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+
+	BufferCRC32CParallel *p = (BufferCRC32CParallel*) data;
+
+	for (U64 c = begin; c < end; ++c) {
+		const U64 start = BufferCRC32CParallel_bound(p, c);
+		const U64 len = BufferCRC32CParallel_bound(p, c + 1) - start;
+		p->crcs[c] = Buffer_crc32c(Buffer_createRefConst(p->ptr + start, len));
+	}
+
+	return true;
+}
+
+Bool Buffer_crc32cParallel(const Buffer buf, JobQueue *queue, U32 *result, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(!result)
+		retError(clean, Error_nullPointer(2, "Buffer_crc32cParallel()::result is required"));
+
+	//A few chunks per thread to even out the load (one thread might be busy with something else)
+
+	const U64 len = Buffer_length(buf);
+	const U64 threads = queue ? JobQueue_threadCount(queue) : 1;
+
+	const U64 chunks = U64_min(
+		U64_min(threads * 4, len / Buffer_crc32cParallelMinChunk), Buffer_crc32cParallelMaxChunks
+	);
+
+	if (threads <= 1 || chunks <= 1) {
+		*result = Buffer_crc32c(buf);
+		goto clean;
+	}
+
+	BufferCRC32CParallel p = (BufferCRC32CParallel) { .ptr = buf.ptr, .length = len, .chunks = chunks };
+
+	gotoIfError3(clean, JobQueue_parallelFor(queue, chunks, 1, BufferCRC32CParallel_job, &p, NULL, e_rr));
+	gotoIfError3(clean, JobQueue_wait(queue, e_rr));
+
+	U32 crc = p.crcs[0];
+
+	for(U64 c = 1; c < chunks; ++c)
+		crc = Buffer_crc32cCombine(
+			crc, p.crcs[c], BufferCRC32CParallel_bound(&p, c + 1) - BufferCRC32CParallel_bound(&p, c)
+		);
+
+	*result = crc;
+
+clean:
+	return s_uccess;
+}
+
 //Ported from https://github.com/krisprice/simd_md5/blob/master/simd_md5/md5_sse.c#L9
 //But removed SIMD, since it was incredibly (and I can't stress this enough!) badly done.
 //Found locally that:
@@ -376,3 +509,463 @@ U64 Buffer_fnv1a64(const Buffer buf, U64 hash) {
 
 	return hash;
 }
+
+//XXH3 (xxHash 0.8), the output matches XXH3_64bits_withSeed and XXH3_128bits_withSeed.
+//Up to 240 bytes it's a handful of 64x64 -> 128 multiplies against the default secret (with the seed mixed in).
+//Above that, 8 U64 accumulators run over 64 byte stripes (Buffer_hashAccumulate, the SIMD part) with a secret
+// derived from the seed and are scrambled after every block of 16 stripes.
+
+static const U8 XXH3_SECRET[Buffer_hashSecretSize] = {
+	0xB8, 0xFE, 0x6C, 0x39, 0x23, 0xA4, 0x4B, 0xBE, 0x7C, 0x01, 0x81, 0x2C, 0xF7, 0x21, 0xAD, 0x1C,
+	0xDE, 0xD4, 0x6D, 0xE9, 0x83, 0x90, 0x97, 0xDB, 0x72, 0x40, 0xA4, 0xA4, 0xB7, 0xB3, 0x67, 0x1F,
+	0xCB, 0x79, 0xE6, 0x4E, 0xCC, 0xC0, 0xE5, 0x78, 0x82, 0x5A, 0xD0, 0x7D, 0xCC, 0xFF, 0x72, 0x21,
+	0xB8, 0x08, 0x46, 0x74, 0xF7, 0x43, 0x24, 0x8E, 0xE0, 0x35, 0x90, 0xE6, 0x81, 0x3A, 0x26, 0x4C,
+	0x3C, 0x28, 0x52, 0xBB, 0x91, 0xC3, 0x00, 0xCB, 0x88, 0xD0, 0x65, 0x8B, 0x1B, 0x53, 0x2E, 0xA3,
+	0x71, 0x64, 0x48, 0x97, 0xA2, 0x0D, 0xF9, 0x4E, 0x38, 0x19, 0xEF, 0x46, 0xA9, 0xDE, 0xAC, 0xD8,
+	0xA8, 0xFA, 0x76, 0x3F, 0xE3, 0x9C, 0x34, 0x3F, 0xF9, 0xDC, 0xBB, 0xC7, 0xC7, 0x0B, 0x4F, 0x1D,
+	0x8A, 0x51, 0xE0, 0x4B, 0xCD, 0xB4, 0x59, 0x31, 0xC8, 0x9F, 0x7E, 0xC9, 0xD9, 0x78, 0x73, 0x64,
+	0xEA, 0xC5, 0xAC, 0x83, 0x34, 0xD3, 0xEB, 0xC3, 0xC5, 0x81, 0xA0, 0xFF, 0xFA, 0x13, 0x63, 0xEB,
+	0x17, 0x0D, 0xDD, 0x51, 0xB7, 0xF0, 0xDA, 0x49, 0xD3, 0x16, 0x55, 0x26, 0x29, 0xD4, 0x68, 0x9E,
+	0x2B, 0x16, 0xBE, 0x58, 0x7D, 0x47, 0xA1, 0xFC, 0x8F, 0xF8, 0xB8, 0xD1, 0x7A, 0xD0, 0x31, 0xCE,
+	0x45, 0xCB, 0x3A, 0x8F, 0x95, 0x16, 0x04, 0x28, 0xAF, 0xD7, 0xFB, 0xCA, 0xBB, 0x4B, 0x40, 0x7E
+};
+
+static const U32 XXH_PRIME32_1 = 0x9E3779B1;
+static const U32 XXH_PRIME32_2 = 0x85EBCA77;
+
+static const U64 XXH_PRIME64_1 = 0x9E3779B185EBCA87;
+static const U64 XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4F;
+static const U64 XXH_PRIME64_3 = 0x165667B19E3779F9;
+static const U64 XXH_PRIME64_4 = 0x85EBCA77C2B2AE63;
+
+//PRIME32_3, PRIME64_1 to 4, PRIME32_2, PRIME64_5 and PRIME32_1
+
+static const U64 XXH3_accInit[8] = {
+	0xC2B2AE3D, 0x9E3779B185EBCA87, 0xC2B2AE3D27D4EB4F, 0x165667B19E3779F9,
+	0x85EBCA77C2B2AE63, 0x85EBCA77, 0x27D4EB2F165667C5, 0x9E3779B1
+};
+
+#define XXH3_stripeSize 64
+#define XXH3_stripesPerBlock ((Buffer_hashSecretSize - XXH3_stripeSize) / 8)
+#define XXH3_midSizeMax 240
+
+static inline U32 XXH3_read32(const U8 *ptr) { return *(const U32*)(const void*)ptr; }
+static inline U64 XXH3_read64(const U8 *ptr) { return *(const U64*)(const void*)ptr; }
+
+static inline U64 XXH3_mulFold(U64 a, U64 b) {
+	const U128 product = U128_mul64(a, b);
+	return U128_lo(product) ^ U128_hi(product);
+}
+
+static inline U64 XXH64_avalanche(U64 h) {
+	h ^= h >> 33;
+	h *= XXH_PRIME64_2;
+	h ^= h >> 29;
+	h *= XXH_PRIME64_3;
+	return h ^ (h >> 32);
+}
+
+static inline U64 XXH3_avalanche(U64 h) {
+	h ^= h >> 37;
+	h *= 0x165667919E3779F9;
+	return h ^ (h >> 32);
+}
+
+static inline U64 XXH3_rrmxmx(U64 h, U64 len) {
+	h ^= U64_rol(h, 49) ^ U64_rol(h, 24);
+	h *= 0x9FB21C651E98DF25;
+	h ^= (h >> 35) + len;
+	h *= 0x9FB21C651E98DF25;
+	return h ^ (h >> 28);
+}
+
+static inline U64 XXH3_mix16(const U8 *ptr, const U8 *secret, U64 seed) {
+	return XXH3_mulFold(
+		XXH3_read64(ptr) ^ (XXH3_read64(secret) + seed),
+		XXH3_read64(ptr + 8) ^ (XXH3_read64(secret + 8) - seed)
+	);
+}
+
+static inline void XXH3_mix32(U64 *lo, U64 *hi, const U8 *a, const U8 *b, const U8 *secret, U64 seed) {
+	*lo += XXH3_mix16(a, secret, seed);
+	*lo ^= XXH3_read64(b) + XXH3_read64(b + 8);
+	*hi += XXH3_mix16(b, secret + 16, seed);
+	*hi ^= XXH3_read64(a) + XXH3_read64(a + 8);
+}
+
+static U64 XXH3_hash64Short(const U8 *ptr, U64 len, U64 seed) {
+
+	const U8 *secret = XXH3_SECRET;
+
+	if (len > 8) {
+		const U64 lo = XXH3_read64(ptr) ^ ((XXH3_read64(secret + 24) ^ XXH3_read64(secret + 32)) + seed);
+		const U64 hi = XXH3_read64(ptr + len - 8) ^ ((XXH3_read64(secret + 40) ^ XXH3_read64(secret + 48)) - seed);
+		return XXH3_avalanche(len + U64_swapEndianness(lo) + hi + XXH3_mulFold(lo, hi));
+	}
+
+	if (len >= 4) {
+		seed ^= (U64)U32_swapEndianness((U32)seed) << 32;
+		const U64 input = XXH3_read32(ptr + len - 4) + ((U64)XXH3_read32(ptr) << 32);
+		const U64 flip = (XXH3_read64(secret + 8) ^ XXH3_read64(secret + 16)) - seed;
+		return XXH3_rrmxmx(input ^ flip, len);
+	}
+
+	if (len) {
+		const U32 combined =
+			((U32)ptr[0] << 16) | ((U32)ptr[len >> 1] << 24) | (U32)ptr[len - 1] | ((U32)len << 8);
+		return XXH64_avalanche(combined ^ ((U64)(XXH3_read32(secret) ^ XXH3_read32(secret + 4)) + seed));
+	}
+
+	return XXH64_avalanche(seed ^ XXH3_read64(secret + 56) ^ XXH3_read64(secret + 64));
+}
+
+static U64 XXH3_hash64Mid(const U8 *ptr, U64 len, U64 seed) {
+
+	const U8 *secret = XXH3_SECRET;
+	U64 acc = len * XXH_PRIME64_1;
+
+	if (len <= 128) {
+
+		//Pairs from the front and back, so all of 17-128 is covered without a tail loop
+
+		for (U64 i = (len - 1) / 32 + 1; i-- > 0; ) {
+			acc += XXH3_mix16(ptr + i * 16, secret + i * 32, seed);
+			acc += XXH3_mix16(ptr + len - (i + 1) * 16, secret + i * 32 + 16, seed);
+		}
+
+		return XXH3_avalanche(acc);
+	}
+
+	const U64 rounds = len / 16;
+
+	for (U64 i = 0; i < 8; ++i)
+		acc += XXH3_mix16(ptr + i * 16, secret + i * 16, seed);
+
+	acc = XXH3_avalanche(acc);
+
+	for (U64 i = 8; i < rounds; ++i)
+		acc += XXH3_mix16(ptr + i * 16, secret + (i - 8) * 16 + 3, seed);
+
+	acc += XXH3_mix16(ptr + len - 16, secret + 136 - 17, seed);
+	return XXH3_avalanche(acc);
+}
+
+static Hash128 XXH3_hash128Short(const U8 *ptr, U64 len, U64 seed) {
+
+	const U8 *secret = XXH3_SECRET;
+
+	if (len > 8) {
+
+		const U64 flipLo = (XXH3_read64(secret + 32) ^ XXH3_read64(secret + 40)) - seed;
+		const U64 flipHi = (XXH3_read64(secret + 48) ^ XXH3_read64(secret + 56)) + seed;
+		const U64 inputLo = XXH3_read64(ptr);
+		const U64 inputHi = XXH3_read64(ptr + len - 8) ^ flipHi;
+
+		const U128 m = U128_mul64(inputLo ^ XXH3_read64(ptr + len - 8) ^ flipLo, XXH_PRIME64_1);
+		U64 mLo = U128_lo(m) + ((len - 1) << 54);
+		const U64 mHi = U128_hi(m) + inputHi + (U64)(U32)inputHi * (XXH_PRIME32_2 - 1);
+		mLo ^= U64_swapEndianness(mHi);
+
+		const U128 h = U128_mul64(mLo, XXH_PRIME64_2);
+		return (Hash128) { .lo = XXH3_avalanche(U128_lo(h)), .hi = XXH3_avalanche(U128_hi(h) + mHi * XXH_PRIME64_2) };
+	}
+
+	if (len >= 4) {
+
+		seed ^= (U64)U32_swapEndianness((U32)seed) << 32;
+
+		const U64 input = XXH3_read32(ptr) + ((U64)XXH3_read32(ptr + len - 4) << 32);
+		const U64 flip = (XXH3_read64(secret + 16) ^ XXH3_read64(secret + 24)) + seed;
+		const U128 m = U128_mul64(input ^ flip, XXH_PRIME64_1 + (len << 2));
+
+		U64 hi = U128_hi(m) + (U128_lo(m) << 1);
+		U64 lo = U128_lo(m) ^ (hi >> 3);
+
+		lo ^= lo >> 35;
+		lo *= 0x9FB21C651E98DF25;
+		lo ^= lo >> 28;
+		hi = XXH3_avalanche(hi);
+
+		return (Hash128) { .lo = lo, .hi = hi };
+	}
+
+	if (len) {
+
+		const U32 lo = ((U32)ptr[0] << 16) | ((U32)ptr[len >> 1] << 24) | (U32)ptr[len - 1] | ((U32)len << 8);
+		const U32 hi = U32_rol(U32_swapEndianness(lo), 13);
+
+		const U64 flipLo = (U64)(XXH3_read32(secret) ^ XXH3_read32(secret + 4)) + seed;
+		const U64 flipHi = (U64)(XXH3_read32(secret + 8) ^ XXH3_read32(secret + 12)) - seed;
+
+		return (Hash128) { .lo = XXH64_avalanche(lo ^ flipLo), .hi = XXH64_avalanche(hi ^ flipHi) };
+	}
+
+	return (Hash128) {
+		.lo = XXH64_avalanche(seed ^ XXH3_read64(secret + 64) ^ XXH3_read64(secret + 72)),
+		.hi = XXH64_avalanche(seed ^ XXH3_read64(secret + 80) ^ XXH3_read64(secret + 88))
+	};
+}
+
+static Hash128 XXH3_hash128Mid(const U8 *ptr, U64 len, U64 seed) {
+
+	const U8 *secret = XXH3_SECRET;
+	U64 lo = len * XXH_PRIME64_1, hi = 0;
+
+	if (len <= 128)
+		for (U64 i = (len - 1) / 32 + 1; i-- > 0; )
+			XXH3_mix32(&lo, &hi, ptr + i * 16, ptr + len - (i + 1) * 16, secret + i * 32, seed);
+
+	else {
+
+		const U64 rounds = len / 32;
+
+		for (U64 i = 0; i < 4; ++i)
+			XXH3_mix32(&lo, &hi, ptr + i * 32, ptr + i * 32 + 16, secret + i * 32, seed);
+
+		lo = XXH3_avalanche(lo);
+		hi = XXH3_avalanche(hi);
+
+		for (U64 i = 4; i < rounds; ++i)
+			XXH3_mix32(&lo, &hi, ptr + i * 32, ptr + i * 32 + 16, secret + 3 + (i - 4) * 32, seed);
+
+		XXH3_mix32(&lo, &hi, ptr + len - 16, ptr + len - 32, secret + 136 - 17 - 16, 0 - seed);
+	}
+
+	return (Hash128) {
+		.lo = XXH3_avalanche(lo + hi),
+		.hi = 0 - XXH3_avalanche(lo * XXH_PRIME64_1 + hi * XXH_PRIME64_4 + (len - seed) * XXH_PRIME64_2)
+	};
+}
+
+//Long inputs
+
+static void XXH3_initSecret(U64 seed, U8 secret[Buffer_hashSecretSize]) {
+	for (U64 i = 0; i < Buffer_hashSecretSize; i += 16) {
+		*(U64*)(void*)(secret + i) = XXH3_read64(XXH3_SECRET + i) + seed;
+		*(U64*)(void*)(secret + i + 8) = XXH3_read64(XXH3_SECRET + i + 8) - seed;
+	}
+}
+
+//Accumulates stripes, scrambling whenever a block is done; returns the stripes done in the current block.
+
+static U64 XXH3_consumeStripes(U64 acc[8], const U8 *ptr, U64 stripes, U64 stripesInBlock, const U8 *secret) {
+
+	while (stripes) {
+
+		const U64 count = U64_min(stripes, XXH3_stripesPerBlock - stripesInBlock);
+		Buffer_hashAccumulate(acc, ptr, count, secret + stripesInBlock * 8);
+
+		ptr += count * XXH3_stripeSize;
+		stripes -= count;
+		stripesInBlock += count;
+
+		if (stripesInBlock == XXH3_stripesPerBlock) {
+			Buffer_hashScramble(acc, secret + Buffer_hashSecretSize - XXH3_stripeSize);
+			stripesInBlock = 0;
+		}
+	}
+
+	return stripesInBlock;
+}
+
+static U64 XXH3_mergeAccs(const U64 acc[8], const U8 *secret, U64 result) {
+
+	for (U8 i = 0; i < 4; ++i)
+		result += XXH3_mulFold(
+			acc[i * 2] ^ XXH3_read64(secret + i * 16), acc[i * 2 + 1] ^ XXH3_read64(secret + i * 16 + 8)
+		);
+
+	return XXH3_avalanche(result);
+}
+
+//The last stripe always ends at the end of the input (overlapping the stripes before it) and uses its own secret
+
+static void XXH3_hashLong(const U8 *ptr, U64 len, const U8 *secret, U64 acc[8]) {
+
+	for (U8 i = 0; i < 8; ++i)
+		acc[i] = XXH3_accInit[i];
+
+	XXH3_consumeStripes(acc, ptr, (len - 1) / XXH3_stripeSize, 0, secret);
+	Buffer_hashAccumulate(acc, ptr + len - XXH3_stripeSize, 1, secret + Buffer_hashSecretSize - XXH3_stripeSize - 7);
+}
+
+static U64 XXH3_digest64(const U64 acc[8], const U8 *secret, U64 len) {
+	return XXH3_mergeAccs(acc, secret + 11, len * XXH_PRIME64_1);
+}
+
+static Hash128 XXH3_digest128(const U64 acc[8], const U8 *secret, U64 len) {
+	return (Hash128) {
+		.lo = XXH3_mergeAccs(acc, secret + 11, len * XXH_PRIME64_1),
+		.hi = XXH3_mergeAccs(acc, secret + Buffer_hashSecretSize - 64 - 11, ~(len * XXH_PRIME64_2))
+	};
+}
+
+void Buffer_hashAccumulateFallback(U64 acc[8], const U8 *ptr, U64 stripes, const U8 *secret) {
+	for (U64 j = 0; j < stripes; ++j, ptr += XXH3_stripeSize, secret += 8)
+		for (U8 i = 0; i < 8; ++i) {
+			const U64 data = XXH3_read64(ptr + i * 8);
+			const U64 key = data ^ XXH3_read64(secret + i * 8);
+			acc[i ^ 1] += data;
+			acc[i] += (U64)(U32)key * (key >> 32);
+		}
+}
+
+void Buffer_hashScrambleFallback(U64 acc[8], const U8 *secret) {
+	for (U8 i = 0; i < 8; ++i)
+		acc[i] = (acc[i] ^ (acc[i] >> 47) ^ XXH3_read64(secret + i * 8)) * XXH_PRIME32_1;
+}
+
+U64 Buffer_hash64(const Buffer buf, U64 seed) {
+
+	const U64 len = Buffer_length(buf);
+
+	if(len <= 16)
+		return XXH3_hash64Short(buf.ptr, len, seed);
+
+	if(len <= XXH3_midSizeMax)
+		return XXH3_hash64Mid(buf.ptr, len, seed);
+
+	U8 secret[Buffer_hashSecretSize];
+	U64 acc[8];
+	XXH3_initSecret(seed, secret);
+	XXH3_hashLong(buf.ptr, len, secret, acc);
+	return XXH3_digest64(acc, secret, len);
+}
+
+Hash128 Buffer_hash128(const Buffer buf, U64 seed) {
+
+	const U64 len = Buffer_length(buf);
+
+	if(len <= 16)
+		return XXH3_hash128Short(buf.ptr, len, seed);
+
+	if(len <= XXH3_midSizeMax)
+		return XXH3_hash128Mid(buf.ptr, len, seed);
+
+	U8 secret[Buffer_hashSecretSize];
+	U64 acc[8];
+	XXH3_initSecret(seed, secret);
+	XXH3_hashLong(buf.ptr, len, secret, acc);
+	return XXH3_digest128(acc, secret, len);
+}
+
+//Streaming; the last Buffer_hashBufferSize bytes are always kept back, since the end of the input is handled differently
+// (and the input might turn out to be short after all).
+
+void BufferHashState_create(U64 seed, BufferHashState *state) {
+
+	if(!state)
+		return;
+
+	*state = (BufferHashState) { .seed = seed };
+	XXH3_initSecret(seed, state->secret);
+
+	for (U8 i = 0; i < 8; ++i)
+		state->acc[i] = XXH3_accInit[i];
+}
+
+void BufferHashState_update(BufferHashState *state, const Buffer buf) {
+
+	if(!state)
+		return;
+
+	const U8 *ptr = buf.ptr;
+	U64 len = Buffer_length(buf);
+	state->length += len;
+
+	if (state->buffered + len <= Buffer_hashBufferSize) {
+		Buffer_memcpy(Buffer_createRef(state->buffer + state->buffered, len), buf);
+		state->buffered += (U16) len;
+		return;
+	}
+
+	if (state->buffered) {
+
+		const U64 fill = Buffer_hashBufferSize - state->buffered;
+		Buffer_memcpy(Buffer_createRef(state->buffer + state->buffered, fill), Buffer_createRefConst(ptr, fill));
+
+		state->stripesInBlock = XXH3_consumeStripes(
+			state->acc, state->buffer, Buffer_hashBufferSize / XXH3_stripeSize, state->stripesInBlock, state->secret
+		);
+
+		ptr += fill;
+		len -= fill;
+		state->buffered = 0;
+	}
+
+	//Everything but the last (at most) Buffer_hashBufferSize bytes is hashed straight from the input.
+	//The stripe before what's kept back is copied too, in case the rest turns out to be less than a stripe.
+
+	if (len > Buffer_hashBufferSize) {
+
+		const U64 direct = (len - 1) / Buffer_hashBufferSize * Buffer_hashBufferSize;
+
+		state->stripesInBlock = XXH3_consumeStripes(
+			state->acc, ptr, direct / XXH3_stripeSize, state->stripesInBlock, state->secret
+		);
+
+		ptr += direct;
+		len -= direct;
+
+		Buffer_memcpy(
+			Buffer_createRef(state->buffer + Buffer_hashBufferSize - XXH3_stripeSize, XXH3_stripeSize),
+			Buffer_createRefConst(ptr - XXH3_stripeSize, XXH3_stripeSize)
+		);
+	}
+
+	Buffer_memcpy(Buffer_createRef(state->buffer, len), Buffer_createRefConst(ptr, len));
+	state->buffered = (U16) len;
+}
+
+static void BufferHashState_finish(const BufferHashState *state, U64 acc[8]) {
+
+	for (U8 i = 0; i < 8; ++i)
+		acc[i] = state->acc[i];
+
+	const U8 *lastSecret = state->secret + Buffer_hashSecretSize - XXH3_stripeSize - 7;
+
+	if (state->buffered >= XXH3_stripeSize) {
+		XXH3_consumeStripes(acc, state->buffer, (state->buffered - 1) / XXH3_stripeSize, state->stripesInBlock, state->secret);
+		Buffer_hashAccumulate(acc, state->buffer + state->buffered - XXH3_stripeSize, 1, lastSecret);
+		return;
+	}
+
+	//Less than a stripe left: the last stripe starts in the previous part of the buffer (already hashed)
+
+	U8 last[XXH3_stripeSize];
+	const U64 catchUp = XXH3_stripeSize - state->buffered;
+
+	for (U64 i = 0; i < catchUp; ++i)
+		last[i] = state->buffer[Buffer_hashBufferSize - catchUp + i];
+
+	for (U64 i = 0; i < state->buffered; ++i)
+		last[catchUp + i] = state->buffer[i];
+
+	Buffer_hashAccumulate(acc, last, 1, lastSecret);
+}
+
+U64 BufferHashState_digest64(const BufferHashState *state) {
+
+	if(!state)
+		return 0;
+
+	if(state->length <= XXH3_midSizeMax)
+		return Buffer_hash64(Buffer_createRefConst(state->buffer, state->buffered), state->seed);
+
+	U64 acc[8];
+	BufferHashState_finish(state, acc);
+	return XXH3_digest64(acc, state->secret, state->length);
+}
+
+Hash128 BufferHashState_digest128(const BufferHashState *state) {
+
+	if(!state)
+		return (Hash128) { 0 };
+
+	if(state->length <= XXH3_midSizeMax)
+		return Buffer_hash128(Buffer_createRefConst(state->buffer, state->buffered), state->seed);
+
+	U64 acc[8];
+	BufferHashState_finish(state, acc);
+	return XXH3_digest128(acc, state->secret, state->length);
+}
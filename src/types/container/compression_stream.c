@@ -0,0 +1,423 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/compression_stream.c
+
+#include "types/base/mathi.h"
+#include "types/container/compression_stream.h"
+#include "types/container/container_types.h"
+#include "types/container/buffer.h"
+#include "types/container/job_queue.h"
+#include "types/base/thread.h"
+
+static inline U64 CompressionStream_blockLength(const CompressionStream *compStream, U64 blockId) {
+	return U64_min(BufferCompress_blockSize, compStream->parent.size - blockId * BufferCompress_blockSize);
+}
+
+//Decompresses a block into output, compressed is scratch for its compressed data (unless it's mapped)
+
+static Bool CompressionStream_decodeBlock(
+	CompressionStream *compStream,
+	U64 blockId,
+	Buffer compressed,
+	Buffer output,
+	const Allocator *alloc,
+	Error *e_rr
+) {
+	Bool s_uccess = true;
+
+	OxStream *underlying = RefPtr_data(compStream->dataStream, OxStream);
+	const BufferCompressBlock block = compStream->blocks[blockId];
+	const U64 offset = compStream->blockOffsets[blockId];
+
+	Buffer input = Buffer_createNull();
+
+	if(underlying->streamType & EStreamType_Mapped)
+		input = Buffer_createRefConst(underlying->mapped + offset, block.size);
+
+	else {
+		input = Buffer_createRef(compressed.ptrNonConst, block.size);
+		gotoIfError3(clean, underlying->read(underlying, offset, block.size, input, alloc, e_rr));
+	}
+
+	gotoIfError3(clean, BufferCompress_decodeBlock(input, block, output, e_rr));
+
+clean:
+	return s_uccess;
+}
+
+//Parallel decompression of whole blocks.
+//Their compressed data is read up front, every job then only decompresses its blocks into the output.
+
+typedef struct CompressionStreamJob {
+	CompressionStream *compStream;
+	const U8 *src;            //Compressed data of firstBlock onwards
+	U8 *dst;
+	U64 firstBlock;
+	AtomicI64 failed;
+} CompressionStreamJob;
+
+static Bool CompressionStream_decodeJob(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+
+	CompressionStreamJob *job = (CompressionStreamJob*) data;
+	CompressionStream *compStream = job->compStream;
+	const U64 srcStart = compStream->blockOffsets[job->firstBlock];
+
+	for (U64 i = begin; i < end && !AtomicI64_load(&job->failed); ++i) {
+
+		const U64 blockId = job->firstBlock + i;
+		const BufferCompressBlock block = compStream->blocks[blockId];
+
+		if (!BufferCompress_decodeBlock(
+			Buffer_createRefConst(job->src + (compStream->blockOffsets[blockId] - srcStart), block.size),
+			block,
+			Buffer_createRef(job->dst + i * BufferCompress_blockSize, CompressionStream_blockLength(compStream, blockId)),
+			NULL
+		))
+			AtomicI64_store(&job->failed, 1);
+	}
+
+	return true;        //A failure is redone serially for its error, it shouldn't mark the caller's queue as failed
+}
+
+//*decoded is false if any block failed to decompress or verify
+static Bool CompressionStream_decodeParallel(
+	CompressionStream *compStream,
+	U64 firstBlock,
+	U64 blocks,
+	U8 *dst,
+	const Allocator *alloc,
+	Bool *decoded,
+	Error *e_rr
+) {
+	Bool s_uccess = true;
+	Buffer compressed = Buffer_createNull();
+
+	OxStream *underlying = RefPtr_data(compStream->dataStream, OxStream);
+	const U64 start = compStream->blockOffsets[firstBlock];
+	const U64 length = compStream->blockOffsets[firstBlock + blocks] - start;
+
+	CompressionStreamJob job = (CompressionStreamJob) {
+		.compStream = compStream,
+		.dst = dst,
+		.firstBlock = firstBlock
+	};
+
+	if(underlying->streamType & EStreamType_Mapped)
+		job.src = underlying->mapped + start;
+
+	else {
+		gotoIfError3(clean, Buffer_createUninitializedBytes(length, alloc, &compressed, e_rr));
+		gotoIfError3(clean, underlying->read(underlying, start, length, compressed, alloc, e_rr));
+		job.src = compressed.ptr;
+	}
+
+	gotoIfError3(clean, JobQueue_parallelFor(
+		compStream->queue, blocks, 1, CompressionStream_decodeJob, &job, NULL, e_rr
+	));
+
+	gotoIfError3(clean, JobQueue_wait(compStream->queue, e_rr));
+	*decoded = !AtomicI64_load(&job.failed);
+
+clean:
+	Buffer_free(&compressed, alloc);
+	return s_uccess;
+}
+
+//Implement OxStream's functions
+
+static Bool CompressionStream_readInternal(        //Decompress
+	OxStream *stream,
+	U64 offset,
+	U64 length,
+	Buffer buf,
+	const Allocator *alloc,
+	Error *e_rr
+) {
+	Bool s_uccess = true;
+	Buffer tempCache = Buffer_createNull();
+
+	CompressionStream *compStream = (CompressionStream*)stream;
+	Bool shared = false;
+
+	if (offset + length > stream->size)
+		retError(clean, Error_outOfBounds(
+			1, offset + length, stream->size,
+			"CompressionStream_readInternal() out of bounds"
+		));
+
+	if (!length)
+		length = Buffer_length(buf);
+
+	if (length > Buffer_length(buf))
+		retError(clean, Error_outOfBounds(
+			2, length, Buffer_length(buf),
+			"CompressionStream_readInternal() buffer too small"
+		));
+
+	//The internal cache is shared by every read of the stream.
+	//A read that runs concurrently (e.g. on a read-ahead worker) finds it claimed and uses a temporary cache instead.
+
+	shared = !AtomicI64_cmpStore(&compStream->cacheInUse, 0, 1);
+	Buffer cache = compStream->internalCache;
+
+	if (!shared) {
+		gotoIfError3(clean, Buffer_createUninitializedBytes(2 * BufferCompress_blockSize, alloc, &tempCache, e_rr));
+		cache = tempCache;
+	}
+
+	const Buffer compressed = Buffer_createRef(cache.ptrNonConst, BufferCompress_blockSize);
+	U8 *decompressed = cache.ptrNonConst + BufferCompress_blockSize;
+
+	//Same as EncryptionStream; the queue can only be waited on by its owner
+
+	Bool parallel = compStream->queue && compStream->queueThread == Thread_getId();
+	U64 dstOff = offset;
+
+	while (length) {
+
+		const U64 blockId = dstOff / BufferCompress_blockSize;
+		const U64 offsetInBlock = dstOff % BufferCompress_blockSize;
+		const U64 blockLength = CompressionStream_blockLength(compStream, blockId);
+		U8 *dst = buf.ptrNonConst + (dstOff - offset);
+
+		//Whole blocks (the last one of the stream may be smaller) can go straight into buf
+
+		if (parallel && !offsetInBlock) {
+
+			U64 blocks = length / BufferCompress_blockSize;
+
+			if (dstOff + length == stream->size && length % BufferCompress_blockSize)
+				++blocks;
+
+			if (blocks >= 2) {
+
+				const U64 bytes = U64_min(blocks * BufferCompress_blockSize, length);
+				Bool decoded = false;
+
+				gotoIfError3(clean, CompressionStream_decodeParallel(
+					compStream, blockId, blocks, dst, alloc, &decoded, e_rr
+				));
+
+				if (decoded) {
+					dstOff += bytes;
+					length -= bytes;
+					continue;
+				}
+
+				parallel = false;        //Decompress serially, to get the error of the block that failed
+			}
+		}
+
+		const U64 bytesInBlock = U64_min(blockLength - offsetInBlock, length);
+
+		if (bytesInBlock == blockLength) {
+			gotoIfError3(clean, CompressionStream_decodeBlock(
+				compStream, blockId, compressed, Buffer_createRef(dst, blockLength), alloc, e_rr
+			));
+		}
+
+		//Partial blocks are decompressed into the cache, so the rest of the block is there for the next read
+
+		else {
+
+			if (!shared || compStream->cachedBlock != blockId) {
+
+				if(shared)
+					compStream->cachedBlock = U64_MAX;
+
+				gotoIfError3(clean, CompressionStream_decodeBlock(
+					compStream, blockId, compressed, Buffer_createRef(decompressed, blockLength), alloc, e_rr
+				));
+
+				if(shared)
+					compStream->cachedBlock = blockId;
+			}
+
+			Buffer_memcpy(
+				Buffer_createRef(dst, bytesInBlock),
+				Buffer_createRefConst(decompressed + offsetInBlock, bytesInBlock)
+			);
+		}
+
+		dstOff += bytesInBlock;
+		length -= bytesInBlock;
+	}
+
+clean:
+
+	if(shared)
+		AtomicI64_store(&compStream->cacheInUse, 0);
+
+	Buffer_free(&tempCache, alloc);
+	return s_uccess;
+}
+
+static void CompressionStream_closeInternal(OxStream *stream, const Allocator *alloc) {
+	CompressionStream *compStream = (CompressionStream*)stream;
+	RefPtr_dec(&compStream->dataStream);
+	Buffer_free(&compStream->internalCache, alloc);
+	Buffer_free(&compStream->blockData, alloc);
+}
+
+//Public compression stream functions
+
+Bool CompressionStream_setJobQueue(CompressionStreamRef *compStream, JobQueue *queue, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if (!compStream || compStream->refPtrType->typeId != (TypeId)EContainerTypeId_Stream)
+		retError(clean, Error_nullPointer(0, "CompressionStream_setJobQueue()::compStream is required"));
+
+	CompressionStream *cs = RefPtr_data(compStream, CompressionStream);
+
+	if (cs->parent.close != CompressionStream_closeInternal)
+		retError(clean, Error_invalidParameter(
+			0, 0, "CompressionStream_setJobQueue()::compStream isn't a CompressionStream"
+		));
+
+	cs->queue = queue;
+	cs->queueThread = queue ? Thread_getId() : 0;
+
+clean:
+	return s_uccess;
+}
+
+Bool CompressionStream_create(
+	StreamRef *dataStream,
+	U64 streamOffset,
+	U64 compressedSize,
+	U64 size,
+	const Allocator *alloc,
+	CompressionStreamRef **compStream,
+	Error *e_rr
+) {
+	Bool s_uccess = true;
+	Bool inc = false;
+	Bool hasStream = false;
+
+	if (!compStream)
+		retError(clean, Error_nullPointer(6, "CompressionStream_create()::compStream is required"));
+
+	if (*compStream)
+		retError(clean, Error_invalidOperation(
+			0, "CompressionStream_create()::compStream already initialized, indicating memleak"
+		));
+
+	if (!dataStream || dataStream->refPtrType->typeId != (TypeId)EContainerTypeId_Stream)
+		retError(clean, Error_nullPointer(0, "CompressionStream_create()::dataStream is required"));
+
+	OxStream *underlying = RefPtr_data(dataStream, OxStream);
+
+	if (!underlying->read)
+		retError(clean, Error_unsupportedOperation(0, "CompressionStream_create()::dataStream has to be readable"));
+
+	if (streamOffset > underlying->size || compressedSize > underlying->size - streamOffset)
+		retError(clean, Error_outOfBounds(
+			1, streamOffset + compressedSize, underlying->size,
+			"CompressionStream_create()::streamOffset + compressedSize out of bounds"
+		));
+
+	const U64 blockCount = BufferCompress_blockCount(size);
+	const U64 tableSize = blockCount * sizeof(BufferCompressBlock);
+
+	if (compressedSize < tableSize)
+		retError(clean, Error_invalidParameter(
+			2, 0, "CompressionStream_create()::compressedSize can't fit the block table"
+		));
+
+	RefPtr_inc(dataStream);
+	inc = true;
+
+	//The type is copied into the stream once it exists, see CompressionStream::type
+
+	const RefPtrType type = Stream_inheritType(alloc, sizeof(CompressionStream) - sizeof(OxStream));
+
+	gotoIfError3(clean, Stream_create(
+		CompressionStream_readInternal,
+		NULL,
+		NULL,
+		CompressionStream_closeInternal,
+		size,
+		(EStreamType)(
+			EStreamType_Compressed |
+			(underlying->streamType & ~(U64)(EStreamType_Mapped | EStreamType_Resizable))    //Compressed data is mapped
+		),
+		&type,
+		compStream,
+		e_rr
+	));
+
+	hasStream = true;
+
+	CompressionStream *cs = RefPtr_data(*compStream, CompressionStream);
+	cs->type = type;
+	(*compStream)->refPtrType = &cs->type;
+
+	cs->dataStream = dataStream;
+	cs->blockCount = blockCount;
+	cs->cachedBlock = U64_MAX;
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(
+		2 * BufferCompress_blockSize, alloc, &cs->internalCache, e_rr
+	));
+
+	//Load and validate the block table, so reads can find any block right away
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(
+		(blockCount + 1) * sizeof(U64) + tableSize, alloc, &cs->blockData, e_rr
+	));
+
+	cs->blockOffsets = (U64*) cs->blockData.ptrNonConst;
+	cs->blocks = (BufferCompressBlock*)(cs->blockOffsets + blockCount + 1);
+
+	if(tableSize)
+		gotoIfError3(clean, underlying->read(
+			underlying, streamOffset, tableSize, Buffer_createRef(cs->blocks, tableSize), alloc, e_rr
+		));
+
+	U64 blockOffset = streamOffset + tableSize;
+
+	for (U64 i = 0; i < blockCount; ++i) {
+
+		if(!cs->blocks[i].size || cs->blocks[i].size > CompressionStream_blockLength(cs, i))
+			retError(clean, Error_invalidState(0, "CompressionStream_create() block size is invalid"));
+
+		cs->blockOffsets[i] = blockOffset;
+		blockOffset += cs->blocks[i].size;
+	}
+
+	cs->blockOffsets[blockCount] = blockOffset;
+
+	if(blockOffset != streamOffset + compressedSize)
+		retError(clean, Error_invalidState(1, "CompressionStream_create() blocks don't add up to compressedSize"));
+
+clean:
+
+	if (hasStream && !s_uccess)
+		RefPtr_dec(compStream);
+
+	else if (inc && !s_uccess)
+		RefPtr_dec(&dataStream);
+
+	return s_uccess;
+}
@@ -27,6 +27,141 @@
 #include "types/container/container_types.h"
 #include "types/container/buffer_encrypt.h"
 #include "types/container/buffer.h"
+#include "types/container/job_queue.h"
+#include "types/base/thread.h"
+
+//The internal cache is shared by every read and write of the stream.
+//A read that runs concurrently (e.g. on a read-ahead worker) finds it claimed and uses a temporary cache instead.
+
+static Bool EncryptionStream_openCursor(
+	EncryptionStream *encStream,
+	Bool writeOnly,
+	const Allocator *alloc,
+	StreamCursor *cursor,
+	Bool *shared,
+	Error *e_rr
+) {
+	Bool s_uccess = true;
+	Buffer cache = Buffer_createNull();
+
+	*shared = !AtomicI64_cmpStore(&encStream->cacheInUse, 0, 1);
+
+	if (*shared) {
+		gotoIfError3(clean, StreamCursor_createWithCache(
+			encStream->dataStream, &encStream->internalCache, writeOnly, cursor, e_rr
+		));
+	}
+
+	else {
+		gotoIfError3(clean, Buffer_createUninitializedBytes(
+			encStream->chunkSize + sizeof(CryptoChunk), alloc, &cache, e_rr
+		));
+
+		gotoIfError3(clean, StreamCursor_createWithCache(encStream->dataStream, &cache, writeOnly, cursor, e_rr));
+	}
+
+clean:
+
+	if (!s_uccess && *shared) {
+		AtomicI64_store(&encStream->cacheInUse, 0);
+		*shared = false;
+	}
+
+	Buffer_free(&cache, alloc);
+	return s_uccess;
+}
+
+static void EncryptionStream_closeCursor(
+	EncryptionStream *encStream, StreamCursor *cursor, Bool shared, const Allocator *alloc
+) {
+
+	if (!shared) {
+		StreamCursor_close(cursor, alloc);
+		return;
+	}
+
+	StreamCursor_closeAndKeepCache(cursor, alloc, &encStream->internalCache, NULL);
+	AtomicI64_store(&encStream->cacheInUse, 0);
+}
+
+//Parallel decryption of whole chunks.
+//Every job reads its chunks from the underlying stream straight into the output and decrypts them there.
+
+typedef struct EncryptionStreamJob {
+	EncryptionStream *encStream;
+	OxStream *underlying;
+	const Allocator *alloc;
+	U8 *dst;
+	U64 firstChunk;
+	AtomicI64 failed;
+} EncryptionStreamJob;
+
+static Bool EncryptionStream_decryptJob(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+
+	EncryptionStreamJob *job = (EncryptionStreamJob*) data;
+	EncryptionStream *encStream = job->encStream;
+	OxStream *underlying = job->underlying;
+
+	for (U64 i = begin; i < end && !AtomicI64_load(&job->failed); ++i) {
+
+		U64 chunkId = job->firstChunk + i;
+		U64 chunkStart = chunkId << encStream->chunkSizeShift;
+		U64 actualChunkSize = U64_min(encStream->chunkSize, encStream->parent.size - chunkStart);
+
+		U64 underlyingOffset = chunkId * (encStream->chunkSize + sizeof(CryptoChunk)) + encStream->startOffset;
+
+		CryptoChunk cryptoChunk;
+		Buffer target = Buffer_createRef(job->dst + (i << encStream->chunkSizeShift), actualChunkSize);
+		I32x4 chunkIv = I32x4_xor(I32x4_load3(encStream->rootIv), I32x4_createFromU64x2(chunkId, 0));
+
+		if (
+			!underlying->read(
+				underlying, underlyingOffset, sizeof(cryptoChunk),
+				Buffer_createRef(&cryptoChunk, sizeof(cryptoChunk)), job->alloc, NULL
+			) ||
+			!underlying->read(
+				underlying, underlyingOffset + sizeof(CryptoChunk), actualChunkSize, target, job->alloc, NULL
+			) ||
+			!Buffer_decryptAuto(&target, NULL, encStream->encryptionKey, cryptoChunk.tag, chunkIv, NULL)
+		)
+			AtomicI64_store(&job->failed, 1);
+	}
+
+	return true;        //A failure is redone serially for its error, it shouldn't mark the caller's queue as failed
+}
+
+//*decrypted is false if any chunk failed to read or verify
+static Bool EncryptionStream_decryptParallel(
+	EncryptionStream *encStream,
+	U64 firstChunk,
+	U64 chunks,
+	U8 *dst,
+	const Allocator *alloc,
+	Bool *decrypted,
+	Error *e_rr
+) {
+	Bool s_uccess = true;
+
+	EncryptionStreamJob job = (EncryptionStreamJob) {
+		.encStream = encStream,
+		.underlying = RefPtr_data(encStream->dataStream, OxStream),
+		.alloc = alloc,
+		.dst = dst,
+		.firstChunk = firstChunk
+	};
+
+	gotoIfError3(clean, JobQueue_parallelFor(
+		encStream->queue, chunks, 1, EncryptionStream_decryptJob, &job, NULL, e_rr
+	));
+
+	gotoIfError3(clean, JobQueue_wait(encStream->queue, e_rr));
+	*decrypted = !AtomicI64_load(&job.failed);
+
+clean:
+	return s_uccess;
+}
 
 //Implement OxStream's functions
 
@@ -42,7 +177,7 @@ static Bool EncryptionStream_readInternal(        //Decrypt
 	StreamCursor underlyingCursor = (StreamCursor) { 0 };
 
 	EncryptionStream *encStream = (EncryptionStream*)stream;
-	Bool open = false;
+	Bool open = false, shared = false;
 
 	if (offset + length > stream->size)
 		retError(clean, Error_outOfBounds(
@@ -59,22 +194,51 @@ static Bool EncryptionStream_readInternal(        //Decrypt
 			"EncryptionStream_readInternal() buffer too small"
 		));
 
-	gotoIfError3(clean, StreamCursor_createWithCache(
-		encStream->dataStream,
-		&encStream->internalCache,
-		false,
-		&underlyingCursor,
-		e_rr
-	));
-
+	gotoIfError3(clean, EncryptionStream_openCursor(encStream, false, alloc, &underlyingCursor, &shared, e_rr));
 	open = true;
 
+	//The queue can only be waited on by its owner.
+	//An encrypted underlying stream could have that same queue, which would then be waited on from inside a job.
+
+	Bool parallel =
+		encStream->queue && encStream->queueThread == Thread_getId() &&
+		!(RefPtr_data(encStream->dataStream, OxStream)->streamType & EStreamType_Encrypted);
+
 	U64 dstOff = offset;
 
 	while (length) {
 
 		U64 chunkId = dstOff >> encStream->chunkSizeShift;
 		U64 offsetInChunk = dstOff & (encStream->chunkSize - 1);
+
+		//Whole chunks (the last one of the stream may be smaller) can go straight into buf
+
+		if (parallel && !offsetInChunk) {
+
+			U64 chunks = length >> encStream->chunkSizeShift;
+
+			if (dstOff + length == stream->size && (length & (encStream->chunkSize - 1)))
+				++chunks;
+
+			if (chunks >= 2) {
+
+				U64 bytes = U64_min(chunks << encStream->chunkSizeShift, length);
+				Bool decrypted = false;
+
+				gotoIfError3(clean, EncryptionStream_decryptParallel(
+					encStream, chunkId, chunks, buf.ptrNonConst + (dstOff - offset), alloc, &decrypted, e_rr
+				));
+
+				if (decrypted) {
+					dstOff += bytes;
+					length -= bytes;
+					continue;
+				}
+
+				parallel = false;        //Decrypt serially, to get the error of the chunk that failed
+			}
+		}
+
 		U64 bytesInChunk = U64_min(encStream->chunkSize - offsetInChunk, length);
 
 		U64 chunkStart = chunkId << encStream->chunkSizeShift;
@@ -132,7 +296,7 @@ static Bool EncryptionStream_readInternal(        //Decrypt
 clean:
 
 	if(open)
-		StreamCursor_closeAndKeepCache(&underlyingCursor, alloc, &encStream->internalCache, NULL);
+		EncryptionStream_closeCursor(encStream, &underlyingCursor, shared, alloc);
 
 	return s_uccess;
 }
@@ -148,7 +312,7 @@ static Bool EncryptionStream_writeInternal(
 
 	Bool s_uccess = true;
 	StreamCursor underlyingCursor = (StreamCursor) { 0 };
-	Bool open = false;
+	Bool open = false, shared = false;
 
 	EncryptionStream *encStream = (EncryptionStream*)stream;
 
@@ -179,14 +343,7 @@ static Bool EncryptionStream_writeInternal(
 		stream->size = requiredSize;
 	}
 
-	gotoIfError3(clean, StreamCursor_createWithCache(
-		encStream->dataStream,
-		&encStream->internalCache,
-		true,
-		&underlyingCursor,
-		e_rr
-	));
-
+	gotoIfError3(clean, EncryptionStream_openCursor(encStream, true, alloc, &underlyingCursor, &shared, e_rr));
 	open = true;
 
 	U64 srcOff = 0;
@@ -307,7 +464,7 @@ static Bool EncryptionStream_writeInternal(
 clean:
 
 	if(open)
-		StreamCursor_closeAndKeepCache(&underlyingCursor, alloc, &encStream->internalCache, NULL);
+		EncryptionStream_closeCursor(encStream, &underlyingCursor, shared, alloc);
 
 	return s_uccess;
 }
@@ -354,6 +511,27 @@ clean:
 
 //Public encryption stream functions
 
+Bool EncryptionStream_setJobQueue(EncryptionStreamRef *encStream, JobQueue *queue, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if (!encStream || encStream->refPtrType->typeId != (TypeId)EContainerTypeId_Stream)
+		retError(clean, Error_nullPointer(0, "EncryptionStream_setJobQueue()::encStream is required"));
+
+	EncryptionStream *es = RefPtr_data(encStream, EncryptionStream);
+
+	if (es->parent.close != EncryptionStream_closeInternal)
+		retError(clean, Error_invalidParameter(
+			0, 0, "EncryptionStream_setJobQueue()::encStream isn't an EncryptionStream"
+		));
+
+	es->queue = queue;
+	es->queueThread = queue ? Thread_getId() : 0;
+
+clean:
+	return s_uccess;
+}
+
 RefPtrType EncryptionStream_makeType(const Allocator *alloc) {
 	return Stream_inheritType(alloc, sizeof(EncryptionStream) - sizeof(OxStream));
 }
@@ -427,7 +605,7 @@ Bool EncryptionStream_create(
 		underlying->reserve ? EncryptionStream_reserveInternal : NULL,
 		EncryptionStream_closeInternal,
 		size,
-		EStreamType_Encrypted | underlying->streamType,
+		(EStreamType)(EStreamType_Encrypted | (underlying->streamType & ~(U64)EStreamType_Mapped)),    //Ciphertext is mapped
 		type,
 		encStream,
 		e_rr
@@ -823,191 +823,6 @@ clean:
 	return s_uccess;
 }
 
-//Easy insertion sort
-//Uses about 8KB of cache on stack to hopefully sort quite quickly.
-//Does mean that this can only be used for lists < 8KB.
-
-static inline Bool GenericList_insertionSort8K(GenericList list, CompareFunction func, void *context) {
-
-	//for U8[8192] -> U64[1024].
-	//Fits neatly into cache.
-	//For bigger objects, qsort should probably be used.
-
-	U8 sorted[8192];
-
-	const U8 *tarr = GenericList_ptrConst(list, 0);
-	U8 *tsorted = sorted;
-
-	//Init first element
-	Buffer_memcpy(Buffer_createRef(tsorted, list.stride), Buffer_createRefConst(tarr, list.stride));
-
-	for(U64 j = 1; j < list.length; ++j) {
-
-		const U8 *t = tarr + j * list.stride;
-		U64 k = 0;
-
-		//Check everything that came before us for order
-
-		for (; k < j; ++k) {
-
-			if (func(t, tsorted + k * list.stride, context) != ECompareResult_Lt)        //!isLess
-				continue;
-
-			//Move to the right
-
-			for (U64 l = j; l != k; --l)
-				Buffer_memmove(
-					Buffer_createRef(tsorted + l * list.stride, list.stride),
-					Buffer_createRef(tsorted + (l - 1) * list.stride, list.stride)
-				);
-
-			break;
-		}
-
-		//Now that everything's moved, we can insert ourselves
-
-		Buffer_memcpy(
-			Buffer_createRef(tsorted + k * list.stride, list.stride),
-			Buffer_createRefConst(t, list.stride)
-		);
-	}
-
-	Buffer_memcpy(GenericList_buffer(list), Buffer_createRefConst(sorted, sizeof(sorted)));
-	return true;
-}
-
-//The comparator takes void* to match CompareFunction exactly, so calling it through that pointer isn't a
-// function-type mismatch under -fsanitize=function.
-//It casts back to the real type immediately.
-//The default comparators need no context, but still take it so their type is CompareFunction exactly.
-#define TGenericList_tsort(T)                                                                        \
-ECompareResult sort##T(const void *aRaw, const void *bRaw, void *context) {                          \
-	(void) context;                                                                                  \
-	const T *a = (const T*) aRaw, *b = (const T*) bRaw;                                              \
-	return *a < *b ? ECompareResult_Lt : (*a > *b ? ECompareResult_Gt : ECompareResult_Eq);          \
-}
-
-#define TGenericList_sorts(f) f(U64); f(I64); f(U32); f(I32); f(U16); f(I16); f(U8); f(I8); f(F32); f(F64);
-
-TGenericList_sorts(TGenericList_tsort);
-
-//https://stackoverflow.com/questions/33884057/quick-sort-stackoverflow-error-for-large-arrays
-//qsort U64 should be taking about ~76ms / 1M elem and ~13ms / 1M (sorted).
-//qsort U8 should be taking about half the time for unsorted because of cache speedups.
-//Expect F32 sorting to be at least 2x to 5x slower (and F64 even slower).
-//(Profiled on a 3900x)
-
-static inline U64 GenericList_qpartition(GenericList list, U64 begin, U64 last, CompareFunction f, void *context) {
-
-	U8 tmp[1024 * 2];        //We only support max of 1024 stride lists. We don't want to allocate
-
-	Buffer_memcpy(
-		Buffer_createRef(tmp, list.stride),
-		Buffer_createRefConst((const U8*)list.ptr + (begin + last) / 2 * list.stride, list.stride)
-	);
-
-	U64 i = begin - 1, j = last + 1;
-
-	while (true) {
-
-		while(++i < last && f((const U8*)list.ptr + i * list.stride, tmp, context) == ECompareResult_Lt);
-		while(--j > begin && f((const U8*)list.ptr + j * list.stride, tmp, context) == ECompareResult_Gt);
-
-		if(i < j) {
-
-			Buffer_memcpy(
-				Buffer_createRef(tmp + list.stride, list.stride),
-				Buffer_createRefConst((const U8*)list.ptr + i * list.stride, list.stride)
-			);
-
-			Buffer_memcpy(
-				Buffer_createRef((U8*)list.ptr + i * list.stride, list.stride),
-				Buffer_createRefConst((const U8*)list.ptr + j * list.stride, list.stride)
-			);
-
-			Buffer_memcpy(
-				Buffer_createRef((U8*)list.ptrNonConst + j * list.stride, list.stride),
-				Buffer_createRefConst(tmp + list.stride, list.stride)
-			);
-		}
-
-		else return j;
-	}
-}
-
-static Bool GenericList_qsortRecurse(GenericList list, U64 begin, U64 end, CompareFunction f, void *context) {
-
-	if(begin >> 63 || end >> 63)
-		return false;
-
-	while(begin < end && end != U64_MAX) {
-
-		const U64 pivot = GenericList_qpartition(list, begin, end, f, context);
-
-		if (pivot == U64_MAX)        //Does return a modified array, but it's not fully sorted
-			return false;
-
-		if ((I64)pivot - begin <= (I64)end - (pivot + 1)) {
-			GenericList_qsortRecurse(list, begin, pivot, f, context);
-			begin = pivot + 1;
-			continue;
-		}
-
-		GenericList_qsortRecurse(list, pivot + 1, end, f, context);
-		end = pivot;
-	}
-
-	return true;
-}
-
-static inline Bool GenericList_qsort(GenericList list, CompareFunction f, void *context) {
-	return GenericList_qsortRecurse(list, 0, list.length - 1, f, context);
-}
-
-Bool GenericList_sortCustom(GenericList list, CompareFunction f, void *context) {
-
-	if(list.length <= 1)
-		return true;
-
-	if(list.stride > 1024)            //Current limitation, because we don't allocate.
-		return false;
-
-	if(GenericList_isConstRef(list))
-		return false;
-
-	if(GenericList_bytes(list) <= 8192)
-		return GenericList_insertionSort8K(list, f, context);
-
-	return GenericList_qsort(list, f, context);
-}
-
-#define TGenericList_sort(T) Bool GenericList_sort##T(GenericList l) {    \
-	return GenericList_sortCustom(l, sort##T, NULL);                     \
-}
-
-TGenericList_sorts(TGenericList_sort);
-
-static inline ECompareResult GenericList_compareString(const void *aRaw, const void *bRaw, void *context) {
-	(void) context;
-	return CharString_compareSensitive((const CharString*) aRaw, (const CharString*) bRaw);
-}
-
-static inline ECompareResult GenericList_compareStringInsensitive(const void *aRaw, const void *bRaw, void *context) {
-	(void) context;
-	return CharString_compareInsensitive((const CharString*) aRaw, (const CharString*) bRaw);
-}
-
-Bool GenericList_sortString(GenericList list, EStringCase stringCase) {
-
-	if(list.stride != sizeof(CharString))        //We don't know the real type, but at least it's a check
-		return false;
-
-	return
-		stringCase == EStringCase_Insensitive ?
-		GenericList_sortCustom(list, GenericList_compareStringInsensitive, NULL) :
-		GenericList_sortCustom(list, GenericList_compareString, NULL);
-}
-
 Bool GenericList_pushBack(GenericList *list, const Buffer *buf, const Allocator *allocator, Error *e_rr) {
 
 	Bool s_uccess = true;
@@ -0,0 +1,930 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/generic_list_sort.c
+
+#include "types/container/list.h"
+#include "types/container/job_queue.h"
+#include "types/container/buffer.h"
+#include "types/container/string.h"
+#include "types/base/allocator.h"
+#include "types/base/atomic.h"
+#include "types/base/error.h"
+#include "types/base/string_read.h"
+#include "types/base/mathi.h"
+#include "types/base/constants.h"
+
+//Comparison sort: pattern-defeating quicksort (Orson Peters' pdqsort, without the branchless block partition).
+//
+//Median of 3 (ninther above 128 elements) pivots, insertion sort below 24 elements.
+//An already partitioned range is finished off with a bounded insertion sort, which makes sorted, reversed and
+// "sorted + a few appended" input linear.
+//Every very unbalanced partition shuffles a few elements to break the pattern that caused it;
+// after log2(n) of those it gives up and heapsorts the range, so the worst case is O(n log n).
+//Ranges with many equal keys are partitioned with the equal keys on the left, which skips over them entirely.
+//
+//The recursion goes into the smaller half, so the depth stays O(log n).
+//Needs no allocation: two elements of temp storage live in GenericListSorter (hence the max stride of 1024).
+
+typedef struct GenericListSorter {
+	U8 *ptr;
+	U64 stride;
+	CompareFunction f;
+	void *context;
+	U8 pivot[1024];
+	U8 tmp[1024];
+} GenericListSorter;
+
+static inline U8 *GenericListSorter_at(const GenericListSorter *s, U64 i) {
+	return s->ptr + i * s->stride;
+}
+
+static inline Bool GenericListSorter_less(const GenericListSorter *s, const U8 *a, const U8 *b) {
+	return s->f(a, b, s->context) == ECompareResult_Lt;
+}
+
+//Elements are moved a lot, so the common strides are copied as a struct of that size, which compiles to a single
+// (unaligned) move instead of a call
+
+typedef struct GenericListSortBytes2 { U8 v[2]; } GenericListSortBytes2;
+typedef struct GenericListSortBytes4 { U8 v[4]; } GenericListSortBytes4;
+typedef struct GenericListSortBytes8 { U8 v[8]; } GenericListSortBytes8;
+typedef struct GenericListSortBytes16 { U8 v[16]; } GenericListSortBytes16;
+
+static inline void GenericList_sortCopy(U8 *dst, const U8 *src, U64 stride) {
+	switch (stride) {
+
+		case 1:
+			*dst = *src;
+			break;
+
+		case 2:
+			*(GenericListSortBytes2*) dst = *(const GenericListSortBytes2*) src;
+			break;
+
+		case 4:
+			*(GenericListSortBytes4*) dst = *(const GenericListSortBytes4*) src;
+			break;
+
+		case 8:
+			*(GenericListSortBytes8*) dst = *(const GenericListSortBytes8*) src;
+			break;
+
+		case 16:
+			*(GenericListSortBytes16*) dst = *(const GenericListSortBytes16*) src;
+			break;
+
+		default:
+			Buffer_memcpy(Buffer_createRef(dst, stride), Buffer_createRefConst(src, stride));
+			break;
+	}
+}
+
+static inline void GenericListSorter_swap(GenericListSorter *s, U64 i, U64 j) {
+	GenericList_sortCopy(s->tmp, GenericListSorter_at(s, i), s->stride);
+	GenericList_sortCopy(GenericListSorter_at(s, i), GenericListSorter_at(s, j), s->stride);
+	GenericList_sortCopy(GenericListSorter_at(s, j), s->tmp, s->stride);
+}
+
+static inline void GenericListSorter_sort2(GenericListSorter *s, U64 a, U64 b) {
+	if(GenericListSorter_less(s, GenericListSorter_at(s, b), GenericListSorter_at(s, a)))
+		GenericListSorter_swap(s, a, b);
+}
+
+static inline void GenericListSorter_sort3(GenericListSorter *s, U64 a, U64 b, U64 c) {
+	GenericListSorter_sort2(s, a, b);
+	GenericListSorter_sort2(s, b, c);
+	GenericListSorter_sort2(s, a, b);
+}
+
+//Insertion sort of [begin, end>, stable.
+//guarded = false may only be used if the element before begin is <= everything in the range (it stops the scan).
+//limit != U64_MAX gives up (returns false) once more than limit elements were moved.
+
+static Bool GenericListSorter_insertion(GenericListSorter *s, U64 begin, U64 end, Bool guarded, U64 limit) {
+
+	U64 moved = 0;
+
+	for (U64 cur = begin + 1; cur < end; ++cur) {
+
+		if(!GenericListSorter_less(s, GenericListSorter_at(s, cur), GenericListSorter_at(s, cur - 1)))
+			continue;
+
+		GenericList_sortCopy(s->tmp, GenericListSorter_at(s, cur), s->stride);
+
+		U64 sift = cur;
+
+		do {
+			GenericList_sortCopy(GenericListSorter_at(s, sift), GenericListSorter_at(s, sift - 1), s->stride);
+			--sift;
+		}
+		while((!guarded || sift != begin) && GenericListSorter_less(s, s->tmp, GenericListSorter_at(s, sift - 1)));
+
+		GenericList_sortCopy(GenericListSorter_at(s, sift), s->tmp, s->stride);
+
+		moved += cur - sift;
+
+		if(moved > limit)
+			return false;
+	}
+
+	return true;
+}
+
+static void GenericListSorter_siftDown(GenericListSorter *s, U64 begin, U64 root, U64 n) {
+
+	while(true) {
+
+		U64 child = root * 2 + 1;
+
+		if(child >= n)
+			return;
+
+		if(
+			child + 1 < n &&
+			GenericListSorter_less(s, GenericListSorter_at(s, begin + child), GenericListSorter_at(s, begin + child + 1))
+		)
+			++child;
+
+		if(!GenericListSorter_less(s, GenericListSorter_at(s, begin + root), GenericListSorter_at(s, begin + child)))
+			return;
+
+		GenericListSorter_swap(s, begin + root, begin + child);
+		root = child;
+	}
+}
+
+static void GenericListSorter_heapSort(GenericListSorter *s, U64 begin, U64 end) {
+
+	const U64 n = end - begin;
+
+	for(U64 i = n / 2; i-- > 0; )
+		GenericListSorter_siftDown(s, begin, i, n);
+
+	for (U64 i = n - 1; i > 0; --i) {
+		GenericListSorter_swap(s, begin, begin + i);
+		GenericListSorter_siftDown(s, begin, 0, i);
+	}
+}
+
+//Partitions around the pivot at begin: [begin, pivot> < pivot <= <pivot, end>.
+//Median of 3 made sure there's an element >= pivot before end, so the first scan needs no bounds check.
+
+static U64 GenericListSorter_partitionRight(GenericListSorter *s, U64 begin, U64 end, Bool *alreadyPartitioned) {
+
+	const U64 stride = s->stride;
+	GenericList_sortCopy(s->pivot, GenericListSorter_at(s, begin), stride);
+
+	U64 first = begin, last = end;
+
+	while(GenericListSorter_less(s, GenericListSorter_at(s, ++first), s->pivot));
+
+	if(first - 1 == begin)
+		while(first < last && !GenericListSorter_less(s, GenericListSorter_at(s, --last), s->pivot));
+
+	else while(!GenericListSorter_less(s, GenericListSorter_at(s, --last), s->pivot));
+
+	*alreadyPartitioned = first >= last;
+
+	while (first < last) {
+		GenericListSorter_swap(s, first, last);
+		while(GenericListSorter_less(s, GenericListSorter_at(s, ++first), s->pivot));
+		while(!GenericListSorter_less(s, GenericListSorter_at(s, --last), s->pivot));
+	}
+
+	const U64 pivotPos = first - 1;
+	GenericList_sortCopy(GenericListSorter_at(s, begin), GenericListSorter_at(s, pivotPos), stride);
+	GenericList_sortCopy(GenericListSorter_at(s, pivotPos), s->pivot, stride);
+	return pivotPos;
+}
+
+//Like partitionRight but puts elements equal to the pivot on the left.
+//Only used when the pivot equals the element before begin, so everything on the left is equal and done.
+
+static U64 GenericListSorter_partitionLeft(GenericListSorter *s, U64 begin, U64 end) {
+
+	const U64 stride = s->stride;
+	GenericList_sortCopy(s->pivot, GenericListSorter_at(s, begin), stride);
+
+	U64 first = begin, last = end;
+
+	while(GenericListSorter_less(s, s->pivot, GenericListSorter_at(s, --last)));
+
+	if(last + 1 == end)
+		while(first < last && !GenericListSorter_less(s, s->pivot, GenericListSorter_at(s, ++first)));
+
+	else while(!GenericListSorter_less(s, s->pivot, GenericListSorter_at(s, ++first)));
+
+	while (first < last) {
+		GenericListSorter_swap(s, first, last);
+		while(GenericListSorter_less(s, s->pivot, GenericListSorter_at(s, --last)));
+		while(!GenericListSorter_less(s, s->pivot, GenericListSorter_at(s, ++first)));
+	}
+
+	GenericList_sortCopy(GenericListSorter_at(s, begin), GenericListSorter_at(s, last), stride);
+	GenericList_sortCopy(GenericListSorter_at(s, last), s->pivot, stride);
+	return last;
+}
+
+#define GenericList_pdqInsertion 24
+#define GenericList_pdqNinther 128
+
+static void GenericListSorter_pdq(GenericListSorter *s, U64 begin, U64 end, U64 badAllowed, Bool leftmost) {
+
+	while(true) {
+
+		const U64 size = end - begin;
+
+		if (size < GenericList_pdqInsertion) {
+			GenericListSorter_insertion(s, begin, end, leftmost, U64_MAX);
+			return;
+		}
+
+		//Pivot goes to begin
+
+		const U64 half = size / 2;
+
+		if (size > GenericList_pdqNinther) {
+			GenericListSorter_sort3(s, begin, begin + half, end - 1);
+			GenericListSorter_sort3(s, begin + 1, begin + (half - 1), end - 2);
+			GenericListSorter_sort3(s, begin + 2, begin + (half + 1), end - 3);
+			GenericListSorter_sort3(s, begin + (half - 1), begin + half, begin + (half + 1));
+			GenericListSorter_swap(s, begin, begin + half);
+		}
+
+		else GenericListSorter_sort3(s, begin + half, begin, end - 1);
+
+		//If the pivot equals the element before us (which is <= everything here), there are lots of equal keys.
+		//Put those left of the pivot and continue right of them.
+
+		if(!leftmost && !GenericListSorter_less(s, GenericListSorter_at(s, begin - 1), GenericListSorter_at(s, begin))) {
+			begin = GenericListSorter_partitionLeft(s, begin, end) + 1;
+			continue;
+		}
+
+		Bool alreadyPartitioned = false;
+		const U64 pivotPos = GenericListSorter_partitionRight(s, begin, end, &alreadyPartitioned);
+
+		const U64 leftSize = pivotPos - begin;
+		const U64 rightSize = end - (pivotPos + 1);
+
+		if (leftSize < size / 8 || rightSize < size / 8) {
+
+			if (!--badAllowed) {
+				GenericListSorter_heapSort(s, begin, end);
+				return;
+			}
+
+			//Shuffle a few elements around to break up the pattern
+
+			if (leftSize >= GenericList_pdqInsertion) {
+
+				GenericListSorter_swap(s, begin, begin + leftSize / 4);
+				GenericListSorter_swap(s, pivotPos - 1, pivotPos - leftSize / 4);
+
+				if (leftSize > GenericList_pdqNinther) {
+					GenericListSorter_swap(s, begin + 1, begin + (leftSize / 4 + 1));
+					GenericListSorter_swap(s, begin + 2, begin + (leftSize / 4 + 2));
+					GenericListSorter_swap(s, pivotPos - 2, pivotPos - (leftSize / 4 + 1));
+					GenericListSorter_swap(s, pivotPos - 3, pivotPos - (leftSize / 4 + 2));
+				}
+			}
+
+			if (rightSize >= GenericList_pdqInsertion) {
+
+				GenericListSorter_swap(s, pivotPos + 1, pivotPos + (1 + rightSize / 4));
+				GenericListSorter_swap(s, end - 1, end - rightSize / 4);
+
+				if (rightSize > GenericList_pdqNinther) {
+					GenericListSorter_swap(s, pivotPos + 2, pivotPos + (2 + rightSize / 4));
+					GenericListSorter_swap(s, pivotPos + 3, pivotPos + (3 + rightSize / 4));
+					GenericListSorter_swap(s, end - 2, end - (1 + rightSize / 4));
+					GenericListSorter_swap(s, end - 3, end - (2 + rightSize / 4));
+				}
+			}
+		}
+
+		//Nothing was swapped, so try to finish it off with an insertion sort that gives up quickly
+
+		else if(
+			alreadyPartitioned &&
+			GenericListSorter_insertion(s, begin, pivotPos, leftmost, 8) &&
+			GenericListSorter_insertion(s, pivotPos + 1, end, false, 8)
+		)
+			return;
+
+		//Recurse into the smaller half and loop on the bigger one
+
+		if (leftSize < rightSize) {
+			GenericListSorter_pdq(s, begin, pivotPos, badAllowed, leftmost);
+			begin = pivotPos + 1;
+			leftmost = false;
+		}
+
+		else {
+			GenericListSorter_pdq(s, pivotPos + 1, end, badAllowed, false);
+			end = pivotPos;
+		}
+	}
+}
+
+Bool GenericList_sortCustom(GenericList list, CompareFunction f, void *context) {
+
+	if(list.length <= 1)
+		return true;
+
+	if(list.stride > 1024 || !f)            //Current limitation, because we don't allocate.
+		return false;
+
+	if(GenericList_isConstRef(list))
+		return false;
+
+	GenericListSorter s = (GenericListSorter) {
+		.ptr = (U8*) list.ptrNonConst,
+		.stride = list.stride,
+		.f = f,
+		.context = context
+	};
+
+	U64 badAllowed = 0;
+
+	for(U64 n = list.length; n; n >>= 1)
+		++badAllowed;
+
+	GenericListSorter_pdq(&s, 0, list.length, badAllowed, true);
+	return true;
+}
+
+//Radix sorts for the primitive types.
+//
+//Keys are transformed in place to unsigned integers that order the same way, sorted and transformed back:
+//signed integers flip the sign bit and floats flip every bit if negative or only the sign bit if positive.
+//This orders -0 before +0, and NaNs end up on the side of their sign bit (after +inf or before -inf).
+//
+//GenericList_sortX is an in place MSD radix sort (American flag sort) and doesn't allocate:
+// every byte is counted and the elements are swapped into their bucket, after which each bucket is sorted by the
+// next byte; buckets of < 64 elements are insertion sorted and bytes that are the same for the whole range are skipped.
+//Each level keeps 4KB of bucket offsets on the stack, so a 64-bit sort can use 32KB of stack.
+//
+//GenericList_sortRadixX is an LSD radix sort that needs a temp buffer as big as the list, but it reads the keys
+// once to count every byte and then needs just one stable scatter per byte (skipping bytes that don't differ).
+
+typedef enum ERadixKey {
+	ERadixKey_Unsigned,
+	ERadixKey_Signed,
+	ERadixKey_Float
+} ERadixKey;
+
+#define GenericList_radixInsertion 64
+
+#define TGenericList_radixBase(UT)                                                                                 \
+																													\
+static void GenericList_radixEncode##UT(UT *v, U64 n, ERadixKey key) {                                             \
+																													\
+	const UT sign = (UT)((UT)1 << (sizeof(UT) * 8 - 1));                                                           \
+																													\
+	if(key == ERadixKey_Signed)                                                                                    \
+		for(U64 i = 0; i < n; ++i)                                                                                 \
+			v[i] = (UT)(v[i] ^ sign);                                                                              \
+																													\
+	else if(key == ERadixKey_Float)                                                                                \
+		for(U64 i = 0; i < n; ++i)                                                                                 \
+			v[i] = (UT)(v[i] ^ (v[i] & sign ? (UT)~(UT)0 : sign));                                                 \
+}                                                                                                                  \
+																													\
+static void GenericList_radixDecode##UT(UT *v, U64 n, ERadixKey key) {                                             \
+																													\
+	const UT sign = (UT)((UT)1 << (sizeof(UT) * 8 - 1));                                                           \
+																													\
+	if(key == ERadixKey_Signed)                                                                                    \
+		for(U64 i = 0; i < n; ++i)                                                                                 \
+			v[i] = (UT)(v[i] ^ sign);                                                                              \
+																													\
+	else if(key == ERadixKey_Float)                                                                                \
+		for(U64 i = 0; i < n; ++i)                                                                                 \
+			v[i] = (UT)(v[i] ^ (v[i] & sign ? sign : (UT)~(UT)0));                                                 \
+}                                                                                                                  \
+																													\
+static void GenericList_radixInsertion##UT(UT *v, U64 n) {                                                         \
+	for (U64 i = 1; i < n; ++i) {                                                                                  \
+		const UT x = v[i];                                                                                         \
+		U64 j = i;                                                                                                 \
+		for(; j && v[j - 1] > x; --j)                                                                              \
+			v[j] = v[j - 1];                                                                                       \
+		v[j] = x;                                                                                                  \
+	}                                                                                                              \
+}                                                                                                                  \
+																													\
+static void GenericList_radixInPlace##UT(UT *v, U64 n, U8 shift) {                                                 \
+																													\
+	while(true) {                                                                                                  \
+																													\
+		if (n < GenericList_radixInsertion) {                                                                      \
+			GenericList_radixInsertion##UT(v, n);                                                                  \
+			return;                                                                                                \
+		}                                                                                                          \
+																													\
+		U64 head[256] = { 0 }, end[256];                                                                           \
+																													\
+		for(U64 i = 0; i < n; ++i)                                                                                 \
+			++head[(v[i] >> shift) & 0xFF];                                                                        \
+																													\
+		/* Same byte everywhere; nothing to move */                                                                \
+		if (head[(v[0] >> shift) & 0xFF] == n) {                                                                   \
+			if(!shift) return;                                                                                     \
+			shift = (U8)(shift - 8);                                                                               \
+			continue;                                                                                              \
+		}                                                                                                          \
+																													\
+		for (U64 b = 0, off = 0; b < 256; ++b) {                                                                   \
+			const U64 count = head[b];                                                                             \
+			head[b] = off;                                                                                         \
+			off += count;                                                                                          \
+			end[b] = off;                                                                                          \
+		}                                                                                                          \
+																													\
+		/* Swap every element into its bucket; each swap places at least one element for good */                   \
+		for (U64 b = 0; b < 256; ++b)                                                                              \
+			while (head[b] < end[b]) {                                                                             \
+				UT x = v[head[b]];                                                                                 \
+				U64 d = (x >> shift) & 0xFF;                                                                       \
+				while (d != b) {                                                                                   \
+					const UT y = v[head[d]];                                                                       \
+					v[head[d]++] = x;                                                                              \
+					x = y;                                                                                         \
+					d = (x >> shift) & 0xFF;                                                                       \
+				}                                                                                                  \
+				v[head[b]++] = x;                                                                                  \
+			}                                                                                                      \
+																													\
+		if(!shift)                                                                                                 \
+			return;                                                                                                \
+																													\
+		for (U64 b = 0, begin = 0; b < 256; begin = end[b], ++b)                                                   \
+			if(end[b] - begin > 1)                                                                                 \
+				GenericList_radixInPlace##UT(v + begin, end[b] - begin, (U8)(shift - 8));                          \
+																													\
+		return;                                                                                                    \
+	}                                                                                                              \
+}                                                                                                                  \
+																													\
+/* hist is U64[sizeof(UT)][256], tmp has room for n elements */                                                    \
+static void GenericList_radixLSD##UT(UT *v, U64 n, UT *tmp, U64 *hist) {                                           \
+																													\
+	for(U64 i = 0; i < sizeof(UT) * 256; ++i)                                                                      \
+		hist[i] = 0;                                                                                               \
+																													\
+	for (U64 i = 0; i < n; ++i) {                                                                                  \
+		const UT x = v[i];                                                                                         \
+		for(U64 b = 0; b < sizeof(UT); ++b)                                                                        \
+			++hist[b * 256 + ((x >> (b * 8)) & 0xFF)];                                                             \
+	}                                                                                                              \
+																													\
+	UT *src = v, *dst = tmp;                                                                                       \
+																													\
+	for (U64 b = 0; b < sizeof(UT); ++b) {                                                                         \
+																													\
+		U64 *offsets = hist + b * 256;                                                                             \
+		const U8 shift = (U8)(b * 8);                                                                              \
+																													\
+		if(offsets[(src[0] >> shift) & 0xFF] == n)                                                                 \
+			continue;                                                                                              \
+																													\
+		for (U64 d = 0, off = 0; d < 256; ++d) {                                                                   \
+			const U64 count = offsets[d];                                                                          \
+			offsets[d] = off;                                                                                      \
+			off += count;                                                                                          \
+		}                                                                                                          \
+																													\
+		for (U64 i = 0; i < n; ++i) {                                                                              \
+			const UT x = src[i];                                                                                   \
+			dst[offsets[(x >> shift) & 0xFF]++] = x;                                                               \
+		}                                                                                                          \
+																													\
+		UT *swap = src;                                                                                            \
+		src = dst;                                                                                                 \
+		dst = swap;                                                                                                \
+	}                                                                                                              \
+																													\
+	if(src != v)                                                                                                   \
+		for(U64 i = 0; i < n; ++i)                                                                                 \
+			v[i] = src[i];                                                                                         \
+}
+
+TGenericList_radixBase(U8);
+TGenericList_radixBase(U16);
+TGenericList_radixBase(U32);
+TGenericList_radixBase(U64);
+
+/* Sorted input (e.g. offsets) is common enough to check for, it only costs a compare until the first inversion */
+#define TGenericList_radixSort(T, UT, key)                                                                         \
+																													\
+static Bool GenericList_isSorted##T(const T *v, U64 n) {                                                           \
+	for(U64 i = 1; i < n; ++i)                                                                                     \
+		if(!(v[i - 1] <= v[i]))                                                                                    \
+			return false;                                                                                          \
+	return true;                                                                                                   \
+}                                                                                                                  \
+																													\
+Bool GenericList_sort##T(GenericList l) {                                                                          \
+																													\
+	if(l.length <= 1)                                                                                              \
+		return true;                                                                                               \
+																													\
+	if(l.stride != sizeof(T) || GenericList_isConstRef(l))                                                         \
+		return false;                                                                                              \
+																													\
+	if(GenericList_isSorted##T((const T*) l.ptr, l.length))                                                        \
+		return true;                                                                                               \
+																													\
+	UT *v = (UT*) l.ptrNonConst;                                                                                   \
+	GenericList_radixEncode##UT(v, l.length, key);                                                                 \
+	GenericList_radixInPlace##UT(v, l.length, (U8)((sizeof(UT) - 1) * 8));                                         \
+	GenericList_radixDecode##UT(v, l.length, key);                                                                 \
+	return true;                                                                                                   \
+}                                                                                                                  \
+																													\
+Bool GenericList_sortRadix##T(GenericList l, const Allocator *alloc, Error *e_rr) {                                \
+																													\
+	Bool s_uccess = true;                                                                                          \
+	Buffer tmp = Buffer_createNull();                                                                              \
+																													\
+	if(l.length <= 1)                                                                                              \
+		goto clean;                                                                                                \
+																													\
+	if(l.stride != sizeof(T))                                                                                      \
+		retError(clean, Error_invalidParameter(0, 0, "GenericList_sortRadix" #T "()::l.stride mismatch"));         \
+																													\
+	if(GenericList_isConstRef(l))                                                                                  \
+		retError(clean, Error_constData(0, 0, "GenericList_sortRadix" #T "()::l is const"));                       \
+																													\
+	/* Bytes are counting sorted in place already, small lists aren't worth the allocation */                      \
+	if (                                                                                                           \
+		sizeof(UT) == 1 || l.length < GenericList_radixInsertion * 4 ||                                            \
+		GenericList_isSorted##T((const T*) l.ptr, l.length)                                                        \
+	) {                                                                                                            \
+		GenericList_sort##T(l);                                                                                    \
+		goto clean;                                                                                                \
+	}                                                                                                              \
+																													\
+	/* Histograms first, so the keys after them are aligned too */                                                 \
+	const U64 histBytes = sizeof(U64) * 256 * sizeof(UT);                                                          \
+	gotoIfError3(clean, Buffer_createUninitializedBytes(histBytes + l.length * sizeof(UT), alloc, &tmp, e_rr));    \
+																													\
+	UT *v = (UT*) l.ptrNonConst;                                                                                   \
+	GenericList_radixEncode##UT(v, l.length, key);                                                                 \
+	GenericList_radixLSD##UT(v, l.length, (UT*)(tmp.ptrNonConst + histBytes), (U64*) tmp.ptrNonConst);             \
+	GenericList_radixDecode##UT(v, l.length, key);                                                                 \
+																													\
+clean:                                                                                                             \
+	Buffer_free(&tmp, alloc);                                                                                      \
+	return s_uccess;                                                                                               \
+}
+
+TGenericList_radixSort(U64, U64, ERadixKey_Unsigned);
+TGenericList_radixSort(I64, U64, ERadixKey_Signed);
+TGenericList_radixSort(F64, U64, ERadixKey_Float);
+TGenericList_radixSort(U32, U32, ERadixKey_Unsigned);
+TGenericList_radixSort(I32, U32, ERadixKey_Signed);
+TGenericList_radixSort(F32, U32, ERadixKey_Float);
+TGenericList_radixSort(U16, U16, ERadixKey_Unsigned);
+TGenericList_radixSort(I16, U16, ERadixKey_Signed);
+TGenericList_radixSort(U8, U8, ERadixKey_Unsigned);
+TGenericList_radixSort(I8, U8, ERadixKey_Signed);
+
+//Stable merge sort.
+//Runs of 32 are insertion sorted in place, after which runs are merged bottom up, ping ponging between the list and
+// a temp buffer of the same size.
+//Two runs that are already in order are copied as a whole, so sorted input only costs a compare per run.
+
+#define GenericList_mergeRun 32
+
+//Merges the stable merge of a[0, aLen> and b[0, bLen> into out, but only the output elements [kBegin, kEnd>.
+//The split points are found with a binary search (merge path), so a merge can be cut into independent parts.
+
+static U64 GenericList_mergeSplit(
+	const U8 *a, U64 aLen, const U8 *b, U64 bLen, U64 k, U64 stride, CompareFunction f, void *context
+) {
+
+	U64 lo = k > bLen ? k - bLen : 0;
+	U64 hi = U64_min(k, aLen);
+
+	//Smallest i where a[i] comes after b[k - i - 1]; ties go to a, which keeps the merge stable
+
+	while (lo < hi) {
+
+		const U64 i = (lo + hi) / 2;
+		const U64 j = k - i;
+
+		if(f(b + (j - 1) * stride, a + i * stride, context) != ECompareResult_Lt)
+			lo = i + 1;
+
+		else hi = i;
+	}
+
+	return lo;
+}
+
+static void GenericList_mergeRange(
+	const U8 *a, U64 aLen, const U8 *b, U64 bLen,
+	U8 *out, U64 kBegin, U64 kEnd,
+	U64 stride, CompareFunction f, void *context
+) {
+
+	U64 i = GenericList_mergeSplit(a, aLen, b, bLen, kBegin, stride, f, context);
+	U64 j = kBegin - i;
+
+	const U64 iEnd = GenericList_mergeSplit(a, aLen, b, bLen, kEnd, stride, f, context);
+	const U64 jEnd = kEnd - iEnd;
+
+	U8 *o = out + kBegin * stride;
+
+	while (i < iEnd && j < jEnd) {
+
+		if (f(b + j * stride, a + i * stride, context) == ECompareResult_Lt) {
+			GenericList_sortCopy(o, b + j * stride, stride);
+			++j;
+		}
+
+		else {
+			GenericList_sortCopy(o, a + i * stride, stride);
+			++i;
+		}
+
+		o += stride;
+	}
+
+	if(i < iEnd)
+		Buffer_memcpy(Buffer_createRef(o, (iEnd - i) * stride), Buffer_createRefConst(a + i * stride, (iEnd - i) * stride));
+
+	else if(j < jEnd)
+		Buffer_memcpy(Buffer_createRef(o, (jEnd - j) * stride), Buffer_createRefConst(b + j * stride, (jEnd - j) * stride));
+}
+
+static void GenericList_mergeSort(U8 *data, U8 *tmp, U64 n, U64 stride, CompareFunction f, void *context) {
+
+	GenericListSorter s = (GenericListSorter) { .ptr = data, .stride = stride, .f = f, .context = context };
+
+	for(U64 i = 0; i < n; i += GenericList_mergeRun)
+		GenericListSorter_insertion(&s, i, U64_min(i + GenericList_mergeRun, n), true, U64_MAX);
+
+	U8 *src = data, *dst = tmp;
+
+	for (U64 width = GenericList_mergeRun; width < n; width *= 2) {
+
+		for (U64 lo = 0; lo < n; lo += width * 2) {
+
+			const U64 mid = U64_min(lo + width, n);
+			const U64 hi = U64_min(lo + width * 2, n);
+
+			const U8 *a = src + lo * stride, *b = src + mid * stride;
+
+			if(mid == hi || f(b, b - stride, context) != ECompareResult_Lt)        //In order already
+				Buffer_memcpy(Buffer_createRef(dst + lo * stride, (hi - lo) * stride), Buffer_createRefConst(a, (hi - lo) * stride));
+
+			else GenericList_mergeRange(a, mid - lo, b, hi - mid, dst + lo * stride, 0, hi - lo, stride, f, context);
+		}
+
+		U8 *swap = src;
+		src = dst;
+		dst = swap;
+	}
+
+	if(src != data)
+		Buffer_memcpy(Buffer_createRef(data, n * stride), Buffer_createRefConst(src, n * stride));
+}
+
+Bool GenericList_sortStable(GenericList list, CompareFunction f, void *context, const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Buffer tmp = Buffer_createNull();
+
+	if(!f)
+		retError(clean, Error_nullPointer(1, "GenericList_sortStable()::f is required"));
+
+	if(list.length <= 1)
+		goto clean;
+
+	if(list.stride > 1024)
+		retError(clean, Error_invalidParameter(0, 0, "GenericList_sortStable()::list.stride is limited to 1024"));
+
+	if(GenericList_isConstRef(list))
+		retError(clean, Error_constData(0, 0, "GenericList_sortStable()::list is const"));
+
+	if(list.length > GenericList_mergeRun)
+		gotoIfError3(clean, Buffer_createUninitializedBytes(GenericList_bytes(list), alloc, &tmp, e_rr));
+
+	GenericList_mergeSort((U8*) list.ptrNonConst, tmp.ptrNonConst, list.length, list.stride, f, context);
+
+clean:
+	Buffer_free(&tmp, alloc);
+	return s_uccess;
+}
+
+//Parallel sort.
+//The list is cut into a power of two of chunks that are sorted by sortCustom as jobs.
+//Then every round merges pairs of neighbouring runs into the temp buffer (or back), until one run remains.
+//A round doesn't get less parallel as the runs grow: the output of every merge is cut at the chunk boundaries
+// (using the merge path split), so every round is still one job per chunk.
+
+#define GenericList_sortParallelMinChunk 4096
+
+typedef struct GenericListParallelSort {
+
+	U8 *data, *tmp;
+	const U8 *src;
+	U8 *dst;
+
+	U64 length, stride, chunks, width;        //width: current run length in chunks
+
+	CompareFunction f;
+	void *context;
+
+	AtomicI64 failed;
+
+} GenericListParallelSort;
+
+static U64 GenericListParallelSort_bound(const GenericListParallelSort *p, U64 chunk) {
+	const U64 per = p->length / p->chunks, rem = p->length % p->chunks;
+	return per * chunk + U64_min(chunk, rem);
+}
+
+static Bool GenericListParallelSort_sortJob(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+
+	GenericListParallelSort *p = (GenericListParallelSort*) data;
+
+	for (U64 c = begin; c < end; ++c) {
+
+		const U64 start = GenericListParallelSort_bound(p, c);
+
+		const GenericList chunk = (GenericList) {
+			.ptrNonConst = p->data + start * p->stride,
+			.stride = p->stride,
+			.length = GenericListParallelSort_bound(p, c + 1) - start
+		};
+
+		if(!GenericList_sortCustom(chunk, p->f, p->context))
+			AtomicI64_store(&p->failed, 1);
+	}
+
+	return true;
+}
+
+static Bool GenericListParallelSort_mergeJob(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+
+	GenericListParallelSort *p = (GenericListParallelSort*) data;
+	const U64 stride = p->stride;
+
+	for (U64 c = begin; c < end; ++c) {
+
+		const U64 pairStart = c & ~(p->width * 2 - 1);
+		const U64 lo = GenericListParallelSort_bound(p, pairStart);
+		const U64 mid = GenericListParallelSort_bound(p, U64_min(pairStart + p->width, p->chunks));
+		const U64 hi = GenericListParallelSort_bound(p, U64_min(pairStart + p->width * 2, p->chunks));
+
+		GenericList_mergeRange(
+			p->src + lo * stride, mid - lo,
+			p->src + mid * stride, hi - mid,
+			p->dst + lo * stride,
+			GenericListParallelSort_bound(p, c) - lo, GenericListParallelSort_bound(p, c + 1) - lo,
+			stride, p->f, p->context
+		);
+	}
+
+	return true;
+}
+
+static Bool GenericListParallelSort_copyJob(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+
+	GenericListParallelSort *p = (GenericListParallelSort*) data;
+
+	const U64 start = GenericListParallelSort_bound(p, begin) * p->stride;
+	const U64 len = GenericListParallelSort_bound(p, end) * p->stride - start;
+
+	Buffer_memcpy(Buffer_createRef(p->data + start, len), Buffer_createRefConst(p->src + start, len));
+	return true;
+}
+
+Bool GenericList_sortParallel(
+	GenericList list,
+	CompareFunction f,
+	void *context,
+	JobQueue *queue,
+	const Allocator *alloc,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+	Buffer tmp = Buffer_createNull();
+
+	if(!f || !queue)
+		retError(clean, Error_nullPointer(!f ? 1 : 3, "GenericList_sortParallel()::f and queue are required"));
+
+	if(list.length <= 1)
+		goto clean;
+
+	if(list.stride > 1024)
+		retError(clean, Error_invalidParameter(0, 0, "GenericList_sortParallel()::list.stride is limited to 1024"));
+
+	if(GenericList_isConstRef(list))
+		retError(clean, Error_constData(0, 0, "GenericList_sortParallel()::list is const"));
+
+	//A power of two of chunks, 4 per thread to even out the load, but not too small to be worth a job
+
+	const U64 threads = JobQueue_threadCount(queue);
+	U64 chunks = 1;
+
+	while(chunks < threads * 4 && list.length / (chunks * 2) >= GenericList_sortParallelMinChunk)
+		chunks *= 2;
+
+	if (threads <= 1 || chunks == 1) {
+		GenericList_sortCustom(list, f, context);
+		goto clean;
+	}
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(GenericList_bytes(list), alloc, &tmp, e_rr));
+
+	GenericListParallelSort p = (GenericListParallelSort) {
+		.data = (U8*) list.ptrNonConst,
+		.tmp = tmp.ptrNonConst,
+		.length = list.length,
+		.stride = list.stride,
+		.chunks = chunks,
+		.f = f,
+		.context = context
+	};
+
+	gotoIfError3(clean, JobQueue_parallelFor(queue, chunks, 1, GenericListParallelSort_sortJob, &p, NULL, e_rr));
+	gotoIfError3(clean, JobQueue_wait(queue, e_rr));
+
+	if(AtomicI64_load(&p.failed))
+		retError(clean, Error_invalidState(0, "GenericList_sortParallel() sorting a chunk failed"));
+
+	p.src = p.data;
+	p.dst = p.tmp;
+
+	for (p.width = 1; p.width < chunks; p.width *= 2) {
+
+		gotoIfError3(clean, JobQueue_parallelFor(queue, chunks, 1, GenericListParallelSort_mergeJob, &p, NULL, e_rr));
+		gotoIfError3(clean, JobQueue_wait(queue, e_rr));
+
+		U8 *swap = (U8*) p.src;
+		p.src = p.dst;
+		p.dst = swap;
+	}
+
+	if (p.src != p.data) {
+		gotoIfError3(clean, JobQueue_parallelFor(queue, chunks, 1, GenericListParallelSort_copyJob, &p, NULL, e_rr));
+		gotoIfError3(clean, JobQueue_wait(queue, e_rr));
+	}
+
+clean:
+	Buffer_free(&tmp, alloc);
+	return s_uccess;
+}
+
+//Strings
+
+static inline ECompareResult GenericList_compareString(const void *aRaw, const void *bRaw, void *context) {
+	(void) context;
+	return CharString_compareSensitive((const CharString*) aRaw, (const CharString*) bRaw);
+}
+
+static inline ECompareResult GenericList_compareStringInsensitive(const void *aRaw, const void *bRaw, void *context) {
+	(void) context;
+	return CharString_compareInsensitive((const CharString*) aRaw, (const CharString*) bRaw);
+}
+
+Bool GenericList_sortString(GenericList list, EStringCase stringCase) {
+
+	if(list.stride != sizeof(CharString))        //We don't know the real type, but at least it's a check
+		return false;
+
+	return
+		stringCase == EStringCase_Insensitive ?
+		GenericList_sortCustom(list, GenericList_compareStringInsensitive, NULL) :
+		GenericList_sortCustom(list, GenericList_compareString, NULL);
+}
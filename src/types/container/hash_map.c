@@ -0,0 +1,487 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/hash_map.c
+
+#include "types/container/hash_map.h"
+#include "types/base/platform_types.h"
+#include "types/container/buffer.h"
+#include "types/container/string.h"
+#include "types/base/string_read_helper.h"
+#include "types/base/allocator.h"
+#include "types/base/error.h"
+#include "types/base/constants.h"
+
+//The group compare is the only part that differs per platform, the rest only sees the mask it produces.
+
+#if _SIMD == SIMD_SSE
+	#define HASH_MAP_SSE_GUARD
+	#include "types/container/simd/sse/sse_hash_map.inc.h"
+#elif _SIMD == SIMD_NEON
+	#define HASH_MAP_NEON_GUARD
+	#include "types/container/simd/neon/neon_hash_map.inc.h"
+#else
+	#define HASH_MAP_NONE_GUARD
+	#include "types/container/simd/none/none_hash_map.inc.h"
+#endif
+
+//Max load is 7/8: linear probing degrades quickly past that, and it keeps at least one empty slot for lookups to stop on.
+
+static U64 GenericHashMap_maxLength(U64 capacity) { return capacity - (capacity >> 3); }
+
+//The user's hash is mixed (murmur3's finalizer) so that the top 7 bits (the tag) and the low bits (the slot)
+// both depend on every input bit, otherwise identity hashes of small integers would all share tag 0.
+
+static U64 GenericHashMap_mix(U64 x) {
+	x ^= x >> 33;
+	x *= 0xFF51AFD7ED558CCD;
+	x ^= x >> 33;
+	x *= 0xC4CEB9FE1A85EC53;
+	x ^= x >> 33;
+	return x;
+}
+
+static U64 GenericHashMap_hashKey(const GenericHashMap *map, const void *key) {
+
+	U64 h;
+
+	if(map->hash)
+		h = map->hash(key);
+
+	else if(map->keyStride == sizeof(U64))
+		h = *(const U64*) key;
+
+	else if(map->keyStride == sizeof(U32))
+		h = *(const U32*) key;
+
+	else h = Buffer_hash64(Buffer_createRefConst(key, map->keyStride), 0);
+
+	return GenericHashMap_mix(h);
+}
+
+static Bool GenericHashMap_keyEquals(const GenericHashMap *map, const void *a, const void *b) {
+	return map->eq ? map->eq(a, b) : Buffer_eq(
+		Buffer_createRefConst(a, map->keyStride), Buffer_createRefConst(b, map->keyStride)
+	);
+}
+
+static U8 GenericHashMap_tag(U64 h) { return (U8)(h >> 57); }
+
+//Slots below HashMap_groupSize - 1 are mirrored past the end, so a group load at any slot sees the wrapped bytes
+
+static void GenericHashMap_setCtrl(GenericHashMap *map, U64 slot, U8 v) {
+
+	map->ctrl[slot] = v;
+
+	if(slot < HashMap_groupSize - 1)
+		map->ctrl[map->capacity + slot] = v;
+}
+
+static U64 GenericHashMap_alignment(U64 stride) {
+	const U64 lowestBit = stride & (~stride + 1);
+	return lowestBit > BUFFER_ALIGN_MAX ? BUFFER_ALIGN_MAX : lowestBit;
+}
+
+static U64 GenericHashMap_alignUp(U64 v, U64 alignment) { return (v + alignment - 1) &~ (alignment - 1); }
+
+static U64 GenericHashMap_findIn(const GenericHashMap *map, const void *key, U64 h) {
+
+	const U64 mask = map->capacity - 1;
+	const U8 tag = GenericHashMap_tag(h);
+	U64 pos = h & mask;
+
+	//Every entry sits between its home slot and the first empty slot after it (erase keeps it that way),
+	//so only candidates in front of the first empty in a group can be the key.
+
+	for(U64 probed = 0; probed < map->capacity; probed += HashMap_groupSize) {
+
+		const U8 *group = map->ctrl + pos;
+		const HashMapGroupMask empty = HashMapGroup_matchEmpty(group);
+		HashMapGroupMask match = HashMapGroupMask_before(HashMapGroup_match(group, tag), empty);
+
+		while (match) {
+
+			const U64 slot = (pos + HashMapGroupMask_first(match)) & mask;
+
+			if(GenericHashMap_keyEquals(map, key, map->keys + slot * map->keyStride))
+				return slot;
+
+			match = HashMapGroupMask_clearFirst(match);
+		}
+
+		if(empty)
+			return U64_MAX;
+
+		pos = (pos + HashMap_groupSize) & mask;
+	}
+
+	return U64_MAX;
+}
+
+//Only for keys that aren't present yet; the load factor guarantees an empty slot exists.
+
+static U64 GenericHashMap_claim(GenericHashMap *map, U64 h) {
+
+	const U64 mask = map->capacity - 1;
+	U64 pos = h & mask;
+
+	while (true) {
+
+		const HashMapGroupMask empty = HashMapGroup_matchEmpty(map->ctrl + pos);
+
+		if (empty) {
+			const U64 slot = (pos + HashMapGroupMask_first(empty)) & mask;
+			GenericHashMap_setCtrl(map, slot, GenericHashMap_tag(h));
+			++map->length;
+			return slot;
+		}
+
+		pos = (pos + HashMap_groupSize) & mask;
+	}
+}
+
+static Bool GenericHashMap_rehash(GenericHashMap *map, U64 capacity, const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Buffer data = Buffer_createNull();
+
+	const U64 keyAlign = GenericHashMap_alignment(map->keyStride);
+	const U64 valueAlign = map->valueStride ? GenericHashMap_alignment(map->valueStride) : 1;
+	const U64 alignment = keyAlign > valueAlign ? keyAlign : valueAlign;
+
+	const U64 strides = map->keyStride + map->valueStride;
+
+	if(strides < map->keyStride || strides > (U64_MAX >> 1) / capacity)
+		retError(clean, Error_overflow(1, capacity, strides, "GenericHashMap_rehash()::capacity * stride overflows"));
+
+	const U64 ctrlBytes = GenericHashMap_alignUp(capacity + HashMap_groupSize - 1, keyAlign);
+	const U64 valuesOffset = GenericHashMap_alignUp(ctrlBytes + capacity * map->keyStride, valueAlign);
+	const U64 bytes = valuesOffset + capacity * map->valueStride;
+
+	gotoIfError3(clean, alignment <= BUFFER_DEFAULT_ALIGNMENT ?
+		Buffer_createUninitializedBytes(bytes, alloc, &data, e_rr) :
+		Buffer_createUninitializedBytesAligned(bytes, alignment, 0, alloc, &data, e_rr)
+	);
+
+	GenericHashMap old = *map;
+
+	map->data = data;
+	map->ctrl = (U8*) data.ptr;
+	map->keys = map->ctrl + ctrlBytes;
+	map->values = map->ctrl + valuesOffset;
+	map->capacity = capacity;
+	map->length = 0;
+
+	data = Buffer_createNull();
+
+	for(U64 i = 0; i < capacity + HashMap_groupSize - 1; ++i)
+		map->ctrl[i] = HashMap_ctrlEmpty;
+
+	for (U64 i = 0; i < old.capacity; ++i) {
+
+		if(old.ctrl[i] & HashMap_ctrlEmpty)
+			continue;
+
+		const U8 *key = old.keys + i * old.keyStride;
+		const U64 slot = GenericHashMap_claim(map, GenericHashMap_hashKey(map, key));
+
+		Buffer_memcpy(
+			Buffer_createRef(map->keys + slot * map->keyStride, map->keyStride),
+			Buffer_createRefConst(key, map->keyStride)
+		);
+
+		if(map->valueStride)
+			Buffer_memcpy(
+				Buffer_createRef(map->values + slot * map->valueStride, map->valueStride),
+				Buffer_createRefConst(old.values + i * old.valueStride, old.valueStride)
+			);
+	}
+
+	Buffer_free(&old.data, alloc);
+
+clean:
+	Buffer_free(&data, alloc);
+	return s_uccess;
+}
+
+static Bool GenericHashMap_capacityFor(U64 length, U64 *capacity, Error *e_rr) {
+
+	Bool s_uccess = true;
+	U64 c = HashMap_groupSize;
+
+	if(length > (U64_MAX >> 8))
+		retError(clean, Error_overflow(0, length, U64_MAX >> 8, "GenericHashMap_capacityFor()::length too big"));
+
+	while(GenericHashMap_maxLength(c) < length)
+		c <<= 1;
+
+	*capacity = c;
+
+clean:
+	return s_uccess;
+}
+
+Bool GenericHashMap_create(
+	U64 keyStride,
+	U64 valueStride,
+	HashFunction hash,
+	EqualsFunction eq,
+	U64 capacity,
+	const Allocator *alloc,
+	GenericHashMap *result,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+
+	if(!result)
+		retError(clean, Error_nullPointer(6, "GenericHashMap_create()::result is required"));
+
+	if(result->data.ptr)
+		retError(clean, Error_invalidParameter(6, 0, "GenericHashMap_create()::result wasn't empty, could indicate memleak"));
+
+	if(!keyStride)
+		retError(clean, Error_invalidParameter(0, 0, "GenericHashMap_create()::keyStride is required"));
+
+	*result = (GenericHashMap) {
+		.keyStride = keyStride,
+		.valueStride = valueStride,
+		.hash = hash,
+		.eq = eq
+	};
+
+	if(capacity)
+		gotoIfError3(clean, GenericHashMap_reserve(result, capacity, alloc, e_rr));
+
+clean:
+	return s_uccess;
+}
+
+void GenericHashMap_free(GenericHashMap *map, const Allocator *alloc) {
+
+	if(!map)
+		return;
+
+	Buffer_free(&map->data, alloc);
+
+	*map = (GenericHashMap) {
+		.keyStride = map->keyStride,
+		.valueStride = map->valueStride,
+		.hash = map->hash,
+		.eq = map->eq
+	};
+}
+
+Bool GenericHashMap_reserve(GenericHashMap *map, U64 capacity, const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+	U64 newCapacity = 0;
+
+	if(!map || !map->keyStride)
+		retError(clean, Error_nullPointer(0, "GenericHashMap_reserve()::map is required"));
+
+	if(capacity <= GenericHashMap_maxLength(map->capacity) && map->capacity)
+		goto clean;
+
+	gotoIfError3(clean, GenericHashMap_capacityFor(capacity, &newCapacity, e_rr));
+	gotoIfError3(clean, GenericHashMap_rehash(map, newCapacity, alloc, e_rr));
+
+clean:
+	return s_uccess;
+}
+
+void GenericHashMap_clear(GenericHashMap *map) {
+
+	if(!map || !map->capacity)
+		return;
+
+	for(U64 i = 0; i < map->capacity + HashMap_groupSize - 1; ++i)
+		map->ctrl[i] = HashMap_ctrlEmpty;
+
+	map->length = 0;
+}
+
+U64 GenericHashMap_findSlot(const GenericHashMap *map, const void *key) {
+
+	if(!map || !key || !map->length)
+		return U64_MAX;
+
+	return GenericHashMap_findIn(map, key, GenericHashMap_hashKey(map, key));
+}
+
+Bool GenericHashMap_emplace(
+	GenericHashMap *map, const void *key, const Allocator *alloc, U64 *slot, Bool *inserted, Error *e_rr
+) {
+
+	Bool s_uccess = true;
+
+	if(!map || !key || !slot || !inserted)
+		retError(clean, Error_nullPointer(
+			!map ? 0 : (!key ? 1 : (!slot ? 3 : 4)), "GenericHashMap_emplace()::map, key, slot and inserted are required"
+		));
+
+	if(!map->keyStride)
+		retError(clean, Error_invalidState(0, "GenericHashMap_emplace()::map wasn't created"));
+
+	const U64 h = GenericHashMap_hashKey(map, key);
+
+	if (map->length) {
+
+		const U64 found = GenericHashMap_findIn(map, key, h);
+
+		if (found != U64_MAX) {
+			*slot = found;
+			*inserted = false;
+			goto clean;
+		}
+	}
+
+	if(!map->capacity || map->length + 1 > GenericHashMap_maxLength(map->capacity))
+		gotoIfError3(clean, GenericHashMap_rehash(
+			map, map->capacity ? map->capacity << 1 : HashMap_groupSize, alloc, e_rr
+		));
+
+	const U64 claimed = GenericHashMap_claim(map, h);
+
+	Buffer_memcpy(
+		Buffer_createRef(map->keys + claimed * map->keyStride, map->keyStride),
+		Buffer_createRefConst(key, map->keyStride)
+	);
+
+	if(map->valueStride)
+		Buffer_unsetAllBits(Buffer_createRef(map->values + claimed * map->valueStride, map->valueStride), NULL);
+
+	*slot = claimed;
+	*inserted = true;
+
+clean:
+	return s_uccess;
+}
+
+Bool GenericHashMap_insert(GenericHashMap *map, const void *key, const void *value, const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+	U64 slot = U64_MAX;
+	Bool inserted = false;
+
+	gotoIfError3(clean, GenericHashMap_emplace(map, key, alloc, &slot, &inserted, e_rr));
+
+	if(!inserted)
+		retError(clean, Error_alreadyDefined(0, "GenericHashMap_insert()::key already exists"));
+
+	if(value && map->valueStride)
+		Buffer_memcpy(
+			Buffer_createRef(map->values + slot * map->valueStride, map->valueStride),
+			Buffer_createRefConst(value, map->valueStride)
+		);
+
+clean:
+	return s_uccess;
+}
+
+Bool GenericHashMap_set(GenericHashMap *map, const void *key, const void *value, const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+	U64 slot = U64_MAX;
+	Bool inserted = false;
+
+	gotoIfError3(clean, GenericHashMap_emplace(map, key, alloc, &slot, &inserted, e_rr));
+
+	if(map->valueStride) {
+
+		const Buffer dst = Buffer_createRef(map->values + slot * map->valueStride, map->valueStride);
+
+		if(value)
+			Buffer_memcpy(dst, Buffer_createRefConst(value, map->valueStride));
+
+		else Buffer_unsetAllBits(dst, NULL);
+	}
+
+clean:
+	return s_uccess;
+}
+
+Bool GenericHashMap_erase(GenericHashMap *map, const void *key, void *valueOut) {
+
+	U64 hole = GenericHashMap_findSlot(map, key);
+
+	if(hole == U64_MAX)
+		return false;
+
+	if(valueOut && map->valueStride)
+		Buffer_memcpy(
+			Buffer_createRef(valueOut, map->valueStride),
+			Buffer_createRefConst(map->values + hole * map->valueStride, map->valueStride)
+		);
+
+	//Backward shift: walk the rest of the run and pull back every entry whose home slot allows it.
+	//An entry may move into the hole if the hole is between its home and where it is now (cyclically),
+	//so nothing ever ends up in front of its home or behind an empty slot.
+
+	const U64 mask = map->capacity - 1;
+
+	for (U64 i = (hole + 1) & mask; !(map->ctrl[i] & HashMap_ctrlEmpty); i = (i + 1) & mask) {
+
+		const U8 *moved = map->keys + i * map->keyStride;
+		const U64 home = GenericHashMap_hashKey(map, moved) & mask;
+
+		if(((i - home) & mask) < ((i - hole) & mask))
+			continue;
+
+		GenericHashMap_setCtrl(map, hole, map->ctrl[i]);
+
+		Buffer_memcpy(
+			Buffer_createRef(map->keys + hole * map->keyStride, map->keyStride),
+			Buffer_createRefConst(moved, map->keyStride)
+		);
+
+		if(map->valueStride)
+			Buffer_memcpy(
+				Buffer_createRef(map->values + hole * map->valueStride, map->valueStride),
+				Buffer_createRefConst(map->values + i * map->valueStride, map->valueStride)
+			);
+
+		hole = i;
+	}
+
+	GenericHashMap_setCtrl(map, hole, HashMap_ctrlEmpty);
+	--map->length;
+	return true;
+}
+
+U64 GenericHashMap_next(const GenericHashMap *map, U64 slot) {
+
+	if(!map)
+		return U64_MAX;
+
+	for(; slot < map->capacity; ++slot)
+		if(!(map->ctrl[slot] & HashMap_ctrlEmpty))
+			return slot;
+
+	return U64_MAX;
+}
+
+U64 GenericHashMap_hashString(const void *a) {
+	return CharString_hash(*(const CharString*) a);
+}
+
+Bool GenericHashMap_equalsString(const void *a, const void *b) {
+	return CharString_equalsStringSensitive((const CharString*) a, (const CharString*) b);
+}
@@ -26,33 +26,261 @@
 #include "types/base/error.h"
 #include "types/base/allocator.h"
 #include "types/base/constants.h"
+#include "types/base/mathi.h"
+#include "types/container/buffer.h"
+#include "types/container/trace.h"
 
 TListImpl(Job);
 TListNamedImpl(ListThreadHandle);
+TListNamedImpl(ListJobTaskPtr);
 
 static const Ns JobQueue_idleSleep = 100000;        //100 * MU
+static const U64 JobQueue_dequeCapacity = 256;      //Initial jobs per deque, doubles when full
+static const U64 JobQueue_compactThreshold = 1024;  //Taken jobs before the shared FIFO is compacted
+
+//The queue and context the current thread is running a job for.
+//A push only knows which deque is "local" through this, since JobQueue_push doesn't get a threadId.
+//Saved and restored around every job, so a job waiting on a different queue doesn't confuse the two.
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define JobQueue_threadLocal __declspec(thread)
+#else
+	#define JobQueue_threadLocal _Thread_local
+#endif
+
+static JobQueue_threadLocal JobQueue *JobQueue_currentQueue;
+static JobQueue_threadLocal U64 JobQueue_currentThreadId;
+
+//Work stealing deque (Chase-Lev).
+//
+//The owning context pushes and pops at bottom, thieves take from top with a cmpStore, which is also how the
+// owner settles the race for the last job.
+//All accesses that need ordering are seq_cst AtomicI64 operations (there's no standalone fence), that's why
+// top and bottom are sometimes read with an AtomicI64_add of 0 rather than a load.
+//
+//A thief copies a job out of the ring before its cmpStore and throws the copy away if that fails.
+//The owner only overwrites that slot once the ring wrapped around, which means top moved and the cmpStore
+// fails, so a torn copy is never run.
+//A ring that is replaced by a bigger one can still be read by a thief, so it's kept until JobQueue_free.
+
+typedef struct JobQueueRing {
+	Buffer data;                    //Allocation of this ring, jobs follow the header
+	struct JobQueueRing *prev;      //The smaller ring this one replaced
+	U64 mask;                       //Capacity - 1 (capacity is a power of two)
+} JobQueueRing;
+
+struct JobQueueDeque {
+	alignas(64) AtomicI64 top;      //Oldest job, stolen from here
+	alignas(64) AtomicI64 bottom;   //Newest job + 1, only written by the owner
+	AtomicI64 ring;                 //JobQueueRing*
+	U64 rng;                        //Victim selection, only touched by the owner
+};
+
+static Job *JobQueueRing_jobs(JobQueueRing *ring) {
+	return (Job*) (ring + 1);
+}
+
+static JobQueueRing *JobQueueDeque_ring(JobQueueDeque *deque) {
+	return (JobQueueRing*) (U64) AtomicI64_load(&deque->ring);
+}
+
+static Bool JobQueueRing_create(
+	U64 capacity, JobQueueRing *prev, const Allocator *alloc, JobQueueRing **result, Error *e_rr
+) {
+
+	Bool s_uccess = true;
+	Buffer data = Buffer_createNull();
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(
+		sizeof(JobQueueRing) + capacity * sizeof(Job), alloc, &data, e_rr
+	));
+
+	JobQueueRing *ring = (JobQueueRing*) data.ptrNonConst;
+	*ring = (JobQueueRing) { .data = data, .prev = prev, .mask = capacity - 1 };
+	*result = ring;
+
+clean:
+	return s_uccess;
+}
+
+static void JobQueueDeque_free(JobQueueDeque *deque, const Allocator *alloc) {
+
+	JobQueueRing *ring = JobQueueDeque_ring(deque);
+
+	while (ring) {
+		JobQueueRing *prev = ring->prev;
+		Buffer data = ring->data;
+		Buffer_free(&data, alloc);
+		ring = prev;
+	}
+
+	AtomicI64_store(&deque->ring, 0);
+}
+
+//Owner only
+
+static Bool JobQueueDeque_push(JobQueueDeque *deque, Job job, const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	const I64 b = AtomicI64_load(&deque->bottom);
+	const I64 t = AtomicI64_load(&deque->top);
+	JobQueueRing *ring = JobQueueDeque_ring(deque);
+
+	if ((U64)(b - t) > ring->mask) {
+
+		JobQueueRing *grown = NULL;
+		gotoIfError3(clean, JobQueueRing_create((ring->mask + 1) * 2, ring, alloc, &grown, e_rr));
+
+		for(I64 i = t; i < b; ++i)
+			JobQueueRing_jobs(grown)[(U64) i & grown->mask] = JobQueueRing_jobs(ring)[(U64) i & ring->mask];
+
+		AtomicI64_store(&deque->ring, (I64) (U64) grown);
+		ring = grown;
+	}
+
+	JobQueueRing_jobs(ring)[(U64) b & ring->mask] = job;
+	AtomicI64_store(&deque->bottom, b + 1);
+
+clean:
+	return s_uccess;
+}
+
+//Owner only, takes the newest job
+
+static Bool JobQueueDeque_pop(JobQueueDeque *deque, Job *job) {
+
+	const I64 b = AtomicI64_load(&deque->bottom) - 1;
+	AtomicI64_store(&deque->bottom, b);
+
+	const I64 t = AtomicI64_add(&deque->top, 0);
+
+	if (t > b) {
+		AtomicI64_store(&deque->bottom, b + 1);
+		return false;
+	}
 
-//Pop the next job.
-//Returns false if the queue is currently empty.
+	const JobQueueRing *ring = JobQueueDeque_ring(deque);
+	*job = JobQueueRing_jobs((JobQueueRing*) ring)[(U64) b & ring->mask];
 
-static Bool JobQueue_pop(JobQueue *queue, Job *job) {
+	if(t != b)
+		return true;
+
+	//Last job, a thief might be after it as well
+
+	const Bool won = AtomicI64_cmpStore(&deque->top, t, t + 1) == t;
+	AtomicI64_store(&deque->bottom, b + 1);
+	return won;
+}
+
+//Any context, takes the oldest job
+
+static Bool JobQueueDeque_steal(JobQueueDeque *deque, Job *job) {
+
+	const I64 t = AtomicI64_add(&deque->top, 0);
+	const I64 b = AtomicI64_add(&deque->bottom, 0);
+
+	if(t >= b)
+		return false;
+
+	const JobQueueRing *ring = JobQueueDeque_ring(deque);
+	*job = JobQueueRing_jobs((JobQueueRing*) ring)[(U64) t & ring->mask];
+
+	return AtomicI64_cmpStore(&deque->top, t, t + 1) == t;
+}
+
+//Pop the next job from the shared FIFOs, highest priority first, skipping the ones below lowest.
+//Returns false if they're currently empty.
+
+static Bool JobQueue_pop(JobQueue *queue, EJobPriority lowest, Job *job) {
 
 	Bool popped = false;
+	Bool any = false;
+
+	for(U64 p = lowest; p < EJobPriority_Count; ++p)
+		any |= AtomicI64_load(&queue->queued[p]) > 0;
+
+	if(!any)
+		return false;
 
-	const ELockAcquire acq = SpinLock_lock(&queue->lock, U64_MAX);
+	const ELockAcquire acq = Mutex_lock(&queue->lock, U64_MAX);
 
 	if(acq < ELockAcquire_Success)
 		return false;
 
-	if(queue->jobs.length)
-		popped = ListJob_popFront(&queue->jobs, job, NULL);
+	for (U64 p = EJobPriority_Count; !popped && p-- > (U64) lowest; ) {
+
+		ListJob *jobs = &queue->jobs[p];
+		U64 *head = &queue->jobsHead[p];
+
+		if(*head >= jobs->length)
+			continue;
+
+		//popFront would move every remaining job each time, so head skips over the ones that were taken and the
+		// list is only compacted once at least half of it is dead (or cleared once it is all dead).
+
+		*job = jobs->ptr[(*head)++];
+		popped = true;
+		AtomicI64_dec(&queue->queued[p]);
+
+		if (*head == jobs->length) {
+			ListJob_clear(jobs, NULL);
+			*head = 0;
+		}
+
+		else if (*head >= JobQueue_compactThreshold && *head * 2 >= jobs->length) {
+
+			const U64 remaining = jobs->length - *head;
+
+			for(U64 i = 0; i < remaining; ++i)
+				jobs->ptrNonConst[i] = jobs->ptr[*head + i];
+
+			ListJob_resize(jobs, remaining, queue->alloc, NULL);      //Shrinking doesn't allocate
+			*head = 0;
+		}
+	}
 
 	if(acq == ELockAcquire_Acquired)
-		SpinLock_unlock(&queue->lock);
+		Mutex_unlock(&queue->lock);
 
 	return popped;
 }
 
+//High priority FIFO, then the own deque, then the normal FIFO, then steal from the other contexts starting at a
+// random one.
+
+static Bool JobQueue_take(JobQueue *queue, U64 threadId, Job *job) {
+
+	if(!Buffer_length(queue->deques))
+		return JobQueue_pop(queue, EJobPriority_Normal, job);
+
+	JobQueueDeque *deques = (JobQueueDeque*) queue->deques.ptrNonConst;
+	JobQueueDeque *local = &deques[threadId];
+
+	if(
+		JobQueue_pop(queue, EJobPriority_High, job) ||
+		JobQueueDeque_pop(local, job) ||
+		JobQueue_pop(queue, EJobPriority_Normal, job)
+	)
+		return true;
+
+	//xorshift64, the state is only used by this context
+
+	U64 rng = local->rng;
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+	local->rng = rng;
+
+	for (U64 i = 0, j = rng % queue->threadCount; i < queue->threadCount; ++i, j = (j + 1) % queue->threadCount)
+		if (j != threadId && JobQueueDeque_steal(&deques[j], job)) {
+			Trace_instant("JobQueue", "steal");
+			return true;
+		}
+
+	return false;
+}
+
 //Run one job and update bookkeeping.
 //Returns false if no job was available.
 
@@ -60,12 +288,25 @@ static Bool JobQueue_runOne(JobQueue *queue, U64 threadId) {
 
 	Job job = (Job) { 0 };
 
-	if(!JobQueue_pop(queue, &job))
+	if(!JobQueue_take(queue, threadId, &job))
 		return false;
 
+	JobQueue *prevQueue = JobQueue_currentQueue;
+	const U64 prevThreadId = JobQueue_currentThreadId;
+
+	JobQueue_currentQueue = queue;
+	JobQueue_currentThreadId = threadId;
+
+	Trace_zoneBegin("JobQueue", "job");
+
 	if(!job.callback || !job.callback(job.data, threadId, queue))
 		AtomicI64_inc(&queue->failedJobs);
 
+	Trace_zoneEnd("JobQueue", "job");
+
+	JobQueue_currentQueue = prevQueue;
+	JobQueue_currentThreadId = prevThreadId;
+
 	AtomicI64_dec(&queue->pending);
 	return true;
 }
@@ -83,6 +324,12 @@ static void JobQueue_workerLoop(void *queuePtr) {
 
 	while(true) {
 
+		//With work stealing, jobs can sit in any deque, so rather than draining them on shutdown the workers stop
+		// right away and JobQueue_free discards whatever is left.
+
+		if(Buffer_length(queue->deques) && AtomicI64_load(&queue->shutdown))
+			break;
+
 		if(JobQueue_runOne(queue, threadId))
 			continue;
 
@@ -93,27 +340,54 @@ static void JobQueue_workerLoop(void *queuePtr) {
 	}
 }
 
-Bool JobQueue_create(U64 threadCount, const Allocator *alloc, JobQueue *queue, Error *e_rr) {
+Bool JobQueue_createFlags(
+	U64 threadCount, EJobQueueFlags flags, const Allocator *alloc, JobQueue *queue, Error *e_rr
+) {
 
 	Bool s_uccess = true;
 
 	if(!queue)
-		retError(clean, Error_nullPointer(2, "JobQueue_create()::queue is required"));
+		retError(clean, Error_nullPointer(3, "JobQueue_create()::queue is required"));
 
 	if(!alloc)
-		retError(clean, Error_nullPointer(1, "JobQueue_create()::alloc is required"));
+		retError(clean, Error_nullPointer(2, "JobQueue_create()::alloc is required"));
 
-	if(queue->jobs.ptr || queue->threads.ptr)
-		retError(clean, Error_invalidParameter(2, 0, "JobQueue_create()::queue wasn't zero initialized, might indicate memleak"));
+	if(flags >> EJobQueueFlags_Count)
+		retError(clean, Error_invalidEnum(1, (U64) flags, (1 << EJobQueueFlags_Count) - 1, "JobQueue_create()::flags is invalid"));
+
+	if(queue->jobs[EJobPriority_Normal].ptr || queue->jobs[EJobPriority_High].ptr || queue->threads.ptr || queue->deques.ptr)
+		retError(clean, Error_invalidParameter(3, 0, "JobQueue_create()::queue wasn't zero initialized, might indicate memleak"));
 
 	if(!threadCount)
 		threadCount = 1;
 
 	*queue = (JobQueue) {
 		.alloc = alloc,
-		.threadCount = threadCount
+		.threadCount = threadCount,
+		.flags = flags
 	};
 
+	//Deques have to exist before the first worker can look at them.
+	//Single threaded mode has nothing to steal from and stays FIFO, so it doesn't get any.
+
+	if ((flags & EJobQueueFlags_WorkStealing) && threadCount > 1) {
+
+		gotoIfError3(clean, Buffer_createEmptyBytesAligned(
+			threadCount * sizeof(JobQueueDeque), alignof(JobQueueDeque), 0, alloc, &queue->deques, e_rr
+		));
+
+		JobQueueDeque *deques = (JobQueueDeque*) queue->deques.ptrNonConst;
+
+		for (U64 i = 0; i < threadCount; ++i) {
+
+			JobQueueRing *ring = NULL;
+			gotoIfError3(clean, JobQueueRing_create(JobQueue_dequeCapacity, NULL, alloc, &ring, e_rr));
+
+			AtomicI64_store(&deques[i].ring, (I64) (U64) ring);
+			deques[i].rng = (i + 1) * 0x9E3779B97F4A7C15;
+		}
+	}
+
 	//The owner thread (which calls JobQueue_wait) is context 0, so only spawn threadCount - 1 workers.
 	//In single threaded mode this spawns nothing and everything runs inline in JobQueue_wait.
 
@@ -135,8 +409,12 @@ clean:
 	return s_uccess;
 }
 
-Bool JobQueue_pushDestructor(
-	JobQueue *queue, JobCallback callback, void *data, JobDestructor destructor, Error *e_rr
+Bool JobQueue_create(U64 threadCount, const Allocator *alloc, JobQueue *queue, Error *e_rr) {
+	return JobQueue_createFlags(threadCount, EJobQueueFlags_None, alloc, queue, e_rr);
+}
+
+Bool JobQueue_pushPriority(
+	JobQueue *queue, EJobPriority priority, JobCallback callback, void *data, JobDestructor destructor, Error *e_rr
 ) {
 
 	Bool s_uccess = true;
@@ -145,30 +423,58 @@ Bool JobQueue_pushDestructor(
 	if(!queue)
 		retError(clean, Error_nullPointer(0, "JobQueue_push()::queue is required"));
 
+	if(priority >= EJobPriority_Count)
+		retError(clean, Error_invalidEnum(1, (U64) priority, EJobPriority_Count, "JobQueue_push()::priority is invalid"));
+
 	if(!callback)
-		retError(clean, Error_nullPointer(1, "JobQueue_push()::callback is required"));
+		retError(clean, Error_nullPointer(2, "JobQueue_push()::callback is required"));
 
 	if(AtomicI64_load(&queue->shutdown))
 		retError(clean, Error_invalidState(0, "JobQueue_push() queue is shutting down"));
 
-	acq = SpinLock_lock(&queue->lock, U64_MAX);
+	const Job job = (Job) { .callback = callback, .data = data, .destructor = destructor };
+
+	//Pushed from inside one of our own jobs, so it can go to that context's deque without locking.
+	//pending goes up first, since a thief could otherwise finish the job before it was counted.
+
+	if (priority == EJobPriority_Normal && Buffer_length(queue->deques) && JobQueue_currentQueue == queue) {
+
+		JobQueueDeque *deque = &((JobQueueDeque*) queue->deques.ptrNonConst)[JobQueue_currentThreadId];
+
+		AtomicI64_inc(&queue->pending);
+
+		if (!JobQueueDeque_push(deque, job, queue->alloc, e_rr)) {
+			AtomicI64_dec(&queue->pending);
+			s_uccess = false;
+		}
+
+		goto clean;
+	}
+
+	acq = Mutex_lock(&queue->lock, U64_MAX);
 
 	if(acq < ELockAcquire_Success)
 		retError(clean, Error_invalidState(0, "JobQueue_push() couldn't acquire lock"));
 
-	const Job job = (Job) { .callback = callback, .data = data, .destructor = destructor };
-	gotoIfError3(clean, ListJob_pushBack(&queue->jobs, job, queue->alloc, e_rr));
+	gotoIfError3(clean, ListJob_pushBack(&queue->jobs[priority], job, queue->alloc, e_rr));
 
 	AtomicI64_inc(&queue->pending);
+	AtomicI64_inc(&queue->queued[priority]);
 
 clean:
 
 	if(acq == ELockAcquire_Acquired)
-		SpinLock_unlock(&queue->lock);
+		Mutex_unlock(&queue->lock);
 
 	return s_uccess;
 }
 
+Bool JobQueue_pushDestructor(
+	JobQueue *queue, JobCallback callback, void *data, JobDestructor destructor, Error *e_rr
+) {
+	return JobQueue_pushPriority(queue, EJobPriority_Normal, callback, data, destructor, e_rr);
+}
+
 Bool JobQueue_push(JobQueue *queue, JobCallback callback, void *data, Error *e_rr) {
 	return JobQueue_pushDestructor(queue, callback, data, NULL, e_rr);
 }
@@ -203,6 +509,8 @@ Bool JobQueue_wait(JobQueue *queue, Error *e_rr) {
 	//pending only hits 0 once all jobs *and* the jobs they spawned have finished,
 	// so this also covers multi-stage fan-out pipelines.
 
+	Trace_zoneBegin("JobQueue", "wait");
+
 	while (AtomicI64_load(&queue->pending)) {
 
 		if(JobQueue_runOne(queue, 0))
@@ -213,6 +521,8 @@ Bool JobQueue_wait(JobQueue *queue, Error *e_rr) {
 		Thread_sleep(JobQueue_idleSleep);
 	}
 
+	Trace_zoneEnd("JobQueue", "wait");
+
 clean:
 	return s_uccess;
 }
@@ -225,31 +535,67 @@ U64 JobQueue_threadCount(const JobQueue *queue) {
 	return !queue ? 0 : queue->threadCount;
 }
 
-void JobQueue_free(JobQueue *queue) {
+//Destroy jobs that never ran so allocator-backed job data (e.g. C++ callables) isn't leaked.
+//The jobs are moved out under the lock and destroyed after it's released,
+// since a destructor can push onto the same lists (e.g. JobTask_skip releasing its dependents).
+//Whatever was pushed meanwhile is picked up by the next round, until nothing is left.
 
-	if(!queue)
-		return;
+static void JobQueue_discardShared(JobQueue *queue) {
 
-	//Discard jobs that haven't started and signal shutdown, then join workers.
-	//Workers finish their current job before exiting.
+	Bool any = true;
+
+	while (any) {
+
+		ListJob discarded[EJobPriority_Count];
+		U64 heads[EJobPriority_Count];
+
+		const ELockAcquire acq = Mutex_lock(&queue->lock, U64_MAX);
+
+		for (U64 p = 0; p < EJobPriority_Count; ++p) {
+
+			discarded[p] = queue->jobs[p];
+			heads[p] = queue->jobsHead[p];
+
+			AtomicI64_sub(&queue->pending, (I64) (discarded[p].length - heads[p]));
+
+			queue->jobs[p] = (ListJob) { 0 };
+			queue->jobsHead[p] = 0;
+			AtomicI64_store(&queue->queued[p], 0);
+		}
 
-	const ELockAcquire acq = SpinLock_lock(&queue->lock, U64_MAX);
+		if(acq == ELockAcquire_Acquired)
+			Mutex_unlock(&queue->lock);
 
-	AtomicI64_sub(&queue->pending, (I64) queue->jobs.length);
+		any = false;
 
-	//Destroy jobs that never ran so allocator-backed job data (e.g. C++ callables) isn't leaked.
+		for (U64 p = 0; p < EJobPriority_Count; ++p) {
 
-	for(U64 i = 0; i < queue->jobs.length; ++i) {
-		const Job discarded = queue->jobs.ptr[i];
-		if(discarded.destructor)
-			discarded.destructor(discarded.data);
+			for(U64 i = heads[p]; i < discarded[p].length; ++i) {
+
+				any = true;
+
+				if(discarded[p].ptr[i].destructor)
+					discarded[p].ptr[i].destructor(discarded[p].ptr[i].data);
+			}
+
+			ListJob_free(&discarded[p], queue->alloc);
+		}
 	}
+}
 
-	ListJob_clear(&queue->jobs, NULL);
+void JobQueue_free(JobQueue *queue) {
 
-	if(acq == ELockAcquire_Acquired)
-		SpinLock_unlock(&queue->lock);
+	if(!queue)
+		return;
 
+	//Discard jobs that haven't started and signal shutdown, then join workers.
+	//Workers finish their current job before exiting.
+	//With work stealing they stop before taking another job, so shutdown has to be set before anything else.
+
+	if(Buffer_length(queue->deques))
+		AtomicI64_store(&queue->shutdown, 1);
+
+	JobQueue_discardShared(queue);
 	AtomicI64_store(&queue->shutdown, 1);
 
 	for(U64 i = 0; i < queue->threads.length; ++i)
@@ -257,7 +603,37 @@ void JobQueue_free(JobQueue *queue) {
 			Thread_waitAndCleanup(queue->alloc, &queue->threads.ptrNonConst[i], NULL);
 
 	ListThreadHandle_free(&queue->threads, queue->alloc);
-	ListJob_free(&queue->jobs, queue->alloc);
+
+	JobQueueDeque *deques = (JobQueueDeque*) queue->deques.ptrNonConst;
+
+	for (U64 i = 0; deques && i < queue->threadCount; ++i) {
+
+		JobQueueRing *ring = JobQueueDeque_ring(&deques[i]);
+
+		if(!ring)       //Might be partially created if JobQueue_create failed midway
+			continue;
+
+		const I64 t = AtomicI64_load(&deques[i].top);
+		const I64 b = AtomicI64_load(&deques[i].bottom);
+
+		for (I64 j = t; j < b; ++j) {
+			const Job discarded = JobQueueRing_jobs(ring)[(U64) j & ring->mask];
+			if(discarded.destructor)
+				discarded.destructor(discarded.data);
+		}
+
+		JobQueueDeque_free(&deques[i], queue->alloc);
+	}
+
+	Buffer_free(&queue->deques, queue->alloc);
+
+	//Nothing runs anymore, so this only discards what the last running jobs (or the destructors above) pushed.
+	//Only work stealing can leave anything here; FIFO workers drain the lists before exiting.
+
+	JobQueue_discardShared(queue);
+
+	for(U64 p = 0; p < EJobPriority_Count; ++p)
+		ListJob_free(&queue->jobs[p], queue->alloc);
 
 	*queue = (JobQueue) { 0 };
 }
@@ -337,8 +713,8 @@ Bool JobGroup_leave(JobGroup *group, Error *e_rr) {
 	//The finalize job carries dataDestructor so data is still freed if it is discarded on shutdown.
 
 	if(!AtomicI64_load(&group->failed) && group->finalize) {
-		gotoIfError3(clean, JobQueue_pushDestructor(
-			group->queue, group->finalize, group->data, group->dataDestructor, e_rr
+		gotoIfError3(clean, JobQueue_pushPriority(
+			group->queue, EJobPriority_High, group->finalize, group->data, group->dataDestructor, e_rr
 		));
 	}
 
@@ -348,3 +724,364 @@ Bool JobGroup_leave(JobGroup *group, Error *e_rr) {
 clean:
 	return s_uccess;
 }
+
+//JobTask
+
+static void JobTask_release(JobTask *task, Bool failed);
+
+//Releases the continuations and marks the task done.
+//Once done is set the owner may free the task, so nothing can touch it afterwards.
+
+static void JobTask_finish(JobTask *task) {
+
+	const Allocator *alloc = task->queue->alloc;
+
+	const ELockAcquire acq = SpinLock_lock(&task->lock, U64_MAX);
+
+	task->closed = true;
+	ListJobTaskPtr continuations = task->continuations;
+	task->continuations = (ListJobTaskPtr) { 0 };
+
+	if(acq == ELockAcquire_Acquired)
+		SpinLock_unlock(&task->lock);
+
+	const Bool failed = AtomicI64_load(&task->failed);
+
+	for(U64 i = 0; i < continuations.length; ++i)
+		JobTask_release(continuations.ptrNonConst[i], failed);
+
+	ListJobTaskPtr_free(&continuations, alloc);
+	AtomicI64_store(&task->done, 1);
+}
+
+//Also the JobDestructor of a pushed task, so a task discarded by JobQueue_free fails its continuations too.
+
+static void JobTask_skip(void *data) {
+
+	JobTask *task = (JobTask*) data;
+	AtomicI64_store(&task->failed, 1);
+
+	if(task->destructor)
+		task->destructor(task->data);
+
+	JobTask_finish(task);
+}
+
+static Bool JobTask_run(void *data, U64 threadId, JobQueue *queue) {
+
+	JobTask *task = (JobTask*) data;
+	const Bool success = task->callback(task->data, threadId, queue);
+
+	if(!success)
+		AtomicI64_store(&task->failed, 1);
+
+	JobTask_finish(task);
+	return success;
+}
+
+//Drops one dependency, the last one pushes the task (or skips it if something before it failed).
+
+static void JobTask_release(JobTask *task, Bool failed) {
+
+	if(failed)
+		AtomicI64_store(&task->failed, 1);
+
+	if(AtomicI64_dec(&task->dependencies) > 0)
+		return;
+
+	if(AtomicI64_load(&task->failed)) {
+		JobTask_skip(task);
+		return;
+	}
+
+	if(!task->callback) {
+		JobTask_finish(task);
+		return;
+	}
+
+	//A push can only fail on shutdown or out of memory, neither of which leaves anything that could run it
+
+	if(!JobQueue_pushPriority(task->queue, task->priority, JobTask_run, task, JobTask_skip, NULL))
+		JobTask_skip(task);
+}
+
+Bool JobTask_create(
+	JobTask *task,
+	JobQueue *queue,
+	EJobPriority priority,
+	JobCallback callback,
+	void *data,
+	JobDestructor destructor,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+
+	if(!task)
+		retError(clean, Error_nullPointer(0, "JobTask_create()::task is required"));
+
+	if(!queue)
+		retError(clean, Error_nullPointer(1, "JobTask_create()::queue is required"));
+
+	if(priority >= EJobPriority_Count)
+		retError(clean, Error_invalidEnum(2, (U64) priority, EJobPriority_Count, "JobTask_create()::priority is invalid"));
+
+	if(task->queue || AtomicI64_load(&task->dependencies))
+		retError(clean, Error_invalidParameter(0, 0, "JobTask_create()::task wasn't zero initialized"));
+
+	task->queue = queue;
+	task->priority = priority;
+	task->callback = callback;
+	task->data = data;
+	task->destructor = destructor;
+
+	AtomicI64_store(&task->dependencies, 1);        //Held until JobTask_submit
+
+clean:
+	return s_uccess;
+}
+
+Bool JobTask_precede(JobTask *before, JobTask *after, Error *e_rr) {
+
+	Bool s_uccess = true;
+	ELockAcquire acq = ELockAcquire_Invalid;
+	Bool added = false;
+
+	if(!before || !after)
+		retError(clean, Error_nullPointer(!before ? 0 : 1, "JobTask_precede()::before and after are required"));
+
+	if(!before->queue || !after->queue)
+		retError(clean, Error_invalidState(0, "JobTask_precede() tasks weren't created"));
+
+	if(before == after)
+		retError(clean, Error_invalidParameter(1, 0, "JobTask_precede() a task can't precede itself"));
+
+	if(AtomicI64_load(&after->done))
+		retError(clean, Error_invalidState(1, "JobTask_precede()::after already finished"));
+
+	acq = SpinLock_lock(&before->lock, U64_MAX);
+
+	if(acq < ELockAcquire_Success)
+		retError(clean, Error_invalidState(2, "JobTask_precede() couldn't acquire lock"));
+
+	//Already finished, nothing to wait for; other than passing on the failure
+
+	if (before->closed) {
+
+		if(AtomicI64_load(&before->failed))
+			AtomicI64_store(&after->failed, 1);
+
+		goto clean;
+	}
+
+	AtomicI64_inc(&after->dependencies);
+	added = true;
+
+	gotoIfError3(clean, ListJobTaskPtr_pushBack(&before->continuations, after, before->queue->alloc, e_rr));
+
+clean:
+
+	if(!s_uccess && added)          //Can't be the last one, JobTask_submit wasn't called yet
+		AtomicI64_dec(&after->dependencies);
+
+	if(acq == ELockAcquire_Acquired)
+		SpinLock_unlock(&before->lock);
+
+	return s_uccess;
+}
+
+Bool JobTask_submit(JobTask *task, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(!task)
+		retError(clean, Error_nullPointer(0, "JobTask_submit()::task is required"));
+
+	if(!task->queue)
+		retError(clean, Error_invalidState(0, "JobTask_submit() task wasn't created"));
+
+	if(AtomicI64_load(&task->dependencies) <= 0)
+		retError(clean, Error_invalidState(1, "JobTask_submit() task was already submitted"));
+
+	JobTask_release(task, false);
+
+clean:
+	return s_uccess;
+}
+
+Bool JobTask_isDone(const JobTask *task) {
+	return task && AtomicI64_load((AtomicI64*) &task->done);
+}
+
+Bool JobTask_isSuccess(const JobTask *task) {
+	return task && !AtomicI64_load((AtomicI64*) &task->failed);
+}
+
+//Parallel for
+
+typedef struct JobParallelFor {
+
+	Buffer data;                    //Allocation of this struct
+	JobQueue *queue;
+	JobRangeCallback callback;
+	void *userData;
+	JobTask *continuation;
+
+	U64 grainSize;
+
+	AtomicI64 remaining;            //Elements that weren't processed (or discarded) yet
+	AtomicI64 failed;
+
+} JobParallelFor;
+
+typedef struct JobParallelForRange {
+	Buffer data;                    //Allocation of this struct
+	JobParallelFor *shared;
+	U64 begin, end;
+} JobParallelForRange;
+
+//Called once per range, the last one releases the continuation and frees the shared state.
+
+static void JobParallelFor_finish(JobParallelFor *shared, U64 count, Bool success) {
+
+	if(!success)
+		AtomicI64_store(&shared->failed, 1);
+
+	if(AtomicI64_sub(&shared->remaining, (I64) count) != (I64) count)
+		return;
+
+	if(shared->continuation)
+		JobTask_release(shared->continuation, AtomicI64_load(&shared->failed));
+
+	Buffer data = shared->data;
+	Buffer_free(&data, shared->queue->alloc);
+}
+
+static void JobParallelForRange_free(JobParallelForRange *range, const Allocator *alloc) {
+	Buffer data = range->data;
+	Buffer_free(&data, alloc);
+}
+
+static void JobParallelFor_discard(void *data) {
+
+	JobParallelForRange *range = (JobParallelForRange*) data;
+	JobParallelFor *shared = range->shared;
+	const U64 count = range->end - range->begin;
+
+	JobParallelForRange_free(range, shared->queue->alloc);
+	JobParallelFor_finish(shared, count, false);
+}
+
+static Bool JobParallelFor_run(void *data, U64 threadId, JobQueue *queue);
+
+static Bool JobParallelFor_push(JobParallelFor *shared, U64 begin, U64 end, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Buffer data = Buffer_createNull();
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(sizeof(JobParallelForRange), shared->queue->alloc, &data, e_rr));
+
+	JobParallelForRange *range = (JobParallelForRange*) data.ptrNonConst;
+	*range = (JobParallelForRange) { .data = data, .shared = shared, .begin = begin, .end = end };
+
+	gotoIfError3(clean, JobQueue_pushDestructor(shared->queue, JobParallelFor_run, range, JobParallelFor_discard, e_rr));
+	data = Buffer_createNull();     //Owned by the job now
+
+clean:
+	Buffer_free(&data, shared->queue->alloc);
+	return s_uccess;
+}
+
+static Bool JobParallelFor_run(void *data, U64 threadId, JobQueue *queue) {
+
+	JobParallelForRange *range = (JobParallelForRange*) data;
+	JobParallelFor *shared = range->shared;
+
+	U64 begin = range->begin, end = range->end;
+	JobParallelForRange_free(range, queue->alloc);
+
+	//Hand off the upper half until only a grain is left.
+	//If that fails (out of memory) the rest is simply done here.
+
+	while(end - begin > shared->grainSize) {
+
+		const U64 mid = begin + (end - begin) / 2;
+
+		if(!JobParallelFor_push(shared, mid, end, NULL))
+			break;
+
+		end = mid;
+	}
+
+	const Bool success = shared->callback(shared->userData, begin, end, threadId, queue);
+	JobParallelFor_finish(shared, end - begin, success);
+	return success;
+}
+
+Bool JobQueue_parallelFor(
+	JobQueue *queue,
+	U64 count,
+	U64 grainSize,
+	JobRangeCallback callback,
+	void *data,
+	JobTask *continuation,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+	Buffer sharedData = Buffer_createNull();
+	Bool entered = false;
+
+	if(!queue)
+		retError(clean, Error_nullPointer(0, "JobQueue_parallelFor()::queue is required"));
+
+	if(!callback)
+		retError(clean, Error_nullPointer(3, "JobQueue_parallelFor()::callback is required"));
+
+	if(continuation && !continuation->queue)
+		retError(clean, Error_invalidState(0, "JobQueue_parallelFor()::continuation wasn't created"));
+
+	if(count >> 62)
+		retError(clean, Error_outOfBounds(1, count, (U64)1 << 62, "JobQueue_parallelFor()::count is too big"));
+
+	if(!count)
+		goto clean;
+
+	//A few ranges per context, so the ones that finish early have something left to steal
+
+	if(!grainSize)
+		grainSize = U64_max(1, count / (JobQueue_threadCount(queue) * 8));
+
+	gotoIfError3(clean, Buffer_createEmptyBytes(sizeof(JobParallelFor), queue->alloc, &sharedData, e_rr));
+
+	JobParallelFor *shared = (JobParallelFor*) sharedData.ptrNonConst;
+
+	*shared = (JobParallelFor) {
+		.data = sharedData,
+		.queue = queue,
+		.callback = callback,
+		.userData = data,
+		.continuation = continuation,
+		.grainSize = grainSize
+	};
+
+	AtomicI64_store(&shared->remaining, (I64) count);
+
+	if (continuation) {
+		AtomicI64_inc(&continuation->dependencies);
+		entered = true;
+	}
+
+	gotoIfError3(clean, JobParallelFor_push(shared, 0, count, e_rr));
+	sharedData = Buffer_createNull();       //Owned by the ranges now
+
+clean:
+
+	if(!s_uccess && entered)
+		AtomicI64_dec(&continuation->dependencies);
+
+	if(queue)
+		Buffer_free(&sharedData, queue->alloc);
+
+	return s_uccess;
+}
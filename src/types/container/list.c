@@ -30,6 +30,10 @@ Bool ListU64_sort(ListU64 l) {
 	return GenericList_sortU64(ListU64_toList(l));
 }
 
+Bool ListU64_sortRadix(ListU64 l, const Allocator *alloc, Error *e_rr) {
+	return GenericList_sortRadixU64(ListU64_toList(l), alloc, e_rr);
+}
+
 TListSortImpl(U8);    TListSortImpl(U16); TListSortImpl(U32);
 TListSortImpl(I8);    TListSortImpl(I16); TListSortImpl(I32); TListSortImpl(I64);
 TListSortImpl(F32); TListSortImpl(F64);
@@ -202,7 +202,9 @@ Bool MemoryStream_createFromBuffer(
 		(flags & EMemoryStreamFlags_IsResizable) ? MemoryStream_reserveInternal : NULL,
 		MemoryStream_closeInternal,
 		Buffer_length(*buffer),
-		EStreamType_Memory | (flags & EMemoryStreamFlags_IsResizable ? EStreamType_Resizable : 0),
+		EStreamType_Memory |
+		(flags & EMemoryStreamFlags_IsResizable ? EStreamType_Resizable : 0) |
+		(flags & EMemoryStreamFlags_WriteResize ? 0 : EStreamType_Mapped),        //Data that can't change or move
 		type,
 		memStream,
 		e_rr
@@ -213,6 +215,9 @@ Bool MemoryStream_createFromBuffer(
 	stream->data = *buffer;
 	*buffer = Buffer_createNull();
 
+	if (stream->parent.streamType & EStreamType_Mapped)
+		stream->parent.mapped = stream->data.ptr;
+
 clean:
 	return s_uccess;
 }
@@ -304,6 +309,8 @@ Bool MemoryStream_move(MemoryStreamRef **streamRef, Buffer *output, Error *e_rr)
 
 	*output = stream->data;
 	stream->data = Buffer_createNull();
+	stream->parent.mapped = NULL;
+	stream->parent.streamType &= ~(U64)EStreamType_Mapped;
 	
 	RefPtr_dec(streamRef);
 
@@ -26,12 +26,71 @@
 #include "types/container/buffer.h"
 #include "types/container/string.h"
 #include "types/container/log.h"
+#include "types/container/job_queue.h"
 
 #include <stdio.h>
 
 static const U32 sizes[] = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 32768, 65536 };
 static const U8  cryptoState[] = { 0, 1, 3 };   // Test non 256-bit, 512-bit, etc.
 static const I64 blockSizeHints[] = { -1, -2, -4, -8, -16, 0 };
+static const U64 threadCounts[] = { 1, 2, 4, 8, 16 };       //Parallel GCM (BufferEncrypt::queue) over the full buffer
+static const U32 softwareSizes[] = { 16, 1024, 65536 };     //Constant-time fallback (Buffer_aesForceSoftware)
+
+Bool Perf_writeCsv(CharString path, CharString csv, Error *e_rr) {
+
+	Bool s_uccess = true;
+	FILE *f = NULL;
+
+	if(!path.ptr)
+		retError(clean, Error_nullPointer(0, "Perf_writeCsv()::path is required"));
+
+	f = fopen(path.ptr, "wb");
+
+	if (!f)
+		retError(clean, Error_invalidState(0, "Perf_writeCsv() fopen failed"));
+
+	if(fwrite(csv.ptr, 1, CharString_length(csv), f) != CharString_length(csv))
+		retError(clean, Error_invalidState(1, "Perf_writeCsv() fwrite failed"));
+
+clean:
+	if(f) fclose(f);
+	return s_uccess;
+}
+
+Bool Perf_readFile(CharString path, const Allocator *alloc, Buffer *result, Error *e_rr) {
+
+	Bool s_uccess = true;
+	FILE *f = NULL;
+
+	if(!path.ptr || !result)
+		retError(clean, Error_nullPointer(!path.ptr ? 0 : 2, "Perf_readFile()::path and result are required"));
+
+	f = fopen(path.ptr, "rb");
+
+	if (!f)
+		retError(clean, Error_notFound(0, 0, "Perf_readFile() fopen failed"));
+
+	fseek(f, 0, SEEK_END);
+	const long size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	if(size < 0)
+		retError(clean, Error_invalidState(0, "Perf_readFile() ftell failed"));
+
+	if (!size) {                //Empty file, it's up to the caller whether that's an error
+		*result = Buffer_createNull();
+		goto clean;
+	}
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes((U64) size, alloc, result, e_rr));
+
+	if(fread(result->ptrNonConst, 1, (U64) size, f) != (U64) size)
+		retError(clean, Error_invalidState(1, "Perf_readFile() fread failed"));
+
+clean:
+	if(f) fclose(f);
+	return s_uccess;
+}
 
 Bool Perf_aesThroughput(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
 
@@ -42,14 +101,15 @@ Bool Perf_aesThroughput(const Allocator *alloc, const CharString *outputCsv, Boo
 	Buffer     full   = Buffer_createNull();
 	CharString csv    = CharString_createNull();
 	CharString tmpStr = CharString_createNull();
+	JobQueue   queue  = (JobQueue) { 0 };
 
 	gotoIfError3(clean, Buffer_createUninitializedBytes(1 * GIBI, alloc, &full, e_rr));
 	Buffer_csprng(full);
 
 	gotoIfError3(clean, CharString_format(
 		alloc, &csv, e_rr,
-		"%s,%s,%s,%s,%s,%s,%s\n",
-		"Type", "Crypto state", "Batch size", "Total size", "Count", "Seconds", "GiB/s"
+		"%s,%s,%s,%s,%s,%s,%s,%s\n",
+		"Type", "Threads", "Crypto state", "Batch size", "Total size", "Count", "Seconds", "GiB/s"
 	));
 
 	for (U64 m = 0; m < 2; ++m)
@@ -147,7 +207,7 @@ Bool Perf_aesThroughput(const Allocator *alloc, const CharString *outputCsv, Boo
 
 						gotoIfError3(clean, CharString_format(
 							alloc, &tmpStr, e_rr,
-							"%s%s,%"PRIx8",%"PRIu8",%"PRIu64",%"PRIu64",%f,%f\n",
+							"%s%s,1,%"PRIx8",%"PRIu8",%"PRIu64",%"PRIu64",%f,%f\n",
 							csv.ptr ? csv.ptr : "",
 							!m ? "Streaming" : "Instant",
 							cryptoState[l],
@@ -165,18 +225,143 @@ Bool Perf_aesThroughput(const Allocator *alloc, const CharString *outputCsv, Boo
 			}
 		}
 
-	if (outputCsv) {
+	//Software fallback, streaming only since it doesn't have any batch sizes or wide paths to pick from
+
+	Buffer_aesForceSoftware(true);
+
+	for (U64 i = 0; i < sizeof(softwareSizes) / sizeof(softwareSizes[0]); ++i) {
+
+		const U64 siz   = softwareSizes[i];
+		const U64 elems = Buffer_length(full) / siz;
+
+		AESEncryptionContext ctx = { 0 };
+		U8 blockSizeMax = 0, use256Or512 = 0;
+
+		gotoIfError3(clean, Buffer_aesExpertCreate(
+			I32x4_zero(), EBufferEncryptionType_AES256GCM,
+			key, 0, 0, U8_MAX,
+			&blockSizeMax, &use256Or512, &ctx, e_rr
+		));
+
+		U64 count = 0;
+		const Ns curr = Time_now();
+
+		do {
+
+			for (U64 j = 0; j < 256; ++j) {
+				Buffer dat = Buffer_createRef(full.ptrNonConst + ((count + j) % elems) * siz, siz);
+				Buffer_aesExpertEncUpdate(&ctx, dat, 0, blockSizeMax, use256Or512);
+			}
+
+			count += 256;
+		}
+		while (Time_elapsed(curr) < (DNs)(SECOND * 3));
+
+		Buffer_aesExpertFinalize(&ctx, 0, count * siz, I32x4_zero());
+
+		const DNs diff = Time_elapsed(curr);
+
+		if (logToConsole)
+			Log_debugLn(
+				alloc,
+				"AES-256-GCM software for 3s on %"PRIu64" byte blocks: %"PRIu64" ops in %fs (%f GiB/s)",
+				siz, count,
+				(F64)diff / SECOND,
+				count * siz / ((F64)diff / SECOND) / GIBI
+			);
+
+		gotoIfError3(clean, CharString_format(
+			alloc, &tmpStr, e_rr,
+			"%s%s,1,0,%"PRIu8",%"PRIu64",%"PRIu64",%f,%f\n",
+			csv.ptr ? csv.ptr : "",
+			"Software",
+			blockSizeMax,
+			siz, count,
+			(F64)diff / SECOND,
+			count * siz / ((F64)diff / SECOND) / GIBI
+		));
+
+		CharString_free(&csv, alloc);
+		csv    = tmpStr;
+		tmpStr = CharString_createNull();
+	}
+
+	Buffer_aesForceSoftware(false);
+
+	//Thread scaling of one big encrypt (the fastest crypto state), every run encrypts the full buffer
+
+	for (U64 i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); ++i) {
 
-		FILE *f = fopen(outputCsv->ptr, "wb");
+		const U64 threads = threadCounts[i];
+		gotoIfError3(clean, JobQueue_create(threads, alloc, &queue, e_rr));
 
-		if (!f)
-			retError(clean, Error_invalidState(0, "Perf_aesThroughput(): fopen failed"));
+		AESEncryptionContext ctx = { 0 };
+		U8 blockSizeMax = 0, use256Or512 = 0;
 
-		fwrite(csv.ptr, 1, CharString_length(csv), f);
-		fclose(f);
+		gotoIfError3(clean, Buffer_aesExpertCreate(
+			I32x4_zero(), EBufferEncryptionType_AES256GCM,
+			key, 0, Buffer_length(full), U8_MAX,
+			&blockSizeMax, &use256Or512, &ctx, e_rr
+		));
+
+		U32 encKey[8] = { 0 };
+		I32x4 iv = I32x4_zero(), tag = I32x4_zero();
+
+		const BufferEncrypt encrypt = (BufferEncrypt) {
+			.target = &full,
+			.type = EBufferEncryptionType_AES256GCM,
+			.flags = EBufferEncryptionFlags_StopCreateIv,
+			.queue = &queue,
+			.nonConstEncrypt = { .key = encKey, .tag = &tag, .iv = &iv }
+		};
+
+		U64 count = 0;
+		const Ns curr = Time_now();
+
+		do {
+			gotoIfError3(clean, Buffer_encryptAdvanced(&encrypt, e_rr));
+			++count;
+		}
+		while (Time_elapsed(curr) < (DNs)(SECOND * 3));
+
+		const DNs diff = Time_elapsed(curr);
+		const U64 siz = Buffer_length(full);
+
+		if (logToConsole)
+			Log_debugLn(
+				alloc,
+				"AES-256-GCM parallel with %"PRIu64" threads on %"PRIu64" bytes: %"PRIu64" ops in %fs (%f GiB/s)",
+				threads, siz, count,
+				(F64)diff / SECOND,
+				count * siz / ((F64)diff / SECOND) / GIBI
+			);
+
+		gotoIfError3(clean, CharString_format(
+			alloc, &tmpStr, e_rr,
+			"%s%s,%"PRIu64",%"PRIx8",%"PRIu8",%"PRIu64",%"PRIu64",%f,%f\n",
+			csv.ptr ? csv.ptr : "",
+			"Parallel",
+			threads,
+			use256Or512,
+			blockSizeMax,
+			siz, count,
+			(F64)diff / SECOND,
+			count * siz / ((F64)diff / SECOND) / GIBI
+		));
+
+		CharString_free(&csv, alloc);
+		csv    = tmpStr;
+		tmpStr = CharString_createNull();
+
+		JobQueue_free(&queue);
 	}
 
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
 clean:
+	Buffer_aesForceSoftware(false);
+	JobQueue_free(&queue);
 	CharString_free(&csv,    alloc);
 	CharString_free(&tmpStr, alloc);
 	Buffer_free(&full, alloc);
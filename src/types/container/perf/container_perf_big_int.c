@@ -0,0 +1,376 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_big_int.c
+
+#include "types/base/time.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/big_int.h"
+#include "types/container/string.h"
+#include "types/base/string_mut.h"
+#include "types/base/string_read_helper.h"
+#include "types/container/buffer.h"
+#include "types/container/log.h"
+
+#define PerfBigInt_seconds 1
+
+static const U16 bigIntBits[] = { 256, 512, 1024, 2048, 4096, 8192 };
+
+typedef enum EPerfBigInt {
+	EPerfBigInt_Mul,
+	EPerfBigInt_MulReference,           //The U32 diagonal multiply BigInt_mul used before Karatsuba
+	EPerfBigInt_DivMod,
+	EPerfBigInt_PowMod,                 //Montgomery
+	EPerfBigInt_PowModReference,        //Square and multiply through BigInt_mul and BigInt_mod
+	EPerfBigInt_ToDec,
+	EPerfBigInt_ToDecReference,         //Divide by 10^18 until nothing is left
+	EPerfBigInt_FromDec,
+	EPerfBigInt_FromDecReference,       //Every digit multiplied by a running power of 10, as createFromDec used to
+	EPerfBigInt_Count
+} EPerfBigInt;
+
+static const C8 *bigIntNames[] = {
+	"mul", "mulReference", "divMod", "powMod", "powModReference",
+	"toDec", "toDecReference", "fromDec", "fromDecReference"
+};
+
+//a *= b with a temp the size of a, digit by digit (U32) along the diagonals of the product
+static void PerfBigInt_mulReference(BigInt *a, BigInt b, BigInt temp) {
+
+	const U32 digitsA = (U32)a->length * 2;
+	const U32 digitsB = (U32)b.length * 2;
+
+	U32 *dst = (U32*) temp.dataNonConst;
+	const U32 *aptr = (const U32*) a->data;
+	const U32 *bptr = (const U32*) b.data;
+
+	for(U32 i = 0; i < digitsA; ++i)
+		dst[i] = 0;
+
+	for (U32 i = 0; i < digitsA; ++i) {
+
+		U64 mul = dst[i];
+
+		const U32 startX = (U32) U64_min(i, digitsA - 1);
+		const U32 startRayT = i - startX;
+		const U32 endRayT = (U32) U64_min(i, digitsB - 1) - startRayT;
+
+		for (U32 t = startRayT; t <= endRayT; ++t) {
+
+			const U64 prevMul = mul;
+			mul += (U64) aptr[i - t] * bptr[t];
+
+			if(mul < prevMul && i + 2 < digitsA) {
+				U64 j = i + 2, v = 0;
+				do { v = ++dst[j++]; } while(!v && j < digitsA);
+			}
+		}
+
+		dst[i] = (U32) mul;
+
+		if(i + 1 < digitsA) {
+
+			const U64 prev = dst[i + 1];
+			dst[i + 1] += (U32) (mul >> 32);
+
+			if (dst[i + 1] < prev && i + 2 < digitsA) {
+				U64 j = i + 2, v = 0;
+				do { v = ++dst[j++]; } while(!v && j < digitsA);
+			}
+		}
+	}
+
+	BigInt_set(a, temp, false, NULL, NULL);
+}
+
+static void PerfBigInt_fill(BigInt b, U16 bits, U64 *rng) {
+
+	for (U64 i = 0; i < b.length; ++i) {
+
+		*rng ^= *rng << 13;
+		*rng ^= *rng >> 7;
+		*rng ^= *rng << 17;
+
+		b.dataNonConst[i] = i * 64 < bits ? *rng : 0;
+	}
+}
+
+//Operations per second of BigInt arithmetic and decimal conversion at 256 to 8192 bits.
+//The reference rows are the quadratic algorithms (or plain square and multiply) the new paths replace.
+
+Bool Perf_bigInt(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	BigInt a = { 0 }, b = { 0 }, m = { 0 }, r = { 0 }, wide = { 0 }, temp = { 0 }, chunk = { 0 }, parsed = { 0 };
+	BigInt expected = { 0 };
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+	CharString dec    = CharString_createNull();
+	CharString text   = CharString_createNull();
+
+	U64 rng = 0x2545F4914F6CDD1D;
+	const U64 chunkValue = 1000000000000000000;
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s\n",
+		"Operation", "Bits", "Ops", "Seconds", "Ops/s"
+	));
+
+	for (U64 s = 0; s < sizeof(bigIntBits) / sizeof(bigIntBits[0]); ++s) {
+
+		const U16 bits = bigIntBits[s];
+		const U16 wideBits = (U16) U64_min(bits * 2, 0xFF * 64);         //Products of 8192 bits get truncated
+
+		gotoIfError3(clean, BigInt_create(wideBits, alloc, &a, e_rr));
+		gotoIfError3(clean, BigInt_create(wideBits, alloc, &wide, e_rr));
+		gotoIfError3(clean, BigInt_create(wideBits, alloc, &temp, e_rr));
+		gotoIfError3(clean, BigInt_create(wideBits, alloc, &expected, e_rr));
+		gotoIfError3(clean, BigInt_create(bits, alloc, &b, e_rr));
+		gotoIfError3(clean, BigInt_create(bits, alloc, &m, e_rr));
+		gotoIfError3(clean, BigInt_create(bits, alloc, &r, e_rr));
+		gotoIfError3(clean, BigInt_create(64, alloc, &chunk, e_rr));
+
+		PerfBigInt_fill(a, bits, &rng);
+		PerfBigInt_fill(b, bits, &rng);
+		PerfBigInt_fill(m, bits, &rng);
+		//Odd for Montgomery and below 2^(bits - 32), so the reference's products still fit in 16320 bits (b < m)
+
+		m.dataNonConst[0] |= 1;
+		m.dataNonConst[m.length - 1] >>= 32;
+
+		gotoIfError3(clean, BigInt_mod(&b, m, alloc, e_rr));
+		chunk.dataNonConst[0] = chunkValue;
+
+		const BigIntStringify stringify = (BigIntStringify) { .alloc = alloc, .result = &text };
+		gotoIfError3(clean, BigInt_dec(&stringify, b, e_rr));
+
+		for (U64 op = 0; op < EPerfBigInt_Count; ++op) {
+
+			const Ns start = Time_now();
+			U64 count = 0;
+
+			do {
+
+				switch (op) {
+
+					case EPerfBigInt_Mul:
+					case EPerfBigInt_MulReference:
+
+						gotoIfError3(clean, BigInt_set(&wide, a, false, NULL, e_rr));
+
+						if (op == EPerfBigInt_Mul) {
+							gotoIfError3(clean, BigInt_mul(&wide, b, alloc, e_rr));
+						}
+
+						else PerfBigInt_mulReference(&wide, b, temp);
+
+						break;
+
+					case EPerfBigInt_DivMod:
+						gotoIfError3(clean, BigInt_set(&wide, a, false, NULL, e_rr));
+						gotoIfError3(clean, BigInt_mul(&wide, b, alloc, e_rr));
+						gotoIfError3(clean, BigInt_divMod(&wide, m, &r, alloc, e_rr));
+						break;
+
+					case EPerfBigInt_PowMod:
+						gotoIfError3(clean, BigInt_set(&r, b, false, NULL, e_rr));
+						gotoIfError3(clean, BigInt_powMod(&r, a, m, alloc, e_rr));
+						break;
+
+					case EPerfBigInt_PowModReference:
+
+						//r = b^a % m, from the top exponent bit down
+
+						gotoIfError3(clean, BigInt_set(&r, BigInt_createNull(), false, NULL, e_rr));
+						r.dataNonConst[0] = 1;
+
+						for (U64 i = bits - 1; i != U64_MAX; --i) {
+
+							gotoIfError3(clean, BigInt_set(&wide, r, false, NULL, e_rr));
+							gotoIfError3(clean, BigInt_mul(&wide, r, alloc, e_rr));
+							gotoIfError3(clean, BigInt_mod(&wide, m, alloc, e_rr));
+
+							if ((a.data[i >> 6] >> (i & 63)) & 1) {
+								gotoIfError3(clean, BigInt_mul(&wide, b, alloc, e_rr));
+								gotoIfError3(clean, BigInt_mod(&wide, m, alloc, e_rr));
+							}
+
+							gotoIfError3(clean, BigInt_set(&r, wide, false, NULL, e_rr));
+						}
+
+						break;
+
+					case EPerfBigInt_ToDec: {
+						const BigIntStringify spec = (BigIntStringify) { .alloc = alloc, .result = &dec };
+						gotoIfError3(clean, BigInt_dec(&spec, b, e_rr));
+						break;
+					}
+
+					case EPerfBigInt_ToDecReference: {
+
+						gotoIfError3(clean, BigInt_set(&wide, b, false, NULL, e_rr));
+						gotoIfError3(clean, CharString_resize(&dec, CharString_length(text) + 18, '0', alloc, e_rr));
+
+						U64 k = CharString_length(dec);
+
+						while (BigInt_bitScan(wide) != U16_MAX) {
+
+							gotoIfError3(clean, BigInt_divMod(&wide, chunk, &r, alloc, e_rr));
+							U64 v = r.data[0];
+
+							for (U8 j = 0; j < 18; ++j, v /= 10)
+								dec.ptrNonConst[--k] = (C8)('0' + v % 10);
+						}
+
+						while(k + 1 < CharString_length(dec) && dec.ptr[k] == '0')
+							++k;
+
+						gotoIfError3(clean, CharString_eraseAtCount(&dec, 0, k, e_rr));
+						break;
+					}
+
+					case EPerfBigInt_FromDec: {
+						const BigIntCreate create = (BigIntCreate) {
+							.text = &text, .bitCount = bits, .alloc = alloc, .big = &parsed
+						};
+						gotoIfError3(clean, BigInt_createFromDec(&create, e_rr));
+						break;
+					}
+
+					default: {
+
+						gotoIfError3(clean, BigInt_create(bits, alloc, &parsed, e_rr));
+						gotoIfError3(clean, BigInt_set(&wide, BigInt_createNull(), false, NULL, e_rr));
+						wide.dataNonConst[0] = 1;
+
+						for (U64 i = CharString_length(text) - 1; i != U64_MAX; --i) {
+
+							gotoIfError3(clean, BigInt_set(&r, wide, false, NULL, e_rr));
+							gotoIfError3(clean, BigInt_set(&temp, BigInt_createNull(), false, NULL, e_rr));
+							temp.dataNonConst[0] = C8_dec(text.ptr[i]);
+
+							PerfBigInt_mulReference(&temp, r, wide);
+							BigInt_add(&parsed, temp);
+
+							//wide *= 10, temp is overwritten again by the next digit
+
+							gotoIfError3(clean, BigInt_set(&temp, BigInt_createNull(), false, NULL, e_rr));
+							temp.dataNonConst[0] = 10;
+							PerfBigInt_mulReference(&r, temp, wide);
+							gotoIfError3(clean, BigInt_set(&wide, r, false, NULL, e_rr));
+						}
+
+						break;
+					}
+				}
+
+				//The first result of every reference has to match the new path
+
+				if (!count) {
+
+					Bool match = true;
+
+					switch (op) {
+
+						case EPerfBigInt_Mul:
+						case EPerfBigInt_PowMod: {
+							const BigInt result = op == EPerfBigInt_Mul ? wide : r;
+							gotoIfError3(clean, BigInt_set(&expected, result, false, NULL, e_rr));
+							break;
+						}
+
+						case EPerfBigInt_MulReference:       match = BigInt_eq(wide, expected);    break;
+						case EPerfBigInt_PowModReference:    match = BigInt_eq(r, expected);       break;
+
+						case EPerfBigInt_ToDec:
+						case EPerfBigInt_ToDecReference:
+							match = CharString_equalsStringSensitive(&dec, &text);
+							break;
+
+						case EPerfBigInt_FromDec:
+						case EPerfBigInt_FromDecReference:
+							match = BigInt_eq(parsed, b);
+							break;
+					}
+
+					if(!match)
+						retError(clean, Error_invalidState(0, "Perf_bigInt() result doesn't match the reference"));
+				}
+
+				BigInt_free(&parsed, alloc);
+				CharString_free(&dec, alloc);
+				++count;
+			}
+			while (Time_elapsed(start) < (DNs)(SECOND * PerfBigInt_seconds));
+
+			const DNs diff = Time_elapsed(start);
+			const F64 seconds = (F64)diff / SECOND;
+
+			if (logToConsole)
+				Log_debugLn(
+					alloc, "BigInt %s on %u bits: %"PRIu64" ops in %fs (%f ops/s)",
+					bigIntNames[op], (U32) bits, count, seconds, count / seconds
+				);
+
+			gotoIfError3(clean, CharString_format(
+				alloc, &tmpStr, e_rr,
+				"%s%s,%u,%"PRIu64",%f,%f\n",
+				csv.ptr ? csv.ptr : "",
+				bigIntNames[op], (U32) bits, count, seconds, count / seconds
+			));
+
+			CharString_free(&csv, alloc);
+			csv    = tmpStr;
+			tmpStr = CharString_createNull();
+		}
+
+		BigInt_free(&a, alloc);
+		BigInt_free(&b, alloc);
+		BigInt_free(&m, alloc);
+		BigInt_free(&r, alloc);
+		BigInt_free(&wide, alloc);
+		BigInt_free(&temp, alloc);
+		BigInt_free(&chunk, alloc);
+		BigInt_free(&expected, alloc);
+		CharString_free(&text, alloc);
+	}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	BigInt_free(&a, alloc);
+	BigInt_free(&b, alloc);
+	BigInt_free(&m, alloc);
+	BigInt_free(&r, alloc);
+	BigInt_free(&wide, alloc);
+	BigInt_free(&temp, alloc);
+	BigInt_free(&chunk, alloc);
+	BigInt_free(&parsed, alloc);
+	BigInt_free(&expected, alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	CharString_free(&dec,    alloc);
+	CharString_free(&text,   alloc);
+	return s_uccess;
+}
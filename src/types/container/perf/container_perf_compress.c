@@ -0,0 +1,204 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_compress.c
+
+#include "types/base/time.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/buffer_compress.h"
+#include "types/container/compression_stream.h"
+#include "types/container/memory_stream.h"
+#include "types/container/job_queue.h"
+#include "types/container/string.h"
+#include "types/container/buffer.h"
+#include "types/container/log.h"
+#include "types/base/mathi.h"
+
+#define PerfCompress_bytes (64 << 20)
+#define PerfCompress_read (MIBI)              //What the stream reader asks for at once
+
+static const U64 PerfCompress_threadCounts[] = { 0, 1, 2, 4, 8 };        //0 = no queue, decompressed on the reader
+
+//Text repeats a sentence with some drift (compresses well), Binary is runs of bytes and ramps, Random is stored
+
+static void PerfCompress_fill(U8 *ptr, U64 length, U64 type) {
+
+	static const C8 words[] = "the quick brown fox jumps over the lazy dog, vertex 0.5 1.0 -2.25 normal 0 1 0\n";
+	U64 seed = 0x9E3779B97F4A7C15;
+
+	for (U64 i = 0; i < length; ++i) {
+
+		seed = seed * 6364136223846793005 + 1442695040888963407;
+
+		if(!type)
+			ptr[i] = (seed >> 61) ? (U8) words[(i + i / 4093) % (sizeof(words) - 1)] : (U8)(seed >> 56);
+
+		else if(type == 1)
+			ptr[i] = (U8)((i >> 6) & 1 ? (i >> 9) : i * 3);
+
+		else ptr[i] = (U8)(seed >> 56);
+	}
+}
+
+//MB/s (of uncompressed data) of Buffer_compress, Buffer_decompress and a reader of a CompressionStream.
+//The stream reader asks for 1MiB at a time and optionally decompresses on a JobQueue.
+
+Bool Perf_compress(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	Buffer data = Buffer_createNull();
+	Buffer check = Buffer_createNull();
+	Buffer compressed = Buffer_createNull();
+	RefPtr *backing = NULL, *comp = NULL;
+	JobQueue queue = (JobQueue) { 0 };
+	Bool hasQueue = false;
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	static const C8 *dataNames[] = { "Text", "Binary", "Random" };
+	static const C8 *opNames[] = { "Compress", "Decompress", "Stream" };
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s,%s\n",
+		"Data", "Operation", "Threads", "Ratio", "Seconds", "MB/s"
+	));
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(PerfCompress_bytes, alloc, &data, e_rr));
+	gotoIfError3(clean, Buffer_createUninitializedBytes(PerfCompress_bytes, alloc, &check, e_rr));
+
+	const RefPtrType memType = MemoryStream_makeType(alloc);
+
+	for (U64 d = 0; d < sizeof(dataNames) / sizeof(dataNames[0]); ++d) {
+
+		PerfCompress_fill(data.ptrNonConst, PerfCompress_bytes, d);
+
+		for (U64 op = 0; op < sizeof(opNames) / sizeof(opNames[0]); ++op) {
+
+			const U64 runs = op == 2 ? sizeof(PerfCompress_threadCounts) / sizeof(PerfCompress_threadCounts[0]) : 1;
+
+			for (U64 i = 0; i < runs; ++i) {
+
+				const U64 threads = op == 2 ? PerfCompress_threadCounts[i] : 0;
+
+				if (threads) {
+					gotoIfError3(clean, JobQueue_create(threads, alloc, &queue, e_rr));
+					hasQueue = true;
+					gotoIfError3(clean, CompressionStream_setJobQueue(comp, &queue, e_rr));
+				}
+
+				if(op)
+					gotoIfError3(clean, Buffer_unsetAllBits(check, e_rr));
+
+				const Ns start = Time_now();
+
+				if (!op) {
+					Buffer_free(&compressed, alloc);
+					gotoIfError3(clean, Buffer_compress(data, alloc, &compressed, e_rr));
+				}
+
+				else if (op == 1) {
+					gotoIfError3(clean, Buffer_decompress(compressed, check, e_rr));
+				}
+
+				else {
+
+					OxStream *stream = RefPtr_data(comp, OxStream);
+
+					for (U64 it = 0; it < PerfCompress_bytes; it += PerfCompress_read)
+						gotoIfError3(clean, stream->read(
+							stream, it, PerfCompress_read,
+							Buffer_createRef(check.ptrNonConst + it, PerfCompress_read), alloc, e_rr
+						));
+				}
+
+				const DNs diff = Time_elapsed(start);
+				const F64 seconds = (F64)diff / SECOND;
+				const F64 ratio = (F64)PerfCompress_bytes / Buffer_length(compressed);
+
+				if (hasQueue) {
+					gotoIfError3(clean, CompressionStream_setJobQueue(comp, NULL, e_rr));
+					JobQueue_free(&queue);
+					hasQueue = false;
+				}
+
+				if (op && !Buffer_eq(check, data))
+					retError(clean, Error_invalidState(0, "Perf_compress() decompressed different data"));
+
+				//The stream reads the data that was just compressed
+
+				if (op == 1) {
+					Buffer compressedRef = Buffer_createRefConst(compressed.ptr, Buffer_length(compressed));
+
+					gotoIfError3(clean, MemoryStream_createFromBuffer(
+						&compressedRef, EMemoryStreamFlags_None, &memType, &backing, e_rr
+					));
+
+					gotoIfError3(clean, CompressionStream_create(
+						backing, 0, Buffer_length(compressed), PerfCompress_bytes, alloc, &comp, e_rr
+					));
+				}
+
+				if (logToConsole)
+					Log_debugLn(
+						alloc,
+						"%s %s with %"PRIu64" threads (ratio %f): %fs (%f MB/s)",
+						opNames[op], dataNames[d], threads, ratio, seconds, PerfCompress_bytes / seconds / 1e6
+					);
+
+				gotoIfError3(clean, CharString_format(
+					alloc, &tmpStr, e_rr,
+					"%s%s,%s,%"PRIu64",%f,%f,%f\n",
+					csv.ptr ? csv.ptr : "",
+					dataNames[d], opNames[op], threads,
+					ratio,
+					seconds,
+					PerfCompress_bytes / seconds / 1e6
+				));
+
+				CharString_free(&csv, alloc);
+				csv    = tmpStr;
+				tmpStr = CharString_createNull();
+			}
+		}
+
+		RefPtr_dec(&comp);
+		RefPtr_dec(&backing);
+	}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	RefPtr_dec(&comp);
+	RefPtr_dec(&backing);
+
+	if (hasQueue)
+		JobQueue_free(&queue);
+
+	Buffer_free(&data, alloc);
+	Buffer_free(&check, alloc);
+	Buffer_free(&compressed, alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
@@ -0,0 +1,176 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_encryption_stream.c
+
+#include "types/base/time.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/encryption_stream.h"
+#include "types/container/memory_stream.h"
+#include "types/container/job_queue.h"
+#include "types/container/string.h"
+#include "types/container/buffer.h"
+#include "types/container/log.h"
+#include "types/base/mathi.h"
+
+#define PerfEncStream_bytes (64 << 20)
+#define PerfEncStream_chunk (64 * KIBI)        //Encryption chunk, the default of oiCA/oiDL
+#define PerfEncStream_read (MIBI)              //What the reader asks for at once
+
+static const U64 threadCounts[] = { 0, 1, 2, 4, 8, 16 };        //0 = no queue, decrypted on the reader
+
+static const U32 PerfEncStream_key[8] = {
+	0xCD00324F, 0x4CBAAE34, 0x67924E05, 0x78012F15,
+	0x5A8F573A, 0xA066652D, 0xDDB8C2E1, 0xF76AF7FE
+};
+
+//MB/s of a sequential reader of a big encrypted stream (like an encrypted oiCA entry), decrypted on a JobQueue.
+//Read asks the stream for 1MiB at a time, ReadAhead reads it through a 1MiB StreamCursor with read-ahead,
+// so one cache is decrypted on the worker (serially) while the reader decrypts the next one on the queue.
+
+Bool Perf_encryptionStream(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	Buffer plain = Buffer_createNull();
+	Buffer check = Buffer_createNull();
+	RefPtr *backing = NULL, *enc = NULL;
+	StreamCursor cursor = (StreamCursor) { 0 };
+	JobQueue queue = (JobQueue) { 0 };
+	Bool hasQueue = false;
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	static const C8 *modeNames[] = { "Read", "ReadAhead" };
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s\n",
+		"Mode", "Threads", "Seconds", "MB/s"
+	));
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(PerfEncStream_bytes, alloc, &plain, e_rr));
+	gotoIfError3(clean, Buffer_createUninitializedBytes(PerfEncStream_bytes, alloc, &check, e_rr));
+
+	for (U64 i = 0; i < PerfEncStream_bytes; ++i)
+		plain.ptrNonConst[i] = (U8)(i * 131 + (i >> 10));
+
+	const RefPtrType memType = MemoryStream_makeType(alloc);
+	const RefPtrType encType = EncryptionStream_makeType(alloc);
+	const I32x4 rootIV = I32x4_create4(0x11223344, 0x55667788, 0x99AABBCC, 0);
+
+	gotoIfError3(clean, MemoryStream_create(
+		EncryptionStream_underlyingSize(PerfEncStream_chunk, PerfEncStream_bytes),
+		EMemoryStreamFlags_IsWritable, &memType, &backing, e_rr
+	));
+
+	gotoIfError3(clean, EncryptionStream_create(
+		backing, 0, PerfEncStream_key, rootIV, PerfEncStream_chunk, 0, &encType, &enc, e_rr
+	));
+
+	OxStream *stream = RefPtr_data(enc, OxStream);
+	gotoIfError3(clean, stream->write(stream, 0, PerfEncStream_bytes, plain, alloc, e_rr));
+
+	for (U64 m = 0; m < sizeof(modeNames) / sizeof(modeNames[0]); ++m)
+		for (U64 i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); ++i) {
+
+			const U64 threads = threadCounts[i];
+
+			if (threads) {
+				gotoIfError3(clean, JobQueue_create(threads, alloc, &queue, e_rr));
+				hasQueue = true;
+			}
+
+			gotoIfError3(clean, EncryptionStream_setJobQueue(enc, threads ? &queue : NULL, e_rr));
+			gotoIfError3(clean, Buffer_unsetAllBits(check, e_rr));
+
+			const Ns start = Time_now();
+
+			if (m) {
+
+				gotoIfError3(clean, StreamCursor_create(enc, PerfEncStream_read, false, alloc, &cursor, e_rr));
+				gotoIfError3(clean, StreamCursor_enableReadAhead(&cursor, 2, alloc, e_rr));
+
+				for (U64 it = 0; it < PerfEncStream_bytes; )
+					gotoIfError3(clean, StreamCursor_consume(
+						&cursor, &it, check.ptrNonConst + it, PerfEncStream_chunk, alloc, e_rr
+					));
+
+				StreamCursor_close(&cursor, alloc);
+			}
+
+			else for (U64 it = 0; it < PerfEncStream_bytes; it += PerfEncStream_read)
+				gotoIfError3(clean, stream->read(
+					stream, it, PerfEncStream_read,
+					Buffer_createRef(check.ptrNonConst + it, PerfEncStream_read), alloc, e_rr
+				));
+
+			const DNs diff = Time_elapsed(start);
+			const F64 seconds = (F64)diff / SECOND;
+
+			gotoIfError3(clean, EncryptionStream_setJobQueue(enc, NULL, e_rr));
+
+			if (hasQueue) {
+				JobQueue_free(&queue);
+				hasQueue = false;
+			}
+
+			if (!Buffer_eq(check, plain))
+				retError(clean, Error_invalidState(0, "Perf_encryptionStream() decrypted different data"));
+
+			if (logToConsole)
+				Log_debugLn(
+					alloc,
+					"EncryptionStream %s with %"PRIu64" threads: %fs (%f MB/s)",
+					modeNames[m], threads, seconds, PerfEncStream_bytes / seconds / 1e6
+				);
+
+			gotoIfError3(clean, CharString_format(
+				alloc, &tmpStr, e_rr,
+				"%s%s,%"PRIu64",%f,%f\n",
+				csv.ptr ? csv.ptr : "",
+				modeNames[m], threads,
+				seconds,
+				PerfEncStream_bytes / seconds / 1e6
+			));
+
+			CharString_free(&csv, alloc);
+			csv    = tmpStr;
+			tmpStr = CharString_createNull();
+		}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	StreamCursor_close(&cursor, alloc);
+	RefPtr_dec(&enc);
+	RefPtr_dec(&backing);
+
+	if (hasQueue)
+		JobQueue_free(&queue);
+
+	Buffer_free(&plain, alloc);
+	Buffer_free(&check, alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
@@ -0,0 +1,125 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_hash_map.c
+
+#include "types/base/time.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/hash_map.h"
+#include "types/container/list_basic_types.h"
+#include "types/container/string.h"
+#include "types/container/log.h"
+
+static const U32 elementCounts[] = { 8, 16, 32, 64, 128, 256, 1024, 4096, 16384, 65536 };
+
+//A linear scan over n keys costs about n/2 compares per hit and n per miss,
+//so the list side gets fewer lookups as n grows to keep every row in the same ballpark of runtime.
+
+static const U64 lookupsHashMap = 1 << 22;
+static const U64 compareBudgetList = (U64)1 << 26;
+
+static U64 Perf_hashMapKey(U64 i) { return i * 0x9E3779B97F4A7C15; }
+
+Bool Perf_hashMap(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	ListU64 list = (ListU64) { 0 };
+	HashMapU64U64 map = (HashMapU64U64) { 0 };
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s,%s\n",
+		"Type", "Elements", "Lookups", "Hits", "Seconds", "ns/lookup"
+	));
+
+	for (U64 i = 0; i < sizeof(elementCounts) / sizeof(elementCounts[0]); ++i) {
+
+		const U64 n = elementCounts[i];
+
+		gotoIfError3(clean, ListU64_clear(&list, e_rr));
+		HashMapU64U64_clear(&map);
+
+		if(!map.map.keyStride)
+			gotoIfError3(clean, HashMapU64U64_create(n, alloc, &map, e_rr));
+
+		for (U64 j = 0; j < n; ++j) {
+			gotoIfError3(clean, ListU64_pushBack(&list, Perf_hashMapKey(j), alloc, e_rr));
+			gotoIfError3(clean, HashMapU64U64_insert(&map, Perf_hashMapKey(j), j, alloc, e_rr));
+		}
+
+		//Keys are drawn from [0, 2n>, so about half of the lookups miss
+
+		for (U64 m = 0; m < 2; ++m) {
+
+			U64 lookups = m ? lookupsHashMap : compareBudgetList / n;
+			lookups = lookups < 1024 ? 1024 : lookups;
+
+			U64 found = 0;
+			const Ns start = Time_now();
+
+			for (U64 j = 0; j < lookups; ++j) {
+
+				const U64 key = Perf_hashMapKey((j * 7) % (n * 2));
+
+				if(m)
+					found += HashMapU64U64_contains(&map, key);
+
+				else found += ListU64_findFirst(list, key, 0, NULL) != U64_MAX;
+			}
+
+			const DNs diff = Time_elapsed(start);
+
+			if (logToConsole)
+				Log_debugLn(
+					alloc,
+					"%s with %"PRIu64" elements: %"PRIu64" lookups in %fs (%fns per lookup)",
+					m ? "HashMap" : "GenericList_find", n, lookups, (F64)diff / SECOND, (F64)diff / lookups
+				);
+
+			gotoIfError3(clean, CharString_format(
+				alloc, &tmpStr, e_rr,
+				"%s%s,%"PRIu64",%"PRIu64",%"PRIu64",%f,%f\n",
+				csv.ptr ? csv.ptr : "",
+				m ? "HashMap" : "GenericList_find",
+				n, lookups, found,
+				(F64)diff / SECOND,
+				(F64)diff / lookups
+			));
+
+			CharString_free(&csv, alloc);
+			csv    = tmpStr;
+			tmpStr = CharString_createNull();
+		}
+	}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	HashMapU64U64_free(&map, alloc);
+	ListU64_free(&list, alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
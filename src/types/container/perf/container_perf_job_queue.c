@@ -0,0 +1,154 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_job_queue.c
+
+#include "types/base/time.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/job_queue.h"
+#include "types/container/string.h"
+#include "types/container/log.h"
+
+static const U64 threadCounts[] = { 1, 2, 4, 8, 16 };
+
+#define PerfJobQueue_flatJobs (1 << 17)
+#define PerfJobQueue_treeWidth 16
+#define PerfJobQueue_treeDepth 5            //1 + 16 + 256 + 4096 + 65536 jobs
+#define PerfJobQueue_work 64                //Iterations of busy work per job, so it isn't only queue overhead
+
+typedef struct PerfJobQueueNode {
+	const struct PerfJobQueueNode *next;    //Level below, NULL for leaves
+	U64 *sinks;                             //One cache line per threadId, keeps the work from being optimized out
+} PerfJobQueueNode;
+
+static Bool PerfJobQueue_job(void *data, U64 threadId, JobQueue *queue) {
+
+	const PerfJobQueueNode *node = (const PerfJobQueueNode*) data;
+
+	U64 rng = threadId + 1;
+
+	for(U64 i = 0; i < PerfJobQueue_work; ++i)
+		rng = rng * 6364136223846793005 + 1442695040888963407;
+
+	node->sinks[threadId * 8] += rng;
+
+	for(U64 i = 0; node->next && i < PerfJobQueue_treeWidth; ++i)
+		if(!JobQueue_push(queue, PerfJobQueue_job, (void*) node->next, NULL))
+			return false;
+
+	return true;
+}
+
+//Jobs per second for the FIFO and work stealing modes at 1..16 threads.
+//"Flat" pushes every job from the owner, "Tree" pushes one job that fans out from inside the jobs,
+// which is the case work stealing is for (each context mostly pops what it pushed itself).
+
+Bool Perf_jobQueue(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	JobQueue queue = (JobQueue) { 0 };
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	U64 sinks[16 * 8] = { 0 };
+	PerfJobQueueNode levels[PerfJobQueue_treeDepth];
+
+	for(U64 i = 0; i < PerfJobQueue_treeDepth; ++i)
+		levels[i] = (PerfJobQueueNode) { .next = i + 1 < PerfJobQueue_treeDepth ? &levels[i + 1] : NULL, .sinks = sinks };
+
+	const PerfJobQueueNode leaf = (PerfJobQueueNode) { .sinks = sinks };
+
+	U64 treeJobs = 0;
+
+	for(U64 i = 0, levelJobs = 1; i < PerfJobQueue_treeDepth; ++i, levelJobs *= PerfJobQueue_treeWidth)
+		treeJobs += levelJobs;
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s,%s\n",
+		"Mode", "Workload", "Threads", "Jobs", "Seconds", "Mjobs/s"
+	));
+
+	for (U64 i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); ++i)
+		for (U64 m = 0; m < 2; ++m) {
+
+			const U64 threads = threadCounts[i];
+			const EJobQueueFlags flags = m ? EJobQueueFlags_WorkStealing : EJobQueueFlags_None;
+
+			gotoIfError3(clean, JobQueue_createFlags(threads, flags, alloc, &queue, e_rr));
+
+			for (U64 w = 0; w < 2; ++w) {
+
+				const Ns start = Time_now();
+
+				if (!w) {
+					for(U64 j = 0; j < PerfJobQueue_flatJobs; ++j)
+						gotoIfError3(clean, JobQueue_push(&queue, PerfJobQueue_job, (void*) &leaf, e_rr));
+				}
+
+				else gotoIfError3(clean, JobQueue_push(&queue, PerfJobQueue_job, &levels[0], e_rr));
+
+				gotoIfError3(clean, JobQueue_wait(&queue, e_rr));
+
+				const DNs diff = Time_elapsed(start);
+				const U64 jobs = w ? treeJobs : PerfJobQueue_flatJobs;
+
+				if(!JobQueue_isSuccess(&queue))
+					retError(clean, Error_outOfMemory(0, "Perf_jobQueue() job failed to push"));
+
+				const C8 *mode = m ? "WorkStealing" : "FIFO";
+				const C8 *workload = w ? "Tree" : "Flat";
+
+				if (logToConsole)
+					Log_debugLn(
+						alloc,
+						"%s %s with %"PRIu64" threads: %"PRIu64" jobs in %fs (%f Mjobs/s)",
+						mode, workload, threads, jobs,
+						(F64)diff / SECOND, jobs / ((F64)diff / SECOND) / 1e6
+					);
+
+				gotoIfError3(clean, CharString_format(
+					alloc, &tmpStr, e_rr,
+					"%s%s,%s,%"PRIu64",%"PRIu64",%f,%f\n",
+					csv.ptr ? csv.ptr : "",
+					mode, workload, threads, jobs,
+					(F64)diff / SECOND,
+					jobs / ((F64)diff / SECOND) / 1e6
+				));
+
+				CharString_free(&csv, alloc);
+				csv    = tmpStr;
+				tmpStr = CharString_createNull();
+			}
+
+			JobQueue_free(&queue);
+		}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	JobQueue_free(&queue);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
@@ -0,0 +1,197 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_lock.c
+
+#include "types/base/time.h"
+#include "types/base/lock.h"
+#include "types/base/thread.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/string.h"
+#include "types/container/log.h"
+
+#define PerfLock_ops (1 << 16)              //Per run, split over the threads
+#define PerfLock_maxThreads 8
+
+static const U64 PerfLock_threadCounts[] = { 1, 2, 4, 8 };
+
+typedef enum EPerfLock {
+	EPerfLock_SpinLock,
+	EPerfLock_Mutex,
+	EPerfLock_RWLock,
+	EPerfLock_Count
+} EPerfLock;
+
+static const C8 *PerfLock_names[] = { "SpinLock", "Mutex", "RWLock" };
+
+typedef enum EPerfLockWorkload {
+	EPerfLockWorkload_Short,                //Increment under the lock
+	EPerfLockWorkload_Long,                 //A few microseconds of work under the lock
+	EPerfLockWorkload_ReadMostly,           //Long, but only one in 16 ops writes (the others only need a read lock)
+	EPerfLockWorkload_Count
+} EPerfLockWorkload;
+
+static const C8 *PerfLock_workloads[] = { "Short", "Long", "ReadMostly" };
+static const U64 PerfLock_work[] = { 0, 512, 512 };
+
+typedef struct PerfLock {
+
+	SpinLock spinLock;
+	Mutex mutex;
+	RWLock rwLock;
+
+	EPerfLock type;
+	EPerfLockWorkload workload;
+	U64 opsPerThread;
+
+	U64 counter;                            //Guarded by the lock
+	alignas(64) AtomicI64 sink;
+
+} PerfLock;
+
+static void PerfLock_thread(void *data) {
+
+	PerfLock *perf = (PerfLock*) data;
+	const U64 work = PerfLock_work[perf->workload];
+	U64 rng = Thread_getId();
+
+	for (U64 i = 0; i < perf->opsPerThread; ++i) {
+
+		const Bool write = perf->workload != EPerfLockWorkload_ReadMostly || !(i & 15);
+
+		switch (perf->type) {
+			case EPerfLock_SpinLock: SpinLock_lock(&perf->spinLock, U64_MAX); break;
+			case EPerfLock_Mutex: Mutex_lock(&perf->mutex, U64_MAX); break;
+			default:
+
+				if(write)
+					RWLock_lockWrite(&perf->rwLock, U64_MAX);
+
+				else RWLock_lockRead(&perf->rwLock, U64_MAX);
+
+				break;
+		}
+
+		for(U64 j = 0; j < work; ++j)
+			rng = rng * 6364136223846793005 + perf->counter;
+
+		if(write)
+			++perf->counter;
+
+		switch (perf->type) {
+			case EPerfLock_SpinLock: SpinLock_unlock(&perf->spinLock); break;
+			case EPerfLock_Mutex: Mutex_unlock(&perf->mutex); break;
+			default:
+
+				if(write)
+					RWLock_unlockWrite(&perf->rwLock);
+
+				else RWLock_unlockRead(&perf->rwLock);
+
+				break;
+		}
+	}
+
+	AtomicI64_add(&perf->sink, (I64) rng);
+}
+
+//Lock + unlock pairs per second for every lock at 1..8 threads all hammering the same lock.
+//Long is where SpinLock's waiters keep yielding while Mutex's park, ReadMostly is what RWLock is for.
+
+Bool Perf_lock(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	PerfLock perf = (PerfLock) { 0 };
+	Thread *threads[PerfLock_maxThreads] = { 0 };
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s,%s\n",
+		"Lock", "Workload", "Threads", "Ops", "Seconds", "Mops/s"
+	));
+
+	for (EPerfLockWorkload w = 0; w < EPerfLockWorkload_Count; ++w)
+		for (U64 i = 0; i < sizeof(PerfLock_threadCounts) / sizeof(PerfLock_threadCounts[0]); ++i)
+			for (EPerfLock type = 0; type < EPerfLock_Count; ++type) {
+
+				const U64 threadCount = PerfLock_threadCounts[i];
+				const U64 ops = PerfLock_ops / threadCount * threadCount;
+
+				perf.type = type;
+				perf.workload = w;
+				perf.opsPerThread = ops / threadCount;
+				perf.counter = 0;
+
+				const Ns start = Time_now();
+
+				for(U64 j = 0; j < threadCount; ++j)
+					gotoIfError3(clean, Thread_create(alloc, PerfLock_thread, &perf, &threads[j], e_rr));
+
+				for(U64 j = 0; j < threadCount; ++j)
+					gotoIfError3(clean, Thread_waitAndCleanup(alloc, &threads[j], e_rr));
+
+				const DNs diff = Time_elapsed(start);
+				const U64 writes = w == EPerfLockWorkload_ReadMostly ? (perf.opsPerThread + 15) / 16 * threadCount : ops;
+
+				if(perf.counter != writes)
+					retError(clean, Error_invalidState(0, "Perf_lock() lost an increment, lock is broken"));
+
+				const C8 *name = PerfLock_names[type];
+				const C8 *workload = PerfLock_workloads[w];
+
+				if (logToConsole)
+					Log_debugLn(
+						alloc,
+						"%s %s with %"PRIu64" threads: %"PRIu64" ops in %fs (%f Mops/s)",
+						name, workload, threadCount, ops,
+						(F64)diff / SECOND, ops / ((F64)diff / SECOND) / 1e6
+					);
+
+				gotoIfError3(clean, CharString_format(
+					alloc, &tmpStr, e_rr,
+					"%s%s,%s,%"PRIu64",%"PRIu64",%f,%f\n",
+					csv.ptr ? csv.ptr : "",
+					name, workload, threadCount, ops,
+					(F64)diff / SECOND,
+					ops / ((F64)diff / SECOND) / 1e6
+				));
+
+				CharString_free(&csv, alloc);
+				csv    = tmpStr;
+				tmpStr = CharString_createNull();
+			}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+
+	for(U64 j = 0; j < PerfLock_maxThreads; ++j)
+		if(threads[j])
+			Thread_waitAndCleanup(alloc, &threads[j], NULL);
+
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
@@ -0,0 +1,417 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_micro.c
+
+#include "types/container/perf/container_perf.h"
+#include "types/container/list_basic_types.h"
+#include "types/container/job_queue.h"
+#include "types/container/memory_stream.h"
+#include "types/container/ref_ptr.h"
+#include "types/container/buffer.h"
+#include "types/container/string.h"
+#include "types/base/allocator.h"
+
+#include <inttypes.h>
+
+//Sizes are picked so every repetition takes roughly 0.1 - 10ms: long enough for the timer, short enough that
+// 15 repetitions of everything finish in a few seconds.
+
+#define PerfMicro_listLength (1 << 16)
+#define PerfMicro_listShift (1 << 11)          //insert/erase at the front move the whole list every time
+#define PerfMicro_textLength (1 << 16)
+#define PerfMicro_formats (1 << 10)
+#define PerfMicro_hashLength (1 << 20)
+#define PerfMicro_jobs (1 << 14)
+#define PerfMicro_jobThreads 4
+#define PerfMicro_streamLength (1 << 20)
+#define PerfMicro_streamChunk 64
+#define PerfMicro_refs (1 << 20)
+
+typedef struct PerfMicro {
+
+	ListU64 source;                 //Random U64s, copied into list before sorting
+	ListU64 list;
+
+	CharString text;                //"word,word,...", where every 4th word is "foo"
+	CharString scratch;
+
+	Buffer hashData;
+
+	JobQueue queue;
+
+	MemoryStreamRef *stream;
+	StreamCursor writer, reader;
+
+	U64 sink;                       //Keeps results alive
+
+} PerfMicro;
+
+//GenericList
+
+static Bool PerfMicro_listPushBack(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+	ListU64 l = (ListU64) { 0 };
+
+	for(U64 i = 0; i < PerfMicro_listLength; ++i)
+		gotoIfError3(clean, ListU64_pushBack(&l, i, alloc, e_rr));
+
+	m->sink += l.ptr[l.length - 1];
+
+clean:
+	ListU64_free(&l, alloc);
+	return s_uccess;
+}
+
+static Bool PerfMicro_listInsertFront(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+	ListU64 l = (ListU64) { 0 };
+
+	gotoIfError3(clean, ListU64_reserve(&l, PerfMicro_listShift, alloc, e_rr));
+
+	for(U64 i = 0; i < PerfMicro_listShift; ++i)
+		gotoIfError3(clean, ListU64_insert(&l, 0, i, alloc, e_rr));
+
+	m->sink += l.ptr[0];
+
+clean:
+	ListU64_free(&l, alloc);
+	return s_uccess;
+}
+
+static Bool PerfMicro_listEraseFront(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+
+	gotoIfError3(clean, ListU64_resize(&m->list, PerfMicro_listShift, alloc, e_rr));
+
+	while(m->list.length)
+		gotoIfError3(clean, ListU64_erase(&m->list, 0, e_rr));
+
+clean:
+	return s_uccess;
+}
+
+static Bool PerfMicro_listFill(PerfMicro *m, const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	gotoIfError3(clean, ListU64_resize(&m->list, m->source.length, alloc, e_rr));
+	Buffer_memcpy(ListU64_buffer(m->list), ListU64_bufferConst(m->source));
+
+clean:
+	return s_uccess;
+}
+
+static ECompareResult PerfMicro_compareU64(const void *a, const void *b, void *context) {
+	(void) context;
+	const U64 x = *(const U64*) a, y = *(const U64*) b;
+	return x < y ? ECompareResult_Lt : (x > y ? ECompareResult_Gt : ECompareResult_Eq);
+}
+
+static Bool PerfMicro_listSort(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+
+	gotoIfError3(clean, PerfMicro_listFill(m, alloc, e_rr));
+
+	if(!ListU64_sort(m->list))
+		retError(clean, Error_invalidState(0, "PerfMicro_listSort() failed"));
+
+clean:
+	return s_uccess;
+}
+
+static Bool PerfMicro_listSortCustom(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+
+	gotoIfError3(clean, PerfMicro_listFill(m, alloc, e_rr));
+
+	if(!ListU64_sortCustom(m->list, PerfMicro_compareU64, NULL))
+		retError(clean, Error_invalidState(0, "PerfMicro_listSortCustom() failed"));
+
+clean:
+	return s_uccess;
+}
+
+//CharString
+
+static Bool PerfMicro_stringSplit(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+	ListCharString parts = (ListCharString) { 0 };
+
+	const CharStringSplit split = (CharStringSplit) { .s = &m->text, .allocator = alloc, .result = &parts };
+	gotoIfError3(clean, CharString_split(&split, ',', EStringCase_Sensitive, e_rr));
+
+	m->sink += parts.length;
+
+clean:
+	ListCharString_freeUnderlying(&parts, alloc);
+	return s_uccess;
+}
+
+static Bool PerfMicro_stringReplace(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+
+	const CharString search = CharString_createRefCStrConst("foo");
+	const CharString replace = CharString_createRefCStrConst("foobar");
+
+	CharString_free(&m->scratch, alloc);
+	gotoIfError3(clean, CharString_createCopy(m->text, alloc, &m->scratch, e_rr));
+
+	const CharStringReplace2 replace2 = (CharStringReplace2) {
+		.s = &m->scratch, .search = &search, .replace = &replace, .allocator = alloc
+	};
+
+	gotoIfError3(clean, CharString_replaceAllString(&replace2, EStringCase_Sensitive, e_rr));
+	m->sink += CharString_length(m->scratch);
+
+clean:
+	return s_uccess;
+}
+
+static Bool PerfMicro_stringFormat(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+	CharString tmp = CharString_createNull();
+
+	for (U64 i = 0; i < PerfMicro_formats; ++i) {
+		gotoIfError3(clean, CharString_format(alloc, &tmp, e_rr, "%s %"PRIu64" %f", "entry", i, (F64) i * 0.5));
+		m->sink += CharString_length(tmp);
+		CharString_free(&tmp, alloc);
+	}
+
+clean:
+	CharString_free(&tmp, alloc);
+	return s_uccess;
+}
+
+//Hashes
+
+static Bool PerfMicro_crc32c(void *data, const Allocator *alloc, Error *e_rr) {
+	(void) alloc; (void) e_rr;
+	PerfMicro *m = (PerfMicro*) data;
+	m->sink += Buffer_crc32c(m->hashData);
+	return true;
+}
+
+static Bool PerfMicro_sha256(void *data, const Allocator *alloc, Error *e_rr) {
+	(void) alloc; (void) e_rr;
+	PerfMicro *m = (PerfMicro*) data;
+	U32 out[8] = { 0 };
+	Buffer_sha256(m->hashData, out);
+	m->sink += out[0];
+	return true;
+}
+
+static Bool PerfMicro_fnv1a64(void *data, const Allocator *alloc, Error *e_rr) {
+	(void) alloc; (void) e_rr;
+	PerfMicro *m = (PerfMicro*) data;
+	m->sink += Buffer_fnv1a64(m->hashData, Buffer_fnv1a64Offset);
+	return true;
+}
+
+static Bool PerfMicro_hash64(void *data, const Allocator *alloc, Error *e_rr) {
+	(void) alloc; (void) e_rr;
+	PerfMicro *m = (PerfMicro*) data;
+	m->sink += Buffer_hash64(m->hashData, 0);
+	return true;
+}
+
+//JobQueue
+
+static Bool PerfMicro_emptyJob(void *data, U64 threadId, JobQueue *queue) {
+	(void) data; (void) threadId; (void) queue;
+	return true;
+}
+
+static Bool PerfMicro_jobQueue(void *data, const Allocator *alloc, Error *e_rr) {
+
+	(void) alloc;
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+
+	for(U64 i = 0; i < PerfMicro_jobs; ++i)
+		gotoIfError3(clean, JobQueue_push(&m->queue, PerfMicro_emptyJob, NULL, e_rr));
+
+	gotoIfError3(clean, JobQueue_wait(&m->queue, e_rr));
+
+clean:
+	return s_uccess;
+}
+
+//StreamCursor, small reads and writes through the cache of a memory stream
+
+static Bool PerfMicro_streamWrite(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+
+	const Buffer chunk = Buffer_createRefConst(m->hashData.ptr, PerfMicro_streamChunk);
+
+	for (U64 it = 0; it < PerfMicro_streamLength; it += PerfMicro_streamChunk)
+		gotoIfError3(clean, StreamCursor_write(&m->writer, chunk, 0, it, PerfMicro_streamChunk, false, alloc, e_rr));
+
+	gotoIfError3(clean, StreamCursor_flush(&m->writer, alloc, e_rr));
+
+clean:
+	return s_uccess;
+}
+
+static Bool PerfMicro_streamRead(void *data, const Allocator *alloc, Error *e_rr) {
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+
+	U64 chunk[PerfMicro_streamChunk / sizeof(U64)] = { 0 };
+
+	for (U64 it = 0; it < PerfMicro_streamLength; it += PerfMicro_streamChunk) {
+		const Buffer buf = Buffer_createRef(chunk, PerfMicro_streamChunk);
+		gotoIfError3(clean, StreamCursor_read(&m->reader, buf, it, 0, PerfMicro_streamChunk, false, alloc, e_rr));
+		m->sink += chunk[0];
+	}
+
+clean:
+	return s_uccess;
+}
+
+//RefPtr
+
+static Bool PerfMicro_refPtr(void *data, const Allocator *alloc, Error *e_rr) {
+
+	(void) alloc;
+
+	PerfMicro *m = (PerfMicro*) data;
+	Bool s_uccess = true;
+	RefPtr *ptr = (RefPtr*) m->stream;
+
+	for (U64 i = 0; i < PerfMicro_refs; ++i) {
+
+		if(!RefPtr_inc(ptr))
+			retError(clean, Error_invalidState(0, "PerfMicro_refPtr() inc failed"));
+
+		RefPtr *tmp = ptr;
+		RefPtr_dec(&tmp);           //Never the last reference, the stream keeps one
+	}
+
+clean:
+	return s_uccess;
+}
+
+Bool Perf_micro(PerfSuite *suite, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(!suite)
+		retError(clean, Error_nullPointer(0, "Perf_micro()::suite is required"));
+
+	const Allocator *alloc = suite->alloc;
+	const RefPtrType streamType = MemoryStream_makeType(alloc);
+
+	PerfMicro m = (PerfMicro) { 0 };
+
+	//Inputs
+
+	gotoIfError3(clean, ListU64_resize(&m.source, PerfMicro_listLength, alloc, e_rr));
+
+	for (U64 i = 0, rng = 0x2545F4914F6CDD1D; i < m.source.length; ++i) {
+		rng ^= rng << 13;
+		rng ^= rng >> 7;
+		rng ^= rng << 17;
+		m.source.ptrNonConst[i] = rng;
+	}
+
+	gotoIfError3(clean, CharString_reserve(&m.text, PerfMicro_textLength, alloc, e_rr));
+
+	while (CharString_length(m.text) + 8 < PerfMicro_textLength) {
+		const CharString word = CharString_createRefCStrConst(CharString_length(m.text) % 4 ? "word," : "foo,");
+		gotoIfError3(clean, CharString_appendString(&m.text, &word, alloc, e_rr));
+	}
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(PerfMicro_hashLength, alloc, &m.hashData, e_rr));
+	Buffer_csprng(m.hashData);
+
+	gotoIfError3(clean, JobQueue_create(PerfMicro_jobThreads, alloc, &m.queue, e_rr));
+
+	gotoIfError3(clean, MemoryStream_create(
+		PerfMicro_streamLength, EMemoryStreamFlags_IsWritable, &streamType, &m.stream, e_rr
+	));
+
+	gotoIfError3(clean, StreamCursor_create((StreamRef*) m.stream, 0, true, alloc, &m.writer, e_rr));
+	gotoIfError3(clean, StreamCursor_create((StreamRef*) m.stream, 0, false, alloc, &m.reader, e_rr));
+
+	//Benchmarks
+
+	gotoIfError3(clean, PerfSuite_run(suite, "List", "pushBack", PerfMicro_listLength, PerfMicro_listPushBack, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "List", "insertFront", PerfMicro_listShift, PerfMicro_listInsertFront, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "List", "eraseFront", PerfMicro_listShift, PerfMicro_listEraseFront, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "List", "sortU64", PerfMicro_listLength, PerfMicro_listSort, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "List", "sortCustom", PerfMicro_listLength, PerfMicro_listSortCustom, &m, e_rr));
+
+	const U64 textLen = CharString_length(m.text);
+
+	gotoIfError3(clean, PerfSuite_run(suite, "CharString", "split", textLen, PerfMicro_stringSplit, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "CharString", "replaceAll", textLen, PerfMicro_stringReplace, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "CharString", "format", PerfMicro_formats, PerfMicro_stringFormat, &m, e_rr));
+
+	gotoIfError3(clean, PerfSuite_run(suite, "Hash", "crc32c", PerfMicro_hashLength, PerfMicro_crc32c, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "Hash", "sha256", PerfMicro_hashLength, PerfMicro_sha256, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "Hash", "fnv1a64", PerfMicro_hashLength, PerfMicro_fnv1a64, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "Hash", "hash64", PerfMicro_hashLength, PerfMicro_hash64, &m, e_rr));
+
+	gotoIfError3(clean, PerfSuite_run(suite, "JobQueue", "pushWait", PerfMicro_jobs, PerfMicro_jobQueue, &m, e_rr));
+
+	const U64 chunks = PerfMicro_streamLength / PerfMicro_streamChunk;
+
+	gotoIfError3(clean, PerfSuite_run(suite, "StreamCursor", "write64", chunks, PerfMicro_streamWrite, &m, e_rr));
+	gotoIfError3(clean, PerfSuite_run(suite, "StreamCursor", "read64", chunks, PerfMicro_streamRead, &m, e_rr));
+
+	gotoIfError3(clean, PerfSuite_run(suite, "RefPtr", "incDec", PerfMicro_refs, PerfMicro_refPtr, &m, e_rr));
+
+clean:
+
+	if (suite) {
+		StreamCursor_close(&m.reader, suite->alloc);
+		StreamCursor_close(&m.writer, suite->alloc);
+		RefPtr_dec(&m.stream);
+		JobQueue_free(&m.queue);
+		Buffer_free(&m.hashData, suite->alloc);
+		CharString_free(&m.scratch, suite->alloc);
+		CharString_free(&m.text, suite->alloc);
+		ListU64_free(&m.list, suite->alloc);
+		ListU64_free(&m.source, suite->alloc);
+	}
+
+	return s_uccess;
+}
@@ -0,0 +1,175 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_pool_allocator.c
+
+#include "types/base/time.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/pool_allocator.h"
+#include "types/container/job_queue.h"
+#include "types/container/buffer.h"
+#include "types/container/string.h"
+#include "types/container/log.h"
+
+static const U64 threadCounts[] = { 1, 2, 4, 8, 16 };
+
+#define PerfPool_window 64
+#define PerfPool_steps (1 << 16)
+#define PerfPool_jobsPerThread 4
+
+typedef struct PerfPoolJob {
+	const Allocator *alloc;         //NULL to use PoolAllocator_thread(pool, threadId)
+	PoolAllocator *pool;
+	U64 seed;
+} PerfPoolJob;
+
+//Keeps a window of live allocations and replaces a random one each step (a free followed by an alloc),
+//which is the typical churn of small strings, RefPtrs and list growth.
+
+static Bool PerfPool_job(void *data, U64 threadId, JobQueue *queue) {
+
+	(void) queue;
+
+	PerfPoolJob *job = (PerfPoolJob*) data;
+	const Allocator *alloc = job->alloc ? job->alloc : PoolAllocator_thread(job->pool, threadId);
+
+	Buffer window[PerfPool_window] = { 0 };
+	U64 rng = job->seed;
+	Bool s_uccess = true;
+
+	for (U64 i = 0; i < PerfPool_steps; ++i) {
+
+		rng = rng * 6364136223846793005 + 1442695040888963407;
+
+		Buffer *slot = &window[(rng >> 33) % PerfPool_window];
+		const U64 size = (rng >> 45) & 3 ? 16 + ((rng >> 20) % 240) : 256 + ((rng >> 20) % 1792);
+
+		Buffer_free(slot, alloc);
+
+		if (!Buffer_createUninitializedBytes(size, alloc, slot, NULL)) {
+			s_uccess = false;
+			break;
+		}
+
+		slot->ptrNonConst[0] = (U8) i;
+	}
+
+	for(U64 i = 0; i < PerfPool_window; ++i)
+		Buffer_free(&window[i], alloc);
+
+	return s_uccess;
+}
+
+Bool Perf_poolAllocator(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	JobQueue queue = (JobQueue) { 0 };
+	PoolAllocator pool = (PoolAllocator) { 0 };
+	PerfPoolJob jobs[16 * PerfPool_jobsPerThread];
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s\n",
+		"Type", "Threads", "Operations", "Seconds", "Mops/s"
+	));
+
+	for (U64 i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); ++i) {
+
+		const U64 threads = threadCounts[i];
+		const U64 jobCount = threads * PerfPool_jobsPerThread;
+
+		gotoIfError3(clean, JobQueue_create(threads, alloc, &queue, e_rr));
+		gotoIfError3(clean, PoolAllocator_create(JobQueue_threadCount(&queue), alloc, &pool, e_rr));
+
+		//m = 0 is the allocator that was passed in (malloc backed, like Platform_allocNoTracking)
+
+		for (U64 m = 0; m < 2; ++m) {
+
+			for(U64 j = 0; j < jobCount; ++j)
+				jobs[j] = (PerfPoolJob) { .alloc = m ? NULL : alloc, .pool = &pool, .seed = j * 0x9E3779B97F4A7C15 + 1 };
+
+			const Ns start = Time_now();
+
+			for(U64 j = 0; j < jobCount; ++j)
+				gotoIfError3(clean, JobQueue_push(&queue, PerfPool_job, &jobs[j], e_rr));
+
+			gotoIfError3(clean, JobQueue_wait(&queue, e_rr));
+
+			const DNs diff = Time_elapsed(start);
+			const U64 ops = jobCount * PerfPool_steps * 2;
+
+			if(!JobQueue_isSuccess(&queue))
+				retError(clean, Error_outOfMemory(0, "Perf_poolAllocator() job failed to allocate"));
+
+			if (logToConsole)
+				Log_debugLn(
+					alloc,
+					"%s with %"PRIu64" threads: %"PRIu64" allocs + frees in %fs (%f Mops/s)",
+					m ? "PoolAllocator" : "Parent allocator", threads, ops,
+					(F64)diff / SECOND, ops / ((F64)diff / SECOND) / 1e6
+				);
+
+			gotoIfError3(clean, CharString_format(
+				alloc, &tmpStr, e_rr,
+				"%s%s,%"PRIu64",%"PRIu64",%f,%f\n",
+				csv.ptr ? csv.ptr : "",
+				m ? "PoolAllocator" : "Parent",
+				threads, ops,
+				(F64)diff / SECOND,
+				ops / ((F64)diff / SECOND) / 1e6
+			));
+
+			CharString_free(&csv, alloc);
+			csv    = tmpStr;
+			tmpStr = CharString_createNull();
+		}
+
+		if (logToConsole) {
+
+			PoolAllocatorStats stats[PoolAllocator_classCount + 1];
+			PoolAllocator_getStats(&pool, stats);
+
+			for (U64 j = 0; j <= PoolAllocator_classCount; ++j)
+				if(stats[j].allocations)
+					Log_debugLn(
+						alloc,
+						"\tClass %"PRIu64" bytes: %"PRIu64" allocations, %"PRIu64" refills, %"PRIu64" flushes, %"PRIu64" slabs",
+						stats[j].blockSize, stats[j].allocations, stats[j].refills, stats[j].flushes, stats[j].slabs
+					);
+		}
+
+		PoolAllocator_free(&pool);
+		JobQueue_free(&queue);
+	}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	PoolAllocator_free(&pool);
+	JobQueue_free(&queue);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
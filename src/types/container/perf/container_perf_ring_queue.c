@@ -0,0 +1,238 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_ring_queue.c
+
+#include "types/base/time.h"
+#include "types/base/lock.h"
+#include "types/base/thread.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/ring_queue.h"
+#include "types/container/string.h"
+#include "types/container/log.h"
+
+#define PerfRingQueue_elements (1 << 20)    //Per run, split over the producers
+#define PerfRingQueue_capacity 1024
+#define PerfRingQueue_maxThreads 8
+
+typedef enum EPerfRingQueue {
+	EPerfRingQueue_MPMC,
+	EPerfRingQueue_SPSC,
+	EPerfRingQueue_Locked,                  //SpinLock around a plain ring, what the lock-free ones replace
+	EPerfRingQueue_Count
+} EPerfRingQueue;
+
+static const C8 *PerfRingQueue_names[] = { "MPMC", "SPSC", "SpinLock" };
+
+static const U64 PerfRingQueue_threads[][2] = { { 1, 1 }, { 2, 2 }, { 4, 4 }, { 1, 4 }, { 4, 1 } };
+
+typedef struct PerfLockedQueue {
+	SpinLock lock;
+	U64 *data;
+	U64 head, tail, mask;
+} PerfLockedQueue;
+
+typedef struct PerfRingQueue {
+
+	MPMCQueue mpmc;
+	SPSCQueue spsc;
+	PerfLockedQueue locked;
+
+	EPerfRingQueue type;
+	U64 perProducer;
+
+	alignas(64) AtomicI64 remaining;        //Elements consumers still have to pop
+	alignas(64) AtomicI64 sum;
+
+} PerfRingQueue;
+
+static Bool PerfRingQueue_push(PerfRingQueue *q, U64 v) {
+
+	switch (q->type) {
+
+		case EPerfRingQueue_MPMC: return MPMCQueue_push(&q->mpmc, &v);
+		case EPerfRingQueue_SPSC: return SPSCQueue_push(&q->spsc, &v);
+
+		default: {
+
+			SpinLock_lock(&q->locked.lock, U64_MAX);
+			const Bool full = q->locked.tail - q->locked.head > q->locked.mask;
+
+			if(!full)
+				q->locked.data[q->locked.tail++ & q->locked.mask] = v;
+
+			SpinLock_unlock(&q->locked.lock);
+			return !full;
+		}
+	}
+}
+
+static Bool PerfRingQueue_pop(PerfRingQueue *q, U64 *v) {
+
+	switch (q->type) {
+
+		case EPerfRingQueue_MPMC: return MPMCQueue_pop(&q->mpmc, v);
+		case EPerfRingQueue_SPSC: return SPSCQueue_pop(&q->spsc, v);
+
+		default: {
+
+			SpinLock_lock(&q->locked.lock, U64_MAX);
+			const Bool empty = q->locked.tail == q->locked.head;
+
+			if(!empty)
+				*v = q->locked.data[q->locked.head++ & q->locked.mask];
+
+			SpinLock_unlock(&q->locked.lock);
+			return !empty;
+		}
+	}
+}
+
+static void PerfRingQueue_producer(void *data) {
+
+	PerfRingQueue *q = (PerfRingQueue*) data;
+
+	for(U64 i = 0; i < q->perProducer; ++i)
+		while(!PerfRingQueue_push(q, i))
+			Thread_sleep(0);
+}
+
+static void PerfRingQueue_consumer(void *data) {
+
+	PerfRingQueue *q = (PerfRingQueue*) data;
+	I64 sum = 0;
+
+	//Claim an element before popping it, so consumers know when to stop without a sentinel
+
+	while (AtomicI64_dec(&q->remaining) >= 0) {
+
+		U64 v = 0;
+
+		while(!PerfRingQueue_pop(q, &v))
+			Thread_sleep(0);
+
+		sum += (I64) v;
+	}
+
+	AtomicI64_add(&q->sum, sum);
+}
+
+//Elements per second through each queue, for a few producer and consumer counts.
+//Every element is a U64, producers and consumers back off with Thread_sleep(0) when full or empty.
+
+Bool Perf_ringQueue(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	PerfRingQueue queue = (PerfRingQueue) { 0 };
+	Thread *threads[PerfRingQueue_maxThreads * 2] = { 0 };
+	Buffer lockedData = Buffer_createNull();
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	gotoIfError3(clean, MPMCQueue_create(PerfRingQueue_capacity, sizeof(U64), alloc, &queue.mpmc, e_rr));
+	gotoIfError3(clean, SPSCQueue_create(PerfRingQueue_capacity, sizeof(U64), alloc, &queue.spsc, e_rr));
+	gotoIfError3(clean, Buffer_createEmptyBytes(PerfRingQueue_capacity * sizeof(U64), alloc, &lockedData, e_rr));
+
+	queue.locked = (PerfLockedQueue) { .data = (U64*) lockedData.ptrNonConst, .mask = PerfRingQueue_capacity - 1 };
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s,%s\n",
+		"Queue", "Producers", "Consumers", "Elements", "Seconds", "Melements/s"
+	));
+
+	for (U64 i = 0; i < sizeof(PerfRingQueue_threads) / sizeof(PerfRingQueue_threads[0]); ++i)
+		for (EPerfRingQueue type = 0; type < EPerfRingQueue_Count; ++type) {
+
+			const U64 producers = PerfRingQueue_threads[i][0];
+			const U64 consumers = PerfRingQueue_threads[i][1];
+
+			if(type == EPerfRingQueue_SPSC && (producers != 1 || consumers != 1))
+				continue;
+
+			const U64 elements = PerfRingQueue_elements / producers * producers;
+
+			queue.type = type;
+			queue.perProducer = elements / producers;
+			AtomicI64_store(&queue.remaining, (I64) elements);
+			AtomicI64_store(&queue.sum, 0);
+
+			const Ns start = Time_now();
+
+			for(U64 j = 0; j < producers + consumers; ++j)
+				gotoIfError3(clean, Thread_create(
+					alloc,
+					j < producers ? PerfRingQueue_producer : PerfRingQueue_consumer,
+					&queue,
+					&threads[j],
+					e_rr
+				));
+
+			for(U64 j = 0; j < producers + consumers; ++j)
+				gotoIfError3(clean, Thread_waitAndCleanup(alloc, &threads[j], e_rr));
+
+			const DNs diff = Time_elapsed(start);
+			const U64 perProducer = queue.perProducer;
+
+			if((U64) AtomicI64_load(&queue.sum) != producers * (perProducer * (perProducer - 1) / 2))
+				retError(clean, Error_invalidState(0, "Perf_ringQueue() lost or duplicated elements"));
+
+			const C8 *name = PerfRingQueue_names[type];
+
+			if (logToConsole)
+				Log_debugLn(
+					alloc,
+					"%s with %"PRIu64" producers and %"PRIu64" consumers: %"PRIu64" elements in %fs (%f Melements/s)",
+					name, producers, consumers, elements,
+					(F64)diff / SECOND, elements / ((F64)diff / SECOND) / 1e6
+				);
+
+			gotoIfError3(clean, CharString_format(
+				alloc, &tmpStr, e_rr,
+				"%s%s,%"PRIu64",%"PRIu64",%"PRIu64",%f,%f\n",
+				csv.ptr ? csv.ptr : "",
+				name, producers, consumers, elements,
+				(F64)diff / SECOND,
+				elements / ((F64)diff / SECOND) / 1e6
+			));
+
+			CharString_free(&csv, alloc);
+			csv    = tmpStr;
+			tmpStr = CharString_createNull();
+		}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+
+	for(U64 j = 0; j < PerfRingQueue_maxThreads * 2; ++j)
+		if(threads[j])
+			Thread_waitAndCleanup(alloc, &threads[j], NULL);
+
+	MPMCQueue_free(&queue.mpmc, alloc);
+	SPSCQueue_free(&queue.spsc, alloc);
+	Buffer_free(&lockedData, alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
@@ -0,0 +1,129 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_sha256.c
+
+#include "types/base/time.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/string.h"
+#include "types/container/buffer.h"
+#include "types/container/log.h"
+
+#define PerfSHA256_bytes (16 << 20)
+#define PerfSHA256_maxMessages (PerfSHA256_bytes / 32)
+
+//MB/s of Buffer_sha256BatchLanes per message size and lane count.
+//1 lane is Buffer_sha256 per message (the SHA extension if the CPU has it), 0 is what the batch picks by itself.
+
+Bool Perf_sha256(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	Buffer data = Buffer_createNull();
+	Buffer bufsData = Buffer_createNull();
+	Buffer outputsData = Buffer_createNull();
+	Buffer expectedData = Buffer_createNull();
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	static const U64 sizes[] = { 32, 256, 1024, 4096, 65536 };
+	static const U8 lanes[] = { 1, 4, 8, 16, 0 };
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s,%s\n",
+		"MessageSize", "Lanes", "Messages", "Seconds", "MB/s", "Messages/s"
+	));
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(PerfSHA256_bytes, alloc, &data, e_rr));
+	gotoIfError3(clean, Buffer_createUninitializedBytes(sizeof(Buffer) * PerfSHA256_maxMessages, alloc, &bufsData, e_rr));
+	gotoIfError3(clean, Buffer_createUninitializedBytes(32 * PerfSHA256_maxMessages, alloc, &outputsData, e_rr));
+	gotoIfError3(clean, Buffer_createUninitializedBytes(32 * PerfSHA256_maxMessages, alloc, &expectedData, e_rr));
+
+	for (U64 i = 0; i < PerfSHA256_bytes; ++i)
+		data.ptrNonConst[i] = (U8)(i * 131 + (i >> 10));
+
+	Buffer *bufs = (Buffer*) bufsData.ptrNonConst;
+	U32 (*outputs)[8] = (U32(*)[8]) outputsData.ptrNonConst;
+	U32 (*expected)[8] = (U32(*)[8]) expectedData.ptrNonConst;
+
+	for (U64 s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+
+		const U64 count = PerfSHA256_bytes / sizes[s];
+
+		for (U64 i = 0; i < count; ++i)
+			bufs[i] = Buffer_createRefConst(data.ptr + i * sizes[s], sizes[s]);
+
+		for (U64 l = 0; l < sizeof(lanes); ++l) {
+
+			const Ns start = Time_now();
+			const U8 used = Buffer_sha256BatchLanes(bufs, count, l ? outputs : expected, lanes[l]);
+			const DNs diff = Time_elapsed(start);
+			const F64 seconds = (F64)diff / SECOND;
+
+			if (l) {
+
+				Bool match = true;
+
+				for (U64 i = 0; i < count; ++i)
+					for (U64 j = 0; j < 8; ++j)
+						match &= outputs[i][j] == expected[i][j];
+
+				if(!match)
+					retError(clean, Error_invalidState(0, "Perf_sha256() batch didn't match Buffer_sha256"));
+			}
+
+			if (logToConsole)
+				Log_debugLn(
+					alloc,
+					"SHA256 of %"PRIu64" x %"PRIu64" bytes with %u lanes (asked %u): %fs (%f MB/s, %f messages/s)",
+					count, sizes[s], (U32) used, (U32) lanes[l],
+					seconds, PerfSHA256_bytes / seconds / 1e6, count / seconds
+				);
+
+			gotoIfError3(clean, CharString_format(
+				alloc, &tmpStr, e_rr,
+				"%s%"PRIu64",%u,%"PRIu64",%f,%f,%f\n",
+				csv.ptr ? csv.ptr : "",
+				sizes[s], (U32) used, count,
+				seconds,
+				PerfSHA256_bytes / seconds / 1e6,
+				count / seconds
+			));
+
+			CharString_free(&csv, alloc);
+			csv    = tmpStr;
+			tmpStr = CharString_createNull();
+		}
+	}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	Buffer_free(&data, alloc);
+	Buffer_free(&bufsData, alloc);
+	Buffer_free(&outputsData, alloc);
+	Buffer_free(&expectedData, alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
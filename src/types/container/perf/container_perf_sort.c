@@ -0,0 +1,164 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_sort.c
+
+#include "types/base/time.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/list_basic_types.h"
+#include "types/container/job_queue.h"
+#include "types/container/buffer.h"
+#include "types/container/string.h"
+#include "types/container/log.h"
+
+#define PerfSort_threads 8
+
+static const U64 sortLengths[] = { 1 << 10, 1 << 16, 1 << 20, 1 << 22 };
+
+typedef enum EPerfSort {
+	EPerfSort_Custom,               //pdqsort through a comparator
+	EPerfSort_RadixInPlace,         //GenericList_sortU64
+	EPerfSort_Radix,                //GenericList_sortRadixU64
+	EPerfSort_Stable,               //Merge sort through a comparator
+	EPerfSort_Parallel,             //sortParallel on a work stealing queue
+	EPerfSort_Count
+} EPerfSort;
+
+static const C8 *sortNames[] = { "sortCustom", "sortU64", "sortRadixU64", "sortStable", "sortParallel" };
+static const C8 *inputNames[] = { "Random", "Sorted", "Reversed", "FewKeys" };
+
+static ECompareResult PerfSort_compare(const void *a, const void *b, void *context) {
+	(void) context;
+	const U64 x = *(const U64*) a, y = *(const U64*) b;
+	return x < y ? ECompareResult_Lt : (x > y ? ECompareResult_Gt : ECompareResult_Eq);
+}
+
+static void PerfSort_fill(U64 *v, U64 n, U64 input) {
+
+	U64 rng = 0x2545F4914F6CDD1D;
+
+	for (U64 i = 0; i < n; ++i) {
+
+		rng ^= rng << 13;
+		rng ^= rng >> 7;
+		rng ^= rng << 17;
+
+		v[i] = input == 0 ? rng : (input == 1 ? i : (input == 2 ? n - i : rng % 16));
+	}
+}
+
+//Million elements per second of every U64 sort on a few input patterns.
+//The parallel sort uses a work stealing queue with PerfSort_threads execution contexts.
+
+Bool Perf_sort(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	ListU64 list = (ListU64) { 0 };
+	JobQueue queue = (JobQueue) { 0 };
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	gotoIfError3(clean, JobQueue_createFlags(PerfSort_threads, EJobQueueFlags_WorkStealing, alloc, &queue, e_rr));
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s\n",
+		"Algorithm", "Input", "Elements", "Seconds", "Melem/s"
+	));
+
+	for (U64 i = 0; i < sizeof(sortLengths) / sizeof(sortLengths[0]); ++i) {
+
+		const U64 n = sortLengths[i];
+		gotoIfError3(clean, ListU64_resize(&list, n, alloc, e_rr));
+
+		for (U64 input = 0; input < sizeof(inputNames) / sizeof(inputNames[0]); ++input)
+			for (U64 algo = 0; algo < EPerfSort_Count; ++algo) {
+
+				PerfSort_fill(list.ptrNonConst, n, input);
+
+				const GenericList l = ListU64_toList(list);
+				const Ns start = Time_now();
+
+				switch (algo) {
+
+					case EPerfSort_Custom:
+						if(!GenericList_sortCustom(l, PerfSort_compare, NULL))
+							retError(clean, Error_invalidState(0, "Perf_sort() sortCustom failed"));
+						break;
+
+					case EPerfSort_RadixInPlace:
+						if(!GenericList_sortU64(l))
+							retError(clean, Error_invalidState(0, "Perf_sort() sortU64 failed"));
+						break;
+
+					case EPerfSort_Radix:
+						gotoIfError3(clean, GenericList_sortRadixU64(l, alloc, e_rr));
+						break;
+
+					case EPerfSort_Stable:
+						gotoIfError3(clean, GenericList_sortStable(l, PerfSort_compare, NULL, alloc, e_rr));
+						break;
+
+					default:
+						gotoIfError3(clean, GenericList_sortParallel(l, PerfSort_compare, NULL, &queue, alloc, e_rr));
+						break;
+				}
+
+				const DNs diff = Time_elapsed(start);
+
+				for(U64 j = 1; j < n; ++j)
+					if(list.ptr[j - 1] > list.ptr[j])
+						retError(clean, Error_invalidState(0, "Perf_sort() output isn't sorted"));
+
+				if (logToConsole)
+					Log_debugLn(
+						alloc,
+						"%s on %"PRIu64" %s U64s: %fs (%f Melem/s)",
+						sortNames[algo], n, inputNames[input],
+						(F64)diff / SECOND, n / ((F64)diff / SECOND) / 1e6
+					);
+
+				gotoIfError3(clean, CharString_format(
+					alloc, &tmpStr, e_rr,
+					"%s%s,%s,%"PRIu64",%f,%f\n",
+					csv.ptr ? csv.ptr : "",
+					sortNames[algo], inputNames[input], n,
+					(F64)diff / SECOND,
+					n / ((F64)diff / SECOND) / 1e6
+				));
+
+				CharString_free(&csv, alloc);
+				csv    = tmpStr;
+				tmpStr = CharString_createNull();
+			}
+	}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	JobQueue_free(&queue);
+	ListU64_free(&list, alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
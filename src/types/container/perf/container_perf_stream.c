@@ -0,0 +1,163 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_stream.c
+
+#include "types/base/time.h"
+#include "types/base/thread.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/memory_stream.h"
+#include "types/container/string.h"
+#include "types/container/buffer.h"
+#include "types/container/log.h"
+#include "types/base/mathi.h"
+
+#define PerfStream_bytes (64 << 20)
+#define PerfStream_chunk (64 * KIBI)
+#define PerfStream_latency (100 * MU)        //Per cache refill (128KiB), about what a disk or network stream takes
+
+//The latency stream is a memory stream that sleeps before every read.
+//Sleeping rather than spinning leaves the core to the reader, like real IO would.
+
+static StreamFunc PerfStream_memoryRead;
+
+static Bool PerfStream_latencyRead(
+	OxStream *stream, U64 offset, U64 length, Buffer buf, const Allocator *alloc, Error *e_rr
+) {
+	Thread_sleep(PerfStream_latency);
+	return PerfStream_memoryRead(stream, offset, length, buf, alloc, e_rr);
+}
+
+//MB/s of a reader that consumes a stream in 64KiB chunks through a default (128KiB) StreamCursor.
+//Depth 0 is a plain cursor, otherwise StreamCursor_enableReadAhead with that depth.
+//The reader either only copies (so it's bound by the stream) or hashes every chunk too (so reads can hide behind it).
+
+Bool Perf_stream(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	Buffer data = Buffer_createNull();
+	Buffer chunk = Buffer_createNull();
+	RefPtr *stream = NULL;
+	StreamCursor cursor = (StreamCursor) { 0 };
+
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	static const C8 *streamNames[] = { "Memory", "Latency" };
+	static const C8 *workNames[] = { "Copy", "SHA256" };
+	static const U64 depths[] = { 0, 1, 2, 4, 8 };
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s\n",
+		"Stream", "Work", "Depth", "Seconds", "MB/s"
+	));
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(PerfStream_bytes, alloc, &data, e_rr));
+	gotoIfError3(clean, Buffer_createUninitializedBytes(PerfStream_chunk, alloc, &chunk, e_rr));
+
+	for (U64 i = 0; i < PerfStream_bytes; ++i)
+		data.ptrNonConst[i] = (U8)(i * 131 + (i >> 10));
+
+	const RefPtrType type = MemoryStream_makeType(alloc);
+	Buffer dataRef = Buffer_createRefConst(data.ptr, PerfStream_bytes);
+	gotoIfError3(clean, MemoryStream_createFromBuffer(&dataRef, EMemoryStreamFlags_None, &type, &stream, e_rr));
+
+	OxStream *oxStream = RefPtr_data(stream, OxStream);
+	PerfStream_memoryRead = oxStream->read;
+
+	for (U64 s = 0; s < sizeof(streamNames) / sizeof(streamNames[0]); ++s) {
+
+		oxStream->read = s ? PerfStream_latencyRead : PerfStream_memoryRead;
+
+		for (U64 w = 0; w < sizeof(workNames) / sizeof(workNames[0]); ++w) {
+
+			U32 expected = 0;
+
+			for (U64 d = 0; d < sizeof(depths) / sizeof(depths[0]); ++d) {
+
+				gotoIfError3(clean, StreamCursor_create(stream, 0, false, alloc, &cursor, e_rr));
+
+				if (depths[d])
+					gotoIfError3(clean, StreamCursor_enableReadAhead(&cursor, depths[d], alloc, e_rr));
+
+				U32 check = 0;
+				const Ns start = Time_now();
+
+				for (U64 it = 0; it < PerfStream_bytes; ) {
+
+					gotoIfError3(clean, StreamCursor_consumeBuffer(&cursor, &it, chunk, alloc, e_rr));
+
+					if (w) {
+						U32 hash[8];
+						Buffer_sha256(chunk, hash);
+						check ^= hash[0];
+					}
+
+					else check ^= *(const U32*)chunk.ptr;
+				}
+
+				const DNs diff = Time_elapsed(start);
+				const F64 seconds = (F64)diff / SECOND;
+
+				StreamCursor_close(&cursor, alloc);
+
+				if(!d)
+					expected = check;
+
+				else if(check != expected)
+					retError(clean, Error_invalidState(0, "Perf_stream() read-ahead read different data"));
+
+				if (logToConsole)
+					Log_debugLn(
+						alloc,
+						"Stream %s (%s) with read-ahead depth %"PRIu64": %fs (%f MB/s)",
+						streamNames[s], workNames[w], depths[d], seconds, PerfStream_bytes / seconds / 1e6
+					);
+
+				gotoIfError3(clean, CharString_format(
+					alloc, &tmpStr, e_rr,
+					"%s%s,%s,%"PRIu64",%f,%f\n",
+					csv.ptr ? csv.ptr : "",
+					streamNames[s], workNames[w], depths[d],
+					seconds,
+					PerfStream_bytes / seconds / 1e6
+				));
+
+				CharString_free(&csv, alloc);
+				csv    = tmpStr;
+				tmpStr = CharString_createNull();
+			}
+		}
+	}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	StreamCursor_close(&cursor, alloc);
+	RefPtr_dec(&stream);
+	Buffer_free(&data, alloc);
+	Buffer_free(&chunk, alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
@@ -0,0 +1,207 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_string_search.c
+
+#include "types/base/time.h"
+#include "types/base/string_read_helper.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/string.h"
+#include "types/container/string_helper.h"
+#include "types/container/log.h"
+
+static const U64 searchLengths[] = { 1 << 16, 1 << 20, 1 << 23 };
+
+typedef enum EPerfSearch {
+	EPerfSearch_ScalarFind,         //Plain byte loop, what findFirst used to be
+	EPerfSearch_FindFirst,          //Byte that isn't present, so the whole text is scanned
+	EPerfSearch_CountAll,
+	EPerfSearch_FindString,         //Needle that isn't present, but its first byte is common
+	EPerfSearch_FindStringInsensitive,
+	EPerfSearch_CountAllString,
+	EPerfSearch_SplitLine,
+	EPerfSearch_ReplaceGrow,        //"the" -> "THE_", then back
+	EPerfSearch_ReplaceShrink,
+	EPerfSearch_Count
+} EPerfSearch;
+
+static const C8 *searchNames[] = {
+	"scalarFind", "findFirst", "countAll", "findFirstString", "findFirstStringInsensitive",
+	"countAllString", "splitLine", "replaceAllStringGrow", "replaceAllStringShrink"
+};
+
+//Lowercase words with spaces and a line end every ~80 characters, so both the byte and the substring
+// searches see realistic hit rates.
+
+static void PerfSearch_fill(C8 *text, U64 n) {
+
+	static const C8 *words[] = { "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "and", "then" };
+	U64 rng = 0x2545F4914F6CDD1D, line = 0;
+
+	for (U64 i = 0; i < n; ) {
+
+		rng ^= rng << 13;
+		rng ^= rng >> 7;
+		rng ^= rng << 17;
+
+		const C8 *word = words[rng % (sizeof(words) / sizeof(words[0]))];
+
+		for(; *word && i < n; ++word, ++i, ++line)
+			text[i] = *word;
+
+		if(i < n)
+			text[i++] = line > 80 ? '\n' : ' ';
+
+		if(line > 80)
+			line = 0;
+	}
+}
+
+//GB/s of the CharString search functions over text of a few MiB, next to a plain byte loop for reference.
+
+Bool Perf_stringSearch(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	CharString text   = CharString_createNull();
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+	ListCharString lines = (ListCharString) { 0 };
+
+	const CharString needle = CharString_createRefCStrConst("thequick");
+	const CharString needleUpper = CharString_createRefCStrConst("THEQUICK");
+	const CharString the = CharString_createRefCStrConst("the");
+	const CharString theLong = CharString_createRefCStrConst("THE_");
+	const CharString the2 = CharString_createRefCStrConst("th");
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s\n",
+		"Function", "Bytes", "Seconds", "GB/s"
+	));
+
+	for (U64 i = 0; i < sizeof(searchLengths) / sizeof(searchLengths[0]); ++i) {
+
+		const U64 n = searchLengths[i];
+
+		for (U64 func = 0; func < EPerfSearch_Count; ++func) {
+
+			CharString_free(&text, alloc);
+			gotoIfError3(clean, CharString_create(' ', n, alloc, &text, e_rr));
+			PerfSearch_fill(text.ptrNonConst, n);
+
+			U64 result = 0;
+			const Ns start = Time_now();
+
+			switch (func) {
+
+				case EPerfSearch_ScalarFind: {
+
+					volatile const C8 *ptr = text.ptr;
+					result = U64_MAX;
+
+					for(U64 j = 0; j < n; ++j)
+						if (ptr[j] == '#') {
+							result = j;
+							break;
+						}
+
+					break;
+				}
+
+				case EPerfSearch_FindFirst:
+					result = CharString_findFirstSensitive(&text, '#', 0, 0);
+					break;
+
+				case EPerfSearch_CountAll:
+					result = CharString_countAllSensitive(&text, 'e', 0);
+					break;
+
+				case EPerfSearch_FindString:
+					result = CharString_findFirstStringSensitive(&text, &needle, 0, 0);
+					break;
+
+				case EPerfSearch_FindStringInsensitive:
+					result = CharString_findFirstStringInsensitive(&text, &needleUpper, 0, 0);
+					break;
+
+				case EPerfSearch_CountAllString:
+					result = CharString_countAllStringSensitive(&text, &the, 0);
+					break;
+
+				case EPerfSearch_SplitLine:
+					gotoIfError3(clean, CharString_splitLine(text, alloc, &lines, e_rr));
+					result = lines.length;
+					ListCharString_free(&lines, alloc);
+					break;
+
+				case EPerfSearch_ReplaceGrow: {
+					CharStringReplace2 r = { .s = &text, .search = &the, .replace = &theLong, .allocator = alloc };
+					gotoIfError3(clean, CharString_replaceAllStringSensitive(&r, e_rr));
+					result = CharString_length(text);
+					break;
+				}
+
+				default: {
+					CharStringReplace2 r = { .s = &text, .search = &the, .replace = &the2, .allocator = alloc };
+					gotoIfError3(clean, CharString_replaceAllStringSensitive(&r, e_rr));
+					result = CharString_length(text);
+					break;
+				}
+			}
+
+			const DNs diff = Time_elapsed(start);
+			const F64 seconds = (F64)diff / SECOND;
+
+			if(func <= EPerfSearch_FindFirst && result != U64_MAX)
+				retError(clean, Error_invalidState(0, "Perf_stringSearch() found a byte that isn't there"));
+
+			if (logToConsole)
+				Log_debugLn(
+					alloc,
+					"%s on %"PRIu64" bytes: %fs (%f GB/s, result %"PRIu64")",
+					searchNames[func], n, seconds, n / seconds / 1e9, result
+				);
+
+			gotoIfError3(clean, CharString_format(
+				alloc, &tmpStr, e_rr,
+				"%s%s,%"PRIu64",%f,%f\n",
+				csv.ptr ? csv.ptr : "",
+				searchNames[func], n,
+				seconds,
+				n / seconds / 1e9
+			));
+
+			CharString_free(&csv, alloc);
+			csv    = tmpStr;
+			tmpStr = CharString_createNull();
+		}
+	}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	ListCharString_free(&lines, alloc);
+	CharString_free(&text,   alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
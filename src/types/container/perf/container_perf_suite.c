@@ -0,0 +1,311 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_suite.c
+
+#include "types/base/time.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/list_impl.h"
+#include "types/container/list_basic_types.h"
+#include "types/container/buffer.h"
+#include "types/container/string.h"
+#include "types/container/log.h"
+#include "types/base/string_read_helper.h"
+
+TListImpl(PerfResult);
+
+Bool PerfSuite_run(
+	PerfSuite *suite,
+	const C8 *group,
+	const C8 *name,
+	U64 ops,
+	PerfBenchFunc func,
+	void *data,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+	ListF64 samples = (ListF64) { 0 };
+
+	if(!suite || !group || !name || !func)
+		retError(clean, Error_nullPointer(!suite ? 0 : 4, "PerfSuite_run()::suite, group, name and func are required"));
+
+	if(!suite->repetitions || !ops)
+		retError(clean, Error_invalidParameter(0, 0, "PerfSuite_run()::suite->repetitions and ops have to be > 0"));
+
+	const Allocator *alloc = suite->alloc;
+
+	gotoIfError3(clean, ListF64_resize(&samples, suite->repetitions, alloc, e_rr));
+
+	for(U64 i = 0; i < suite->warmup; ++i)
+		gotoIfError3(clean, func(data, alloc, e_rr));
+
+	//Allocations are counted over the measured repetitions only, so the warmup can fill caches
+
+	U64 allocsBefore = 0, bytesBefore = 0;
+
+	if(suite->allocStats)
+		suite->allocStats(&allocsBefore, &bytesBefore);
+
+	for (U64 i = 0; i < suite->repetitions; ++i) {
+		const Ns start = Time_now();
+		gotoIfError3(clean, func(data, alloc, e_rr));
+		samples.ptrNonConst[i] = (F64) Time_elapsed(start);
+	}
+
+	U64 allocsAfter = 0, bytesAfter = 0;
+
+	if(suite->allocStats)
+		suite->allocStats(&allocsAfter, &bytesAfter);
+
+	if(!ListF64_sort(samples))
+		retError(clean, Error_invalidState(0, "PerfSuite_run() couldn't sort samples"));
+
+	const U64 n = samples.length;
+	const U64 p95 = (n * 95 + 99) / 100;        //ceil(n * 0.95), the nearest rank
+
+	const PerfResult result = (PerfResult) {
+		.group = group,
+		.name = name,
+		.ops = ops,
+		.repetitions = n,
+		.medianNs = n & 1 ? samples.ptr[n / 2] : (samples.ptr[n / 2 - 1] + samples.ptr[n / 2]) / 2,
+		.p95Ns = samples.ptr[p95 - 1],
+		.minNs = samples.ptr[0],
+		.allocations = (F64)(allocsAfter - allocsBefore) / (F64) n,
+		.allocBytes = (F64)(bytesAfter - bytesBefore) / (F64) n
+	};
+
+	gotoIfError3(clean, ListPerfResult_pushBack(&suite->results, result, alloc, e_rr));
+
+	if (suite->logToConsole)
+		Log_debugLn(
+			alloc,
+			"%s::%s: median %.0fns (%.2fns/op), p95 %.0fns, min %.0fns, %.1f allocations (%.0f bytes)",
+			group, name,
+			result.medianNs, result.medianNs / (F64) ops, result.p95Ns, result.minNs,
+			result.allocations, result.allocBytes
+		);
+
+clean:
+	ListF64_free(&samples, suite ? suite->alloc : NULL);
+	return s_uccess;
+}
+
+static Bool PerfSuite_writeFile(const CharString *path, const CharString data, Error *e_rr) {
+
+	if(!path || !path->ptr) {
+		if(e_rr) *e_rr = Error_nullPointer(1, "PerfSuite_writeFile()::path is required");
+		return false;
+	}
+
+	return Perf_writeCsv(*path, data, e_rr);
+}
+
+static Bool PerfSuite_append(CharString *out, const Allocator *alloc, CharString *tmp, Error *e_rr) {
+	const Bool ok = CharString_appendString(out, tmp, alloc, e_rr);
+	CharString_free(tmp, alloc);
+	return ok;
+}
+
+Bool PerfSuite_writeCsv(const PerfSuite *suite, const CharString *path, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	const Allocator *alloc = suite ? suite->alloc : NULL;
+	CharString csv = CharString_createNull();
+	CharString tmp = CharString_createNull();
+
+	if(!suite)
+		retError(clean, Error_nullPointer(0, "PerfSuite_writeCsv()::suite is required"));
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s,%s,%s,%s,%s,%s\n",
+		"Group", "Name", "Ops", "Repetitions", "Median ns", "P95 ns", "Min ns", "Median ns/op",
+		"Allocations", "Allocated bytes"
+	));
+
+	for (U64 i = 0; i < suite->results.length; ++i) {
+
+		const PerfResult *r = &suite->results.ptr[i];
+
+		gotoIfError3(clean, CharString_format(
+			alloc, &tmp, e_rr,
+			"%s,%s,%"PRIu64",%"PRIu64",%f,%f,%f,%f,%f,%f\n",
+			r->group, r->name, r->ops, r->repetitions,
+			r->medianNs, r->p95Ns, r->minNs, r->medianNs / (F64) r->ops,
+			r->allocations, r->allocBytes
+		));
+
+		gotoIfError3(clean, PerfSuite_append(&csv, alloc, &tmp, e_rr));
+	}
+
+	gotoIfError3(clean, PerfSuite_writeFile(path, csv, e_rr));
+
+clean:
+	CharString_free(&csv, alloc);
+	CharString_free(&tmp, alloc);
+	return s_uccess;
+}
+
+Bool PerfSuite_writeJson(const PerfSuite *suite, const CharString *path, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	const Allocator *alloc = suite ? suite->alloc : NULL;
+	CharString json = CharString_createNull();
+	CharString tmp = CharString_createNull();
+
+	if(!suite)
+		retError(clean, Error_nullPointer(0, "PerfSuite_writeJson()::suite is required"));
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &json, e_rr,
+		"{\n\t\"warmup\": %"PRIu64",\n\t\"repetitions\": %"PRIu64",\n\t\"results\": [",
+		suite->warmup, suite->repetitions
+	));
+
+	//Names are static identifiers, so they don't need escaping
+
+	for (U64 i = 0; i < suite->results.length; ++i) {
+
+		const PerfResult *r = &suite->results.ptr[i];
+
+		gotoIfError3(clean, CharString_format(
+			alloc, &tmp, e_rr,
+			"%s\n\t\t{ \"group\": \"%s\", \"name\": \"%s\", \"ops\": %"PRIu64", \"repetitions\": %"PRIu64", "
+			"\"medianNs\": %f, \"p95Ns\": %f, \"minNs\": %f, \"medianNsPerOp\": %f, "
+			"\"allocations\": %f, \"allocatedBytes\": %f }",
+			i ? "," : "",
+			r->group, r->name, r->ops, r->repetitions,
+			r->medianNs, r->p95Ns, r->minNs, r->medianNs / (F64) r->ops,
+			r->allocations, r->allocBytes
+		));
+
+		gotoIfError3(clean, PerfSuite_append(&json, alloc, &tmp, e_rr));
+	}
+
+	gotoIfError3(clean, CharString_format(alloc, &tmp, e_rr, "\n\t]\n}\n"));
+	gotoIfError3(clean, PerfSuite_append(&json, alloc, &tmp, e_rr));
+
+	gotoIfError3(clean, PerfSuite_writeFile(path, json, e_rr));
+
+clean:
+	CharString_free(&json, alloc);
+	CharString_free(&tmp, alloc);
+	return s_uccess;
+}
+
+Bool PerfSuite_compareBaseline(
+	const PerfSuite *suite, const CharString *baselineCsv, F64 threshold, U64 *regressions, Error *e_rr
+) {
+
+	Bool s_uccess = true;
+
+	const Allocator *alloc = suite ? suite->alloc : NULL;
+	Buffer file = Buffer_createNull();
+	ListCharString lines = (ListCharString) { 0 };
+	ListCharString fields = (ListCharString) { 0 };
+
+	if(!suite || !regressions)
+		retError(clean, Error_nullPointer(!suite ? 0 : 3, "PerfSuite_compareBaseline()::suite and regressions are required"));
+
+	if(!(threshold >= 0))
+		retError(clean, Error_invalidParameter(2, 0, "PerfSuite_compareBaseline()::threshold has to be >= 0"));
+
+	*regressions = 0;
+
+	if(!baselineCsv || !baselineCsv->ptr)
+		retError(clean, Error_nullPointer(1, "PerfSuite_compareBaseline()::baselineCsv is required"));
+
+	gotoIfError3(clean, Perf_readFile(*baselineCsv, alloc, &file, e_rr));
+
+	if(!Buffer_length(file))
+		retError(clean, Error_invalidState(0, "PerfSuite_compareBaseline() baseline is empty"));
+
+	const CharString str = CharString_createRefSizedConst((const C8*) file.ptr, Buffer_length(file), false);
+	gotoIfError3(clean, CharString_splitLine(str, alloc, &lines, e_rr));
+
+	for (U64 i = 1; i < lines.length; ++i) {        //Skip header
+
+		if(!CharString_length(lines.ptr[i]))
+			continue;
+
+		const CharStringSplit split = (CharStringSplit) { .s = &lines.ptr[i], .allocator = alloc, .result = &fields };
+		gotoIfError3(clean, CharString_split(&split, ',', EStringCase_Sensitive, e_rr));
+
+		F64 baseMedian = 0, baseAllocs = 0;
+
+		if(
+			fields.length < 10 ||
+			!CharString_parseDouble(fields.ptr[4], &baseMedian) ||
+			!CharString_parseDouble(fields.ptr[8], &baseAllocs)
+		)
+			retError(clean, Error_invalidParameter(1, 0, "PerfSuite_compareBaseline() baseline isn't a PerfSuite CSV"));
+
+		for (U64 j = 0; j < suite->results.length; ++j) {
+
+			const PerfResult *r = &suite->results.ptr[j];
+
+			if(
+				!CharString_equalsCStringSensitive(&fields.ptr[0], r->group) ||
+				!CharString_equalsCStringSensitive(&fields.ptr[1], r->name)
+			)
+				continue;
+
+			//Allocation counts are (almost) deterministic, so any growth past the threshold counts, even 0 -> 1
+
+			const Bool slower = r->medianNs > baseMedian * (1 + threshold);
+			const Bool allocs = r->allocations > baseAllocs * (1 + threshold) + 0.5;
+
+			if (slower || allocs) {
+
+				++*regressions;
+
+				Log_errorLn(
+					alloc,
+					"Regression in %s::%s: median %.0fns (baseline %.0fns, %+.1f%%), %.1f allocations (baseline %.1f)",
+					r->group, r->name,
+					r->medianNs, baseMedian, (r->medianNs / baseMedian - 1) * 100,
+					r->allocations, baseAllocs
+				);
+			}
+
+			break;
+		}
+
+		ListCharString_freeUnderlying(&fields, alloc);
+	}
+
+clean:
+	ListCharString_freeUnderlying(&fields, alloc);
+	ListCharString_freeUnderlying(&lines, alloc);
+	Buffer_free(&file, alloc);
+	return s_uccess;
+}
+
+void PerfSuite_free(PerfSuite *suite) {
+
+	if(!suite)
+		return;
+
+	ListPerfResult_free(&suite->results, suite->alloc);
+}
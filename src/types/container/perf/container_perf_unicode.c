@@ -0,0 +1,198 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/perf/container_perf_unicode.c
+
+#include "types/base/time.h"
+#include "types/base/string_read_helper.h"
+#include "types/container/perf/container_perf.h"
+#include "types/container/list_basic_types.h"
+#include "types/container/string.h"
+#include "types/container/string_unicode.h"
+#include "types/container/buffer.h"
+#include "types/container/log.h"
+
+#define PerfUnicode_bytes (8 << 20)
+
+typedef enum EPerfUnicode {
+	EPerfUnicode_ReadAsUTF8,        //Buffer_readAsUTF8 per code point, what validation used to be
+	EPerfUnicode_Validate,          //CharString_unicodeCodepoints
+	EPerfUnicode_IsUTF8,            //Buffer_isUTF8
+	EPerfUnicode_ToUTF16,
+	EPerfUnicode_ToUTF32,
+	EPerfUnicode_FromUTF16,         //createFromUTF16 of the toUTF16 result
+	EPerfUnicode_Count
+} EPerfUnicode;
+
+static const C8 *unicodeNames[] = {
+	"readAsUTF8", "unicodeCodepoints", "isUTF8", "toUTF16", "toUTF32", "createFromUTF16"
+};
+
+//ASCII only, mostly ASCII with some accents and symbols (like source code or European text), and mostly 3 and 4
+// byte code points (CJK with emoji), since the ASCII runs are what the fast paths skip.
+
+static const C8 *inputNames[] = { "Ascii", "Latin", "Cjk" };
+
+static void PerfUnicode_fill(C8 *text, U64 n, U64 input) {
+
+	static const C8 *latin[] = { "plain ", "words ", "caf\xC3\xA9 ", "na\xC3\xAFve ", "\xE2\x82\xAC" "5 ", "text\n" };
+	static const C8 *cjk[] = { "\xE6\x96\x87", "\xE5\xAD\x97", "\xE3\x81\x82", "\xF0\x9F\x98\x80", " ", "\xE8\xAA\x9E" };
+
+	U64 rng = 0x2545F4914F6CDD1D;
+
+	for (U64 i = 0; i < n; ) {
+
+		rng ^= rng << 13;
+		rng ^= rng >> 7;
+		rng ^= rng << 17;
+
+		const C8 *word = !input ? "ascii " : (input == 1 ? latin[rng % 6] : cjk[rng % 6]);
+		const U64 len = CharString_calcStrLen(word, 16);
+
+		//Pad with spaces rather than cut a code point in half
+
+		if (i + len > n) {
+			for(; i < n; ++i)
+				text[i] = ' ';
+			break;
+		}
+
+		for(U64 j = 0; j < len; ++j)
+			text[i++] = word[j];
+	}
+}
+
+//GB/s (of UTF-8 input) of the unicode validation and transcoding functions on 8 MiB of text.
+
+Bool Perf_unicode(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	CharString text   = CharString_createNull();
+	CharString back   = CharString_createNull();
+	CharString csv    = CharString_createNull();
+	CharString tmpStr = CharString_createNull();
+
+	ListU16 utf16 = (ListU16) { 0 };
+	ListU32 utf32 = (ListU32) { 0 };
+
+	gotoIfError3(clean, CharString_format(
+		alloc, &csv, e_rr,
+		"%s,%s,%s,%s,%s\n",
+		"Function", "Input", "Bytes", "Seconds", "GB/s"
+	));
+
+	gotoIfError3(clean, CharString_create(' ', PerfUnicode_bytes, alloc, &text, e_rr));
+
+	for (U64 input = 0; input < sizeof(inputNames) / sizeof(inputNames[0]); ++input) {
+
+		PerfUnicode_fill(text.ptrNonConst, PerfUnicode_bytes, input);
+
+		const Buffer buf = CharString_bufferConst(text);
+
+		for (U64 func = 0; func < EPerfUnicode_Count; ++func) {
+
+			if (func == EPerfUnicode_FromUTF16)
+				gotoIfError3(clean, CharString_toUTF16(text, alloc, &utf16, e_rr));
+
+			U64 result = 0;
+			const Ns start = Time_now();
+
+			switch (func) {
+
+				case EPerfUnicode_ReadAsUTF8:
+
+					for (U64 i = 0; i < PerfUnicode_bytes; ++result) {
+						UnicodeCodePointInfo info = (UnicodeCodePointInfo) { 0 };
+						gotoIfError3(clean, Buffer_readAsUTF8(buf, i, &info, e_rr));
+						i += info.bytes;
+					}
+
+					break;
+
+				case EPerfUnicode_Validate:
+					result = CharString_unicodeCodepoints(text);
+					break;
+
+				case EPerfUnicode_IsUTF8:
+					result = Buffer_isUTF8(buf, 1);
+					break;
+
+				case EPerfUnicode_ToUTF16:
+					gotoIfError3(clean, CharString_toUTF16(text, alloc, &utf16, e_rr));
+					result = utf16.length;
+					break;
+
+				case EPerfUnicode_ToUTF32:
+					gotoIfError3(clean, CharString_toUTF32(text, alloc, &utf32, e_rr));
+					result = utf32.length;
+					break;
+
+				default:
+					gotoIfError3(clean, CharString_createFromUTF16(utf16.ptr, utf16.length, alloc, &back, e_rr));
+					result = CharString_length(back);
+					break;
+			}
+
+			const DNs diff = Time_elapsed(start);
+			const F64 seconds = (F64)diff / SECOND;
+
+			if(func == EPerfUnicode_FromUTF16 && !CharString_equalsStringSensitive(&back, &text))
+				retError(clean, Error_invalidState(0, "Perf_unicode() UTF16 round trip didn't match"));
+
+			ListU16_free(&utf16, alloc);
+			ListU32_free(&utf32, alloc);
+			CharString_free(&back, alloc);
+
+			if (logToConsole)
+				Log_debugLn(
+					alloc,
+					"%s on %s (%"PRIu64" bytes): %fs (%f GB/s, result %"PRIu64")",
+					unicodeNames[func], inputNames[input], (U64) PerfUnicode_bytes,
+					seconds, PerfUnicode_bytes / seconds / 1e9, result
+				);
+
+			gotoIfError3(clean, CharString_format(
+				alloc, &tmpStr, e_rr,
+				"%s%s,%s,%"PRIu64",%f,%f\n",
+				csv.ptr ? csv.ptr : "",
+				unicodeNames[func], inputNames[input], (U64) PerfUnicode_bytes,
+				seconds,
+				PerfUnicode_bytes / seconds / 1e9
+			));
+
+			CharString_free(&csv, alloc);
+			csv    = tmpStr;
+			tmpStr = CharString_createNull();
+		}
+	}
+
+	if (outputCsv)
+		gotoIfError3(clean, Perf_writeCsv(*outputCsv, csv, e_rr));
+
+clean:
+	ListU16_free(&utf16, alloc);
+	ListU32_free(&utf32, alloc);
+	CharString_free(&text,   alloc);
+	CharString_free(&back,   alloc);
+	CharString_free(&csv,    alloc);
+	CharString_free(&tmpStr, alloc);
+	return s_uccess;
+}
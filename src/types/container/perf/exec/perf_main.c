@@ -25,13 +25,19 @@
 #include "types/base/atomic.h"
 #include "types/base/buffer_base.h"
 #include "types/base/string_base.h"
+#include "types/base/string_read_helper.h"
+#include "types/base/string_read.h"
 #include "types/container/perf/container_perf.h"
+#include "types/container/log.h"
 
 #include <stdlib.h>
 
 static AtomicI64 allocCounter = { 0 };
 static AtomicI64 allocBytes = { 0 };
 
+static AtomicI64 allocTotal = { 0 };             //Never decremented, PerfSuite takes the difference
+static AtomicI64 allocTotalBytes = { 0 };
+
 Bool ourAlloc(void *allocator, U64 length, Buffer *output, Error *e_rr) {
 
 	Bool s_uccess = true;
@@ -49,6 +55,8 @@ Bool ourAlloc(void *allocator, U64 length, Buffer *output, Error *e_rr) {
 	*output = Buffer_createManagedPtr(ptr, length);
 	AtomicI64_inc(&allocCounter);
 	AtomicI64_add(&allocBytes, (I64)length);
+	AtomicI64_inc(&allocTotal);
+	AtomicI64_add(&allocTotalBytes, (I64)length);
 
 clean:
 	return s_uccess;
@@ -61,7 +69,90 @@ void ourFree(void *allocator, Buffer buf) {
 	AtomicI64_sub(&allocBytes, (I64)Buffer_length(buf));
 }
 
-int main() {
+static void ourAllocStats(U64 *allocations, U64 *bytes) {
+	*allocations = (U64) AtomicI64_load(&allocTotal);
+	*bytes = (U64) AtomicI64_load(&allocTotalBytes);
+}
+
+//Options of the micro suite (see main)
+
+static U64 microWarmup = 3;
+static U64 microRepetitions = 15;
+static F64 microThreshold = 0.1;
+static const C8 *microCsv;
+static const C8 *microJson;
+static const C8 *microBaseline;
+
+static Bool Perf_microSuite(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	PerfSuite suite = (PerfSuite) {
+		.alloc = alloc,
+		.allocStats = ourAllocStats,
+		.warmup = microWarmup,
+		.repetitions = microRepetitions,
+		.logToConsole = logToConsole
+	};
+
+	gotoIfError3(clean, Perf_micro(&suite, e_rr));
+
+	const CharString csv = microCsv ? CharString_createRefCStrConst(microCsv) : *outputCsv;
+	gotoIfError3(clean, PerfSuite_writeCsv(&suite, &csv, e_rr));
+
+	if (microJson) {
+		const CharString json = CharString_createRefCStrConst(microJson);
+		gotoIfError3(clean, PerfSuite_writeJson(&suite, &json, e_rr));
+	}
+
+	if (microBaseline) {
+
+		const CharString baseline = CharString_createRefCStrConst(microBaseline);
+		U64 regressions = 0;
+		gotoIfError3(clean, PerfSuite_compareBaseline(&suite, &baseline, microThreshold, &regressions, e_rr));
+
+		if(regressions)
+			retError(clean, Error_invalidState(0, "Perf_microSuite() benchmarks regressed against the baseline"));
+	}
+
+clean:
+	PerfSuite_free(&suite);
+	return s_uccess;
+}
+
+typedef Bool (*PerfFunc)(const Allocator *alloc, const CharString *outputCsv, Bool logToConsole, Error *e_rr);
+
+typedef struct PerfEntry {
+	const C8 *name;
+	const C8 *outputCsv;
+	PerfFunc func;
+} PerfEntry;
+
+static const PerfEntry perfEntries[] = {
+	{ "aes", "test.csv", Perf_aesThroughput },
+	{ "bigInt", "big_int.csv", Perf_bigInt },
+	{ "compress", "compress.csv", Perf_compress },
+	{ "encryptionStream", "encryption_stream.csv", Perf_encryptionStream },
+	{ "hashMap", "hash_map.csv", Perf_hashMap },
+	{ "jobQueue", "job_queue.csv", Perf_jobQueue },
+	{ "lock", "lock.csv", Perf_lock },
+	{ "micro", "micro.csv", Perf_microSuite },
+	{ "poolAllocator", "pool_allocator.csv", Perf_poolAllocator },
+	{ "ringQueue", "ring_queue.csv", Perf_ringQueue },
+	{ "sha256", "sha256.csv", Perf_sha256 },
+	{ "sort", "sort.csv", Perf_sort },
+	{ "stream", "stream.csv", Perf_stream },
+	{ "stringSearch", "string_search.csv", Perf_stringSearch },
+	{ "unicode", "unicode.csv", Perf_unicode }
+};
+
+//No arguments runs everything, otherwise only the perf tests that were named (e.g. OxC3_types_container_perf hashMap).
+//Options (for micro):
+//  --warmup N and --reps N: repetitions to skip and to measure (3 and 15 by default).
+//  --csv path and --json path: where to write the results (micro.csv by default, JSON is optional).
+//  --baseline path: CSV of an earlier run; exits with an error if anything regressed by more than --threshold F (0.1).
+
+int main(int argc, const char *argv[]) {
 
 	const Allocator alloc = (Allocator){
 		.alloc = ourAlloc,
@@ -71,11 +162,78 @@ int main() {
 
 	Bool s_uccess = true;
 	Error err = Error_none();
+	Error *e_rr = &err;
+	Bool anyFilter = false;
 
-	const CharString outputCsv = CharString_createRefCStrConst("test.csv");
+	for (int j = 1; j < argc; ++j) {
 
-	gotoIfError3(clean, Perf_aesThroughput(&alloc, &outputCsv, true, &err));
+		const CharString arg = CharString_createRefCStrConst(argv[j]);
+
+		if (!CharString_startsWithCStringSensitive(&arg, "--", 0)) {
+			anyFilter = true;
+			continue;
+		}
+
+		if(j + 1 >= argc)
+			retError(clean, Error_invalidParameter(0, 0, "main() option is missing its value"));
+
+		const C8 *value = argv[++j];
+		const CharString valueStr = CharString_createRefCStrConst(value);
+
+		if (CharString_equalsCStringSensitive(&arg, "--warmup")) {
+			if(!CharString_parseU64(valueStr, &microWarmup))
+				retError(clean, Error_invalidParameter(0, 1, "main() --warmup expects an integer"));
+		}
+
+		else if (CharString_equalsCStringSensitive(&arg, "--reps")) {
+			if(!CharString_parseU64(valueStr, &microRepetitions) || !microRepetitions)
+				retError(clean, Error_invalidParameter(0, 2, "main() --reps expects an integer > 0"));
+		}
+
+		else if (CharString_equalsCStringSensitive(&arg, "--threshold")) {
+			if(!CharString_parseDouble(valueStr, &microThreshold) || microThreshold < 0)
+				retError(clean, Error_invalidParameter(0, 3, "main() --threshold expects a number >= 0"));
+		}
+
+		else if(CharString_equalsCStringSensitive(&arg, "--csv"))
+			microCsv = value;
+
+		else if(CharString_equalsCStringSensitive(&arg, "--json"))
+			microJson = value;
+
+		else if(CharString_equalsCStringSensitive(&arg, "--baseline"))
+			microBaseline = value;
+
+		else retError(clean, Error_invalidParameter(0, 4, "main() unknown option"));
+	}
+
+	for (U64 i = 0; i < sizeof(perfEntries) / sizeof(perfEntries[0]); ++i) {
+
+		Bool enabled = !anyFilter;
+
+		for (int j = 1; j < argc && !enabled; ++j) {
+
+			const CharString arg = CharString_createRefCStrConst(argv[j]);
+
+			if (CharString_startsWithCStringSensitive(&arg, "--", 0)) {
+				++j;
+				continue;
+			}
+
+			enabled = CharString_equalsCStringInsensitive(&arg, perfEntries[i].name);
+		}
+
+		if(!enabled)
+			continue;
+
+		const CharString outputCsv = CharString_createRefCStrConst(perfEntries[i].outputCsv);
+		gotoIfError3(clean, perfEntries[i].func(&alloc, &outputCsv, true, e_rr));
+	}
 
 clean:
+
+	if(!s_uccess)
+		Error_print(&alloc, &err, ELogLevel_Error, ELogOptions_NewLine);
+
 	return !s_uccess;
 }
@@ -0,0 +1,344 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/pool_allocator.c
+
+#include "types/container/pool_allocator.h"
+#include "types/container/buffer.h"
+#include "types/base/error.h"
+
+static const U16 PoolAllocator_classSizes[PoolAllocator_classCount] = {
+	16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096
+};
+
+//Slabs start with a pointer to the previous slab, blocks start after that (keeping 16 byte alignment)
+
+static const U64 PoolAllocator_slabHeader = 16;
+
+U64 PoolAllocator_classSize(U64 classId) {
+	return classId < PoolAllocator_classCount ? PoolAllocator_classSizes[classId] : 0;
+}
+
+//Steps of 16 up to 64, after that two classes per power of two (1x and 1.5x), so at most 33% is wasted.
+
+static U64 PoolAllocator_classOf(U64 length) {
+
+	if(length <= 64)
+		return length ? (length - 1) >> 4 : 0;
+
+	U64 p = 63;
+	const U64 v = length - 1;
+
+	#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index = 0;
+		_BitScanReverse64(&index, v);
+		p = index;
+	#else
+		p -= (U64) __builtin_clzll(v);
+	#endif
+
+	return 4 + (p - 6) * 2 + (length > ((U64)3 << (p - 1)));
+}
+
+//Carves a new slab into the depot's free list; depot lock has to be held
+
+static Bool PoolAllocator_carveSlab(PoolAllocator *pool, U64 classId, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Buffer slab = Buffer_createNull();
+	PoolAllocatorDepot *depot = &pool->depots[classId];
+	const U64 blockSize = PoolAllocator_classSizes[classId];
+
+	gotoIfError3(clean, Buffer_createUninitializedBytes(PoolAllocator_slabSize, pool->parent, &slab, e_rr));
+
+	U8 *base = slab.ptrNonConst;
+	*(void**) base = depot->slabs;
+	depot->slabs = base;
+	++depot->slabCount;
+
+	//Pushed back to front, so the free list hands out blocks in address order
+
+	const U64 blocks = (PoolAllocator_slabSize - PoolAllocator_slabHeader) / blockSize;
+
+	for (U64 i = blocks; i > 0; --i) {
+		void *block = base + PoolAllocator_slabHeader + (i - 1) * blockSize;
+		*(void**) block = depot->freeList;
+		depot->freeList = block;
+	}
+
+	depot->freeCount += blocks;
+
+clean:
+	return s_uccess;
+}
+
+static Bool PoolAllocator_refill(
+	PoolAllocator *pool, U64 classId, PoolAllocatorThread *ctx, Error *e_rr
+) {
+
+	Bool s_uccess = true;
+	PoolAllocatorDepot *depot = &pool->depots[classId];
+	PoolMagazine *mag = &ctx->magazines[classId];
+
+	const ELockAcquire acq = SpinLock_lock(&depot->lock, U64_MAX);
+
+	if(acq < ELockAcquire_Success)
+		retError(clean, Error_invalidState(0, "PoolAllocator_refill() couldn't acquire depot lock"));
+
+	if(!depot->freeCount)
+		gotoIfError3(clean, PoolAllocator_carveSlab(pool, classId, e_rr));
+
+	while (mag->count < PoolAllocator_magazineSize / 2 && depot->freeList) {
+		void *block = depot->freeList;
+		depot->freeList = *(void**) block;
+		mag->blocks[mag->count++] = block;
+		--depot->freeCount;
+	}
+
+	++ctx->stats[classId].refills;
+
+clean:
+	if(acq == ELockAcquire_Acquired)
+		SpinLock_unlock(&depot->lock);
+
+	return s_uccess;
+}
+
+//Magazine is full, hand the older half to the depot so the hot (recently freed) blocks stay local
+
+static void PoolAllocator_flush(PoolAllocator *pool, U64 classId, PoolAllocatorThread *ctx) {
+
+	PoolAllocatorDepot *depot = &pool->depots[classId];
+	PoolMagazine *mag = &ctx->magazines[classId];
+
+	const ELockAcquire acq = SpinLock_lock(&depot->lock, U64_MAX);
+
+	if(acq < ELockAcquire_Success)
+		return;
+
+	const U64 half = PoolAllocator_magazineSize / 2;
+
+	for (U64 i = 0; i < half; ++i) {
+		void *block = mag->blocks[i];
+		*(void**) block = depot->freeList;
+		depot->freeList = block;
+	}
+
+	depot->freeCount += half;
+
+	if(acq == ELockAcquire_Acquired)
+		SpinLock_unlock(&depot->lock);
+
+	for(U64 i = half; i < mag->count; ++i)
+		mag->blocks[i - half] = mag->blocks[i];
+
+	mag->count -= half;
+	++ctx->stats[classId].flushes;
+}
+
+static Bool PoolAllocator_allocFrom(PoolAllocatorThread *ctx, U64 length, Buffer *output, Error *e_rr) {
+
+	Bool s_uccess = true;
+	PoolAllocator *pool = ctx->pool;
+
+	if(!output)
+		retError(clean, Error_nullPointer(2, "PoolAllocator_alloc()::output is required"));
+
+	if (length > PoolAllocator_maxSize) {
+		gotoIfError3(clean, pool->parent->alloc(pool->parent->ptr, length, output, e_rr));
+		++ctx->stats[PoolAllocator_classCount].allocations;
+		goto clean;
+	}
+
+	if(!length)
+		retError(clean, Error_invalidParameter(1, 0, "PoolAllocator_alloc()::length is required"));
+
+	const U64 classId = PoolAllocator_classOf(length);
+	PoolMagazine *mag = &ctx->magazines[classId];
+
+	if(!mag->count)
+		gotoIfError3(clean, PoolAllocator_refill(pool, classId, ctx, e_rr));
+
+	*output = Buffer_createManagedPtr(mag->blocks[--mag->count], length);
+	++ctx->stats[classId].allocations;
+
+clean:
+	return s_uccess;
+}
+
+static void PoolAllocator_freeFrom(PoolAllocatorThread *ctx, Buffer buf) {
+
+	PoolAllocator *pool = ctx->pool;
+	const U64 length = Buffer_length(buf);
+
+	if (length > PoolAllocator_maxSize) {
+		pool->parent->free(pool->parent->ptr, buf);
+		++ctx->stats[PoolAllocator_classCount].frees;
+		return;
+	}
+
+	if(!length || !buf.ptr)
+		return;
+
+	const U64 classId = PoolAllocator_classOf(length);
+	PoolMagazine *mag = &ctx->magazines[classId];
+
+	if(mag->count == PoolAllocator_magazineSize)
+		PoolAllocator_flush(pool, classId, ctx);
+
+	mag->blocks[mag->count++] = buf.ptrNonConst;
+	++ctx->stats[classId].frees;
+}
+
+static Bool PoolAllocator_allocThread(void *allocator, U64 length, Buffer *output, Error *e_rr) {
+	return PoolAllocator_allocFrom((PoolAllocatorThread*) allocator, length, output, e_rr);
+}
+
+static void PoolAllocator_freeThread(void *allocator, Buffer buf) {
+	PoolAllocator_freeFrom((PoolAllocatorThread*) allocator, buf);
+}
+
+static Bool PoolAllocator_allocShared(void *allocator, U64 length, Buffer *output, Error *e_rr) {
+
+	Bool s_uccess = true;
+	PoolAllocator *pool = (PoolAllocator*) allocator;
+
+	const ELockAcquire acq = SpinLock_lock(&pool->sharedLock, U64_MAX);
+
+	if(acq < ELockAcquire_Success)
+		retError(clean, Error_invalidState(0, "PoolAllocator_allocShared() couldn't acquire lock"));
+
+	gotoIfError3(clean, PoolAllocator_allocFrom(&pool->threads[pool->threadCount], length, output, e_rr));
+
+clean:
+	if(acq == ELockAcquire_Acquired)
+		SpinLock_unlock(&pool->sharedLock);
+
+	return s_uccess;
+}
+
+static void PoolAllocator_freeShared(void *allocator, Buffer buf) {
+
+	PoolAllocator *pool = (PoolAllocator*) allocator;
+	const ELockAcquire acq = SpinLock_lock(&pool->sharedLock, U64_MAX);
+
+	if(acq < ELockAcquire_Success)
+		return;
+
+	PoolAllocator_freeFrom(&pool->threads[pool->threadCount], buf);
+
+	if(acq == ELockAcquire_Acquired)
+		SpinLock_unlock(&pool->sharedLock);
+}
+
+Bool PoolAllocator_create(U64 threadCount, const Allocator *parent, PoolAllocator *result, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Buffer threads = Buffer_createNull();
+
+	if(!parent || !result)
+		retError(clean, Error_nullPointer(!parent ? 1 : 2, "PoolAllocator_create()::parent and result are required"));
+
+	if(result->threads)
+		retError(clean, Error_invalidParameter(2, 0, "PoolAllocator_create()::result wasn't empty, could indicate memleak"));
+
+	if(threadCount >= U32_MAX)
+		retError(clean, Error_outOfBounds(0, threadCount, U32_MAX, "PoolAllocator_create()::threadCount is out of bounds"));
+
+	gotoIfError3(clean, Buffer_createEmptyBytes(
+		sizeof(PoolAllocatorThread) * (threadCount + 1), parent, &threads, e_rr
+	));
+
+	*result = (PoolAllocator) {
+		.allocator = (Allocator) { .ptr = result, .alloc = PoolAllocator_allocShared, .free = PoolAllocator_freeShared },
+		.parent = parent,
+		.threads = (PoolAllocatorThread*) threads.ptrNonConst,
+		.threadCount = threadCount
+	};
+
+	for (U64 i = 0; i <= threadCount; ++i) {
+
+		PoolAllocatorThread *ctx = &result->threads[i];
+
+		ctx->pool = result;
+		ctx->allocator = (Allocator) {
+			.ptr = ctx, .alloc = PoolAllocator_allocThread, .free = PoolAllocator_freeThread
+		};
+
+		for(U64 j = 0; j < PoolAllocator_classCount; ++j)
+			ctx->stats[j].blockSize = PoolAllocator_classSizes[j];
+	}
+
+	threads = Buffer_createNull();
+
+clean:
+	Buffer_free(&threads, parent);
+	return s_uccess;
+}
+
+void PoolAllocator_free(PoolAllocator *pool) {
+
+	if(!pool || !pool->threads)
+		return;
+
+	for (U64 i = 0; i < PoolAllocator_classCount; ++i) {
+
+		void *slab = pool->depots[i].slabs;
+
+		while (slab) {
+			void *prev = *(void**) slab;
+			Buffer buf = Buffer_createManagedPtr(slab, PoolAllocator_slabSize);
+			Buffer_free(&buf, pool->parent);
+			slab = prev;
+		}
+	}
+
+	Buffer threads = Buffer_createManagedPtr(pool->threads, sizeof(PoolAllocatorThread) * (pool->threadCount + 1));
+	Buffer_free(&threads, pool->parent);
+
+	*pool = (PoolAllocator) { 0 };
+}
+
+const Allocator *PoolAllocator_thread(const PoolAllocator *pool, U64 threadId) {
+	return pool && threadId < pool->threadCount ? &pool->threads[threadId].allocator : NULL;
+}
+
+void PoolAllocator_getStats(const PoolAllocator *pool, PoolAllocatorStats *stats) {
+
+	if(!pool || !stats || !pool->threads)
+		return;
+
+	for (U64 i = 0; i <= PoolAllocator_classCount; ++i) {
+
+		PoolAllocatorStats *dst = &stats[i];
+		*dst = (PoolAllocatorStats) { .blockSize = PoolAllocator_classSize(i) };
+
+		for (U64 j = 0; j <= pool->threadCount; ++j) {
+			const PoolAllocatorStats *src = &pool->threads[j].stats[i];
+			dst->allocations += src->allocations;
+			dst->frees += src->frees;
+			dst->refills += src->refills;
+			dst->flushes += src->flushes;
+		}
+
+		if(i < PoolAllocator_classCount)
+			dst->slabs = pool->depots[i].slabCount;
+	}
+}
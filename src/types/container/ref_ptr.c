@@ -22,6 +22,8 @@
 
 #include "types/container/list_impl.h"
 #include "types/container/ref_ptr.h"
+#include "types/base/lock.h"
+#include <stdalign.h>
 
 TListNamedImpl(ListRefPtr);
 TListNamedImpl(ListWeakRefPtr);
@@ -64,13 +66,166 @@ clean:
 	return s_uccess;
 }
 
+//Retired RefPtrs are linked through their own refCount (which nothing needs anymore), in one list per thread.
+//Threads are spread over the lists of a domain round robin, so unless there are more threads than lists every thread
+// has one of its own and a retire only contends with a collect swapping the list out.
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define RefPtr_threadLocal __declspec(thread)
+#else
+	#define RefPtr_threadLocal _Thread_local
+#endif
+
+static RefPtrRetireDomain RefPtr_processDomain;
+static AtomicI64 RefPtr_nextRetireList;
+static RefPtr_threadLocal U64 RefPtr_retireListId;      //1 + index, 0 if the thread didn't retire anything yet
+
+//Registered domains, only locked to (un)register and to take their lists, never while freeing.
+//A free can release the owner of a domain (a retired resource holding the last device reference), which unregisters.
+
+static SpinLock RefPtr_domainLock;
+static RefPtrRetireDomain *RefPtr_domains;
+
+static inline I64 RefPtr_encodeRetired(RefPtr *next) { return I64_MIN | (I64)(U64)(uintptr_t)next; }
+static inline RefPtr *RefPtr_decodeRetired(I64 v) { return (RefPtr*)(uintptr_t)(U64)(v &~ I64_MIN); }
+
+static RefPtrRetireDomain *RefPtr_getRetireDomain(RefPtr *ptr) {
+
+	RefPtrRetireDomain *domain = NULL;
+
+	if(ptr->refPtrType->retireDomain)
+		domain = ptr->refPtrType->retireDomain(RefPtr_data(ptr, void));
+
+	return domain ? domain : &RefPtr_processDomain;
+}
+
+//Pushes first .. last (already linked to each other) onto the list of this thread in domain
+
+static void RefPtr_retire(RefPtrRetireDomain *domain, RefPtr *first, RefPtr *last) {
+
+	if(!RefPtr_retireListId)
+		RefPtr_retireListId = 1 + (U64)(AtomicI64_inc(&RefPtr_nextRetireList) - 1) % RefPtr_retireListCount;
+
+	AtomicI64 *head = &domain->lists[RefPtr_retireListId - 1].head;
+	I64 prev = AtomicI64_load(head);
+
+	while (true) {
+
+		AtomicI64_store(&last->refCount, RefPtr_encodeRetired((RefPtr*)(uintptr_t)(U64) prev));
+
+		const I64 found = AtomicI64_cmpStore(head, prev, (I64)(U64)(uintptr_t) first);
+
+		if(found == prev)
+			break;
+
+		prev = found;
+	}
+}
+
+void RefPtrRetireDomain_create(RefPtrRetireDomain *domain) {
+
+	if(!domain)
+		return;
+
+	*domain = (RefPtrRetireDomain) { 0 };
+
+	const ELockAcquire acq = SpinLock_lock(&RefPtr_domainLock, U64_MAX);
+
+	if((domain->next = RefPtr_domains))
+		RefPtr_domains->prev = domain;
+
+	RefPtr_domains = domain;
+
+	if(acq == ELockAcquire_Acquired)
+		SpinLock_unlock(&RefPtr_domainLock);
+}
+
+void RefPtrRetireDomain_free(RefPtrRetireDomain *domain) {
+
+	if(!domain)
+		return;
+
+	RefPtr_collectDomain(domain);
+
+	const ELockAcquire acq = SpinLock_lock(&RefPtr_domainLock, U64_MAX);
+
+	if(domain->prev)
+		domain->prev->next = domain->next;
+
+	else if(RefPtr_domains == domain)
+		RefPtr_domains = domain->next;
+
+	if(domain->next)
+		domain->next->prev = domain->prev;
+
+	domain->prev = domain->next = NULL;
+
+	if(acq == ELockAcquire_Acquired)
+		SpinLock_unlock(&RefPtr_domainLock);
+}
+
+static void RefPtr_free(RefPtr *ptr) {
+
+	//freeInvoke first: a wrapper registers that one precisely because its own callback can't carry the
+	// Allocator type (see ObjectFreeInvoke).
+
+	if(ptr->refPtrType->freeInvoke)
+		ptr->refPtrType->freeInvoke(RefPtr_data(ptr, void), ptr->refPtrType->alloc);
+
+	else if(ptr->refPtrType->free)
+		ptr->refPtrType->free(RefPtr_data(ptr, void), ptr->refPtrType->alloc);
+
+	const RefPtrType *type = ptr->refPtrType;
+	Buffer orig = Buffer_createManagedPtr(ptr, sizeof(*ptr) + RefPtrType_length(type));
+
+	//The Buffer that carried the aligned bit went away when only the pointer was kept, so it has to be put
+	// back before freeing, or Buffer_free hands the allocator the payload instead of the real base.
+
+	if(RefPtrType_alignment(type) > BUFFER_DEFAULT_ALIGNMENT)
+		Buffer_markAligned(&orig);
+
+	Buffer_free(&orig, type->alloc);
+}
+
 Bool RefPtr_inc(RefPtr *ptr) {
 
 	if(!ptr || !ptr->refPtrType)
 		return false;
 
-	AtomicI64_inc(&ptr->refCount);
-	return true;
+	if (!(ptr->refPtrType->flags & ERefPtrFlags_DeferRelease)) {
+		AtomicI64_inc(&ptr->refCount);
+		return true;
+	}
+
+	//A retired one can't come back, its refCount is the link to the next retired RefPtr
+
+	I64 refCount = AtomicI64_load(&ptr->refCount);
+
+	while (refCount > 0) {
+
+		const I64 found = AtomicI64_cmpStore(&ptr->refCount, refCount, refCount + 1);
+
+		if(found == refCount)
+			return true;
+
+		refCount = found;
+	}
+
+	return false;
+}
+
+Bool RefPtr_incMany(RefPtr *const *ptrs, U64 count) {
+
+	if(!ptrs)
+		return !count;
+
+	Bool ok = true;
+
+	for(U64 i = 0; i < count; ++i)
+		if(ptrs[i])
+			ok &= RefPtr_inc(ptrs[i]);
+
+	return ok;
 }
 
 void RefPtr_dec(RefPtr **pptr) {
@@ -80,28 +235,133 @@ void RefPtr_dec(RefPtr **pptr) {
 
 	RefPtr *ptr = *pptr;
 
-	if(!AtomicI64_dec(&ptr->refCount)) {
+	if (!AtomicI64_dec(&ptr->refCount)) {
 
-		//freeInvoke first: a wrapper registers that one precisely because its own callback can't carry the
-		// Allocator type (see ObjectFreeInvoke).
+		if(ptr->refPtrType->flags & ERefPtrFlags_DeferRelease)
+			RefPtr_retire(RefPtr_getRetireDomain(ptr), ptr, ptr);
 
-		if(ptr->refPtrType->freeInvoke)
-			ptr->refPtrType->freeInvoke(RefPtr_data(ptr, void), ptr->refPtrType->alloc);
+		else RefPtr_free(ptr);
+	}
+
+	*pptr = NULL;
+}
+
+void RefPtr_decMany(RefPtr **ptrs, U64 count) {
+
+	if(!ptrs)
+		return;
 
-		else if(ptr->refPtrType->free)
-			ptr->refPtrType->free(RefPtr_data(ptr, void), ptr->refPtrType->alloc);
+	//The released deferred ones are linked up front, so they take one push instead of one each.
+	//That's one push per run of the same domain, which is one in total for a list that belongs to a single owner.
 
-		const RefPtrType *type = ptr->refPtrType;
-		Buffer orig = Buffer_createManagedPtr(ptr, sizeof(*ptr) + RefPtrType_length(type));
+	RefPtr *first = NULL, *last = NULL;
+	RefPtrRetireDomain *domain = NULL;
 
-		//The Buffer that carried the aligned bit went away when only the pointer was kept, so it has to be put
-		// back before freeing, or Buffer_free hands the allocator the payload instead of the real base.
+	for (U64 i = 0; i < count; ++i) {
 
-		if(RefPtrType_alignment(type) > BUFFER_DEFAULT_ALIGNMENT)
-			Buffer_markAligned(&orig);
+		RefPtr *ptr = ptrs[i];
+		ptrs[i] = NULL;
 
-		Buffer_free(&orig, type->alloc);
+		if(!ptr || AtomicI64_dec(&ptr->refCount))
+			continue;
+
+		if (!(ptr->refPtrType->flags & ERefPtrFlags_DeferRelease)) {
+			RefPtr_free(ptr);
+			continue;
+		}
+
+		RefPtrRetireDomain *ptrDomain = RefPtr_getRetireDomain(ptr);
+
+		if (first && ptrDomain != domain) {
+			RefPtr_retire(domain, first, last);
+			first = NULL;
+		}
+
+		domain = ptrDomain;
+		AtomicI64_store(&ptr->refCount, RefPtr_encodeRetired(first));
+
+		if(!first)
+			last = ptr;
+
+		first = ptr;
 	}
 
-	*pptr = NULL;
+	if(first)
+		RefPtr_retire(domain, first, last);
+}
+
+//Takes every list of domain and puts them in front of chain, without freeing anything
+
+static RefPtr *RefPtr_takeDomain(RefPtrRetireDomain *domain, RefPtr *chain) {
+
+	for (U64 i = 0; i < RefPtr_retireListCount; ++i) {
+
+		if(!AtomicI64_load(&domain->lists[i].head))
+			continue;
+
+		RefPtr *first = (RefPtr*)(uintptr_t)(U64) AtomicI64_store(&domain->lists[i].head, 0);
+		RefPtr *last = first;
+
+		for(RefPtr *next; (next = RefPtr_decodeRetired(AtomicI64_load(&last->refCount))); )
+			last = next;
+
+		AtomicI64_store(&last->refCount, RefPtr_encodeRetired(chain));
+		chain = first;
+	}
+
+	return chain;
+}
+
+static U64 RefPtr_freeChain(RefPtr *ptr) {
+
+	U64 freed = 0;
+
+	while (ptr) {
+		RefPtr *next = RefPtr_decodeRetired(AtomicI64_load(&ptr->refCount));
+		RefPtr_free(ptr);
+		ptr = next;
+		++freed;
+	}
+
+	return freed;
+}
+
+//Frees can retire more (an object dropping the last reference to another), so both keep going until it's quiet
+
+U64 RefPtr_collectDomain(RefPtrRetireDomain *domain) {
+
+	U64 freed = 0;
+
+	if(!domain)
+		return freed;
+
+	for(RefPtr *chain; (chain = RefPtr_takeDomain(domain, NULL)); )
+		freed += RefPtr_freeChain(chain);
+
+	return freed;
+}
+
+U64 RefPtr_collect() {
+
+	U64 freed = 0;
+
+	while (true) {
+
+		RefPtr *chain = RefPtr_takeDomain(&RefPtr_processDomain, NULL);
+
+		const ELockAcquire acq = SpinLock_lock(&RefPtr_domainLock, U64_MAX);
+
+		for(RefPtrRetireDomain *domain = RefPtr_domains; domain; domain = domain->next)
+			chain = RefPtr_takeDomain(domain, chain);
+
+		if(acq == ELockAcquire_Acquired)
+			SpinLock_unlock(&RefPtr_domainLock);
+
+		if(!chain)
+			break;
+
+		freed += RefPtr_freeChain(chain);
+	}
+
+	return freed;
 }
@@ -0,0 +1,268 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/ring_queue.c
+
+#include "types/container/ring_queue.h"
+#include "types/container/buffer.h"
+#include "types/base/allocator.h"
+#include "types/base/error.h"
+
+static const U64 RingQueue_maxCapacity = (U64)1 << 40;
+
+static Bool RingQueue_capacity(U64 capacity, U64 stride, U64 *result, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(!stride)
+		retError(clean, Error_invalidParameter(1, 0, "RingQueue_capacity()::stride is required"));
+
+	if(capacity > RingQueue_maxCapacity)
+		retError(clean, Error_outOfBounds(0, capacity, RingQueue_maxCapacity, "RingQueue_capacity()::capacity is too big"));
+
+	U64 pow2 = 2;
+
+	while(pow2 < capacity)
+		pow2 <<= 1;
+
+	*result = pow2;
+
+clean:
+	return s_uccess;
+}
+
+//MPMC
+
+static inline AtomicI64 *MPMCQueue_cell(const MPMCQueue *queue, U64 pos) {
+	return (AtomicI64*) (queue->cells.ptrNonConst + (pos & queue->mask) * queue->cellStride);
+}
+
+Bool MPMCQueue_create(U64 capacity, U64 stride, const Allocator *alloc, MPMCQueue *queue, Error *e_rr) {
+
+	Bool s_uccess = true;
+	U64 count = 0;
+
+	if(!queue)
+		retError(clean, Error_nullPointer(3, "MPMCQueue_create()::queue is required"));
+
+	if(queue->cells.ptr)
+		retError(clean, Error_invalidParameter(3, 0, "MPMCQueue_create()::queue wasn't empty, might indicate memleak"));
+
+	gotoIfError3(clean, RingQueue_capacity(capacity, stride, &count, e_rr));
+
+	const U64 cellStride = sizeof(AtomicI64) + ((stride + 7) &~ (U64)7);
+	gotoIfError3(clean, Buffer_createUninitializedBytes(count * cellStride, alloc, &queue->cells, e_rr));
+
+	queue->mask = count - 1;
+	queue->stride = stride;
+	queue->cellStride = cellStride;
+
+	//Cell i is free for the push at position i
+
+	for(U64 i = 0; i < count; ++i)
+		AtomicI64_store(MPMCQueue_cell(queue, i), (I64) i);
+
+	AtomicI64_store(&queue->enqueuePos, 0);
+	AtomicI64_store(&queue->dequeuePos, 0);
+
+clean:
+	return s_uccess;
+}
+
+void MPMCQueue_free(MPMCQueue *queue, const Allocator *alloc) {
+
+	if(!queue)
+		return;
+
+	Buffer_free(&queue->cells, alloc);
+	*queue = (MPMCQueue) { 0 };
+}
+
+Bool MPMCQueue_push(MPMCQueue *queue, const void *element) {
+
+	if(!queue || !queue->stride || !element)
+		return false;
+
+	I64 pos = AtomicI64_load(&queue->enqueuePos);
+	AtomicI64 *cell = NULL;
+
+	while (true) {
+
+		cell = MPMCQueue_cell(queue, (U64) pos);
+		const I64 dif = AtomicI64_load(cell) - pos;
+
+		if (!dif) {                                 //Free for us, try to claim the position
+
+			const I64 prev = AtomicI64_cmpStore(&queue->enqueuePos, pos, pos + 1);
+
+			if(prev == pos)
+				break;
+
+			pos = prev;
+		}
+
+		else if(dif < 0)                            //Still holds the element of the previous round
+			return false;
+
+		else pos = AtomicI64_load(&queue->enqueuePos);          //Another producer got here first
+	}
+
+	Buffer_memcpy(Buffer_createRef(cell + 1, queue->stride), Buffer_createRefConst(element, queue->stride));
+	AtomicI64_store(cell, pos + 1);
+	return true;
+}
+
+Bool MPMCQueue_pop(MPMCQueue *queue, void *element) {
+
+	if(!queue || !queue->stride)
+		return false;
+
+	I64 pos = AtomicI64_load(&queue->dequeuePos);
+	AtomicI64 *cell = NULL;
+
+	while (true) {
+
+		cell = MPMCQueue_cell(queue, (U64) pos);
+		const I64 dif = AtomicI64_load(cell) - (pos + 1);
+
+		if (!dif) {                                 //Holds the element for this position
+
+			const I64 prev = AtomicI64_cmpStore(&queue->dequeuePos, pos, pos + 1);
+
+			if(prev == pos)
+				break;
+
+			pos = prev;
+		}
+
+		else if(dif < 0)                            //Not pushed yet
+			return false;
+
+		else pos = AtomicI64_load(&queue->dequeuePos);
+	}
+
+	if(element)
+		Buffer_memcpy(Buffer_createRef(element, queue->stride), Buffer_createRefConst(cell + 1, queue->stride));
+
+	AtomicI64_store(cell, pos + (I64) queue->mask + 1);        //Free for the push one round later
+	return true;
+}
+
+U64 MPMCQueue_length(MPMCQueue *queue) {
+
+	if(!queue)
+		return 0;
+
+	const I64 dequeued = AtomicI64_load(&queue->dequeuePos);
+	const I64 enqueued = AtomicI64_load(&queue->enqueuePos);
+	return enqueued > dequeued ? (U64) (enqueued - dequeued) : 0;
+}
+
+//SPSC
+
+Bool SPSCQueue_create(U64 capacity, U64 stride, const Allocator *alloc, SPSCQueue *queue, Error *e_rr) {
+
+	Bool s_uccess = true;
+	U64 count = 0;
+
+	if(!queue)
+		retError(clean, Error_nullPointer(3, "SPSCQueue_create()::queue is required"));
+
+	if(queue->data.ptr)
+		retError(clean, Error_invalidParameter(3, 0, "SPSCQueue_create()::queue wasn't empty, might indicate memleak"));
+
+	gotoIfError3(clean, RingQueue_capacity(capacity, stride, &count, e_rr));
+	gotoIfError3(clean, Buffer_createUninitializedBytes(count * stride, alloc, &queue->data, e_rr));
+
+	queue->mask = count - 1;
+	queue->stride = stride;
+	queue->cachedHead = queue->cachedTail = 0;
+
+	AtomicI64_store(&queue->head, 0);
+	AtomicI64_store(&queue->tail, 0);
+
+clean:
+	return s_uccess;
+}
+
+void SPSCQueue_free(SPSCQueue *queue, const Allocator *alloc) {
+
+	if(!queue)
+		return;
+
+	Buffer_free(&queue->data, alloc);
+	*queue = (SPSCQueue) { 0 };
+}
+
+Bool SPSCQueue_push(SPSCQueue *queue, const void *element) {
+
+	if(!queue || !queue->stride || !element)
+		return false;
+
+	const I64 tail = AtomicI64_load(&queue->tail);
+
+	if ((U64) (tail - queue->cachedHead) > queue->mask) {
+
+		queue->cachedHead = AtomicI64_load(&queue->head);
+
+		if((U64) (tail - queue->cachedHead) > queue->mask)
+			return false;
+	}
+
+	U8 *dst = queue->data.ptrNonConst + ((U64) tail & queue->mask) * queue->stride;
+	Buffer_memcpy(Buffer_createRef(dst, queue->stride), Buffer_createRefConst(element, queue->stride));
+
+	AtomicI64_store(&queue->tail, tail + 1);
+	return true;
+}
+
+Bool SPSCQueue_pop(SPSCQueue *queue, void *element) {
+
+	if(!queue || !queue->stride)
+		return false;
+
+	const I64 head = AtomicI64_load(&queue->head);
+
+	if (head == queue->cachedTail) {
+
+		queue->cachedTail = AtomicI64_load(&queue->tail);
+
+		if(head == queue->cachedTail)
+			return false;
+	}
+
+	if (element) {
+		const U8 *src = queue->data.ptr + ((U64) head & queue->mask) * queue->stride;
+		Buffer_memcpy(Buffer_createRef(element, queue->stride), Buffer_createRefConst(src, queue->stride));
+	}
+
+	AtomicI64_store(&queue->head, head + 1);
+	return true;
+}
+
+U64 SPSCQueue_length(SPSCQueue *queue) {
+
+	if(!queue)
+		return 0;
+
+	const I64 head = AtomicI64_load(&queue->head);
+	const I64 tail = AtomicI64_load(&queue->tail);
+	return tail > head ? (U64) (tail - head) : 0;
+}
@@ -60,7 +60,6 @@
 #define SIMD_CRC32C_U32 __crc32cw
 #define SIMD_CRC32C_U16 __crc32ch
 #define SIMD_CRC32C_U8 __crc32cb
-#define DISABLE_CRC32C_TRIPLET //TODO:
 
 #include "types/container/simd/buffer_simd_crc32c.inc.h"
 
@@ -144,3 +143,88 @@ void Buffer_sha256(const Buffer buf, U32 output[8]) {
 
 	Buffer_sha256Simd(buf, output);
 }
+
+//Multi-buffer SHA256, 4 lanes
+
+#define SIMD_SHA256X_T uint32x4_t
+#define SIMD_SHA256X_LANES 4
+#define SIMD_SHA256X_SUFFIX(x) x##X4
+
+#define SIMD_SHA256X_ADD vaddq_u32
+#define SIMD_SHA256X_XOR veorq_u32
+#define SIMD_SHA256X_AND vandq_u32
+#define SIMD_SHA256X_OR vorrq_u32
+#define SIMD_SHA256X_ANDNOT(a, b) vbicq_u32(b, a)
+#define SIMD_SHA256X_SHR vshrq_n_u32
+#define SIMD_SHA256X_ROR(a, n) vsriq_n_u32(vshlq_n_u32(a, 32 - (n)), a, n)
+#define SIMD_SHA256X_SET1 vdupq_n_u32
+#define SIMD_SHA256X_LOAD(ptr) vld1q_u32((const uint32_t*)(const void*)(ptr))
+#define SIMD_SHA256X_STORE(ptr, v) vst1q_u32((uint32_t*)(void*)(ptr), v)
+
+#include "types/container/simd/buffer_simd_sha_multi.inc.h"
+
+U8 Buffer_sha256BatchLanes(const Buffer *bufs, U64 count, U32 (*outputs)[8], U8 lanes) {
+
+	if(!bufs || !outputs || !count)
+		return 0;
+
+	//4 NEON lanes don't beat the SHA2 extension on a single message, so they're only picked without it
+
+	#ifndef _CRYPTO_ALWAYS
+		if(hasSHA256 < 0)
+			hasSHA256 = (Platform_detectCPUFeatures() & ECPUFeatures_HwSHA256) != 0;
+		const Bool hwSHA256 = hasSHA256;
+	#else
+		const Bool hwSHA256 = true;
+	#endif
+
+	if(!lanes)
+		lanes = hwSHA256 ? 1 : 4;
+
+	if (lanes >= 4) {
+		Buffer_sha256BatchX4(bufs, count, outputs, hwSHA256 ? 64 * KIBI : U64_MAX);
+		return 4;
+	}
+
+	for(U64 i = 0; i < count; ++i)
+		Buffer_sha256(bufs[i], outputs[i]);
+
+	return 1;
+}
+
+//XXH3 stripes; vmlal_u32 is the 32x32 -> 64 multiply-add the accumulator step is built around
+
+void Buffer_hashAccumulate(U64 acc[8], const U8 *ptr, U64 stripes, const U8 *secret) {
+
+	uint64x2_t a[4];
+
+	for (U8 i = 0; i < 4; ++i)
+		a[i] = vld1q_u64(acc + i * 2);
+
+	for (U64 j = 0; j < stripes; ++j, ptr += 64, secret += 8)
+		for (U8 i = 0; i < 4; ++i) {
+			const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(ptr + i * 16));
+			const uint64x2_t key = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(secret + i * 16)));
+			const uint64x2_t swapped = vextq_u64(data, data, 1);
+			a[i] = vaddq_u64(a[i], vmlal_u32(swapped, vmovn_u64(key), vshrn_n_u64(key, 32)));
+		}
+
+	for (U8 i = 0; i < 4; ++i)
+		vst1q_u64(acc + i * 2, a[i]);
+}
+
+void Buffer_hashScramble(U64 acc[8], const U8 *secret) {
+
+	const uint32x2_t prime = vdup_n_u32(0x9E3779B1);
+
+	for (U8 i = 0; i < 4; ++i) {
+
+		uint64x2_t a = vld1q_u64(acc + i * 2);
+		a = veorq_u64(veorq_u64(a, vshrq_n_u64(a, 47)), vreinterpretq_u64_u8(vld1q_u8(secret + i * 16)));
+
+		//a * prime mod 2^64 is lo32(a) * prime + (hi32(a) * prime << 32)
+
+		const uint64x2_t hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(a, 32), prime), 32);
+		vst1q_u64(acc + i * 2, vmlal_u32(hi, vmovn_u64(a), prime));
+	}
+}
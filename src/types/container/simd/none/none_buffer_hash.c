@@ -36,3 +36,24 @@ void Buffer_sha256(const Buffer buf, U32 output[8]) {
 
 	Buffer_sha256Fallback(buf, output);
 }
+
+U8 Buffer_sha256BatchLanes(const Buffer *bufs, U64 count, U32 (*outputs)[8], U8 lanes) {
+
+	(void) lanes;
+
+	if(!bufs || !outputs || !count)
+		return 0;
+
+	for(U64 i = 0; i < count; ++i)
+		Buffer_sha256(bufs[i], outputs[i]);
+
+	return 1;
+}
+
+void Buffer_hashAccumulate(U64 acc[8], const U8 *ptr, U64 stripes, const U8 *secret) {
+	Buffer_hashAccumulateFallback(acc, ptr, stripes, secret);
+}
+
+void Buffer_hashScramble(U64 acc[8], const U8 *secret) {
+	Buffer_hashScrambleFallback(acc, secret);
+}
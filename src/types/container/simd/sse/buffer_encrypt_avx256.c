@@ -618,7 +618,7 @@ void AESEncryptionContext_blocks8(
 
 	//Contents
 
-	while (*next + 4 <= end) {
+	while (*next + 8 <= end) {
 
 		U32 counter = *counterForIv;
 
@@ -610,7 +610,7 @@ void AESEncryptionContext_blocks16(
 
 	//Contents
 
-	while (*next + 8 <= end) {
+	while (*next + 16 <= end) {
 
 		U32 counter = *counterForIv;
 
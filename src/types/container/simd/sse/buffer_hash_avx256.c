@@ -0,0 +1,86 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/simd/sse/buffer_hash_avx256.c
+
+#include "types/container/buffer.h"
+#include "types/base/mathi.h"
+#include <immintrin.h>
+
+//8 lane multi-buffer SHA256 (AVX2), picked by Buffer_sha256BatchLanes in sse_buffer_hash.c
+
+#define SIMD_SHA256X_T __m256i
+#define SIMD_SHA256X_LANES 8
+#define SIMD_SHA256X_SUFFIX(x) x##X8
+#define SIMD_SHA256X_LINKING
+
+#define SIMD_SHA256X_ADD _mm256_add_epi32
+#define SIMD_SHA256X_XOR _mm256_xor_si256
+#define SIMD_SHA256X_AND _mm256_and_si256
+#define SIMD_SHA256X_OR _mm256_or_si256
+#define SIMD_SHA256X_ANDNOT _mm256_andnot_si256
+#define SIMD_SHA256X_SHR _mm256_srli_epi32
+#define SIMD_SHA256X_ROR(a, n) _mm256_or_si256(_mm256_srli_epi32(a, n), _mm256_slli_epi32(a, 32 - (n)))
+#define SIMD_SHA256X_SET1(v) _mm256_set1_epi32((I32)(v))
+#define SIMD_SHA256X_LOAD(ptr) _mm256_loadu_si256((const __m256i*)(const void*)(ptr))
+#define SIMD_SHA256X_STORE(ptr, v) _mm256_storeu_si256((__m256i*)(void*)(ptr), v)
+
+#include "types/container/simd/buffer_simd_sha_multi.inc.h"
+
+//XXH3 stripes with AVX2, picked by Buffer_hashAccumulate/Buffer_hashScramble in sse_buffer_hash.c
+
+void Buffer_hashAccumulate256(U64 acc[8], const U8 *ptr, U64 stripes, const U8 *secret) {
+
+	__m256i a0 = _mm256_loadu_si256((const __m256i*)(const void*)acc);
+	__m256i a1 = _mm256_loadu_si256((const __m256i*)(const void*)(acc + 4));
+
+	for (U64 j = 0; j < stripes; ++j, ptr += 64, secret += 8) {
+
+		const __m256i d0 = _mm256_loadu_si256((const __m256i*)(const void*)ptr);
+		const __m256i d1 = _mm256_loadu_si256((const __m256i*)(const void*)(ptr + 32));
+		const __m256i k0 = _mm256_xor_si256(d0, _mm256_loadu_si256((const __m256i*)(const void*)secret));
+		const __m256i k1 = _mm256_xor_si256(d1, _mm256_loadu_si256((const __m256i*)(const void*)(secret + 32)));
+
+		const __m256i p0 = _mm256_mul_epu32(k0, _mm256_srli_epi64(k0, 32));
+		const __m256i p1 = _mm256_mul_epu32(k1, _mm256_srli_epi64(k1, 32));
+
+		a0 = _mm256_add_epi64(a0, _mm256_add_epi64(p0, _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2))));
+		a1 = _mm256_add_epi64(a1, _mm256_add_epi64(p1, _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	_mm256_storeu_si256((__m256i*)(void*)acc, a0);
+	_mm256_storeu_si256((__m256i*)(void*)(acc + 4), a1);
+}
+
+void Buffer_hashScramble256(U64 acc[8], const U8 *secret) {
+
+	const __m256i prime = _mm256_set1_epi32((I32) 0x9E3779B1);
+
+	for (U8 i = 0; i < 2; ++i) {
+
+		__m256i a = _mm256_loadu_si256((const __m256i*)(const void*)(acc + i * 4));
+		const __m256i key = _mm256_loadu_si256((const __m256i*)(const void*)(secret + i * 32));
+		a = _mm256_xor_si256(_mm256_xor_si256(a, _mm256_srli_epi64(a, 47)), key);
+
+		const __m256i lo = _mm256_mul_epu32(a, prime);
+		const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+		_mm256_storeu_si256((__m256i*)(void*)(acc + i * 4), _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+	}
+}
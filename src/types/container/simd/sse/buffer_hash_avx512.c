@@ -0,0 +1,78 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/simd/sse/buffer_hash_avx512.c
+
+#include "types/container/buffer.h"
+#include "types/base/mathi.h"
+#include <immintrin.h>
+
+//16 lane multi-buffer SHA256 (AVX512F), picked by Buffer_sha256BatchLanes in sse_buffer_hash.c.
+//AVX512 has a real rotate and ternary logic, which makes Ch and Maj one instruction each.
+
+#define SIMD_SHA256X_T __m512i
+#define SIMD_SHA256X_LANES 16
+#define SIMD_SHA256X_SUFFIX(x) x##X16
+#define SIMD_SHA256X_LINKING
+
+#define SIMD_SHA256X_ADD _mm512_add_epi32
+#define SIMD_SHA256X_XOR _mm512_xor_si512
+#define SIMD_SHA256X_AND _mm512_and_si512
+#define SIMD_SHA256X_OR _mm512_or_si512
+#define SIMD_SHA256X_ANDNOT _mm512_andnot_si512
+#define SIMD_SHA256X_SHR _mm512_srli_epi32
+#define SIMD_SHA256X_ROR _mm512_ror_epi32
+#define SIMD_SHA256X_SET1(v) _mm512_set1_epi32((I32)(v))
+#define SIMD_SHA256X_LOAD(ptr) _mm512_loadu_si512((const void*)(ptr))
+#define SIMD_SHA256X_STORE(ptr, v) _mm512_storeu_si512((void*)(ptr), v)
+
+#define SIMD_SHA256X_CH(e, f, g) _mm512_ternarylogic_epi32(e, f, g, 0xCA)        //e ? f : g
+#define SIMD_SHA256X_MAJ(a, b, c) _mm512_ternarylogic_epi32(a, b, c, 0xE8)       //Majority of a, b, c
+
+#include "types/container/simd/buffer_simd_sha_multi.inc.h"
+
+//XXH3 stripes with AVX512F, a whole stripe per register
+
+void Buffer_hashAccumulate512(U64 acc[8], const U8 *ptr, U64 stripes, const U8 *secret) {
+
+	__m512i a = _mm512_loadu_si512(acc);
+
+	for (U64 j = 0; j < stripes; ++j, ptr += 64, secret += 8) {
+		const __m512i data = _mm512_loadu_si512(ptr);
+		const __m512i key = _mm512_xor_si512(data, _mm512_loadu_si512(secret));
+		const __m512i product = _mm512_mul_epu32(key, _mm512_srli_epi64(key, 32));
+		const __m512i swapped = _mm512_shuffle_epi32(data, (_MM_PERM_ENUM) _MM_SHUFFLE(1, 0, 3, 2));
+		a = _mm512_add_epi64(a, _mm512_add_epi64(product, swapped));
+	}
+
+	_mm512_storeu_si512(acc, a);
+}
+
+void Buffer_hashScramble512(U64 acc[8], const U8 *secret) {
+
+	const __m512i prime = _mm512_set1_epi32((I32) 0x9E3779B1);
+
+	__m512i a = _mm512_loadu_si512(acc);
+	a = _mm512_ternarylogic_epi64(a, _mm512_srli_epi64(a, 47), _mm512_loadu_si512(secret), 0x96);        //a ^ b ^ c
+
+	const __m512i lo = _mm512_mul_epu32(a, prime);
+	const __m512i hi = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), prime);
+	_mm512_storeu_si512(acc, _mm512_add_epi64(lo, _mm512_slli_epi64(hi, 32)));
+}
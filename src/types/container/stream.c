@@ -24,6 +24,238 @@
 #include "types/container/buffer.h"
 #include "types/container/container_types.h"
 #include "types/base/mathi.h"
+#include "types/base/thread.h"
+#include "types/base/lock.h"
+#include "types/base/atomic.h"
+#include "types/base/allocator.h"
+
+//Read-ahead.
+//The owner requests slots in ring order and the worker fills them in the same order, so both sides only need a
+// monotonic counter; requested is what the worker parks on, completed what the owner parks on.
+//A slot is only touched by the worker between being requested and completed, and only by the owner otherwise.
+
+#define StreamReadAhead_maxDepth 16
+
+typedef struct StreamReadAheadSlot {
+	Buffer data;                //Same size as the cursor's cache, swapped with it on a hit
+	U64 offset, length;
+	Bool failed;
+	U8 padding[7];
+} StreamReadAheadSlot;
+
+typedef struct StreamReadAhead {
+
+	OxStream *stream;
+	const Allocator *alloc;
+	Thread *thread;
+	Buffer allocation;          //This struct and the slots
+
+	AtomicI64 requested;        //Slots requested since create, written by the owner
+	AtomicI64 completed;        //Slots read since create, written by the worker
+	AtomicI64 shutdown;
+
+	U64 depth;
+	U64 head;                   //Owner side: slots consumed or dropped
+	U64 tail;                   //Owner side: slots requested (mirrors requested)
+	U64 nextOffset;             //Where the next request starts
+
+	StreamReadAheadSlot slots[StreamReadAhead_maxDepth];
+
+} StreamReadAhead;
+
+static void StreamReadAhead_worker(void *data) {
+
+	StreamReadAhead *ra = (StreamReadAhead*) data;
+	U64 next = 0;
+
+	while (!AtomicI64_load(&ra->shutdown)) {
+
+		const I64 requested = AtomicI64_load(&ra->requested);
+
+		if (next == (U64) requested) {
+			Lock_park(&ra->requested, requested, U64_MAX);
+			continue;
+		}
+
+		StreamReadAheadSlot *slot = &ra->slots[next % ra->depth];
+
+		slot->failed = !ra->stream->read(
+			ra->stream, slot->offset, slot->length, slot->data, ra->alloc, NULL
+		);
+
+		AtomicI64_store(&ra->completed, (I64) ++next);
+		Lock_wake(&ra->completed, true);
+	}
+}
+
+static void StreamReadAhead_waitFor(StreamReadAhead *ra, U64 count) {
+
+	I64 completed = AtomicI64_load(&ra->completed);
+
+	while ((U64) completed < count) {
+		Lock_park(&ra->completed, completed, U64_MAX);
+		completed = AtomicI64_load(&ra->completed);
+	}
+}
+
+//Waits for the worker and forgets everything it prefetched
+static void StreamReadAhead_drop(StreamReadAhead *ra) {
+
+	if(!ra)
+		return;
+
+	StreamReadAhead_waitFor(ra, ra->tail);
+	ra->head = ra->tail;
+}
+
+//Requests caches from nextOffset on until depth are in flight or the stream ends
+static void StreamReadAhead_request(StreamReadAhead *ra, U64 cacheSize) {
+
+	const U64 prevTail = ra->tail;
+
+	while (ra->tail - ra->head < ra->depth && ra->nextOffset < ra->stream->size) {
+
+		StreamReadAheadSlot *slot = &ra->slots[ra->tail % ra->depth];
+		slot->offset = ra->nextOffset;
+		slot->length = U64_min(cacheSize, ra->stream->size - ra->nextOffset);
+
+		ra->nextOffset += cacheSize;
+		++ra->tail;
+	}
+
+	if (ra->tail != prevTail) {
+		AtomicI64_store(&ra->requested, (I64) ra->tail);
+		Lock_wake(&ra->requested, false);
+	}
+}
+
+//Refills the cursor's cache at srcOff, from a prefetched slot if possible.
+//Reading on after the end of the previous cache (or hitting a prefetched one) keeps the worker ahead of the reader.
+static Bool StreamReadAhead_refill(StreamCursor *cursor, U64 srcOff, const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	StreamReadAhead *ra = cursor->readAhead;
+	OxStream *stream = ra->stream;
+	const U64 cacheSize = Buffer_length(cursor->cacheData);
+
+	Bool sequential = cursor->lastLocation != U64_MAX && cursor->lastLocation + cacheSize == srcOff;
+
+	if (ra->head != ra->tail && ra->slots[ra->head % ra->depth].offset == srcOff) {
+
+		StreamReadAheadSlot *slot = &ra->slots[ra->head % ra->depth];
+		StreamReadAhead_waitFor(ra, ra->head + 1);
+
+		//A failed read is done again below, so the error is reported like it would be without read-ahead
+
+		if (!slot->failed) {
+
+			const Buffer cache = cursor->cacheData;
+			cursor->cacheData = slot->data;
+			slot->data = cache;
+
+			++ra->head;
+			cursor->lastLocation = srcOff;
+			StreamReadAhead_request(ra, cacheSize);
+			goto clean;
+		}
+
+		sequential = true;
+	}
+
+	StreamReadAhead_drop(ra);
+
+	cursor->lastLocation = srcOff;
+	gotoIfError3(clean, stream->read(
+		stream,
+		srcOff,
+		U64_min(cacheSize, stream->size - srcOff),
+		cursor->cacheData,
+		alloc,
+		e_rr
+	));
+
+	if (sequential) {
+		ra->nextOffset = srcOff + cacheSize;
+		StreamReadAhead_request(ra, cacheSize);
+	}
+
+clean:
+	return s_uccess;
+}
+
+static void StreamReadAhead_free(StreamReadAhead **readAhead) {
+
+	StreamReadAhead *ra = readAhead ? *readAhead : NULL;
+
+	if(!ra)
+		return;
+
+	const Allocator *alloc = ra->alloc;
+
+	if (ra->thread) {
+		AtomicI64_store(&ra->shutdown, 1);
+		Lock_wake(&ra->requested, true);
+		Thread_waitAndCleanup(alloc, &ra->thread, NULL);
+	}
+
+	for(U64 i = 0; i < ra->depth; ++i)
+		Buffer_free(&ra->slots[i].data, alloc);
+
+	Buffer allocation = ra->allocation;
+	Buffer_free(&allocation, alloc);
+	*readAhead = NULL;
+}
+
+Bool StreamCursor_enableReadAhead(StreamCursor *cursor, U64 depth, const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+	StreamReadAhead *ra = NULL;
+	Buffer allocation = Buffer_createNull();
+
+	if (!cursor || !cursor->cacheData.ptr)
+		retError(clean, Error_nullPointer(0, "StreamCursor_enableReadAhead()::cursor is required"));
+
+	OxStream *stream = RefPtr_data(cursor->stream, OxStream);
+
+	if (!stream || cursor->stream->refPtrType->typeId != (TypeId)EContainerTypeId_Stream || !stream->read)
+		retError(clean, Error_nullPointer(0, "StreamCursor_enableReadAhead()::cursor->stream is required"));
+
+	if (cursor->readAhead)
+		retError(clean, Error_invalidOperation(0, "StreamCursor_enableReadAhead()::read-ahead is already enabled"));
+
+	if (!depth)
+		depth = 2;
+
+	if (depth > StreamReadAhead_maxDepth)
+		retError(clean, Error_outOfBounds(
+			1, depth, StreamReadAhead_maxDepth, "StreamCursor_enableReadAhead()::depth is limited to 16"
+		));
+
+	gotoIfError3(clean, Buffer_createEmptyBytes(sizeof(StreamReadAhead), alloc, &allocation, e_rr));
+
+	ra = (StreamReadAhead*) allocation.ptrNonConst;
+	ra->stream = stream;
+	ra->alloc = alloc;
+	ra->allocation = allocation;
+	ra->depth = depth;
+	allocation = Buffer_createNull();
+
+	for(U64 i = 0; i < depth; ++i)
+		gotoIfError3(clean, Buffer_createUninitializedBytes(
+			Buffer_length(cursor->cacheData), alloc, &ra->slots[i].data, e_rr
+		));
+
+	gotoIfError3(clean, Thread_create(alloc, StreamReadAhead_worker, ra, &ra->thread, e_rr));
+
+	cursor->readAhead = ra;
+	ra = NULL;
+
+clean:
+	StreamReadAhead_free(&ra);
+	Buffer_free(&allocation, alloc);
+	return s_uccess;
+}
 
 void Stream_close(void *streamGeneric, const Allocator *alloc) {
 
@@ -88,6 +320,9 @@ Bool Stream_create(
 	if (streamSize >> 48)
 		retError(clean, Error_invalidParameter(5, 0, "Stream_create()::streamSize too big"));
 
+	if ((streamType & EStreamType_Mapped) && write)
+		retError(clean, Error_invalidParameter(1, 0, "Stream_create()::mapped streams have to be readonly"));
+
 	gotoIfError3(clean, RefPtr_create(type, streamRef, e_rr));
 
 	*RefPtr_data(*streamRef, OxStream) = (OxStream) {
@@ -190,6 +425,7 @@ void StreamCursor_close(StreamCursor *cursor, const Allocator *alloc) {
 		return;
 
 	StreamCursor_flush(cursor, alloc, NULL);
+	StreamReadAhead_free(&cursor->readAhead);
 	Buffer_free(&cursor->cacheData, alloc);
 	RefPtr_dec(&cursor->stream);
 
@@ -233,6 +469,10 @@ Bool StreamCursor_flush(StreamCursor *cursor, const Allocator *alloc, Error *e_r
 	if (!stream || cursor->stream->refPtrType->typeId != (TypeId)EContainerTypeId_Stream)
 		retError(clean, Error_nullPointer(0, "StreamCursor_flush()::input/output->stream is required"));
 
+	//The worker could still be reading the range that's written back, so it has to be done (and forgotten) first
+
+	StreamReadAhead_drop(cursor->readAhead);
+
 	//Only flush if we have pending writes
 
 	if (stream->write && StreamCursor_canWrite(cursor) && cursor->lastWriteLocation != U64_MAX)
@@ -285,6 +525,7 @@ Bool StreamCursor_setWritable(StreamCursor *cursor, Error *e_rr) {
 	if (StreamCursor_canWrite(cursor))
 		goto clean;
 
+	StreamReadAhead_drop(cursor->readAhead);
 	cursor->lastLocation = U64_MAX;
 	cursor->lastWriteLocation = U64_MAX;
 	cursor->readOnly = false;
@@ -296,6 +537,7 @@ clean:
 Bool StreamCursor_resize(StreamCursor *cursor, U64 newSize, Bool disableFlush, const Allocator *alloc, Error *e_rr) {
 
 	Bool s_uccess = true;
+	Bool resizingReadAhead = false;
 
 	if (!cursor || !cursor->cacheData.ptr)
 		retError(clean, Error_nullPointer(0, "StreamCursor_resize()::cursor is required"));
@@ -317,7 +559,28 @@ Bool StreamCursor_resize(StreamCursor *cursor, U64 newSize, Bool disableFlush, c
 	gotoIfError3(clean, Buffer_createUninitializedBytes(newSize, alloc, &cursor->cacheData, e_rr));
 	cursor->lastLocation = cursor->lastWriteLocation = U64_MAX;
 
+	//Prefetched caches have to stay the size of the cache they're swapped with
+
+	StreamReadAhead *ra = cursor->readAhead;
+
+	if (ra) {
+
+		StreamReadAhead_drop(ra);
+		resizingReadAhead = true;
+
+		for (U64 i = 0; i < ra->depth; ++i) {
+			Buffer_free(&ra->slots[i].data, ra->alloc);
+			gotoIfError3(clean, Buffer_createUninitializedBytes(newSize, ra->alloc, &ra->slots[i].data, e_rr));
+		}
+
+		resizingReadAhead = false;
+	}
+
 clean:
+
+	if(resizingReadAhead)                //A read-ahead with a missing cache can't be used anymore
+		StreamReadAhead_free(&cursor->readAhead);
+
 	return s_uccess;
 }
 
@@ -378,7 +641,9 @@ Bool StreamCursor_copyStream(
 	if (srcEnd > inputSize)
 		retError(clean, Error_outOfBounds(2, srcOff, inputSize, "StreamCursor_copyStream()::srcOff out of bounds"));
 
-	U64 cacheSiz = Buffer_length(input->cacheData);
+	//Mapped input can be written in one go, without going through its cache
+
+	U64 cacheSiz = streamIn->streamType & EStreamType_Mapped ? length : Buffer_length(input->cacheData);
 
 	//Copy
 
@@ -386,8 +651,9 @@ Bool StreamCursor_copyStream(
 
 		U64 len = U64_min(cacheSiz, length);
 
-		gotoIfError3(clean, StreamCursor_read(input, Buffer_createNull(), srcOff, 0, len, false, alloc, e_rr));
-		gotoIfError3(clean, StreamCursor_write(output, input->cacheData, 0, dstOff, len, false, alloc, e_rr));
+		Buffer chunk = Buffer_createNull();
+		gotoIfError3(clean, StreamCursor_view(input, srcOff, len, &chunk, alloc, e_rr));
+		gotoIfError3(clean, StreamCursor_write(output, chunk, 0, dstOff, len, false, alloc, e_rr));
 
 		srcOff += len;
 		dstOff += len;
@@ -398,6 +664,55 @@ clean:
 	return s_uccess;
 }
 
+Bool StreamCursor_hash(
+	StreamCursor *cursor,
+	U64 offset,
+	U64 length,
+	BufferHashState *state,
+	const Allocator *alloc,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+
+	if (!cursor || !state)
+		retError(clean, Error_nullPointer(!cursor ? 0 : 3, "StreamCursor_hash()::cursor and state are required"));
+
+	OxStream *stream = RefPtr_data(cursor->stream, OxStream);
+
+	if (!stream || cursor->stream->refPtrType->typeId != (TypeId)EContainerTypeId_Stream)
+		retError(clean, Error_nullPointer(0, "StreamCursor_hash()::cursor->stream is required"));
+
+	if (!StreamCursor_canRead(cursor))
+		retError(clean, Error_invalidParameter(0, 0, "StreamCursor_hash()::cursor must be readable"));
+
+	if (!length) {
+
+		if (offset > stream->size)
+			retError(clean, Error_outOfBounds(1, offset, stream->size, "StreamCursor_hash()::offset out of bounds"));
+
+		length = stream->size - offset;
+	}
+
+	const U64 cacheSiz = Buffer_length(cursor->cacheData);
+
+	//A cache worth at a time, reading without a buffer leaves it at the start of cacheData
+
+	while (length) {
+
+		const U64 len = U64_min(cacheSiz, length);
+
+		gotoIfError3(clean, StreamCursor_read(cursor, Buffer_createNull(), offset, 0, len, false, alloc, e_rr));
+		BufferHashState_update(state, Buffer_createRefConst(cursor->cacheData.ptr, len));
+
+		offset += len;
+		length -= len;
+	}
+
+clean:
+	return s_uccess;
+}
+
 Bool StreamCursor_write(
 	StreamCursor *cursor,
 	Buffer buf,
@@ -582,6 +897,18 @@ Bool StreamCursor_read(
 			3, dstEnd, bufLen, "StreamCursor_read()::buf out of bounds"
 		));
 
+	//Mapped streams are already in memory, going through the cache would only add a copy
+
+	if ((stream->streamType & EStreamType_Mapped) && bufLen) {
+
+		Buffer_memcpy(
+			Buffer_createRef(buf.ptrNonConst + dstOff, length),
+			Buffer_createRefConst(stream->mapped + srcOff, length)
+		);
+
+		goto clean;
+	}
+
 	U64 streamLen = Buffer_length(cursor->cacheData);
 
 	if (!bufLen && length > streamLen)
@@ -652,16 +979,23 @@ Bool StreamCursor_read(
 	//In that case, you don't want to load the entire file, but you might want to keep the next info ready just in case.
 	//It would minimize IO access at the cost of memory and potentially unnecessary copies.
 
-	cursor->lastLocation = srcOff;
+	if (cursor->readAhead) {
+		gotoIfError3(clean, StreamReadAhead_refill(cursor, srcOff, alloc, e_rr));
+	}
 
-	gotoIfError3(clean, stream->read(
-		stream,
-		srcOff,
-		U64_min(streamLen, stream->size - srcOff),
-		cursor->cacheData,
-		alloc,
-		e_rr
-	));
+	else {
+
+		cursor->lastLocation = srcOff;
+
+		gotoIfError3(clean, stream->read(
+			stream,
+			srcOff,
+			U64_min(streamLen, stream->size - srcOff),
+			cursor->cacheData,
+			alloc,
+			e_rr
+		));
+	}
 
 	if (bufLen)
 		Buffer_memcpy(Buffer_createRef(buf.ptrNonConst + dstOff, length), cursor->cacheData);
@@ -670,6 +1004,54 @@ clean:
 	return s_uccess;
 }
 
+Bool StreamCursor_view(
+	StreamCursor *cursor,
+	U64 offset,
+	U64 length,
+	Buffer *output,
+	const Allocator *alloc,
+	Error *e_rr
+) {
+
+	Bool s_uccess = true;
+
+	if (!cursor || !output)
+		retError(clean, Error_nullPointer(!cursor ? 0 : 3, "StreamCursor_view()::cursor and output are required"));
+
+	OxStream *stream = RefPtr_data(cursor->stream, OxStream);
+
+	if (!stream || cursor->stream->refPtrType->typeId != (TypeId)EContainerTypeId_Stream || !stream->read)
+		retError(clean, Error_nullPointer(0, "StreamCursor_view()::cursor->stream is required"));
+
+	if (!StreamCursor_canRead(cursor))
+		retError(clean, Error_invalidParameter(0, 0, "StreamCursor_view()::cursor must be readable"));
+
+	if ((offset >> 48) || (length >> 48) || offset + length > stream->size)
+		retError(clean, Error_outOfBounds(
+			1, offset + length, stream->size, "StreamCursor_view()::stream out of bounds"
+		));
+
+	if (!length) {
+		*output = Buffer_createNull();
+		goto clean;
+	}
+
+	if (stream->streamType & EStreamType_Mapped) {
+		*output = Buffer_createRefConst(stream->mapped + offset, length);
+		goto clean;
+	}
+
+	//The cache might already hold it, otherwise it's loaded to start at offset
+
+	if (!StreamCursor_contains(cursor, offset, length))
+		gotoIfError3(clean, StreamCursor_read(cursor, Buffer_createNull(), offset, 0, length, false, alloc, e_rr));
+
+	*output = Buffer_createRefConst(cursor->cacheData.ptr + (offset - cursor->lastLocation), length);
+
+clean:
+	return s_uccess;
+}
+
 Bool Stream_compare(
 	StreamRef *a,
 	StreamRef *b,
@@ -728,15 +1110,11 @@ Bool Stream_compare(
 
 		U64 readNow = U64_min(remaining, Buffer_length(aCursor.cacheData));
 
-		//Read chunk from a into cursor cache, then directly compare against b's chunk
-
-		gotoIfError3(clean, StreamCursor_read(&aCursor, Buffer_createNull(), aIt, 0, readNow, false, alloc, e_rr));
-		gotoIfError3(clean, StreamCursor_read(&bCursor, Buffer_createNull(), bIt, 0, readNow, false, alloc, e_rr));
-
-		//Both cursors now have the chunk in cache; compare the cache windows directly
+		//View both chunks (from the cache, or straight from the mapping) and compare them directly
 
-		Buffer aCached = Buffer_createRefConst(aCursor.cacheData.ptr, readNow);
-		Buffer bCached = Buffer_createRefConst(bCursor.cacheData.ptr, readNow);
+		Buffer aCached = Buffer_createNull(), bCached = Buffer_createNull();
+		gotoIfError3(clean, StreamCursor_view(&aCursor, aIt, readNow, &aCached, alloc, e_rr));
+		gotoIfError3(clean, StreamCursor_view(&bCursor, bIt, readNow, &bCached, alloc, e_rr));
 
 		ECompareResult cmp = Buffer_cmp(aCached, bCached);
 
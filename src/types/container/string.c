@@ -25,6 +25,7 @@
 #include "types/container/list_basic_types.h"
 #include "types/base/allocator.h"
 #include "types/base/string_read.h"
+#include "types/base/string_search.h"
 #include "types/base/mathi.h"
 #include "types/base/c8.h"
 #include "types/base/constants.h"
@@ -164,7 +165,7 @@ Bool CharString_split(const CharStringSplit *split, C8 c, EStringCase casing, Er
 	C8 *sPtrNonConst = s->ptrNonConst;
 
 	const ListCharString str = *split->result;
-	EStringTransform transform = (EStringTransform) casing;
+	const Bool insensitive = casing == EStringCase_Insensitive;
 
 	if (!length) {
 
@@ -174,19 +175,23 @@ Bool CharString_split(const CharStringSplit *split, C8 c, EStringCase casing, Er
 		goto clean;
 	}
 
-	c = C8_transform(c, transform);
-
 	U64 count = 0, last = 0;
 
-	for (U64 i = 0; i < strl; ++i)
-		if (C8_transform(sPtr[i], transform) == c) {
+	while (true) {
 
-			str.ptrNonConst[count++] =
-				isConstRef ? CharString_createRefSizedConst(sPtr + last, i - last, false) :
-				CharString_createRefSized(sPtrNonConst + last, i - last, false);
+		const U64 found = StringSearch_findByte(sPtr + last, strl - last, c, insensitive);
 
-			last = i + 1;
-		}
+		if(found == U64_MAX)
+			break;
+
+		const U64 i = last + found;
+
+		str.ptrNonConst[count++] =
+			isConstRef ? CharString_createRefSizedConst(sPtr + last, i - last, false) :
+			CharString_createRefSized(sPtrNonConst + last, i - last, false);
+
+		last = i + 1;
+	}
 
 	str.ptrNonConst[count++] =
 		isConstRef ? CharString_createRefSizedConst(sPtr + last, strl - last, b) :
@@ -219,7 +224,7 @@ Bool CharString_splitString(const CharStringSplit *split, const CharString *othe
 	const C8 *sPtr = s->ptr;
 	C8 *sPtrNonConst = s->ptrNonConst;
 
-	EStringTransform transform = (EStringTransform) casing;
+	const Bool insensitive = casing == EStringCase_Insensitive;
 	const ListCharString str = *split->result;
 
 	if (!length) {
@@ -232,25 +237,20 @@ Bool CharString_splitString(const CharStringSplit *split, const CharString *othe
 
 	U64 count = 0, last = 0;
 
-	for (U64 i = 0; i < strl - otherl + 1; ++i) {
+	while (true) {
 
-		Bool match = true;
+		const U64 found = StringSearch_findString(sPtr + last, strl - last, otherPtr, otherl, insensitive);
 
-		for (U64 j = i, k = 0; j < strl && k < otherl; ++j, ++k)
-			if (C8_transform(sPtr[j], transform) != C8_transform(otherPtr[k], transform)) {
-				match = false;
-				break;
-			}
+		if(found == U64_MAX)
+			break;
 
-		if (match) {
+		const U64 i = last + found;
 
-			str.ptrNonConst[count++] =
-				isConstRef ? CharString_createRefSizedConst(sPtr + last, i - last, false) :
-				CharString_createRefSized(sPtrNonConst + last, i - last, false);
+		str.ptrNonConst[count++] =
+			isConstRef ? CharString_createRefSizedConst(sPtr + last, i - last, false) :
+			CharString_createRefSized(sPtrNonConst + last, i - last, false);
 
-			last = i + otherl;
-			i += otherl - 1;
-		}
+		last = i + otherl;
 	}
 
 	str.ptrNonConst[count++] =
@@ -274,23 +274,23 @@ Bool CharString_splitLine(const CharString s, const Allocator *alloc, ListCharSt
 	U64 v = 0, lastLineEnd = U64_MAX;
 	const U64 strl = CharString_length(s);
 
-	for(U64 i = 0; i < strl; ++i)
+	//Line ends are \n (Unix), \r\n (Windows) or \r (legacy Mac), \r\n counts as one
 
-		if (s.ptr[i] == '\n') {            //Unix line endings
-			++v;
-			lastLineEnd = i;
-			continue;
-		}
+	for (U64 i = 0; i < strl; ++i) {
 
-		else if (s.ptr[i] == '\r') {    //Windows/Legacy Mac line endings
+		const U64 found = StringSearch_findEither(s.ptr + i, strl - i, '\r', '\n');
 
-			if(i + 1 < strl && s.ptr[i + 1] == '\n')        //Windows
-				++i;
+		if(found == U64_MAX)
+			break;
 
-			++v;
-			lastLineEnd = i;
-			continue;
-		}
+		i += found;
+
+		if(s.ptr[i] == '\r' && i + 1 < strl && s.ptr[i + 1] == '\n')
+			++i;
+
+		++v;
+		lastLineEnd = i;
+	}
 
 	if(lastLineEnd != strl)
 		++v;
@@ -300,25 +300,18 @@ Bool CharString_splitLine(const CharString s, const Allocator *alloc, ListCharSt
 	v = 0;
 	lastLineEnd = 0;
 
-	for(U64 i = 0; i < strl; ++i) {
+	for (U64 i = 0; i < strl; ++i) {
 
-		Bool isLineEnd = false;
+		const U64 found = StringSearch_findEither(s.ptr + i, strl - i, '\r', '\n');
 
-		const U64 iOld = i;
-
-		if (s.ptr[i] == '\n')            //Unix line endings
-			isLineEnd = true;
-
-		else if (s.ptr[i] == '\r') {    //Windows/Legacy Mac line endings
-
-			if(i + 1 < strl && s.ptr[i + 1] == '\n')        //Windows
-				++i;
+		if(found == U64_MAX)
+			break;
 
-			isLineEnd = true;
-		}
+		i += found;
+		const U64 iOld = i;
 
-		if(!isLineEnd)
-			continue;
+		if(s.ptr[i] == '\r' && i + 1 < strl && s.ptr[i + 1] == '\n')
+			++i;
 
 		result->ptrNonConst[v++] = CharString_isConstRef(s) ?
 			CharString_createRefSizedConst(s.ptr + lastLineEnd, iOld - lastLineEnd, false) :
@@ -447,13 +440,18 @@ Bool CharString_findAll(const CharStringFind *find, C8 c, EStringCase caseSensit
 	gotoIfError3(clean, ListU64_reserve(&l, (strl - off) / 25 + 16, find->alloc, e_rr));
 	alloc = find->alloc;
 
-	EStringTransform transform = (EStringTransform) caseSensitive;
+	const Bool insensitive = caseSensitive == EStringCase_Insensitive;
 
-	c = C8_transform(c, transform);
+	for (U64 i = off; i < strl; ++i) {
 
-	for (U64 i = off; i < strl; ++i)
-		if (c == C8_transform(sPtr[i], transform))
-			gotoIfError3(clean, ListU64_pushBack(&l, i, alloc, e_rr));
+		const U64 found = StringSearch_findByte(sPtr + i, strl - i, c, insensitive);
+
+		if(found == U64_MAX)
+			break;
+
+		i += found;
+		gotoIfError3(clean, ListU64_pushBack(&l, i, alloc, e_rr));
+	}
 
 	*find->result = l;
 
@@ -505,22 +503,17 @@ Bool CharString_findAllString(const CharStringFind *find, const CharString *othe
 	gotoIfError3(clean, ListU64_reserve(&l, (strl - off) / otherl / 25 + 16, find->alloc, e_rr));
 	alloc = find->alloc;
 
-	EStringTransform transform = (EStringTransform) caseSensitive;
+	const Bool insensitive = caseSensitive == EStringCase_Insensitive;
 
-	for (U64 i = off; i < strl; ++i) {
+	for (U64 i = off; i < strl; i += otherl) {
 
-		Bool match = true;
+		const U64 found = StringSearch_findString(sPtr + i, strl - i, otherPtr, otherl, insensitive);
 
-		for (U64 j = i, k = 0; j < strl && k < otherl; ++j, ++k)
-			if (C8_transform(sPtr[j], transform) != C8_transform(otherPtr[k], transform)) {
-				match = false;
-				break;
-			}
+		if(found == U64_MAX)
+			break;
 
-		if (match) {
-			gotoIfError3(clean, ListU64_pushBack(&l, i, alloc, e_rr));
-			i += otherl - 1;
-		}
+		i += found;
+		gotoIfError3(clean, ListU64_pushBack(&l, i, alloc, e_rr));
 	}
 
 	*find->result = l;
@@ -644,8 +637,7 @@ clean:
 }
 
 U64 CharString_hash(const CharString s) {
-	U64 hash = Buffer_fnv1a64Single(CharString_length(s), Buffer_fnv1a64Offset);
-	return Buffer_fnv1a64(CharString_bufferConst(s), hash);
+	return Buffer_hash64(CharString_bufferConst(s), 0);
 }
 
 Bool ListCharString_concat(const ListCharStringConcat *conc, C8 between, Error *e_rr) {
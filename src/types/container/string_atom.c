@@ -0,0 +1,155 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/string_atom.c
+
+#include "types/container/string_atom.h"
+#include "types/container/string.h"
+#include "types/container/buffer.h"
+
+Bool StringAtomTable_create(const Allocator *alloc, StringAtomTable *table, Error *e_rr) {
+
+	Bool s_uccess = true;
+	Buffer pages = Buffer_createNull();
+
+	if(!alloc || !table)
+		retError(clean, Error_nullPointer(!alloc ? 0 : 1, "StringAtomTable_create()::alloc and table are required"));
+
+	if(table->pages)
+		retError(clean, Error_invalidParameter(1, 0, "StringAtomTable_create()::table wasn't empty, might indicate memleak"));
+
+	gotoIfError3(clean, Buffer_createEmptyBytes(sizeof(StringAtomEntry*) * StringAtomTable_maxPages, alloc, &pages, e_rr));
+	gotoIfError3(clean, Arena_create(0, 0, EArenaFlags_None, alloc, &table->arena, e_rr));
+
+	gotoIfError3(clean, StringAtomMap_createCustom(
+		0, GenericHashMap_hashString, GenericHashMap_equalsString, alloc, &table->map, e_rr
+	));
+
+	table->pages = (StringAtomEntry**) pages.ptr;
+	table->alloc = alloc;
+	AtomicI64_store(&table->count, 1);
+	pages = Buffer_createNull();
+
+clean:
+
+	if (!s_uccess && table) {
+		Arena_free(&table->arena);
+		StringAtomMap_free(&table->map, alloc);
+	}
+
+	Buffer_free(&pages, alloc);
+	return s_uccess;
+}
+
+void StringAtomTable_free(StringAtomTable *table) {
+
+	if(!table || !table->pages)
+		return;
+
+	StringAtomMap_free(&table->map, table->alloc);
+	Arena_free(&table->arena);
+
+	Buffer pages = Buffer_createManagedPtr(table->pages, sizeof(StringAtomEntry*) * StringAtomTable_maxPages);
+	Buffer_free(&pages, table->alloc);
+
+	*table = (StringAtomTable) { 0 };
+}
+
+StringAtom StringAtomTable_find(StringAtomTable *table, CharString str) {
+
+	if(!table || !table->pages)
+		return StringAtom_none;
+
+	if(RWLock_lockRead(&table->lock, U64_MAX) < ELockAcquire_Success)
+		return StringAtom_none;
+
+	StringAtom atom = StringAtom_none;
+	StringAtomMap_get(&table->map, str, &atom);
+
+	RWLock_unlockRead(&table->lock);
+	return atom;
+}
+
+Bool StringAtomTable_intern(StringAtomTable *table, CharString str, StringAtom *atom, Error *e_rr) {
+
+	Bool s_uccess = true;
+	ELockAcquire acq = ELockAcquire_Invalid;
+
+	if(!table || !table->pages || !atom)
+		retError(clean, Error_nullPointer(!atom ? 2 : 0, "StringAtomTable_intern()::table and atom are required"));
+
+	//Most interns are of names that are already there, which only needs the read lock
+
+	*atom = StringAtomTable_find(table, str);
+
+	if(*atom)
+		goto clean;
+
+	acq = RWLock_lockWrite(&table->lock, U64_MAX);
+
+	if(acq < ELockAcquire_Success)
+		retError(clean, Error_invalidState(0, "StringAtomTable_intern() couldn't acquire the write lock"));
+
+	if(StringAtomMap_get(&table->map, str, atom))        //Someone else was first
+		goto clean;
+
+	const U64 next = (U64) AtomicI64_load(&table->count);
+
+	if(next >= StringAtomTable_pageSize * StringAtomTable_maxPages)
+		retError(clean, Error_outOfBounds(
+			0, next, StringAtomTable_pageSize * StringAtomTable_maxPages, "StringAtomTable_intern() table is full"
+		));
+
+	StringAtomEntry **page = &table->pages[next / StringAtomTable_pageSize];
+
+	if (!*page) {
+		Buffer pageBuf = Buffer_createNull();
+		gotoIfError3(clean, Buffer_createUninitializedBytes(
+			sizeof(StringAtomEntry) * StringAtomTable_pageSize, &table->arena.allocator, &pageBuf, e_rr
+		));
+		*page = (StringAtomEntry*) pageBuf.ptr;
+	}
+
+	//Characters are copied with a null terminator, so the string can be passed to C APIs as is
+
+	const U64 len = CharString_length(str);
+	Buffer chars = Buffer_createNull();
+	gotoIfError3(clean, Buffer_createUninitializedBytes(len + 1, &table->arena.allocator, &chars, e_rr));
+	Buffer_memcpy(chars, CharString_bufferConst(str));
+	((C8*)chars.ptr)[len] = '\0';
+
+	StringAtomEntry *entry = &(*page)[next % StringAtomTable_pageSize];
+	*entry = (StringAtomEntry) { .str = CharString_createRefSizedConst((const C8*) chars.ptr, len, true) };
+	entry->hash = CharString_hash(entry->str);
+
+	gotoIfError3(clean, StringAtomMap_insert(&table->map, entry->str, (StringAtom) next, table->alloc, e_rr));
+
+	//Published last, the lock free readers only look at entries below count
+
+	AtomicI64_store(&table->count, (I64) next + 1);
+	*atom = (StringAtom) next;
+
+clean:
+
+	if(acq == ELockAcquire_Acquired)
+		RWLock_unlockWrite(&table->lock);
+
+	return s_uccess;
+}
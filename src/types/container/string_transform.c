@@ -24,6 +24,7 @@
 #include "types/container/string.h"
 #include "types/base/string_read.h"
 #include "types/base/string_mut.h"
+#include "types/base/string_search.h"
 #include "types/base/c8.h"
 #include "types/base/constants.h"
 
@@ -153,7 +154,7 @@ Bool CharString_replaceAllString(const CharStringReplace2 *replace, EStringCase
 
 	Bool s_uccess = true;
 	const Allocator *alloc = NULL;
-	ListU64 finds = { 0 };
+	CharString out = CharString_createNull();
 
 	if (!replace || !replace->s || !replace->search || !replace->replace)
 		retError(clean, Error_nullPointer(0, "CharString_replaceAllString()::replace is required"));
@@ -163,94 +164,90 @@ Bool CharString_replaceAllString(const CharStringReplace2 *replace, EStringCase
 	if(CharString_isRef(*replace->s))
 		retError(clean, Error_constData(0, 0, "CharString_replaceAllString()::replace->s must be managed memory"));
 
-	const CharStringFind find = { replace->s, replace->allocator, replace->off, replace->len, &finds };
-	gotoIfError3(clean, CharString_findAllString(&find, replace->search, caseSensitive, e_rr));
-
-	if (!finds.length)
-		goto clean;
-
-	const U64 *ptr = finds.ptr;
 	const U64 searchl = CharString_length(*replace->search);
 	const U64 replacel = CharString_length(*replace->replace);
 	const U64 strl = CharString_length(*replace->s);
-	const Buffer replaceBuf = CharString_bufferConst(*replace->replace);
+	const U64 off = replace->off;
+	const U64 end = replace->len ? off + replace->len : strl;
 
-	//Same size; overwrite in place, no resize and no moving
+	if(!searchl)
+		retError(clean, Error_invalidParameter(1, 0, "CharString_replaceAllString()::search is empty"));
 
-	if (searchl == replacel) {
+	if(off >= strl || end > strl)
+		retError(clean, Error_invalidParameter(4, 0, "CharString_replaceAllString()::off or len is out of bounds"));
 
-		C8 *sPtr = replace->s->ptrNonConst;
+	const C8 *searchPtr = replace->search->ptr;
+	const Buffer replaceBuf = CharString_bufferConst(*replace->replace);
+	const Bool insensitive = caseSensitive == EStringCase_Insensitive;
+	C8 *sPtr = replace->s->ptrNonConst;
+
+	//Counting is the same vectorized scan as finding, so it's cheap to do first.
+	//It gives the exact output size, so nothing is grown repeatedly and no list of matches is kept around.
 
-		for (U64 i = 0; i < finds.length; ++i)
-			Buffer_memcpy(Buffer_createRef(sPtr + ptr[i], replacel), replaceBuf);
+	const U64 count = StringSearch_countString(sPtr + off, end - off, searchPtr, searchl, insensitive);
 
+	if (!count)
 		goto clean;
-	}
 
-	//Shrinking; walk left to right, since every byte moves towards the front
+	const U64 newLen = strl - count * searchl + count * replacel;
 
-	if (searchl > replacel) {
+	//Not growing; in place left to right, since the write position never passes the read position
 
-		C8 *sPtr = replace->s->ptrNonConst;
-		U64 write = ptr[0];
+	if (replacel <= searchl) {
 
-		for (U64 i = 0; i < finds.length; ++i) {
+		U64 read = off, write = off;
 
-			Buffer_memcpy(Buffer_createRef(sPtr + write, replacel), replaceBuf);
-			write += replacel;
+		for (U64 i = 0; i < count; ++i) {
 
-			//The run between this match and the next one (or the end of the string) follows it
+			const U64 found = read + StringSearch_findString(sPtr + read, end - read, searchPtr, searchl, insensitive);
 
-			const U64 tailStart = ptr[i] + searchl;
-			const U64 tailEnd = i + 1 == finds.length ? strl : ptr[i + 1];
+			if(write != read)
+				Buffer_memmove(Buffer_createRef(sPtr + write, found - read), Buffer_createRef(sPtr + read, found - read));
 
-			Buffer_memmove(
-				Buffer_createRef(sPtr + write, tailEnd - tailStart),
-				Buffer_createRef(sPtr + tailStart, tailEnd - tailStart)
-			);
-
-			write += tailEnd - tailStart;
+			write += found - read;
+			Buffer_memcpy(Buffer_createRef(sPtr + write, replacel), replaceBuf);
+			write += replacel;
+			read = found + searchl;
 		}
 
-		gotoIfError3(clean, CharString_resize(replace->s, write, ' ', alloc, e_rr));
+		if(write != read)
+			Buffer_memmove(Buffer_createRef(sPtr + write, strl - read), Buffer_createRef(sPtr + read, strl - read));
+
+		gotoIfError3(clean, CharString_resize(replace->s, newLen, ' ', alloc, e_rr));
 		goto clean;
 	}
 
-	//Growing; resize first, then walk right to left so nothing is overwritten before it's read.
-	//The pointer has to be re-read afterwards, since the resize may have reallocated.
+	//Growing; one allocation of the exact size that's written front to back in a single pass, then swapped in
 
-	const U64 newLen = strl + (replacel - searchl) * finds.length;
-	gotoIfError3(clean, CharString_resize(replace->s, newLen, ' ', alloc, e_rr));
+	gotoIfError3(clean, CharString_reserve(&out, newLen, alloc, e_rr));
 
-	{
-		C8 *sPtr = replace->s->ptrNonConst;
-		U64 readEnd = strl;            //end of the not yet moved region, in the old layout
-		U64 write = newLen;            //end of the already written region, in the new layout
+	C8 *outPtr = out.ptrNonConst;
+	Buffer_memcpy(Buffer_createRef(outPtr, off), Buffer_createRef(sPtr, off));
 
-		for (U64 i = finds.length - 1; i != U64_MAX; --i) {
+	U64 read = off, write = off;
 
-			const U64 tailStart = ptr[i] + searchl;
-			const U64 tailLen = readEnd - tailStart;
+	for (U64 i = 0; i < count; ++i) {
 
-			write -= tailLen;
+		const U64 found = read + StringSearch_findString(sPtr + read, end - read, searchPtr, searchl, insensitive);
 
-			Buffer_memmove(
-				Buffer_createRef(sPtr + write, tailLen),
-				Buffer_createRef(sPtr + tailStart, tailLen)
-			);
+		Buffer_memcpy(Buffer_createRef(outPtr + write, found - read), Buffer_createRef(sPtr + read, found - read));
+		write += found - read;
 
-			write -= replacel;
-			Buffer_memcpy(Buffer_createRef(sPtr + write, replacel), replaceBuf);
-
-			readEnd = ptr[i];
-		}
+		Buffer_memcpy(Buffer_createRef(outPtr + write, replacel), replaceBuf);
+		write += replacel;
+		read = found + searchl;
 	}
 
-clean:
+	Buffer_memcpy(Buffer_createRef(outPtr + write, strl - read), Buffer_createRef(sPtr + read, strl - read));
+	outPtr[newLen] = '\0';
+	out.lenAndNullTerminated = newLen | ((U64)1 << 63);
 
-	if(alloc)
-		ListU64_free(&finds, alloc);
+	CharString_free(replace->s, alloc);
+	*replace->s = out;
+	out = CharString_createNull();
 
+clean:
+	CharString_free(&out, alloc);
 	return s_uccess;
 }
 
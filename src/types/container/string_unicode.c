@@ -22,48 +22,34 @@
 
 #include "types/container/string.h"
 #include "types/container/list_basic_types.h"
+#include "types/base/unicode.h"
 
 Bool CharString_createFromUTF16(const U16 *ptr, U64 limit, const Allocator *allocator, CharString *result, Error *e_rr) {
 
 	Bool s_uccess = true;
 	Bool alloc = false;
 
-	gotoIfError3(clean, CharString_reserve(result, limit == U64_MAX ? 16 : (limit * 4 + 1), allocator, e_rr));
-	alloc = true;
-
-	UnicodeCodePointInfo codepoint = { 0 };
-	U64 j = 0;
-
-	const Buffer buf = Buffer_createRefConst(ptr, limit == U64_MAX ? ((U64)1 << 48) - 1 : limit * sizeof(U16));
-	Buffer buf0 = CharString_allocatedBuffer(*result);
-
-	for(U64 i = 0; i < limit * 2; ) {
+	if(!ptr && limit)
+		retError(clean, Error_nullPointer(0, "CharString_createFromUTF16()::ptr is required"));
 
-		U16 c = ptr[i >> 1];
+	//Up to the null terminator or limit, then one pass to validate and size it and one to convert
 
-		if (!c) {
-			result->lenAndNullTerminated = j | ((U64)1 << 63);
-			break;
-		}
+	U64 len = 0;
 
-		if(limit == U64_MAX) {
-			gotoIfError3(clean, CharString_reserve(result, j + 5, allocator, e_rr));
-			buf0 = CharString_allocatedBuffer(*result);
-		}
+	while(len < limit && ptr[len])
+		++len;
 
-		//Read as UTF16 encoding
+	UnicodeLengths lengths = (UnicodeLengths) { 0 };
 
-		gotoIfError3(clean, Buffer_readAsUTF16(buf, i, &codepoint, e_rr));
-		i += codepoint.bytes;
+	if(!Unicode_validateUTF16(ptr, len, &lengths))
+		retError(clean, Error_invalidParameter(0, 0, "CharString_createFromUTF16()::ptr didn't contain valid UTF16"));
 
-		//Write as UTF8 encoding
+	gotoIfError3(clean, CharString_reserve(result, lengths.utf8, allocator, e_rr));
+	alloc = true;
 
-		gotoIfError3(clean, Buffer_writeAsUTF8(buf0, j, codepoint.index, &codepoint.bytes, e_rr));
-		j += codepoint.bytes;
-		result->lenAndNullTerminated = j | ((U64)1 << 63);
-	}
-
-	result->ptrNonConst[j] = '\0';
+	Unicode_utf16ToUTF8(ptr, len, (U8*) result->ptrNonConst);
+	result->ptrNonConst[lengths.utf8] = '\0';
+	result->lenAndNullTerminated = lengths.utf8 | ((U64)1 << 63);
 
 clean:
 
@@ -78,36 +64,37 @@ Bool CharString_createFromUTF32(const U32 *ptr, U64 limit, const Allocator *allo
 	Bool s_uccess = true;
 	Bool alloc = false;
 
-	gotoIfError3(clean, CharString_reserve(result, limit == U64_MAX ? 16 : (limit * 4 + 1), allocator, e_rr));
-	alloc = true;
+	if(!ptr && limit)
+		retError(clean, Error_nullPointer(0, "CharString_createFromUTF32()::ptr is required"));
 
-	UnicodeCodePointInfo codepoint = { 0 };
-	U64 j = 0;
+	//Size first, so the string is allocated once
 
-	Buffer buf0 = CharString_allocatedBuffer(*result);
+	U64 len = 0, bytes = 0;
 
-	for(U64 i = 0; i < limit; ++i) {
+	for (; len < limit && ptr[len]; ++len) {
 
-		U32 c = ptr[i];
+		const U32 c = ptr[len];
 
-		if (!c) {
-			result->lenAndNullTerminated = j | ((U64)1 << 63);
-			break;
-		}
+		if(c > 0x10FFFF)
+			retError(clean, Error_invalidParameter(0, 0, "CharString_createFromUTF32()::ptr[i] out of bounds (>0x10FFFF)"));
 
-		if(limit == U64_MAX) {
-			gotoIfError3(clean, CharString_reserve(result, j + 5, allocator, e_rr));
-			buf0 = CharString_allocatedBuffer(*result);
-		}
+		bytes += c < 0x80 ? 1 : (c < 0x800 ? 2 : (c < 0x10000 ? 3 : 4));
+	}
 
-		//Write as UTF8 encoding
+	gotoIfError3(clean, CharString_reserve(result, bytes, allocator, e_rr));
+	alloc = true;
+
+	const Buffer buf0 = CharString_allocatedBuffer(*result);
+	U64 j = 0;
 
-		gotoIfError3(clean, Buffer_writeAsUTF8(buf0, j, c, &codepoint.bytes, e_rr));
-		j += codepoint.bytes;
-		result->lenAndNullTerminated = j | ((U64)1 << 63);
+	for (U64 i = 0; i < len; ++i) {
+		U8 written = 0;
+		gotoIfError3(clean, Buffer_writeAsUTF8(buf0, j, ptr[i], &written, e_rr));
+		j += written;
 	}
 
 	result->ptrNonConst[j] = '\0';
+	result->lenAndNullTerminated = j | ((U64)1 << 63);
 
 clean:
 
@@ -122,45 +109,31 @@ Bool CharString_toUTF16(const CharString s, const Allocator *allocator, ListU16
 	Bool s_uccess = true;
 	Bool alloc = false;
 
-	const U64 len = CharString_length(s);
-
 	if(!arr)
 		retError(clean, Error_nullPointer(0, "CharString_toUTF16()::arr is required"));
 
+	UnicodeLengths lengths = (UnicodeLengths) { 0 };
+
+	if(!Unicode_validateUTF8((const U8*) s.ptr, CharString_length(s), &lengths))
+		retError(clean, Error_invalidParameter(0, 0, "CharString_toUTF16()::s didn't contain valid UTF8"));
+
 	Bool isRef = arr->length && ListU16_isRef(*arr);
 
 	if(!isRef) {
-		gotoIfError3(clean, ListU16_reserve(arr, len + 1, allocator, e_rr));
+		gotoIfError3(clean, ListU16_reserve(arr, lengths.utf16 + 1, allocator, e_rr));
 		alloc = true;
 	}
 
 	else if(ListU16_isConstRef(*arr))
 		retError(clean, Error_constData(0, 0, "CharString_toUTF16()::arr should be writable"));
 
-	const Buffer buf0 = isRef ? ListU16_buffer(*arr) : ListU16_allocatedBuffer(*arr);
-	const Buffer buf = CharString_bufferConst(s);
-	UnicodeCodePointInfo codepoint = { 0 };
-
-	U64 j = 0;
-
-	for (U64 i = 0; i < len; ) {
-
-		//Read as UTF8 encoding
-
-		gotoIfError3(clean, Buffer_readAsUTF8(buf, i, &codepoint, e_rr));
-		i += codepoint.bytes;
-
-		//Write as UTF16 encoding
-
-		gotoIfError3(clean, Buffer_writeAsUTF16(buf0, j, codepoint.index, &codepoint.bytes, e_rr));
-		j += codepoint.bytes;
-	}
+	if(isRef && arr->length < lengths.utf16 + 1)
+		retError(clean, Error_outOfBounds(0, lengths.utf16 + 1, arr->length, "CharString_toUTF16()::arr is too small"));
 
-	if(j + 2 > Buffer_length(buf0))
-		retError(clean, Error_outOfBounds(0, j + 1, Buffer_length(buf0), "CharString_toUTF16() no space for null terminator"));
+	Unicode_utf8ToUTF16((const U8*) s.ptr, CharString_length(s), arr->ptrNonConst);
 
-	arr->ptrNonConst[j / 2] = 0;
-	arr->length = j / 2 + 1;
+	arr->ptrNonConst[lengths.utf16] = 0;
+	arr->length = lengths.utf16 + 1;
 
 clean:
 
@@ -175,27 +148,18 @@ Bool CharString_toUTF32(const CharString s, const Allocator *allocator, ListU32
 	Bool s_uccess = true;
 	Bool alloc = false;
 
-	const U64 len = CharString_length(s);
-	gotoIfError3(clean, ListU32_reserve(arr, len + 1, allocator, e_rr));
-	alloc = true;
-
-	const Buffer buf = CharString_bufferConst(s);
-	UnicodeCodePointInfo codepoint = { 0 };
-
-	U32 *buf0 = arr->ptrNonConst;
-
-	U64 j = 0;
+	UnicodeLengths lengths = (UnicodeLengths) { 0 };
 
-	for (U64 i = 0; i < len; ) {
+	if(!Unicode_validateUTF8((const U8*) s.ptr, CharString_length(s), &lengths))
+		retError(clean, Error_invalidParameter(0, 0, "CharString_toUTF32()::s didn't contain valid UTF8"));
 
-		gotoIfError3(clean, Buffer_readAsUTF8(buf, i, &codepoint, e_rr));    //Read as UTF8 encoding
-		i += codepoint.bytes;
+	gotoIfError3(clean, ListU32_reserve(arr, lengths.codepoints + 1, allocator, e_rr));
+	alloc = true;
 
-		buf0[j++] = codepoint.index;                                        //Write as UTF32 encoding
-	}
+	Unicode_utf8ToUTF32((const U8*) s.ptr, CharString_length(s), arr->ptrNonConst);
 
-	arr->ptrNonConst[j] = 0;
-	arr->length = j;
+	arr->ptrNonConst[lengths.codepoints] = 0;
+	arr->length = lengths.codepoints;
 
 clean:
 
@@ -206,20 +170,6 @@ clean:
 }
 
 U64 CharString_unicodeCodepoints(const CharString str) {
-
-	U64 i = 0, j = 0;
-	Buffer buf = CharString_bufferConst(str);
-
-	while(i < Buffer_length(buf)) {
-
-		UnicodeCodePointInfo codePoint = (UnicodeCodePointInfo) { 0 };
-
-		if(!Buffer_readAsUTF8(buf, i, &codePoint, NULL))
-			return U64_MAX;
-
-		i += codePoint.bytes;
-		++j;
-	}
-
-	return j;
+	UnicodeLengths lengths = (UnicodeLengths) { 0 };
+	return Unicode_validateUTF8((const U8*) str.ptr, CharString_length(str), &lengths) ? lengths.codepoints : U64_MAX;
 }
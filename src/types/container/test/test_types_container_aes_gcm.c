@@ -25,6 +25,7 @@
 #include "types/math/vec4i.h"
 #include "types/container/buffer_encrypt.h"
 #include "types/container/string.h"
+#include "types/container/job_queue.h"
 
 //Shared loop used for both AES256 and AES128 test vectors.
 //Each test vector is: encrypt -> verify ciphertext + tag -> decrypt -> verify plaintext.
@@ -360,6 +361,214 @@ void Test_aesValidation(Test *t) {
 	Buffer_free(&full, t->alloc);
 }
 
+//Fails on purpose, so the queue is already marked as failed before the parallel path uses it
+static Bool Test_aesFailingJob(void *data, U64 threadId, JobQueue *queue) {
+	(void) data; (void) threadId; (void) queue;
+	return false;
+}
+
+//The parallel path splits in 4 MiB+ chunks that have to give the same ciphertext and tag as the serial one.
+//The odd length leaves a partial block at the end of the last chunk.
+
+void Test_aesParallel(Test *t) {
+
+	Test_setModule(t, "aes256gcm parallel");
+
+	JobQueue queue = (JobQueue) { 0 };
+	Buffer serial = Buffer_createNull(), parallel = Buffer_createNull(), aad = Buffer_createNull();
+
+	const U64 len = 17 * MIBI + 5;
+
+	if (
+		!Test_assert(t, "alloc", Buffer_createUninitializedBytes(len, t->alloc, &serial, &t->err)) ||
+		!Test_assert(t, "alloc", Buffer_createUninitializedBytes(len, t->alloc, &parallel, &t->err)) ||
+		!Test_assert(t, "alloc aad", Buffer_createUninitializedBytes(37, t->alloc, &aad, &t->err)) ||
+		!Test_assert(t, "create queue", JobQueue_create(4, t->alloc, &queue, &t->err))
+	)
+		goto clean;
+
+	for (U64 i = 0; i < len; ++i)
+		serial.ptrNonConst[i] = (U8)(i ^ (i >> 13));
+
+	for (U64 i = 0; i < Buffer_length(aad); ++i)
+		aad.ptrNonConst[i] = (U8) i;
+
+	Buffer_memcpy(parallel, serial);
+
+	U32 key[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	I32x4 iv = I32x4_create4(0x12345678, 0x9ABCDEF0, 0x0F1E2D3C, 0);
+	I32x4 tagSerial = I32x4_zero(), tagParallel = I32x4_zero();
+
+	BufferEncrypt encrypt = (BufferEncrypt) {
+		.target = &serial,
+		.additionalData = &aad,
+		.type = EBufferEncryptionType_AES256GCM,
+		.flags = EBufferEncryptionFlags_StopCreateIv,
+		.nonConstEncrypt = { .key = key, .tag = &tagSerial, .iv = &iv }
+	};
+
+	Test_assert(t, "encrypt serial", Buffer_encryptAdvanced(&encrypt, &t->err));
+
+	encrypt.target = &parallel;
+	encrypt.queue = &queue;
+	encrypt.nonConstEncrypt.tag = &tagParallel;
+
+	Test_assert(t, "encrypt parallel", Buffer_encryptAdvanced(&encrypt, &t->err));
+	Test_assert(t, "same ciphertext", Buffer_eq(serial, parallel));
+	Test_assert(t, "same tag", I32x4_eq4(tagSerial, tagParallel));
+
+	encrypt.flags = EBufferEncryptionFlags_None;
+	Test_assert(t, "decrypt parallel", Buffer_decryptAdvanced(&encrypt, &t->err));
+
+	Bool plainText = true;
+
+	for (U64 i = 0; i < len; ++i)
+		plainText &= parallel.ptr[i] == (U8)(i ^ (i >> 13));
+
+	Test_assert(t, "plaintext", plainText);
+
+	//Someone else's failed job on the same queue doesn't fail the chunks
+
+	if (
+		Test_assert(t, "push failing job", JobQueue_push(&queue, Test_aesFailingJob, NULL, &t->err)) &&
+		Test_assert(t, "wait failing job", JobQueue_wait(&queue, &t->err) && !JobQueue_isSuccess(&queue))
+	) {
+		encrypt.flags = EBufferEncryptionFlags_StopCreateIv;
+		Test_assert(t, "encrypt failed queue", Buffer_encryptAdvanced(&encrypt, &t->err));
+		Test_assert(t, "failed queue tag", I32x4_eq4(tagSerial, tagParallel));
+		encrypt.flags = EBufferEncryptionFlags_None;
+	}
+
+	//A bad tag has to be rejected and the target cleared, just like serial
+
+	I32x4_setWRef(&tagParallel, I32x4_w(tagParallel) ^ 1);
+	Buffer_memcpy(parallel, serial);
+
+	Test_assert(t, "decrypt bad tag", !Buffer_decryptAdvanced(&encrypt, NULL));
+	Test_assert(t, "cleared", !parallel.ptr[12345] && !parallel.ptr[len - 1]);
+
+clean:
+	JobQueue_free(&queue);
+	Buffer_free(&aad, t->alloc);
+	Buffer_free(&parallel, t->alloc);
+	Buffer_free(&serial, t->alloc);
+}
+
+//The software fallback has to produce exactly what the hardware path does (if there is one) for every length,
+// including the tails, AAD that isn't a multiple of 16 and the parallel path.
+
+void Test_aesSoftware(Test *t) {
+
+	Test_setModule(t, "aes256gcm software");
+
+	JobQueue queue = (JobQueue) { 0 };
+	Buffer hardware = Buffer_createNull(), software = Buffer_createNull(), aad = Buffer_createNull();
+
+	const U64 len = 9 * MIBI + 3;
+
+	if (
+		!Test_assert(t, "alloc", Buffer_createUninitializedBytes(len, t->alloc, &hardware, &t->err)) ||
+		!Test_assert(t, "alloc", Buffer_createUninitializedBytes(len, t->alloc, &software, &t->err)) ||
+		!Test_assert(t, "alloc aad", Buffer_createUninitializedBytes(53, t->alloc, &aad, &t->err)) ||
+		!Test_assert(t, "create queue", JobQueue_create(2, t->alloc, &queue, &t->err))
+	)
+		goto clean;
+
+	for (U64 i = 0; i < Buffer_length(aad); ++i)
+		aad.ptrNonConst[i] = (U8)(i * 7);
+
+	U32 key[8] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+	I32x4 iv = I32x4_create4(0x01234567, 0x89ABCDEF, 0x76543210, 0);
+	Bool sameCipher = true, sameTag = true, decrypted = true;
+
+	for (U8 type = 0; type < 2; ++type)
+		for (U64 l = 0; l <= 300; l += (l < 40 ? 1 : 13)) {
+
+			const U64 aadLen = l % Buffer_length(aad);
+
+			for (U64 i = 0; i < l; ++i)
+				hardware.ptrNonConst[i] = software.ptrNonConst[i] = (U8)(i * 31 + l);
+
+			Buffer hw = Buffer_createRef(hardware.ptrNonConst, l);
+			Buffer sw = Buffer_createRef(software.ptrNonConst, l);
+			Buffer ad = Buffer_createRefConst(aad.ptr, aadLen);
+			I32x4 tagHw = I32x4_zero(), tagSw = I32x4_zero();
+
+			BufferEncrypt encrypt = (BufferEncrypt) {
+				.target = &hw,
+				.additionalData = aadLen ? &ad : NULL,
+				.type = type ? EBufferEncryptionType_AES128GCM : EBufferEncryptionType_AES256GCM,
+				.flags = EBufferEncryptionFlags_StopCreateIv,
+				.nonConstEncrypt = { .key = key, .tag = &tagHw, .iv = &iv }
+			};
+
+			sameCipher &= Buffer_encryptAdvanced(&encrypt, NULL);
+
+			Buffer_aesForceSoftware(true);
+
+			encrypt.target = &sw;
+			encrypt.nonConstEncrypt.tag = &tagSw;
+			sameCipher &= Buffer_encryptAdvanced(&encrypt, NULL);
+
+			sameCipher &= Buffer_eq(sw, hw) || !l;
+			sameTag &= I32x4_eq4(tagHw, tagSw);
+
+			//Software has to accept the hardware's ciphertext too
+
+			encrypt.flags = EBufferEncryptionFlags_None;
+			encrypt.target = &hw;
+			decrypted &= Buffer_decryptAdvanced(&encrypt, NULL);
+
+			Buffer_aesForceSoftware(false);
+
+			for (U64 i = 0; i < l; ++i)
+				decrypted &= hardware.ptr[i] == (U8)(i * 31 + l);
+		}
+
+	Test_assert(t, "same ciphertext", sameCipher);
+	Test_assert(t, "same tag", sameTag);
+	Test_assert(t, "decrypt", decrypted);
+
+	//Large enough to be split over the queue, with the software mulH folding the tags
+
+	for (U64 i = 0; i < len; ++i)
+		hardware.ptrNonConst[i] = (U8)(i ^ (i >> 11));
+
+	Buffer_memcpy(software, hardware);
+
+	I32x4 tagHw = I32x4_zero(), tagSw = I32x4_zero();
+
+	BufferEncrypt encrypt = (BufferEncrypt) {
+		.target = &hardware,
+		.additionalData = &aad,
+		.type = EBufferEncryptionType_AES256GCM,
+		.flags = EBufferEncryptionFlags_StopCreateIv,
+		.nonConstEncrypt = { .key = key, .tag = &tagHw, .iv = &iv }
+	};
+
+	Test_assert(t, "encrypt hardware", Buffer_encryptAdvanced(&encrypt, &t->err));
+
+	Buffer_aesForceSoftware(true);
+
+	encrypt.target = &software;
+	encrypt.queue = &queue;
+	encrypt.nonConstEncrypt.tag = &tagSw;
+
+	Test_assert(t, "encrypt software parallel", Buffer_encryptAdvanced(&encrypt, &t->err));
+
+	Buffer_aesForceSoftware(false);
+
+	Test_assert(t, "same ciphertext parallel", Buffer_eq(hardware, software));
+	Test_assert(t, "same tag parallel", I32x4_eq4(tagHw, tagSw));
+
+clean:
+	Buffer_aesForceSoftware(false);
+	JobQueue_free(&queue);
+	Buffer_free(&aad, t->alloc);
+	Buffer_free(&software, t->alloc);
+	Buffer_free(&hardware, t->alloc);
+}
+
 //Test vectors 13-16: https://luca-giuzzi.unibs.it/corsi/Support/papers-cryptography/gcm-spec.pdf
 //Test vectors 2.1.2, 2.8.2: https://www.ieee802.org/1/files/public/docs2011/bn-randall-test-vectors-0511-v1.pdf
 
@@ -644,9 +853,17 @@ void Test_aes256gcm(Test *t) {
 
 	runAesVectors(t, EBufferEncryptionType_AES256GCM, sizeof(keys) / sizeof(keys[0]), keys, plainTexts, aad, ivs, results);
 
+	//Same vectors through the constant-time software fallback
+
+	Buffer_aesForceSoftware(true);
+	runAesVectors(t, EBufferEncryptionType_AES256GCM, sizeof(keys) / sizeof(keys[0]), keys, plainTexts, aad, ivs, results);
+	Buffer_aesForceSoftware(false);
+
 	//Test different chunkSizes for AVX2/AVX512/etc.
 
 	Test_aesValidation(t);
+	Test_aesParallel(t);
+	Test_aesSoftware(t);
 }
 
 void Test_aes128gcm(Test *t) {
@@ -871,4 +1088,8 @@ void Test_aes128gcm(Test *t) {
 	};
 
 	runAesVectors(t, EBufferEncryptionType_AES128GCM, sizeof(keys) / sizeof(keys[0]), keys, plainTexts, aad, ivs, results);
+
+	Buffer_aesForceSoftware(true);
+	runAesVectors(t, EBufferEncryptionType_AES128GCM, sizeof(keys) / sizeof(keys[0]), keys, plainTexts, aad, ivs, results);
+	Buffer_aesForceSoftware(false);
 }
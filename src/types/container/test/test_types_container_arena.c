@@ -0,0 +1,213 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_arena.c
+
+#include "test_types_container_shared.h"
+#include "types/container/arena.h"
+#include "types/container/buffer.h"
+#include "types/container/list_basic_types.h"
+#include "types/container/string.h"
+#include "types/base/string_read_helper.h"
+
+void Test_arena(Test *t) {
+
+	const Allocator *alloc = t->alloc;
+	Error *e_rr = &t->err;
+
+	Test_setModule(t, "Arena");
+
+	//1. Regular containers on top of an arena, released by a single rewind.
+
+	{
+		Arena arena = (Arena) { 0 };
+
+		if (Test_assert(t, "create", Arena_create(4096, 0, EArenaFlags_None, alloc, &arena, e_rr))) {
+
+			const Allocator *a = &arena.allocator;
+			const ArenaMark start = Arena_mark(&arena);
+
+			ListU32 list = (ListU32) { 0 };
+			Bool ok = true;
+
+			for(U32 i = 0; ok && i < 10000; ++i)
+				ok = ListU32_pushBack(&list, i, a, e_rr);
+
+			Bool valid = ok && list.length == 10000;
+			for(U32 i = 0; valid && i < 10000; ++i)
+				valid = list.ptr[i] == i;
+
+			Test_assert(t, "list grows in arena", valid);
+			Test_assert(t, "big allocations get their own chunk", arena.reserved >= 40000);
+
+			CharString str = CharString_createNull();
+			Test_assert(t, "format in arena", CharString_format(a, &str, e_rr, "%s %i", "arena", 42));
+			Test_assert(t, "format result", CharString_equalsCStringSensitive(&str, "arena 42"));
+
+			Buffer aligned = Buffer_createNull();
+			Test_assert(t, "aligned alloc", Buffer_createEmptyBytesAligned(100, 64, 0, a, &aligned, e_rr));
+			Test_assert(t, "aligned result", !((U64) aligned.ptr & 63));
+			Buffer_free(&aligned, a);
+
+			Test_assert(t, "rewind", !Arena_rewind(&arena, start));
+			Test_assert(t, "rewind released chunks", !arena.current && arena.reserved == 0);
+		}
+
+		Arena_free(&arena);
+	}
+
+	//2. Marks nest and the most recent allocation can be given back.
+
+	{
+		Arena arena = (Arena) { 0 };
+
+		if (Test_assert(t, "create nested", Arena_create(1024, 0, EArenaFlags_None, alloc, &arena, e_rr))) {
+
+			const Allocator *a = &arena.allocator;
+			Buffer b0 = Buffer_createNull(), b1 = Buffer_createNull(), b2 = Buffer_createNull();
+
+			Test_assert(t, "alloc b0", Buffer_createUninitializedBytes(100, a, &b0, e_rr));
+			const ArenaMark outer = Arena_mark(&arena);
+
+			Test_assert(t, "alloc b1", Buffer_createUninitializedBytes(200, a, &b1, e_rr));
+			const U64 used = Arena_mark(&arena).used;
+
+			Test_assert(t, "alloc b2", Buffer_createUninitializedBytes(16, a, &b2, e_rr));
+			Buffer_free(&b2, a);
+			Test_assert(t, "last allocation is undone", Arena_mark(&arena).used == used);
+
+			const ArenaMark inner = Arena_mark(&arena);
+
+			for (U64 i = 0; i < 32; ++i) {
+				Buffer tmp = Buffer_createNull();
+				Test_assert(t, "alloc in inner scope", Buffer_createUninitializedBytes(512, a, &tmp, e_rr));
+			}
+
+			Arena_rewind(&arena, inner);
+			Test_assert(t, "inner rewind", arena.current == inner.chunk && Arena_mark(&arena).used == inner.used);
+
+			Arena_rewind(&arena, outer);
+			Test_assert(t, "outer rewind", arena.current == outer.chunk && Arena_mark(&arena).used == outer.used);
+
+			Buffer again = Buffer_createNull();
+			Test_assert(t, "realloc after rewind", Buffer_createUninitializedBytes(200, a, &again, e_rr));
+			Test_assert(t, "reuses rewound memory", again.ptr == b1.ptr);
+		}
+
+		Arena_free(&arena);
+	}
+
+	//Rewinding parks a chunk as the spare, reusing it has to start at its beginning again.
+
+	{
+		Arena arena = (Arena) { 0 };
+
+		if (Test_assert(t, "create spare", Arena_create(64 * KIBI, 0, EArenaFlags_None, alloc, &arena, e_rr))) {
+
+			const Allocator *a = &arena.allocator;
+			Buffer b0 = Buffer_createNull(), b1 = Buffer_createNull(), b2 = Buffer_createNull();
+
+			Test_assert(t, "alloc first chunk", Buffer_createUninitializedBytes(60 * KIBI, a, &b0, e_rr));
+			Test_assert(t, "alloc second chunk", Buffer_createUninitializedBytes(10 * KIBI, a, &b1, e_rr));
+
+			Arena_reset(&arena);
+			Test_assert(t, "reset parks a spare", !arena.current && arena.spare);
+
+			Test_assert(t, "alloc from spare", Buffer_createUninitializedBytes(60 * KIBI, a, &b2, e_rr));
+			Test_assert(t, "spare starts empty", Arena_mark(&arena).used == 60 * KIBI);
+			Test_assert(t, "spare is the only chunk", b2.ptr == b1.ptr && arena.reserved < 70 * KIBI);
+
+			Test_assert(t, "fill spare", Buffer_setAllBits(b2, e_rr));        //Past the chunk if it kept its old fill level
+		}
+
+		Arena_free(&arena);
+	}
+
+	//3. maxSize with and without fallback to the parent.
+
+	{
+		Arena arena = (Arena) { 0 };
+
+		if (Test_assert(t, "create limited", Arena_create(1024, 1024 + 64, EArenaFlags_None, alloc, &arena, e_rr))) {
+
+			Buffer b = Buffer_createNull();
+			Test_assert(t, "fits", Buffer_createUninitializedBytes(1000, &arena.allocator, &b, e_rr));
+
+			b = Buffer_createNull();
+			Test_assert(t, "limited fails", !Buffer_createUninitializedBytes(1000, &arena.allocator, &b, NULL));
+		}
+
+		Arena_free(&arena);
+
+		if (Test_assert(t, "create fallback", Arena_create(
+			1024, 1024 + 64, EArenaFlags_FallbackToParent, alloc, &arena, e_rr
+		))) {
+
+			const ArenaMark start = Arena_mark(&arena);
+			Buffer b[4] = { 0 };
+			Bool ok = true;
+
+			for(U64 i = 0; ok && i < 4; ++i)
+				ok = Buffer_createUninitializedBytes(1000, &arena.allocator, &b[i], e_rr);
+
+			Test_assert(t, "fallback allocates", ok && ArenaFallbackMap_length(arena.fallbacks) == 3);
+
+			Buffer_free(&b[3], &arena.allocator);
+			Test_assert(t, "fallback free", ArenaFallbackMap_length(arena.fallbacks) == 2);
+
+			Arena_rewind(&arena, start);
+			Test_assert(t, "rewind frees fallbacks", ArenaFallbackMap_empty(arena.fallbacks));
+
+			b[0] = Buffer_createNull();
+			Test_assert(t, "fallback left after free", Buffer_createUninitializedBytes(2000, &arena.allocator, &b[0], e_rr));
+		}
+
+		Arena_free(&arena);
+	}
+
+	//4. Leak reporting, what wasn't freed individually is reported on rewind.
+
+	{
+		Arena arena = (Arena) { 0 };
+
+		if (Test_assert(t, "create leak report", Arena_create(0, 0, EArenaFlags_ReportLeaks, alloc, &arena, e_rr))) {
+
+			const Allocator *a = &arena.allocator;
+			const ArenaMark start = Arena_mark(&arena);
+			Buffer b0 = Buffer_createNull(), b1 = Buffer_createNull();
+
+			Test_assert(t, "alloc tracked", Buffer_createUninitializedBytes(32, a, &b0, e_rr));
+			Test_assert(t, "alloc tracked 2", Buffer_createUninitializedBytes(48, a, &b1, e_rr));
+			Test_assert(t, "live", Arena_liveAllocations(&arena) == 2);
+
+			Buffer_free(&b0, a);
+			Test_assert(t, "free untracks", Arena_liveAllocations(&arena) == 1);
+
+			Test_print(t, "Expecting one leak to be reported below");
+			Test_assert(t, "leak reported", Arena_rewind(&arena, start) == 1);
+			Test_assert(t, "no live after rewind", !Arena_liveAllocations(&arena));
+		}
+
+		Arena_free(&arena);
+	}
+
+	Test_assert(t, "invalid flags", !Arena_create(0, 0, (EArenaFlags) 4, alloc, &(Arena) { 0 }, NULL));
+	Test_assert(t, "no parent", !Arena_create(0, 0, EArenaFlags_None, NULL, &(Arena) { 0 }, NULL));
+}
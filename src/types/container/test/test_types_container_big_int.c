@@ -50,6 +50,52 @@ static const U64 addResult[][2] = {
 	{ 0xFB6D0B6FE73ECB86, 0x715AD28B6F17ABC9 }
 };
 
+//a, b, a / b, a % b; with b of 2, 1, 3 and 4 U64s (single U32 digit short division and Knuth D)
+
+static const U64 divParams[][4][4] = {
+	{
+		{ 0x6B01A1C12A3A2107, 0x6B0404F2B09490B8, 0x48007596A28F5B37, 0xD7E11B1B7AA6540D },
+		{ 0xFD5E5EE3374CB757, 0x00F304F6CAEA0518, 0x0000000000000000, 0x0000000000000000 },
+		{ 0xAD3E5BB484121817, 0x69079F448EEC08F6, 0x00000000000000E3, 0x0000000000000000 },
+		{ 0xA0F5860E41078036, 0x00B059753D8AABA9, 0x0000000000000000, 0x0000000000000000 }
+	},
+	{
+		{ 0xF69542B8CECF8A17, 0x2EFF2F128330550F, 0x870D6796814D31E8, 0xC9D4D0203C6E3096 },
+		{ 0x0000000000683917, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000 },
+		{ 0x5A793AB04E1C4898, 0x04D95492CE84AD55, 0x1AA395716E15DF5F, 0x000001EFC0A1B5F7 },
+		{ 0x00000000005B2C6F, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000 }
+	},
+	{
+		{ 0x5EFCEA76039D74ED, 0x95DA5109EECA8C28, 0x11BB55F86D9DEEEE, 0xCB33444B25199D60 },
+		{ 0x3B74E9FBC056855F, 0x3B91E572EBE718DF, 0x0015ACFCB1A4A4F9, 0x0000000000000000 },
+		{ 0xE2A0263845BCB42A, 0x000000000000095F, 0x0000000000000000, 0x0000000000000000 },
+		{ 0x9577ABA712E0C757, 0x0DBDB56C0A2E5A1C, 0x0005252EF9D4C5B1, 0x0000000000000000 }
+	},
+	{
+		{ 0xFF602BDA6FD5CA04, 0xBD1AA3F1FED0C435, 0xE0029715C54CB0E4, 0x9DAAF919682204BB },
+		{ 0x08B8D0A0711C718B, 0x5434B6B5F4EE9A03, 0x7F5F96B68A473A6A, 0x003B4B6CB1A470B6 },
+		{ 0x00000000000002A8, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000 },
+		{ 0xD47601ADFC4830CC, 0x1115509F6507AC26, 0x8A1A423678198675, 0x002AA0618B569FF9 }
+	}
+};
+
+//a, exponent, modulus, a^exponent % modulus; odd (2^255 - 19, Montgomery) and even modulus
+
+static const U64 powModParams[][4][4] = {
+	{
+		{ 0xF3B3EB97A618D143, 0x5E5284E4F01AEA92, 0x27A1D40205F204AB, 0x03452132BDB39A62 },
+		{ 0x1FF7F21216A591F4, 0xED8DBAB6CF014130, 0x74002B8E05013278, 0x8D500F76293DC206 },
+		{ 0xFFFFFFFFFFFFFFED, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF },
+		{ 0xFF1E0A81491E4117, 0x7ABD101C7E44F803, 0x312056384D83626B, 0x28BE1180C4B7BB81 }
+	},
+	{
+		{ 0xDDAAAD70784E1EA4, 0x3C202FB0D1F4FB87, 0xC7BF13AA131A83DC, 0x0000000000000032 },
+		{ 0xAC7DC96B35645553, 0xCD8BBE9CF8013EBB, 0x0000000000000003, 0x0000000000000000 },
+		{ 0x57C9B2C0BA7C3A74, 0x7C1589B466BE6E54, 0x2FD940BB26AE54EE, 0x0981FA59AA448655 },
+		{ 0xFA91C35B15A08780, 0xC6B0522BE5F1FC86, 0x907CF1EF13AE489F, 0x053926B1B80263ED }
+	}
+};
+
 static const C8 *stringified[] = {
 	"0xFEDCBA98765432100123456789ABCDEF",
 	(
@@ -231,6 +277,182 @@ void Test_bigIntSub(Test *t) {
 	}
 }
 
+void Test_bigIntDivMod(Test *t) {
+
+	Test_setModule(t, "BigInt_divMod");
+
+	for (U64 i = 0; i < sizeof(divParams) / sizeof(divParams[0]); ++i) {
+
+		BigInt aBig = { 0 }, bBig = { 0 }, qBig = { 0 }, rBig = { 0 }, remBig = { 0 };
+		U64 temp[4] = { divParams[i][0][0], divParams[i][0][1], divParams[i][0][2], divParams[i][0][3] };
+		U64 rem[4] = { 0 };
+
+		if (
+			!BigInt_createRef(temp, 4, &aBig, &t->err)                  ||
+			!BigInt_createRef(rem, 4, &remBig, &t->err)                 ||
+			!BigInt_createRefConst(divParams[i][1], 4, &bBig, &t->err)  ||
+			!BigInt_createRefConst(divParams[i][2], 4, &qBig, &t->err)  ||
+			!BigInt_createRefConst(divParams[i][3], 4, &rBig, &t->err)
+		) {
+			Test_assert(t, "BigInt_divMod createRef", false);
+			continue;
+		}
+
+		Test_assert(t, "BigInt_divMod",       BigInt_divMod(&aBig, bBig, &remBig, t->alloc, NULL));
+		Test_assert(t, "BigInt_divMod q eq",  !BigInt_neq(aBig, qBig));
+		Test_assert(t, "BigInt_divMod r eq",  !BigInt_neq(remBig, rBig));
+
+		for(U8 j = 0; j < 4; ++j)
+			temp[j] = divParams[i][0][j];
+
+		Test_assert(t, "BigInt_mod",    BigInt_mod(&aBig, bBig, t->alloc, NULL));
+		Test_assert(t, "BigInt_mod eq", !BigInt_neq(aBig, rBig));
+	}
+
+	//Division by zero has to fail instead of producing garbage
+
+	U64 one[1] = { 1 };
+	BigInt oneBig = { 0 };
+
+	if (!BigInt_createRef(one, 1, &oneBig, &t->err))
+		Test_assert(t, "BigInt_divMod createRef", false);
+
+	else Test_assert(t, "BigInt_div zero", !BigInt_div(&oneBig, BigInt_createNull(), t->alloc, NULL));
+}
+
+void Test_bigIntMulKaratsuba(Test *t) {
+
+	Test_setModule(t, "BigInt_mul Karatsuba");
+
+	//Products of at least 24 U64s per side take the Karatsuba path.
+	//Dividing by b again uses the independent schoolbook division, so (a * b) / b == a and (a * b) % b == 0.
+
+	BigInt aBig = { 0 }, bBig = { 0 }, prodBig = { 0 }, remBig = { 0 };
+	U64 rng = 0x9E3779B97F4A7C15;
+
+	static const U16 limbCounts[][2] = { { 24, 24 }, { 31, 31 }, { 64, 64 }, { 100, 29 }, { 127, 127 } };
+
+	for (U64 i = 0; i < sizeof(limbCounts) / sizeof(limbCounts[0]); ++i) {
+
+		const U16 an = limbCounts[i][0], bn = limbCounts[i][1];
+
+		if (
+			!BigInt_create(an * 64, t->alloc, &aBig, &t->err)             ||
+			!BigInt_create(bn * 64, t->alloc, &bBig, &t->err)             ||
+			!BigInt_create((an + bn) * 64, t->alloc, &prodBig, &t->err)   ||
+			!BigInt_create(bn * 64, t->alloc, &remBig, &t->err)
+		) {
+			Test_assert(t, "BigInt_mul create", false);
+			break;
+		}
+
+		for (U64 j = 0; j < an + bn; ++j) {
+
+			rng ^= rng << 13;
+			rng ^= rng >> 7;
+			rng ^= rng << 17;
+
+			const U64 v = j % 11 == 3 ? U64_MAX : rng;        //Runs of ones stress the carries
+
+			if(j < an)
+				aBig.dataNonConst[j] = v;
+
+			else bBig.dataNonConst[j - an] = v;
+		}
+
+		Test_assert(t, "BigInt_mul set", BigInt_set(&prodBig, aBig, false, NULL, NULL));
+		Test_assert(t, "BigInt_mul", BigInt_mul(&prodBig, bBig, t->alloc, NULL));
+		Test_assert(t, "BigInt_divMod", BigInt_divMod(&prodBig, bBig, &remBig, t->alloc, NULL));
+		Test_assert(t, "BigInt_mul eq", BigInt_eq(prodBig, aBig));
+		Test_assert(t, "BigInt_mul rem", BigInt_bitScan(remBig) == U16_MAX);
+
+		BigInt_free(&aBig, t->alloc);
+		BigInt_free(&bBig, t->alloc);
+		BigInt_free(&prodBig, t->alloc);
+		BigInt_free(&remBig, t->alloc);
+	}
+
+	BigInt_free(&aBig, t->alloc);
+	BigInt_free(&bBig, t->alloc);
+	BigInt_free(&prodBig, t->alloc);
+	BigInt_free(&remBig, t->alloc);
+}
+
+void Test_bigIntPowMod(Test *t) {
+
+	Test_setModule(t, "BigInt_powMod");
+
+	for (U64 i = 0; i < sizeof(powModParams) / sizeof(powModParams[0]); ++i) {
+
+		BigInt aBig = { 0 }, eBig = { 0 }, mBig = { 0 }, rBig = { 0 };
+		U64 temp[4] = { powModParams[i][0][0], powModParams[i][0][1], powModParams[i][0][2], powModParams[i][0][3] };
+
+		if (
+			!BigInt_createRef(temp, 4, &aBig, &t->err)                       ||
+			!BigInt_createRefConst(powModParams[i][1], 4, &eBig, &t->err)    ||
+			!BigInt_createRefConst(powModParams[i][2], 4, &mBig, &t->err)    ||
+			!BigInt_createRefConst(powModParams[i][3], 4, &rBig, &t->err)
+		) {
+			Test_assert(t, "BigInt_powMod createRef", false);
+			continue;
+		}
+
+		Test_assert(t, "BigInt_powMod",    BigInt_powMod(&aBig, eBig, mBig, t->alloc, NULL));
+		Test_assert(t, "BigInt_powMod eq", !BigInt_neq(aBig, rBig));
+	}
+}
+
+void Test_bigIntDec(Test *t) {
+
+	Test_setModule(t, "BigInt dec");
+
+	//10^1000 is parsed, printed and checked against the digits; that's big enough to split the number a few times
+
+	CharString text = CharString_createNull();
+	CharString result = CharString_createNull();
+	BigInt aBig = { 0 }, tenBig = { 0 }, remBig = { 0 };
+
+	if (
+		!CharString_resize(&text, 1001, '0', t->alloc, &t->err) ||
+		!BigInt_create(64, t->alloc, &tenBig, &t->err)          ||
+		!BigInt_create(64, t->alloc, &remBig, &t->err)
+	) {
+		Test_assert(t, "BigInt dec create", false);
+		goto clean;
+	}
+
+	text.ptrNonConst[0] = '1';
+	tenBig.dataNonConst[0] = 10;
+
+	const BigIntCreate create = { .text = &text, .bitCount = 0, .alloc = t->alloc, .big = &aBig };
+	const BigIntStringify stringify = { .leadingZeros = false, .alloc = t->alloc, .result = &result };
+
+	if (!BigInt_createFromDec(&create, &t->err)) {
+		Test_assert(t, "BigInt_createFromDec", false);
+		goto clean;
+	}
+
+	Test_assert(t, "BigInt_dec", BigInt_dec(&stringify, aBig, NULL));
+	Test_assert(t, "BigInt_dec eq", CharString_equalsStringSensitive(&text, &result));
+
+	//Dividing by 10 a thousand times has to leave exactly 1
+
+	Bool divisible = true;
+
+	for (U64 i = 0; i < 1000 && divisible; ++i)
+		divisible = BigInt_divMod(&aBig, tenBig, &remBig, t->alloc, NULL) && BigInt_bitScan(remBig) == U16_MAX;
+
+	Test_assert(t, "BigInt_createFromDec divisible", divisible);
+	Test_assert(t, "BigInt_createFromDec one", BigInt_bitScan(aBig) == 0);
+
+clean:
+	CharString_free(&text, t->alloc);
+	CharString_free(&result, t->alloc);
+	BigInt_free(&aBig, t->alloc);
+	BigInt_free(&tenBig, t->alloc);
+	BigInt_free(&remBig, t->alloc);
+}
+
 void Test_bigIntLsh(Test *t) {
 
 	Test_setModule(t, "BigInt_lsh");
@@ -349,6 +571,10 @@ void Test_bigInt(Test *t) {
 	Test_bigIntMul(t);
 	Test_bigIntAdd(t);
 	Test_bigIntSub(t);
+	Test_bigIntDivMod(t);
+	Test_bigIntMulKaratsuba(t);
+	Test_bigIntPowMod(t);
+	Test_bigIntDec(t);
 	Test_bigIntLsh(t);
 	Test_bigIntRsh(t);
 	Test_bigIntBitScan(t);
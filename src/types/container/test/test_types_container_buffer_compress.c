@@ -0,0 +1,363 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_buffer_compress.c
+
+#include "test_types_container_shared.h"
+#include "types/container/buffer_compress.h"
+#include "types/container/compression_stream.h"
+#include "types/container/memory_stream.h"
+#include "types/container/buffer.h"
+#include "types/container/job_queue.h"
+#include "types/base/mathi.h"
+
+//Kinds of data that hit different paths of the encoder and decoder
+
+typedef enum ECompressTestData {
+	ECompressTestData_Random,         //Incompressible, stored
+	ECompressTestData_Text,           //Long matches far back
+	ECompressTestData_Runs,           //Matches that overlap themselves (offset < 16)
+	ECompressTestData_Mixed,          //Random runs of random lengths
+	ECompressTestData_Count
+} ECompressTestData;
+
+static void CompressTest_fill(U8 *ptr, U64 length, ECompressTestData type) {
+
+	U64 seed = 0x9E3779B97F4A7C15;
+
+	for (U64 i = 0; i < length; ) {
+
+		seed = seed * 6364136223846793005 + 1442695040888963407;
+		const U8 v = (U8)(seed >> 56);
+
+		switch (type) {
+
+			case ECompressTestData_Random:
+				ptr[i++] = v;
+				break;
+
+			case ECompressTestData_Text: {
+				static const C8 words[] = "the quick brown fox jumps over the lazy dog and compresses well ";
+				ptr[i] = (U8) words[(i + (i / 997)) % (sizeof(words) - 1)];
+				++i;
+				break;
+			}
+
+			case ECompressTestData_Runs: {
+
+				const U64 period = 1 + v % 15;
+				const U64 end = U64_min(i + 64 + v, length);
+
+				for(U64 j = i; j < end; ++j)
+					ptr[j] = (U8)(j % period + period);
+
+				i = end;
+				break;
+			}
+
+			default: {
+
+				const U64 end = U64_min(i + 1 + (v & 31), length);
+
+				for(U64 j = i; j < end; ++j)
+					ptr[j] = (v & 64) ? v : (U8)(j * 13);
+
+				i = end;
+				break;
+			}
+		}
+	}
+}
+
+static void Test_bufferCompressBlock(Test *t) {
+
+	Test_setModule(t, "Buffer_compressBlock");
+
+	static const U64 lengths[] = { 0, 1, 12, 13, 17, 100, 4097, 65536 };
+	static const C8 *typeNames[] = { "Random", "Text", "Runs", "Mixed" };
+
+	Buffer data = Buffer_createNull(), compressed = Buffer_createNull(), check = Buffer_createNull();
+
+	if (
+		!Buffer_createUninitializedBytes(BufferCompress_blockSize, t->alloc, &data, &t->err) ||
+		!Buffer_createUninitializedBytes(
+			Buffer_compressBlockBound(BufferCompress_blockSize), t->alloc, &compressed, &t->err
+		) ||
+		!Buffer_createUninitializedBytes(BufferCompress_blockSize, t->alloc, &check, &t->err)
+	) {
+		Test_assert(t, "Allocate", false);
+		goto clean;
+	}
+
+	for (U64 type = 0; type < ECompressTestData_Count; ++type) {
+
+		CompressTest_fill(data.ptrNonConst, BufferCompress_blockSize, (ECompressTestData) type);
+
+		for (U64 i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+
+			const U64 length = lengths[i];
+			U64 written = 0;
+
+			const Buffer input = Buffer_createRefConst(data.ptr, length);
+			const Buffer output = Buffer_createRef(check.ptrNonConst, length);
+
+			Bool ok = Buffer_compressBlock(input, compressed, &written, &t->err);
+			ok = Test_assert(t, typeNames[type], ok && written <= Buffer_compressBlockBound(length));
+
+			if(!ok)
+				continue;
+
+			const Buffer block = Buffer_createRefConst(compressed.ptr, written);
+			Test_assert(t, typeNames[type], Buffer_decompressBlock(block, output, &t->err) && Buffer_eq(input, output));
+
+			//Everything but random data has to actually get smaller
+
+			if(type != ECompressTestData_Random && length == BufferCompress_blockSize)
+				Test_assert(t, "Compresses", written < length / 2);
+
+			//Any truncation or wrong output size fails rather than producing garbage
+
+			if (written > 1)
+				Test_assert(
+					t, "Truncated",
+					!Buffer_decompressBlock(Buffer_createRefConst(compressed.ptr, written - 1), output, NULL)
+				);
+
+			if (length)
+				Test_assert(
+					t, "Output too small",
+					!Buffer_decompressBlock(block, Buffer_createRef(check.ptrNonConst, length - 1), NULL)
+				);
+		}
+	}
+
+	//Offsets that point before the start of the output are rejected
+
+	static const U8 badOffset[] = { 0x10, 'a', 0x05, 0x00 };        //1 literal, match 4 bytes from 5 back
+	static const U8 zeroOffset[] = { 0x10, 'a', 0x00, 0x00 };
+
+	Test_assert(
+		t, "Offset out of bounds",
+		!Buffer_decompressBlock(Buffer_createRefConst(badOffset, 4), Buffer_createRef(check.ptrNonConst, 5), NULL)
+	);
+
+	Test_assert(
+		t, "Offset zero",
+		!Buffer_decompressBlock(Buffer_createRefConst(zeroOffset, 4), Buffer_createRef(check.ptrNonConst, 5), NULL)
+	);
+
+	Test_assert(
+		t, "Too big",
+		!Buffer_compressBlock(
+			Buffer_createRefConst(data.ptr, BufferCompress_blockSize + 1), compressed, &(U64){ 0 }, NULL
+		)
+	);
+
+clean:
+	Buffer_free(&data, t->alloc);
+	Buffer_free(&compressed, t->alloc);
+	Buffer_free(&check, t->alloc);
+}
+
+static void Test_bufferCompressBlocked(Test *t) {
+
+	Test_setModule(t, "Buffer_compress");
+
+	const U64 size = BufferCompress_blockSize * 5 + 1234;
+	Buffer data = Buffer_createNull(), compressed = Buffer_createNull(), check = Buffer_createNull();
+
+	if (
+		!Buffer_createUninitializedBytes(size, t->alloc, &data, &t->err) ||
+		!Buffer_createUninitializedBytes(size, t->alloc, &check, &t->err)
+	) {
+		Test_assert(t, "Allocate", false);
+		goto clean;
+	}
+
+	//Block 2 is random, so it's stored instead
+
+	CompressTest_fill(data.ptrNonConst, size, ECompressTestData_Mixed);
+	CompressTest_fill(data.ptrNonConst + 2 * BufferCompress_blockSize, BufferCompress_blockSize, ECompressTestData_Random);
+
+	if (!Test_assert(t, "Compress", Buffer_compress(data, t->alloc, &compressed, &t->err)))
+		goto clean;
+
+	Test_assert(t, "Smaller", Buffer_length(compressed) < size);
+	Test_assert(t, "Decompress", Buffer_decompress(compressed, check, &t->err) && Buffer_eq(data, check));
+
+	BufferCompressBlock *blocks = (BufferCompressBlock*) compressed.ptrNonConst;
+	Test_assert(t, "Stored block", blocks[2].size == BufferCompress_blockSize);
+
+	//A flipped bit in a stored block can only be caught by the checksum
+
+	U64 stored = BufferCompress_blockCount(size) * sizeof(BufferCompressBlock) + blocks[0].size + blocks[1].size + 7;
+	compressed.ptrNonConst[stored] ^= 1;
+	Test_assert(t, "Checksum", !Buffer_decompress(compressed, check, NULL));
+
+clean:
+	Buffer_free(&data, t->alloc);
+	Buffer_free(&compressed, t->alloc);
+	Buffer_free(&check, t->alloc);
+}
+
+//Random access, parallel reads and read-ahead of a CompressionStream, at an offset into a memory stream
+
+static void Test_compressionStream(Test *t) {
+
+	Test_setModule(t, "CompressionStream");
+
+	const U64 size = BufferCompress_blockSize * 7 + 4321, streamOffset = 48;
+	const RefPtrType memType = MemoryStream_makeType(t->alloc);
+
+	RefPtr *backing = NULL, *comp = NULL;
+	Buffer data = Buffer_createNull(), compressed = Buffer_createNull(), check = Buffer_createNull();
+	Buffer file = Buffer_createNull();
+	JobQueue queue = (JobQueue) { 0 };
+	StreamCursor cursor = (StreamCursor) { 0 };
+	Bool hasQueue = false;
+
+	if (
+		!Buffer_createUninitializedBytes(size, t->alloc, &data, &t->err) ||
+		!Buffer_createUninitializedBytes(size, t->alloc, &check, &t->err)
+	) {
+		Test_assert(t, "Allocate", false);
+		goto clean;
+	}
+
+	CompressTest_fill(data.ptrNonConst, size, ECompressTestData_Text);
+
+	if (
+		!Buffer_compress(data, t->alloc, &compressed, &t->err) ||
+		!Buffer_createEmptyBytes(streamOffset + Buffer_length(compressed), t->alloc, &file, &t->err)
+	) {
+		Test_assert(t, "Compress", false);
+		goto clean;
+	}
+
+	Buffer_memcpy(Buffer_createRef(file.ptrNonConst + streamOffset, Buffer_length(compressed)), compressed);
+	Buffer fileRef = Buffer_createRefConst(file.ptr, Buffer_length(file));
+
+	if (
+		!MemoryStream_createFromBuffer(&fileRef, EMemoryStreamFlags_None, &memType, &backing, &t->err) ||
+		!CompressionStream_create(
+			backing, streamOffset, Buffer_length(compressed), size, t->alloc, &comp, &t->err
+		)
+	) {
+		Test_assert(t, "Create", false);
+		goto clean;
+	}
+
+	Test_assert(
+		t, "Wrong compressedSize",
+		!CompressionStream_create(backing, streamOffset, Buffer_length(compressed) - 1, size, t->alloc, &(RefPtr*){ 0 }, NULL)
+	);
+
+	OxStream *s = RefPtr_data(comp, OxStream);
+	Test_assert(t, "Readonly", !s->write && (s->streamType & EStreamType_Compressed) && !s->mapped);
+
+	Test_assert(t, "Read all", s->read(s, 0, size, check, t->alloc, &t->err) && Buffer_eq(check, data));
+
+	static const U64 ranges[][2] = { { 1, 1 }, { 65530, 12 }, { 65536 * 3 + 5, 65536 * 2 }, { 65536 * 7, 4321 } };
+
+	for (U64 i = 0; i < sizeof(ranges) / sizeof(ranges[0]); ++i) {
+
+		const U64 off = ranges[i][0], len = ranges[i][1];
+
+		Test_assert(
+			t, "Seek",
+			s->read(s, off, len, Buffer_createRef(check.ptrNonConst, len), t->alloc, &t->err) &&
+			Buffer_eq(Buffer_createRefConst(check.ptr, len), Buffer_createRefConst(data.ptr + off, len))
+		);
+	}
+
+	Test_assert(t, "Out of bounds", !s->read(s, size - 10, 11, check, t->alloc, NULL));
+
+	hasQueue = JobQueue_create(4, t->alloc, &queue, &t->err);
+
+	if (!Test_assert(t, "Create queue", hasQueue) || !CompressionStream_setJobQueue(comp, &queue, &t->err))
+		goto clean;
+
+	Test_assert(t, "Non compression stream rejected", !CompressionStream_setJobQueue(backing, &queue, NULL));
+
+	Test_assert(
+		t, "Parallel read all",
+		s->read(s, 0, size, check, t->alloc, &t->err) && Buffer_eq(check, data)
+	);
+
+	Test_assert(
+		t, "Parallel read partial head and tail",
+		s->read(s, 100, size - 150, Buffer_createRef(check.ptrNonConst, size - 150), t->alloc, &t->err) &&
+		Buffer_eq(Buffer_createRefConst(check.ptr, size - 150), Buffer_createRefConst(data.ptr + 100, size - 150))
+	);
+
+	//Read-ahead reads from its worker, which has to decompress serially next to the owner
+
+	U64 it = 0;
+	Bool sequential = StreamCursor_create(comp, 0, false, t->alloc, &cursor, &t->err) &&
+		StreamCursor_enableReadAhead(&cursor, 4, t->alloc, &t->err);
+
+	for (; sequential && it < size; )
+		sequential = StreamCursor_consume(
+			&cursor, &it, check.ptrNonConst + it, U64_min(size - it, 12345), t->alloc, &t->err
+		);
+
+	Test_assert(t, "Read-ahead", sequential && Buffer_eq(check, data));
+	StreamCursor_close(&cursor, t->alloc);
+
+	//A corrupt block in the middle of a parallel read fails the same as a serial one would
+
+	BufferCompressBlock *blocks = (BufferCompressBlock*) compressed.ptrNonConst;
+	U64 corrupt = streamOffset + BufferCompress_blockCount(size) * sizeof(BufferCompressBlock) + 3;
+
+	for(U64 i = 0; i < 4; ++i)
+		corrupt += blocks[i].size;
+
+	file.ptrNonConst[corrupt] ^= 0x40;
+
+	Test_assert(t, "Corrupt read fails", !s->read(s, 0, size, check, t->alloc, NULL));
+
+	const U64 good = BufferCompress_blockSize * 4;
+
+	Test_assert(
+		t, "Other blocks still read",
+		s->read(s, 0, good, Buffer_createRef(check.ptrNonConst, good), t->alloc, &t->err) &&
+		Buffer_eq(Buffer_createRefConst(check.ptr, good), Buffer_createRefConst(data.ptr, good))
+	);
+
+clean:
+	StreamCursor_close(&cursor, t->alloc);
+	RefPtr_dec(&comp);
+	RefPtr_dec(&backing);
+
+	if (hasQueue)
+		JobQueue_free(&queue);
+
+	Buffer_free(&file, t->alloc);
+	Buffer_free(&compressed, t->alloc);
+	Buffer_free(&check, t->alloc);
+	Buffer_free(&data, t->alloc);
+}
+
+void Test_bufferCompress(Test *t) {
+	Test_bufferCompressBlock(t);
+	Test_bufferCompressBlocked(t);
+	Test_compressionStream(t);
+	Test_setModule(t, NULL);
+}
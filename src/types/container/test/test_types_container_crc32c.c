@@ -23,6 +23,8 @@
 #include "test_types_container_shared.h"
 #include "types/base/string_base.h"
 #include "types/container/buffer.h"
+#include "types/container/job_queue.h"
+#include "types/base/error.h"
 
 void Test_crc32c(Test *test) {
 
@@ -87,4 +89,62 @@ void Test_crc32c(Test *test) {
 
 		Test_assert(test, offsetNames[off], allMatch);
 	}
+
+	//Combining the CRCs of two halves has to give the CRC of the whole, wherever the split is.
+	//The length is past three long blocks (3 * 8192) and a short triple, so both interleaved paths run too;
+	// the table version is the reference for them.
+
+	Test_setModule(test, "CRC32C combine");
+
+	Buffer data = Buffer_createNull();
+	const U64 combineLen = 3 * 8192 * 2 + 3 * 256 + 13;
+
+	if (Test_assert(test, "alloc", Buffer_createUninitializedBytes(combineLen, test->alloc, &data, &test->err))) {
+
+		for (U64 i = 0; i < combineLen; ++i)
+			data.ptrNonConst[i] = (U8)(i * 131 + (i >> 9) * 7 + 3);
+
+		const U32 whole = Buffer_crc32c(data);
+		Test_assert(test, "interleaved matches table", whole == Buffer_crc32cFallback(data));
+
+		static const U64 splits[] = { 0, 1, 7, 8, 255, 8191, 8192 * 3, 40000, combineLen - 1, combineLen };
+		Bool allMatch = true;
+
+		for (U64 i = 0; i < sizeof(splits) / sizeof(splits[0]); ++i) {
+			const U32 a = Buffer_crc32c(Buffer_createRefConst(data.ptr, splits[i]));
+			const U32 b = Buffer_crc32c(Buffer_createRefConst(data.ptr + splits[i], combineLen - splits[i]));
+			allMatch &= Buffer_crc32cCombine(a, b, combineLen - splits[i]) == whole;
+		}
+
+		Test_assert(test, "combine of every split", allMatch);
+		Test_assert(test, "combine with empty", Buffer_crc32cCombine(whole, 0, 0) == whole);
+	}
+
+	Buffer_free(&data, test->alloc);
+
+	//The parallel version splits in 4 MiB+ chunks; an odd length leaves a remainder for the last chunk.
+
+	Test_setModule(test, "CRC32C parallel");
+
+	JobQueue queue = (JobQueue) { 0 };
+	const U64 parallelLen = 9 * MIBI + 3;
+
+	if (
+		Test_assert(test, "alloc", Buffer_createUninitializedBytes(parallelLen, test->alloc, &data, &test->err)) &&
+		Test_assert(test, "create queue", JobQueue_create(4, test->alloc, &queue, &test->err))
+	) {
+
+		for (U64 i = 0; i < parallelLen; ++i)
+			data.ptrNonConst[i] = (U8)(i ^ (i >> 11));
+
+		const U32 want = Buffer_crc32c(data);
+		U32 got = 0, inline0 = 0;
+
+		Test_assert(test, "parallel", Buffer_crc32cParallel(data, &queue, &got, &test->err) && got == want);
+		Test_assert(test, "without queue", Buffer_crc32cParallel(data, NULL, &inline0, &test->err) && inline0 == want);
+		Test_assert(test, "requires result", !Buffer_crc32cParallel(data, &queue, NULL, NULL));
+	}
+
+	JobQueue_free(&queue);
+	Buffer_free(&data, test->alloc);
 }
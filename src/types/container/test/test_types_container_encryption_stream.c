@@ -25,6 +25,7 @@
 #include "types/container/encryption_stream.h"
 #include "types/container/memory_stream.h"
 #include "types/container/buffer.h"
+#include "types/container/job_queue.h"
 #include "types/base/mathi.h"
 
 static const U32 encTestKey[8] = {
@@ -85,6 +86,168 @@ static Bool EncStream_harnessCreate(
 	return true;
 }
 
+//Readonly memory streams are mapped, but what they map is the ciphertext
+
+static void Test_encryptionStreamReadonly(Test *t, const RefPtrType *type) {
+
+	Test_setModule(t, "EncryptionStream readonly backing");
+
+	const I32x4 rootIV = I32x4_create4(0x11223344, 0x55667788, 0x99AABBCC, 0);
+	const U64 chunkSize = 64 * KIBI, size = chunkSize + 100;
+
+	RefPtr *backing = NULL, *enc = NULL;
+	Buffer cipher = Buffer_createNull();
+	U8 plain[64 * KIBI + 100], check[64 * KIBI + 100];
+
+	for (U64 i = 0; i < size; ++i)
+		plain[i] = (U8)(i * 5 + 1);
+
+	const U64 realSize = EncryptionStream_underlyingSize(chunkSize, size);
+
+	if (
+		!MemoryStream_create(realSize, EMemoryStreamFlags_IsWritable, &memType, &backing, &t->err) ||
+		!EncryptionStream_create(backing, 0, encTestKey, rootIV, chunkSize, 0, type, &enc, &t->err)
+	) {
+		Test_assert(t, "Create writable", false);
+		goto clean;
+	}
+
+	OxStream *s = RefPtr_data(enc, OxStream);
+
+	Test_assert(t, "Write", s->write(s, 0, size, Buffer_createRefConst(plain, size), t->alloc, &t->err));
+	RefPtr_dec(&enc);
+
+	if (!Test_assert(t, "Move", MemoryStream_move(&backing, &cipher, &t->err)))
+		goto clean;
+
+	Buffer cipherRef = Buffer_createRefConst(cipher.ptr, realSize);
+
+	if (
+		!MemoryStream_createFromBuffer(&cipherRef, EMemoryStreamFlags_None, &memType, &backing, &t->err) ||
+		!EncryptionStream_create(backing, 0, encTestKey, rootIV, chunkSize, size, type, &enc, &t->err)
+	) {
+		Test_assert(t, "Create readonly", false);
+		goto clean;
+	}
+
+	s = RefPtr_data(enc, OxStream);
+
+	Test_assert(t, "Backing is mapped", RefPtr_data(backing, OxStream)->streamType & EStreamType_Mapped);
+	Test_assert(t, "Encrypted isn't mapped", !(s->streamType & EStreamType_Mapped) && !s->mapped);
+
+	Test_assert(
+		t, "Read",
+		s->read(s, 0, size, Buffer_createRef(check, size), t->alloc, &t->err) &&
+		Buffer_eq(Buffer_createRefConst(check, size), Buffer_createRefConst(plain, size))
+	);
+
+clean:
+	RefPtr_dec(&enc);
+	RefPtr_dec(&backing);
+	Buffer_free(&cipher, t->alloc);
+}
+
+//Reads over multiple chunks are decrypted on a queue, partial chunks and other threads stay serial
+
+static void Test_encryptionStreamJobQueue(Test *t, const RefPtrType *type) {
+
+	Test_setModule(t, "EncryptionStream_setJobQueue");
+
+	const I32x4 rootIV = I32x4_create4(0x11223344, 0x55667788, 0x99AABBCC, 0);
+	const U64 chunkSize = 64 * KIBI, size = chunkSize * 8 + 777;
+
+	RefPtr *backing = NULL, *enc = NULL;
+	Buffer plain = Buffer_createNull(), check = Buffer_createNull();
+	JobQueue queue = (JobQueue) { 0 };
+	StreamCursor cursor = (StreamCursor) { 0 };
+	Bool hasQueue = false;
+
+	if (
+		!Buffer_createUninitializedBytes(size, t->alloc, &plain, &t->err) ||
+		!Buffer_createUninitializedBytes(size, t->alloc, &check, &t->err) ||
+		!MemoryStream_create(
+			EncryptionStream_underlyingSize(chunkSize, size), EMemoryStreamFlags_IsWritable, &memType, &backing, &t->err
+		) ||
+		!EncryptionStream_create(backing, 0, encTestKey, rootIV, chunkSize, 0, type, &enc, &t->err)
+	) {
+		Test_assert(t, "Create", false);
+		goto clean;
+	}
+
+	for (U64 i = 0; i < size; ++i)
+		plain.ptrNonConst[i] = (U8)(i * 7 + (i >> 12));
+
+	OxStream *s = RefPtr_data(enc, OxStream);
+
+	if (!Test_assert(t, "Write", s->write(s, 0, size, plain, t->alloc, &t->err)))
+		goto clean;
+
+	Test_assert(t, "Non encryption stream rejected", !EncryptionStream_setJobQueue(backing, &queue, NULL));
+
+	hasQueue = JobQueue_create(4, t->alloc, &queue, &t->err);
+
+	if (!Test_assert(t, "Create queue", hasQueue) || !EncryptionStream_setJobQueue(enc, &queue, &t->err))
+		goto clean;
+
+	Test_assert(
+		t, "Read all",
+		s->read(s, 0, size, check, t->alloc, &t->err) && Buffer_eq(check, plain)
+	);
+
+	Test_assert(
+		t, "Read partial head and tail",
+		s->read(s, 100, size - 150, Buffer_createRef(check.ptrNonConst, size - 150), t->alloc, &t->err) &&
+		Buffer_eq(Buffer_createRefConst(check.ptr, size - 150), Buffer_createRefConst(plain.ptr + 100, size - 150))
+	);
+
+	//Read-ahead reads from its worker, which has to decrypt serially next to the owner
+
+	U64 it = 0;
+	Bool sequential = StreamCursor_create(enc, 0, false, t->alloc, &cursor, &t->err) &&
+		StreamCursor_enableReadAhead(&cursor, 4, t->alloc, &t->err);
+
+	for (; sequential && it < size; )
+		sequential = StreamCursor_consume(
+			&cursor, &it, check.ptrNonConst + it, U64_min(size - it, 12345), t->alloc, &t->err
+		);
+
+	Test_assert(t, "Read-ahead", sequential && Buffer_eq(check, plain));
+	StreamCursor_close(&cursor, t->alloc);
+
+	//A tampered chunk in the middle of a parallel read fails the same as a serial one would
+
+	OxStream *b = RefPtr_data(backing, OxStream);
+	const U64 tampered = 5 * (chunkSize + sizeof(CryptoChunk)) + sizeof(CryptoChunk) + 3;
+	U8 byte = 0;
+
+	if (
+		!b->read(b, tampered, 1, Buffer_createRef(&byte, 1), t->alloc, &t->err) ||
+		!(byte ^= 0x40, b->write(b, tampered, 1, Buffer_createRefConst(&byte, 1), t->alloc, &t->err))
+	) {
+		Test_assert(t, "Tamper", false);
+		goto clean;
+	}
+
+	Test_assert(t, "Tampered read fails", !s->read(s, 0, size, check, t->alloc, NULL));
+
+	Test_assert(
+		t, "Untampered chunks still read",
+		s->read(s, 0, chunkSize * 5, Buffer_createRef(check.ptrNonConst, chunkSize * 5), t->alloc, &t->err) &&
+		Buffer_eq(Buffer_createRefConst(check.ptr, chunkSize * 5), Buffer_createRefConst(plain.ptr, chunkSize * 5))
+	);
+
+clean:
+	StreamCursor_close(&cursor, t->alloc);
+	RefPtr_dec(&enc);
+	RefPtr_dec(&backing);
+
+	if (hasQueue)
+		JobQueue_free(&queue);
+
+	Buffer_free(&check, t->alloc);
+	Buffer_free(&plain, t->alloc);
+}
+
 void Test_encryptionStream(Test *t) {
 
 	const RefPtrType type = EncryptionStream_makeType(t->alloc);
@@ -98,5 +261,7 @@ void Test_encryptionStream(Test *t) {
 
 	StreamHarness_testStream(&h, t);
 	StreamHarness_testCursor(&h, t);
+	Test_encryptionStreamReadonly(t, &type);
+	Test_encryptionStreamJobQueue(t, &type);
 	Test_setModule(t, NULL);
 }
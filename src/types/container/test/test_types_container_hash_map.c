@@ -0,0 +1,240 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_hash_map.c
+
+#include "test_types_container_shared.h"
+#include "types/container/hash_map.h"
+#include "types/container/string.h"
+#include "types/base/allocator.h"
+
+//Everything hashes to the same home slot, so every key lands in one long run and erase has to shift it around.
+
+static U64 hashCollide(const void *a) { (void) a; return 0; }
+
+//Mostly collides: only 4 home slots, so runs overlap and wrap.
+
+static U64 hashFewSlots(const void *a) { return *(const U64*) a & 3; }
+
+typedef struct Key24 { U64 a, b, c; } Key24;
+
+THashMap(Key24, U32);
+
+static Bool Test_hashMapMatchesReference(HashMapU64U64 *m, const U64 *ref, U64 n) {
+
+	U64 present = 0;
+
+	for (U64 i = 0; i < n; ++i) {
+
+		U64 v = 0;
+		const Bool found = HashMapU64U64_get(m, i, &v);
+
+		if(found != (ref[i] != U64_MAX) || (found && v != ref[i]))
+			return false;
+
+		present += found;
+	}
+
+	return present == HashMapU64U64_length(*m);
+}
+
+void Test_hashMap(Test *t) {
+
+	const Allocator *alloc = t->alloc;
+	Error *e_rr = &t->err;
+
+	Test_setModule(t, "HashMap");
+
+	//1. Insert, find, overwrite and erase with the default (raw byte) hash, growing a few times on the way.
+
+	{
+		HashMapU64U64 m = (HashMapU64U64) { 0 };
+		const U64 n = 5000;
+		Bool ok = HashMapU64U64_create(0, alloc, &m, e_rr);
+
+		for(U64 i = 0; ok && i < n; ++i)
+			ok = HashMapU64U64_insert(&m, i * 7919, i, alloc, e_rr);
+
+		Test_assert(t, "insert 5000", ok && HashMapU64U64_length(m) == n);
+		Test_assert(t, "capacity stays above length", m.map.capacity > n);
+
+		Bool allFound = true;
+		for(U64 i = 0; allFound && i < n; ++i) {
+			const U64 *v = HashMapU64U64_find(&m, i * 7919);
+			allFound = v && *v == i;
+		}
+
+		Test_assert(t, "find all", allFound);
+		Test_assert(t, "missing key", !HashMapU64U64_contains(&m, 1));
+
+		Test_assert(t, "insert duplicate fails", !HashMapU64U64_insert(&m, 7919, 0, alloc, NULL));
+
+		Test_assert(t, "set overwrites", HashMapU64U64_set(&m, 7919, 42, alloc, e_rr));
+		Test_assert(t, "set didn't add", HashMapU64U64_length(m) == n);
+		Test_assert(t, "value overwritten", *HashMapU64U64_find(&m, 7919) == 42);
+
+		U64 popped = 0;
+		Test_assert(t, "pop", HashMapU64U64_pop(&m, 7919, &popped) && popped == 42);
+		Test_assert(t, "pop twice", !HashMapU64U64_pop(&m, 7919, &popped));
+		Test_assert(t, "insert after pop", HashMapU64U64_insert(&m, 7919, 1, alloc, e_rr));
+
+		for(U64 i = 0; i < n; i += 2)
+			HashMapU64U64_erase(&m, i * 7919);
+
+		Bool oddFound = true;
+		for(U64 i = 0; oddFound && i < n; ++i)
+			oddFound = HashMapU64U64_contains(&m, i * 7919) == (i & 1);
+
+		Test_assert(t, "erase every even key", oddFound && HashMapU64U64_length(m) == n / 2);
+
+		U64 iterated = 0, sum = 0;
+
+		for (U64 i = HashMapU64U64_next(&m, 0); i != U64_MAX; i = HashMapU64U64_next(&m, i + 1)) {
+			++iterated;
+			sum += *HashMapU64U64_valueAt(&m, i);
+		}
+
+		Test_assert(t, "iterate", iterated == n / 2 && sum == (n / 2) * (n / 2));
+
+		HashMapU64U64_clear(&m);
+		Test_assert(t, "clear", HashMapU64U64_empty(m) && !HashMapU64U64_contains(&m, 7919 * 3));
+
+		HashMapU64U64_free(&m, alloc);
+	}
+
+	//2. Degenerate hashes: every erase has to shift the run back (and wrap around the end) correctly.
+	//Compared against a plain array after each step.
+
+	{
+		const HashFunction hashes[] = { hashCollide, hashFewSlots };
+		U64 ref[200];
+
+		for (U64 h = 0; h < sizeof(hashes) / sizeof(hashes[0]); ++h) {
+
+			HashMapU64U64 m = (HashMapU64U64) { 0 };
+			Bool ok = HashMapU64U64_createCustom(0, hashes[h], NULL, alloc, &m, e_rr);
+
+			for(U64 i = 0; i < 200; ++i)
+				ref[i] = U64_MAX;
+
+			U64 rng = 0x9E3779B97F4A7C15 + h;
+
+			for (U64 step = 0; ok && step < 4000; ++step) {
+
+				rng = rng * 6364136223846793005 + 1442695040888963407;
+				const U64 k = (rng >> 33) % 200;
+
+				if ((rng >> 20) & 1) {
+					ok = HashMapU64U64_set(&m, k, step, alloc, e_rr);
+					ref[k] = step;
+				}
+
+				else {
+					const Bool erased = HashMapU64U64_erase(&m, k);
+					ok = erased == (ref[k] != U64_MAX);
+					ref[k] = U64_MAX;
+				}
+
+				if(!(step % 97))
+					ok &= Test_hashMapMatchesReference(&m, ref, 200);
+			}
+
+			Test_assert(t, "colliding hash matches reference", ok && Test_hashMapMatchesReference(&m, ref, 200));
+			HashMapU64U64_free(&m, alloc);
+		}
+	}
+
+	//3. Sets (no value storage), reserve and reuse after free.
+
+	{
+		HashSetU64 s = (HashSetU64) { 0 };
+		Bool ok = HashSetU64_create(100, alloc, &s, e_rr);
+		const U64 capacity = s.map.capacity;
+
+		Test_assert(t, "reserve up front", ok && capacity >= 100);
+
+		Bool inserted = false;
+		for(U64 i = 0; ok && i < 100; ++i)
+			ok = HashSetU64_add(&s, i, alloc, &inserted, e_rr) && inserted;
+
+		ok &= HashSetU64_add(&s, 5, alloc, &inserted, e_rr) && !inserted;
+
+		Test_assert(t, "set add", ok && HashSetU64_length(s) == 100);
+		Test_assert(t, "reserve didn't need to grow", s.map.capacity == capacity);
+		Test_assert(t, "set has no value", !GenericHashMap_valueAt(&s.map, HashSetU64_next(&s, 0)));
+
+		HashSetU64_free(&s, alloc);
+		Test_assert(t, "free", !s.map.capacity && !HashSetU64_contains(&s, 5));
+
+		ok = HashSetU64_add(&s, 5, alloc, NULL, e_rr);
+		Test_assert(t, "reuse after free", ok && HashSetU64_contains(&s, 5));
+		HashSetU64_free(&s, alloc);
+	}
+
+	//4. Keys that aren't 4 or 8 bytes go through the byte hash, and a value type smaller than the key.
+
+	{
+		HashMapKey24U32 m = (HashMapKey24U32) { 0 };
+		Bool ok = HashMapKey24U32_create(0, alloc, &m, e_rr);
+
+		for(U32 i = 0; ok && i < 300; ++i)
+			ok = HashMapKey24U32_insert(&m, (Key24) { i, i * 3, ~(U64)i }, i, alloc, e_rr);
+
+		for(U32 i = 0; ok && i < 300; ++i) {
+			U32 v = 0;
+			ok = HashMapKey24U32_get(&m, (Key24) { i, i * 3, ~(U64)i }, &v) && v == i;
+		}
+
+		Test_assert(t, "struct keys", ok && !HashMapKey24U32_contains(&m, (Key24) { 1, 2, 3 }));
+		HashMapKey24U32_free(&m, alloc);
+	}
+
+	//5. CharString keys compare by content, not by pointer.
+
+	{
+		GenericHashMap m = (GenericHashMap) { 0 };
+		const CharString names[] = {
+			CharString_createRefCStrConst("alpha"),
+			CharString_createRefCStrConst("beta"),
+			CharString_createRefCStrConst("gamma")
+		};
+
+		Bool ok = GenericHashMap_create(
+			sizeof(CharString), sizeof(U32),
+			GenericHashMap_hashString, GenericHashMap_equalsString,
+			0, alloc, &m, e_rr
+		);
+
+		for (U32 i = 0; ok && i < 3; ++i)
+			ok = GenericHashMap_insert(&m, &names[i], &i, alloc, e_rr);
+
+		CharString copy = CharString_createNull();
+		ok &= CharString_createCopy(CharString_createRefCStrConst("beta"), alloc, &copy, e_rr);
+
+		const U32 *v = (const U32*) GenericHashMap_find(&m, &copy);
+		Test_assert(t, "string key by content", ok && v && *v == 1);
+
+		const CharString other = CharString_createRefCStrConst("delta");
+		Test_assert(t, "missing string key", !GenericHashMap_contains(&m, &other));
+
+		CharString_free(&copy, alloc);
+		GenericHashMap_free(&m, alloc);
+	}
+}
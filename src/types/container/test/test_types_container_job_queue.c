@@ -20,11 +20,12 @@
 
 //types/container/test/test_types_container_job_queue.c
 //
-//Exercises JobQueue and, through it, the SpinLock + Thread primitives it is built on.
+//Exercises JobQueue and, through it, the Mutex + Thread primitives it is built on.
 
 #include "test_types_container_shared.h"
 #include "types/container/job_queue.h"
 #include "types/container/list_basic_types.h"
+#include "types/container/buffer.h"
 #include "types/base/atomic.h"
 
 //--- Job payloads & callbacks -------------------------------------------------
@@ -88,6 +89,139 @@ static Bool jobCheckThreadId(void *data, U64 threadId, JobQueue *queue) {
 	return true;
 }
 
+//Recursive fan-out for work stealing: every level pushes 'width' jobs of the next level from inside a job.
+
+typedef struct TreePayload {
+	AtomicI64 *counter;
+	AtomicI64 *bad;
+	const struct TreePayload *next;     //NULL for the leaves
+	U64 width, threadCount;
+} TreePayload;
+
+static Bool jobTree(void *data, U64 threadId, JobQueue *queue) {
+
+	const TreePayload *p = (const TreePayload*) data;
+	AtomicI64_inc(p->counter);
+
+	if(threadId >= p->threadCount)
+		AtomicI64_inc(p->bad);
+
+	for(U64 i = 0; p->next && i < p->width; ++i)
+		if(!JobQueue_push(queue, jobTree, (void*) p->next, NULL))
+			return false;
+
+	return true;
+}
+
+//Pushes children that either run or get discarded, then signals it's done.
+
+typedef struct DiscardPayload {
+	AtomicI64 ran, destroyed, parentDone;
+} DiscardPayload;
+
+static Bool jobDiscardChild(void *data, U64 threadId, JobQueue *queue) {
+	(void) threadId; (void) queue;
+	AtomicI64_inc(&((DiscardPayload*) data)->ran);
+	return true;
+}
+
+static void jobDiscardChildDestructor(void *data) {
+	AtomicI64_inc(&((DiscardPayload*) data)->destroyed);
+}
+
+static Bool jobDiscardParent(void *data, U64 threadId, JobQueue *queue) {
+
+	(void) threadId;
+	DiscardPayload *p = (DiscardPayload*) data;
+	Bool ok = true;
+
+	for(U64 i = 0; i < 1000; ++i)
+		ok &= JobQueue_pushDestructor(queue, jobDiscardChild, p, jobDiscardChildDestructor, NULL);
+
+	AtomicI64_store(&p->parentDone, 1);
+	return ok;
+}
+
+//A destructor that pushes again while the queue is being freed (like JobTask_skip releasing its dependents)
+
+typedef struct RepushPayload {
+	JobQueue *queue;
+	AtomicI64 ran, destroyed, pushesLeft;
+} RepushPayload;
+
+static Bool jobRepush(void *data, U64 threadId, JobQueue *queue) {
+	(void) threadId; (void) queue;
+	AtomicI64_inc(&((RepushPayload*) data)->ran);
+	return true;
+}
+
+static void jobRepushDestructor(void *data) {
+
+	RepushPayload *p = (RepushPayload*) data;
+	AtomicI64_inc(&p->destroyed);
+
+	if(AtomicI64_dec(&p->pushesLeft) >= 0)
+		JobQueue_pushDestructor(p->queue, jobRepush, p, jobRepushDestructor, NULL);
+}
+
+//Task graph: every task records when it ran (a global sequence number) and fails if a predecessor hadn't run yet.
+
+typedef struct TaskPayload {
+	AtomicI64 *sequence;
+	AtomicI64 ranAt;                    //1 + sequence when it ran, 0 if it didn't
+	AtomicI64 destroyed;
+	const struct TaskPayload *after[2]; //Have to have run before this one
+	Bool fail;
+	U8 padding[7];
+} TaskPayload;
+
+static Bool jobTask(void *data, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+	TaskPayload *p = (TaskPayload*) data;
+
+	for(U64 i = 0; i < 2; ++i)
+		if(p->after[i] && !AtomicI64_load((AtomicI64*) &p->after[i]->ranAt))
+			return false;
+
+	AtomicI64_store(&p->ranAt, AtomicI64_inc(p->sequence));
+	return !p->fail;
+}
+
+static void jobTaskDestructor(void *data) {
+	AtomicI64_inc(&((TaskPayload*) data)->destroyed);
+}
+
+//parallelFor: every index is marked once, so overlap or gaps show up in the sum and the marks.
+
+typedef struct RangePayloadFor {
+	U8 *marks;
+	AtomicI64 *sum;
+	AtomicI64 *chunks;
+	U64 grainSize;
+	AtomicI64 *tooBig;
+} RangePayloadFor;
+
+static Bool jobRange(void *data, U64 begin, U64 end, U64 threadId, JobQueue *queue) {
+
+	(void) threadId; (void) queue;
+	RangePayloadFor *p = (RangePayloadFor*) data;
+
+	if(end - begin > p->grainSize)
+		AtomicI64_inc(p->tooBig);
+
+	I64 sum = 0;
+
+	for (U64 i = begin; i < end; ++i) {
+		++p->marks[i];
+		sum += (I64) i;
+	}
+
+	AtomicI64_add(p->sum, sum);
+	AtomicI64_inc(p->chunks);
+	return true;
+}
+
 //--- JobGroup payloads & callbacks --------------------------------------------
 
 typedef struct GroupResult {
@@ -330,4 +464,337 @@ void Test_jobQueue(Test *t) {
 
 		JobQueue_free(&q);
 	}
+
+	//9. Work stealing: flat jobs pushed by the owner go through the shared FIFO and still all run once.
+
+	{
+		JobQueue q = (JobQueue) { 0 };
+		AtomicI64 counter = (AtomicI64) { 0 };
+
+		if (Test_assert(
+			t, "create work stealing", JobQueue_createFlags(4, EJobQueueFlags_WorkStealing, alloc, &q, e_rr)
+		)) {
+
+			Bool ok = true;
+			for (U64 i = 0; i < 1000; ++i)
+				ok &= JobQueue_push(&q, jobIncrement, &counter, e_rr);
+
+			Test_assert(t, "work stealing: pushed flat jobs", ok);
+			Test_assert(t, "work stealing: wait flat", JobQueue_wait(&q, e_rr));
+			Test_assert(t, "work stealing: every flat job ran once", AtomicI64_load(&counter) == 1000);
+			Test_assert(t, "work stealing: success", JobQueue_isSuccess(&q));
+		}
+
+		JobQueue_free(&q);
+	}
+
+	//10. Work stealing: a tree of jobs pushed from inside jobs (local deques, growing past their initial size).
+
+	{
+		JobQueue q = (JobQueue) { 0 };
+		AtomicI64 counter = (AtomicI64) { 0 };
+		AtomicI64 bad = (AtomicI64) { 0 };
+
+		if (Test_assert(
+			t, "create work stealing tree", JobQueue_createFlags(4, EJobQueueFlags_WorkStealing, alloc, &q, e_rr)
+		)) {
+
+			TreePayload levels[4];
+
+			for(U64 i = 0; i < 4; ++i)
+				levels[i] = (TreePayload) {
+					.counter = &counter, .bad = &bad, .next = i + 1 < 4 ? &levels[i + 1] : NULL,
+					.width = 16, .threadCount = 4
+				};
+
+			Test_assert(t, "work stealing: push root", JobQueue_push(&q, jobTree, &levels[0], e_rr));
+			Test_assert(t, "work stealing: wait tree", JobQueue_wait(&q, e_rr));
+			Test_assert(t, "work stealing: every node ran once", AtomicI64_load(&counter) == 1 + 16 + 256 + 4096);
+			Test_assert(t, "work stealing: threadId within [0, threadCount)", AtomicI64_load(&bad) == 0);
+			Test_assert(t, "work stealing: tree success", JobQueue_isSuccess(&q));
+		}
+
+		JobQueue_free(&q);
+	}
+
+	//11. Work stealing in single threaded mode stays FIFO and deterministic.
+
+	{
+		JobQueue q = (JobQueue) { 0 };
+		ListU8 order = (ListU8) { 0 };
+		OrderPayload payloads[8];
+
+		if (Test_assert(
+			t, "create single threaded work stealing",
+			JobQueue_createFlags(1, EJobQueueFlags_WorkStealing, alloc, &q, e_rr)
+		)) {
+
+			Bool ok = true;
+			for (U8 i = 0; i < 8; ++i) {
+				payloads[i] = (OrderPayload) { .out = &order, .alloc = alloc, .id = i };
+				ok &= JobQueue_push(&q, jobRecordOrder, &payloads[i], e_rr);
+			}
+
+			Test_assert(t, "work stealing: pushed 8 order jobs", ok);
+			Test_assert(t, "work stealing: wait single threaded", JobQueue_wait(&q, e_rr));
+
+			Bool inOrder = order.length == 8;
+			for (U8 i = 0; inOrder && i < 8; ++i)
+				inOrder = order.ptr[i] == i;
+
+			Test_assert(t, "work stealing: single threaded runs jobs in push order", inOrder);
+		}
+
+		ListU8_free(&order, alloc);
+		JobQueue_free(&q);
+	}
+
+	//12. Work stealing: freeing while jobs sit in the deques runs the destructor of every job that didn't run.
+
+	{
+		JobQueue q = (JobQueue) { 0 };
+		DiscardPayload payload = (DiscardPayload) { 0 };
+
+		if (Test_assert(
+			t, "create work stealing discard", JobQueue_createFlags(4, EJobQueueFlags_WorkStealing, alloc, &q, e_rr)
+		)) {
+
+			Test_assert(t, "work stealing: push discard parent", JobQueue_push(&q, jobDiscardParent, &payload, e_rr));
+
+			while(!AtomicI64_load(&payload.parentDone))         //Only workers run jobs, since nobody waits
+				Thread_sleep(100 * MU);
+		}
+
+		JobQueue_free(&q);
+
+		Test_assert(
+			t, "work stealing: every child either ran or was destroyed",
+			AtomicI64_load(&payload.ran) + AtomicI64_load(&payload.destroyed) == 1000
+		);
+	}
+
+	//13. Invalid flags are rejected (NULL e_rr, this is expected to fail)
+
+	{
+		JobQueue q = (JobQueue) { 0 };
+		Test_assert(t, "invalid flags", !JobQueue_createFlags(4, (EJobQueueFlags) 2, alloc, &q, NULL));
+		JobQueue_free(&q);
+	}
+
+	//14. Priorities: in single threaded mode high priority jobs run before normal ones, each in push order.
+
+	{
+		JobQueue q = (JobQueue) { 0 };
+		ListU8 order = (ListU8) { 0 };
+		OrderPayload payloads[6];
+
+		if (Test_assert(t, "create for priorities", JobQueue_create(1, alloc, &q, e_rr))) {
+
+			Bool ok = true;
+
+			for (U8 i = 0; i < 6; ++i) {
+				payloads[i] = (OrderPayload) { .out = &order, .alloc = alloc, .id = i };
+				ok &= JobQueue_pushPriority(
+					&q, i & 1 ? EJobPriority_High : EJobPriority_Normal, jobRecordOrder, &payloads[i], NULL, e_rr
+				);
+			}
+
+			Test_assert(t, "priorities: pushed", ok);
+			Test_assert(t, "priorities: wait", JobQueue_wait(&q, e_rr));
+
+			const U8 expected[] = { 1, 3, 5, 0, 2, 4 };
+			Bool inOrder = order.length == 6;
+
+			for (U8 i = 0; inOrder && i < 6; ++i)
+				inOrder = order.ptr[i] == expected[i];
+
+			Test_assert(t, "priorities: high first, then normal, each in push order", inOrder);
+			Test_assert(t, "priorities: invalid priority", !JobQueue_pushPriority(
+				&q, EJobPriority_Count, jobRecordOrder, &payloads[0], NULL, NULL
+			));
+		}
+
+		ListU8_free(&order, alloc);
+		JobQueue_free(&q);
+	}
+
+	//15. Task graph (diamond a -> b, c -> d) and failure propagation, in single threaded, FIFO and work stealing.
+
+	for (U64 m = 0; m < 3; ++m) {
+
+		JobQueue q = (JobQueue) { 0 };
+
+		const U64 threads = m ? 4 : 1;
+		const EJobQueueFlags flags = m == 2 ? EJobQueueFlags_WorkStealing : EJobQueueFlags_None;
+
+		if (!Test_assert(t, "create for task graph", JobQueue_createFlags(threads, flags, alloc, &q, e_rr))) {
+			JobQueue_free(&q);
+			continue;
+		}
+
+		AtomicI64 sequence = (AtomicI64) { 0 };
+		TaskPayload p[7] = { 0 };
+		JobTask tasks[7] = { 0 };
+
+		for(U64 i = 0; i < 7; ++i)
+			p[i].sequence = &sequence;
+
+		p[1].after[0] = &p[0];
+		p[2].after[0] = &p[0];
+		p[3].after[0] = &p[1];
+		p[3].after[1] = &p[2];
+
+		//4 fails, 5 follows it and 6 follows 5 (both skipped)
+
+		p[4].fail = true;
+
+		Bool ok = true;
+
+		for(U64 i = 0; i < 7; ++i)
+			ok &= JobTask_create(
+				&tasks[i], &q, i == 3 ? EJobPriority_High : EJobPriority_Normal, jobTask, &p[i], jobTaskDestructor, e_rr
+			);
+
+		ok &= JobTask_precede(&tasks[0], &tasks[1], e_rr);
+		ok &= JobTask_precede(&tasks[0], &tasks[2], e_rr);
+		ok &= JobTask_precede(&tasks[1], &tasks[3], e_rr);
+		ok &= JobTask_precede(&tasks[2], &tasks[3], e_rr);
+		ok &= JobTask_precede(&tasks[4], &tasks[5], e_rr);
+		ok &= JobTask_precede(&tasks[5], &tasks[6], e_rr);
+
+		for(U64 i = 7; i-- > 0; )           //Reverse, so nothing depends on submit order
+			ok &= JobTask_submit(&tasks[i], e_rr);
+
+		Test_assert(t, "task graph: created", ok);
+		Test_assert(t, "task graph: wait", JobQueue_wait(&q, e_rr));
+
+		Bool allDone = true;
+
+		for(U64 i = 0; i < 7; ++i)
+			allDone &= JobTask_isDone(&tasks[i]);
+
+		Test_assert(t, "task graph: every task is done", allDone);
+
+		Test_assert(
+			t, "task graph: diamond ran in dependency order",
+			JobTask_isSuccess(&tasks[3]) &&
+			AtomicI64_load(&p[0].ranAt) < AtomicI64_load(&p[1].ranAt) &&
+			AtomicI64_load(&p[0].ranAt) < AtomicI64_load(&p[2].ranAt) &&
+			AtomicI64_load(&p[1].ranAt) < AtomicI64_load(&p[3].ranAt) &&
+			AtomicI64_load(&p[2].ranAt) < AtomicI64_load(&p[3].ranAt)
+		);
+
+		Test_assert(
+			t, "task graph: a failure skips the continuations and runs their destructors",
+			!JobTask_isSuccess(&tasks[4]) && !JobTask_isSuccess(&tasks[5]) && !JobTask_isSuccess(&tasks[6]) &&
+			!AtomicI64_load(&p[5].ranAt) && !AtomicI64_load(&p[6].ranAt) &&
+			AtomicI64_load(&p[5].destroyed) == 1 && AtomicI64_load(&p[6].destroyed) == 1 &&
+			!AtomicI64_load(&p[4].destroyed)
+		);
+
+		Test_assert(t, "task graph: the failed callback fails the queue", !JobQueue_isSuccess(&q));
+
+		//Preceding a task that already finished doesn't wait for it
+
+		JobTask late = (JobTask) { 0 };
+		TaskPayload latePayload = (TaskPayload) { .sequence = &sequence };
+
+		ok = JobTask_create(&late, &q, EJobPriority_Normal, jobTask, &latePayload, NULL, e_rr);
+		ok &= JobTask_precede(&tasks[3], &late, e_rr);
+		ok &= JobTask_submit(&late, e_rr);
+
+		Test_assert(t, "task graph: precede after finish", ok && JobQueue_wait(&q, e_rr));
+		Test_assert(t, "task graph: late task ran", AtomicI64_load(&latePayload.ranAt) && JobTask_isSuccess(&late));
+
+		JobQueue_free(&q);
+	}
+
+	//16. parallelFor covers the range exactly once in chunks of at most grainSize, then runs its continuation.
+
+	for (U64 m = 0; m < 3; ++m) {
+
+		JobQueue q = (JobQueue) { 0 };
+
+		const U64 threads = m ? 4 : 1;
+		const EJobQueueFlags flags = m == 2 ? EJobQueueFlags_WorkStealing : EJobQueueFlags_None;
+		const U64 count = 100003;
+
+		U8 *marks = NULL;
+		Buffer marksBuf = Buffer_createNull();
+
+		if (
+			!Test_assert(t, "create for parallelFor", JobQueue_createFlags(threads, flags, alloc, &q, e_rr)) ||
+			!Test_assert(t, "parallelFor: allocate marks", Buffer_createEmptyBytes(count, alloc, &marksBuf, e_rr))
+		) {
+			JobQueue_free(&q);
+			continue;
+		}
+
+		marks = marksBuf.ptrNonConst;
+
+		AtomicI64 sum = (AtomicI64) { 0 }, chunks = (AtomicI64) { 0 }, tooBig = (AtomicI64) { 0 };
+		AtomicI64 sequence = (AtomicI64) { 0 };
+		RangePayloadFor payload = { .marks = marks, .sum = &sum, .chunks = &chunks, .grainSize = 100, .tooBig = &tooBig };
+
+		JobTask then = (JobTask) { 0 };
+		TaskPayload thenPayload = (TaskPayload) { .sequence = &sequence };
+
+		Bool ok = JobTask_create(&then, &q, EJobPriority_Normal, jobTask, &thenPayload, NULL, e_rr);
+		ok &= JobQueue_parallelFor(&q, count, 100, jobRange, &payload, &then, e_rr);
+		ok &= JobTask_submit(&then, e_rr);
+
+		Test_assert(t, "parallelFor: pushed", ok);
+		Test_assert(t, "parallelFor: wait", JobQueue_wait(&q, e_rr));
+
+		Bool once = true;
+
+		for(U64 i = 0; i < count; ++i)
+			once &= marks[i] == 1;
+
+		Test_assert(t, "parallelFor: every index exactly once", once);
+		Test_assert(t, "parallelFor: sum", AtomicI64_load(&sum) == (I64) (count * (count - 1) / 2));
+		Test_assert(t, "parallelFor: chunks within grainSize", !AtomicI64_load(&tooBig) && AtomicI64_load(&chunks) >= 1000);
+		Test_assert(t, "parallelFor: continuation ran", AtomicI64_load(&thenPayload.ranAt) == 1 && JobTask_isDone(&then));
+
+		//Empty range is a no-op and the continuation still runs once submitted
+
+		JobTask thenEmpty = (JobTask) { 0 };
+		TaskPayload thenEmptyPayload = (TaskPayload) { .sequence = &sequence };
+
+		ok = JobTask_create(&thenEmpty, &q, EJobPriority_Normal, jobTask, &thenEmptyPayload, NULL, e_rr);
+		ok &= JobQueue_parallelFor(&q, 0, 0, jobRange, &payload, &thenEmpty, e_rr);
+		ok &= JobTask_submit(&thenEmpty, e_rr);
+
+		Test_assert(t, "parallelFor: empty range", ok && JobQueue_wait(&q, e_rr));
+		Test_assert(t, "parallelFor: empty range continuation ran", AtomicI64_load(&thenEmptyPayload.ranAt) != 0);
+
+		Buffer_free(&marksBuf, alloc);
+		JobQueue_free(&q);
+	}
+	//17. Freeing runs destructors outside of the lock, what they push is destroyed too (FIFO and work stealing).
+
+	for (U64 m = 0; m < 2; ++m) {
+
+		JobQueue q = (JobQueue) { 0 };
+		RepushPayload payload = (RepushPayload) { .queue = &q, .pushesLeft = (AtomicI64) { 100 } };
+
+		const EJobQueueFlags flags = m ? EJobQueueFlags_WorkStealing : EJobQueueFlags_None;
+
+		if (Test_assert(t, "create for repush", JobQueue_createFlags(1, flags, alloc, &q, e_rr))) {
+
+			Bool ok = true;
+
+			for(U64 i = 0; i < 8; ++i)
+				ok &= JobQueue_pushDestructor(&q, jobRepush, &payload, jobRepushDestructor, e_rr);
+
+			Test_assert(t, "repush: pushed", ok);
+		}
+
+		JobQueue_free(&q);
+
+		Test_assert(
+			t, "repush: every job pushed from a destructor is destroyed",
+			!AtomicI64_load(&payload.ran) && AtomicI64_load(&payload.destroyed) == 8 + 100
+		);
+	}
 }
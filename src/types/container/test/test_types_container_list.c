@@ -26,6 +26,7 @@
 #include "types/container/list_basic_types.h"
 #include "types/container/list_impl.h"
 #include "types/base/algorithm.h"
+#include "types/container/job_queue.h"
 
 //A 64 byte element, so GenericList_alignment derives 64 from the stride and the list goes through the aligned
 // allocator instead of the plain one.
@@ -62,6 +63,48 @@ static ECompareResult cmpU32ByKey(const void *a, const void *b, void *context) {
 	return x < y ? ECompareResult_Lt : (x > y ? ECompareResult_Gt : ECompareResult_Eq);
 }
 
+static ECompareResult cmpU32Asc(const void *a, const void *b, void *context) {
+	(void) context;
+	const U32 x = *(const U32*) a, y = *(const U32*) b;
+	return x < y ? ECompareResult_Lt : (x > y ? ECompareResult_Gt : ECompareResult_Eq);
+}
+
+//For stability checks: sorted by key only, idx records where the element came from
+
+typedef struct KeyIndex {
+	U32 key, idx;
+} KeyIndex;
+
+TList(KeyIndex);
+TListImpl(KeyIndex);
+
+static ECompareResult cmpKeyIndex(const void *a, const void *b, void *context) {
+	(void) context;
+	const U32 x = ((const KeyIndex*) a)->key, y = ((const KeyIndex*) b)->key;
+	return x < y ? ECompareResult_Lt : (x > y ? ECompareResult_Gt : ECompareResult_Eq);
+}
+
+static U64 Test_listRand(U64 *state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+//Patterns that break naive quicksorts: sorted, reversed, all equal, sawtooth, organ pipe, few keys, random
+
+static U32 Test_listPattern(U64 pattern, U64 i, U64 n, U64 *rng) {
+	switch (pattern) {
+		case 0:   return (U32) i;
+		case 1:   return (U32) (n - i);
+		case 2:   return 7;
+		case 3:   return (U32) (i % 97);
+		case 4:   return (U32) (i < n / 2 ? i : n - i);
+		case 5:   return (U32) (Test_listRand(rng) % 4);
+		default:  return (U32) Test_listRand(rng);
+	}
+}
+
 void Test_list(Test *t) {
 
 	const Allocator *alloc = t->alloc;
@@ -362,6 +405,150 @@ void Test_list(Test *t) {
 		ListU32_free(&snapshot, alloc);
 	}
 
+	// -- Sorting --------------------------------------------------------------------------------------
+
+	Test_setModule(t, "ListSort");
+
+	{
+		const U64 n = 100003;
+		U64 rng = 0x9E3779B97F4A7C15;
+
+		ListU64 u64 = (ListU64) { 0 };
+		ListU64 u64b = (ListU64) { 0 };
+		ListI32 i32 = (ListI32) { 0 };
+		ListF32 f32 = (ListF32) { 0 };
+		ListF64 f64 = (ListF64) { 0 };
+		ListU32 u32 = (ListU32) { 0 };
+		ListKeyIndex keyed = (ListKeyIndex) { 0 };
+		JobQueue queue = (JobQueue) { 0 };
+
+		//Integers, in place (sort) and with a temp buffer (sortRadix)
+		//The sum checks nothing was lost or duplicated on the way
+
+		Bool created =
+			ListU64_resize(&u64, n, alloc, e_rr) &&
+			ListU64_resize(&u64b, n, alloc, e_rr) &&
+			ListI32_resize(&i32, n, alloc, e_rr);
+
+		Test_assert(t, "sort lists created", created);
+
+		U64 sum = 0;
+
+		for (U64 i = 0; created && i < n; ++i) {
+			const U64 v = i & 1 ? Test_listRand(&rng) : Test_listRand(&rng) >> 40;      //Mixed widths
+			u64.ptrNonConst[i] = u64b.ptrNonConst[i] = v;
+			i32.ptrNonConst[i] = (I32) (U32) Test_listRand(&rng);
+			sum += v;
+		}
+
+		Test_assert(t, "sort U64", created && ListU64_sort(u64));
+		Test_assert(t, "sortRadix U64", created && ListU64_sortRadix(u64b, alloc, e_rr));
+		Test_assert(t, "sort I32", created && ListI32_sort(i32));
+		Test_assert(t, "sortRadix I32 (already sorted)", created && ListI32_sortRadix(i32, alloc, e_rr));
+
+		Bool sorted = created;
+		U64 sumAfter = 0;
+
+		for (U64 i = 0; created && i < n; ++i) {
+			sorted &= u64.ptr[i] == u64b.ptr[i] && (!i || (u64.ptr[i - 1] <= u64.ptr[i] && i32.ptr[i - 1] <= i32.ptr[i]));
+			sumAfter += u64.ptr[i];
+		}
+
+		Test_assert(t, "radix sorts are ascending and agree", sorted);
+		Test_assert(t, "radix sort keeps every element", sum == sumAfter);
+
+		//Floats, including the special values
+
+		const F32 specialsF32[] = { 3, -0.f, 1e-30f, -1e30f, 0, -2.5f, 2.5f, 1e30f, -1e-30f, -7 };
+		const F64 specialsF64[] = { 3, -0., 1e-300, -1e300, 0, -2.5, 2.5, 1e300, -1e-300, -7 };
+
+		Bool floatsOk = true;
+
+		for(U64 i = 0; i < 1000; ++i) {
+			floatsOk &= ListF32_pushBack(&f32, specialsF32[i % 10] * (F32)(i % 13 + 1), alloc, e_rr);
+			floatsOk &= ListF64_pushBack(&f64, specialsF64[i % 10] * (F64)(i % 13 + 1), alloc, e_rr);
+		}
+
+		floatsOk &= ListF32_sortRadix(f32, alloc, e_rr) && ListF64_sort(f64);
+
+		for(U64 i = 1; floatsOk && i < f32.length; ++i)
+			floatsOk &= f32.ptr[i - 1] <= f32.ptr[i] && f64.ptr[i - 1] <= f64.ptr[i];
+
+		Test_assert(t, "sort F32 and F64 with negatives and zeros", floatsOk);
+
+		//The radix sorts check the stride matches the type
+
+		Test_assert(t, "sortU64 rejects a U32 list", !GenericList_sortU64(ListI32_toList(i32)));
+		Test_assert(t, "sortRadixU64 rejects a U32 list", !GenericList_sortRadixU64(ListI32_toList(i32), alloc, NULL));
+
+		//sortCustom on patterns that are quadratic for a plain quicksort
+
+		Bool patternsOk = ListU32_resize(&u32, n, alloc, e_rr);
+
+		for (U64 pattern = 0; patternsOk && pattern < 7; ++pattern) {
+
+			for(U64 i = 0; i < n; ++i)
+				u32.ptrNonConst[i] = Test_listPattern(pattern, i, n, &rng);
+
+			patternsOk &= ListU32_sortCustom(u32, cmpU32Desc, NULL);
+
+			for(U64 i = 1; i < n; ++i)
+				patternsOk &= u32.ptr[i - 1] >= u32.ptr[i];
+		}
+
+		Test_assert(t, "sortCustom handles sorted, reversed, equal, sawtooth, organ pipe and random", patternsOk);
+
+		//sortStable keeps equal keys in their original order
+
+		Bool stableOk = ListKeyIndex_resize(&keyed, n, alloc, e_rr);
+
+		for(U64 i = 0; stableOk && i < n; ++i)
+			keyed.ptrNonConst[i] = (KeyIndex) { .key = (U32) (Test_listRand(&rng) % 64), .idx = (U32) i };
+
+		stableOk &= ListKeyIndex_sortStable(keyed, cmpKeyIndex, NULL, alloc, e_rr);
+
+		for(U64 i = 1; stableOk && i < n; ++i)
+			stableOk &=
+				keyed.ptr[i - 1].key < keyed.ptr[i].key ||
+				(keyed.ptr[i - 1].key == keyed.ptr[i].key && keyed.ptr[i - 1].idx < keyed.ptr[i].idx);
+
+		Test_assert(t, "sortStable is sorted and stable", stableOk);
+		Test_assert(t, "sortStable requires a comparator", !ListKeyIndex_sortStable(keyed, NULL, NULL, alloc, NULL));
+
+		//sortParallel, both threaded and single threaded (which falls back to sortCustom)
+
+		for (U64 threads = 1; threads <= 4; threads += 3) {
+
+			Bool parallelOk = JobQueue_create(threads, alloc, &queue, e_rr);
+			U64 xorBefore = 0, xorAfter = 0;
+
+			for(U64 i = 0; parallelOk && i < n; ++i) {
+				u32.ptrNonConst[i] = Test_listPattern(i & 1 ? 5 : 6, i, n, &rng);
+				xorBefore ^= (U64) u32.ptr[i] * 0x9E3779B97F4A7C15;
+			}
+
+			parallelOk &= GenericList_sortParallel(ListU32_toList(u32), cmpU32Asc, NULL, &queue, alloc, e_rr);
+
+			for (U64 i = 0; parallelOk && i < n; ++i) {
+				parallelOk &= !i || u32.ptr[i - 1] <= u32.ptr[i];
+				xorAfter ^= (U64) u32.ptr[i] * 0x9E3779B97F4A7C15;
+			}
+
+			Test_assert(t, threads == 1 ? "sortParallel (single threaded)" : "sortParallel (4 threads)", parallelOk);
+			Test_assert(t, "sortParallel keeps every element", xorBefore == xorAfter);
+
+			JobQueue_free(&queue);
+		}
+
+		ListU64_free(&u64, alloc);
+		ListU64_free(&u64b, alloc);
+		ListI32_free(&i32, alloc);
+		ListF32_free(&f32, alloc);
+		ListF64_free(&f64, alloc);
+		ListU32_free(&u32, alloc);
+		ListKeyIndex_free(&keyed, alloc);
+	}
+
 	// -- Over-aligned elements ------------------------------------------------------------------------
 
 	Test_setModule(t, "List/OverAligned");
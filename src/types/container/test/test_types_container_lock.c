@@ -0,0 +1,208 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_lock.c
+//
+//Mutex and RWLock, the parking locks next to SpinLock (which JobQueue's tests already cover).
+
+#include "test_types_container_shared.h"
+#include "types/base/lock.h"
+#include "types/base/thread.h"
+#include "types/base/time.h"
+
+#define LockTest_threads 4
+#define LockTest_iterations 5000
+
+typedef struct LockTest {
+
+	Mutex mutex;
+	RWLock rwLock;
+
+	U64 counter;                //Only touched under the lock, so increments can't be lost
+	U64 pair[2];                //Writers keep both equal, readers check that
+
+	AtomicI64 held, release;    //Handshake for LockTest_holder
+	AtomicI64 bad;
+
+} LockTest;
+
+//Holds the lock on another thread until release is set, to test timeouts and owner checks
+
+static void LockTest_holder(void *data) {
+
+	LockTest *test = (LockTest*) data;
+
+	if(Mutex_lock(&test->mutex, U64_MAX) != ELockAcquire_Acquired)
+		AtomicI64_inc(&test->bad);
+
+	AtomicI64_store(&test->held, 1);
+
+	while(!AtomicI64_load(&test->release))
+		Thread_sleep(10 * MU);
+
+	Mutex_unlock(&test->mutex);
+}
+
+static void LockTest_mutexWorker(void *data) {
+
+	LockTest *test = (LockTest*) data;
+
+	for (U64 i = 0; i < LockTest_iterations; ++i) {
+
+		if (Mutex_lock(&test->mutex, U64_MAX) != ELockAcquire_Acquired) {
+			AtomicI64_inc(&test->bad);
+			continue;
+		}
+
+		++test->counter;
+
+		if(!(i & 255))              //Hold it for a while every now and then, so waiters really park
+			Thread_sleep(50 * MU);
+
+		if(!Mutex_unlock(&test->mutex))
+			AtomicI64_inc(&test->bad);
+	}
+}
+
+static void LockTest_rwWorker(void *data) {
+
+	LockTest *test = (LockTest*) data;
+
+	for (U64 i = 0; i < LockTest_iterations; ++i) {
+
+		if (!(i & 15)) {
+
+			if (RWLock_lockWrite(&test->rwLock, U64_MAX) != ELockAcquire_Acquired) {
+				AtomicI64_inc(&test->bad);
+				continue;
+			}
+
+			++test->pair[0];
+			Thread_sleep(0);
+			++test->pair[1];
+
+			if(!RWLock_unlockWrite(&test->rwLock))
+				AtomicI64_inc(&test->bad);
+
+			continue;
+		}
+
+		if (RWLock_lockRead(&test->rwLock, U64_MAX) != ELockAcquire_Acquired) {
+			AtomicI64_inc(&test->bad);
+			continue;
+		}
+
+		if(*(volatile U64*)&test->pair[0] != *(volatile U64*)&test->pair[1])
+			AtomicI64_inc(&test->bad);
+
+		if(!RWLock_unlockRead(&test->rwLock))
+			AtomicI64_inc(&test->bad);
+	}
+}
+
+void Test_lock(Test *t) {
+
+	const Allocator *alloc = t->alloc;
+	Error *e_rr = &t->err;
+
+	Test_setModule(t, "Lock");
+
+	LockTest test = (LockTest) { 0 };
+	Thread *threads[LockTest_threads] = { 0 };
+
+	//Mutex on one thread
+
+	Test_assert(t, "Mutex invalid", Mutex_lock(NULL, 0) == ELockAcquire_Invalid);
+	Test_assert(t, "Mutex acquire", Mutex_lock(&test.mutex, 0) == ELockAcquire_Acquired);
+	Test_assert(t, "Mutex owned", Mutex_isLockedForThread(&test.mutex));
+	Test_assert(t, "Mutex already", Mutex_lock(&test.mutex, U64_MAX) == ELockAcquire_AlreadyLocked);
+	Test_assert(t, "Mutex unlock", Mutex_unlock(&test.mutex) && !Mutex_isLockedForThread(&test.mutex));
+
+	//Timeouts while another thread holds it
+
+	Bool ok = Test_assert(t, "Mutex holder", Thread_create(alloc, LockTest_holder, &test, &threads[0], e_rr));
+
+	while(ok && !AtomicI64_load(&test.held))
+		Thread_sleep(10 * MU);
+
+	if (ok) {
+
+		Test_assert(t, "Mutex not owned", !Mutex_isLockedForThread(&test.mutex));
+		Test_assert(t, "Mutex try", Mutex_lock(&test.mutex, 0) == ELockAcquire_TimedOut);
+
+		const Ns start = Time_now();
+		Test_assert(t, "Mutex timeout", Mutex_lock(&test.mutex, 5 * MS) == ELockAcquire_TimedOut);
+		Test_assert(t, "Mutex waited", Time_now() - start >= 5 * MS);
+
+		AtomicI64_store(&test.release, 1);
+		Test_assert(t, "Mutex after release", Mutex_lock(&test.mutex, U64_MAX) == ELockAcquire_Acquired);
+		Test_assert(t, "Mutex unlock after wait", Mutex_unlock(&test.mutex));
+	}
+
+	if(threads[0])
+		ok &= Thread_waitAndCleanup(alloc, &threads[0], e_rr);
+
+	//Mutex under contention
+
+	for(U64 i = 0; ok && i < LockTest_threads; ++i)
+		ok = Thread_create(alloc, LockTest_mutexWorker, &test, &threads[i], e_rr);
+
+	for(U64 i = 0; i < LockTest_threads; ++i)
+		if(threads[i])
+			ok &= Thread_waitAndCleanup(alloc, &threads[i], e_rr);
+
+	if (Test_assert(t, "Mutex threads", ok)) {
+		Test_assert(t, "Mutex counter", test.counter == LockTest_threads * LockTest_iterations);
+		Test_assert(t, "Mutex no errors", !AtomicI64_load(&test.bad));
+		Test_assert(t, "Mutex free", !AtomicI64_load(&test.mutex.state));
+	}
+
+	//RWLock on one thread
+
+	Test_assert(t, "RWLock invalid", RWLock_lockRead(NULL, 0) == ELockAcquire_Invalid);
+	Test_assert(t, "RWLock read", RWLock_lockRead(&test.rwLock, 0) == ELockAcquire_Acquired);
+	Test_assert(t, "RWLock second reader", RWLock_lockRead(&test.rwLock, 0) == ELockAcquire_Acquired);
+	Test_assert(t, "RWLock no writer", RWLock_lockWrite(&test.rwLock, MS) == ELockAcquire_TimedOut);
+	Test_assert(t, "RWLock readers stay", RWLock_unlockRead(&test.rwLock) && RWLock_unlockRead(&test.rwLock));
+	Test_assert(t, "RWLock unlocked", !RWLock_isLocked(&test.rwLock));
+
+	Test_assert(t, "RWLock write", RWLock_lockWrite(&test.rwLock, 0) == ELockAcquire_Acquired);
+	Test_assert(t, "RWLock owned", RWLock_isWriteLockedForThread(&test.rwLock));
+	Test_assert(t, "RWLock write again", RWLock_lockWrite(&test.rwLock, 0) == ELockAcquire_AlreadyLocked);
+	Test_assert(t, "RWLock read as writer", RWLock_lockRead(&test.rwLock, 0) == ELockAcquire_AlreadyLocked);
+	Test_assert(t, "RWLock unlock write", RWLock_unlockWrite(&test.rwLock) && !RWLock_isLocked(&test.rwLock));
+
+	//Readers and writers together
+
+	AtomicI64_store(&test.bad, 0);
+
+	for(U64 i = 0; ok && i < LockTest_threads; ++i)
+		ok = Thread_create(alloc, LockTest_rwWorker, &test, &threads[i], e_rr);
+
+	for(U64 i = 0; i < LockTest_threads; ++i)
+		if(threads[i])
+			ok &= Thread_waitAndCleanup(alloc, &threads[i], e_rr);
+
+	if (Test_assert(t, "RWLock threads", ok)) {
+		Test_assert(t, "RWLock consistent", !AtomicI64_load(&test.bad));
+		Test_assert(t, "RWLock writes", test.pair[0] == LockTest_threads * (LockTest_iterations / 16 + 1));
+		Test_assert(t, "RWLock free", !AtomicI64_load(&test.rwLock.state));
+	}
+}
@@ -36,6 +36,7 @@ OXC3_TEST_MAIN(types_container) {
 	Test_md5(&t);
 	Test_crc32c(&t);
 	Test_sha256(&t);
+	Test_xxh3(&t);
 
 	Test_textureFormat(&t);
 
@@ -47,11 +48,20 @@ OXC3_TEST_MAIN(types_container) {
 	Test_containerBuffer(&t);
 	Test_filePaths(&t);
 	Test_list(&t);
+	Test_hashMap(&t);
+	Test_arena(&t);
+	Test_poolAllocator(&t);
 	Test_jobQueue(&t);
+	Test_trace(&t);
+	Test_ringQueue(&t);
+	Test_lock(&t);
+	Test_refPtr(&t);
+	Test_stringAtom(&t);
 	Test_hpp(&t);
 	Test_hppWrappers(&t);
 	Test_memoryStream(&t);
 	Test_encryptionStream(&t);
+	Test_bufferCompress(&t);
 	Test_logOOM(&t);
 
 	BasicAllocator_checkLeakedMem(&t);
@@ -24,6 +24,7 @@
 #include "types/container/test/stream_harness.h"
 #include "types/container/memory_stream.h"
 #include "types/container/buffer.h"
+#include "types/base/mathi.h"
 
 static void Test_memoryStreamCreate(Test *t, const RefPtrType *type) {
 
@@ -138,6 +139,182 @@ static void Test_memoryStreamMove(Test *t, const RefPtrType *type) {
 	RefPtr_dec(&stream);
 }
 
+static void Test_memoryStreamView(Test *t, const RefPtrType *type) {
+
+	Test_setModule(t, "StreamCursor_view");
+
+	U8 data[96 * KIBI];
+
+	for (U64 i = 0; i < sizeof(data); ++i)
+		data[i] = (U8)(i * 13 + (i >> 9));
+
+	RefPtr *readonly = NULL, *writable = NULL;
+	StreamCursor readCursor = (StreamCursor) { 0 }, writeCursor = (StreamCursor) { 0 };
+	Buffer view = Buffer_createNull();
+
+	Buffer dataRef = Buffer_createRefConst(data, sizeof(data));
+
+	if (
+		!MemoryStream_createFromBuffer(&dataRef, EMemoryStreamFlags_None, type, &readonly, &t->err) ||
+		!MemoryStream_create(sizeof(data), EMemoryStreamFlags_IsWritable, type, &writable, &t->err) ||
+		!StreamCursor_create(readonly, 0, false, t->alloc, &readCursor, &t->err) ||
+		!StreamCursor_create(writable, 32 * KIBI, true, t->alloc, &writeCursor, &t->err)
+	) {
+		Test_assert(t, "Create streams", false);
+		goto clean;
+	}
+
+	const OxStream *ro = RefPtr_data(readonly, OxStream);
+	const OxStream *rw = RefPtr_data(writable, OxStream);
+
+	Test_assert(t, "Readonly is mapped", (ro->streamType & EStreamType_Mapped) && ro->mapped == data);
+	Test_assert(t, "Writable isn't mapped", !(rw->streamType & EStreamType_Mapped) && !rw->mapped);
+
+	//Mapped: the view is the data itself, even if it's bigger than the cache
+
+	Test_assert(t, "Mapped view", StreamCursor_view(&readCursor, 1000, 90 * KIBI, &view, t->alloc, &t->err));
+	Test_assert(t, "Mapped view zero copy", view.ptr == data + 1000 && Buffer_length(view) == 90 * KIBI);
+	Test_assert(t, "Out of bounds", !StreamCursor_view(&readCursor, 1, sizeof(data), &view, t->alloc, NULL));
+
+	//Copying a mapped stream skips the cache, after that the writable stream only has a view into its cache
+
+	Test_assert(t, "Copy mapped", StreamCursor_copyStream(&writeCursor, &readCursor, 0, 0, 0, t->alloc, &t->err));
+	Test_assert(t, "Flush", StreamCursor_setReadOnly(&writeCursor, t->alloc, &t->err));
+
+	Test_assert(t, "Cached view", StreamCursor_view(&writeCursor, 40 * KIBI + 3, 100, &view, t->alloc, &t->err));
+
+	Test_assert(
+		t, "Cached view points into cache",
+		view.ptr >= writeCursor.cacheData.ptr &&
+		view.ptr + 100 <= writeCursor.cacheData.ptr + Buffer_length(writeCursor.cacheData)
+	);
+
+	Test_assert(t, "Cached view contents", Buffer_eq(view, Buffer_createRefConst(data + 40 * KIBI + 3, 100)));
+
+	Test_assert(
+		t, "Cached view can't exceed cache",
+		!StreamCursor_view(&writeCursor, 0, 64 * KIBI, &view, t->alloc, NULL)
+	);
+
+clean:
+	StreamCursor_close(&readCursor, t->alloc);
+	StreamCursor_close(&writeCursor, t->alloc);
+	RefPtr_dec(&readonly);
+	RefPtr_dec(&writable);
+}
+
+static void Test_memoryStreamReadAhead(Test *t, const RefPtrType *type) {
+
+	Test_setModule(t, "StreamCursor_enableReadAhead");
+
+	const U64 cacheSize = 32 * KIBI;
+	const U64 size = 16 * cacheSize + 123;        //Last cache is partial
+
+	RefPtr *stream = NULL;
+	StreamCursor cursor = (StreamCursor) { 0 };
+	Buffer data = Buffer_createNull();
+	U8 tmp[1000];
+
+	if (!Buffer_createUninitializedBytes(size, t->alloc, &data, &t->err)) {
+		Test_assert(t, "Alloc data", false);
+		goto clean;
+	}
+
+	for (U64 i = 0; i < size; ++i)
+		((U8*)data.ptrNonConst)[i] = (U8)(i * 7 + (i >> 8));
+
+	if (!MemoryStream_createFromBuffer(&data, EMemoryStreamFlags_None, type, &stream, &t->err)) {
+		Test_assert(t, "Create stream", false);
+		goto clean;
+	}
+
+	if (!StreamCursor_create(stream, cacheSize, false, t->alloc, &cursor, &t->err)) {
+		Test_assert(t, "Create cursor", false);
+		goto clean;
+	}
+
+	Test_assert(t, "Depth > 16 rejected", !StreamCursor_enableReadAhead(&cursor, 17, t->alloc, NULL));
+	Test_assert(t, "Enable", StreamCursor_enableReadAhead(&cursor, 3, t->alloc, &t->err));
+	Test_assert(t, "Enable twice rejected", !StreamCursor_enableReadAhead(&cursor, 3, t->alloc, NULL));
+
+	//Sequential reads that straddle caches, twice to make sure restarting at 0 drops what was prefetched
+
+	for (U64 pass = 0; pass < 2; ++pass) {
+
+		Bool seqOk = true;
+
+		for (U64 it = 0; it < size && seqOk; ) {
+
+			const U64 len = U64_min(sizeof(tmp), size - it);
+
+			if (!StreamCursor_consume(&cursor, &it, tmp, len, t->alloc, &t->err)) {
+				seqOk = false;
+				break;
+			}
+
+			for (U64 i = 0; i < len; ++i)
+				if (tmp[i] != (U8)((it - len + i) * 7 + ((it - len + i) >> 8))) {
+					seqOk = false;
+					break;
+				}
+		}
+
+		Test_assert(t, "Sequential read", seqOk);
+	}
+
+	//Random access falls back to plain reads
+
+	Bool randOk = true;
+	const U64 offsets[] = { 10 * cacheSize + 5, 3, 15 * cacheSize + 100, 11 * cacheSize, 4 * cacheSize - 8 };
+
+	for (U64 j = 0; j < sizeof(offsets) / sizeof(offsets[0]) && randOk; ++j) {
+
+		const U64 off = offsets[j], len = U64_min(16, size - off);
+
+		if (!StreamCursor_read(&cursor, Buffer_createRef(tmp, len), off, 0, len, false, t->alloc, &t->err)) {
+			randOk = false;
+			break;
+		}
+
+		for (U64 i = 0; i < len; ++i)
+			if (tmp[i] != (U8)((off + i) * 7 + ((off + i) >> 8)))
+				randOk = false;
+	}
+
+	Test_assert(t, "Random read", randOk);
+
+	//Cache only loads (like StreamCursor_copyStream) after a resize
+
+	Test_assert(t, "Resize", StreamCursor_resize(&cursor, cacheSize * 2, false, t->alloc, &t->err));
+
+	Bool cacheOk = true;
+
+	for (U64 off = 0; off < size && cacheOk; off += cacheSize * 2) {
+
+		const U64 len = U64_min(cacheSize * 2, size - off);
+
+		if (!StreamCursor_read(&cursor, Buffer_createNull(), off, 0, len, false, t->alloc, &t->err)) {
+			cacheOk = false;
+			break;
+		}
+
+		const U8 *ptr = cursor.cacheData.ptr + (off - cursor.lastLocation);
+
+		for (U64 i = 0; i < len; ++i)
+			if (ptr[i] != (U8)((off + i) * 7 + ((off + i) >> 8))) {
+				cacheOk = false;
+				break;
+			}
+	}
+
+	Test_assert(t, "Cache only read after resize", cacheOk);
+
+clean:
+	StreamCursor_close(&cursor, t->alloc);
+	RefPtr_dec(&stream);
+	Buffer_free(&data, t->alloc);
+}
+
 static Bool MemStream_harnessCreate(const StreamHarness *h, U64 size, Bool isResizable, RefPtr **out, Test *t) {
 
 	(void)h;
@@ -167,6 +344,8 @@ void Test_memoryStream(Test *t) {
 	Test_memoryStreamCreate(t, &type);
 	StreamHarness_testStream(&h, t);
 	Test_memoryStreamMove(t, &type);
+	Test_memoryStreamView(t, &type);
+	Test_memoryStreamReadAhead(t, &type);
 
 	StreamHarness_testCursor(&h, t);
 
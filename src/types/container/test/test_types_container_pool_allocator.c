@@ -0,0 +1,198 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_pool_allocator.c
+
+#include "test_types_container_shared.h"
+#include "types/container/pool_allocator.h"
+#include "types/container/job_queue.h"
+#include "types/container/buffer.h"
+#include "types/container/list_basic_types.h"
+
+#define PoolTest_perJob 256
+#define PoolTest_jobs 32
+
+typedef struct PoolTestJob {
+	PoolAllocator *pool;
+	Buffer blocks[PoolTest_perJob];
+	U64 seed;
+	AtomicI64 *bad;
+} PoolTestJob;
+
+static U64 PoolTest_size(U64 seed, U64 i) { return 1 + ((seed * 31 + i * 977) % 6000); }      //Mostly pooled, some parent
+
+//Allocates and fills every block with a pattern unique to the block
+
+static Bool PoolTest_allocJob(void *data, U64 threadId, JobQueue *queue) {
+
+	(void) queue;
+	PoolTestJob *job = (PoolTestJob*) data;
+	const Allocator *alloc = PoolAllocator_thread(job->pool, threadId);
+
+	for (U64 i = 0; i < PoolTest_perJob; ++i) {
+
+		if(!Buffer_createUninitializedBytes(PoolTest_size(job->seed, i), alloc, &job->blocks[i], NULL))
+			return false;
+
+		for(U64 j = 0; j < Buffer_length(job->blocks[i]); ++j)
+			job->blocks[i].ptrNonConst[j] = (U8)(job->seed + i + j);
+	}
+
+	return true;
+}
+
+//Ran as a separate round, so blocks are usually freed by another thread than the one that allocated them
+
+static Bool PoolTest_freeJob(void *data, U64 threadId, JobQueue *queue) {
+
+	(void) queue;
+	PoolTestJob *job = (PoolTestJob*) data;
+	const Allocator *alloc = PoolAllocator_thread(job->pool, threadId);
+
+	for (U64 i = 0; i < PoolTest_perJob; ++i) {
+
+		for(U64 j = 0; j < Buffer_length(job->blocks[i]); ++j)
+			if (job->blocks[i].ptr[j] != (U8)(job->seed + i + j)) {
+				AtomicI64_inc(job->bad);
+				break;
+			}
+
+		Buffer_free(&job->blocks[i], alloc);
+	}
+
+	return true;
+}
+
+void Test_poolAllocator(Test *t) {
+
+	const Allocator *alloc = t->alloc;
+	Error *e_rr = &t->err;
+
+	Test_setModule(t, "PoolAllocator");
+
+	//1. Size classes and the shared allocator
+
+	{
+		PoolAllocator pool = (PoolAllocator) { 0 };
+
+		if (Test_assert(t, "create shared only", PoolAllocator_create(0, alloc, &pool, e_rr))) {
+
+			Test_assert(t, "no thread allocators", !PoolAllocator_thread(&pool, 0));
+
+			Buffer a = Buffer_createNull(), b = Buffer_createNull(), c = Buffer_createNull(), big = Buffer_createNull();
+
+			Test_assert(t, "alloc 1", Buffer_createUninitializedBytes(1, &pool.allocator, &a, e_rr));
+			Test_assert(t, "alloc 65", Buffer_createUninitializedBytes(65, &pool.allocator, &b, e_rr));
+			Test_assert(t, "alloc 4096", Buffer_createUninitializedBytes(4096, &pool.allocator, &c, e_rr));
+			Test_assert(t, "alloc parent", Buffer_createUninitializedBytes(4097, &pool.allocator, &big, e_rr));
+			Test_assert(t, "aligned", !((U64)a.ptr & 15) && !((U64)b.ptr & 15) && !((U64)c.ptr & 15));
+
+			PoolAllocatorStats stats[PoolAllocator_classCount + 1];
+			PoolAllocator_getStats(&pool, stats);
+
+			Test_assert(t, "class 16", stats[0].allocations == 1 && stats[0].blockSize == 16);
+			Test_assert(t, "class 96", stats[4].allocations == 1 && stats[4].blockSize == 96);
+			Test_assert(t, "class 4096", stats[15].allocations == 1 && stats[15].slabs == 1);
+			Test_assert(t, "parent", stats[PoolAllocator_classCount].allocations == 1);
+
+			const U8 *freed = a.ptr;
+
+			Buffer_free(&a, &pool.allocator);
+			Buffer_free(&c, &pool.allocator);
+			Buffer_free(&big, &pool.allocator);
+
+			Buffer again = Buffer_createNull();
+			Test_assert(t, "realloc", Buffer_createUninitializedBytes(16, &pool.allocator, &again, e_rr));
+			Test_assert(t, "freed block is reused", again.ptr == freed);
+
+			Buffer_free(&again, &pool.allocator);
+			Buffer_free(&b, &pool.allocator);
+
+			PoolAllocator_getStats(&pool, stats);
+
+			Bool balanced = true;
+			for(U64 i = 0; i <= PoolAllocator_classCount; ++i)
+				balanced &= stats[i].allocations == stats[i].frees;
+
+			Test_assert(t, "balanced", balanced);
+		}
+
+		PoolAllocator_free(&pool);
+	}
+
+	//2. Many threads, frees mostly on a different thread than the allocation, magazines refill and flush
+
+	{
+		PoolAllocator pool = (PoolAllocator) { 0 };
+		JobQueue queue = (JobQueue) { 0 };
+		AtomicI64 bad = (AtomicI64) { 0 };
+		Buffer jobBuf = Buffer_createNull();
+
+		Bool ok = JobQueue_create(4, alloc, &queue, e_rr);
+		ok = ok && PoolAllocator_create(JobQueue_threadCount(&queue), alloc, &pool, e_rr);
+		ok = ok && Buffer_createEmptyBytes(sizeof(PoolTestJob) * PoolTest_jobs, alloc, &jobBuf, e_rr);
+
+		if (Test_assert(t, "create threaded", ok)) {
+
+			PoolTestJob *jobs = (PoolTestJob*) jobBuf.ptrNonConst;
+
+			for (U64 round = 0; ok && round < 4; ++round) {
+
+				for (U64 i = 0; ok && i < PoolTest_jobs; ++i) {
+					jobs[i].pool = &pool;
+					jobs[i].seed = i + round * PoolTest_jobs;
+					jobs[i].bad = &bad;
+					ok = JobQueue_push(&queue, PoolTest_allocJob, &jobs[i], e_rr);
+				}
+
+				ok = ok && JobQueue_wait(&queue, e_rr);
+
+				//Reversed, so job i is freed by whichever thread picks it up now
+
+				for(U64 i = PoolTest_jobs; ok && i > 0; --i)
+					ok = JobQueue_push(&queue, PoolTest_freeJob, &jobs[i - 1], e_rr);
+
+				ok = ok && JobQueue_wait(&queue, e_rr);
+			}
+
+			Test_assert(t, "threaded jobs", ok && JobQueue_isSuccess(&queue));
+			Test_assert(t, "no corrupted blocks", !AtomicI64_load(&bad));
+
+			PoolAllocatorStats stats[PoolAllocator_classCount + 1];
+			PoolAllocator_getStats(&pool, stats);
+
+			Bool balanced = true;
+			U64 flushes = 0, refills = 0;
+
+			for (U64 i = 0; i <= PoolAllocator_classCount; ++i) {
+				balanced &= stats[i].allocations == stats[i].frees;
+				flushes += stats[i].flushes;
+				refills += stats[i].refills;
+			}
+
+			Test_assert(t, "threaded balanced", balanced);
+			Test_assert(t, "magazines exchanged with depots", flushes && refills);
+		}
+
+		Buffer_free(&jobBuf, alloc);
+		JobQueue_free(&queue);
+		PoolAllocator_free(&pool);
+	}
+}
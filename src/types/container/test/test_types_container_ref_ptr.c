@@ -0,0 +1,234 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_ref_ptr.c
+//
+//ERefPtrFlags_DeferRelease: retiring on the last dec, RefPtr_collect(Domain) and the batched inc/dec.
+
+#include "test_types_container_shared.h"
+#include "types/container/ref_ptr.h"
+#include "types/base/thread.h"
+
+#define RefPtrTest_threads 4
+#define RefPtrTest_perThread 64
+
+typedef struct RefPtrTestObject {
+	AtomicI64 *freed;
+	RefPtr *child;              //Released by the free, to retire something while collecting
+	RefPtrRetireDomain *domain; //Where it retires to if the type asks, NULL is the process-wide one
+} RefPtrTestObject;
+
+static RefPtrRetireDomain *RefPtrTestObject_retireDomain(void *ptr) {
+	return ((RefPtrTestObject*) ptr)->domain;
+}
+
+static void RefPtrTestObject_free(void *ptr, const Allocator *alloc) {
+	(void) alloc;
+	RefPtrTestObject *obj = (RefPtrTestObject*) ptr;
+	RefPtr_dec(&obj->child);
+	AtomicI64_inc(obj->freed);
+}
+
+typedef struct RefPtrTest {
+	RefPtr *objects[RefPtrTest_threads][RefPtrTest_perThread];
+	AtomicI64 nextThread;
+} RefPtrTest;
+
+//Every thread drops its own objects, so they end up on different retire lists
+
+static void RefPtrTest_dropper(void *data) {
+
+	RefPtrTest *test = (RefPtrTest*) data;
+	const U64 id = (U64) AtomicI64_inc(&test->nextThread) - 1;
+
+	for(U64 i = 0; i < RefPtrTest_perThread; ++i)
+		RefPtr_dec(&test->objects[id][i]);
+}
+
+static Bool RefPtrTest_create(const RefPtrType *type, AtomicI64 *freed, RefPtr **result, Error *e_rr) {
+
+	if(!RefPtr_create(type, result, e_rr))
+		return false;
+
+	*RefPtr_data(*result, RefPtrTestObject) = (RefPtrTestObject) { .freed = freed };
+	return true;
+}
+
+void Test_refPtr(Test *t) {
+
+	const Allocator *alloc = t->alloc;
+	Error *e_rr = &t->err;
+
+	Test_setModule(t, "RefPtr");
+
+	AtomicI64 freed = (AtomicI64) { 0 };
+
+	const RefPtrType deferred = (RefPtrType) {
+		.lengthAndAlignment = RefPtrType_pack(sizeof(RefPtrTestObject), alignof(RefPtrTestObject)),
+		.alloc = alloc,
+		.free = RefPtrTestObject_free,
+		.flags = ERefPtrFlags_DeferRelease
+	};
+
+	RefPtrType immediate = deferred;
+	immediate.flags = ERefPtrFlags_None;
+
+	RefPtr_collect();           //Start without anything retired by someone else
+
+	//Last dec retires instead of freeing
+
+	RefPtr *a = NULL;
+
+	if (Test_assert(t, "create", RefPtrTest_create(&deferred, &freed, &a, e_rr))) {
+
+		RefPtr *keep = a;
+
+		Test_assert(t, "inc", RefPtr_inc(a) && !RefPtr_isRetired(a));
+		RefPtr_dec(&a);
+		Test_assert(t, "dec keeps it alive", !a && !RefPtr_isRetired(keep) && !AtomicI64_load(&freed));
+
+		a = keep;
+		RefPtr_dec(&a);
+		Test_assert(t, "retired", RefPtr_isRetired(keep) && !AtomicI64_load(&freed));
+		Test_assert(t, "no revive", !RefPtr_inc(keep));
+		Test_assert(t, "collect", RefPtr_collect() == 1 && AtomicI64_load(&freed) == 1);
+		Test_assert(t, "collect empty", !RefPtr_collect());
+	}
+
+	//Immediate types are untouched
+
+	if (Test_assert(t, "create immediate", RefPtrTest_create(&immediate, &freed, &a, e_rr))) {
+		RefPtr_dec(&a);
+		Test_assert(t, "immediate free", AtomicI64_load(&freed) == 2 && !RefPtr_collect());
+	}
+
+	//A free that retires a child, which the same collect has to pick up
+
+	RefPtr *parent = NULL, *child = NULL;
+	Bool ok = Test_assert(t, "create parent", RefPtrTest_create(&deferred, &freed, &parent, e_rr));
+	ok &= Test_assert(t, "create child", RefPtrTest_create(&deferred, &freed, &child, e_rr));
+
+	if (ok) {
+		RefPtr_data(parent, RefPtrTestObject)->child = child;
+		child = NULL;
+		RefPtr_dec(&parent);
+		Test_assert(t, "nested collect", RefPtr_collect() == 2 && AtomicI64_load(&freed) == 4);
+	}
+
+	RefPtr_dec(&parent);
+	RefPtr_dec(&child);
+	AtomicI64_store(&freed, 0);
+
+	//Batched, mixed with immediate ones and NULLs
+
+	RefPtr *many[8] = { 0 }, *refs[8] = { 0 }, *copy[8] = { 0 };
+
+	for(U64 i = 0; ok && i < 7; ++i)
+		ok = RefPtrTest_create(i & 1 ? &immediate : &deferred, &freed, &many[i], e_rr);
+
+	for(U64 i = 0; i < 8; ++i)
+		refs[i] = copy[i] = many[i];
+
+	if (Test_assert(t, "create many", ok)) {
+
+		Test_assert(t, "incMany", RefPtr_incMany(refs, 8));
+		RefPtr_decMany(refs, 8);
+		Test_assert(t, "decMany clears", !refs[0] && !refs[6]);
+		Test_assert(t, "decMany keeps alive", !AtomicI64_load(&freed) && !RefPtr_isRetired(copy[0]));
+
+		RefPtr_decMany(many, 8);
+		Test_assert(t, "decMany immediate", AtomicI64_load(&freed) == 3);
+		Test_assert(t, "decMany retired", RefPtr_isRetired(copy[0]) && RefPtr_isRetired(copy[6]));
+		Test_assert(t, "incMany retired", !RefPtr_incMany(copy, 1));
+		Test_assert(t, "collect many", RefPtr_collect() == 4 && AtomicI64_load(&freed) == 7);
+	}
+
+	RefPtr_decMany(many, 8);
+	AtomicI64_store(&freed, 0);
+
+	//Retired per owner, collecting one owner leaves the others alone
+
+	RefPtrType owned = deferred;
+	owned.retireDomain = RefPtrTestObject_retireDomain;
+
+	RefPtrRetireDomain domains[2];
+	RefPtrRetireDomain_create(&domains[0]);
+	RefPtrRetireDomain_create(&domains[1]);
+
+	RefPtr *perOwner[3] = { 0 };
+	ok = true;
+
+	for(U64 i = 0; ok && i < 3; ++i)
+		ok = RefPtrTest_create(&owned, &freed, &perOwner[i], e_rr);
+
+	if (Test_assert(t, "create owned", ok)) {
+
+		RefPtr_data(perOwner[0], RefPtrTestObject)->domain = &domains[0];
+		RefPtr_data(perOwner[1], RefPtrTestObject)->domain = &domains[1];
+
+		RefPtr_decMany(perOwner, 3);
+		Test_assert(t, "owned retired", !AtomicI64_load(&freed));
+		Test_assert(t, "collect domain", RefPtr_collectDomain(&domains[0]) == 1 && AtomicI64_load(&freed) == 1);
+		Test_assert(t, "collect domain empty", !RefPtr_collectDomain(&domains[0]));
+		Test_assert(t, "collect all domains", RefPtr_collect() == 2 && AtomicI64_load(&freed) == 3);
+	}
+
+	RefPtr_decMany(perOwner, 3);
+
+	if (Test_assert(t, "create unregistered", RefPtrTest_create(&owned, &freed, &perOwner[0], e_rr))) {
+		RefPtr_data(perOwner[0], RefPtrTestObject)->domain = &domains[1];
+		RefPtr_dec(&perOwner[0]);
+		RefPtrRetireDomain_free(&domains[1]);
+		Test_assert(t, "free domain collects", AtomicI64_load(&freed) == 4 && !RefPtr_collect());
+	}
+
+	RefPtrRetireDomain_free(&domains[0]);
+	RefPtrRetireDomain_free(&domains[1]);
+	AtomicI64_store(&freed, 0);
+
+	//Retired on other threads, collected here
+
+	RefPtrTest test = (RefPtrTest) { 0 };
+	Thread *threads[RefPtrTest_threads] = { 0 };
+	ok = true;
+
+	for(U64 i = 0; ok && i < RefPtrTest_threads; ++i)
+		for(U64 j = 0; ok && j < RefPtrTest_perThread; ++j)
+			ok = RefPtrTest_create(&deferred, &freed, &test.objects[i][j], e_rr);
+
+	for(U64 i = 0; ok && i < RefPtrTest_threads; ++i)
+		ok = Thread_create(alloc, RefPtrTest_dropper, &test, &threads[i], e_rr);
+
+	for(U64 i = 0; i < RefPtrTest_threads; ++i)
+		if(threads[i])
+			ok &= Thread_waitAndCleanup(alloc, &threads[i], e_rr);
+
+	if (Test_assert(t, "threads", ok)) {
+		Test_assert(t, "threads retired", !AtomicI64_load(&freed));
+		Test_assert(t, "threads collect", RefPtr_collect() == RefPtrTest_threads * RefPtrTest_perThread);
+		Test_assert(t, "threads freed", AtomicI64_load(&freed) == RefPtrTest_threads * RefPtrTest_perThread);
+	}
+
+	for(U64 i = 0; i < RefPtrTest_threads; ++i)
+		for(U64 j = 0; j < RefPtrTest_perThread; ++j)
+			RefPtr_dec(&test.objects[i][j]);
+
+	RefPtr_collect();
+}
@@ -0,0 +1,209 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_ring_queue.c
+
+#include "test_types_container_shared.h"
+#include "types/container/ring_queue.h"
+#include "types/base/thread.h"
+
+#define RingQueueTest_threads 4
+#define RingQueueTest_perThread 20000
+
+//Every element is (producer << 32) | i, so a consumer can check the elements of one producer arrive in order
+
+typedef struct RingQueueTest {
+
+	MPMCQueue mpmc;
+	SPSCQueue spsc;
+
+	AtomicI64 popped, sum, bad;
+
+	U64 producer;                   //Index of the producer, only set on the per thread copies
+	struct RingQueueTest *shared;
+
+} RingQueueTest;
+
+static void RingQueueTest_producer(void *data) {
+
+	RingQueueTest *self = (RingQueueTest*) data;
+
+	for (U64 i = 0; i < RingQueueTest_perThread; ++i) {
+
+		const U64 v = (self->producer << 32) | i;
+
+		while(!MPMCQueue_push(&self->shared->mpmc, &v))
+			Thread_sleep(0);
+	}
+}
+
+static void RingQueueTest_consumer(void *data) {
+
+	RingQueueTest *shared = ((RingQueueTest*) data)->shared;
+	U64 next[RingQueueTest_threads] = { 0 };
+	const I64 total = RingQueueTest_threads * RingQueueTest_perThread;
+
+	while (AtomicI64_load(&shared->popped) < total) {
+
+		U64 v = 0;
+
+		if (!MPMCQueue_pop(&shared->mpmc, &v)) {
+			Thread_sleep(0);
+			continue;
+		}
+
+		const U64 producer = v >> 32, i = (U32) v;
+
+		if(producer >= RingQueueTest_threads || i < next[producer])
+			AtomicI64_inc(&shared->bad);
+
+		else next[producer] = i + 1;
+
+		AtomicI64_add(&shared->sum, (I64) v);
+		AtomicI64_inc(&shared->popped);
+	}
+}
+
+static void RingQueueTest_spscProducer(void *data) {
+
+	RingQueueTest *shared = (RingQueueTest*) data;
+
+	for(U64 i = 0; i < RingQueueTest_perThread; ++i)
+		while(!SPSCQueue_push(&shared->spsc, &i))
+			Thread_sleep(0);
+}
+
+void Test_ringQueue(Test *t) {
+
+	const Allocator *alloc = t->alloc;
+	Error *e_rr = &t->err;
+
+	Test_setModule(t, "RingQueue");
+
+	RingQueueTest shared = (RingQueueTest) { 0 };
+	RingQueueTest perThread[RingQueueTest_threads * 2] = { 0 };
+	Thread *threads[RingQueueTest_threads * 2] = { 0 };
+
+	//Creation
+
+	Test_assert(t, "stride required", !MPMCQueue_create(8, 0, alloc, &shared.mpmc, NULL));
+	Test_assert(t, "queue required", !SPSCQueue_create(8, 8, alloc, NULL, NULL));
+	Test_assert(t, "capacity limit", !MPMCQueue_create(U64_MAX, 8, alloc, &shared.mpmc, NULL));
+
+	Bool ok = Test_assert(t, "create", MPMCQueue_create(5, sizeof(U64), alloc, &shared.mpmc, e_rr));
+	ok = ok && Test_assert(t, "capacity pow2", MPMCQueue_capacity(&shared.mpmc) == 8);
+	ok = ok && Test_assert(t, "not twice", !MPMCQueue_create(5, sizeof(U64), alloc, &shared.mpmc, NULL));
+
+	//Single threaded: FIFO, full and empty
+
+	for(U64 i = 0; ok && i < 8; ++i)
+		ok = MPMCQueue_push(&shared.mpmc, &i);
+
+	const U64 extra = 8;
+	ok = ok && Test_assert(t, "full", !MPMCQueue_push(&shared.mpmc, &extra) && MPMCQueue_length(&shared.mpmc) == 8);
+
+	for (U64 i = 0; ok && i < 24; ++i) {                 //Wrap around a few times
+		U64 v = U64_MAX;
+		const U64 next = i + 8;
+		ok = MPMCQueue_pop(&shared.mpmc, &v) && v == i && MPMCQueue_push(&shared.mpmc, &next);
+	}
+
+	for (U64 i = 24; ok && i < 32; ++i) {
+		U64 v = U64_MAX;
+		ok = MPMCQueue_pop(&shared.mpmc, &v) && v == i;
+	}
+
+	ok = Test_assert(t, "MPMC FIFO", ok);
+	ok = ok && Test_assert(t, "empty", !MPMCQueue_pop(&shared.mpmc, NULL) && !MPMCQueue_length(&shared.mpmc));
+
+	//Many producers and consumers
+
+	for (U64 i = 0; ok && i < RingQueueTest_threads * 2; ++i) {
+
+		perThread[i] = (RingQueueTest) { .producer = i % RingQueueTest_threads, .shared = &shared };
+
+		ok = Thread_create(
+			alloc,
+			i < RingQueueTest_threads ? RingQueueTest_producer : RingQueueTest_consumer,
+			&perThread[i],
+			&threads[i],
+			e_rr
+		);
+	}
+
+	for(U64 i = 0; i < RingQueueTest_threads * 2; ++i)
+		if(threads[i])
+			ok &= Thread_waitAndCleanup(alloc, &threads[i], e_rr);
+
+	if (Test_assert(t, "MPMC threads", ok)) {
+
+		const U64 n = RingQueueTest_perThread;
+		const U64 threadCount = RingQueueTest_threads;
+		const U64 expected = threadCount * (n * (n - 1) / 2) + ((threadCount * (threadCount - 1) / 2 * n) << 32);
+
+		Test_assert(t, "MPMC count", AtomicI64_load(&shared.popped) == RingQueueTest_threads * RingQueueTest_perThread);
+		Test_assert(t, "MPMC sum", (U64) AtomicI64_load(&shared.sum) == expected);
+		Test_assert(t, "MPMC order", !AtomicI64_load(&shared.bad));
+		Test_assert(t, "MPMC drained", !MPMCQueue_length(&shared.mpmc));
+	}
+
+	MPMCQueue_free(&shared.mpmc, alloc);
+
+	//SPSC: single threaded FIFO, then a producer thread against this thread
+
+	ok = Test_assert(t, "SPSC create", SPSCQueue_create(3, sizeof(U64), alloc, &shared.spsc, e_rr));
+	ok = ok && Test_assert(t, "SPSC capacity", SPSCQueue_capacity(&shared.spsc) == 4);
+
+	for(U64 i = 0; ok && i < 4; ++i)
+		ok = SPSCQueue_push(&shared.spsc, &i);
+
+	ok = ok && Test_assert(t, "SPSC full", !SPSCQueue_push(&shared.spsc, &extra) && SPSCQueue_length(&shared.spsc) == 4);
+
+	for (U64 i = 0; ok && i < 4; ++i) {
+		U64 v = U64_MAX;
+		ok = SPSCQueue_pop(&shared.spsc, &v) && v == i;
+	}
+
+	ok = Test_assert(t, "SPSC FIFO", ok);
+	ok = ok && Test_assert(t, "SPSC empty", !SPSCQueue_pop(&shared.spsc, NULL));
+	ok = ok && Thread_create(alloc, RingQueueTest_spscProducer, &shared, &threads[0], e_rr);
+
+	U64 received = 0, outOfOrder = 0;
+
+	while (ok && received < RingQueueTest_perThread) {     //Keeps draining on a mismatch, or the producer never finishes
+
+		U64 v = U64_MAX;
+
+		if (!SPSCQueue_pop(&shared.spsc, &v)) {
+			Thread_sleep(0);
+			continue;
+		}
+
+		outOfOrder += v != received;
+		++received;
+	}
+
+	if(threads[0])
+		ok &= Thread_waitAndCleanup(alloc, &threads[0], e_rr);
+
+	Test_assert(t, "SPSC thread", ok);
+	Test_assert(t, "SPSC order", received == RingQueueTest_perThread && !outOfOrder);
+	SPSCQueue_free(&shared.spsc, alloc);
+}
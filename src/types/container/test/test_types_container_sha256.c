@@ -148,6 +148,58 @@ void Test_sha256(Test *t) {
 
 	Test_assert(t, "SHA256: Alloc success", allocSuccess);
 
+	//Multi-buffer: the known vectors in one batch, then messages of every length around the block boundaries.
+	//Every width is forced in turn; a CPU without it runs the widest below it, which is still a valid check.
+
+	Test_setModule(t, "SHA256 batch");
+
+	Buffer bufs[200];
+	U32 outputs[200][8];
+	U32 expected[200][8];
+
+	static const U8 laneCounts[] = { 1, 4, 8, 16, 0 };
+	static const C8 *laneNames[] = { "1 lane", "4 lanes", "8 lanes", "16 lanes", "auto" };
+
+	for (U64 l = 0; l < sizeof(laneCounts); ++l) {
+
+		for (U64 i = 0; i < validCount; ++i)
+			bufs[i] = CharString_bufferConst(inputs[i]);
+
+		Buffer_sha256BatchLanes(bufs, validCount, outputs, laneCounts[l]);
+
+		Bool match = true;
+
+		for (U64 i = 0; i < validCount; ++i)
+			for (U64 j = 0; j < 8; ++j)
+				match &= outputs[i][j] == resultHashes[i][j];
+
+		Test_assert(t, laneNames[l], match);
+	}
+
+	U8 pattern[600];
+
+	for (U64 i = 0; i < sizeof(pattern); ++i)
+		pattern[i] = (U8)(i * 29 + (i >> 3));
+
+	for (U64 i = 0; i < 200; ++i) {        //Lengths 0 - 199, then some multi block ones with every tail size
+		const U64 len = i < 140 ? i : (i * 37) % 590;
+		bufs[i] = Buffer_createRefConst(pattern + (i & 7), len);
+		Buffer_sha256(bufs[i], expected[i]);
+	}
+
+	for (U64 l = 0; l < sizeof(laneCounts); ++l) {
+
+		Buffer_sha256BatchLanes(bufs, 200, outputs, laneCounts[l]);
+
+		Bool match = true;
+
+		for (U64 i = 0; i < 200; ++i)
+			for (U64 j = 0; j < 8; ++j)
+				match &= outputs[i][j] == expected[i][j];
+
+		Test_assert(t, laneNames[l], match);
+	}
+
 	for (U64 i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i)
 		CharString_free(&inputs[i], t->alloc);
 }
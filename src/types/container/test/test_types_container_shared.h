@@ -28,7 +28,15 @@ void Test_stringOps(Test *test);   //CharString beyond number conversion
 void Test_containerBuffer(Test *test);
 void Test_filePaths(Test *test);    //File_resolve / File_makeRelative
 void Test_list(Test *test);
+void Test_hashMap(Test *test);
+void Test_arena(Test *test);
+void Test_poolAllocator(Test *test);
 void Test_jobQueue(Test *test);
+void Test_trace(Test *test);
+void Test_ringQueue(Test *test);
+void Test_lock(Test *test);
+void Test_refPtr(Test *test);
+void Test_stringAtom(Test *test);
 void Test_hpp(Test *test);          //Defined in the C++ TU test_types_container_hpp.cpp
 void Test_hppWrappers(Test *test);  //Defined in the C++ TU test_types_container_hpp_wrappers.cpp
 void Test_bigInt(Test *test);
@@ -38,8 +46,10 @@ void Test_aes256gcm(Test *test);
 void Test_sha256(Test *test);
 void Test_crc32c(Test *test);
 void Test_md5(Test *test);
+void Test_xxh3(Test *test);
 void Test_memoryStream(Test *test);
 void Test_encryptionStream(Test *test);
+void Test_bufferCompress(Test *test);     //Includes CompressionStream
 void Test_textureFormat(Test *test);
 void Test_allocationBuffer(Test *test);
 void Test_logOOM(Test *test);
@@ -0,0 +1,151 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_string_atom.c
+
+#include "test_types_container_shared.h"
+#include "types/container/string_atom.h"
+#include "types/container/string.h"
+#include "types/base/string_read_helper.h"
+#include "types/base/thread.h"
+
+#include <inttypes.h>
+
+#define StringAtomTest_threads 4
+#define StringAtomTest_names 3000        //More than two pages
+
+typedef struct StringAtomTest {
+	StringAtomTable table;
+	CharString names[StringAtomTest_names];
+	StringAtom atoms[StringAtomTest_threads][StringAtomTest_names];
+	AtomicI64 nextThread, bad;
+} StringAtomTest;
+
+//Every thread interns all names, starting somewhere else, so they race on adding the same ones
+
+static void StringAtomTest_worker(void *data) {
+
+	StringAtomTest *test = (StringAtomTest*) data;
+	const U64 id = (U64) AtomicI64_inc(&test->nextThread) - 1;
+
+	for (U64 j = 0; j < StringAtomTest_names; ++j) {
+
+		const U64 i = (j + id * StringAtomTest_names / StringAtomTest_threads) % StringAtomTest_names;
+
+		if(!StringAtomTable_intern(&test->table, test->names[i], &test->atoms[id][i], NULL))
+			AtomicI64_inc(&test->bad);
+	}
+}
+
+void Test_stringAtom(Test *t) {
+
+	const Allocator *alloc = t->alloc;
+	Error *e_rr = &t->err;
+
+	Test_setModule(t, "StringAtom");
+
+	StringAtomTest *test = NULL;
+	Buffer testBuf = Buffer_createNull();
+	Thread *threads[StringAtomTest_threads] = { 0 };
+
+	if(!Test_assert(t, "alloc", Buffer_createEmptyBytes(sizeof(StringAtomTest), alloc, &testBuf, e_rr)))
+		return;
+
+	test = (StringAtomTest*) testBuf.ptrNonConst;
+	StringAtomTable *table = &test->table;
+
+	Test_assert(t, "table required", !StringAtomTable_create(alloc, NULL, NULL));
+
+	if(!Test_assert(t, "create", StringAtomTable_create(alloc, table, e_rr)))
+		goto clean;
+
+	//Single thread
+
+	CharString a = CharString_createRefCStrConst("albedo");
+	C8 aCopy[] = "albedo";
+	CharString b = CharString_createRefSizedConst("normal map", 6, false);        //"normal" without terminator
+
+	StringAtom atomA = StringAtom_none, atomA2 = StringAtom_none, atomB = StringAtom_none, atomEmpty = StringAtom_none;
+
+	Test_assert(t, "find missing", StringAtomTable_find(table, a) == StringAtom_none);
+	Test_assert(t, "intern", StringAtomTable_intern(table, a, &atomA, e_rr) && atomA != StringAtom_none);
+	Test_assert(t, "intern copy", StringAtomTable_intern(table, CharString_createRefCStrConst(aCopy), &atomA2, e_rr));
+	Test_assert(t, "same atom", atomA == atomA2 && StringAtomTable_find(table, a) == atomA);
+	Test_assert(t, "intern other", StringAtomTable_intern(table, b, &atomB, e_rr) && atomB != atomA);
+	Test_assert(t, "intern empty", StringAtomTable_intern(table, CharString_createNull(), &atomEmpty, e_rr));
+	Test_assert(t, "empty unique", atomEmpty && atomEmpty != atomA && atomEmpty != atomB);
+	Test_assert(t, "count", StringAtomTable_count(table) == 3);
+
+	CharString strB = StringAtomTable_string(table, atomB);
+	Test_assert(t, "string", CharString_equalsStringSensitive(&strB, &b));
+	Test_assert(t, "string terminated", CharString_isNullTerminated(strB) && !strB.ptr[CharString_length(strB)]);
+	Test_assert(t, "string const", CharString_isConstRef(strB));
+	Test_assert(t, "hash", StringAtomTable_hash(table, atomA) == CharString_hash(a));
+	Test_assert(t, "case sensitive", StringAtomTable_find(table, CharString_createRefCStrConst("Albedo")) == StringAtom_none);
+	Test_assert(t, "unknown atom", CharString_isEmpty(StringAtomTable_string(table, 1234)));
+	Test_assert(t, "none atom", !StringAtomTable_entry(table, StringAtom_none));
+
+	StringAtomTable_free(table);
+
+	//Threads racing on the same names
+
+	Bool ok = Test_assert(t, "recreate", StringAtomTable_create(alloc, table, e_rr));
+
+	for(U64 i = 0; ok && i < StringAtomTest_names; ++i)
+		ok = CharString_format(alloc, &test->names[i], e_rr, "name%"PRIu64, i);
+
+	for(U64 i = 0; ok && i < StringAtomTest_threads; ++i)
+		ok = Thread_create(alloc, StringAtomTest_worker, test, &threads[i], e_rr);
+
+	for(U64 i = 0; i < StringAtomTest_threads; ++i)
+		if(threads[i])
+			ok &= Thread_waitAndCleanup(alloc, &threads[i], e_rr);
+
+	if (Test_assert(t, "threads", ok)) {
+
+		Test_assert(t, "threads no errors", !AtomicI64_load(&test->bad));
+		Test_assert(t, "threads count", StringAtomTable_count(table) == StringAtomTest_names);
+
+		Bool same = true;
+
+		for (U64 i = 0; i < StringAtomTest_names; ++i) {
+
+			for(U64 j = 1; j < StringAtomTest_threads; ++j)
+				same &= test->atoms[j][i] == test->atoms[0][i];
+
+			CharString str = StringAtomTable_string(table, test->atoms[0][i]);
+			same &= CharString_equalsStringSensitive(&str, &test->names[i]);
+		}
+
+		Test_assert(t, "threads same atoms", same);
+	}
+
+clean:
+
+	if (test) {
+
+		for(U64 i = 0; i < StringAtomTest_names; ++i)
+			CharString_free(&test->names[i], alloc);
+
+		StringAtomTable_free(&test->table);
+	}
+
+	Buffer_free(&testBuf, alloc);
+}
@@ -32,6 +32,8 @@
 #include "types/base/string_mut_helper.h"
 #include "types/container/string.h"
 #include "types/container/string_helper.h"
+#include "types/container/string_unicode.h"
+#include "types/container/list_basic_types.h"
 #include "types/container/list_impl.h"
 
 //Shorthand: a const ref to a literal, which is what most of these compare against
@@ -318,6 +320,188 @@ static void Test_stringSearch(Test *t) {
 	else Test_assert(t, "hash copy", false);
 }
 
+//========================= search over long strings =========================
+
+//The search functions step through 64 bytes at a time, so everything above fits in one partial block.
+//These compare against a plain loop on text long enough to cover several blocks, with matches that straddle a
+// block boundary, that sit at the very end and that only exist case insensitively.
+
+static U64 Test_naiveFind(const C8 *s, U64 len, const C8 *needle, U64 needleLen, Bool insensitive) {
+
+	for (U64 i = 0; i + needleLen <= len; ++i) {
+
+		U64 j = 0;
+
+		for(; j < needleLen; ++j)
+			if(insensitive ? C8_toLower(s[i + j]) != C8_toLower(needle[j]) : s[i + j] != needle[j])
+				break;
+
+		if(j == needleLen)
+			return i;
+	}
+
+	return U64_MAX;
+}
+
+static void Test_stringSearchLong(Test *t) {
+
+	Test_setModule(t, "CharString search long");
+
+	//Pseudo random lowercase text with a few markers placed around the 64 byte boundaries
+
+	C8 text[777];
+
+	for(U64 i = 0, x = 0x2545F491; i < sizeof(text) - 1; ++i) {
+		x = x * 6364136223846793005ull + 1442695040888963407ull;
+		text[i] = (C8)('a' + (x >> 59) % 8);
+	}
+
+	text[sizeof(text) - 1] = '\0';
+
+	//"XyZ" straddles the first boundary and ends the text, "xYz" only matches insensitively
+
+	for (U64 i = 0; i < 3; ++i) {
+		text[63 + i] = "XyZ"[i];
+		text[190 + i] = "xYz"[i];
+		text[sizeof(text) - 4 + i] = "XyZ"[i];
+	}
+
+	const CharString s = CharString_createRefSizedConst(text, sizeof(text) - 1, true);
+	const U64 len = CharString_length(s);
+
+	Bool ok = true;
+
+	for (C8 c = 'a'; c <= 'z'; ++c) {
+
+		U64 first = U64_MAX, last = U64_MAX, count = 0;
+
+		for(U64 i = 0; i < len; ++i)
+			if(text[i] == c) {
+				first = first == U64_MAX ? i : first;
+				last = i;
+				++count;
+			}
+
+		ok &= CharString_findFirstSensitive(&s, c, 0, 0) == first;
+		ok &= CharString_findLastSensitive(&s, c, 0, 0) == last;
+		ok &= CharString_countAllSensitive(&s, c, 0) == count;
+	}
+
+	Test_assert(t, "find/count char match a plain loop", ok);
+
+	//Every offset, so the scalar head and tail and the block loop all get hit
+	ok = true;
+
+	for (U64 off = 0; off < len; off += 7) {
+		const U64 found = Test_naiveFind(text + off, len - off, "y", 1, false);
+		ok &= CharString_findFirstSensitive(&s, 'y', off, 0) == (found == U64_MAX ? U64_MAX : found + off);
+	}
+
+	Test_assert(t, "findFirst char from every offset", ok);
+
+	const CharString xyz = S("XyZ"), lower = S("xyz");
+
+	Test_assert(t, "findFirstString across a block boundary", CharString_findFirstStringSensitive(&s, &xyz, 0, 0) == 63);
+	Test_assert(t, "findFirstString at the end", CharString_findFirstStringSensitive(&s, &xyz, 64, 0) == len - 3);
+	Test_assert(t, "findFirstString insensitive", CharString_findFirstStringInsensitive(&s, &lower, 64, 0) == 190);
+	Test_assert(t, "countAllString", CharString_countAllStringSensitive(&s, &xyz, 0) == 2);
+	Test_assert(t, "countAllString insensitive", CharString_countAllStringInsensitive(&s, &lower, 0) == 3);
+
+	//Needles of every length up to a block and a bit, taken from the text itself (so they're always found)
+	ok = true;
+
+	for (U64 n = 1; n <= 70; ++n) {
+
+		const U64 at = (n * 37) % (len - n);
+		const CharString needle = CharString_createRefSizedConst(text + at, n, false);
+
+		ok &= CharString_findFirstStringSensitive(&s, &needle, 0, 0) == Test_naiveFind(text, len, text + at, n, false);
+		ok &= CharString_findFirstStringInsensitive(&s, &needle, 0, 0) == Test_naiveFind(text, len, text + at, n, true);
+	}
+
+	Test_assert(t, "findFirstString matches a plain loop", ok);
+
+	//findAllString doesn't report a partial match at the end of the string
+
+	ListU64 finds = (ListU64) { 0 };
+	const CharString tail = S("XyZw");
+	const CharStringFind find = { .s = &s, .alloc = t->alloc, .result = &finds };
+
+	if (CharString_findAllStringSensitive(&find, &tail, &t->err)) {
+		Test_assert(t, "findAllString ignores a match cut off by the end", !finds.length);
+		ListU64_free(&finds, t->alloc);
+	}
+	else Test_assert(t, "findAllString", false);
+
+	//splitLine over many short lines with both line endings
+
+	CharString lines = CharString_createNull();
+	ListCharString parts = (ListCharString) { 0 };
+	ok = true;
+
+	for(U64 i = 0; i < 100 && ok; ++i)
+		ok &= CharString_appendString(&lines, i & 1 ? &xyz : &lower, t->alloc, &t->err) && (
+			i & 2 ? CharString_append(&lines, '\r', t->alloc, &t->err) : true
+		) && CharString_append(&lines, '\n', t->alloc, &t->err);
+
+	Test_assert(t, "build lines", ok);
+
+	if (ok && CharString_splitLine(lines, t->alloc, &parts, &t->err)) {
+
+		//The final line end is followed by an empty line, like it always has been
+
+		Bool linesOk = parts.length == 101 && CharString_isEmpty(parts.ptr[100]);
+
+		for(U64 i = 0; i < 100 && linesOk; ++i)
+			linesOk &= Test_strEq(parts.ptr[i], i & 1 ? "XyZ" : "xyz");
+
+		Test_assert(t, "splitLine many lines", linesOk);
+		ListCharString_free(&parts, t->alloc);
+	}
+	else Test_assert(t, "splitLine many lines", false);
+
+	CharString_free(&lines, t->alloc);
+
+	//replaceAllString growing and shrinking over the long text, and with an offset
+
+	CharString mut = CharString_createNull();
+	const CharString a = S("a"), longer = S("<a>"), empty = CharString_createNull();
+
+	if (CharString_createCopy(s, t->alloc, &mut, &t->err)) {
+
+		const U64 count = CharString_countAllSensitive(&s, 'a', 0);
+
+		CharStringReplace2 r = { .s = &mut, .search = &a, .replace = &longer, .allocator = t->alloc };
+		Test_assert(t, "replaceAllString grow", CharString_replaceAllStringSensitive(&r, &t->err));
+		Test_assert(t, "replaceAllString grow length", CharString_length(mut) == len + count * 2);
+		Test_assert(t, "replaceAllString grow is null terminated", CharString_isNullTerminated(mut));
+
+		r.search = &longer;
+		r.replace = &a;
+		Test_assert(t, "replaceAllString shrink", CharString_replaceAllStringSensitive(&r, &t->err));
+		Test_assert(t, "replaceAllString round trips", CharString_equalsStringSensitive(&mut, &s));
+
+		//Only the second half loses its 'a's
+
+		r.search = &a;
+		r.replace = &empty;
+		r.off = len / 2;
+		Test_assert(t, "replaceAllString with offset", CharString_replaceAllStringSensitive(&r, &t->err));
+		Test_assert(t, "replaceAllString with offset length", (
+			CharString_length(mut) == len - CharString_countAllSensitive(&s, 'a', len / 2)
+		));
+		Test_assert(t, "replaceAllString with offset keeps the head", (
+			CharString_countAllSensitive(&mut, 'a', 0) == count - CharString_countAllSensitive(&s, 'a', len / 2)
+		));
+
+		r.off = len * 2;
+		Test_assert(t, "replaceAllString offset out of bounds", !CharString_replaceAllStringSensitive(&r, NULL));
+
+		CharString_free(&mut, t->alloc);
+	}
+	else Test_assert(t, "replace copy", false);
+}
+
 //========================= cut =========================
 
 static void Test_stringCut(Test *t) {
@@ -457,6 +641,237 @@ static void Test_stringList(Test *t) {
 	Test_assert(t, "free of a ref list", !list.length);
 }
 
+//========================= unicode =========================
+
+//Code points the way Buffer_readAsUTF8 sees them, one at a time; the bulk validation has to agree with it exactly
+
+static U64 Test_referenceCodepoints(const U8 *ptr, U64 len) {
+
+	const Buffer buf = Buffer_createRefConst(ptr, len);
+	U64 i = 0, j = 0;
+
+	while (i < len) {
+
+		UnicodeCodePointInfo info = (UnicodeCodePointInfo) { 0 };
+
+		if(!Buffer_readAsUTF8(buf, i, &info, NULL))
+			return U64_MAX;
+
+		i += info.bytes;
+		++j;
+	}
+
+	return j;
+}
+
+static void Test_stringUnicode(Test *t) {
+
+	Test_setModule(t, "CharString unicode");
+
+	//Every kind of invalid sequence, alone and placed right before and across the 64 byte blocks
+
+	static const C8 *invalid[] = {
+		"\x80",                     //Continuation without a lead
+		"\xC0\xAF",                 //Overlong '/'
+		"\xC1\xBF",
+		"\xE0\x80\xAF",             //Overlong 3 byte
+		"\xED\xA0\x80",             //Surrogate
+		"\xF0\x80\x80\xAF",         //Overlong 4 byte
+		"\xF4\x90\x80\x80",         //Above 0x10FFFF
+		"\xF5\x80\x80\x80",
+		"\xFF",
+		"\xC3",                     //Cut off
+		"\xE2\x82",
+		"\xF0\x9F\x98",
+		"\xC3\xA9\xA9",             //One continuation too many
+		"\x01",                     //Control characters aren't C8_isValidAscii
+		"\x7F"
+	};
+
+	C8 text[192];
+
+	Bool ok = true;
+
+	for (U64 i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+
+		const U64 n = CharString_calcStrLen(invalid[i], 8);
+
+		ok &= CharString_unicodeCodepoints(CharString_createRefSizedConst(invalid[i], n, false)) == U64_MAX;
+
+		for (U64 at = 56; at <= 72; ++at) {
+
+			for(U64 j = 0; j < sizeof(text); ++j)
+				text[j] = 'a' + (C8)(j % 26);
+
+			for(U64 j = 0; j < n; ++j)
+				text[at + j] = invalid[i][j];
+
+			ok &= CharString_unicodeCodepoints(CharString_createRefSizedConst(text, sizeof(text), false)) == U64_MAX;
+		}
+	}
+
+	Test_assert(t, "invalid UTF8 is rejected anywhere", ok);
+
+	//Every valid width at every alignment
+
+	static const C8 *valid[] = {
+		"\xC3\xA9", "\xE2\x82\xAC", "\xED\x9F\xBF", "\xEE\x80\x80", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF"
+	};
+	ok = true;
+
+	for (U64 i = 0; i < sizeof(valid) / sizeof(valid[0]); ++i) {
+
+		const U64 n = CharString_calcStrLen(valid[i], 8);
+
+		for (U64 at = 56; at <= 72; ++at) {
+
+			for(U64 j = 0; j < sizeof(text); ++j)
+				text[j] = 'a' + (C8)(j % 26);
+
+			for(U64 j = 0; j < n; ++j)
+				text[at + j] = valid[i][j];
+
+			const CharString str = CharString_createRefSizedConst(text, sizeof(text), false);
+			ok &= CharString_unicodeCodepoints(str) == sizeof(text) - n + 1;
+		}
+	}
+
+	Test_assert(t, "valid UTF8 at every alignment", ok);
+
+	//Random mixes of valid sequences, some with a byte flipped, against the one at a time reference
+
+	U8 bytes[300];
+	U64 rng = 0x9E3779B97F4A7C15;
+	ok = true;
+
+	for (U64 iter = 0; iter < 2000; ++iter) {
+
+		U64 len = 0;
+
+		while (len + 4 <= sizeof(bytes)) {
+
+			rng ^= rng << 13;
+			rng ^= rng >> 7;
+			rng ^= rng << 17;
+
+			//Mostly ASCII with runs of wider code points, like real text
+
+			static const U32 wideStart[] = { 0x80, 0x800, 0x10000 };
+
+			U32 c = (U32)(rng >> 32);
+			c = (rng & 3) ? 0x20 + c % 0x5F : wideStart[(rng >> 2) % 3] + c % 0x800;
+
+			if(c >= 0xD800 && c < 0xE000)
+				c += 0x800;
+
+			U8 written = 0;
+			Buffer_writeAsUTF8(Buffer_createRef(bytes + len, 4), 0, c, &written, NULL);
+			len += written;
+		}
+
+		if (iter & 1) {
+			rng ^= rng << 13;
+			rng ^= rng >> 7;
+			rng ^= rng << 17;
+			bytes[(rng >> 8) % len] ^= (U8)(1 << ((rng >> 40) % 8));
+		}
+
+		const CharString str = CharString_createRefSizedConst((const C8*) bytes, len, false);
+		ok &= CharString_unicodeCodepoints(str) == Test_referenceCodepoints(bytes, len);
+	}
+
+	Test_assert(t, "validation matches Buffer_readAsUTF8", ok);
+
+	//Round trips through UTF16 and UTF32 on text that's long enough for the block paths
+
+	CharString mixed = CharString_createNull(), back = CharString_createNull();
+	ListU16 utf16 = (ListU16) { 0 };
+	ListU32 utf32 = (ListU32) { 0 };
+
+	const CharString line = S("plain ascii text \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 ");
+	ok = true;
+
+	for(U64 i = 0; i < 20 && ok; ++i)
+		ok &= CharString_appendString(&mixed, &line, t->alloc, &t->err);
+
+	Test_assert(t, "build mixed text", ok);
+
+	const U64 codepoints = CharString_unicodeCodepoints(mixed);
+	Test_assert(t, "mixed codepoints", codepoints == 20 * 21);
+
+	if (CharString_toUTF16(mixed, t->alloc, &utf16, &t->err)) {
+
+		//U+1F600 is the pair D83D DE00, the ascii and the null terminator aren't touched
+		Test_assert(t, "toUTF16 length", utf16.length == 20 * 22 + 1 && !utf16.ptr[utf16.length - 1]);
+		Test_assert(t, "toUTF16 surrogate pair", utf16.ptr[19] == 0xD83D && utf16.ptr[20] == 0xDE00);
+		Test_assert(t, "toUTF16 two and three byte", utf16.ptr[17] == 0xE9 && utf16.ptr[18] == 0x20AC);
+
+		Test_assert(t, "createFromUTF16", CharString_createFromUTF16(utf16.ptr, U64_MAX, t->alloc, &back, &t->err));
+		Test_assert(t, "UTF16 round trip", CharString_equalsStringSensitive(&back, &mixed));
+		Test_assert(t, "createFromUTF16 is null terminated", CharString_isNullTerminated(back));
+		CharString_free(&back, t->alloc);
+
+		//limit stops before the null terminator, but not in the middle of a pair
+		Test_assert(t, "createFromUTF16 limit", CharString_createFromUTF16(utf16.ptr, 17, t->alloc, &back, &t->err));
+		Test_assert(t, "createFromUTF16 limit result", Test_strEq(back, "plain ascii text "));
+		CharString_free(&back, t->alloc);
+
+		Test_assert(t, "createFromUTF16 half a pair", !CharString_createFromUTF16(utf16.ptr, 20, t->alloc, &back, NULL));
+
+		ListU16_free(&utf16, t->alloc);
+	}
+	else Test_assert(t, "toUTF16", false);
+
+	if (CharString_toUTF32(mixed, t->alloc, &utf32, &t->err)) {
+
+		Test_assert(t, "toUTF32 length", utf32.length == codepoints && !utf32.ptr[utf32.length]);
+		Test_assert(t, "toUTF32 values", utf32.ptr[17] == 0xE9 && utf32.ptr[18] == 0x20AC && utf32.ptr[19] == 0x1F600);
+
+		Test_assert(t, "createFromUTF32", CharString_createFromUTF32(utf32.ptr, utf32.length, t->alloc, &back, &t->err));
+		Test_assert(t, "UTF32 round trip", CharString_equalsStringSensitive(&back, &mixed));
+		CharString_free(&back, t->alloc);
+
+		ListU32_free(&utf32, t->alloc);
+	}
+	else Test_assert(t, "toUTF32", false);
+
+	Test_assert(t, "toUTF16 rejects invalid UTF8", !CharString_toUTF16(S("a\xC0\xAF"), t->alloc, &utf16, NULL));
+	Test_assert(t, "toUTF32 rejects invalid UTF8", !CharString_toUTF32(S("a\xED\xA0\x80"), t->alloc, &utf32, NULL));
+
+	//A ref list has to be big enough for the result and the null terminator
+
+	U16 small[4] = { 0 };
+	utf16 = (ListU16) { 0 };
+
+	if (ListU16_createRef(small, 4, &utf16, &t->err)) {
+		Test_assert(t, "toUTF16 into a ref", CharString_toUTF16(S("abc"), t->alloc, &utf16, &t->err));
+		Test_assert(t, "toUTF16 into a ref result", small[0] == 'a' && small[2] == 'c' && !small[3]);
+		Test_assert(t, "toUTF16 ref too small", !CharString_toUTF16(S("abcd"), t->alloc, &utf16, NULL));
+	}
+	else Test_assert(t, "ListU16_createRef", false);
+
+	//UTF16 above the surrogates is valid, unpaired surrogates aren't
+
+	const U16 highBmp[] = { 'a', 0xE000, 0xFFFD, 0 };
+	const U16 loneLow[] = { 'a', 0xDC00, 0 };
+	const U16 loneHigh[] = { 'a', 0xD800, 'b', 0 };
+
+	Test_assert(t, "UTF16 above surrogates", CharString_createFromUTF16(highBmp, U64_MAX, t->alloc, &back, &t->err));
+	Test_assert(t, "UTF16 above surrogates result", Test_strEq(back, "a\xEE\x80\x80\xEF\xBF\xBD"));
+	CharString_free(&back, t->alloc);
+
+	Test_assert(t, "UTF16 lone low surrogate", !CharString_createFromUTF16(loneLow, U64_MAX, t->alloc, &back, NULL));
+	Test_assert(t, "UTF16 lone high surrogate", !CharString_createFromUTF16(loneHigh, U64_MAX, t->alloc, &back, NULL));
+
+	//isUTF8 with a threshold still counts the invalid code points once the fast path fails
+
+	Test_assert(t, "isUTF8 long valid", Buffer_isUTF8(CharString_bufferConst(mixed), 1));
+	Test_assert(t, "isUTF8 threshold", Buffer_isUTF8(Buffer_createRefConst("abcdefghi\x80", 10), 0.5f));
+	Test_assert(t, "isUTF8 strict", !Buffer_isUTF8(Buffer_createRefConst("abcdefghi\x80", 10), 1));
+
+	CharString_free(&mixed, t->alloc);
+}
+
 //========================= validation and parsing =========================
 
 static void Test_stringValidate(Test *t) {
@@ -506,8 +921,10 @@ void Test_stringOps(Test *t) {
 	Test_stringMutate(t);
 	Test_stringReplace(t);
 	Test_stringSearch(t);
+	Test_stringSearchLong(t);
 	Test_stringCut(t);
 	Test_stringSplit(t);
 	Test_stringList(t);
 	Test_stringValidate(t);
+	Test_stringUnicode(t);
 }
@@ -0,0 +1,111 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_trace.c
+
+#include "test_types_container_shared.h"
+#include "types/container/trace.h"
+#include "types/container/job_queue.h"
+#include "types/container/string.h"
+#include "types/base/string_read_helper.h"
+
+#define TraceTest_jobs 3000             //Enough for a few chunks per thread
+
+static Bool TraceTest_job(void *data, U64 threadId, JobQueue *queue) {
+	(void) data; (void) threadId; (void) queue;
+	Trace_zoneBegin("Test", "zone");
+	Trace_counter("Test", "counter", threadId);
+	Trace_zoneEnd("Test", "zone");
+	return true;
+}
+
+static U64 TraceTest_count(const CharString *json, const C8 *what) {
+	const CharString str = CharString_createRefCStrConst(what);
+	return CharString_countAllStringSensitive(json, &str, 0);
+}
+
+void Test_trace(Test *t) {
+
+	const Allocator *alloc = t->alloc;
+	Error *e_rr = &t->err;
+
+	Test_setModule(t, "Trace");
+
+	CharString json = CharString_createNull();
+	JobQueue queue = (JobQueue) { 0 };
+
+	//Nothing recorded yet, but always a valid (empty) trace
+
+	if (Test_assert(t, "export empty", Trace_exportChrome(alloc, &json, e_rr))) {
+		Test_assert(t, "has traceEvents", TraceTest_count(&json, "\"traceEvents\"") == 1);
+		Test_assert(t, "no events", !TraceTest_count(&json, "\"ph\""));
+	}
+
+	CharString_free(&json, alloc);
+
+	Test_assert(t, "start requires alloc", !Trace_start(NULL, NULL));
+
+	//Zones from many threads, every zone's end has to make it in
+
+	Bool ok = Test_assert(t, "start", Trace_start(alloc, e_rr));
+	ok = ok && Test_assert(t, "recording", Trace_isRecording());
+	ok = ok && Test_assert(t, "queue", JobQueue_createFlags(4, EJobQueueFlags_WorkStealing, alloc, &queue, e_rr));
+
+	for(U64 i = 0; ok && i < TraceTest_jobs; ++i)
+		ok = JobQueue_push(&queue, TraceTest_job, NULL, e_rr);
+
+	ok = ok && Test_assert(t, "wait", JobQueue_wait(&queue, e_rr));
+
+	Trace_stop();
+	Trace_zoneBegin("Test", "zone");        //Not recording anymore, so ignored
+	Trace_zoneEnd("Test", "zone");
+
+	if (ok && Test_assert(t, "export", Trace_exportChrome(alloc, &json, e_rr))) {
+
+		const U64 expected = _ENABLE_TRACING ? TraceTest_jobs : 0;
+		const U64 zones = TraceTest_count(&json, "\"name\": \"zone\"");
+		const U64 jobs = TraceTest_count(&json, "\"name\": \"job\"");
+
+		Test_assert(t, "zones", zones == expected * 2);
+		Test_assert(t, "counters", TraceTest_count(&json, "\"ph\": \"C\"") == expected);
+		Test_assert(t, "job zones", jobs == expected * 2);
+		Test_assert(t, "balanced", TraceTest_count(&json, "\"ph\": \"B\"") == TraceTest_count(&json, "\"ph\": \"E\""));
+		Test_assert(t, "nothing dropped", !Trace_dropped());
+	}
+
+	CharString_free(&json, alloc);
+	JobQueue_free(&queue);
+
+	//Clear throws everything away, recording again starts from scratch
+
+	Trace_clear();
+
+	ok = Test_assert(t, "restart", Trace_start(alloc, e_rr));
+	Trace_instant("Test", "instant");
+	Trace_stop();
+
+	if (ok && Test_assert(t, "export again", Trace_exportChrome(alloc, &json, e_rr))) {
+		Test_assert(t, "old events gone", !TraceTest_count(&json, "\"name\": \"zone\""));
+		Test_assert(t, "instant", TraceTest_count(&json, "\"ph\": \"i\"") == (_ENABLE_TRACING ? 1 : 0));
+	}
+
+	CharString_free(&json, alloc);
+	Trace_clear();
+}
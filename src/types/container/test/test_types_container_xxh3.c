@@ -0,0 +1,241 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/test/test_types_container_xxh3.c
+
+#include "test_types_container_shared.h"
+#include "types/container/buffer.h"
+#include "types/container/stream.h"
+#include "types/container/memory_stream.h"
+#include "types/base/error.h"
+#include "types/base/mathi.h"
+
+//Same bytes as the generator the expected values were made with (xxhash 0.8 reference, python xxhash module)
+
+static void Test_xxh3Fill(U8 *ptr, U64 len) {
+
+	U64 x = 0x243F6A8885A308D3;
+
+	for (U64 i = 0; i < len; ++i) {
+		x = x * 6364136223846793005 + 1442695040888963407;
+		ptr[i] = (U8)(x >> 56);
+	}
+}
+
+void Test_xxh3(Test *t) {
+
+	Test_setModule(t, "XXH3");
+
+	//Every size class: 0, 1-3, 4-8, 9-16, 17-128, 129-240 and the long path (partial blocks, exact blocks, many)
+
+	typedef struct XXH3Case { U64 len, seed, h64, lo, hi; } XXH3Case;
+
+	static const XXH3Case cases[] = {
+		{      0, 0, 0x2D06800538D394C2, 0x6001C324468D497F, 0x99AA06D3014798D8 },
+		{      0, 0x9E3779B97F4A7C15, 0x602B0E2CD6662C8B, 0x4CA5176998171787, 0xD142977A2CCA554B },
+		{      1, 0, 0xC0D1E3A09A6AB844, 0xC0D1E3A09A6AB844, 0x6321413D8CC8BA26 },
+		{      1, 0x9E3779B97F4A7C15, 0xDC15A76BC0376200, 0xDC15A76BC0376200, 0xC035A66AD4C6F143 },
+		{      3, 0, 0x40FFB44DDC6A1AE4, 0x40FFB44DDC6A1AE4, 0x28E76C0AED21454E },
+		{      3, 0x9E3779B97F4A7C15, 0x27A0D38444A5F15F, 0x27A0D38444A5F15F, 0x831107B5F4838DC3 },
+		{      4, 0, 0xC67C86EEA81241B8, 0xB7AC6EF08BE17F71, 0x18BF30908B185C17 },
+		{      4, 0x9E3779B97F4A7C15, 0x202EBFE08F560F51, 0x98A6D4478D9BC856, 0x822761916A6F59D4 },
+		{      8, 0, 0x8BBB553473F39D0D, 0x9182A768A749A191, 0xFD424BCEDA0D6225 },
+		{      8, 0x9E3779B97F4A7C15, 0xB6032214BC4DFA72, 0x7793D3E056BD1648, 0x680BB9548B68367D },
+		{      9, 0, 0x21E8E1BB56E8FBBB, 0x42B8BF0931C735BA, 0xE63EE9D080C64B54 },
+		{      9, 0x9E3779B97F4A7C15, 0x763805F205B3DB21, 0xBDC61227AEADB849, 0x65D31DE830DB4EEE },
+		{     16, 0, 0xF16CDB36E7FB7C86, 0x60B7053A636DFC82, 0xC74FBFBE5203F1DF },
+		{     16, 0x9E3779B97F4A7C15, 0x6CF506795A36E5DF, 0xF0E475C31F753441, 0x79BAC2953EE2AA92 },
+		{     17, 0, 0xF81D8C46A785BAD9, 0x0FF7F89AB83AF543, 0xAE7042DB7E613E1D },
+		{     17, 0x9E3779B97F4A7C15, 0x2AFCBB50A85C425E, 0x97CEBA135C8DBD40, 0x2FB12EAF7F230E2C },
+		{     64, 0, 0x64BFE753916B76D7, 0x8857EA5A2986E4DD, 0x0C947F8FFDDE3496 },
+		{     64, 0x9E3779B97F4A7C15, 0x3A08D70BB065BFEB, 0xAD4689FCA50E4839, 0x71AE9DA82D9B6506 },
+		{    128, 0, 0x0AB589B07C0B2288, 0xFE10984052431F30, 0x435206FD8BAA8431 },
+		{    128, 0x9E3779B97F4A7C15, 0xE848482282718767, 0x0BA16DBBA31FFA1D, 0x4A6ADB773E2F1F7F },
+		{    129, 0, 0x7DBD0C5B2622D756, 0xC5E24E434AFD305D, 0x814CBDC6B32E3F61 },
+		{    129, 0x9E3779B97F4A7C15, 0xE8FAE6F52D574FCC, 0xBD249AF3BC4412D1, 0xA1DDFEB5C502FAD7 },
+		{    240, 0, 0xFEDB3D4C4F935A6E, 0x4874C02A86C21441, 0x5F22F8C286130339 },
+		{    240, 0x9E3779B97F4A7C15, 0xAB231ED903781BBF, 0x579B004C2E1913B5, 0xDA5E3F5D1D545FC6 },
+		{    241, 0, 0x0D78BC9C748024A7, 0x0D78BC9C748024A7, 0xF5ABBFA6FC8316EA },
+		{    241, 0x9E3779B97F4A7C15, 0xED7B29942ECF2795, 0xED7B29942ECF2795, 0xBFF4256700B3CA4F },
+		{    256, 0, 0x024D790B2C4FDEFB, 0x024D790B2C4FDEFB, 0xB84185B42781EC60 },
+		{    256, 0x9E3779B97F4A7C15, 0xC7EBDC305A9D516C, 0xC7EBDC305A9D516C, 0x309C79243AB207AE },
+		{   1024, 0, 0x46182DAFF2F9D8E1, 0x46182DAFF2F9D8E1, 0x4D0919C06231148E },
+		{   1024, 0x9E3779B97F4A7C15, 0xC5F1E7B3D00FA68E, 0xC5F1E7B3D00FA68E, 0x203C0FAB72046AC9 },
+		{   1025, 0, 0x1F7A9173CE46BB59, 0x1F7A9173CE46BB59, 0xF9B4D48F250AE826 },
+		{   1025, 0x9E3779B97F4A7C15, 0xE823BD8F4DA5C3B2, 0xE823BD8F4DA5C3B2, 0xECCEC8A65C1A241F },
+		{   2047, 0, 0x7E5433723D10EE59, 0x7E5433723D10EE59, 0xCC91E4B6FE5B80BE },
+		{   2047, 0x9E3779B97F4A7C15, 0xE8B0B0DAB6CF617D, 0xE8B0B0DAB6CF617D, 0x2956BCB9BBC2E6AC },
+		{   4160, 0, 0x28DDB01F388F5278, 0x28DDB01F388F5278, 0x4A8BF7984687393B },
+		{   4160, 0x9E3779B97F4A7C15, 0x80F2925113FEDB54, 0x80F2925113FEDB54, 0x6D327B3E5AE60CF9 },
+		{ 100003, 0, 0x970CC9424E02479B, 0x970CC9424E02479B, 0xFF088ABB1B749F46 },
+		{ 100003, 0x9E3779B97F4A7C15, 0x611C35B4DF1C04CA, 0x611C35B4DF1C04CA, 0x427F233C9CADBBD7 }
+	};
+
+	const U64 maxLen = 100003;
+	Buffer data = Buffer_createNull();
+	Buffer copy = Buffer_createNull();
+	RefPtr *stream = NULL;
+	StreamCursor cursor = (StreamCursor) { 0 };
+
+	if (!Buffer_createUninitializedBytes(maxLen + 1, t->alloc, &data, &t->err)) {
+		Test_assert(t, "Alloc", false);
+		return;
+	}
+
+	Test_xxh3Fill(data.ptrNonConst, maxLen);
+
+	Bool all64 = true, all128 = true;
+
+	for (U64 i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+		const Buffer buf = Buffer_createRefConst(data.ptr, cases[i].len);
+		const Hash128 h = Buffer_hash128(buf, cases[i].seed);
+		all64 &= Buffer_hash64(buf, cases[i].seed) == cases[i].h64;
+		all128 &= h.lo == cases[i].lo && h.hi == cases[i].hi;
+	}
+
+	Test_assert(t, "hash64 matches xxHash", all64);
+	Test_assert(t, "hash128 matches xxHash", all128);
+
+	//Misaligned input takes the same unaligned loads
+
+	Bool misaligned = true;
+
+	for (U64 i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+
+		if(cases[i].len > 4160)
+			continue;
+
+		for (U64 j = cases[i].len; j-- > 0; )
+			data.ptrNonConst[j + 1] = data.ptr[j];
+
+		const Buffer buf = Buffer_createRefConst(data.ptr + 1, cases[i].len);
+		misaligned &= Buffer_hash64(buf, cases[i].seed) == cases[i].h64;
+
+		Test_xxh3Fill(data.ptrNonConst, maxLen);
+	}
+
+	Test_assert(t, "Misaligned input", misaligned);
+
+	//The backend stripe loop has to match the plain C one, including a run of many stripes at once
+
+	U64 accA[8], accB[8];
+
+	for (U8 i = 0; i < 8; ++i)
+		accA[i] = accB[i] = 0x0123456789ABCDEF * (i + 1);
+
+	const U8 *secret = data.ptr + 4096;
+
+	Buffer_hashAccumulate(accA, data.ptr + 7, 16, secret);
+	Buffer_hashAccumulateFallback(accB, data.ptr + 7, 16, secret);
+	Buffer_hashScramble(accA, secret + 3);
+	Buffer_hashScrambleFallback(accB, secret + 3);
+
+	Bool sameAcc = true;
+
+	for (U8 i = 0; i < 8; ++i)
+		sameAcc &= accA[i] == accB[i];
+
+	Test_assert(t, "SIMD stripes match fallback", sameAcc);
+
+	Test_assert(t, "Seed changes hash", Buffer_hash64(data, 1) != Buffer_hash64(data, 2));
+
+	//Streaming: any split has to give the one shot result, both for short (buffered) and long input
+
+	Test_setModule(t, "XXH3 streaming");
+
+	static const U64 lengths[] = { 0, 5, 200, 240, 241, 256, 257, 512, 1024, 5000, 100003 };
+	static const U64 parts[] = { 1, 3, 64, 100, 255, 256, 257, 1000, 4096 };
+
+	const U64 seed = cases[1].seed;
+	Bool streamed = true;
+
+	for (U64 i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i)
+		for (U64 j = 0; j < sizeof(parts) / sizeof(parts[0]); ++j) {
+
+			const U64 len = lengths[i];
+
+			if(parts[j] == 1 && len > 5000)
+				continue;
+
+			BufferHashState state;
+			BufferHashState_create(seed, &state);
+
+			for (U64 off = 0; off < len; off += parts[j])
+				BufferHashState_update(&state, Buffer_createRefConst(data.ptr + off, U64_min(parts[j], len - off)));
+
+			const Buffer whole = Buffer_createRefConst(data.ptr, len);
+			const Hash128 h = BufferHashState_digest128(&state);
+			const Hash128 w = Buffer_hash128(whole, seed);
+
+			streamed &= BufferHashState_digest64(&state) == Buffer_hash64(whole, seed);
+			streamed &= h.lo == w.lo && h.hi == w.hi;
+		}
+
+	Test_assert(t, "Any split matches one shot", streamed);
+
+	//Digest doesn't consume the state
+
+	BufferHashState state;
+	BufferHashState_create(0, &state);
+	BufferHashState_update(&state, Buffer_createRefConst(data.ptr, 1000));
+	const U64 first = BufferHashState_digest64(&state);
+	BufferHashState_update(&state, Buffer_createRefConst(data.ptr + 1000, 1000));
+
+	Test_assert(t, "Digest then update", first == Buffer_hash64(Buffer_createRefConst(data.ptr, 1000), 0));
+	Test_assert(
+		t, "Digest then update (continued)",
+		BufferHashState_digest64(&state) == Buffer_hash64(Buffer_createRefConst(data.ptr, 2000), 0)
+	);
+
+	//A stream through a cursor with the smallest cache (so it takes a few reads that aren't stripe aligned)
+
+	Test_setModule(t, "XXH3 StreamCursor");
+
+	const RefPtrType type = MemoryStream_makeType(t->alloc);
+
+	const Bool ok =
+		Buffer_createCopy(Buffer_createRefConst(data.ptr, maxLen), t->alloc, &copy, &t->err) &&
+		MemoryStream_createFromBuffer(&copy, EMemoryStreamFlags_None, &type, &stream, &t->err) &&
+		StreamCursor_create(stream, 32 * KIBI + 3, false, t->alloc, &cursor, &t->err);
+
+	Test_assert(t, "Create stream", ok);
+
+	if (ok) {
+
+		BufferHashState_create(0, &state);
+		Bool hashed = StreamCursor_hash(&cursor, 0, 0, &state, t->alloc, &t->err);
+		Test_assert(t, "Whole stream", hashed && BufferHashState_digest64(&state) == cases[36].h64);
+
+		BufferHashState_create(0, &state);
+		hashed = StreamCursor_hash(&cursor, 1000, 2000, &state, t->alloc, &t->err);
+
+		const U64 want = Buffer_hash64(Buffer_createRefConst(data.ptr + 1000, 2000), 0);
+		Test_assert(t, "Range", hashed && BufferHashState_digest64(&state) == want);
+
+		BufferHashState_create(0, &state);
+		const Bool outOfBounds = StreamCursor_hash(&cursor, maxLen - 10, 20, &state, t->alloc, NULL);
+		Test_assert(t, "Range out of bounds", !outOfBounds);
+	}
+
+	StreamCursor_close(&cursor, t->alloc);
+	RefPtr_dec(&stream);
+	Buffer_free(&copy, t->alloc);
+	Buffer_free(&data, t->alloc);
+}
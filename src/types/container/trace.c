@@ -0,0 +1,245 @@
+/* OxC3(Oxsomi core 3), a general framework and toolset for cross-platform applications.
+*  Copyright (C) 2023 - 2026 Oxsomi / Nielsbishere (Niels Brunekreef)
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program. If not, see https://github.com/Oxsomi/core3/blob/main/LICENSE.
+*  Be aware that GPL3 requires closed source products to be GPL3 too if released to the public.
+*  To prevent this a separate license will have to be requested at contact@osomi.net for a premium;
+*  This is called dual licensing.
+*/
+
+//types/container/trace.c
+
+#include "types/container/trace.h"
+#include "types/container/list_basic_types.h"
+#include "types/container/buffer.h"
+#include "types/container/string.h"
+#include "types/base/allocator.h"
+#include "types/base/atomic.h"
+#include "types/base/thread.h"
+#include "types/base/time.h"
+
+#include <inttypes.h>
+
+//Chunks are never written by anyone but their thread and never freed before Trace_clear.
+//Trace_chunks is the newest one; a chunk's next is the one published before it (by any thread).
+
+#define Trace_chunkEvents 1024
+
+typedef struct TraceChunk {
+	Buffer data;                    //Allocation of this chunk
+	struct TraceChunk *next;
+	U64 threadId;
+	AtomicI64 count;                //Published events
+	TraceEvent events[Trace_chunkEvents];
+} TraceChunk;
+
+static const Allocator *Trace_alloc;
+static Ns Trace_startTime;
+
+static AtomicI64 Trace_recordingState;
+static AtomicI64 Trace_chunks;              //TraceChunk*
+static AtomicI64 Trace_generation;          //Bumped by Trace_clear, so no thread keeps appending to a freed chunk
+static AtomicI64 Trace_droppedEvents;
+
+Bool Trace_start(const Allocator *alloc, Error *e_rr) {
+
+	Bool s_uccess = true;
+
+	if(!alloc)
+		retError(clean, Error_nullPointer(0, "Trace_start()::alloc is required"));
+
+	if(Trace_alloc && Trace_alloc != alloc && AtomicI64_load(&Trace_chunks))
+		retError(clean, Error_invalidState(0, "Trace_start() can't switch allocator without Trace_clear"));
+
+	if (!Trace_alloc || !AtomicI64_load(&Trace_chunks)) {
+		Trace_alloc = alloc;
+		Trace_startTime = Time_now();
+	}
+
+	AtomicI64_store(&Trace_recordingState, 1);
+
+clean:
+	return s_uccess;
+}
+
+void Trace_stop() {
+	AtomicI64_store(&Trace_recordingState, 0);
+}
+
+Bool Trace_isRecording() {
+	return AtomicI64_load(&Trace_recordingState);
+}
+
+U64 Trace_dropped() {
+	return (U64) AtomicI64_load(&Trace_droppedEvents);
+}
+
+void Trace_clear() {
+
+	AtomicI64_inc(&Trace_generation);
+
+	TraceChunk *chunk = (TraceChunk*) (U64) AtomicI64_store(&Trace_chunks, 0);
+
+	while (chunk) {
+		TraceChunk *next = chunk->next;
+		Buffer data = chunk->data;
+		Buffer_free(&data, Trace_alloc);
+		chunk = next;
+	}
+
+	AtomicI64_store(&Trace_droppedEvents, 0);
+	Trace_startTime = Time_now();
+}
+
+#if _ENABLE_TRACING
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define Trace_threadLocal __declspec(thread)
+#else
+	#define Trace_threadLocal _Thread_local
+#endif
+
+static Trace_threadLocal TraceChunk *Trace_localChunk;
+static Trace_threadLocal I64 Trace_localGeneration;
+
+static TraceChunk *Trace_newChunk(I64 generation) {
+
+	Buffer data = Buffer_createNull();
+
+	if(!Buffer_createUninitializedBytes(sizeof(TraceChunk), Trace_alloc, &data, NULL))
+		return NULL;
+
+	TraceChunk *chunk = (TraceChunk*) data.ptrNonConst;
+	chunk->data = data;
+	chunk->threadId = Thread_getId();
+	AtomicI64_store(&chunk->count, 0);
+
+	I64 head = AtomicI64_load(&Trace_chunks);
+
+	while (true) {
+
+		chunk->next = (TraceChunk*) (U64) head;
+		const I64 prev = AtomicI64_cmpStore(&Trace_chunks, head, (I64) (U64) chunk);
+
+		if(prev == head)
+			break;
+
+		head = prev;
+	}
+
+	Trace_localChunk = chunk;
+	Trace_localGeneration = generation;
+	return chunk;
+}
+
+void Trace_record(ETraceEvent type, const C8 *category, const C8 *name, I64 value) {
+
+	if(!AtomicI64_load(&Trace_recordingState))
+		return;
+
+	const Ns time = Time_now();
+	const I64 generation = AtomicI64_load(&Trace_generation);
+	TraceChunk *chunk = Trace_localGeneration == generation ? Trace_localChunk : NULL;
+
+	I64 count = chunk ? AtomicI64_load(&chunk->count) : Trace_chunkEvents;
+
+	if (count == Trace_chunkEvents) {
+
+		chunk = Trace_newChunk(generation);
+
+		if (!chunk) {
+			AtomicI64_inc(&Trace_droppedEvents);
+			return;
+		}
+
+		count = 0;
+	}
+
+	chunk->events[count] = (TraceEvent) {
+		.category = category, .name = name, .time = time, .value = value, .type = type
+	};
+
+	AtomicI64_store(&chunk->count, count + 1);
+}
+
+#endif
+
+Bool Trace_exportChrome(const Allocator *alloc, CharString *result, Error *e_rr) {
+
+	Bool s_uccess = true;
+	ListU64 chunks = (ListU64) { 0 };
+	CharString tmp = CharString_createNull();
+	Bool first = true;
+
+	if(!result)
+		retError(clean, Error_nullPointer(1, "Trace_exportChrome()::result is required"));
+
+	if(result->ptr)
+		retError(clean, Error_invalidParameter(1, 0, "Trace_exportChrome()::result wasn't empty, might indicate memleak"));
+
+	//Oldest chunk first, so the events of every thread come out in the order they were recorded
+
+	for(TraceChunk *c = (TraceChunk*) (U64) AtomicI64_load(&Trace_chunks); c; c = c->next)
+		gotoIfError3(clean, ListU64_pushBack(&chunks, (U64) c, alloc, e_rr));
+
+	gotoIfError3(clean, CharString_createCopy(CharString_createRefCStrConst("{ \"traceEvents\": [\n"), alloc, result, e_rr));
+
+	static const C8 *phases[] = { "B", "E", "C", "i" };
+
+	for (U64 i = chunks.length; i > 0; --i) {
+
+		TraceChunk *chunk = (TraceChunk*) chunks.ptr[i - 1];
+		const U64 count = (U64) AtomicI64_load(&chunk->count);
+
+		for (U64 j = 0; j < count; ++j) {
+
+			const TraceEvent *ev = &chunk->events[j];
+			const F64 ts = (F64) Time_dns(Trace_startTime, ev->time) / 1000;
+
+			if (ev->type == ETraceEvent_Counter) {
+				gotoIfError3(clean, CharString_format(
+					alloc, &tmp, e_rr,
+					"%s\t{ \"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"C\", \"ts\": %.3f, \"pid\": 1, \"tid\": %"PRIu64
+					", \"args\": { \"value\": %"PRIi64" } }",
+					first ? "" : ",\n", ev->name, ev->category, ts, chunk->threadId, ev->value
+				));
+			}
+
+			else {
+				gotoIfError3(clean, CharString_format(
+					alloc, &tmp, e_rr,
+					"%s\t{ \"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"%s\", \"ts\": %.3f, \"pid\": 1, \"tid\": %"PRIu64"%s }",
+					first ? "" : ",\n", ev->name, ev->category, phases[ev->type], ts, chunk->threadId,
+					ev->type == ETraceEvent_Instant ? ", \"s\": \"t\"" : ""
+				));
+			}
+
+			gotoIfError3(clean, CharString_appendString(result, &tmp, alloc, e_rr));
+			CharString_free(&tmp, alloc);
+			first = false;
+		}
+	}
+
+	const CharString end = CharString_createRefCStrConst("\n], \"displayTimeUnit\": \"ns\" }\n");
+	gotoIfError3(clean, CharString_appendString(result, &end, alloc, e_rr));
+
+clean:
+
+	if(!s_uccess && result)
+		CharString_free(result, alloc);
+
+	CharString_free(&tmp, alloc);
+	ListU64_free(&chunks, alloc);
+	return s_uccess;
+}